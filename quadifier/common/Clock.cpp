@@ -0,0 +1,119 @@
+#include "Clock.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <time.h>
+#endif
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+namespace {
+
+#if defined(_WIN32)
+
+/// Returns the current performance counter value
+LONGLONG counter()
+{
+    LARGE_INTEGER value = {};
+    QueryPerformanceCounter( &value );
+    return value.QuadPart;
+}
+
+/// Returns the period of the performance counter in seconds
+double period()
+{
+    LARGE_INTEGER frequency = {};
+    QueryPerformanceFrequency( &frequency );
+    return ( frequency.QuadPart > 0 ) ?
+        1.0 / static_cast<double>( frequency.QuadPart ) : 0.0;
+}
+
+// these are initialised when the module is loaded (function static variables
+// are not initialised in a thread-safe way by all our compilers)
+const double s_period = period();
+const LONGLONG s_start = counter();
+
+#elif defined(__linux__)
+
+/// Returns the monotonic clock time in seconds
+double now()
+{
+    struct timespec value;
+    clock_gettime( CLOCK_MONOTONIC, &value );
+    return static_cast<double>( value.tv_sec ) +
+           static_cast<double>( value.tv_nsec ) * 1.0e-9;
+}
+
+// initialised when the module is loaded
+const double s_start = now();
+
+#endif
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+
+double Clock::seconds()
+{
+#if defined(_WIN32)
+
+    return static_cast<double>( counter() - s_start ) * s_period;
+
+#elif defined(__linux__)
+
+    return now() - s_start;
+
+#endif
+}
+
+//-----------------------------------------------------------------------------
+
+double Clock::milliseconds()
+{
+    return 1000.0 * seconds();
+}
+
+//-----------------------------------------------------------------------------
+
+#if defined(_WIN32)
+
+double Clock::seconds( long long counter )
+{
+    return static_cast<double>( counter - s_start ) * s_period;
+}
+
+//-----------------------------------------------------------------------------
+
+double Clock::interval( long long counts )
+{
+    return static_cast<double>( counts ) * s_period;
+}
+
+//-----------------------------------------------------------------------------
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef hive_Clock_h
+#define hive_Clock_h
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+/**
+ * Provides a monotonic, high resolution wall clock, measured from the time
+ * the module was loaded. On Windows this uses QueryPerformanceCounter, and
+ * on Linux clock_gettime with CLOCK_MONOTONIC.
+ */
+class Clock {
+public:
+    /// Returns the elapsed time in seconds
+    static double seconds();
+
+    /// Returns the elapsed time in milliseconds
+    static double milliseconds();
+
+#if defined(_WIN32)
+    /// Returns the elapsed time in seconds at a QueryPerformanceCounter value
+    /// (e.g. a time-stamp reported by the system)
+    static double seconds( long long counter );
+
+    /// Returns the duration in seconds of a QueryPerformanceCounter interval
+    static double interval( long long counts );
+#endif
+};
+
+//-----------------------------------------------------------------------------
+
+#endif//hive_Clock_h
@@ -1,12 +1,17 @@
 #include "Event.h"
+#include "Clock.h"
 
 #if defined(_WIN32)
 #include <windows.h>
 #elif defined(__linux__)
 #include <time.h>
-#include <pthread.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
 #endif
 
+#include <algorithm>
+#include <atomic>
 #include <assert.h>
 
 //-----------------------------------------------------------------------------
@@ -35,19 +40,95 @@
 //
 //-----------------------------------------------------------------------------
 
+namespace {
+    /// Spin iterations before blocking, adapted between these limits: the
+    /// count doubles whenever spinning catches the signal, and halves when
+    /// the waiter has to block (so long waits soon stop burning the CPU)
+    const int MIN_SPIN = 16;
+    const int MAX_SPIN = 4096;
+
+    /// Hint to the processor that we are spinning
+    inline void cpuPause()
+    {
+#if defined(_WIN32)
+        YieldProcessor();
+#elif defined(__i386__) || defined(__x86_64__)
+        __builtin_ia32_pause();
+#endif
+    }
+
+#if defined(_WIN32)
+    /// WaitOnAddress/WakeByAddressSingle (Windows 8 upwards, loaded
+    /// dynamically so that the module still runs on Windows 7)
+    typedef BOOL (WINAPI *PFNWaitOnAddress)(
+        volatile VOID *address, PVOID compareAddress,
+        SIZE_T addressSize, DWORD milliseconds );
+    typedef VOID (WINAPI *PFNWakeByAddressSingle)( PVOID address );
+#endif
+} // namespace
+
+//-----------------------------------------------------------------------------
+
+/**
+ * The event is a word which is 1 when signalled, claimed by the waiter with
+ * a compare-and-swap. A waiter spins briefly before parking on the word
+ * (futex on Linux, WaitOnAddress on Windows 8 upwards, or an auto-reset
+ * event object on older Windows), and signal() only makes a system call
+ * when a thread is actually parked.
+ */
 struct Event::Context {
+    std::atomic<int> state;         ///< 1 if signalled, else 0
+    std::atomic<unsigned> waiting;  ///< number of parked (or parking) threads
+    std::atomic<int> spin;          ///< current spin count
+
 #if defined(_WIN32)
+    PFNWaitOnAddress       waitOnAddress;       ///< zero if unsupported
+    PFNWakeByAddressSingle wakeByAddressSingle; ///< zero if unsupported
+    HANDLE eventHandle;             ///< fallback when WaitOnAddress is missing
+#endif
 
-    HANDLE eventHandle;
+    /// Claim the signal, returns true if it was set
+    bool tryAcquire() {
+        int expected = 1;
+        return state.compare_exchange_strong( expected, 0 );
+    }
 
-#elif defined(__linux__)
+    /// The address the kernel waits on
+    int * address() {
+        return reinterpret_cast<int*>( &state );
+    }
 
-    pthread_mutex_t mutex;      ///< the mutex
-    pthread_cond_t condition;   ///< condition variable to wait on
-    bool signalled;             ///< is the event signalled?
-    unsigned waiting;           ///< number of waiting threads
+    /// Block until woken, the state changes from 0, or the timeout expires
+    /// (0 = no timeout); may return spuriously
+    void park( unsigned milliseconds ) {
+#if defined(_WIN32)
+        DWORD timeout = milliseconds ? static_cast<DWORD>( milliseconds ) : INFINITE;
+        if ( waitOnAddress ) {
+            int unsignalled = 0;
+            waitOnAddress( address(), &unsignalled, sizeof(int), timeout );
+        } else {
+            WaitForSingleObject( eventHandle, timeout );
+        }
+#elif defined(__linux__)
+        struct timespec timeout;
+        timeout.tv_sec  = milliseconds / 1000;
+        timeout.tv_nsec = 1000000L * static_cast<long>( milliseconds % 1000 );
+        syscall( SYS_futex, address(), FUTEX_WAIT_PRIVATE, 0,
+            milliseconds ? &timeout : 0, 0, 0 );
+#endif
+    }
 
+    /// Wake one parked thread
+    void wake() {
+#if defined(_WIN32)
+        if ( wakeByAddressSingle )
+            wakeByAddressSingle( address() );
+        else
+            SetEvent( eventHandle );
+#elif defined(__linux__)
+        syscall( SYS_futex, address(), FUTEX_WAKE_PRIVATE, 1, 0, 0, 0 );
 #endif
+    }
 };
 
 //-----------------------------------------------------------------------------
@@ -55,29 +136,39 @@ struct Event::Context {
 Event::Event() :
     self( new Event::Context )
 {
-#if defined(_WIN32)
+    self->state   = 0;
+    self->waiting = 0;
+    self->spin    = MIN_SPIN;
 
-    // create an event object
-    self->eventHandle = CreateEvent(
-        NULL,   // default security attributes
-        FALSE,  // auto-reset event object
-        FALSE,  // initial state is not signalled
-        NULL    // object is not named
-    );
-
-    // ensure that event object was created successfully (in debug builds)
-    assert( self->eventHandle != 0 );
-
-#elif defined(__linux__)
-
-    self->signalled = false;
-    self->waiting   = 0;
-    
-    // initialise mutex
-    pthread_mutex_init( &self->mutex, 0 );
+#if defined(_WIN32)
 
-    // initialise condition variable
-    pthread_cond_init( &self->condition, 0 );
+    // use WaitOnAddress if the system has it
+    self->waitOnAddress       = 0;
+    self->wakeByAddressSingle = 0;
+    self->eventHandle         = 0;
+    HMODULE synch = LoadLibraryA( "api-ms-win-core-synch-l1-2-0.dll" );
+    if ( synch != 0 ) {
+        self->waitOnAddress = reinterpret_cast<PFNWaitOnAddress>(
+            GetProcAddress( synch, "WaitOnAddress" ) );
+        self->wakeByAddressSingle = reinterpret_cast<PFNWakeByAddressSingle>(
+            GetProcAddress( synch, "WakeByAddressSingle" ) );
+    }
+
+    if ( (self->waitOnAddress == 0) || (self->wakeByAddressSingle == 0) ) {
+        self->waitOnAddress       = 0;
+        self->wakeByAddressSingle = 0;
+
+        // otherwise create an event object to park on
+        self->eventHandle = CreateEvent(
+            NULL,   // default security attributes
+            FALSE,  // auto-reset event object
+            FALSE,  // initial state is not signalled
+            NULL    // object is not named
+        );
+
+        // ensure that event object was created successfully (in debug builds)
+        assert( self->eventHandle != 0 );
+    }
 
 #endif
 }//Event
@@ -89,12 +180,8 @@ Event::~Event()
 #if defined(_WIN32)
 
     // destroy the event object
-    CloseHandle( self->eventHandle );
-
-#elif defined(__linux__)
-
-    pthread_mutex_destroy( &self->mutex );
-    pthread_cond_destroy( &self->condition );
+    if ( self->eventHandle != 0 )
+        CloseHandle( self->eventHandle );
 
 #endif
 }
@@ -103,90 +190,62 @@ Event::~Event()
 
 void Event::signal()
 {
-#if defined(_WIN32)
-
-    // set the event to the signalled state
-    SetEvent( self->eventHandle );
-
-#elif defined(__linux__)
-
-    // lock the mutex first
-    pthread_mutex_lock( &self->mutex );
-
-    if ( self->waiting > 0 ) {
-        // threads waiting: wake up waiting thread
-        pthread_cond_signal( &self->condition );
-    } else {
-        // no threads waiting: signal the event
-        self->signalled = true;
-    }
-    
-    // release the mutex
-    pthread_mutex_unlock( &self->mutex );
-
-#endif
+    // set the signalled state, then wake a parked thread if there is one
+    // (both are sequentially consistent: a waiter increments the count
+    // before its last look at the state, so one of us sees the other)
+    self->state.store( 1 );
+    if ( self->waiting.load() > 0 )
+        self->wake();
 }
 
 //-----------------------------------------------------------------------------
 
 bool Event::wait( unsigned milliseconds )
 {
-#if defined(_WIN32)
-
-    // wait for the event to be signalled, return true if signalled,
-    // return false if the wait timed out or was abandoned
-    return ( WaitForSingleObject(
-        self->eventHandle,
-        static_cast<DWORD>( milliseconds )
-    ) == WAIT_OBJECT_0 );
-
-#elif defined(__linux__)
-
-    // lock the mutex first
-    pthread_mutex_lock( &self->mutex );
-
-    // is the event signalled?
-    if ( self->signalled ) {
-        // automatically reset
-        self->signalled = false;
-    } else {
-        // not signalled
-
-        // increment number of waiting threads
-        self->waiting++;
-        
-        // has a timeout been specified?
-        if ( milliseconds == 0 ) {
-            // no timeout specified: wait indefinitely
-            pthread_cond_wait( &self->condition, &self->mutex );
-        } else {
-            // timeout specified: we will use a timed wait
-
-            // get current time, to calculate absolute expiry time
-            struct timespec expiry;
-            clock_gettime( CLOCK_REALTIME, &expiry );
-            
-            // increment nanoseconds by user specified timeout
-            expiry.tv_nsec += 1000L * static_cast<long>( milliseconds );
-
-            // carry into seconds
-            if ( expiry.tv_nsec >= 1000000000 ) {
-                expiry.tv_nsec -= 1000000000;
-                expiry.tv_sec++;
-            }
+    Context & context = *self;
+
+    // fast path: already signalled
+    if ( context.tryAcquire() ) return true;
+
+    // spin for a short while, in case the signal is about to arrive
+    const int spin = context.spin.load( std::memory_order_relaxed );
+    for (int i=0; i<spin; ++i) {
+        cpuPause();
+        if ( (context.state.load( std::memory_order_relaxed ) != 0) &&
+             context.tryAcquire()
+        ) {
+            context.spin.store( std::min( spin * 2, MAX_SPIN ),
+                std::memory_order_relaxed );
+            return true;
+        }
+    }
+    context.spin.store( std::max( spin / 2, MIN_SPIN ), std::memory_order_relaxed );
+
+    // slow path: park until signalled or timed out
+    const double deadline = Clock::milliseconds() + milliseconds;
+    unsigned remaining = milliseconds;
+    bool signalled = false;
+
+    context.waiting.fetch_add( 1 );
+    for (;;) {
+        if ( context.tryAcquire() ) {
+            signalled = true;
+            break;
+        }
 
-            // wait with timeout
-            pthread_cond_timedwait( &self->condition, &self->mutex, &expiry );
+        // work out the time left if we were woken early (spuriously, or
+        // another waiter took the signal)
+        if ( milliseconds != 0 ) {
+            const double left = deadline - Clock::milliseconds();
+            if ( left <= 0.0 ) break;
+            remaining = static_cast<unsigned>( left ) + 1;
         }
 
-        // decrement number of waiting threads
-        self->waiting--;
+        context.park( remaining );
     }
-    
-    // release the mutex
-    pthread_mutex_unlock( &self->mutex );
+    context.waiting.fetch_sub( 1 );
 
-#endif
+    return signalled;
 }//wait
 
 //-----------------------------------------------------------------------------
@@ -37,7 +37,10 @@
 
 /**
  * This class implements an Event object. Clients can wait for an event, and
- * the event can be signalled.
+ * the event can be signalled. The event resets automatically when a wait
+ * returns true. Signalling an event with nobody waiting, and waiting on an
+ * event already signalled, stay in user mode; a waiter spins briefly before
+ * blocking in the kernel.
  */
 class Event {
 public:
@@ -5,6 +5,8 @@
 
 #include <iostream>
 #include <fstream>
+#include <stdio.h>
+#include "Clock.h"
 
 //-----------------------------------------------------------------------------
 
@@ -40,7 +42,8 @@ public:
 	/// Returns true if the specified logging level is enabled
 	static bool level( int value );
 
-	/// Returns the stream used for output
+	/// Returns the stream used for output, after writing a time-stamp
+	/// (in milliseconds) to start the message
 	static std::ostream & stream();
 
 	/// Returns true if logging is disabled
@@ -157,7 +160,12 @@ inline bool Log::level( int value )
 
 inline std::ostream & Log::stream()
 {
-	return get().getStream();
+	// format the time-stamp separately, so that we don't change the
+	// precision of the stream used by the caller
+	char timeStamp[32] = {};
+	snprintf( timeStamp, sizeof(timeStamp), "%.3f: ", Clock::milliseconds() );
+
+	return get().getStream() << timeStamp;
 }
 
 //-----------------------------------------------------------------------------
@@ -0,0 +1,72 @@
+#ifndef SharedStats_h
+#define SharedStats_h
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+#include <stdint.h>
+
+//-----------------------------------------------------------------------------
+
+/**
+ * Layout of the per-process frame statistics segment, which the Linux shim
+ * creates as /dev/shm/quadifier-<pid> (shm_open name "/quadifier-<pid>").
+ *
+ * The segment is a SharedStatsHeader followed by a ring of `capacity`
+ * SharedStatsRecord. The shim writes one record per swap without any system
+ * calls: it claims a slot by incrementing `frames`, fills in the record and
+ * finally stores `sequence` (the frame number plus one) with release
+ * semantics. A monitor reads `frames`, then for each frame n it wants reads
+ * records[n % capacity], accepting the copy only if `sequence` was n+1 both
+ * before and after copying (otherwise the slot was being rewritten).
+ */
+struct SharedStatsHeader {
+    uint32_t magic;         ///< SHARED_STATS_MAGIC
+    uint32_t version;       ///< SHARED_STATS_VERSION
+    uint32_t recordSize;    ///< sizeof(SharedStatsRecord)
+    uint32_t capacity;      ///< number of records in the ring
+    uint64_t frames;        ///< number of records claimed so far
+};
+
+/// One swap of one drawable
+struct SharedStatsRecord {
+    uint64_t sequence;      ///< frame number + 1, written last (0 = empty)
+    uint64_t drawable;      ///< GLXDrawable which was swapped
+    int64_t  swapTime;      ///< CLOCK_MONOTONIC time at the swap (ns)
+    double   swapInterval;  ///< time since the drawable's previous swap (ms)
+    double   swapDuration;  ///< time spent in the swap (ms)
+    uint32_t clearCount;    ///< glClear calls in the frame
+    uint32_t clearsPerEye;  ///< glClear calls per eye (0 if not counting)
+    uint32_t stereo;        ///< 1 if the frame was detected as stereo
+    uint32_t signalled;     ///< 1 if the eye signal was received
+};
+
+static const uint32_t SHARED_STATS_MAGIC   = 0x51554144; // "QUAD"
+static const uint32_t SHARED_STATS_VERSION = 1;
+
+//-----------------------------------------------------------------------------
+
+#endif//SharedStats_h
@@ -1,8 +1,19 @@
 #include <GL/gl.h>
 #include <GL/glx.h>
 #include <dlfcn.h>
+#include <cstdlib>
+#include <cstring>
+#include <stdint.h>
+#include <map>
 #include <vector>
+#include <pthread.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+#include "Clock.h"
 #include "Log.h"
+#include "SharedStats.h"
 
 using namespace std;
 
@@ -36,30 +47,64 @@ using namespace std;
 // J.Ward 16/12/13
 // Usage:
 //   LD_PRELOAD=$PWD/quadifer.so <YourExecutableHere>
+// Environment (all optional):
+//   QUADIFIER_SWAP_GROUP=n     join NV swap group n (frame lock)
+//   QUADIFIER_SWAP_BARRIER=n   bind the swap group to NV swap barrier n
+//   QUADIFIER_OML_PACING=1     swap at the vblank after the previous swap
+//   QUADIFIER_LOG_LEVEL=n      0 (off) to 4 (verbose), default 3 (detailed)
+// Per-swap statistics are published in /dev/shm/quadifier-<pid> (see
+// SharedStats.h for the layout).
 
 //-----------------------------------------------------------------------------
 
-bool g_stereoDetect = false;    ///< have we detected incoming stereo frames?
-unsigned g_clearsPerEye = 0;    ///< number of glClear calls per eye
-unsigned g_clearCount   = 0;    ///< used to count number of glClear calls
-
-//-----------------------------------------------------------------------------
+/// Stereo detection state, kept for each drawable on each thread, so that
+/// several windows (or loader threads clearing their own drawables) do not
+/// disturb each other's clear counting
+struct Stereo {
+    bool stereoDetect;      ///< have we detected incoming stereo frames?
+    unsigned clearsPerEye;  ///< number of glClear calls per eye
+    unsigned clearCount;    ///< used to count number of glClear calls
+    double lastSwapTime;    ///< time-stamp of the last swap (ms)
+    bool signalled;         ///< is the application sending the eye signal?
+    bool rightEye;          ///< has the right eye signal been seen this frame?
+    bool swapJoined;        ///< has the drawable joined the swap group?
+    int64_t lastUst;        ///< OML time of the last swap (microseconds)
+    int64_t lastMsc;        ///< OML vblank count of the last swap
+
+    Stereo() :
+        stereoDetect( false ),
+        clearsPerEye( 0 ),
+        clearCount( 0 ),
+        lastSwapTime( 0.0 ),
+        signalled( false ),
+        rightEye( false ),
+        swapJoined( false ),
+        lastUst( 0 ),
+        lastMsc( 0 )
+    {
+    }
 
-/// Class used to perform one-time initialisation at load time
-class Init {
-public:
-    Init() {
-        Log::get()
-            .setLevel( Log::Detailed )
-            .open( "quadifier.log" );
+    /// Returns the back buffer for the eye being drawn, when the application
+    /// sends the eye signal
+    GLenum signalledBuffer() const {
+        return rightEye ? GL_BACK_RIGHT : GL_BACK_LEFT;
     }
-} g_init;
+};
+
+/// The stereo state of each drawable used by one thread
+typedef std::map<GLXDrawable, Stereo> StereoMap;
 
 //-----------------------------------------------------------------------------
 
 /// define function type for glClear
 typedef void FN_glClear( GLbitfield mask );
 
+/// define function type for glDrawBuffer
+typedef void FN_glDrawBuffer( GLenum mode );
+
+/// define function type for glViewport
+typedef void FN_glViewport( GLint x, GLint y, GLsizei width, GLsizei height );
+
 /// define function type for glXSwapBuffers
 typedef void FN_glXSwapBuffers( Display *dpy, GLXDrawable drawable );
 
@@ -69,6 +114,376 @@ typedef GLXFBConfig* FN_glXChooseFBConfig(
     const int *attribList, int *nitems
 );
 
+/// define function type for glXMakeCurrent
+typedef Bool FN_glXMakeCurrent(
+    Display *dpy, GLXDrawable drawable, GLXContext ctx
+);
+
+/// define function type for glXMakeContextCurrent
+typedef Bool FN_glXMakeContextCurrent(
+    Display *dpy, GLXDrawable draw, GLXDrawable read, GLXContext ctx
+);
+
+/// define function types for GLX_NV_swap_group
+typedef Bool FN_glXJoinSwapGroupNV(
+    Display *dpy, GLXDrawable drawable, GLuint group
+);
+typedef Bool FN_glXBindSwapBarrierNV( Display *dpy, GLuint group, GLuint barrier );
+typedef Bool FN_glXQueryMaxSwapGroupsNV(
+    Display *dpy, int screen, GLuint *maxGroups, GLuint *maxBarriers
+);
+
+/// define function types for GLX_OML_sync_control
+typedef Bool FN_glXGetSyncValuesOML(
+    Display *dpy, GLXDrawable drawable,
+    int64_t *ust, int64_t *msc, int64_t *sbc
+);
+typedef int64_t FN_glXSwapBuffersMscOML(
+    Display *dpy, GLXDrawable drawable,
+    int64_t target, int64_t divisor, int64_t remainder
+);
+typedef Bool FN_glXWaitForSbcOML(
+    Display *dpy, GLXDrawable drawable, int64_t target,
+    int64_t *ust, int64_t *msc, int64_t *sbc
+);
+
+/// define function type for glXGetProcAddress/glXGetProcAddressARB
+typedef void (*FN_glXGetProcAddress( const GLubyte *procName ))();
+
+//-----------------------------------------------------------------------------
+
+/// The original functions which we hook, resolved at load time so that no
+/// symbol lookup happens on the rendering path (filled in by g_init, before
+/// the application starts, then once more by the first hook called, for any
+/// not found then; see resolveOriginals)
+struct Dispatch {
+    FN_glClear              *glClear;
+    FN_glDrawBuffer         *glDrawBuffer;
+    FN_glViewport           *glViewport;
+    FN_glXSwapBuffers       *glXSwapBuffers;
+    FN_glXChooseFBConfig    *glXChooseFBConfig;
+    FN_glXMakeCurrent       *glXMakeCurrent;
+    FN_glXMakeContextCurrent *glXMakeContextCurrent;
+    FN_glXGetProcAddress    *glXGetProcAddress;
+    FN_glXGetProcAddress    *glXGetProcAddressARB;
+
+    // optional extension functions (zero if unsupported)
+    FN_glXJoinSwapGroupNV       *glXJoinSwapGroupNV;
+    FN_glXBindSwapBarrierNV     *glXBindSwapBarrierNV;
+    FN_glXQueryMaxSwapGroupsNV  *glXQueryMaxSwapGroupsNV;
+    FN_glXGetSyncValuesOML      *glXGetSyncValuesOML;
+    FN_glXSwapBuffersMscOML     *glXSwapBuffersMscOML;
+    FN_glXWaitForSbcOML         *glXWaitForSbcOML;
+
+    /// Look up any functions not yet found: these come from the next library
+    /// in the search order, or from glXGetProcAddress if that fails
+    void resolve() {
+        lookup( glXGetProcAddress,    "glXGetProcAddress" );
+        lookup( glXGetProcAddressARB, "glXGetProcAddressARB" );
+        lookup( glClear,              "glClear" );
+        lookup( glDrawBuffer,         "glDrawBuffer" );
+        lookup( glViewport,           "glViewport" );
+        lookup( glXSwapBuffers,       "glXSwapBuffers" );
+        lookup( glXChooseFBConfig,    "glXChooseFBConfig" );
+        lookup( glXMakeCurrent,       "glXMakeCurrent" );
+        lookup( glXMakeContextCurrent, "glXMakeContextCurrent" );
+
+        lookup( glXJoinSwapGroupNV,      "glXJoinSwapGroupNV",      false );
+        lookup( glXBindSwapBarrierNV,    "glXBindSwapBarrierNV",    false );
+        lookup( glXQueryMaxSwapGroupsNV, "glXQueryMaxSwapGroupsNV", false );
+        lookup( glXGetSyncValuesOML,     "glXGetSyncValuesOML",     false );
+        lookup( glXSwapBuffersMscOML,    "glXSwapBuffersMscOML",    false );
+        lookup( glXWaitForSbcOML,        "glXWaitForSbcOML",        false );
+    }
+
+private:
+    template <typename FN>
+    void lookup( FN *&function, const char *name, bool required = true ) {
+        if ( function != 0 ) return;
+        function = reinterpret_cast<FN*>( dlsym( RTLD_NEXT, name ) );
+        if ( (function == 0) && (glXGetProcAddressARB != 0) ) {
+            function = reinterpret_cast<FN*>( glXGetProcAddressARB(
+                reinterpret_cast<const GLubyte*>( name ) ) );
+        }
+        if ( (function == 0) && required && Log::error() )
+            Log::stream() << "Failed to find " << name << endl;
+    }
+} g_real = {};
+
+/// Guards the second lookup of the original functions
+pthread_once_t g_resolved = PTHREAD_ONCE_INIT;
+
+/// Look up the original functions not found at load time
+void resolveLate()
+{
+    g_real.resolve();
+}
+
+/// Called by every hook before it uses g_real: the first call looks up any
+/// functions not found at load time (e.g. if libGL was loaded after us),
+/// on one thread while any others wait, and later calls return at once; a
+/// function still missing is not looked for again
+void resolveOriginals()
+{
+    pthread_once( &g_resolved, resolveLate );
+}
+
+//-----------------------------------------------------------------------------
+
+/// Frame lock and pacing options, read from the environment at load time
+struct Config {
+    unsigned swapGroup;     ///< NV swap group to join (0 = none)
+    unsigned swapBarrier;   ///< NV swap barrier to bind the group to (0 = none)
+    bool omlPacing;         ///< swap with glXSwapBuffersMscOML?
+    unsigned logLevel;      ///< Log::Disabled to Log::Verbose
+
+    /// Read the options
+    void load() {
+        const char *level = getenv( "QUADIFIER_LOG_LEVEL" );
+        logLevel    = level ? readUnsigned( "QUADIFIER_LOG_LEVEL" ) : Log::Detailed;
+        if ( logLevel > Log::Verbose ) logLevel = Log::Verbose;
+        swapGroup   = readUnsigned( "QUADIFIER_SWAP_GROUP" );
+        swapBarrier = readUnsigned( "QUADIFIER_SWAP_BARRIER" );
+        omlPacing   = readUnsigned( "QUADIFIER_OML_PACING" ) != 0;
+    }
+
+private:
+    static unsigned readUnsigned( const char *name ) {
+        const char *value = getenv( name );
+        return value ? static_cast<unsigned>( strtoul( value, 0, 10 ) ) : 0;
+    }
+} g_config = {};
+
+//-----------------------------------------------------------------------------
+
+/// The shared memory segment holding the per-swap statistics ring, written
+/// without locks or system calls so that a monitor can watch the frames
+struct Stats {
+    static const uint32_t CAPACITY = 1024;  ///< records in the ring
+
+    SharedStatsHeader *header;      ///< start of the segment (zero if none)
+    SharedStatsRecord *records;     ///< the ring of records
+    size_t size;                    ///< size of the segment in bytes
+    char name[64];                  ///< shm_open name of the segment
+
+    /// Create the segment for this process
+    void open() {
+        snprintf( name, sizeof(name), "/quadifier-%d", int(getpid()) );
+        size = sizeof(SharedStatsHeader) + CAPACITY * sizeof(SharedStatsRecord);
+
+        int fd = shm_open( name, O_CREAT | O_RDWR | O_TRUNC, 0644 );
+        if ( fd < 0 ) {
+            if ( Log::warning() )
+                Log::stream() << "failed to create " << name << endl;
+            return;
+        }
+        void *memory = MAP_FAILED;
+        if ( ftruncate( fd, size ) == 0 )
+            memory = mmap( 0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+        ::close( fd );
+        if ( memory == MAP_FAILED ) {
+            shm_unlink( name );
+            if ( Log::warning() )
+                Log::stream() << "failed to map " << name << endl;
+            return;
+        }
+
+        // the new segment is zero filled: only the header needs writing
+        header  = static_cast<SharedStatsHeader*>( memory );
+        records = reinterpret_cast<SharedStatsRecord*>( header + 1 );
+        header->version    = SHARED_STATS_VERSION;
+        header->recordSize = sizeof(SharedStatsRecord);
+        header->capacity   = CAPACITY;
+        __atomic_store_n( &header->magic, SHARED_STATS_MAGIC, __ATOMIC_RELEASE );
+    }
+
+    /// Remove the segment
+    void close() {
+        if ( header == 0 ) return;
+        munmap( header, size );
+        shm_unlink( name );
+        header = 0;
+    }
+
+    /// Publish a record (any thread): the sequence number is written last
+    void write( const SharedStatsRecord & record ) {
+        if ( header == 0 ) return;
+        uint64_t frame = __atomic_fetch_add( &header->frames, 1, __ATOMIC_RELAXED );
+        SharedStatsRecord & slot = records[ frame % CAPACITY ];
+        __atomic_store_n( &slot.sequence, 0, __ATOMIC_RELAXED );
+        __atomic_thread_fence( __ATOMIC_RELEASE );
+        slot.drawable     = record.drawable;
+        slot.swapTime     = record.swapTime;
+        slot.swapInterval = record.swapInterval;
+        slot.swapDuration = record.swapDuration;
+        slot.clearCount   = record.clearCount;
+        slot.clearsPerEye = record.clearsPerEye;
+        slot.stereo       = record.stereo;
+        slot.signalled    = record.signalled;
+        __atomic_store_n( &slot.sequence, frame + 1, __ATOMIC_RELEASE );
+    }
+} g_stats = {};
+
+//-----------------------------------------------------------------------------
+
+/// Deletes a thread's stereo state when the thread exits
+void deleteStereoMap( void *map )
+{
+    delete static_cast<StereoMap*>( map );
+}
+
+//-----------------------------------------------------------------------------
+
+/// Class used to perform one-time initialisation at load time
+class Init {
+public:
+    pthread_key_t stereoKey;    ///< owns each thread's StereoMap
+
+    Init() {
+        g_config.load();
+        Log::get()
+            .setLevel( g_config.logLevel )
+            .open( "quadifier.log" );
+
+        // resolve the original functions (libGL is normally loaded by now,
+        // otherwise the first hook called tries once more)
+        g_real.resolve();
+
+        // publish per-swap statistics for external monitors
+        g_stats.open();
+
+        // the key deletes the stereo state of threads as they exit
+        pthread_key_create( &stereoKey, deleteStereoMap );
+    }
+
+    ~Init() {
+        g_stats.close();
+    }
+} g_init;
+
+//-----------------------------------------------------------------------------
+
+/// This thread's stereo state, and the state of its current drawable (the
+/// thread-local pointers need no locking, the map is owned by g_init's key)
+__thread StereoMap *t_stereoMap = 0;
+__thread Stereo    *t_current   = 0;
+
+//-----------------------------------------------------------------------------
+
+/// Returns this thread's stereo state for a drawable
+Stereo & stereoFor( GLXDrawable drawable )
+{
+    if ( t_stereoMap == 0 ) {
+        t_stereoMap = new StereoMap;
+        pthread_setspecific( g_init.stereoKey, t_stereoMap );
+    }
+    return (*t_stereoMap)[ drawable ];
+}
+
+//-----------------------------------------------------------------------------
+
+/// Returns the stereo state of this thread's current drawable
+Stereo & currentStereo()
+{
+    // the drawable may have been made current before we were loaded, or
+    // through a call we do not hook
+    if ( t_current == 0 ) t_current = &stereoFor( glXGetCurrentDrawable() );
+    return *t_current;
+}
+
+//-----------------------------------------------------------------------------
+
+/// Returns true if the screen's GLX extension string contains a name
+bool hasExtension( Display *dpy, const char *name )
+{
+    const char *extensions = glXQueryExtensionsString( dpy, DefaultScreen(dpy) );
+    if ( extensions == 0 ) return false;
+
+    // match whole names only (one name may prefix another)
+    const size_t length = strlen( name );
+    for (const char *p = extensions; (p = strstr( p, name )) != 0; p += length) {
+        bool start = ( p == extensions ) || ( p[-1] == ' ' );
+        bool end   = ( p[length] == ' ' ) || ( p[length] == 0 );
+        if ( start && end ) return true;
+    }
+    return false;
+}
+
+//-----------------------------------------------------------------------------
+
+/// The displays checked for GLX_OML_sync_control (libGL may export the OML
+/// functions whether or not the extension is there), and the last display
+/// each thread checked, so that swaps do not normally take the lock
+typedef std::map<Display*, bool> DisplayMap;
+DisplayMap g_omlDisplays;
+pthread_mutex_t g_omlMutex = PTHREAD_MUTEX_INITIALIZER;
+__thread Display *t_omlDisplay = 0;
+__thread bool     t_omlSupported = false;
+
+/// Returns true if the display advertises GLX_OML_sync_control (the
+/// extension string is only read the first time each display is seen)
+bool hasOmlSync( Display *dpy )
+{
+    if ( dpy == t_omlDisplay ) return t_omlSupported;
+
+    pthread_mutex_lock( &g_omlMutex );
+    DisplayMap::iterator i = g_omlDisplays.find( dpy );
+    if ( i == g_omlDisplays.end() ) {
+        const bool supported = hasExtension( dpy, "GLX_OML_sync_control" );
+        i = g_omlDisplays.insert( make_pair( dpy, supported ) ).first;
+        if ( !supported && g_config.omlPacing && Log::warning() )
+            Log::stream() << "GLX_OML_sync_control not supported" << endl;
+    }
+    t_omlDisplay   = dpy;
+    t_omlSupported = i->second;
+    pthread_mutex_unlock( &g_omlMutex );
+    return t_omlSupported;
+}
+
+//-----------------------------------------------------------------------------
+
+/// Join the configured NV swap group (and barrier) the first time a drawable
+/// is swapped, so that cluster nodes swap together
+void joinSwapGroup( Display *dpy, GLXDrawable drawable, Stereo & state )
+{
+    if ( state.swapJoined || (g_config.swapGroup == 0) ) return;
+    state.swapJoined = true;
+
+    if ( (g_real.glXJoinSwapGroupNV == 0) ||
+         !hasExtension( dpy, "GLX_NV_swap_group" )
+    ) {
+        if ( Log::warning() )
+            Log::stream() << "GLX_NV_swap_group not supported" << endl;
+        return;
+    }
+
+    GLuint maxGroups = 0, maxBarriers = 0;
+    if ( g_real.glXQueryMaxSwapGroupsNV )
+        g_real.glXQueryMaxSwapGroupsNV(
+            dpy, DefaultScreen(dpy), &maxGroups, &maxBarriers );
+
+    if ( !g_real.glXJoinSwapGroupNV( dpy, drawable, g_config.swapGroup ) ) {
+        if ( Log::error() )
+            Log::stream()
+                << "failed to join swap group " << g_config.swapGroup
+                << " (maximum " << maxGroups << ")" << endl;
+        return;
+    }
+
+    bool barrier = ( g_config.swapBarrier != 0 ) &&
+        g_real.glXBindSwapBarrierNV &&
+        g_real.glXBindSwapBarrierNV( dpy, g_config.swapGroup, g_config.swapBarrier );
+
+    if ( Log::detailed() ) {
+        Log::stream() << "joined swap group " << g_config.swapGroup << endl;
+        if ( g_config.swapBarrier != 0 ) {
+            Log::stream()
+                << (barrier ? "bound to swap barrier " : "failed to bind swap barrier ")
+                << g_config.swapBarrier << endl;
+        }
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 /// hook calls to glClear()
@@ -77,31 +492,104 @@ void glClear( GLbitfield mask )
     if ( Log::verbose() )
         Log::stream() << "glClear" << endl;
 
-    // obtain pointer to original function
-    static FN_glClear *original = reinterpret_cast<FN_glClear*>(
-        dlsym( RTLD_NEXT, "glClear" )
-    );
-    if ( original == 0 ) {
+    // pointer to original function
+    resolveOriginals();
+    FN_glClear *original = g_real.glClear;
+    if ( (original == 0) || (g_real.glDrawBuffer == 0) ) {
         // failed to obtain original function pointer
         if ( Log::error() )
             Log::stream() << "Failed to hook glClear" << endl;
         return;
     }
 
+    // the state of the drawable being cleared
+    Stereo & state = currentStereo();
+
     // if stereo is enabled, select the appropriate left/right buffer,
-    // otherwise select the back buffer
-    if ( !g_stereoDetect )
-        glDrawBuffer( GL_BACK );
-    else if ( g_clearCount < g_clearsPerEye )
-        glDrawBuffer( GL_BACK_LEFT );
+    // otherwise select the back buffer (the eye signal, when it is being
+    // sent, takes priority over counting the clears)
+    if ( state.signalled )
+        g_real.glDrawBuffer( state.signalledBuffer() );
+    else if ( !state.stereoDetect )
+        g_real.glDrawBuffer( GL_BACK );
+    else if ( state.clearCount < state.clearsPerEye )
+        g_real.glDrawBuffer( GL_BACK_LEFT );
     else
-        glDrawBuffer( GL_BACK_RIGHT );
+        g_real.glDrawBuffer( GL_BACK_RIGHT );
 
     // call the original function
     original( mask );
 
     // count the number of glClear calls
-    ++g_clearCount;
+    ++state.clearCount;
+}
+
+//-----------------------------------------------------------------------------
+
+/// hook calls to glDrawBuffer(), so that an application selecting the back
+/// buffer itself draws into the eye chosen by glClear
+void glDrawBuffer( GLenum mode )
+{
+    if ( Log::verbose() )
+        Log::stream() << "glDrawBuffer" << endl;
+
+    // pointer to original function
+    resolveOriginals();
+    FN_glDrawBuffer *original = g_real.glDrawBuffer;
+    if ( original == 0 ) {
+        // failed to obtain original function pointer
+        if ( Log::error() )
+            Log::stream() << "Failed to hook glDrawBuffer" << endl;
+        return;
+    }
+
+    // while in stereo, the back buffer means the current eye's back buffer
+    // (the clear count has already moved past the clear for this eye)
+    const Stereo & state = currentStereo();
+    if ( (mode == GL_BACK) || (mode == GL_FRONT_AND_BACK) ) {
+        if ( state.signalled )
+            mode = state.signalledBuffer();
+        else if ( state.stereoDetect )
+            mode = ( state.clearCount <= state.clearsPerEye ) ? GL_BACK_LEFT : GL_BACK_RIGHT;
+    }
+
+    // call the original function
+    original( mode );
+}
+
+//-----------------------------------------------------------------------------
+
+/// hook calls to glViewport(): a viewport of (1,*,2,3) is the signal from
+/// the Quadifier script that right eye rendering has started, the same
+/// protocol as IDirect3DDevice9::SetViewport on Windows
+void glViewport( GLint x, GLint y, GLsizei width, GLsizei height )
+{
+    // pointer to original function
+    resolveOriginals();
+    FN_glViewport *original = g_real.glViewport;
+    if ( (original == 0) || (g_real.glDrawBuffer == 0) ) {
+        // failed to obtain original function pointer
+        if ( Log::error() )
+            Log::stream() << "Failed to hook glViewport" << endl;
+        return;
+    }
+
+    if ( (x == 1) && (width == 2) && (height == 3) ) {
+        if ( Log::verbose() )
+            Log::stream() << "stereo signal" << endl;
+
+        Stereo & state = currentStereo();
+        if ( !state.signalled && Log::detailed() )
+            Log::stream() << "stereo enabled: eye signal received" << endl;
+
+        // switch to the right eye for the rest of this frame
+        state.signalled = true;
+        state.rightEye  = true;
+        g_real.glDrawBuffer( GL_BACK_RIGHT );
+    }
+
+    // pass on the call (the script sets its real viewport next)
+    original( x, y, width, height );
 }
 
 //-----------------------------------------------------------------------------
@@ -112,10 +600,9 @@ void glXSwapBuffers( Display *dpy, GLXDrawable drawable )
     if ( Log::verbose() )
         Log::stream() << "glXSwapBuffers" << endl;
 
-    // obtain pointer to original function
-    FN_glXSwapBuffers *original = reinterpret_cast<FN_glXSwapBuffers*>(
-        dlsym( RTLD_NEXT, "glXSwapBuffers" )
-    );
+    // pointer to original function
+    resolveOriginals();
+    FN_glXSwapBuffers *original = g_real.glXSwapBuffers;
     if ( original == 0 ) {
         // failed to obtain original function pointer
         if ( Log::error() )
@@ -123,42 +610,133 @@ void glXSwapBuffers( Display *dpy, GLXDrawable drawable )
         return;
     }
 
-    // call the original function
-    original( dpy, drawable );
-
-    // was stereo detected previously?
-    bool wasStereo = g_stereoDetect;
-
-    // detected stereo if there is more than one glClear per frame, and the
-    // number of glClear per frame is exactly divisible by two
-    g_stereoDetect = (g_clearCount > 1) && ((g_clearCount % 2) == 0);
-    
-    // if stereo is enabled, then g_clearsPerEye indicates how many glClear
-    // calls are expected per eye, otherwise zero
-    if ( g_stereoDetect )
-        g_clearsPerEye = g_clearCount / 2;
-    else
-        g_clearsPerEye = 0;
+    // the state of the drawable being swapped
+    Stereo & state = stereoFor( drawable );
+
+    // frame lock with the other cluster nodes, if configured
+    joinSwapGroup( dpy, drawable, state );
+
+    // are the OML sync values available for this drawable?
+    int64_t ust = 0, msc = 0, sbc = 0;
+    const bool oml = g_real.glXGetSyncValuesOML && hasOmlSync( dpy ) &&
+        g_real.glXGetSyncValuesOML( dpy, drawable, &ust, &msc, &sbc );
+    const bool pace = oml && g_config.omlPacing &&
+        g_real.glXSwapBuffersMscOML && g_real.glXWaitForSbcOML;
+
+    // call the original function, timing how long the swap takes; when
+    // pacing, swap at the vblank after the previous swap (or the next one
+    // if that has passed) and wait for it, so frames never queue up
+    const double swapStart = Clock::milliseconds();
+    if ( pace ) {
+        const int64_t target = state.lastMsc + 1;
+        const int64_t swap = ( target > msc ) ?
+            g_real.glXSwapBuffersMscOML( dpy, drawable, target, 0, 0 ) :
+            g_real.glXSwapBuffersMscOML( dpy, drawable, 0, 1, 0 );
+
+        // the swap returns its swap buffer count (not a vblank count): wait
+        // for that swap to complete, which gives the ust/msc it happened at
+        if ( (swap < 0) ||
+             !g_real.glXWaitForSbcOML( dpy, drawable, swap, &ust, &msc, &sbc )
+        ) {
+            g_real.glXGetSyncValuesOML( dpy, drawable, &ust, &msc, &sbc );
+        }
+    } else {
+        original( dpy, drawable );
+    }
+    const double swapEnd = Clock::milliseconds();
+
+    // report the vblank interval, and any missed vblanks, since the previous
+    // swap (when pacing, ust/msc are those of the vblank we swapped at)
+    if ( oml ) {
+        if ( !pace )
+            g_real.glXGetSyncValuesOML( dpy, drawable, &ust, &msc, &sbc );
+        if ( Log::verbose() && (state.lastMsc > 0) ) {
+            Log::stream()
+                << "msc +" << (msc - state.lastMsc) << ", "
+                << "ust " << 0.001 * double(ust - state.lastUst) << " ms" << endl;
+        } else if ( Log::detailed() && (state.lastMsc > 0) &&
+            (msc - state.lastMsc > 1)
+        ) {
+            Log::stream()
+                << (msc - state.lastMsc - 1) << " vblanks missed" << endl;
+        }
+        state.lastUst = ust;
+        state.lastMsc = msc;
+    }
+
+    // log the frame time (from the end of the previous swap to the start of
+    // this one) and the time spent in the swap itself
+    if ( Log::verbose() && (state.lastSwapTime > 0.0) ) {
+        Log::stream()
+            << "frame " << (swapStart - state.lastSwapTime) << " ms, "
+            << "swap " << (swapEnd - swapStart) << " ms" << endl;
+    }
+    const double swapInterval =
+        (state.lastSwapTime > 0.0) ? (swapEnd - state.lastSwapTime) : 0.0;
+    state.lastSwapTime = swapEnd;
+
+    // was stereo detected previously? was the eye signal seen this frame?
+    bool wasStereo = state.stereoDetect;
+    bool signalled = state.rightEye;
+
+    if ( state.signalled ) {
+        // the application is sending the eye signal: stereo lasts as long as
+        // the signal arrives every frame, otherwise go back to counting
+        state.stereoDetect = state.rightEye;
+        state.signalled    = state.rightEye;
+        state.clearsPerEye = 0;
+        state.rightEye     = false;
+        if ( !state.signalled && Log::detailed() )
+            Log::stream() << "eye signal lost" << endl;
+    } else {
+        // detected stereo if there is more than one glClear per frame, and
+        // the number of glClear per frame is exactly divisible by two
+        state.stereoDetect = (state.clearCount > 1) && ((state.clearCount % 2) == 0);
+
+        // if stereo is enabled, then clearsPerEye indicates how many glClear
+        // calls are expected per eye, otherwise zero
+        if ( state.stereoDetect )
+            state.clearsPerEye = state.clearCount / 2;
+        else
+            state.clearsPerEye = 0;
+    }
 
     if ( Log::verbose() ) {
         // log the number of glClears per frame
-        if ( g_clearCount > 1 )
-            Log::stream() << g_clearCount << " clears per frame" << endl;
+        if ( state.clearCount > 1 )
+            Log::stream() << state.clearCount << " clears per frame" << endl;
     }
 
     if ( Log::detailed() ) {
         // detect when stereo is enabled/disabled
-        if ( g_stereoDetect && !wasStereo ) {
+        if ( state.stereoDetect && !wasStereo && !state.signalled ) {
             Log::stream()
                 << "stereo enabled: "
-                << g_clearCount   << " sub-frames detected "
-                << "(" << g_clearsPerEye << " per eye)" << endl;
-        } else if ( wasStereo && !g_stereoDetect )
+                << state.clearCount   << " sub-frames detected "
+                << "(" << state.clearsPerEye << " per eye)" << endl;
+        } else if ( wasStereo && !state.stereoDetect )
             Log::stream() << "stereo disabled" << endl;
     }
 
+    // publish the frame's statistics
+    if ( g_stats.header ) {
+        timespec now;
+        clock_gettime( CLOCK_MONOTONIC, &now );
+
+        SharedStatsRecord record = {};
+        record.drawable     = drawable;
+        record.swapTime     = int64_t(now.tv_sec) * 1000000000 + now.tv_nsec;
+        record.swapInterval = swapInterval;
+        record.swapDuration = swapEnd - swapStart;
+        record.clearCount   = state.clearCount;
+        record.clearsPerEye = state.clearsPerEye;
+        record.stereo       = state.stereoDetect ? 1 : 0;
+        record.signalled    = signalled ? 1 : 0;
+        g_stats.write( record );
+    }
+
     // reset counter for next time
-    g_clearCount=0;
+    state.clearCount = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -171,10 +749,9 @@ GLXFBConfig *glXChooseFBConfig(
     if ( Log::verbose() )
         Log::stream() << "glXChooseFBConfig" << endl;
 
-    // obtain pointer to original function
-    FN_glXChooseFBConfig *original = reinterpret_cast<FN_glXChooseFBConfig*>(
-        dlsym( RTLD_NEXT, "glXChooseFBConfig" )
-    );
+    // pointer to original function
+    resolveOriginals();
+    FN_glXChooseFBConfig *original = g_real.glXChooseFBConfig;
     if ( original == 0 ) {
         // failed to obtain original function pointer
         if ( Log::error() )
@@ -234,3 +811,105 @@ GLXFBConfig *glXChooseFBConfig(
 
 //-----------------------------------------------------------------------------
 
+
+/// hook calls to glXMakeCurrent, to select the stereo state of the drawable
+Bool glXMakeCurrent( Display *dpy, GLXDrawable drawable, GLXContext ctx )
+{
+    if ( Log::verbose() )
+        Log::stream() << "glXMakeCurrent" << endl;
+
+    // pointer to original function
+    resolveOriginals();
+    FN_glXMakeCurrent *original = g_real.glXMakeCurrent;
+    if ( original == 0 ) {
+        // failed to obtain original function pointer
+        if ( Log::error() )
+            Log::stream() << "Failed to hook glXMakeCurrent" << endl;
+        return False;
+    }
+
+    // call the original function, then switch state if it succeeded
+    Bool result = original( dpy, drawable, ctx );
+    if ( result )
+        t_current = ( drawable != None ) ? &stereoFor( drawable ) : 0;
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+
+/// hook calls to glXMakeContextCurrent (as for glXMakeCurrent, stereo state
+/// follows the draw drawable)
+Bool glXMakeContextCurrent(
+    Display *dpy, GLXDrawable draw, GLXDrawable read, GLXContext ctx
+) {
+    if ( Log::verbose() )
+        Log::stream() << "glXMakeContextCurrent" << endl;
+
+    // pointer to original function
+    resolveOriginals();
+    FN_glXMakeContextCurrent *original = g_real.glXMakeContextCurrent;
+    if ( original == 0 ) {
+        // failed to obtain original function pointer
+        if ( Log::error() )
+            Log::stream() << "Failed to hook glXMakeContextCurrent" << endl;
+        return False;
+    }
+
+    // call the original function, then switch state if it succeeded
+    Bool result = original( dpy, draw, read, ctx );
+    if ( result )
+        t_current = ( draw != None ) ? &stereoFor( draw ) : 0;
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+
+/// Returns our hook for the named function, or zero if it is not hooked
+static void (*hookFor( const GLubyte *procName ))()
+{
+    typedef void (*Proc)();
+    const char *name = reinterpret_cast<const char*>( procName );
+    if ( name == 0 ) return 0;
+    if ( strcmp( name, "glClear" ) == 0 )
+        return reinterpret_cast<Proc>( &glClear );
+    if ( strcmp( name, "glDrawBuffer" ) == 0 )
+        return reinterpret_cast<Proc>( &glDrawBuffer );
+    if ( strcmp( name, "glViewport" ) == 0 )
+        return reinterpret_cast<Proc>( &glViewport );
+    if ( strcmp( name, "glXSwapBuffers" ) == 0 )
+        return reinterpret_cast<Proc>( &glXSwapBuffers );
+    if ( strcmp( name, "glXChooseFBConfig" ) == 0 )
+        return reinterpret_cast<Proc>( &glXChooseFBConfig );
+    if ( strcmp( name, "glXMakeCurrent" ) == 0 )
+        return reinterpret_cast<Proc>( &glXMakeCurrent );
+    if ( strcmp( name, "glXMakeContextCurrent" ) == 0 )
+        return reinterpret_cast<Proc>( &glXMakeContextCurrent );
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+
+/// hook calls to glXGetProcAddressARB, so that applications which look up
+/// the GL entry points at run time still call our hooks
+void (*glXGetProcAddressARB( const GLubyte *procName ))()
+{
+    if ( void (*hook)() = hookFor( procName ) ) return hook;
+
+    resolveOriginals();
+    if ( g_real.glXGetProcAddressARB == 0 ) return 0;
+    return g_real.glXGetProcAddressARB( procName );
+}
+
+//-----------------------------------------------------------------------------
+
+/// hook calls to glXGetProcAddress (as for glXGetProcAddressARB)
+void (*glXGetProcAddress( const GLubyte *procName ))()
+{
+    if ( void (*hook)() = hookFor( procName ) ) return hook;
+
+    resolveOriginals();
+    if ( g_real.glXGetProcAddress == 0 ) return 0;
+    return g_real.glXGetProcAddress( procName );
+}
+
+//-----------------------------------------------------------------------------
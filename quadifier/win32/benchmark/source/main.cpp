@@ -0,0 +1,543 @@
+#include <d3d9.h>
+#include <windows.h>
+#include <process.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "Clock.h"
+#include "Event.h"
+
+using namespace std;
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+namespace {
+
+/// A transport mode: the settings written to quadifier.ini for one run
+struct Mode {
+    const char * name;      ///< name on the command line and in the report
+    bool inject;            ///< load the module (false = raw Direct3D)
+    const char * settings;  ///< extra quadifier.ini lines
+};
+
+/// The modes measured when no mode is given on the command line
+const Mode modes[] = {
+    { "direct",   false, "" },
+    { "blit",     true,  "useTexture false\n" },
+    { "texture",  true,  "useTexture true\n" },
+    { "async",    true,  "asyncPresent true\n" },
+    { "zeroCopy", true,  "zeroCopy true\n" },
+    { "readback", true,  "readback true\n" },
+};
+const unsigned modeCount = sizeof(modes) / sizeof(modes[0]);
+
+/// Frames rendered before timing starts
+const unsigned warmupFrames = 60;
+
+/// Time allowed for each child run (milliseconds)
+const DWORD runTimeout = 5 * 60 * 1000;
+
+/// Name of the file each child run writes its results to
+const char * const resultName = "result.txt";
+
+/// The synthetic application being measured
+struct Options {
+    unsigned width;     ///< back buffer width
+    unsigned height;    ///< back buffer height
+    unsigned msaa;      ///< samples per pixel (0 = none)
+    unsigned draws;     ///< draw calls per eye
+    unsigned frames;    ///< frames timed after the warm-up
+    bool stereo;        ///< send the stereo signal between the eyes?
+    std::string mode;   ///< mode to run in this process (empty = all)
+    bool events;        ///< measure Event instead of the pipeline?
+
+    Options() :
+        width( 1280 ),
+        height( 720 ),
+        msaa( 0 ),
+        draws( 500 ),
+        frames( 600 ),
+        stereo( true ),
+        events( false )
+    {
+    }
+
+    /// Returns the options as command line arguments
+    std::string arguments() const {
+        ostringstream args;
+        args << "-width " << width << " -height " << height
+             << " -msaa " << msaa << " -draws " << draws
+             << " -frames " << frames << (stereo ? "" : " -mono");
+        return args.str();
+    }
+};
+
+/// The results of one run
+struct Result {
+    double fps;         ///< frames per second
+    double p50;         ///< frame time percentiles (milliseconds)
+    double p90;
+    double p99;
+    double max;
+    double callNs;      ///< time per device call (nanoseconds)
+};
+
+/// Vertex of a screen space triangle
+struct Vertex {
+    float x, y, z, rhw;
+    DWORD colour;
+};
+
+//-----------------------------------------------------------------------------
+
+/// Returns the directory containing this executable, with a trailing slash
+std::string exeDirectory()
+{
+    char path[MAX_PATH] = {};
+    GetModuleFileNameA( 0, path, MAX_PATH );
+    std::string directory( path );
+    return directory.substr( 0, directory.find_last_of( "\\/" ) + 1 );
+}
+
+//-----------------------------------------------------------------------------
+
+/// Returns a percentile (0..1) of sorted samples
+double percentile( const std::vector<double> & sorted, double fraction )
+{
+    if ( sorted.empty() ) return 0.0;
+    size_t index = static_cast<size_t>( fraction * (sorted.size() - 1) + 0.5 );
+    return sorted[ std::min( index, sorted.size() - 1 ) ];
+}
+
+//-----------------------------------------------------------------------------
+
+/// Draw one eye: a clear followed by a number of small triangles
+void drawEye( IDirect3DDevice9 *device, const Options & options, unsigned eye )
+{
+    const float w = static_cast<float>( options.width );
+    const float h = static_cast<float>( options.height );
+
+    D3DVIEWPORT9 viewport = { 0, 0, options.width, options.height, 0.f, 1.f };
+    device->SetViewport( &viewport );
+    device->Clear( 0, 0, D3DCLEAR_TARGET, eye ? 0xff000040 : 0xff400000, 1.f, 0 );
+
+    for (unsigned i=0; i<options.draws; ++i) {
+        // spread the triangles over the screen, offset for each eye
+        float x = w * ((i * 37) % 100) / 100.f + (eye ? 4.f : -4.f);
+        float y = h * ((i * 61) % 100) / 100.f;
+        DWORD colour = 0xff000000 | (i * 0x010307);
+        Vertex triangle[3] = {
+            { x,         y,         0.5f, 1.f, colour },
+            { x + 32.f,  y,         0.5f, 1.f, colour },
+            { x,         y + 32.f,  0.5f, 1.f, colour },
+        };
+        device->SetRenderState( D3DRS_TEXTUREFACTOR, colour );
+        device->DrawPrimitiveUP( D3DPT_TRIANGLELIST, 1, triangle, sizeof(Vertex) );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+/// The previous Event implementation on Windows: an auto-reset event object,
+/// so every signal and wait is a system call
+struct KernelEvent {
+    HANDLE handle;
+
+    KernelEvent() : handle( CreateEvent( 0, FALSE, FALSE, 0 ) ) {}
+    ~KernelEvent() { CloseHandle( handle ); }
+
+    void signal() { SetEvent( handle ); }
+
+    bool wait( unsigned milliseconds = 0 ) {
+        return WaitForSingleObject( handle,
+            milliseconds ? milliseconds : INFINITE ) == WAIT_OBJECT_0;
+    }
+};
+
+//-----------------------------------------------------------------------------
+
+/// Measures an event type: signal/wait on one thread (like m_frameDone when
+/// GL is ahead), and round trips between two threads
+template <typename E>
+struct EventTimer {
+    E ping;             ///< signalled by the main thread
+    E pong;             ///< signalled by the echo thread
+    unsigned count;     ///< number of iterations
+
+    explicit EventTimer( unsigned count ) : count( count ) {}
+
+    /// Echo each ping back as a pong
+    static unsigned __stdcall echo( void *param ) {
+        EventTimer *timer = static_cast<EventTimer*>( param );
+        for (unsigned i=0; i<timer->count; ++i) {
+            timer->ping.wait();
+            timer->pong.signal();
+        }
+        return 0;
+    }
+
+    /// Returns the time for a signal followed by a wait (nanoseconds)
+    double uncontended() {
+        double start = Clock::seconds();
+        for (unsigned i=0; i<count; ++i) {
+            ping.signal();
+            ping.wait( 1000 );
+        }
+        return 1e9 * (Clock::seconds() - start) / count;
+    }
+
+    /// Returns the time for a round trip between two threads (nanoseconds)
+    double roundTrip() {
+        HANDLE thread = reinterpret_cast<HANDLE>(
+            _beginthreadex( 0, 0, echo, this, 0, 0 ) );
+        if ( thread == 0 ) return 0.0;
+
+        double start = Clock::seconds();
+        for (unsigned i=0; i<count; ++i) {
+            ping.signal();
+            pong.wait( 1000 );
+        }
+        double elapsed = Clock::seconds() - start;
+
+        WaitForSingleObject( thread, INFINITE );
+        CloseHandle( thread );
+        return 1e9 * elapsed / count;
+    }
+};
+
+//-----------------------------------------------------------------------------
+
+/// Compare Event with the kernel event object it replaced
+void runEvents( const Options & options )
+{
+    // use the frame count as a scale for the number of iterations
+    const unsigned count = 100 * options.frames;
+
+    EventTimer<Event> event( count );
+    EventTimer<KernelEvent> kernel( count );
+
+    char line[160];
+    sprintf_s( line, "%-12s %14s %14s\n", "event", "signal+wait ns", "round trip ns" );
+    cout << line;
+    sprintf_s( line, "%-12s %14.1f %14.1f\n", "Event",
+        event.uncontended(), event.roundTrip() );
+    cout << line;
+    sprintf_s( line, "%-12s %14.1f %14.1f\n", "event object",
+        kernel.uncontended(), kernel.roundTrip() );
+    cout << line;
+}
+
+//-----------------------------------------------------------------------------
+
+/// Run the synthetic application in this process, returns true on success
+bool runMode( const Options & options, const Mode & mode, Result & result )
+{
+    // load the module first so that it hooks Direct3DCreate9
+    if ( mode.inject ) {
+        std::string moduleName( exeDirectory() + "module.dll" );
+        if ( LoadLibraryA( moduleName.c_str() ) == 0 ) {
+            cerr << "error: failed to load " << moduleName << endl;
+            return false;
+        }
+    }
+
+    // an application window which is never shown
+    WNDCLASSA windowClass = {};
+    windowClass.lpfnWndProc   = DefWindowProcA;
+    windowClass.hInstance     = GetModuleHandle( 0 );
+    windowClass.lpszClassName = "QuadifierBenchmark";
+    RegisterClassA( &windowClass );
+
+    RECT rect = { 0, 0, LONG(options.width), LONG(options.height) };
+    AdjustWindowRect( &rect, WS_OVERLAPPEDWINDOW, FALSE );
+    HWND window = CreateWindowA( windowClass.lpszClassName, "benchmark",
+        WS_OVERLAPPEDWINDOW, 0, 0, rect.right - rect.left,
+        rect.bottom - rect.top, 0, 0, windowClass.hInstance, 0 );
+    if ( window == 0 ) {
+        cerr << "error: failed to create window\n";
+        return false;
+    }
+
+    IDirect3D9 *direct3D = Direct3DCreate9( D3D_SDK_VERSION );
+    if ( direct3D == 0 ) {
+        cerr << "error: Direct3DCreate9 failed\n";
+        DestroyWindow( window );
+        return false;
+    }
+
+    D3DPRESENT_PARAMETERS params = {};
+    params.BackBufferWidth      = options.width;
+    params.BackBufferHeight     = options.height;
+    params.BackBufferFormat     = D3DFMT_X8R8G8B8;
+    params.BackBufferCount      = 1;
+    params.SwapEffect           = D3DSWAPEFFECT_DISCARD;
+    params.hDeviceWindow        = window;
+    params.Windowed             = TRUE;
+    params.PresentationInterval = D3DPRESENT_INTERVAL_IMMEDIATE;
+
+    // fall back to no multisampling if the requested count is unsupported
+    D3DMULTISAMPLE_TYPE samples = static_cast<D3DMULTISAMPLE_TYPE>( options.msaa );
+    if ( (options.msaa > 1) && SUCCEEDED( direct3D->CheckDeviceMultiSampleType(
+            D3DADAPTER_DEFAULT, D3DDEVTYPE_HAL, params.BackBufferFormat,
+            TRUE, samples, 0 ) )
+    ) {
+        params.MultiSampleType = samples;
+    } else if ( options.msaa > 1 ) {
+        cerr << "warning: " << options.msaa << "x MSAA unsupported\n";
+    }
+
+    IDirect3DDevice9 *device = 0;
+    HRESULT hr = direct3D->CreateDevice( D3DADAPTER_DEFAULT, D3DDEVTYPE_HAL,
+        window, D3DCREATE_HARDWARE_VERTEXPROCESSING, &params, &device );
+    if ( FAILED(hr) ) {
+        cerr << "error: CreateDevice failed (" << hr << ")\n";
+        direct3D->Release();
+        DestroyWindow( window );
+        return false;
+    }
+
+    device->SetFVF( D3DFVF_XYZRHW | D3DFVF_DIFFUSE );
+    device->SetRenderState( D3DRS_LIGHTING, FALSE );
+    device->SetRenderState( D3DRS_CULLMODE, D3DCULL_NONE );
+
+    // the viewport used by the Quadifier script to mark the right eye
+    D3DVIEWPORT9 signal = { 1, 0, 2, 3, 0.f, 1.f };
+
+    std::vector<double> frameTimes;
+    frameTimes.reserve( options.frames );
+    double callTime = 0.0;
+    double start = 0.0;
+    double last = 0.0;
+
+    for (unsigned frame=0; frame<warmupFrames+options.frames; ++frame) {
+        // keep the window responsive
+        MSG msg;
+        while ( PeekMessage( &msg, 0, 0, 0, PM_REMOVE ) ) {
+            TranslateMessage( &msg );
+            DispatchMessage( &msg );
+        }
+
+        device->BeginScene();
+        double drawStart = Clock::seconds();
+        drawEye( device, options, 0 );
+        double drawTime = Clock::seconds() - drawStart;
+        if ( options.stereo ) {
+            device->SetViewport( &signal );
+            drawStart = Clock::seconds();
+            drawEye( device, options, 1 );
+            drawTime += Clock::seconds() - drawStart;
+        }
+        device->EndScene();
+        device->Present( 0, 0, 0, 0 );
+
+        double now = Clock::seconds();
+        if ( frame == warmupFrames ) {
+            start = now;
+        } else if ( frame > warmupFrames ) {
+            frameTimes.push_back( 1000.0 * (now - last) );
+            callTime += drawTime;
+        }
+        last = now;
+    }
+
+    device->Release();
+    direct3D->Release();
+    DestroyWindow( window );
+
+    // each eye makes a viewport, a clear and two calls per draw
+    unsigned eyes = options.stereo ? 2 : 1;
+    double calls = double(frameTimes.size()) * eyes * (2.0 + 2.0 * options.draws);
+
+    std::sort( frameTimes.begin(), frameTimes.end() );
+    result.fps    = frameTimes.empty() ? 0.0 : frameTimes.size() / (last - start);
+    result.p50    = percentile( frameTimes, 0.50 );
+    result.p90    = percentile( frameTimes, 0.90 );
+    result.p99    = percentile( frameTimes, 0.99 );
+    result.max    = frameTimes.empty() ? 0.0 : frameTimes.back();
+    result.callNs = (calls > 0.0) ? 1e9 * callTime / calls : 0.0;
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+/// Run one mode in a child process, in its own directory (so that it reads
+/// its own quadifier.ini), returns true if it wrote a result
+bool runChild( const Options & options, const Mode & mode, Result & result )
+{
+    char temp[MAX_PATH] = {};
+    GetTempPathA( MAX_PATH, temp );
+    std::string directory( std::string(temp) + "quadifier-benchmark\\" );
+    CreateDirectoryA( directory.c_str(), 0 );
+    directory += std::string( mode.name ) + "\\";
+    CreateDirectoryA( directory.c_str(), 0 );
+
+    // the settings for this mode, leaving everything else at the defaults
+    {
+        ofstream ini( (directory + "quadifier.ini").c_str() );
+        ini << "passThrough false\n"
+            << "stereoIndicator false\n"
+            << "statsInterval 0\n"
+            << mode.settings
+            << "logLevel warning\n";
+    }
+    DeleteFileA( (directory + resultName).c_str() );
+
+    char path[MAX_PATH] = {};
+    GetModuleFileNameA( 0, path, MAX_PATH );
+    std::string commandLine( "\"" + std::string(path) + "\" -mode " +
+        mode.name + " " + options.arguments() );
+
+    STARTUPINFOA startup = {};
+    startup.cb = sizeof(startup);
+    PROCESS_INFORMATION process = {};
+    if ( !CreateProcessA( 0, &commandLine[0], 0, 0, FALSE, 0, 0,
+        directory.c_str(), &startup, &process )
+    ) {
+        cerr << "error: failed to start " << mode.name << " run\n";
+        return false;
+    }
+
+    if ( WaitForSingleObject( process.hProcess, runTimeout ) != WAIT_OBJECT_0 ) {
+        cerr << "error: " << mode.name << " run timed out\n";
+        TerminateProcess( process.hProcess, 1 );
+    }
+    CloseHandle( process.hThread );
+    CloseHandle( process.hProcess );
+
+    ifstream input( (directory + resultName).c_str() );
+    input >> result.fps >> result.p50 >> result.p90 >> result.p99
+          >> result.max >> result.callNs;
+    return !input.fail();
+}
+
+//-----------------------------------------------------------------------------
+
+/// Parse the command line, returns false for unknown options
+bool parse( int argc, char **argv, Options & options )
+{
+    for (int i=1; i<argc; ++i) {
+        std::string arg( argv[i] );
+        bool hasValue = (i + 1 < argc);
+        if ( arg == "-mono" )
+            options.stereo = false;
+        else if ( arg == "-events" )
+            options.events = true;
+        else if ( hasValue && (arg == "-mode") )
+            options.mode = argv[++i];
+        else if ( hasValue && (arg == "-width") )
+            options.width = std::max( 16ul, strtoul( argv[++i], 0, 10 ) );
+        else if ( hasValue && (arg == "-height") )
+            options.height = std::max( 16ul, strtoul( argv[++i], 0, 10 ) );
+        else if ( hasValue && (arg == "-msaa") )
+            options.msaa = std::min( 16ul, strtoul( argv[++i], 0, 10 ) );
+        else if ( hasValue && (arg == "-draws") )
+            options.draws = strtoul( argv[++i], 0, 10 );
+        else if ( hasValue && (arg == "-frames") )
+            options.frames = std::max( 1ul, strtoul( argv[++i], 0, 10 ) );
+        else
+            return false;
+    }
+    return true;
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+
+int main( int argc, char **argv )
+{
+    Options options;
+    if ( !parse( argc, argv, options ) ) {
+        cerr << "usage: benchmark [-width w] [-height h] [-msaa samples]"
+                " [-draws count] [-frames count] [-mono] [-mode name]"
+                " [-events]\n"
+                "modes:";
+        for (unsigned i=0; i<modeCount; ++i) cerr << " " << modes[i].name;
+        cerr << endl;
+        return 1;
+    }
+
+    // the Event microbenchmark instead of the pipeline
+    if ( options.events ) {
+        runEvents( options );
+        return 0;
+    }
+
+    // a single mode: run it here and write the results for the parent
+    if ( !options.mode.empty() ) {
+        for (unsigned i=0; i<modeCount; ++i) {
+            if ( options.mode != modes[i].name ) continue;
+            Result result;
+            if ( !runMode( options, modes[i], result ) ) return 1;
+            ofstream output( resultName );
+            output << result.fps << " " << result.p50 << " " << result.p90
+                   << " " << result.p99 << " " << result.max << " "
+                   << result.callNs << endl;
+            return 0;
+        }
+        cerr << "error: unknown mode " << options.mode << endl;
+        return 1;
+    }
+
+    // otherwise run every mode in turn, each in a new process
+    cout << options.width << "x" << options.height << ", "
+         << options.msaa << "x MSAA, " << options.draws << " draws per eye, "
+         << (options.stereo ? "stereo" : "mono") << ", "
+         << options.frames << " frames\n\n";
+
+    char line[160];
+    sprintf_s( line, "%-10s %8s %8s %8s %8s %8s %9s %9s\n", "mode", "fps",
+        "p50 ms", "p90 ms", "p99 ms", "max ms", "ns/call", "overhead" );
+    cout << line;
+
+    double directNs = 0.0;
+    for (unsigned i=0; i<modeCount; ++i) {
+        Result result;
+        if ( !runChild( options, modes[i], result ) ) {
+            sprintf_s( line, "%-10s %8s\n", modes[i].name, "failed" );
+            cout << line << flush;
+            continue;
+        }
+
+        // proxy cost per call, relative to the raw Direct3D run
+        if ( !modes[i].inject ) directNs = result.callNs;
+        double overhead = (directNs > 0.0) ? result.callNs - directNs : 0.0;
+        sprintf_s( line, "%-10s %8.1f %8.2f %8.2f %8.2f %8.2f %9.1f %9.1f\n",
+            modes[i].name, result.fps, result.p50, result.p90, result.p99,
+            result.max, result.callNs, overhead );
+        cout << line << flush;
+    }
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
@@ -5,6 +5,7 @@
 #include <iostream>
 #include <Tlhelp32.h>
 #include <windows.h>
+#include <process.h>
 #include <VersionHelpers.h>
 #include "Defines.h"
 #include "NtCreateThreadEx.h"
@@ -87,7 +88,7 @@ struct Data {
     PFNGetLastError         GetLastError;
     void                   *threadExitFunc;         ///< Thread exit function
     char                    pathName[_MAX_PATH];    ///< DLL path name
-} g_data;
+};
 
 #ifdef _M_X64
 // The 64-bit loader code is linked from an external assembler file,
@@ -172,7 +173,7 @@ bool enablePrivilege( HANDLE process, LPCSTR privilege )
 
 //-----------------------------------------------------------------------------
 
-bool hive::injectDLL( DWORD processId, const std::string & pathName )
+bool hive::injectDLL( DWORD processId, const std::string & pathName, DWORD timeout )
 {
     HANDLE process = 0;
     HANDLE thread  = 0;
@@ -180,8 +181,10 @@ bool hive::injectDLL( DWORD processId, const std::string & pathName )
 
     bool result = false;
 
-    // zero fill the data structure
-    memset( &g_data, 0, sizeof(g_data) );
+    // the data structure copied into the target process (local, so that
+    // several injections can run at once)
+    Data data;
+    memset( &data, 0, sizeof(data) );
 
     // load kernel32
     HMODULE kernel32 = LoadLibrary( "kernel32.dll" );
@@ -230,29 +233,29 @@ bool hive::injectDLL( DWORD processId, const std::string & pathName )
         );
         if ( process == 0 ) break;
 
-        // obtain function pointer to LoadLibraryA and store in g_data
-        g_data.LoadLibrary = reinterpret_cast<PFNLoadLibraryA>(
+        // obtain function pointer to LoadLibraryA and store in data
+        data.LoadLibrary = reinterpret_cast<PFNLoadLibraryA>(
             GetProcAddress( kernel32, "LoadLibraryA" ) );
-        if ( g_data.LoadLibrary == 0 ) break;
+        if ( data.LoadLibrary == 0 ) break;
 
-        // obtain function pointer to GetLastError and store in g_data
-        g_data.GetLastError = reinterpret_cast<PFNGetLastError>(
+        // obtain function pointer to GetLastError and store in data
+        data.GetLastError = reinterpret_cast<PFNGetLastError>(
             GetProcAddress( kernel32, "GetLastError" ) );
-        if ( g_data.GetLastError == 0 ) break;
+        if ( data.GetLastError == 0 ) break;
 
-        // obtain function pointer to ExitThread and store in g_data
-        g_data.ExitThread = reinterpret_cast<PFNExitThread>(
+        // obtain function pointer to ExitThread and store in data
+        data.ExitThread = reinterpret_cast<PFNExitThread>(
             GetProcAddress( kernel32, "ExitThread" ) );
-        if ( g_data.ExitThread == 0 ) break;
+        if ( data.ExitThread == 0 ) break;
 
-        // obtain function pointer to RtlExitUserThread and store in g_data
-        g_data.RtlExitUserThread = reinterpret_cast<PFNRtlExitUserThread>(
+        // obtain function pointer to RtlExitUserThread and store in data
+        data.RtlExitUserThread = reinterpret_cast<PFNRtlExitUserThread>(
             GetProcAddress( ntdll, "RtlExitUserThread" ) );
-        if ( g_data.RtlExitUserThread == 0 ) break;
+        if ( data.RtlExitUserThread == 0 ) break;
 
         // copy the DLL path name into the data structure
         strncpy_s(
-            g_data.pathName, sizeof(g_data.pathName),
+            data.pathName, sizeof(data.pathName),
             fullPath, _TRUNCATE
         );
 
@@ -275,7 +278,7 @@ bool hive::injectDLL( DWORD processId, const std::string & pathName )
         size_t codeSize = codeEndPtr - codeBeginPtr;
 
         // size of data
-        unsigned dataSize = sizeof(g_data);
+        unsigned dataSize = sizeof(data);
 
         // total memory required
         size_t memorySize = codeSize + dataSize;
@@ -340,7 +343,7 @@ bool hive::injectDLL( DWORD processId, const std::string & pathName )
 
         } local(                    // initialisation
             process, dataAddress,
-            &g_data, dataSize
+            &data, dataSize
         );
 
         // initialise OS version info structure
@@ -358,7 +361,7 @@ bool hive::injectDLL( DWORD processId, const std::string & pathName )
 
         // CreateRemoteThread
         // -install the appropriate thread exit function
-        g_data.threadExitFunc = g_data.ExitThread;
+        data.threadExitFunc = data.ExitThread;
         if ( !local.writeProcessMemory() ) break;
         // -create remote thread and execute code inside target process
         thread = CreateRemoteThread(
@@ -371,7 +374,7 @@ bool hive::injectDLL( DWORD processId, const std::string & pathName )
         if ( ( thread == 0 ) && vistaUp ) {
             // NtCreateThreadEx
             // -install the appropriate thread exit function
-            g_data.threadExitFunc = g_data.RtlExitUserThread;
+            data.threadExitFunc = data.RtlExitUserThread;
             if ( !local.writeProcessMemory() ) break;
             // -create remote thread and execute code inside target process
             thread = SimpleNtCreateThreadEx(
@@ -384,7 +387,7 @@ bool hive::injectDLL( DWORD processId, const std::string & pathName )
         if ( ( thread == 0 ) && vistaUp ) {
             // RtlCreateUserThread
             // -install the appropriate thread exit function
-            g_data.threadExitFunc = g_data.RtlExitUserThread;
+            data.threadExitFunc = data.RtlExitUserThread;
             if ( !local.writeProcessMemory() ) break;
 
             // -create remote thread and execute code inside target process,
@@ -402,7 +405,14 @@ bool hive::injectDLL( DWORD processId, const std::string & pathName )
 
         if (thread != 0) {
             // wait for thread to terminate
-            WaitForSingleObject( thread, INFINITE );
+            if ( WaitForSingleObject( thread, timeout ) != WAIT_OBJECT_0 ) {
+                // the loader code may still be running, so its memory must
+                // be left allocated in the target process
+                cerr << "error: injection into process " << processId
+                     << " timed out" << endl;
+                memory = 0;
+                break;
+            }
 
             // success depends on thread exit code
             DWORD exitCode = 0;
@@ -436,7 +446,9 @@ bool hive::createProcessWithDLL(
     const std::string & applicationName,
     const std::string & DLLName,
     const std::string & commandLine,
-    const std::string & currentDirectory
+    const std::string & currentDirectory,
+    DWORD timeout,
+    DWORD *processId
 ) {
     STARTUPINFO startupInfo = { sizeof(startupInfo) };
     PROCESS_INFORMATION processInfo = {};
@@ -461,12 +473,19 @@ bool hive::createProcessWithDLL(
         cerr << "failed to create process" << endl;
         return false;
     }
+    if ( processId != 0 ) *processId = processInfo.dwProcessId;
+
+    // the event which the DLL signals once it has installed its hooks
+    // (created before injecting, so that the DLL can open it in DllMain)
+    HANDLE ready = CreateEventA(
+        0, TRUE, FALSE, readyEventName( processInfo.dwProcessId ).c_str()
+    );
 
     // attempt to inject the DLL
     bool injected = false;
     int  attempts = 0;
     for (; (attempts<2) && !injected; ++attempts)
-        injected = injectDLL( processInfo.dwProcessId, DLLName );
+        injected = injectDLL( processInfo.dwProcessId, DLLName, timeout );
 
     if ( !injected )
         cerr << "error: failed to inject" << endl;
@@ -477,18 +496,97 @@ bool hive::createProcessWithDLL(
     // resume the main thread
     if ( ResumeThread( processInfo.hThread ) == static_cast<DWORD>(-1) ) {
         TerminateThread( processInfo.hThread, 0 );
+        if ( ready != 0 ) CloseHandle( ready );
+        CloseHandle( processInfo.hProcess );
+        CloseHandle( processInfo.hThread );
         return false;
     }
 
-    // wait for it to start up (as near as we can tell)
-    Sleep(1000);
-    WaitForInputIdle( processInfo.hProcess, 1000 );
+    // wait for the DLL to report that it is ready; the injection runs
+    // DllMain to completion, so this is normally signalled already, and
+    // the timeout only matters if the hooks failed (or the process exited)
+    bool isReady = false;
+    if ( injected && (ready != 0) ) {
+        HANDLE handles[2] = { ready, processInfo.hProcess };
+        isReady = WaitForMultipleObjects( 2, handles, FALSE, timeout )
+            == WAIT_OBJECT_0;
+        if ( !isReady )
+            cerr << "error: " << DLLName << " did not report ready" << endl;
+    }
 
-    // close process and thread handles
+    // close event, process and thread handles
+    if ( ready != 0 ) CloseHandle( ready );
     CloseHandle( processInfo.hProcess );
     CloseHandle( processInfo.hThread );
 
-    return true;
+    return isReady;
 }//createProcessWithDLL
 
 //-----------------------------------------------------------------------------
+
+namespace {
+
+/// one target of injectDLLs, and the parameters common to all of them
+struct BatchItem {
+    InjectTarget       *target;
+    const std::string  *DLLName;
+    DWORD               timeout;
+};
+
+/// injects into (or launches) one target of injectDLLs
+unsigned __stdcall injectThread( void *userData )
+{
+    BatchItem *item = reinterpret_cast<BatchItem*>( userData );
+    InjectTarget & target = *item->target;
+
+    if ( target.processId != 0 )
+        target.result = injectDLL( target.processId, *item->DLLName, item->timeout );
+    else
+        target.result = createProcessWithDLL(
+            target.applicationName, *item->DLLName, target.commandLine,
+            target.currentDirectory, item->timeout, &target.launchedId
+        );
+    return 0;
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+
+bool hive::injectDLLs(
+    std::vector<InjectTarget> & targets,
+    const std::string & DLLName,
+    DWORD timeout
+) {
+    std::vector<BatchItem> items( targets.size() );
+    std::vector<HANDLE> threads( targets.size(), HANDLE(0) );
+
+    // start one thread per target, so that the waits overlap
+    for (size_t i=0; i<targets.size(); ++i) {
+        targets[i].result = false;
+        targets[i].launchedId = 0;
+        items[i].target  = &targets[i];
+        items[i].DLLName = &DLLName;
+        items[i].timeout = timeout;
+        threads[i] = reinterpret_cast<HANDLE>(
+            _beginthreadex( 0, 0, injectThread, &items[i], 0, 0 )
+        );
+
+        // no thread: do this one now
+        if ( threads[i] == 0 ) injectThread( &items[i] );
+    }
+
+    // each thread is bounded by the timeouts, so this wait is too
+    bool result = true;
+    for (size_t i=0; i<targets.size(); ++i) {
+        if ( threads[i] != 0 ) {
+            WaitForSingleObject( threads[i], INFINITE );
+            CloseHandle( threads[i] );
+        }
+        result = result && targets[i].result;
+    }
+
+    return result;
+}//injectDLLs
+
+//-----------------------------------------------------------------------------
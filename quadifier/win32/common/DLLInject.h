@@ -1,58 +1,104 @@
-#ifndef hive_DLLInject_h
-#define hive_DLLInject_h
-
-//-----------------------------------------------------------------------------
-//
-// Copyright (C) 2012-14 James Ward, University of Hull
-//
-// This software is provided 'as-is', without any express or implied
-// warranty. In no event will the authors be held liable for any damages
-// arising from the use of this software.
-//
-// Permission is granted to anyone to use this software for any purpose,
-// including commercial applications, and to alter it and redistribute it
-// freely, subject to the following restrictions:
-//
-//    1. The origin of this software must not be misrepresented; you must not
-//    claim that you wrote the original software.
-//
-//    2. If you use this software in a product, an acknowledgment in the
-//    product documentation is required.
-//
-//    3. Altered source versions must be plainly marked as such, and must not
-//    be misrepresented as being the original software.
-//
-//    4. This notice may not be removed or altered from any source
-//    distribution.
-//
-//-----------------------------------------------------------------------------
-
-#include <windows.h>
-#include <string>
-
-//-----------------------------------------------------------------------------
-
-namespace hive {
-
-/**
- * Injects a DLL into the specified process, given the process ID (PID) and the
- * filename of the DLL to inject. Returns true for success, false otherwise.
- */
-bool injectDLL( DWORD processId, const std::string & DLLName );
-
-/**
- * Creates a process and injects a DLL into it. Returns true for success, false
- * otherwise.
- */
-bool createProcessWithDLL(
-    const std::string & applicationName,
-    const std::string & DLLName,
-    const std::string & commandLine = "",
-    const std::string & currentDirectory = ""
-);
-
-} // namespace hive
-
-//-----------------------------------------------------------------------------
-
+#ifndef hive_DLLInject_h
+#define hive_DLLInject_h
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+#include <windows.h>
+#include <string>
+#include <vector>
+#include <cstdio>
+
+//-----------------------------------------------------------------------------
+
+namespace hive {
+
+/**
+ * Injects a DLL into the specified process, given the process ID (PID) and the
+ * filename of the DLL to inject, waiting up to timeout milliseconds for it to
+ * load. Returns true for success, false otherwise.
+ */
+bool injectDLL(
+    DWORD processId,
+    const std::string & DLLName,
+    DWORD timeout = INFINITE
+);
+
+/**
+ * Creates a process and injects a DLL into it, then resumes the process and
+ * waits up to timeout milliseconds for the DLL to signal the event named by
+ * readyEventName (the injection itself has the same timeout). Returns true
+ * once the DLL has reported ready, false otherwise; the ID of the process
+ * is stored in processId (if given) once it has been created.
+ */
+bool createProcessWithDLL(
+    const std::string & applicationName,
+    const std::string & DLLName,
+    const std::string & commandLine = "",
+    const std::string & currentDirectory = "",
+    DWORD timeout = 5000,
+    DWORD *processId = 0
+);
+
+/// A target of injectDLLs: an executable to launch, or a running process
+struct InjectTarget {
+    std::string applicationName;    ///< executable to launch (if no processId)
+    std::string commandLine;        ///< command line options to launch with
+    std::string currentDirectory;   ///< directory to launch in ("" = current)
+    DWORD       processId;          ///< running process to inject into (or 0)
+    DWORD       launchedId;         ///< out: ID of the launched process (or 0)
+    bool        result;             ///< out: was the DLL injected (and ready)?
+
+    InjectTarget() : processId( 0 ), launchedId( 0 ), result( false ) {}
+};
+
+/**
+ * Injects a DLL into all of the targets concurrently (one thread each),
+ * launching those which are executables, with the given timeout applying to
+ * each target. Sets the result of every target, and returns true if all of
+ * them succeeded.
+ */
+bool injectDLLs(
+    std::vector<InjectTarget> & targets,
+    const std::string & DLLName,
+    DWORD timeout = 5000
+);
+
+/**
+ * Returns the name of the event which the injected module signals in the
+ * given process once its hooks (Direct3DCreate9 at least) are installed.
+ */
+inline std::string readyEventName( DWORD processId ) {
+    char name[64];
+    sprintf_s( name, sizeof(name), "Local\\quadifier-ready-%lu", processId );
+    return name;
+}
+
+} // namespace hive
+
+//-----------------------------------------------------------------------------
+
 #endif//hive_DLLInject_h
\ No newline at end of file
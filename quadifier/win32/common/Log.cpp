@@ -1,145 +1,373 @@
-#include "Log.h"
-#include <thread>
-#include <mutex>
-#include <time.h>
-
-using namespace hive;
-
-//-----------------------------------------------------------------------------
-//
-// Copyright (C) 2012-14 James Ward, University of Hull
-//
-// This software is provided 'as-is', without any express or implied
-// warranty. In no event will the authors be held liable for any damages
-// arising from the use of this software.
-//
-// Permission is granted to anyone to use this software for any purpose,
-// including commercial applications, and to alter it and redistribute it
-// freely, subject to the following restrictions:
-//
-//    1. The origin of this software must not be misrepresented; you must not
-//    claim that you wrote the original software.
-//
-//    2. If you use this software in a product, an acknowledgment in the
-//    product documentation is required.
-//
-//    3. Altered source versions must be plainly marked as such, and must not
-//    be misrepresented as being the original software.
-//
-//    4. This notice may not be removed or altered from any source
-//    distribution.
-//
-//-----------------------------------------------------------------------------
-
-Log & Log::get()
-{
-    static Log instance;
-    return instance;
-}
-
-//-----------------------------------------------------------------------------
-
-Log::~Log()
-{
-    close();
-}
-
-//-----------------------------------------------------------------------------
-
-Log::Log() :
-    m_level( Level::Info )
-{
-}
-
-//-----------------------------------------------------------------------------
-
-bool Log::open( const std::string & fileName )
-{
-    // close existing
-    close();
-
-    // open stream for writing
-    get().m_stream.open( fileName.c_str() );
-    if ( !get().m_stream ) return false;
-
-    return true;
-}
-
-//-----------------------------------------------------------------------------
-
-void Log::close()
-{
-    if ( get().m_stream.is_open() ) get().m_stream.close();
-}
-
-//-----------------------------------------------------------------------------
-
-bool Log::info()
-{
-    return get().getLevel() >= Level::Info;
-}
-
-//-----------------------------------------------------------------------------
-
-bool Log::warnings()
-{
-    return get().getLevel() >= Level::Warning;
-}
-
-//-----------------------------------------------------------------------------
-
-bool Log::errors()
-{
-    return get().getLevel() >= Level::Error;
-}
-
-//-----------------------------------------------------------------------------
-
-bool Log::verbose()
-{
-    return get().getLevel() >= Level::Verbose;
-}
-
-//-----------------------------------------------------------------------------
-
-std::ostream & Log::print( const std::string & text )
-{
-    static std::mutex mutex;
-    std::lock_guard<std::mutex> lock( mutex );
-
-    unsigned timeStamp = static_cast<unsigned>(
-        1000.0 *
-        static_cast<double>( clock() ) / static_cast<double>( CLOCKS_PER_SEC )
-        + 0.5
-    );
-
-    get().m_stream << timeStamp << ": " << text;
-
-    get().m_stream.flush();
-
-    return get().m_stream;
-}
-
-//-----------------------------------------------------------------------------
-
-std::ostream & Log::out()
-{
-    return get().m_stream;
-}
-
-//-----------------------------------------------------------------------------
-
-Log & Log::setLevel( Log::Level level )
-{
-    m_level = level;
-    return *this;
-}
-
-//-----------------------------------------------------------------------------
-
-Log::Level Log::getLevel() const
-{
-    return m_level;
-}
-
-//-----------------------------------------------------------------------------
+#include "Log.h"
+#include "Clock.h"
+#include <windows.h>
+#include <process.h>
+#include <stdio.h>
+#include <string.h>
+
+using namespace hive;
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+namespace hive {
+
+/**
+ * Per-thread stream buffer, which collects the text of one message and
+ * passes it to the log queue as a record when the message is complete.
+ */
+class LogBuffer : public std::streambuf {
+public:
+    /// Constructor
+    LogBuffer() :
+        m_stream( this )
+    {
+        setp( m_text, m_text + sizeof(m_text) );
+    }
+
+    /// Returns the buffer of the calling thread (created on first use)
+    static LogBuffer & current()
+    {
+        Log & log = Log::get();
+        LogBuffer *buffer =
+            static_cast<LogBuffer *>( TlsGetValue( log.m_tlsIndex ) );
+
+        if ( buffer == 0 ) {
+            buffer = new LogBuffer;
+            TlsSetValue( log.m_tlsIndex, buffer );
+
+            // keep a list so that the buffers can be freed on shutdown
+            std::lock_guard<std::mutex> lock( log.m_buffersMutex );
+            log.m_buffers.push_back( buffer );
+        }
+
+        return *buffer;
+    }
+
+    /// Returns the stream which writes into this buffer
+    std::ostream & stream() { return m_stream; }
+
+    /// Pass any text in the buffer to the log queue
+    void submit()
+    {
+        const size_t length = pptr() - pbase();
+        if ( length > 0 ) {
+            Log::get().push( pbase(), length );
+            setp( m_text, m_text + sizeof(m_text) );
+        }
+    }
+
+protected:
+    /// Called when the buffer is full: queue what we have and carry on
+    virtual int_type overflow( int_type c )
+    {
+        submit();
+        if ( !traits_type::eq_int_type( c, traits_type::eof() ) ) {
+            *pptr() = traits_type::to_char_type( c );
+            pbump( 1 );
+        }
+        return traits_type::not_eof( c );
+    }
+
+    /// Called for strings: complete the message after a trailing newline
+    virtual std::streamsize xsputn( const char *text, std::streamsize count )
+    {
+        const std::streamsize result = std::streambuf::xsputn( text, count );
+        if ( ( count > 0 ) && ( text[count - 1] == '\n' ) ) submit();
+        return result;
+    }
+
+    /// Called on std::endl or flush: complete the message
+    virtual int sync()
+    {
+        submit();
+        return 0;
+    }
+
+private:
+    char         m_text[Log::RECORD_SIZE];  ///< text of the current message
+    std::ostream m_stream;                  ///< stream writing to m_text
+};
+
+} // namespace hive
+
+//-----------------------------------------------------------------------------
+
+Log & Log::get()
+{
+    static Log instance;
+    return instance;
+}
+
+//-----------------------------------------------------------------------------
+
+Log::~Log()
+{
+    close();
+
+    for ( size_t i = 0; i < m_buffers.size(); ++i ) delete m_buffers[i];
+    TlsFree( m_tlsIndex );
+
+    delete [] m_records;
+}
+
+//-----------------------------------------------------------------------------
+
+std::atomic<int> Log::s_level( Log::Info );
+
+//-----------------------------------------------------------------------------
+
+Log::Log() :
+    m_records( new Record[QUEUE_SIZE] ),
+    m_enqueue( 0 ),
+    m_dequeue( 0 ),
+    m_dropped( 0 ),
+    m_running( false ),
+    m_thread( 0 ),
+    m_tlsIndex( TlsAlloc() )
+{
+    m_writing.clear();
+
+    // each record initially expects to be written at its own position
+    for ( unsigned i = 0; i < QUEUE_SIZE; ++i ) {
+        m_records[i].sequence = i;
+        m_records[i].length   = 0;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+bool Log::open( const std::string & fileName )
+{
+    // close existing
+    close();
+
+    Log & log = get();
+
+    // open stream for writing
+    log.m_stream.open( fileName.c_str() );
+    if ( !log.m_stream ) return false;
+
+    // start the writer thread (note that we can be called from DllMain, so
+    // the thread won't actually run until the loader lock is released)
+    log.m_running = true;
+    log.m_thread = _beginthreadex(
+        NULL,       // no security attributes (child cannot inherit handle)
+        64*1024,    // 64KB stack size
+        threadFunc, // code to run on new thread
+        &log,       // pointer to the log
+        0,          // run immediately
+        NULL        // thread ID not required
+    );
+    if ( log.m_thread == 0 ) {
+        log.m_running = false;
+        log.m_stream.close();
+        return false;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void Log::close()
+{
+    Log & log = get();
+
+    // complete any unfinished message from this thread
+    LogBuffer *buffer =
+        static_cast<LogBuffer *>( TlsGetValue( log.m_tlsIndex ) );
+    if ( buffer != 0 ) buffer->submit();
+
+    // stop the writer thread; we only wait briefly, because inside DllMain
+    // the thread can't exit until we return (and at process exit it has
+    // already been terminated)
+    if ( log.m_thread != 0 ) {
+        log.m_running = false;
+        log.m_wake.signal();
+
+        HANDLE thread = reinterpret_cast<HANDLE>( log.m_thread );
+        WaitForSingleObject( thread, CLOSE_TIMEOUT );
+        CloseHandle( thread );
+        log.m_thread = 0;
+    }
+
+    // write out anything still queued, and close the file
+    log.drain( true );
+}
+
+//-----------------------------------------------------------------------------
+
+bool Log::push( const char *text, size_t length )
+{
+    // nothing to do if the log isn't open
+    if ( !m_running ) return false;
+
+    // claim a position in the queue (multiple producers)
+    unsigned position = m_enqueue.load( std::memory_order_relaxed );
+    Record *record = 0;
+    for (;;) {
+        record = &m_records[ position & (QUEUE_SIZE - 1) ];
+        const unsigned sequence =
+            record->sequence.load( std::memory_order_acquire );
+        const int difference = static_cast<int>( sequence - position );
+
+        if ( difference == 0 ) {
+            // record is free: try to claim it
+            if ( m_enqueue.compare_exchange_weak(
+                    position, position + 1, std::memory_order_relaxed ) )
+                break;
+        } else if ( difference < 0 ) {
+            // queue is full: drop the record rather than wait
+            m_dropped.fetch_add( 1, std::memory_order_relaxed );
+            return false;
+        } else {
+            // another producer claimed this position: try again
+            position = m_enqueue.load( std::memory_order_relaxed );
+        }
+    }
+
+    // copy the text and hand the record to the writer
+    if ( length > RECORD_SIZE ) length = RECORD_SIZE;
+    memcpy( record->text, text, length );
+    record->length = static_cast<unsigned>( length );
+    record->sequence.store( position + 1, std::memory_order_release );
+
+    // wake the writer early if the queue is filling up
+    const unsigned queued =
+        position + 1 - m_dequeue.load( std::memory_order_relaxed );
+    if ( queued == QUEUE_SIZE / 2 ) m_wake.signal();
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void Log::drain( bool closing )
+{
+    // only one thread writes at a time; when closing we wait (for a while)
+    // for the writer thread to finish its current batch
+    unsigned attempts = 0;
+    while ( m_writing.test_and_set( std::memory_order_acquire ) ) {
+        if ( !closing || ( ++attempts > CLOSE_TIMEOUT ) ) return;
+        Sleep( 1 );
+    }
+
+    // write out all complete records (single consumer)
+    unsigned position = m_dequeue.load( std::memory_order_relaxed );
+    size_t written = 0;
+    for (;;) {
+        Record & record = m_records[ position & (QUEUE_SIZE - 1) ];
+        if ( record.sequence.load( std::memory_order_acquire ) != position + 1 )
+            break;
+
+        m_stream.write( record.text, record.length );
+        ++written;
+
+        // release the record for reuse on the next pass around the queue
+        record.sequence.store(
+            position + QUEUE_SIZE, std::memory_order_release );
+        m_dequeue.store( ++position, std::memory_order_relaxed );
+    }
+
+    // report any records that we had to drop
+    const unsigned dropped = m_dropped.exchange( 0, std::memory_order_relaxed );
+    if ( dropped > 0 ) {
+        m_stream << "Log: " << dropped << " records dropped (queue full)\n";
+        ++written;
+    }
+
+    // a single flush for the whole batch
+    if ( written > 0 ) m_stream.flush();
+
+    if ( closing && m_stream.is_open() ) m_stream.close();
+
+    m_writing.clear( std::memory_order_release );
+}
+
+//-----------------------------------------------------------------------------
+
+unsigned __stdcall Log::threadFunc( void *context )
+{
+    Log & log = *static_cast<Log *>( context );
+
+    while ( log.m_running ) {
+        log.m_wake.wait( FLUSH_INTERVAL );
+        log.drain();
+    }
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+
+std::ostream & Log::print( const std::string & text )
+{
+    return print( text.c_str() );
+}
+
+//-----------------------------------------------------------------------------
+
+std::ostream & Log::print( const char *text )
+{
+    LogBuffer & buffer = LogBuffer::current();
+
+    // complete any previous message that wasn't terminated
+    buffer.submit();
+
+    // time-stamp in milliseconds (formatted separately, so that we don't
+    // change the precision of the stream used by the caller)
+    char timeStamp[32] = {};
+    sprintf_s( timeStamp, sizeof(timeStamp), "%.3f", Clock::milliseconds() );
+
+    buffer.stream() << timeStamp << ": " << text;
+
+    return buffer.stream();
+}
+
+//-----------------------------------------------------------------------------
+
+std::ostream & Log::out()
+{
+    return LogBuffer::current().stream();
+}
+
+//-----------------------------------------------------------------------------
+
+Log & Log::setLevel( Log::Level level )
+{
+    s_level.store( level, std::memory_order_relaxed );
+    return *this;
+}
+
+//-----------------------------------------------------------------------------
+
+Log::Level Log::getLevel() const
+{
+    return static_cast<Level>( s_level.load( std::memory_order_relaxed ) );
+}
+
+//-----------------------------------------------------------------------------
@@ -1,99 +1,183 @@
-#ifndef hive_Log_h
-#define hive_Log_h
-
-//-----------------------------------------------------------------------------
-//
-// Copyright (C) 2012-14 James Ward, University of Hull
-//
-// This software is provided 'as-is', without any express or implied
-// warranty. In no event will the authors be held liable for any damages
-// arising from the use of this software.
-//
-// Permission is granted to anyone to use this software for any purpose,
-// including commercial applications, and to alter it and redistribute it
-// freely, subject to the following restrictions:
-//
-//    1. The origin of this software must not be misrepresented; you must not
-//    claim that you wrote the original software.
-//
-//    2. If you use this software in a product, an acknowledgment in the
-//    product documentation is required.
-//
-//    3. Altered source versions must be plainly marked as such, and must not
-//    be misrepresented as being the original software.
-//
-//    4. This notice may not be removed or altered from any source
-//    distribution.
-//
-//-----------------------------------------------------------------------------
-
-#include <string>
-#include <fstream>
-
-//-----------------------------------------------------------------------------
-
-namespace hive {
-
-/**
- * Simple logging singleton class.
- */
-class Log {
-public:
-    /// Defines logging levels, in increasing level of detail
-    enum Level {
-        Error,
-        Warning,
-        Info,
-        Verbose
-    };
-
-    /// Virtual Destructor
-    virtual ~Log();
-
-    /// Provides access to the single instance
-    static Log & get();
-
-    /// Open the specified log file for output
-    static bool open( const std::string & fileName = "log.txt" );
-
-    /// Close the log file
-    static void close();
-
-    /// Returns true if we are logging errors (least verbose mode)
-    static bool errors();
-
-    /// Returns true if we are logging warnings
-    static bool warnings();
-
-    /// Returns true if we are logging informational messages
-    static bool info();
-
-    /// Returns true if we are logging everything (most verbose mode)
-    static bool verbose();
-
-    /// Print a message to the log
-    static std::ostream & print( const std::string & text = "" );
-
-    /// Provides access to the log output stream
-    static std::ostream & out();
-
-    /// Set the current logging level
-    Log & setLevel( Log::Level level );
-
-    /// Get the current logging level
-    Level getLevel() const;
-
-private:
-    /// Default Constructor
-    Log();
-
-    std::ofstream m_stream; ///< the log output stream
-
-    Level m_level;          ///< the current log level
-};
-
-} // namespace hive
-
-//-----------------------------------------------------------------------------
-
+#ifndef hive_Log_h
+#define hive_Log_h
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+#include <string>
+#include <fstream>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <stdint.h>
+#include "Event.h"
+
+//-----------------------------------------------------------------------------
+
+/// The most detailed logging level compiled into the module: checks for more
+/// detailed levels are constant false, so the compiler removes the logging
+/// code entirely. By default this is Info for release builds, and Verbose for
+/// debug builds; define HIVE_LOG_MAX_LEVEL (0=Error ... 3=Verbose) to change.
+#if !defined(HIVE_LOG_MAX_LEVEL)
+    #if defined(NDEBUG)
+        #define HIVE_LOG_MAX_LEVEL 2
+    #else
+        #define HIVE_LOG_MAX_LEVEL 3
+    #endif
+#endif
+
+//-----------------------------------------------------------------------------
+
+namespace hive {
+
+class LogBuffer;
+
+/**
+ * Simple logging singleton class.
+ *
+ * Messages are formatted by the calling thread into a per-thread buffer, and
+ * when the message is complete (on std::endl, flush, or a trailing newline)
+ * it is copied as a record into a bounded lock-free queue. A background
+ * thread periodically writes the queued records to the file in batches, so
+ * that logging never blocks a rendering thread on a mutex or on file I/O.
+ * If the queue is full, records are dropped (and the number dropped is
+ * reported in the log) rather than waiting for space.
+ */
+class Log {
+public:
+    /// Defines logging levels, in increasing level of detail
+    enum Level {
+        Error,
+        Warning,
+        Info,
+        Verbose
+    };
+
+    /// Most detailed level compiled in (see HIVE_LOG_MAX_LEVEL)
+    enum { MAX_LEVEL = HIVE_LOG_MAX_LEVEL };
+
+    /// Virtual Destructor
+    virtual ~Log();
+
+    /// Provides access to the single instance
+    static Log & get();
+
+    /// Open the specified log file for output
+    static bool open( const std::string & fileName = "log.txt" );
+
+    /// Close the log file
+    static void close();
+
+    /// Returns true if we are logging at the specified level: this is false
+    /// at compile time for levels above MAX_LEVEL, otherwise it is a single
+    /// read of the current level
+    template <Level level> static bool enabled() {
+        return ( static_cast<int>( level ) <= MAX_LEVEL ) &&
+            ( s_level.load( std::memory_order_relaxed ) >= level );
+    }
+
+    /// Returns true if we are logging errors (least verbose mode)
+    static bool errors() { return enabled<Error>(); }
+
+    /// Returns true if we are logging warnings
+    static bool warnings() { return enabled<Warning>(); }
+
+    /// Returns true if we are logging informational messages
+    static bool info() { return enabled<Info>(); }
+
+    /// Returns true if we are logging everything (most verbose mode)
+    static bool verbose() { return enabled<Verbose>(); }
+
+    /// Print a message to the log
+    static std::ostream & print( const char *text = "" );
+
+    /// Print a message to the log
+    static std::ostream & print( const std::string & text );
+
+    /// Provides access to the log output stream (of the calling thread)
+    static std::ostream & out();
+
+    /// Set the current logging level
+    Log & setLevel( Log::Level level );
+
+    /// Get the current logging level
+    Level getLevel() const;
+
+    enum {
+        RECORD_SIZE    = 256,   ///< maximum record length (longer are split)
+        QUEUE_SIZE     = 1024,  ///< number of records queued (power of two)
+        FLUSH_INTERVAL = 20,    ///< milliseconds between batched writes
+        CLOSE_TIMEOUT  = 100    ///< milliseconds to wait for writer thread
+    };
+
+private:
+    friend class LogBuffer;
+
+    /// Default Constructor
+    Log();
+
+    /// Queue a record for writing (returns false if the record was dropped)
+    bool push( const char *text, size_t length );
+
+    /// Write all queued records to the file; when closing, this waits for
+    /// the writer thread to finish its batch, and then closes the file
+    void drain( bool closing = false );
+
+    /// Background writer thread function
+    static unsigned __stdcall threadFunc( void *context );
+
+    /// A queued log record
+    struct Record {
+        std::atomic<unsigned> sequence; ///< position of record in the queue
+        unsigned length;                ///< length of text in bytes
+        char     text[RECORD_SIZE];     ///< preformatted text (no terminator)
+    };
+
+    std::ofstream m_stream; ///< the log output stream (writer only)
+
+    static std::atomic<int> s_level;   ///< the current log level
+
+    Record *m_records;                 ///< circular queue of records
+    std::atomic<unsigned> m_enqueue;   ///< next position to write (producers)
+    std::atomic<unsigned> m_dequeue;   ///< next position to read (writer)
+    std::atomic<unsigned> m_dropped;   ///< records dropped since last batch
+    std::atomic_flag      m_writing;   ///< held while writing the file
+
+    std::atomic<bool> m_running;       ///< is the writer thread running?
+    uintptr_t         m_thread;        ///< handle of the writer thread
+    Event             m_wake;          ///< wakes writer when queue fills up
+
+    unsigned long m_tlsIndex;          ///< TLS slot for per-thread buffers
+
+    std::mutex               m_buffersMutex; ///< guards m_buffers
+    std::vector<LogBuffer *> m_buffers;      ///< all per-thread buffers
+};
+
+} // namespace hive
+
+//-----------------------------------------------------------------------------
+
 #endif//hive_Log_h
\ No newline at end of file
@@ -0,0 +1,288 @@
+#include "SharedFrames.h"
+#include <cstdio>
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+namespace {
+
+/// Prefix of the name of the shared memory (per session and process)
+const char *MAPPING_PREFIX = "Local\\QuadifierFrames-";
+
+/// Prefix of the name of the frame ready event
+const char *EVENT_PREFIX = "Local\\QuadifierFramesReady-";
+
+/// Number of attempts to read a consistent pool of surfaces
+const unsigned READ_ATTEMPTS = 4;
+
+/// Mailbox state: the waiting slot, a flag set while it holds a frame the
+/// reader has not seen, and the generation in the remaining bits
+const LONG SLOT_MASK = 3;
+const LONG FRESH = 4;
+const int  GENERATION_SHIFT = 3;
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+
+namespace hive {
+
+//-----------------------------------------------------------------------------
+
+/// Layout of the shared memory: the sequence number is odd while the
+/// surfaces are being written; handles (and the window) are kept as 32-bit
+/// values, which Windows guarantees is all they use in both 32 and 64-bit
+/// processes
+struct SharedFrames::Data {
+    volatile LONG state;
+    volatile LONG sequence;
+    DWORD writer;
+    LONG  window;
+    unsigned width;
+    unsigned height;
+    unsigned format;
+    LONG  handle[SLOTS][EYES];
+    Frame frame[SLOTS];
+};
+
+//-----------------------------------------------------------------------------
+
+SharedFrames::SharedFrames() :
+    m_mapping( 0 ),
+    m_event( 0 ),
+    m_data( 0 )
+{
+}
+
+//-----------------------------------------------------------------------------
+
+SharedFrames::~SharedFrames()
+{
+    close();
+}
+
+//-----------------------------------------------------------------------------
+
+bool SharedFrames::create()
+{
+    if ( isOpen() ) return true;
+    if ( !map( GetCurrentProcessId(), true ) ) return false;
+
+    // nothing waiting in the mailbox; a presenter may still have the memory
+    // open from an earlier device, so the generation carries on from its
+    // pool (and the next pool is a new one to it)
+    m_data->writer = GetCurrentProcessId();
+    const LONG generation = m_data->state & ~(SLOT_MASK | FRESH);
+    InterlockedExchange( &m_data->state, generation | 1 );
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+bool SharedFrames::open( DWORD processId )
+{
+    if ( isOpen() ) return true;
+    return map( processId, false );
+}
+
+//-----------------------------------------------------------------------------
+
+bool SharedFrames::map( DWORD processId, bool create )
+{
+    char name[64];
+    sprintf_s( name, sizeof(name), "%s%lu", MAPPING_PREFIX, processId );
+
+    m_mapping = create ?
+        CreateFileMappingA(
+            INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE,
+            0, sizeof(Data), name
+        ) :
+        OpenFileMappingA( FILE_MAP_ALL_ACCESS, FALSE, name );
+    if ( m_mapping == 0 ) return false;
+
+    m_data = reinterpret_cast<Data*>(
+        MapViewOfFile( m_mapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(Data) )
+    );
+
+    // auto-reset, so that each publish wakes the reader once
+    sprintf_s( name, sizeof(name), "%s%lu", EVENT_PREFIX, processId );
+    m_event = CreateEventA( NULL, FALSE, FALSE, name );
+
+    if ( (m_data == 0) || (m_event == 0) ) {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void SharedFrames::close()
+{
+    if ( m_data != 0 ) {
+        UnmapViewOfFile( m_data );
+        m_data = 0;
+    }
+    if ( m_mapping != 0 ) {
+        CloseHandle( m_mapping );
+        m_mapping = 0;
+    }
+    if ( m_event != 0 ) {
+        CloseHandle( m_event );
+        m_event = 0;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+bool SharedFrames::isOpen() const
+{
+    return ( m_data != 0 );
+}
+
+//-----------------------------------------------------------------------------
+
+DWORD SharedFrames::writer() const
+{
+    return ( m_data != 0 ) ? m_data->writer : 0;
+}
+
+//-----------------------------------------------------------------------------
+
+HANDLE SharedFrames::readyEvent() const
+{
+    return m_event;
+}
+
+//-----------------------------------------------------------------------------
+
+void SharedFrames::setSurfaces( const Surfaces & surfaces )
+{
+    if ( m_data == 0 ) return;
+
+    // odd while writing (the interlocked operations are full barriers)
+    InterlockedIncrement( &m_data->sequence );
+    m_data->window = HandleToLong( surfaces.window );
+    m_data->width  = surfaces.width;
+    m_data->height = surfaces.height;
+    m_data->format = surfaces.format;
+    for (unsigned slot = 0; slot < SLOTS; ++slot) {
+        for (unsigned eye = 0; eye < EYES; ++eye) {
+            m_data->handle[slot][eye] = HandleToLong( surfaces.handle[slot][eye] );
+        }
+    }
+    InterlockedIncrement( &m_data->sequence );
+
+    // a new generation, with slot 1 waiting and no frame in it
+    const LONG next = ( (m_data->state >> GENERATION_SHIFT) + 1 ) << GENERATION_SHIFT;
+    InterlockedExchange( &m_data->state, next | 1 );
+}
+
+//-----------------------------------------------------------------------------
+
+unsigned SharedFrames::publish( unsigned slot, const Frame & frame )
+{
+    if ( m_data == 0 ) return slot;
+
+    m_data->frame[slot] = frame;
+
+    // only the writer changes the generation, so a plain exchange will do
+    const LONG generation = m_data->state & ~(SLOT_MASK | FRESH);
+    const LONG previous = InterlockedExchange(
+        &m_data->state, generation | FRESH | static_cast<LONG>(slot)
+    );
+
+    SetEvent( m_event );
+    return static_cast<unsigned>( previous & SLOT_MASK );
+}
+
+//-----------------------------------------------------------------------------
+
+unsigned SharedFrames::generation() const
+{
+    if ( m_data == 0 ) return 0;
+    return static_cast<unsigned>( m_data->state >> GENERATION_SHIFT );
+}
+
+//-----------------------------------------------------------------------------
+
+bool SharedFrames::surfaces( Surfaces & surfaces, unsigned & generation ) const
+{
+    if ( m_data == 0 ) return false;
+
+    for (unsigned attempt = 0; attempt < READ_ATTEMPTS; ++attempt) {
+        const LONG before = m_data->sequence;
+        if ( before == 0 ) return false;
+        if ( before & 1 ) continue;
+
+        MemoryBarrier();
+        surfaces.window = static_cast<HWND>( LongToHandle( m_data->window ) );
+        surfaces.width  = m_data->width;
+        surfaces.height = m_data->height;
+        surfaces.format = m_data->format;
+        for (unsigned slot = 0; slot < SLOTS; ++slot) {
+            for (unsigned eye = 0; eye < EYES; ++eye) {
+                surfaces.handle[slot][eye] = LongToHandle( m_data->handle[slot][eye] );
+            }
+        }
+        generation = this->generation();
+        MemoryBarrier();
+
+        // the copy is consistent if no write started in the meantime, and
+        // the generation read belongs to it (it is bumped after the write)
+        if ( (m_data->sequence == before) && (generation != 0) ) return true;
+    }
+
+    return false;
+}
+
+//-----------------------------------------------------------------------------
+
+bool SharedFrames::acquire( unsigned generation, unsigned & slot, Frame & frame )
+{
+    if ( m_data == 0 ) return false;
+
+    for (;;) {
+        const LONG current = m_data->state;
+        if ( static_cast<unsigned>(current >> GENERATION_SHIFT) != generation ) return false;
+        if ( (current & FRESH) == 0 ) return false;
+
+        // hand our slot back, unless the writer got there first
+        const LONG next = ( current & ~(SLOT_MASK | FRESH) ) | static_cast<LONG>(slot);
+        if ( InterlockedCompareExchange( &m_data->state, next, current ) == current ) {
+            slot = static_cast<unsigned>( current & SLOT_MASK );
+            frame = m_data->frame[slot];
+            return true;
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+} // namespace hive
+
+//-----------------------------------------------------------------------------
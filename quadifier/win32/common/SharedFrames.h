@@ -0,0 +1,162 @@
+#ifndef hive_SharedFrames_h
+#define hive_SharedFrames_h
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+#include <windows.h>
+
+//-----------------------------------------------------------------------------
+
+namespace hive {
+
+//-----------------------------------------------------------------------------
+
+/**
+ * Stereo frames shared between an application process and the presenter
+ * process, through a named block of shared memory per application process.
+ *
+ * The application (the writer) creates a small pool of shareable Direct3D9Ex
+ * render target surfaces (CreateRenderTarget with a share handle), one per
+ * eye in each of SLOTS slots, and publishes their share handles here. The
+ * presenter (the reader) opens the same surfaces on its own device, and
+ * paints them at the display rate, so an application which hitches (or
+ * dies) no longer stalls the display.
+ *
+ * The slots are handed over through a three slot "mailbox", as FrameMailbox
+ * does between threads: the writer always has a slot to copy into, the
+ * reader keeps the one it is painting, and the third holds the latest frame
+ * (older frames are dropped, and nobody ever waits). The mailbox state also
+ * carries the generation of the surfaces, so a reader still holding a slot
+ * of the previous surfaces can never hand it back into the new pool.
+ *
+ * The share handles and the window are stored as 32-bit values (Windows
+ * only uses the low 32 bits of them in both 32 and 64-bit processes), so
+ * that 32-bit applications and a 64-bit presenter (or the reverse) agree
+ * on the layout.
+ */
+class SharedFrames {
+public:
+    /// Number of slots in the pool
+    static const unsigned SLOTS = 3;
+
+    /// Number of eyes in each slot
+    static const unsigned EYES = 2;
+
+    /// The render target surfaces of the pool
+    struct Surfaces {
+        HWND     window;                ///< window the application presents to
+        unsigned width;                 ///< width of each eye
+        unsigned height;                ///< height of each eye
+        unsigned format;                ///< D3DFORMAT of the surfaces
+        HANDLE   handle[SLOTS][EYES];   ///< D3D9Ex share handles
+    };
+
+    /// A published frame
+    struct Frame {
+        unsigned  frameId;      ///< application frame number
+        unsigned  eyes;         ///< eyes captured (1 = mono, 2 = stereo)
+        long long presentTime;  ///< QueryPerformanceCounter at present
+    };
+
+    /// Constructor
+    SharedFrames();
+
+    /// Destructor (closes the shared memory)
+    ~SharedFrames();
+
+    /// Create the shared memory of this process (writer): one device at a
+    /// time writes to it
+    bool create();
+
+    /// Open the shared memory of an application process (reader): returns
+    /// false if that process has not created it (yet)
+    bool open( DWORD processId );
+
+    /// Close the shared memory
+    void close();
+
+    /// Returns true if the shared memory is open
+    bool isOpen() const;
+
+    /// Returns the ID of the application process
+    DWORD writer() const;
+
+    /// Returns the event which is signalled as each frame is published
+    HANDLE readyEvent() const;
+
+    /// Index of the slot the writer first copies into
+    static unsigned writeSlot() { return 0; }
+
+    /// Index of the slot the reader first holds (no frame in it)
+    static unsigned readSlot() { return 2; }
+
+    /// Publish a new pool of surfaces, discarding any published frame
+    /// (writer); the writer starts again from writeSlot()
+    void setSurfaces( const Surfaces & surfaces );
+
+    /// Publish the frame copied into a slot (writer): returns the slot to
+    /// copy the next frame into
+    unsigned publish( unsigned slot, const Frame & frame );
+
+    /// Returns the generation of the surfaces (0 = none published yet)
+    unsigned generation() const;
+
+    /// Read the current pool of surfaces and its generation (reader):
+    /// returns false if none has been published (or a consistent copy could
+    /// not be read)
+    bool surfaces( Surfaces & surfaces, unsigned & generation ) const;
+
+    /// Exchange the slot the reader holds for the latest frame (reader):
+    /// returns false, keeping the slot, if no new frame has been published,
+    /// or if the surfaces are no longer those of the given generation
+    bool acquire( unsigned generation, unsigned & slot, Frame & frame );
+
+private:
+    /// Copy construction is not supported
+    SharedFrames( const SharedFrames & );
+
+    /// Assignment is not supported
+    SharedFrames & operator = ( const SharedFrames & );
+
+    /// Map the memory and the event of an application process
+    bool map( DWORD processId, bool create );
+
+    /// Layout of the shared memory
+    struct Data;
+
+    HANDLE m_mapping;   ///< handle of the file mapping
+    HANDLE m_event;     ///< frame ready event
+    Data  *m_data;      ///< the mapped view (or 0)
+};
+
+//-----------------------------------------------------------------------------
+
+} // namespace hive
+
+//-----------------------------------------------------------------------------
+
+#endif//hive_SharedFrames_h
@@ -0,0 +1,160 @@
+#include "SharedPose.h"
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+namespace {
+
+/// Name of the shared memory (per session)
+const wchar_t *MAPPING_NAME = L"Local\\QuadifierPose";
+
+/// Number of attempts to read a consistent pose
+const unsigned READ_ATTEMPTS = 4;
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+
+namespace hive {
+
+//-----------------------------------------------------------------------------
+
+/// Layout of the shared memory: the sequence number of a sensor is odd
+/// while its pose is being written, and zero if it has never been written
+struct SharedPose::Data {
+    struct Sensor {
+        volatile LONG sequence;
+        Pose pose;
+    };
+
+    Sensor sensor[MAX_SENSORS];
+};
+
+//-----------------------------------------------------------------------------
+
+SharedPose::SharedPose() :
+    m_mapping( 0 ),
+    m_data( 0 )
+{
+}
+
+//-----------------------------------------------------------------------------
+
+SharedPose::~SharedPose()
+{
+    close();
+}
+
+//-----------------------------------------------------------------------------
+
+bool SharedPose::open()
+{
+    if ( isOpen() ) return true;
+
+    // the first process to get here creates the (zero-filled) memory, and
+    // any other process opens the same memory
+    m_mapping = CreateFileMappingW(
+        INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE,
+        0, sizeof(Data), MAPPING_NAME
+    );
+    if ( m_mapping == 0 ) return false;
+
+    m_data = reinterpret_cast<Data*>(
+        MapViewOfFile( m_mapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(Data) )
+    );
+    if ( m_data == 0 ) {
+        CloseHandle( m_mapping );
+        m_mapping = 0;
+        return false;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void SharedPose::close()
+{
+    if ( m_data != 0 ) {
+        UnmapViewOfFile( m_data );
+        m_data = 0;
+    }
+    if ( m_mapping != 0 ) {
+        CloseHandle( m_mapping );
+        m_mapping = 0;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+bool SharedPose::isOpen() const
+{
+    return ( m_data != 0 );
+}
+
+//-----------------------------------------------------------------------------
+
+void SharedPose::write( unsigned sensor, const Pose & pose )
+{
+    if ( (m_data == 0) || (sensor >= MAX_SENSORS) ) return;
+
+    Data::Sensor & slot = m_data->sensor[sensor];
+
+    // odd while writing (the interlocked operations are full barriers)
+    InterlockedIncrement( &slot.sequence );
+    slot.pose = pose;
+    InterlockedIncrement( &slot.sequence );
+}
+
+//-----------------------------------------------------------------------------
+
+bool SharedPose::read( unsigned sensor, Pose & pose ) const
+{
+    if ( (m_data == 0) || (sensor >= MAX_SENSORS) ) return false;
+
+    const Data::Sensor & slot = m_data->sensor[sensor];
+
+    for (unsigned attempt = 0; attempt < READ_ATTEMPTS; ++attempt) {
+        const LONG before = slot.sequence;
+        if ( before == 0 ) return false;
+        if ( before & 1 ) continue;
+
+        MemoryBarrier();
+        pose = slot.pose;
+        MemoryBarrier();
+
+        // the copy is consistent if no write started in the meantime
+        if ( slot.sequence == before ) return true;
+    }
+
+    return false;
+}
+
+//-----------------------------------------------------------------------------
+
+} // namespace hive
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,102 @@
+#ifndef hive_SharedPose_h
+#define hive_SharedPose_h
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+#include <windows.h>
+
+//-----------------------------------------------------------------------------
+
+namespace hive {
+
+//-----------------------------------------------------------------------------
+
+/**
+ * Tracker poses shared between processes through a named block of shared
+ * memory. The VRPN bridge writes the latest pose of each sensor as it
+ * arrives, and the Quadifier module reads them at capture and present time
+ * (much later than the pose that reaches Unity through the socket).
+ *
+ * Each sensor has its own sequence counter (a "seqlock"), so neither side
+ * ever waits for the other: a reader which sees a write in progress simply
+ * tries again.
+ */
+class SharedPose {
+public:
+    /// Maximum number of sensors
+    static const unsigned MAX_SENSORS = 8;
+
+    /// The pose of one sensor
+    struct Pose {
+        float timeStamp;    ///< time in seconds (from the tracker)
+        float position[3];  ///< position vector
+        float rotation[4];  ///< orientation quaternion (x,y,z,w)
+    };
+
+    /// Constructor
+    SharedPose();
+
+    /// Destructor (closes the shared memory)
+    ~SharedPose();
+
+    /// Open the shared memory, creating it if it does not yet exist
+    bool open();
+
+    /// Close the shared memory
+    void close();
+
+    /// Returns true if the shared memory is open
+    bool isOpen() const;
+
+    /// Store the latest pose of a sensor
+    void write( unsigned sensor, const Pose & pose );
+
+    /// Read the latest pose of a sensor: returns false if none has been
+    /// written (or a consistent copy could not be read)
+    bool read( unsigned sensor, Pose & pose ) const;
+
+private:
+    /// Copy construction is not supported
+    SharedPose( const SharedPose & );
+
+    /// Assignment is not supported
+    SharedPose & operator = ( const SharedPose & );
+
+    /// Layout of the shared memory
+    struct Data;
+
+    HANDLE m_mapping;   ///< handle of the file mapping
+    Data  *m_data;      ///< the mapped view (or 0)
+};
+
+//-----------------------------------------------------------------------------
+
+} // namespace hive
+
+//-----------------------------------------------------------------------------
+
+#endif//hive_SharedPose_h
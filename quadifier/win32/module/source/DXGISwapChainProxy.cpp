@@ -1,217 +1,334 @@
-#if defined(SUPPORT_D3D11)
-
-#include "DXGISwapChainProxy.h"
-#include "Log.h"
-#include "DebugUtil.h"
-
-using namespace hive;
-
-//-----------------------------------------------------------------------------
-//
-// Copyright (C) 2012-14 James Ward, University of Hull
-//
-// This software is provided 'as-is', without any express or implied
-// warranty. In no event will the authors be held liable for any damages
-// arising from the use of this software.
-//
-// Permission is granted to anyone to use this software for any purpose,
-// including commercial applications, and to alter it and redistribute it
-// freely, subject to the following restrictions:
-//
-//    1. The origin of this software must not be misrepresented; you must not
-//    claim that you wrote the original software.
-//
-//    2. If you use this software in a product, an acknowledgment in the
-//    product documentation is required.
-//
-//    3. Altered source versions must be plainly marked as such, and must not
-//    be misrepresented as being the original software.
-//
-//    4. This notice may not be removed or altered from any source
-//    distribution.
-//
-//-----------------------------------------------------------------------------
-
-DXGISwapChainProxy::DXGISwapChainProxy(
-    IDXGISwapChain *chain
-)
-    : m_chain( chain )
-{
-    Log::print() << "DXGISwapChainProxy(" << chain << ")\n";
-}
-
-//-----------------------------------------------------------------------------
-
-DXGISwapChainProxy::~DXGISwapChainProxy()
-{
-}
-
-//-----------------------------------------------------------------------------
-
-HRESULT DXGISwapChainProxy::QueryInterface( REFIID riid, void **ppvObj)
-{
-    Log::print() << "DXGISwapChainProxy::QueryInterface("
-                 << GUIDtoObjectName(riid) << ")\n";
-    HRESULT result = m_chain->QueryInterface( riid, ppvObj ); 
-    return result; 
-}
-
-//-----------------------------------------------------------------------------
-
-ULONG DXGISwapChainProxy::AddRef()
-{
-    return m_chain->AddRef();
-}
-
-//-----------------------------------------------------------------------------
-
-ULONG DXGISwapChainProxy::Release()
-{
-    return m_chain->Release();
-}
-
-//-----------------------------------------------------------------------------
-
-HRESULT STDMETHODCALLTYPE DXGISwapChainProxy::Present(
-    UINT SyncInterval,
-    UINT Flags
-) {
-    return m_chain->Present( SyncInterval, Flags );
-}
-
-//-----------------------------------------------------------------------------
-
-HRESULT STDMETHODCALLTYPE DXGISwapChainProxy::GetBuffer(
-    UINT Buffer,
-    __in REFIID riid,
-    __out void **ppSurface
-) {
-    return m_chain->GetBuffer( Buffer, riid, ppSurface );
-}
-
-//-----------------------------------------------------------------------------
-
-HRESULT STDMETHODCALLTYPE DXGISwapChainProxy::SetFullscreenState(
-    BOOL Fullscreen,
-    __in_opt IDXGIOutput *pTarget
-) {
-    return m_chain->SetFullscreenState( Fullscreen, pTarget );
-}
-
-//-----------------------------------------------------------------------------
-
-HRESULT STDMETHODCALLTYPE DXGISwapChainProxy::GetFullscreenState(
-    __out BOOL *pFullscreen,
-    __out IDXGIOutput **ppTarget
-) {
-    return m_chain->GetFullscreenState( pFullscreen, ppTarget );
-}
-
-//-----------------------------------------------------------------------------
-
-HRESULT STDMETHODCALLTYPE DXGISwapChainProxy::GetDesc(
-    __out DXGI_SWAP_CHAIN_DESC *pDesc
-) {
-    return m_chain->GetDesc( pDesc );
-}
-
-//-----------------------------------------------------------------------------
-
-HRESULT STDMETHODCALLTYPE DXGISwapChainProxy::ResizeBuffers(
-    UINT BufferCount,
-    UINT Width,
-    UINT Height,
-    DXGI_FORMAT NewFormat,
-    UINT SwapChainFlags
-) {
-    return m_chain->ResizeBuffers(
-        BufferCount,
-        Width,
-        Height,
-        NewFormat,
-        SwapChainFlags
-    );
-}
-
-//-----------------------------------------------------------------------------
-
-HRESULT STDMETHODCALLTYPE DXGISwapChainProxy::ResizeTarget(
-    __in const DXGI_MODE_DESC *pNewTargetParameters
-) {
-    return m_chain->ResizeTarget( pNewTargetParameters );
-}
-
-//-----------------------------------------------------------------------------
-
-HRESULT STDMETHODCALLTYPE DXGISwapChainProxy::GetContainingOutput(
-    __out IDXGIOutput **ppOutput
-) {
-    return m_chain->GetContainingOutput( ppOutput );
-}
-
-//-----------------------------------------------------------------------------
-
-HRESULT STDMETHODCALLTYPE DXGISwapChainProxy::GetFrameStatistics(
-    __out DXGI_FRAME_STATISTICS *pStats
-) {
-    return m_chain->GetFrameStatistics( pStats );
-}
-
-//-----------------------------------------------------------------------------
-
-HRESULT STDMETHODCALLTYPE DXGISwapChainProxy::GetLastPresentCount(
-    __out UINT *pLastPresentCount
-) {
-    return m_chain->GetLastPresentCount( pLastPresentCount );
-}
-
-//-----------------------------------------------------------------------------
-
-HRESULT STDMETHODCALLTYPE DXGISwapChainProxy::SetPrivateData(
-    __in  REFGUID Name,
-    UINT DataSize,
-    __in_bcount(DataSize)  const void *pData
-) {
-    return m_chain->SetPrivateData( Name, DataSize, pData );
-}
-
-//-----------------------------------------------------------------------------
-
-HRESULT STDMETHODCALLTYPE DXGISwapChainProxy::SetPrivateDataInterface(
-    __in  REFGUID Name,
-    __in  const IUnknown *pUnknown
-) {
-    return m_chain->SetPrivateDataInterface( Name, pUnknown );
-}
-
-//-----------------------------------------------------------------------------
-
-HRESULT STDMETHODCALLTYPE DXGISwapChainProxy::GetPrivateData(
-    __in  REFGUID Name,
-    __inout  UINT *pDataSize,
-    __out_bcount(*pDataSize) void *pData
-) {
-    return m_chain->GetPrivateData( Name, pDataSize, pData );
-}
-
-//-----------------------------------------------------------------------------
-
-HRESULT STDMETHODCALLTYPE DXGISwapChainProxy::GetParent(
-    __in  REFIID riid,
-    __out  void **ppParent
-) {
-    return m_chain->GetParent( riid, ppParent );
-}
-
-//-----------------------------------------------------------------------------
-
-HRESULT STDMETHODCALLTYPE DXGISwapChainProxy::GetDevice(
-    __in  REFIID riid,
-    __out  void **ppDevice
-) {
-    return m_chain->GetDevice( riid, ppDevice );
-}
-
-//-----------------------------------------------------------------------------
-
+#if defined(SUPPORT_D3D11)
+
+#include "DXGISwapChainProxy.h"
+#include "Quadifier.h"
+#include "Log.h"
+#include "DebugUtil.h"
+#include "Settings.h"
+
+using namespace hive;
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+DXGISwapChainProxy::DXGISwapChainProxy(
+    IDXGISwapChain *chain,
+    Quadifier *quad
+)
+    : m_chain( chain ),
+      m_quad( quad ),
+      m_waitable( 0 )
+{
+    Log::print() << "DXGISwapChainProxy(" << chain << ")\n";
+
+    // a waitable chain queues a single frame, and Present waits on it
+    DXGI_SWAP_CHAIN_DESC desc = {};
+    IDXGISwapChain2 *chain2 = 0;
+    if ( SUCCEEDED( m_chain->GetDesc( &desc ) ) &&
+         ( (desc.Flags & DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT) != 0 ) &&
+         SUCCEEDED( m_chain->QueryInterface(
+            __uuidof(IDXGISwapChain2), reinterpret_cast<void**>(&chain2) ) )
+    ) {
+        chain2->SetMaximumFrameLatency( 1 );
+        m_waitable = chain2->GetFrameLatencyWaitableObject();
+        chain2->Release();
+        if (Log::info())
+            Log::print() << "swap chain frame latency waitable = " << m_waitable << '\n';
+    }
+
+    if ( m_quad != 0 ) m_quad->onCreateSwapChainDX( m_chain );
+}
+
+//-----------------------------------------------------------------------------
+
+DXGISwapChainProxy::~DXGISwapChainProxy()
+{
+    if ( m_waitable != 0 ) CloseHandle( m_waitable );
+}
+
+//-----------------------------------------------------------------------------
+
+HRESULT DXGISwapChainProxy::create(
+    IDXGIFactory *factory,
+    IUnknown *device,
+    DXGI_SWAP_CHAIN_DESC *desc,
+    IDXGISwapChain **chain
+) {
+    // the flip model only takes these back buffer formats (sRGB views of
+    // them have to be made by the application, so sRGB formats are left)
+    const bool flipFormat = ( desc != 0 ) && (
+        ( desc->BufferDesc.Format == DXGI_FORMAT_R16G16B16A16_FLOAT ) ||
+        ( desc->BufferDesc.Format == DXGI_FORMAT_B8G8R8A8_UNORM ) ||
+        ( desc->BufferDesc.Format == DXGI_FORMAT_R8G8B8A8_UNORM ) ||
+        ( desc->BufferDesc.Format == DXGI_FORMAT_R10G10B10A2_UNORM )
+    );
+
+    if ( Settings::get().flipModel && flipFormat &&
+         ( desc->SampleDesc.Count == 1 ) &&
+         ( (desc->Flags & DXGI_SWAP_CHAIN_FLAG_GDI_COMPATIBLE) == 0 )
+    ) {
+        DXGI_SWAP_CHAIN_DESC flip = *desc;
+        flip.Flags |= DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT;
+        if ( flip.BufferCount < 2 ) flip.BufferCount = 2;
+
+        // DXGI_SWAP_EFFECT_FLIP_DISCARD (4) is only in the Windows 10 SDK
+        const DXGI_SWAP_EFFECT effects[] = {
+            static_cast<DXGI_SWAP_EFFECT>( 4 ),
+            DXGI_SWAP_EFFECT_FLIP_SEQUENTIAL
+        };
+        for (unsigned i=0; i<2; ++i) {
+            flip.SwapEffect = effects[i];
+            HRESULT result = factory->CreateSwapChain( device, &flip, chain );
+            if ( SUCCEEDED( result ) ) {
+                if (Log::info())
+                    Log::print() << "created flip model swap chain (swap effect "
+                        << flip.SwapEffect << ")\n";
+                return result;
+            }
+        }
+        Log::print( "warning: failed to create flip model swap chain\n" );
+    } else if ( Settings::get().flipModel )
+        Log::print( "warning: swap chain cannot use the flip model (format, MSAA or GDI)\n" );
+
+    return factory->CreateSwapChain( device, desc, chain );
+}
+
+//-----------------------------------------------------------------------------
+
+HRESULT DXGISwapChainProxy::QueryInterface( REFIID riid, void **ppvObj)
+{
+    Log::print() << "DXGISwapChainProxy::QueryInterface("
+                 << GUIDtoObjectName(riid) << ")\n";
+    HRESULT result = m_chain->QueryInterface( riid, ppvObj ); 
+    return result; 
+}
+
+//-----------------------------------------------------------------------------
+
+ULONG DXGISwapChainProxy::AddRef()
+{
+    return m_chain->AddRef();
+}
+
+//-----------------------------------------------------------------------------
+
+ULONG DXGISwapChainProxy::Release()
+{
+    return m_chain->Release();
+}
+
+//-----------------------------------------------------------------------------
+
+HRESULT STDMETHODCALLTYPE DXGISwapChainProxy::Present(
+    UINT SyncInterval,
+    UINT Flags
+) {
+    // a test present (for occlusion) is not a frame
+    const bool passThrough = (m_quad == 0) || ((Flags & DXGI_PRESENT_TEST) != 0);
+
+    if ( !passThrough )
+        m_quad->onPrePresentDX( SyncInterval, Flags );
+
+    HRESULT result = S_OK;
+
+    if ( passThrough ) {
+        result = m_chain->Present( SyncInterval, Flags );
+
+        // start the next frame once the chain can queue it, so that it is
+        // rendered as late as possible (a test present queues nothing)
+        if ( (m_waitable != 0) && ((Flags & DXGI_PRESENT_TEST) == 0) )
+            WaitForSingleObjectEx( m_waitable, 1000, TRUE );
+    } else {
+        // Ignore calls to Present() and pretend that it succeeded, as for
+        // Direct3D 9, to avoid flicker when we make the GL window a child
+        // of the original application source window
+    }
+
+    if (Log::verbose()) {
+        Log::print() << "Present("
+            << SyncInterval << ','
+            << Flags << ") = " << result << std::endl;
+    }
+
+    if ( !passThrough )
+        m_quad->onPostPresentDX();
+
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+
+HRESULT STDMETHODCALLTYPE DXGISwapChainProxy::GetBuffer(
+    UINT Buffer,
+    __in REFIID riid,
+    __out void **ppSurface
+) {
+    return m_chain->GetBuffer( Buffer, riid, ppSurface );
+}
+
+//-----------------------------------------------------------------------------
+
+HRESULT STDMETHODCALLTYPE DXGISwapChainProxy::SetFullscreenState(
+    BOOL Fullscreen,
+    __in_opt IDXGIOutput *pTarget
+) {
+    return m_chain->SetFullscreenState( Fullscreen, pTarget );
+}
+
+//-----------------------------------------------------------------------------
+
+HRESULT STDMETHODCALLTYPE DXGISwapChainProxy::GetFullscreenState(
+    __out BOOL *pFullscreen,
+    __out IDXGIOutput **ppTarget
+) {
+    return m_chain->GetFullscreenState( pFullscreen, ppTarget );
+}
+
+//-----------------------------------------------------------------------------
+
+HRESULT STDMETHODCALLTYPE DXGISwapChainProxy::GetDesc(
+    __out DXGI_SWAP_CHAIN_DESC *pDesc
+) {
+    return m_chain->GetDesc( pDesc );
+}
+
+//-----------------------------------------------------------------------------
+
+HRESULT STDMETHODCALLTYPE DXGISwapChainProxy::ResizeBuffers(
+    UINT BufferCount,
+    UINT Width,
+    UINT Height,
+    DXGI_FORMAT NewFormat,
+    UINT SwapChainFlags
+) {
+    // a waitable chain must keep its flag (and the flip model two buffers)
+    if ( m_waitable != 0 ) {
+        SwapChainFlags |= DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT;
+        if ( BufferCount == 1 ) BufferCount = 2;
+    }
+
+    HRESULT result = m_chain->ResizeBuffers(
+        BufferCount,
+        Width,
+        Height,
+        NewFormat,
+        SwapChainFlags
+    );
+
+    if (Log::info()) {
+        Log::print() << "ResizeBuffers("
+            << Width << 'x' << Height << ") = " << result << std::endl;
+    }
+
+    // our render targets have to be rebuilt to match the new back buffer
+    if ( m_quad != 0 )
+        m_quad->onPostResizeBuffersDX( result );
+
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+
+HRESULT STDMETHODCALLTYPE DXGISwapChainProxy::ResizeTarget(
+    __in const DXGI_MODE_DESC *pNewTargetParameters
+) {
+    return m_chain->ResizeTarget( pNewTargetParameters );
+}
+
+//-----------------------------------------------------------------------------
+
+HRESULT STDMETHODCALLTYPE DXGISwapChainProxy::GetContainingOutput(
+    __out IDXGIOutput **ppOutput
+) {
+    return m_chain->GetContainingOutput( ppOutput );
+}
+
+//-----------------------------------------------------------------------------
+
+HRESULT STDMETHODCALLTYPE DXGISwapChainProxy::GetFrameStatistics(
+    __out DXGI_FRAME_STATISTICS *pStats
+) {
+    return m_chain->GetFrameStatistics( pStats );
+}
+
+//-----------------------------------------------------------------------------
+
+HRESULT STDMETHODCALLTYPE DXGISwapChainProxy::GetLastPresentCount(
+    __out UINT *pLastPresentCount
+) {
+    return m_chain->GetLastPresentCount( pLastPresentCount );
+}
+
+//-----------------------------------------------------------------------------
+
+HRESULT STDMETHODCALLTYPE DXGISwapChainProxy::SetPrivateData(
+    __in  REFGUID Name,
+    UINT DataSize,
+    __in_bcount(DataSize)  const void *pData
+) {
+    return m_chain->SetPrivateData( Name, DataSize, pData );
+}
+
+//-----------------------------------------------------------------------------
+
+HRESULT STDMETHODCALLTYPE DXGISwapChainProxy::SetPrivateDataInterface(
+    __in  REFGUID Name,
+    __in  const IUnknown *pUnknown
+) {
+    return m_chain->SetPrivateDataInterface( Name, pUnknown );
+}
+
+//-----------------------------------------------------------------------------
+
+HRESULT STDMETHODCALLTYPE DXGISwapChainProxy::GetPrivateData(
+    __in  REFGUID Name,
+    __inout  UINT *pDataSize,
+    __out_bcount(*pDataSize) void *pData
+) {
+    return m_chain->GetPrivateData( Name, pDataSize, pData );
+}
+
+//-----------------------------------------------------------------------------
+
+HRESULT STDMETHODCALLTYPE DXGISwapChainProxy::GetParent(
+    __in  REFIID riid,
+    __out  void **ppParent
+) {
+    return m_chain->GetParent( riid, ppParent );
+}
+
+//-----------------------------------------------------------------------------
+
+HRESULT STDMETHODCALLTYPE DXGISwapChainProxy::GetDevice(
+    __in  REFIID riid,
+    __out  void **ppDevice
+) {
+    return m_chain->GetDevice( riid, ppDevice );
+}
+
+//-----------------------------------------------------------------------------
+
 #endif//SUPPORT_D3D11
\ No newline at end of file
@@ -0,0 +1,600 @@
+#include "Direct3DDevice9Hooks.h"
+#include <mhook-lib/mhook.h>
+#include <atomic>
+#include <mutex>
+#include "Quadifier.h"
+#include "IDirect3D9Proxy.h"
+#include "ResourceTracker.h"
+#include "Log.h"
+#include "Settings.h"
+using namespace hive;
+using namespace std;
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+namespace {
+
+/// vtable slots of the IDirect3DDevice9 methods which are hooked
+enum Slot {
+    SLOT_GetDirect3D                 = 6,
+    SLOT_Reset                       = 16,
+    SLOT_Present                     = 17,
+    SLOT_CreateTexture               = 23,
+    SLOT_CreateVolumeTexture         = 24,
+    SLOT_CreateCubeTexture           = 25,
+    SLOT_CreateVertexBuffer          = 26,
+    SLOT_CreateIndexBuffer           = 27,
+    SLOT_CreateRenderTarget          = 28,
+    SLOT_CreateDepthStencilSurface   = 29,
+    SLOT_CreateOffscreenPlainSurface = 36,
+    SLOT_Clear                       = 43,
+    SLOT_SetViewport                 = 47
+};
+
+typedef HRESULT (STDMETHODCALLTYPE *PFNGetDirect3D)(
+    IDirect3DDevice9*, IDirect3D9** );
+typedef HRESULT (STDMETHODCALLTYPE *PFNReset)(
+    IDirect3DDevice9*, D3DPRESENT_PARAMETERS* );
+typedef HRESULT (STDMETHODCALLTYPE *PFNPresent)(
+    IDirect3DDevice9*, CONST RECT*, CONST RECT*, HWND, CONST RGNDATA* );
+typedef HRESULT (STDMETHODCALLTYPE *PFNCreateTexture)(
+    IDirect3DDevice9*, UINT, UINT, UINT, DWORD, D3DFORMAT, D3DPOOL,
+    IDirect3DTexture9**, HANDLE* );
+typedef HRESULT (STDMETHODCALLTYPE *PFNCreateVolumeTexture)(
+    IDirect3DDevice9*, UINT, UINT, UINT, UINT, DWORD, D3DFORMAT, D3DPOOL,
+    IDirect3DVolumeTexture9**, HANDLE* );
+typedef HRESULT (STDMETHODCALLTYPE *PFNCreateCubeTexture)(
+    IDirect3DDevice9*, UINT, UINT, DWORD, D3DFORMAT, D3DPOOL,
+    IDirect3DCubeTexture9**, HANDLE* );
+typedef HRESULT (STDMETHODCALLTYPE *PFNCreateVertexBuffer)(
+    IDirect3DDevice9*, UINT, DWORD, DWORD, D3DPOOL,
+    IDirect3DVertexBuffer9**, HANDLE* );
+typedef HRESULT (STDMETHODCALLTYPE *PFNCreateIndexBuffer)(
+    IDirect3DDevice9*, UINT, DWORD, D3DFORMAT, D3DPOOL,
+    IDirect3DIndexBuffer9**, HANDLE* );
+typedef HRESULT (STDMETHODCALLTYPE *PFNCreateRenderTarget)(
+    IDirect3DDevice9*, UINT, UINT, D3DFORMAT, D3DMULTISAMPLE_TYPE, DWORD, BOOL,
+    IDirect3DSurface9**, HANDLE* );
+typedef HRESULT (STDMETHODCALLTYPE *PFNCreateDepthStencilSurface)(
+    IDirect3DDevice9*, UINT, UINT, D3DFORMAT, D3DMULTISAMPLE_TYPE, DWORD, BOOL,
+    IDirect3DSurface9**, HANDLE* );
+typedef HRESULT (STDMETHODCALLTYPE *PFNCreateOffscreenPlainSurface)(
+    IDirect3DDevice9*, UINT, UINT, D3DFORMAT, D3DPOOL,
+    IDirect3DSurface9**, HANDLE* );
+typedef HRESULT (STDMETHODCALLTYPE *PFNClear)(
+    IDirect3DDevice9*, DWORD, CONST D3DRECT*, DWORD, D3DCOLOR, float, DWORD );
+typedef HRESULT (STDMETHODCALLTYPE *PFNSetViewport)(
+    IDirect3DDevice9*, CONST D3DVIEWPORT9* );
+
+/// the real functions (trampolines once hooked)
+PFNGetDirect3D                  real_GetDirect3D = 0;
+PFNReset                        real_Reset = 0;
+PFNPresent                      real_Present = 0;
+PFNCreateTexture                real_CreateTexture = 0;
+PFNCreateVolumeTexture          real_CreateVolumeTexture = 0;
+PFNCreateCubeTexture            real_CreateCubeTexture = 0;
+PFNCreateVertexBuffer           real_CreateVertexBuffer = 0;
+PFNCreateIndexBuffer            real_CreateIndexBuffer = 0;
+PFNCreateRenderTarget           real_CreateRenderTarget = 0;
+PFNCreateDepthStencilSurface    real_CreateDepthStencilSurface = 0;
+PFNCreateOffscreenPlainSurface  real_CreateOffscreenPlainSurface = 0;
+PFNClear                        real_Clear = 0;
+PFNSetViewport                  real_SetViewport = 0;
+
+/// the vtable of the first device attached (all devices must share it)
+void **g_vtable = 0;
+
+/// guards attaching and unhooking
+std::mutex g_mutex;
+
+/// an attached device, and its renderer
+struct Attached {
+    std::atomic<IDirect3DDevice9*> device;  ///< the real device (or 0)
+    IDirect3D9 *direct3D;                   ///< returned by GetDirect3D
+    Quadifier  *quad;                       ///< the DX/OpenGL renderer
+    IDirect3DDevice9Ex *deviceEx;           ///< the device in low latency mode (or 0)
+};
+
+/// the attached devices (written under g_mutex, read without it)
+Attached g_attached[Direct3DDevice9Hooks::CAPACITY];
+
+/// nesting of hooked calls on this thread: calls made by Quadifier itself
+/// (e.g. restoring the viewport) go straight to the device
+__declspec(thread) int t_depth = 0;
+
+/// RAII helper for t_depth
+struct Nested {
+    Nested()  { ++t_depth; }
+    ~Nested() { --t_depth; }
+};
+
+/// Returns the attachment of the device, or 0 if it is not attached (or is
+/// being called from inside another hook)
+Attached * find( IDirect3DDevice9 *device )
+{
+    if ( t_depth > 0 ) return 0;
+    for (unsigned i=0; i<Direct3DDevice9Hooks::CAPACITY; ++i) {
+        if ( g_attached[i].device.load( std::memory_order_acquire ) == device )
+            return &g_attached[i];
+    }
+    return 0;
+}
+
+/// Direct3D9Ex has no managed pool: use the default pool instead (dynamic
+/// for textures, so that they can still be locked)
+void substitutePool( D3DPOOL & Pool, DWORD *Usage )
+{
+    if ( Settings::get().forceDirect3D9Ex && (Pool == D3DPOOL_MANAGED) ) {
+        Pool = D3DPOOL_DEFAULT;
+        if ( Usage != 0 ) *Usage |= D3DUSAGE_DYNAMIC;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+HRESULT STDMETHODCALLTYPE hook_GetDirect3D(
+    IDirect3DDevice9 *self,
+    IDirect3D9 **ppD3D9
+) {
+    HRESULT result = real_GetDirect3D( self, ppD3D9 );
+
+    // return our direct 3D proxy instead of the real one (the proxy
+    // forwards its reference counting, so the reference taken still holds)
+    Attached *attached = find( self );
+    if ( (attached != 0) && SUCCEEDED( result ) && (ppD3D9 != 0) )
+        *ppD3D9 = attached->direct3D;
+
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+
+HRESULT STDMETHODCALLTYPE hook_Reset(
+    IDirect3DDevice9 *self,
+    D3DPRESENT_PARAMETERS *pPresentParam
+) {
+    Attached *attached = find( self );
+    if ( attached == 0 ) return real_Reset( self, pPresentParam );
+    Nested nested;
+
+    if (Log::info()) {
+        Log::print( "IDirect3DDevice9::Reset: " )
+            << pPresentParam->BackBufferWidth << 'x' << pPresentParam->BackBufferHeight << ','
+            << "backBuffers=" << pPresentParam->BackBufferCount << ','
+            << "windowed=" << pPresentParam->Windowed << endl;
+    }
+
+    if ( pPresentParam->Windowed == FALSE ) {
+        if (Log::info())
+            Log::print("Forcing windowed mode\n");
+        // enforce windowed mode
+        pPresentParam->Windowed = TRUE;
+        pPresentParam->FullScreen_RefreshRateInHz = 0;
+    }
+
+    const bool passThrough = Settings::get().passThrough;
+
+    // our render targets have to be rebuilt to match the new back buffer
+    if ( !passThrough )
+        attached->quad->onPreResetDX();
+
+    HRESULT result = real_Reset( self, pPresentParam );
+
+    if ( !passThrough )
+        attached->quad->onPostResetDX( result );
+
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+
+HRESULT STDMETHODCALLTYPE hook_Present(
+    IDirect3DDevice9 *self,
+    CONST RECT *pSourceRect,
+    CONST RECT *pDestRect,
+    HWND hDestWindowOverride,
+    CONST RGNDATA *pDirtyRegion
+) {
+    Attached *attached = find( self );
+    if ( (attached != 0) && (attached->deviceEx != 0) && Settings::get().passThrough ) {
+        // in low latency mode a frame is dropped, rather than waited for,
+        // when the GPU still has a frame queued (PresentEx is not hooked)
+        Nested nested;
+        HRESULT result = attached->deviceEx->PresentEx(
+            pSourceRect, pDestRect, hDestWindowOverride, pDirtyRegion,
+            D3DPRESENT_DONOTWAIT
+        );
+        return ( result == D3DERR_WASSTILLDRAWING ) ? D3D_OK : result;
+    }
+    if ( (attached == 0) || Settings::get().passThrough )
+        return real_Present(
+            self, pSourceRect, pDestRect, hDestWindowOverride, pDirtyRegion
+        );
+    Nested nested;
+
+    attached->quad->onPrePresentDX(
+        pSourceRect,
+        pDestRect,
+        hDestWindowOverride,
+        pDirtyRegion
+    );
+
+    // Ignore calls to Present() and pretend that it succeeded, to avoid
+    // flicker when we make the GL window a child of the original
+    // application source window
+
+    attached->quad->onPostPresentDX();
+
+    return D3D_OK;
+}
+
+//-----------------------------------------------------------------------------
+
+HRESULT STDMETHODCALLTYPE hook_CreateTexture(
+    IDirect3DDevice9 *self,
+    UINT Width,
+    UINT Height,
+    UINT Levels,
+    DWORD Usage,
+    D3DFORMAT Format,
+    D3DPOOL Pool,
+    IDirect3DTexture9 **ppTexture,
+    HANDLE *pSharedHandle
+) {
+    const bool attached = ( find( self ) != 0 );
+    if ( attached ) substitutePool( Pool, &Usage );
+
+    HRESULT result = real_CreateTexture(
+        self, Width, Height, Levels, Usage, Format, Pool, ppTexture, pSharedHandle
+    );
+    if ( attached && SUCCEEDED( result ) ) ResourceTracker::track( *ppTexture );
+
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+
+HRESULT STDMETHODCALLTYPE hook_CreateVolumeTexture(
+    IDirect3DDevice9 *self,
+    UINT Width,
+    UINT Height,
+    UINT Depth,
+    UINT Levels,
+    DWORD Usage,
+    D3DFORMAT Format,
+    D3DPOOL Pool,
+    IDirect3DVolumeTexture9 **ppVolumeTexture,
+    HANDLE *pSharedHandle
+) {
+    const bool attached = ( find( self ) != 0 );
+    if ( attached ) substitutePool( Pool, &Usage );
+
+    HRESULT result = real_CreateVolumeTexture(
+        self, Width, Height, Depth, Levels, Usage, Format, Pool,
+        ppVolumeTexture, pSharedHandle
+    );
+    if ( attached && SUCCEEDED( result ) ) ResourceTracker::track( *ppVolumeTexture );
+
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+
+HRESULT STDMETHODCALLTYPE hook_CreateCubeTexture(
+    IDirect3DDevice9 *self,
+    UINT EdgeLength,
+    UINT Levels,
+    DWORD Usage,
+    D3DFORMAT Format,
+    D3DPOOL Pool,
+    IDirect3DCubeTexture9 **ppCubeTexture,
+    HANDLE *pSharedHandle
+) {
+    const bool attached = ( find( self ) != 0 );
+    if ( attached ) substitutePool( Pool, &Usage );
+
+    HRESULT result = real_CreateCubeTexture(
+        self, EdgeLength, Levels, Usage, Format, Pool, ppCubeTexture, pSharedHandle
+    );
+    if ( attached && SUCCEEDED( result ) ) ResourceTracker::track( *ppCubeTexture );
+
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+
+HRESULT STDMETHODCALLTYPE hook_CreateVertexBuffer(
+    IDirect3DDevice9 *self,
+    UINT Length,
+    DWORD Usage,
+    DWORD FVF,
+    D3DPOOL Pool,
+    IDirect3DVertexBuffer9 **ppVertexBuffer,
+    HANDLE *pSharedHandle
+) {
+    const bool attached = ( find( self ) != 0 );
+    if ( attached ) substitutePool( Pool, 0 );
+
+    HRESULT result = real_CreateVertexBuffer(
+        self, Length, Usage, FVF, Pool, ppVertexBuffer, pSharedHandle
+    );
+    if ( attached && SUCCEEDED( result ) ) ResourceTracker::track( *ppVertexBuffer );
+
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+
+HRESULT STDMETHODCALLTYPE hook_CreateIndexBuffer(
+    IDirect3DDevice9 *self,
+    UINT Length,
+    DWORD Usage,
+    D3DFORMAT Format,
+    D3DPOOL Pool,
+    IDirect3DIndexBuffer9 **ppIndexBuffer,
+    HANDLE *pSharedHandle
+) {
+    const bool attached = ( find( self ) != 0 );
+    if ( attached ) substitutePool( Pool, 0 );
+
+    HRESULT result = real_CreateIndexBuffer(
+        self, Length, Usage, Format, Pool, ppIndexBuffer, pSharedHandle
+    );
+    if ( attached && SUCCEEDED( result ) ) ResourceTracker::track( *ppIndexBuffer );
+
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+
+HRESULT STDMETHODCALLTYPE hook_CreateRenderTarget(
+    IDirect3DDevice9 *self,
+    UINT Width,
+    UINT Height,
+    D3DFORMAT Format,
+    D3DMULTISAMPLE_TYPE MultiSample,
+    DWORD MultisampleQuality,
+    BOOL Lockable,
+    IDirect3DSurface9 **ppSurface,
+    HANDLE *pSharedHandle
+) {
+    const bool attached = ( find( self ) != 0 );
+
+    HRESULT result = real_CreateRenderTarget(
+        self, Width, Height, Format, MultiSample, MultisampleQuality, Lockable,
+        ppSurface, pSharedHandle
+    );
+    if ( attached && SUCCEEDED( result ) ) ResourceTracker::track( *ppSurface );
+
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+
+HRESULT STDMETHODCALLTYPE hook_CreateDepthStencilSurface(
+    IDirect3DDevice9 *self,
+    UINT Width,
+    UINT Height,
+    D3DFORMAT Format,
+    D3DMULTISAMPLE_TYPE MultiSample,
+    DWORD MultisampleQuality,
+    BOOL Discard,
+    IDirect3DSurface9 **ppSurface,
+    HANDLE *pSharedHandle
+) {
+    const bool attached = ( find( self ) != 0 );
+
+    HRESULT result = real_CreateDepthStencilSurface(
+        self, Width, Height, Format, MultiSample, MultisampleQuality, Discard,
+        ppSurface, pSharedHandle
+    );
+    if ( attached && SUCCEEDED( result ) ) ResourceTracker::track( *ppSurface );
+
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+
+HRESULT STDMETHODCALLTYPE hook_CreateOffscreenPlainSurface(
+    IDirect3DDevice9 *self,
+    UINT Width,
+    UINT Height,
+    D3DFORMAT Format,
+    D3DPOOL Pool,
+    IDirect3DSurface9 **ppSurface,
+    HANDLE *pSharedHandle
+) {
+    const bool attached = ( find( self ) != 0 );
+    if ( attached ) substitutePool( Pool, 0 );
+
+    HRESULT result = real_CreateOffscreenPlainSurface(
+        self, Width, Height, Format, Pool, ppSurface, pSharedHandle
+    );
+    if ( attached && SUCCEEDED( result ) ) ResourceTracker::track( *ppSurface );
+
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+
+HRESULT STDMETHODCALLTYPE hook_Clear(
+    IDirect3DDevice9 *self,
+    DWORD Count,
+    CONST D3DRECT *pRects,
+    DWORD Flags,
+    D3DCOLOR Color,
+    float Z,
+    DWORD Stencil
+) {
+    Attached *attached = find( self );
+    if ( (attached == 0) || Settings::get().passThrough )
+        return real_Clear( self, Count, pRects, Flags, Color, Z, Stencil );
+    Nested nested;
+
+    attached->quad->onPreClearDX( Count, pRects, Flags, Color, Z, Stencil );
+
+    HRESULT result = real_Clear( self, Count, pRects, Flags, Color, Z, Stencil );
+
+    attached->quad->onPostClearDX();
+
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+
+HRESULT STDMETHODCALLTYPE hook_SetViewport(
+    IDirect3DDevice9 *self,
+    CONST D3DVIEWPORT9 *pViewport
+) {
+    Attached *attached = find( self );
+    if ( (attached != 0) && !Settings::get().passThrough ) {
+        Nested nested;
+
+        // call handler: if it returns false, bypass the real D3D function by
+        // returning D3D_OK
+        if ( !attached->quad->onPreSetViewportDX( pViewport ) )
+            return D3D_OK;
+    }
+
+    return real_SetViewport( self, pViewport );
+}
+
+//-----------------------------------------------------------------------------
+
+/// one hooked slot: where the real function pointer lives, and the hook
+struct Hook {
+    unsigned slot;
+    PVOID   *real;
+    PVOID    hook;
+};
+
+#define HOOK(name) { SLOT_##name, reinterpret_cast<PVOID*>(&real_##name), \
+    reinterpret_cast<PVOID>(hook_##name) }
+
+const Hook g_hooks[] = {
+    HOOK(GetDirect3D),
+    HOOK(Reset),
+    HOOK(Present),
+    HOOK(CreateTexture),
+    HOOK(CreateVolumeTexture),
+    HOOK(CreateCubeTexture),
+    HOOK(CreateVertexBuffer),
+    HOOK(CreateIndexBuffer),
+    HOOK(CreateRenderTarget),
+    HOOK(CreateDepthStencilSurface),
+    HOOK(CreateOffscreenPlainSurface),
+    HOOK(Clear),
+    HOOK(SetViewport)
+};
+
+#undef HOOK
+
+const unsigned HOOK_COUNT = sizeof(g_hooks) / sizeof(g_hooks[0]);
+
+/// hook the functions of the vtable (call with g_mutex held)
+bool install( void **vtable )
+{
+    for (unsigned i=0; i<HOOK_COUNT; ++i) {
+        *g_hooks[i].real = vtable[g_hooks[i].slot];
+        if ( !Mhook_SetHook( g_hooks[i].real, g_hooks[i].hook ) ) {
+            Log::print( "error: failed to hook IDirect3DDevice9 vtable slot " )
+                << g_hooks[i].slot << endl;
+
+            // undo the hooks made so far
+            while ( i-- > 0 ) Mhook_Unhook( g_hooks[i].real );
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+
+bool Direct3DDevice9Hooks::attach(
+    IDirect3DDevice9 *device,
+    IDirect3D9 *direct3D
+) {
+    if ( device == 0 ) return false;
+    std::lock_guard<std::mutex> lock( g_mutex );
+
+    // the first device's implementation is hooked; others must share it
+    void **vtable = *reinterpret_cast<void***>( device );
+    if ( g_vtable == 0 ) {
+        if ( !install( vtable ) ) return false;
+        g_vtable = vtable;
+    } else if ( vtable != g_vtable ) {
+        Log::print( "warning: IDirect3DDevice9 has a different implementation, "
+                    "cannot hook it\n" );
+        return false;
+    }
+
+    // find a free entry, or the entry of an earlier device at the same
+    // address (its renderer is abandoned, as with the proxy)
+    unsigned index = CAPACITY;
+    for (unsigned i=0; i<CAPACITY; ++i) {
+        IDirect3DDevice9 *entry = g_attached[i].device.load();
+        if ( entry == device ) { index = i; break; }
+        if ( (entry == 0) && (index == CAPACITY) ) index = i;
+    }
+    if ( index == CAPACITY ) {
+        Log::print( "warning: too many IDirect3DDevice9 hooked\n" );
+        return false;
+    }
+
+    Attached & attached = g_attached[index];
+    attached.device.store( 0 );
+    attached.direct3D = direct3D;
+    attached.quad = new Quadifier( device, direct3D );
+    attached.deviceEx = IDirect3D9Proxy::lowLatency( device );
+
+    if (Log::info())
+        Log::print() << "Direct3DDevice9Hooks::attach(" << device << ','
+            << direct3D << ")\n";
+
+    // when the D3D device is created, call onCreateDX
+    if ( !Settings::get().passThrough ) attached.quad->onCreateDX();
+
+    // publish the entry last, so that hooks only see it complete
+    attached.device.store( device, std::memory_order_release );
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void Direct3DDevice9Hooks::unhook()
+{
+    std::lock_guard<std::mutex> lock( g_mutex );
+    if ( g_vtable == 0 ) return;
+
+    for (unsigned i=0; i<HOOK_COUNT; ++i)
+        Mhook_Unhook( g_hooks[i].real );
+    g_vtable = 0;
+}
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,63 @@
+#ifndef hive_Direct3DDevice9Hooks_h
+#define hive_Direct3DDevice9Hooks_h
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+#include <d3d9.h>
+
+//-----------------------------------------------------------------------------
+
+/**
+ * Alternative to IDirect3DDevice9Proxy which hooks only the methods of the
+ * real device that Quadifier acts on (Present, Clear, SetViewport, Reset,
+ * GetDirect3D and the resource creation methods, which change the pool for
+ * Direct3D9Ex and feed ResourceTracker), so that every other call, in
+ * particular the draw and state calls, goes straight to the driver.
+ *
+ * The functions found in the device's vtable slots are patched with mhook,
+ * so the hooks apply to every device with the same implementation: calls
+ * for devices which have not been attached pass straight through. Devices
+ * with a different implementation (vtable) from the first one attached
+ * cannot be hooked (attach returns false, and the proxy should be used).
+ */
+class Direct3DDevice9Hooks {
+public:
+    /// Maximum number of attached devices
+    static const unsigned CAPACITY = 8;
+
+    /// Hook the device (installing the hooks if this is the first device),
+    /// with the IDirect3D9 interface to return from GetDirect3D. Returns
+    /// false if the device cannot be hooked.
+    static bool attach( IDirect3DDevice9 *device, IDirect3D9 *direct3D );
+
+    /// Remove all the hooks
+    static void unhook();
+};
+
+//-----------------------------------------------------------------------------
+
+#endif//hive_Direct3DDevice9Hooks_h
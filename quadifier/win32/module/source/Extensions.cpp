@@ -1,142 +1,578 @@
-#include "Extensions.h"
-
-//-----------------------------------------------------------------------------
-
-Extensions::Extensions() :
-    wglDXSetResourceShareHandleNV(0),
-    wglDXOpenDeviceNV(0),
-    wglDXCloseDeviceNV(0),
-    wglDXRegisterObjectNV(0),
-    wglDXUnregisterObjectNV(0),
-    wglDXObjectAccessNV(0),
-    wglDXLockObjectsNV(0),
-    wglDXUnlockObjectsNV(0),
-    glGenFramebuffers(0),
-    glBindFramebuffer(0),
-    glFramebufferTexture2D(0),
-    glBindRenderbuffer(0),
-    glGenRenderbuffers(0),
-    glDeleteRenderbuffers(0),
-    glFramebufferRenderbuffer(0),
-    glBlitFramebuffer(0),
-    glCheckFramebufferStatus(0),
-    glGetRenderbufferParameteriv(0)
-{
-}
-
-//-----------------------------------------------------------------------------
-
-bool Extensions::load()
-{
-    wglDXSetResourceShareHandleNV =
-        reinterpret_cast<PFNWGLDXSETRESOURCESHAREHANDLENVPROC>
-            ( wglGetProcAddress( "wglDXSetResourceShareHandleNV" ) );
-
-    bool success = ( wglDXSetResourceShareHandleNV != 0 );
-
-    wglDXOpenDeviceNV = reinterpret_cast<PFNWGLDXOPENDEVICENVPROC>
-        ( wglGetProcAddress( "wglDXOpenDeviceNV" ) );
-
-    success = success && ( wglDXOpenDeviceNV != 0 );
-
-    wglDXCloseDeviceNV = reinterpret_cast<PFNWGLDXCLOSEDEVICENVPROC>
-        ( wglGetProcAddress( "wglDXCloseDeviceNV" ) );
-
-    success = success && ( wglDXCloseDeviceNV != 0 );
-
-    wglDXRegisterObjectNV = reinterpret_cast<PFNWGLDXREGISTEROBJECTNVPROC>
-        ( wglGetProcAddress( "wglDXRegisterObjectNV" ) );
-
-    success = success && ( wglDXRegisterObjectNV != 0 );
-
-    wglDXUnregisterObjectNV = reinterpret_cast<PFNWGLDXUNREGISTEROBJECTNVPROC>
-        ( wglGetProcAddress( "wglDXUnregisterObjectNV" ) );
-
-    success = success && ( wglDXUnregisterObjectNV != 0 );
-
-    wglDXObjectAccessNV = reinterpret_cast<PFNWGLDXOBJECTACCESSNVPROC>
-        ( wglGetProcAddress( "wglDXObjectAccessNV" ) );
-
-    success = success && ( wglDXObjectAccessNV != 0 );
-
-    wglDXLockObjectsNV = reinterpret_cast<PFNWGLDXLOCKOBJECTSNVPROC>
-        ( wglGetProcAddress( "wglDXLockObjectsNV" ) );
-
-    success = success && ( wglDXLockObjectsNV != 0 );
-
-    wglDXUnlockObjectsNV =
-        reinterpret_cast<PFNWGLDXUNLOCKOBJECTSNVPROC>
-            ( wglGetProcAddress( "wglDXUnlockObjectsNV" ) );
-
-    success = success && ( wglDXUnlockObjectsNV != 0 );
-
-    glGenFramebuffers =
-        reinterpret_cast<PFNGLGENFRAMEBUFFERSPROC>
-            ( wglGetProcAddress( "glGenFramebuffers" ) );
-
-    success = success && ( glGenFramebuffers != 0 );
-
-    glBindFramebuffer =
-        reinterpret_cast<PFNGLBINDFRAMEBUFFERPROC>
-            ( wglGetProcAddress( "glBindFramebuffer" ) );
-
-    success = success && ( glBindFramebuffer != 0 );
-
-    glFramebufferTexture2D =
-        reinterpret_cast<PFNGLFRAMEBUFFERTEXTURE2DPROC>
-            ( wglGetProcAddress( "glFramebufferTexture2D" ) );
-
-    success = success && ( glBindFramebuffer != 0 );
-
-    glBindRenderbuffer =
-        reinterpret_cast<PFNGLBINDRENDERBUFFERPROC>
-            ( wglGetProcAddress( "glBindRenderbuffer" ) );
-
-    success = success && ( glBindRenderbuffer != 0 );
-
-    glGenRenderbuffers =
-        reinterpret_cast<PFNGLGENRENDERBUFFERSPROC>
-            ( wglGetProcAddress( "glGenRenderbuffers" ) );
-
-    success = success && ( glGenRenderbuffers != 0 );
-
-    glRenderbufferStorage =
-        reinterpret_cast<PFNGLRENDERBUFFERSTORAGEPROC>
-            ( wglGetProcAddress( "glRenderbufferStorage" ) );
-
-    success = success && ( glRenderbufferStorage != 0 );
-
-    glDeleteRenderbuffers =
-        reinterpret_cast<PFNGLDELETERENDERBUFFERSPROC>
-            ( wglGetProcAddress( "glDeleteRenderbuffers" ) );
-
-    success = success && ( glDeleteRenderbuffers != 0 );
-
-    glFramebufferRenderbuffer =
-        reinterpret_cast<PFNGLFRAMEBUFFERRENDERBUFFERPROC>
-            ( wglGetProcAddress( "glFramebufferRenderbuffer" ) );
-
-    success = success && ( glFramebufferRenderbuffer != 0 );
-
-    glBlitFramebuffer =
-        reinterpret_cast<PFNGLBLITFRAMEBUFFERPROC>
-            ( wglGetProcAddress( "glBlitFramebuffer" ) );
-
-    success = success && ( glBlitFramebuffer != 0 );
-
-    glCheckFramebufferStatus =
-        reinterpret_cast<PFNGLCHECKFRAMEBUFFERSTATUSPROC>
-            ( wglGetProcAddress( "glCheckFramebufferStatus" ) );
-
-    success = success && ( glCheckFramebufferStatus != 0 );
-
-    glGetRenderbufferParameteriv =
-        reinterpret_cast<PFNGLGETRENDERBUFFERPARAMETERIVPROC>
-            ( wglGetProcAddress( "glGetRenderbufferParameteriv" ) );
-
-    success = success && ( glGetRenderbufferParameteriv != 0 );
-
-    return success;
-}//load
-
-//-----------------------------------------------------------------------------
+#include "Extensions.h"
+
+//-----------------------------------------------------------------------------
+
+Extensions::Extensions() :
+    wglDXSetResourceShareHandleNV(0),
+    wglDXOpenDeviceNV(0),
+    wglDXCloseDeviceNV(0),
+    wglDXRegisterObjectNV(0),
+    wglDXUnregisterObjectNV(0),
+    wglDXObjectAccessNV(0),
+    wglDXLockObjectsNV(0),
+    wglDXUnlockObjectsNV(0),
+    glGenFramebuffers(0),
+    glBindFramebuffer(0),
+    glDeleteFramebuffers(0),
+    glFramebufferTexture2D(0),
+    glBindRenderbuffer(0),
+    glGenRenderbuffers(0),
+    glDeleteRenderbuffers(0),
+    glFramebufferRenderbuffer(0),
+    glBlitFramebuffer(0),
+    glCheckFramebufferStatus(0),
+    glGetRenderbufferParameteriv(0),
+    wglJoinSwapGroupNV(0),
+    wglBindSwapBarrierNV(0),
+    wglQuerySwapGroupNV(0),
+    wglQueryMaxSwapGroupsNV(0),
+    wglQueryFrameCountNV(0),
+    glActiveTexture(0),
+    glCreateShader(0),
+    glShaderSource(0),
+    glCompileShader(0),
+    glGetShaderiv(0),
+    glGetShaderInfoLog(0),
+    glDeleteShader(0),
+    glCreateProgram(0),
+    glAttachShader(0),
+    glBindAttribLocation(0),
+    glLinkProgram(0),
+    glGetProgramiv(0),
+    glGetProgramInfoLog(0),
+    glDeleteProgram(0),
+    glUseProgram(0),
+    glGetUniformLocation(0),
+    glUniform1i(0),
+    glUniform1f(0),
+    glUniform2f(0),
+    glUniform3f(0),
+    glUniform4f(0),
+    glUniformMatrix3fv(0),
+    glGenBuffers(0),
+    glBindBuffer(0),
+    glBufferData(0),
+    glDeleteBuffers(0),
+    glGenVertexArrays(0),
+    glBindVertexArray(0),
+    glDeleteVertexArrays(0),
+    glVertexAttribPointer(0),
+    glEnableVertexAttribArray(0),
+    glGenQueries(0),
+    glDeleteQueries(0),
+    glQueryCounter(0),
+    glGetQueryObjectiv(0),
+    glGetQueryObjectui64v(0),
+    glFenceSync(0),
+    glWaitSync(0),
+    glClientWaitSync(0),
+    glDeleteSync(0),
+    glBufferStorage(0),
+    glMapBufferRange(0),
+    glUnmapBuffer(0),
+    wglCopyImageSubDataNV(0),
+    wglEnumGpusNV(0),
+    wglCreateAffinityDCNV(0),
+    wglDeleteDCNV(0),
+    glDebugMessageCallback(0),
+    glDebugMessageControl(0)
+{
+}
+
+//-----------------------------------------------------------------------------
+
+bool Extensions::load()
+{
+    wglDXSetResourceShareHandleNV =
+        reinterpret_cast<PFNWGLDXSETRESOURCESHAREHANDLENVPROC>
+            ( wglGetProcAddress( "wglDXSetResourceShareHandleNV" ) );
+
+    bool success = ( wglDXSetResourceShareHandleNV != 0 );
+
+    wglDXOpenDeviceNV = reinterpret_cast<PFNWGLDXOPENDEVICENVPROC>
+        ( wglGetProcAddress( "wglDXOpenDeviceNV" ) );
+
+    success = success && ( wglDXOpenDeviceNV != 0 );
+
+    wglDXCloseDeviceNV = reinterpret_cast<PFNWGLDXCLOSEDEVICENVPROC>
+        ( wglGetProcAddress( "wglDXCloseDeviceNV" ) );
+
+    success = success && ( wglDXCloseDeviceNV != 0 );
+
+    wglDXRegisterObjectNV = reinterpret_cast<PFNWGLDXREGISTEROBJECTNVPROC>
+        ( wglGetProcAddress( "wglDXRegisterObjectNV" ) );
+
+    success = success && ( wglDXRegisterObjectNV != 0 );
+
+    wglDXUnregisterObjectNV = reinterpret_cast<PFNWGLDXUNREGISTEROBJECTNVPROC>
+        ( wglGetProcAddress( "wglDXUnregisterObjectNV" ) );
+
+    success = success && ( wglDXUnregisterObjectNV != 0 );
+
+    wglDXObjectAccessNV = reinterpret_cast<PFNWGLDXOBJECTACCESSNVPROC>
+        ( wglGetProcAddress( "wglDXObjectAccessNV" ) );
+
+    success = success && ( wglDXObjectAccessNV != 0 );
+
+    wglDXLockObjectsNV = reinterpret_cast<PFNWGLDXLOCKOBJECTSNVPROC>
+        ( wglGetProcAddress( "wglDXLockObjectsNV" ) );
+
+    success = success && ( wglDXLockObjectsNV != 0 );
+
+    wglDXUnlockObjectsNV =
+        reinterpret_cast<PFNWGLDXUNLOCKOBJECTSNVPROC>
+            ( wglGetProcAddress( "wglDXUnlockObjectsNV" ) );
+
+    success = success && ( wglDXUnlockObjectsNV != 0 );
+
+    glGenFramebuffers =
+        reinterpret_cast<PFNGLGENFRAMEBUFFERSPROC>
+            ( wglGetProcAddress( "glGenFramebuffers" ) );
+
+    success = success && ( glGenFramebuffers != 0 );
+
+    glBindFramebuffer =
+        reinterpret_cast<PFNGLBINDFRAMEBUFFERPROC>
+            ( wglGetProcAddress( "glBindFramebuffer" ) );
+
+    success = success && ( glBindFramebuffer != 0 );
+
+    glDeleteFramebuffers =
+        reinterpret_cast<PFNGLDELETEFRAMEBUFFERSPROC>
+            ( wglGetProcAddress( "glDeleteFramebuffers" ) );
+
+    success = success && ( glDeleteFramebuffers != 0 );
+
+    glFramebufferTexture2D =
+        reinterpret_cast<PFNGLFRAMEBUFFERTEXTURE2DPROC>
+            ( wglGetProcAddress( "glFramebufferTexture2D" ) );
+
+    success = success && ( glBindFramebuffer != 0 );
+
+    glBindRenderbuffer =
+        reinterpret_cast<PFNGLBINDRENDERBUFFERPROC>
+            ( wglGetProcAddress( "glBindRenderbuffer" ) );
+
+    success = success && ( glBindRenderbuffer != 0 );
+
+    glGenRenderbuffers =
+        reinterpret_cast<PFNGLGENRENDERBUFFERSPROC>
+            ( wglGetProcAddress( "glGenRenderbuffers" ) );
+
+    success = success && ( glGenRenderbuffers != 0 );
+
+    glRenderbufferStorage =
+        reinterpret_cast<PFNGLRENDERBUFFERSTORAGEPROC>
+            ( wglGetProcAddress( "glRenderbufferStorage" ) );
+
+    success = success && ( glRenderbufferStorage != 0 );
+
+    glDeleteRenderbuffers =
+        reinterpret_cast<PFNGLDELETERENDERBUFFERSPROC>
+            ( wglGetProcAddress( "glDeleteRenderbuffers" ) );
+
+    success = success && ( glDeleteRenderbuffers != 0 );
+
+    glFramebufferRenderbuffer =
+        reinterpret_cast<PFNGLFRAMEBUFFERRENDERBUFFERPROC>
+            ( wglGetProcAddress( "glFramebufferRenderbuffer" ) );
+
+    success = success && ( glFramebufferRenderbuffer != 0 );
+
+    glBlitFramebuffer =
+        reinterpret_cast<PFNGLBLITFRAMEBUFFERPROC>
+            ( wglGetProcAddress( "glBlitFramebuffer" ) );
+
+    success = success && ( glBlitFramebuffer != 0 );
+
+    glCheckFramebufferStatus =
+        reinterpret_cast<PFNGLCHECKFRAMEBUFFERSTATUSPROC>
+            ( wglGetProcAddress( "glCheckFramebufferStatus" ) );
+
+    success = success && ( glCheckFramebufferStatus != 0 );
+
+    glGetRenderbufferParameteriv =
+        reinterpret_cast<PFNGLGETRENDERBUFFERPARAMETERIVPROC>
+            ( wglGetProcAddress( "glGetRenderbufferParameteriv" ) );
+
+    success = success && ( glGetRenderbufferParameteriv != 0 );
+
+    // swap groups are optional, so these don't affect success
+    wglJoinSwapGroupNV =
+        reinterpret_cast<PFNWGLJOINSWAPGROUPNVPROC>
+            ( wglGetProcAddress( "wglJoinSwapGroupNV" ) );
+
+    wglBindSwapBarrierNV =
+        reinterpret_cast<PFNWGLBINDSWAPBARRIERNVPROC>
+            ( wglGetProcAddress( "wglBindSwapBarrierNV" ) );
+
+    wglQuerySwapGroupNV =
+        reinterpret_cast<PFNWGLQUERYSWAPGROUPNVPROC>
+            ( wglGetProcAddress( "wglQuerySwapGroupNV" ) );
+
+    wglQueryMaxSwapGroupsNV =
+        reinterpret_cast<PFNWGLQUERYMAXSWAPGROUPSNVPROC>
+            ( wglGetProcAddress( "wglQueryMaxSwapGroupsNV" ) );
+
+    wglQueryFrameCountNV =
+        reinterpret_cast<PFNWGLQUERYFRAMECOUNTNVPROC>
+            ( wglGetProcAddress( "wglQueryFrameCountNV" ) );
+
+    return success;
+}//load
+
+//-----------------------------------------------------------------------------
+
+bool Extensions::hasSwapGroup() const
+{
+    return ( wglJoinSwapGroupNV != 0 ) && ( wglBindSwapBarrierNV != 0 ) &&
+           ( wglQuerySwapGroupNV != 0 ) && ( wglQueryMaxSwapGroupsNV != 0 ) &&
+           ( wglQueryFrameCountNV != 0 );
+}
+
+//-----------------------------------------------------------------------------
+
+bool Extensions::hasFramebuffers() const
+{
+    return ( glGenFramebuffers != 0 ) && ( glBindFramebuffer != 0 ) &&
+           ( glDeleteFramebuffers != 0 ) && ( glFramebufferTexture2D != 0 ) &&
+           ( glBlitFramebuffer != 0 ) && ( glCheckFramebufferStatus != 0 );
+}
+
+//-----------------------------------------------------------------------------
+
+bool Extensions::loadShaders()
+{
+    glActiveTexture =
+        reinterpret_cast<PFNGLACTIVETEXTUREPROC>
+            ( wglGetProcAddress( "glActiveTexture" ) );
+
+    bool success = ( glActiveTexture != 0 );
+
+    glCreateShader =
+        reinterpret_cast<PFNGLCREATESHADERPROC>
+            ( wglGetProcAddress( "glCreateShader" ) );
+
+    success = success && ( glCreateShader != 0 );
+
+    glShaderSource =
+        reinterpret_cast<PFNGLSHADERSOURCEPROC>
+            ( wglGetProcAddress( "glShaderSource" ) );
+
+    success = success && ( glShaderSource != 0 );
+
+    glCompileShader =
+        reinterpret_cast<PFNGLCOMPILESHADERPROC>
+            ( wglGetProcAddress( "glCompileShader" ) );
+
+    success = success && ( glCompileShader != 0 );
+
+    glGetShaderiv =
+        reinterpret_cast<PFNGLGETSHADERIVPROC>
+            ( wglGetProcAddress( "glGetShaderiv" ) );
+
+    success = success && ( glGetShaderiv != 0 );
+
+    glGetShaderInfoLog =
+        reinterpret_cast<PFNGLGETSHADERINFOLOGPROC>
+            ( wglGetProcAddress( "glGetShaderInfoLog" ) );
+
+    success = success && ( glGetShaderInfoLog != 0 );
+
+    glDeleteShader =
+        reinterpret_cast<PFNGLDELETESHADERPROC>
+            ( wglGetProcAddress( "glDeleteShader" ) );
+
+    success = success && ( glDeleteShader != 0 );
+
+    glCreateProgram =
+        reinterpret_cast<PFNGLCREATEPROGRAMPROC>
+            ( wglGetProcAddress( "glCreateProgram" ) );
+
+    success = success && ( glCreateProgram != 0 );
+
+    glAttachShader =
+        reinterpret_cast<PFNGLATTACHSHADERPROC>
+            ( wglGetProcAddress( "glAttachShader" ) );
+
+    success = success && ( glAttachShader != 0 );
+
+    glBindAttribLocation =
+        reinterpret_cast<PFNGLBINDATTRIBLOCATIONPROC>
+            ( wglGetProcAddress( "glBindAttribLocation" ) );
+
+    success = success && ( glBindAttribLocation != 0 );
+
+    glLinkProgram =
+        reinterpret_cast<PFNGLLINKPROGRAMPROC>
+            ( wglGetProcAddress( "glLinkProgram" ) );
+
+    success = success && ( glLinkProgram != 0 );
+
+    glGetProgramiv =
+        reinterpret_cast<PFNGLGETPROGRAMIVPROC>
+            ( wglGetProcAddress( "glGetProgramiv" ) );
+
+    success = success && ( glGetProgramiv != 0 );
+
+    glGetProgramInfoLog =
+        reinterpret_cast<PFNGLGETPROGRAMINFOLOGPROC>
+            ( wglGetProcAddress( "glGetProgramInfoLog" ) );
+
+    success = success && ( glGetProgramInfoLog != 0 );
+
+    glDeleteProgram =
+        reinterpret_cast<PFNGLDELETEPROGRAMPROC>
+            ( wglGetProcAddress( "glDeleteProgram" ) );
+
+    success = success && ( glDeleteProgram != 0 );
+
+    glUseProgram =
+        reinterpret_cast<PFNGLUSEPROGRAMPROC>
+            ( wglGetProcAddress( "glUseProgram" ) );
+
+    success = success && ( glUseProgram != 0 );
+
+    glGetUniformLocation =
+        reinterpret_cast<PFNGLGETUNIFORMLOCATIONPROC>
+            ( wglGetProcAddress( "glGetUniformLocation" ) );
+
+    success = success && ( glGetUniformLocation != 0 );
+
+    glUniform1i =
+        reinterpret_cast<PFNGLUNIFORM1IPROC>
+            ( wglGetProcAddress( "glUniform1i" ) );
+
+    success = success && ( glUniform1i != 0 );
+
+    glUniform1f =
+        reinterpret_cast<PFNGLUNIFORM1FPROC>
+            ( wglGetProcAddress( "glUniform1f" ) );
+
+    success = success && ( glUniform1f != 0 );
+
+    glUniform2f =
+        reinterpret_cast<PFNGLUNIFORM2FPROC>
+            ( wglGetProcAddress( "glUniform2f" ) );
+
+    success = success && ( glUniform2f != 0 );
+
+    glUniform3f =
+        reinterpret_cast<PFNGLUNIFORM3FPROC>
+            ( wglGetProcAddress( "glUniform3f" ) );
+
+    success = success && ( glUniform3f != 0 );
+
+    glUniform4f =
+        reinterpret_cast<PFNGLUNIFORM4FPROC>
+            ( wglGetProcAddress( "glUniform4f" ) );
+
+    success = success && ( glUniform4f != 0 );
+
+    glUniformMatrix3fv =
+        reinterpret_cast<PFNGLUNIFORMMATRIX3FVPROC>
+            ( wglGetProcAddress( "glUniformMatrix3fv" ) );
+
+    success = success && ( glUniformMatrix3fv != 0 );
+
+    glGenBuffers =
+        reinterpret_cast<PFNGLGENBUFFERSPROC>
+            ( wglGetProcAddress( "glGenBuffers" ) );
+
+    success = success && ( glGenBuffers != 0 );
+
+    glBindBuffer =
+        reinterpret_cast<PFNGLBINDBUFFERPROC>
+            ( wglGetProcAddress( "glBindBuffer" ) );
+
+    success = success && ( glBindBuffer != 0 );
+
+    glBufferData =
+        reinterpret_cast<PFNGLBUFFERDATAPROC>
+            ( wglGetProcAddress( "glBufferData" ) );
+
+    success = success && ( glBufferData != 0 );
+
+    glDeleteBuffers =
+        reinterpret_cast<PFNGLDELETEBUFFERSPROC>
+            ( wglGetProcAddress( "glDeleteBuffers" ) );
+
+    success = success && ( glDeleteBuffers != 0 );
+
+    glGenVertexArrays =
+        reinterpret_cast<PFNGLGENVERTEXARRAYSPROC>
+            ( wglGetProcAddress( "glGenVertexArrays" ) );
+
+    success = success && ( glGenVertexArrays != 0 );
+
+    glBindVertexArray =
+        reinterpret_cast<PFNGLBINDVERTEXARRAYPROC>
+            ( wglGetProcAddress( "glBindVertexArray" ) );
+
+    success = success && ( glBindVertexArray != 0 );
+
+    glDeleteVertexArrays =
+        reinterpret_cast<PFNGLDELETEVERTEXARRAYSPROC>
+            ( wglGetProcAddress( "glDeleteVertexArrays" ) );
+
+    success = success && ( glDeleteVertexArrays != 0 );
+
+    glVertexAttribPointer =
+        reinterpret_cast<PFNGLVERTEXATTRIBPOINTERPROC>
+            ( wglGetProcAddress( "glVertexAttribPointer" ) );
+
+    success = success && ( glVertexAttribPointer != 0 );
+
+    glEnableVertexAttribArray =
+        reinterpret_cast<PFNGLENABLEVERTEXATTRIBARRAYPROC>
+            ( wglGetProcAddress( "glEnableVertexAttribArray" ) );
+
+    success = success && ( glEnableVertexAttribArray != 0 );
+
+    return success;
+}//loadShaders
+
+//-----------------------------------------------------------------------------
+
+bool Extensions::loadTimerQueries()
+{
+    glGenQueries =
+        reinterpret_cast<PFNGLGENQUERIESPROC>
+            ( wglGetProcAddress( "glGenQueries" ) );
+
+    bool success = ( glGenQueries != 0 );
+
+    glDeleteQueries =
+        reinterpret_cast<PFNGLDELETEQUERIESPROC>
+            ( wglGetProcAddress( "glDeleteQueries" ) );
+
+    success = success && ( glDeleteQueries != 0 );
+
+    glQueryCounter =
+        reinterpret_cast<PFNGLQUERYCOUNTERPROC>
+            ( wglGetProcAddress( "glQueryCounter" ) );
+
+    success = success && ( glQueryCounter != 0 );
+
+    glGetQueryObjectiv =
+        reinterpret_cast<PFNGLGETQUERYOBJECTIVPROC>
+            ( wglGetProcAddress( "glGetQueryObjectiv" ) );
+
+    success = success && ( glGetQueryObjectiv != 0 );
+
+    glGetQueryObjectui64v =
+        reinterpret_cast<PFNGLGETQUERYOBJECTUI64VPROC>
+            ( wglGetProcAddress( "glGetQueryObjectui64v" ) );
+
+    success = success && ( glGetQueryObjectui64v != 0 );
+
+    return success;
+}//loadTimerQueries
+
+//-----------------------------------------------------------------------------
+
+bool Extensions::loadSync()
+{
+    glFenceSync =
+        reinterpret_cast<PFNGLFENCESYNCPROC>
+            ( wglGetProcAddress( "glFenceSync" ) );
+
+    bool success = ( glFenceSync != 0 );
+
+    glWaitSync =
+        reinterpret_cast<PFNGLWAITSYNCPROC>
+            ( wglGetProcAddress( "glWaitSync" ) );
+
+    success = success && ( glWaitSync != 0 );
+
+    glClientWaitSync =
+        reinterpret_cast<PFNGLCLIENTWAITSYNCPROC>
+            ( wglGetProcAddress( "glClientWaitSync" ) );
+
+    success = success && ( glClientWaitSync != 0 );
+
+    glDeleteSync =
+        reinterpret_cast<PFNGLDELETESYNCPROC>
+            ( wglGetProcAddress( "glDeleteSync" ) );
+
+    success = success && ( glDeleteSync != 0 );
+
+    return success;
+}//loadSync
+
+//-----------------------------------------------------------------------------
+
+bool Extensions::loadBufferStorage()
+{
+    glBufferStorage =
+        reinterpret_cast<PFNGLBUFFERSTORAGEPROC>
+            ( wglGetProcAddress( "glBufferStorage" ) );
+
+    bool success = ( glBufferStorage != 0 );
+
+    glMapBufferRange =
+        reinterpret_cast<PFNGLMAPBUFFERRANGEPROC>
+            ( wglGetProcAddress( "glMapBufferRange" ) );
+
+    success = success && ( glMapBufferRange != 0 );
+
+    glUnmapBuffer =
+        reinterpret_cast<PFNGLUNMAPBUFFERPROC>
+            ( wglGetProcAddress( "glUnmapBuffer" ) );
+
+    success = success && ( glUnmapBuffer != 0 );
+
+    return success;
+}//loadBufferStorage
+
+//-----------------------------------------------------------------------------
+
+bool Extensions::loadMultiGpu()
+{
+    wglCopyImageSubDataNV =
+        reinterpret_cast<PFNWGLCOPYIMAGESUBDATANVPROC>
+            ( wglGetProcAddress( "wglCopyImageSubDataNV" ) );
+
+    bool success = ( wglCopyImageSubDataNV != 0 );
+
+    wglEnumGpusNV =
+        reinterpret_cast<PFNWGLENUMGPUSNVPROC>
+            ( wglGetProcAddress( "wglEnumGpusNV" ) );
+
+    success = success && ( wglEnumGpusNV != 0 );
+
+    wglCreateAffinityDCNV =
+        reinterpret_cast<PFNWGLCREATEAFFINITYDCNVPROC>
+            ( wglGetProcAddress( "wglCreateAffinityDCNV" ) );
+
+    success = success && ( wglCreateAffinityDCNV != 0 );
+
+    wglDeleteDCNV =
+        reinterpret_cast<PFNWGLDELETEDCNVPROC>
+            ( wglGetProcAddress( "wglDeleteDCNV" ) );
+
+    success = success && ( wglDeleteDCNV != 0 );
+
+    return success;
+}//loadMultiGpu
+
+//-----------------------------------------------------------------------------
+
+bool Extensions::loadDebug()
+{
+    glDebugMessageCallback =
+        reinterpret_cast<PFNGLDEBUGMESSAGECALLBACKPROC>
+            ( wglGetProcAddress( "glDebugMessageCallback" ) );
+
+    bool success = ( glDebugMessageCallback != 0 );
+
+    glDebugMessageControl =
+        reinterpret_cast<PFNGLDEBUGMESSAGECONTROLPROC>
+            ( wglGetProcAddress( "glDebugMessageControl" ) );
+
+    success = success && ( glDebugMessageControl != 0 );
+
+    return success;
+}//loadDebug
+
+//-----------------------------------------------------------------------------
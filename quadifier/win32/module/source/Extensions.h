@@ -1,41 +1,135 @@
-#ifndef hive_Extensions_h
-#define hive_Extensions_h
-
-//-----------------------------------------------------------------------------
-
-#include <windows.h>
-#include <GL/gl.h>
-#include <GL/glext.h>
-#include <GL/wglext.h>
-
-//-----------------------------------------------------------------------------
-
-struct Extensions {
-    PFNWGLDXSETRESOURCESHAREHANDLENVPROC    wglDXSetResourceShareHandleNV;
-    PFNWGLDXOPENDEVICENVPROC                wglDXOpenDeviceNV;
-    PFNWGLDXCLOSEDEVICENVPROC               wglDXCloseDeviceNV;
-    PFNWGLDXREGISTEROBJECTNVPROC            wglDXRegisterObjectNV;
-    PFNWGLDXUNREGISTEROBJECTNVPROC          wglDXUnregisterObjectNV;
-    PFNWGLDXOBJECTACCESSNVPROC              wglDXObjectAccessNV;
-    PFNWGLDXLOCKOBJECTSNVPROC               wglDXLockObjectsNV;
-    PFNWGLDXUNLOCKOBJECTSNVPROC             wglDXUnlockObjectsNV;
-    PFNGLGENFRAMEBUFFERSPROC                glGenFramebuffers;
-    PFNGLBINDFRAMEBUFFERPROC                glBindFramebuffer;
-    PFNGLFRAMEBUFFERTEXTURE2DPROC           glFramebufferTexture2D;
-    PFNGLBINDRENDERBUFFERPROC               glBindRenderbuffer;
-    PFNGLGENRENDERBUFFERSPROC               glGenRenderbuffers;
-    PFNGLRENDERBUFFERSTORAGEPROC            glRenderbufferStorage;
-    PFNGLDELETERENDERBUFFERSPROC            glDeleteRenderbuffers;
-    PFNGLFRAMEBUFFERRENDERBUFFERPROC        glFramebufferRenderbuffer;
-    PFNGLBLITFRAMEBUFFERPROC                glBlitFramebuffer;
-    PFNGLCHECKFRAMEBUFFERSTATUSPROC         glCheckFramebufferStatus;
-    PFNGLGETRENDERBUFFERPARAMETERIVPROC     glGetRenderbufferParameteriv;
-
-    Extensions();
-
-    bool load();
-};
-
-//-----------------------------------------------------------------------------
-
-#endif//hive_Extensions_h
+#ifndef hive_Extensions_h
+#define hive_Extensions_h
+
+//-----------------------------------------------------------------------------
+
+#include <windows.h>
+#include <GL/gl.h>
+#include <GL/glext.h>
+#include <GL/wglext.h>
+
+//-----------------------------------------------------------------------------
+
+struct Extensions {
+    PFNWGLDXSETRESOURCESHAREHANDLENVPROC    wglDXSetResourceShareHandleNV;
+    PFNWGLDXOPENDEVICENVPROC                wglDXOpenDeviceNV;
+    PFNWGLDXCLOSEDEVICENVPROC               wglDXCloseDeviceNV;
+    PFNWGLDXREGISTEROBJECTNVPROC            wglDXRegisterObjectNV;
+    PFNWGLDXUNREGISTEROBJECTNVPROC          wglDXUnregisterObjectNV;
+    PFNWGLDXOBJECTACCESSNVPROC              wglDXObjectAccessNV;
+    PFNWGLDXLOCKOBJECTSNVPROC               wglDXLockObjectsNV;
+    PFNWGLDXUNLOCKOBJECTSNVPROC             wglDXUnlockObjectsNV;
+    PFNGLGENFRAMEBUFFERSPROC                glGenFramebuffers;
+    PFNGLBINDFRAMEBUFFERPROC                glBindFramebuffer;
+    PFNGLDELETEFRAMEBUFFERSPROC             glDeleteFramebuffers;
+    PFNGLFRAMEBUFFERTEXTURE2DPROC           glFramebufferTexture2D;
+    PFNGLBINDRENDERBUFFERPROC               glBindRenderbuffer;
+    PFNGLGENRENDERBUFFERSPROC               glGenRenderbuffers;
+    PFNGLRENDERBUFFERSTORAGEPROC            glRenderbufferStorage;
+    PFNGLDELETERENDERBUFFERSPROC            glDeleteRenderbuffers;
+    PFNGLFRAMEBUFFERRENDERBUFFERPROC        glFramebufferRenderbuffer;
+    PFNGLBLITFRAMEBUFFERPROC                glBlitFramebuffer;
+    PFNGLCHECKFRAMEBUFFERSTATUSPROC         glCheckFramebufferStatus;
+    PFNGLGETRENDERBUFFERPARAMETERIVPROC     glGetRenderbufferParameteriv;
+
+    // swap group functions (optional: loaded by load, but 0 if unsupported)
+    PFNWGLJOINSWAPGROUPNVPROC               wglJoinSwapGroupNV;
+    PFNWGLBINDSWAPBARRIERNVPROC             wglBindSwapBarrierNV;
+    PFNWGLQUERYSWAPGROUPNVPROC              wglQuerySwapGroupNV;
+    PFNWGLQUERYMAXSWAPGROUPSNVPROC          wglQueryMaxSwapGroupsNV;
+    PFNWGLQUERYFRAMECOUNTNVPROC             wglQueryFrameCountNV;
+
+    // shader and vertex array functions (loaded by loadShaders)
+    PFNGLACTIVETEXTUREPROC                  glActiveTexture;
+    PFNGLCREATESHADERPROC                   glCreateShader;
+    PFNGLSHADERSOURCEPROC                   glShaderSource;
+    PFNGLCOMPILESHADERPROC                  glCompileShader;
+    PFNGLGETSHADERIVPROC                    glGetShaderiv;
+    PFNGLGETSHADERINFOLOGPROC               glGetShaderInfoLog;
+    PFNGLDELETESHADERPROC                   glDeleteShader;
+    PFNGLCREATEPROGRAMPROC                  glCreateProgram;
+    PFNGLATTACHSHADERPROC                   glAttachShader;
+    PFNGLBINDATTRIBLOCATIONPROC             glBindAttribLocation;
+    PFNGLLINKPROGRAMPROC                    glLinkProgram;
+    PFNGLGETPROGRAMIVPROC                   glGetProgramiv;
+    PFNGLGETPROGRAMINFOLOGPROC              glGetProgramInfoLog;
+    PFNGLDELETEPROGRAMPROC                  glDeleteProgram;
+    PFNGLUSEPROGRAMPROC                     glUseProgram;
+    PFNGLGETUNIFORMLOCATIONPROC             glGetUniformLocation;
+    PFNGLUNIFORM1IPROC                      glUniform1i;
+    PFNGLUNIFORM1FPROC                      glUniform1f;
+    PFNGLUNIFORM2FPROC                      glUniform2f;
+    PFNGLUNIFORM3FPROC                      glUniform3f;
+    PFNGLUNIFORM4FPROC                      glUniform4f;
+    PFNGLUNIFORMMATRIX3FVPROC               glUniformMatrix3fv;
+    PFNGLGENBUFFERSPROC                     glGenBuffers;
+    PFNGLBINDBUFFERPROC                     glBindBuffer;
+    PFNGLBUFFERDATAPROC                     glBufferData;
+    PFNGLDELETEBUFFERSPROC                  glDeleteBuffers;
+    PFNGLGENVERTEXARRAYSPROC                glGenVertexArrays;
+    PFNGLBINDVERTEXARRAYPROC                glBindVertexArray;
+    PFNGLDELETEVERTEXARRAYSPROC             glDeleteVertexArrays;
+    PFNGLVERTEXATTRIBPOINTERPROC            glVertexAttribPointer;
+    PFNGLENABLEVERTEXATTRIBARRAYPROC        glEnableVertexAttribArray;
+
+    // timer query functions (loaded by loadTimerQueries)
+    PFNGLGENQUERIESPROC                     glGenQueries;
+    PFNGLDELETEQUERIESPROC                  glDeleteQueries;
+    PFNGLQUERYCOUNTERPROC                   glQueryCounter;
+    PFNGLGETQUERYOBJECTIVPROC               glGetQueryObjectiv;
+    PFNGLGETQUERYOBJECTUI64VPROC            glGetQueryObjectui64v;
+
+    // sync object functions (loaded by loadSync)
+    PFNGLFENCESYNCPROC                      glFenceSync;
+    PFNGLWAITSYNCPROC                       glWaitSync;
+    PFNGLCLIENTWAITSYNCPROC                 glClientWaitSync;
+    PFNGLDELETESYNCPROC                     glDeleteSync;
+
+    // persistent buffer functions (loaded by loadBufferStorage)
+    PFNGLBUFFERSTORAGEPROC                  glBufferStorage;
+    PFNGLMAPBUFFERRANGEPROC                 glMapBufferRange;
+    PFNGLUNMAPBUFFERPROC                    glUnmapBuffer;
+
+    // multi-GPU functions (loaded by loadMultiGpu)
+    PFNWGLCOPYIMAGESUBDATANVPROC            wglCopyImageSubDataNV;
+    PFNWGLENUMGPUSNVPROC                    wglEnumGpusNV;
+    PFNWGLCREATEAFFINITYDCNVPROC            wglCreateAffinityDCNV;
+    PFNWGLDELETEDCNVPROC                    wglDeleteDCNV;
+
+    // debug output functions (loaded by loadDebug)
+    PFNGLDEBUGMESSAGECALLBACKPROC           glDebugMessageCallback;
+    PFNGLDEBUGMESSAGECONTROLPROC            glDebugMessageControl;
+
+    Extensions();
+
+    bool load();
+
+    /// Returns true if the swap group functions were loaded
+    bool hasSwapGroup() const;
+
+    /// Returns true if the framebuffer functions were loaded (which are
+    /// all that load provides without the DX interop)
+    bool hasFramebuffers() const;
+
+    /// Load the shader and vertex array functions
+    bool loadShaders();
+
+    /// Load the timer query functions
+    bool loadTimerQueries();
+
+    /// Load the sync object functions
+    bool loadSync();
+
+    /// Load the persistently mapped buffer functions
+    bool loadBufferStorage();
+
+    /// Load the WGL_NV_copy_image and WGL_NV_gpu_affinity functions
+    bool loadMultiGpu();
+
+    /// Load the KHR_debug functions
+    bool loadDebug();
+};
+
+//-----------------------------------------------------------------------------
+
+#endif//hive_Extensions_h
@@ -0,0 +1,67 @@
+#include "FrameMailbox.h"
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+FrameMailbox::FrameMailbox() :
+    m_state( 1 )
+{
+}
+
+//-----------------------------------------------------------------------------
+
+unsigned FrameMailbox::publish( unsigned slot )
+{
+    // place our slot in the mailbox (flagged as fresh), and take whichever
+    // slot was waiting there - if the reader never acquired it, that frame
+    // is simply overwritten next time (latest frame wins)
+    unsigned previous = m_state.exchange( (slot & MASK) | FRESH );
+    return previous & MASK;
+}
+
+//-----------------------------------------------------------------------------
+
+bool FrameMailbox::acquire( unsigned & slot )
+{
+    // nothing new has been published since we last looked
+    if ( !isFresh() ) return false;
+
+    // swap our slot (which we have finished with) for the waiting frame;
+    // only the reader clears the fresh flag, so the slot we receive must
+    // hold a published frame (possibly a newer one than we checked for)
+    unsigned previous = m_state.exchange( slot & MASK );
+    slot = previous & MASK;
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+bool FrameMailbox::isFresh() const
+{
+    return ( m_state.load() & FRESH ) != 0;
+}
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,81 @@
+#ifndef hive_FrameMailbox_h
+#define hive_FrameMailbox_h
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+#include <atomic>
+
+//-----------------------------------------------------------------------------
+
+/**
+ * A latest-wins mailbox used to pass completed frames from the Direct3D
+ * thread to the OpenGL thread without either side blocking.
+ *
+ * The mailbox manages three slot indices (0, 1 or 2): one owned by the
+ * writer, one owned by the reader, and one waiting in the mailbox. When the
+ * writer publishes a slot it swaps it with the waiting slot, overwriting any
+ * frame the reader has not yet picked up. When the reader acquires, it swaps
+ * its slot with the waiting slot, but only if a fresh frame is waiting.
+ */
+class FrameMailbox {
+public:
+    /// Number of slots managed by the mailbox
+    static const unsigned SLOTS = 3;
+
+    /// Constructor
+    FrameMailbox();
+
+    /// Initial slot index owned by the writer
+    unsigned writeSlot() const { return 0; }
+
+    /// Initial slot index owned by the reader
+    unsigned readSlot() const { return 2; }
+
+    /// Publish the writer's completed slot, returning the slot that the
+    /// writer now owns and should fill next
+    unsigned publish( unsigned slot );
+
+    /// If a fresh frame has been published, swap it with the reader's slot
+    /// (passed in and returned via the parameter) and return true
+    bool acquire( unsigned & slot );
+
+    /// Returns true if a frame has been published but not yet acquired
+    bool isFresh() const;
+
+private:
+    /// Flag bit set in the state when the waiting slot holds a new frame
+    static const unsigned FRESH = 4;
+
+    /// Mask used to extract the waiting slot index from the state
+    static const unsigned MASK = 3;
+
+    std::atomic<unsigned> m_state;  ///< waiting slot index and fresh flag
+};
+
+//-----------------------------------------------------------------------------
+
+#endif//hive_FrameMailbox_h
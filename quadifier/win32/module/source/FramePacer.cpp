@@ -0,0 +1,206 @@
+#include "FramePacer.h"
+#include <dwmapi.h>
+#include "Clock.h"
+#include "Log.h"
+
+using namespace hive;
+using namespace std;
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+namespace {
+
+/// Flag to request a high resolution waitable timer (Windows 10 1803 and
+/// later: older systems fail the request, and we fall back to a normal one)
+const DWORD TIMER_HIGH_RESOLUTION = 0x00000002;
+
+/// Longest time we expect to sleep before a paint (a safety net in case the
+/// prediction is wildly wrong), in seconds
+const double MAX_WAIT = 0.1;
+
+/// Rate at which the timer slack estimate decays back towards zero
+const double SLACK_DECAY = 0.95;
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+
+FramePacer::FramePacer() :
+    m_timer( 0 ),
+    m_dwm( 0 ),
+    m_timingInfo( 0 ),
+    m_headroom( 0.0 ),
+    m_slack( 0.0 ),
+    m_late( -1.0 )
+{
+}
+
+//-----------------------------------------------------------------------------
+
+FramePacer::~FramePacer()
+{
+    destroy();
+}
+
+//-----------------------------------------------------------------------------
+
+bool FramePacer::create( double headroom )
+{
+    destroy();
+
+    // DWM is loaded at run time, so that we don't depend on dwmapi.dll
+    m_dwm = LoadLibraryW( L"dwmapi.dll" );
+    if ( m_dwm != 0 ) {
+        m_timingInfo = reinterpret_cast<TimingInfoProc>(
+            GetProcAddress( m_dwm, "DwmGetCompositionTimingInfo" )
+        );
+    }
+    if ( m_timingInfo == 0 ) {
+        Log::print( "warning: DWM composition timing is unavailable, frames will not be paced\n" );
+        destroy();
+        return false;
+    }
+
+    // a high resolution timer if we can get one (otherwise the timer may
+    // wake us up to a scheduler tick late, which the slack allows for)
+    m_timer = CreateWaitableTimerExW( NULL, NULL, TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS );
+    if ( m_timer == 0 )
+        m_timer = CreateWaitableTimerExW( NULL, NULL, 0, TIMER_ALL_ACCESS );
+    if ( m_timer == 0 ) {
+        Log::print( "warning: unable to create frame pacing timer\n" );
+        destroy();
+        return false;
+    }
+
+    m_headroom = headroom;
+    m_slack = 0.0;
+
+    if (Log::info())
+        Log::print( "frame pacing enabled, headroom = " ) << (1000.0 * headroom) << "ms\n";
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void FramePacer::destroy()
+{
+    if ( m_timer != 0 ) {
+        CloseHandle( m_timer );
+        m_timer = 0;
+    }
+    m_timingInfo = 0;
+    if ( m_dwm != 0 ) {
+        FreeLibrary( m_dwm );
+        m_dwm = 0;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+bool FramePacer::isEnabled() const
+{
+    return m_timer != 0;
+}
+
+//-----------------------------------------------------------------------------
+
+bool FramePacer::predictVBlank( double now, double & vblank ) const
+{
+    if ( m_timingInfo == 0 ) return false;
+
+    // note: hwnd must be NULL from Windows 8.1, and gives the timing of the
+    // whole desktop before that (which is what we want in any case)
+    DWM_TIMING_INFO info = {};
+    info.cbSize = sizeof(info);
+    if ( FAILED( m_timingInfo( NULL, &info ) ) ) return false;
+
+    const double period = Clock::interval( static_cast<long long>( info.qpcRefreshPeriod ) );
+    if ( period <= 0.0 ) return false;
+
+    // step forward from the last vblank DWM saw to the first one after now
+    vblank = Clock::seconds( static_cast<long long>( info.qpcVBlank ) );
+    if ( vblank <= now )
+        vblank += period * ( 1.0 + static_cast<double>(
+            static_cast<long long>( (now - vblank) / period )
+        ) );
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+bool FramePacer::wait( HANDLE event )
+{
+    m_late = -1.0;
+    if ( m_timer == 0 ) return true;
+
+    // when to start painting (as soon as possible if we can't tell)
+    const double now = Clock::seconds();
+    double vblank = 0.0;
+    if ( !predictVBlank( now, vblank ) ) return true;
+    const double paintTime = vblank - m_headroom;
+
+    // too late to wait (or too little time to be worth sleeping): paint now
+    double delay = paintTime - now - m_slack;
+    if ( delay <= 0.0 ) return true;
+    if ( delay > MAX_WAIT ) delay = MAX_WAIT;
+
+    // relative due time, in 100ns units
+    LARGE_INTEGER due = {};
+    due.QuadPart = -static_cast<LONGLONG>( delay * 1.0e7 );
+    if ( !SetWaitableTimer( m_timer, &due, 0, NULL, NULL, FALSE ) ) return true;
+
+    // sleep until the timer fires, a message arrives, or the event is set
+    HANDLE handles[2] = { m_timer, event };
+    const DWORD count = ( event != 0 ) ? 2 : 1;
+    const DWORD result = MsgWaitForMultipleObjects(
+        count, handles, FALSE, static_cast<DWORD>( 1000.0 * MAX_WAIT ) + 1, QS_ALLINPUT
+    );
+    if ( result != WAIT_OBJECT_0 ) {
+        // woken early: leave the remaining wait to the next call
+        CancelWaitableTimer( m_timer );
+        return false;
+    }
+
+    // learn how late the timer wakes us, so that we ask to be woken earlier
+    const double late = Clock::seconds() - (now + delay);
+    m_slack *= SLACK_DECAY;
+    if ( late > m_slack ) m_slack = late;
+    m_late = late;
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+double FramePacer::lastLate() const
+{
+    return m_late;
+}
+
+//-----------------------------------------------------------------------------
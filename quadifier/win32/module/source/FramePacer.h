@@ -0,0 +1,95 @@
+#ifndef hive_FramePacer_h
+#define hive_FramePacer_h
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+#include <windows.h>
+
+//-----------------------------------------------------------------------------
+
+/**
+ * Schedules GL paints a fixed headroom before the next vertical blank, so
+ * that each frame is presented as late as possible (with the freshest DX
+ * frame) while still making the flip, and at an even phase.
+ *
+ * The vblank is predicted from the DWM composition timing; when that is not
+ * available (e.g. composition is disabled) frames are painted as soon as
+ * they arrive, as before. Waits use a waitable timer together with
+ * MsgWaitForMultipleObjects, so the GL thread sleeps rather than spins, and
+ * still wakes for window messages and new frames.
+ */
+class FramePacer {
+public:
+    /// Constructor
+    FramePacer();
+
+    /// Destructor
+    virtual ~FramePacer();
+
+    /// Create the timer, with the headroom (in seconds) left before each
+    /// vblank for painting and swapping
+    bool create( double headroom );
+
+    /// Release the timer
+    void destroy();
+
+    /// Returns true if pacing is enabled
+    bool isEnabled() const;
+
+    /// Wait until it is time to paint, until a window message arrives, or
+    /// until the event is signalled: returns true when it is time to paint
+    bool wait( HANDLE event );
+
+    /// Returns how late the timer woke the last wait which slept until
+    /// paint time (seconds), or a negative value if the last wait did not
+    double lastLate() const;
+
+private:
+    /// Copy construction is not supported
+    FramePacer( const FramePacer & );
+
+    /// Assignment is not supported
+    FramePacer & operator = ( const FramePacer & );
+
+    /// Predict the time of the next vblank after the given time (seconds,
+    /// as Clock::seconds), returns false if it cannot be predicted
+    bool predictVBlank( double now, double & vblank ) const;
+
+    /// Signature of DwmGetCompositionTimingInfo (loaded at run time)
+    typedef HRESULT (WINAPI *TimingInfoProc)( HWND, void * );
+
+    HANDLE   m_timer;       ///< waitable timer used to sleep until paint time
+    HMODULE  m_dwm;         ///< dwmapi.dll (or 0)
+    TimingInfoProc m_timingInfo; ///< DwmGetCompositionTimingInfo (or 0)
+    double   m_headroom;    ///< time before the vblank to start painting
+    double   m_slack;       ///< estimate of how late the timer wakes us
+    double   m_late;        ///< how late the last wait woke (< 0 = did not sleep)
+};
+
+//-----------------------------------------------------------------------------
+
+#endif//hive_FramePacer_h
@@ -0,0 +1,256 @@
+#include "FramePublisher.h"
+#include "Log.h"
+#include "ResourceTracker.h"
+
+using namespace hive;
+using namespace std;
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+FramePublisher::FramePublisher() :
+    m_device( 0 ),
+    m_window( 0 ),
+    m_width( 0 ),
+    m_height( 0 ),
+    m_format( D3DFMT_UNKNOWN ),
+    m_writeSlot( SharedFrames::writeSlot() ),
+    m_pending( false ),
+    m_published( 0 ),
+    m_dropped( 0 )
+{
+    for (unsigned slot = 0; slot < SLOTS; ++slot) {
+        for (unsigned eye = 0; eye < EYES; ++eye) {
+            m_surface[slot][eye] = 0;
+            m_handle[slot][eye] = 0;
+        }
+        m_query[slot] = 0;
+    }
+    m_frame.frameId = 0;
+    m_frame.eyes = 0;
+    m_frame.presentTime = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+FramePublisher::~FramePublisher()
+{
+    destroy();
+}
+
+//-----------------------------------------------------------------------------
+
+bool FramePublisher::create( IDirect3DDevice9 *device )
+{
+    if ( isOpen() ) return true;
+    if ( device == 0 ) return false;
+
+    if ( !m_frames.create() ) {
+        Log::print( "error: failed to create the shared frames: " )
+            << GetLastError() << endl;
+        return false;
+    }
+
+    m_device = device;
+    if (Log::info())
+        Log::print( "publishing frames to the presenter (process " )
+            << GetCurrentProcessId() << ")\n";
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void FramePublisher::destroy()
+{
+    if ( isOpen() && Log::info() )
+        Log::print( "presenter frames published " ) << m_published
+            << ", dropped " << m_dropped << endl;
+    releasePool();
+    m_frames.close();
+    m_device = 0;
+    m_window = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+void FramePublisher::publish(
+    IDirect3DSurface9 * const *surface,
+    const RECT *region,
+    unsigned eyes,
+    unsigned width,
+    unsigned height,
+    unsigned frameId
+) {
+    if ( !isOpen() || (eyes == 0) || (surface[0] == 0) ) return;
+    if ( eyes > EYES ) eyes = EYES;
+
+    // the frame before must have left the write slot: the application's
+    // thread never waits for the GPU here, so if its copy is still running
+    // this frame is dropped (the one in flight is published soon after)
+    if ( !flush() ) {
+        ++m_dropped;
+        return;
+    }
+
+    // the pool holds whole eyes in the captured format (a frame captured
+    // at a lower resolution is scaled up as it is copied)
+    D3DSURFACE_DESC desc = {};
+    if ( surface[0]->GetDesc( &desc ) != D3D_OK ) return;
+    if ( !createPool( width, height, desc.Format ) ) return;
+
+    for (unsigned eye = 0; eye < eyes; ++eye) {
+        if ( m_device->StretchRect(
+                surface[eye], &region[eye],
+                m_surface[m_writeSlot][eye], NULL, D3DTEXF_LINEAR
+            ) != D3D_OK
+        ) {
+            Log::print( "error: failed to copy a frame for the presenter\n" );
+            return;
+        }
+    }
+
+    // fence the copies: the slot is published once they are done
+    LARGE_INTEGER now = {};
+    QueryPerformanceCounter( &now );
+    m_frame.frameId = frameId;
+    m_frame.eyes = eyes;
+    m_frame.presentTime = now.QuadPart;
+    m_query[m_writeSlot]->Issue( D3DISSUE_END );
+    m_pending = true;
+
+    // it often is already (e.g. if the application waited for the GPU)
+    flush();
+}
+
+//-----------------------------------------------------------------------------
+
+void FramePublisher::poll()
+{
+    if ( m_pending ) flush();
+}
+
+//-----------------------------------------------------------------------------
+
+bool FramePublisher::flush()
+{
+    if ( !m_pending ) return true;
+
+    // note: D3DGETDATA_FLUSH makes sure the query is on its way to the GPU
+    HRESULT result = m_query[m_writeSlot]->GetData( NULL, 0, D3DGETDATA_FLUSH );
+    if ( result == S_FALSE ) return false;
+
+    // (a lost device is not waited for: the frame is simply dropped)
+    m_pending = false;
+    if ( result != S_OK ) return true;
+
+    m_writeSlot = m_frames.publish( m_writeSlot, m_frame );
+    ++m_published;
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+bool FramePublisher::createPool( unsigned width, unsigned height, D3DFORMAT format )
+{
+    if ( (m_surface[0][0] != 0) &&
+         (width == m_width) && (height == m_height) && (format == m_format)
+    )
+        return true;
+
+    releasePool();
+
+    SharedFrames::Surfaces surfaces = {};
+    surfaces.window = m_window;
+    surfaces.width  = width;
+    surfaces.height = height;
+    surfaces.format = static_cast<unsigned>( format );
+
+    for (unsigned slot = 0; slot < SLOTS; ++slot) {
+        for (unsigned eye = 0; eye < EYES; ++eye) {
+            if ( m_device->CreateRenderTarget(
+                width,
+                height,
+                format,
+                D3DMULTISAMPLE_NONE,
+                0,
+                FALSE,
+                &m_surface[slot][eye],
+                &m_handle[slot][eye]
+            ) != D3D_OK ) {
+                Log::print( "error: failed to create a shared target for the presenter\n" );
+                releasePool();
+                return false;
+            }
+            ResourceTracker::track( m_surface[slot][eye], "quadifier" );
+            surfaces.handle[slot][eye] = m_handle[slot][eye];
+        }
+
+        if ( m_device->CreateQuery( D3DQUERYTYPE_EVENT, &m_query[slot] ) != D3D_OK ) {
+            Log::print( "error: failed to create an event query for the presenter\n" );
+            releasePool();
+            return false;
+        }
+    }
+
+    m_width  = width;
+    m_height = height;
+    m_format = format;
+
+    // the presenter opens the new pool, and the writer starts again
+    m_frames.setSurfaces( surfaces );
+    m_writeSlot = SharedFrames::writeSlot();
+
+    if (Log::info())
+        Log::print( "presenter targets " ) << width << 'x' << height
+            << " generation " << m_frames.generation() << endl;
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void FramePublisher::releasePool()
+{
+    // the presenter keeps its own references to the targets it has open
+    m_pending = false;
+    for (unsigned slot = 0; slot < SLOTS; ++slot) {
+        for (unsigned eye = 0; eye < EYES; ++eye) {
+            if ( m_surface[slot][eye] != 0 ) {
+                m_surface[slot][eye]->Release();
+                m_surface[slot][eye] = 0;
+            }
+            m_handle[slot][eye] = 0;
+        }
+        if ( m_query[slot] != 0 ) {
+            m_query[slot]->Release();
+            m_query[slot] = 0;
+        }
+    }
+    m_width  = 0;
+    m_height = 0;
+    m_format = D3DFMT_UNKNOWN;
+}
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,136 @@
+#ifndef hive_FramePublisher_h
+#define hive_FramePublisher_h
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+#include <windows.h>
+#include <d3d9.h>
+#include "SharedFrames.h"
+
+//-----------------------------------------------------------------------------
+
+/**
+ * Hands the captured frames of a Direct3D9Ex device over to the presenter
+ * process, instead of painting them on a GL thread of our own.
+ *
+ * Each frame is copied (with StretchRect, one eye at a time, scaled up to
+ * the full resolution if it was captured at less) into the write slot of a
+ * pool of shareable render targets, whose share handles are published
+ * through SharedFrames. The copy is then fenced with an event query: the
+ * slot is published once the query has completed, which is checked as the
+ * next frame is started, and waited for (at the latest) when the next frame
+ * is copied, so the presenter never opens a slot the GPU is still writing.
+ *
+ * The pool is created as the first frame is published, and created again
+ * whenever the size or format of the captured eyes changes.
+ */
+class FramePublisher {
+public:
+    /// Constructor
+    FramePublisher();
+
+    /// Destructor
+    ~FramePublisher();
+
+    /// Start publishing the frames of a device (which must be an
+    /// IDirect3DDevice9Ex)
+    bool create( IDirect3DDevice9 *device );
+
+    /// Set the window the application presents to (which the presenter
+    /// follows), before the first frame
+    void setWindow( HWND window ) { m_window = window; }
+
+    /// Release the pool and stop publishing
+    void destroy();
+
+    /// Returns true if frames are being published
+    bool isOpen() const { return m_frames.isOpen(); }
+
+    /// Copy the eyes of a frame (each a region of a surface) into the write
+    /// slot, as eyes of the given full size, after publishing the frame
+    /// before it (the frame is dropped, without waiting, if the copy of the
+    /// frame before has not completed yet)
+    void publish(
+        IDirect3DSurface9 * const *surface,
+        const RECT *region,
+        unsigned eyes,
+        unsigned width,
+        unsigned height,
+        unsigned frameId
+    );
+
+    /// Publish the frame copied last if the GPU has finished it (called as
+    /// the next frame starts, so the presenter gets it without waiting)
+    void poll();
+
+    /// Returns the number of frames published
+    unsigned publishedFrames() const { return m_published; }
+
+    /// Returns the number of frames dropped while a copy was in flight
+    unsigned droppedFrames() const { return m_dropped; }
+
+private:
+    /// Copy construction is not supported
+    FramePublisher( const FramePublisher & );
+
+    /// Assignment is not supported
+    FramePublisher & operator = ( const FramePublisher & );
+
+    /// Create the pool for eyes of the given size and format, and publish
+    /// its share handles
+    bool createPool( unsigned width, unsigned height, D3DFORMAT format );
+
+    /// Release the pool
+    void releasePool();
+
+    /// Publish the pending frame, if its copy has completed (never waits):
+    /// returns true if nothing is pending any more
+    bool flush();
+
+    /// Number of slots and eyes in the pool
+    static const unsigned SLOTS = hive::SharedFrames::SLOTS;
+    static const unsigned EYES  = hive::SharedFrames::EYES;
+
+    IDirect3DDevice9  *m_device;            ///< the application's device
+    HWND               m_window;            ///< window the application presents to
+    hive::SharedFrames m_frames;            ///< the frames shared with the presenter
+    IDirect3DSurface9 *m_surface[SLOTS][EYES]; ///< the pool of shared targets
+    HANDLE             m_handle[SLOTS][EYES];  ///< their share handles
+    IDirect3DQuery9   *m_query[SLOTS];      ///< copy fence of each slot
+    unsigned           m_width;             ///< width of each eye in the pool
+    unsigned           m_height;            ///< height of each eye in the pool
+    D3DFORMAT          m_format;            ///< format of the pool
+    unsigned           m_writeSlot;         ///< slot the next frame is copied into
+    bool               m_pending;           ///< is the write slot waiting for its fence?
+    hive::SharedFrames::Frame m_frame;      ///< the pending frame
+    unsigned           m_published;         ///< frames published
+    unsigned           m_dropped;           ///< frames dropped behind a copy
+};
+
+//-----------------------------------------------------------------------------
+
+#endif//hive_FramePublisher_h
@@ -0,0 +1,332 @@
+#include "FrameReadback.h"
+#include <process.h>
+#include "Log.h"
+
+using namespace hive;
+using namespace std;
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+namespace {
+
+/// Flags used both for the buffer storage and for its mapping
+const GLbitfield MAP_FLAGS =
+    GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+/// Longest time to wait for a read when stopping (nanoseconds)
+const GLuint64 READ_TIMEOUT = 100000000;
+
+/// Longest time to wait for the worker to write its last frames (ms)
+const DWORD THREAD_TIMEOUT = 10000;
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+
+FrameReadback::FrameReadback() :
+    m_glx( 0 ),
+    m_buffer( 0 ),
+    m_mapped( 0 ),
+    m_slotSize( 0 ),
+    m_slot( 0 ),
+    m_collect( 0 ),
+    m_dropped( 0 ),
+    m_thread( 0 ),
+    m_queued( 0 )
+{
+    m_quit.store( false );
+    m_failed.store( false );
+    m_written.store( 0 );
+    for (unsigned i=0; i<SLOTS; ++i) {
+        m_slots[i].state.store( STATE_FREE );
+        m_slots[i].fence = 0;
+        m_slots[i].header = Header();
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+FrameReadback::~FrameReadback()
+{
+    // note: GL resources must be freed by calling stop() while the
+    // context is still current
+}
+
+//-----------------------------------------------------------------------------
+
+bool FrameReadback::start( Extensions & glx )
+{
+    m_glx = &glx;
+
+    // the buffer is allocated by the first capture, when the size is known
+    if ( !glx.loadSync() || !glx.loadBufferStorage() ) {
+        Log::print( "warning: persistent buffers are not supported, readback disabled\n" );
+        return false;
+    }
+
+    m_queued = CreateEvent( 0, FALSE, FALSE, 0 );
+    m_quit.store( false );
+    m_failed.store( false );
+    m_thread = reinterpret_cast<HANDLE>( _beginthreadex(
+        0, 0, threadFunc, this, 0, 0
+    ) );
+    if ( (m_queued == 0) || (m_thread == 0) ) {
+        Log::print( "error: failed to start readback thread\n" );
+        stop();
+        return false;
+    }
+
+    // the writes must not compete with the GL thread
+    SetThreadPriority( m_thread, THREAD_PRIORITY_BELOW_NORMAL );
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void FrameReadback::stop()
+{
+    bool stopped = true;
+    if ( m_thread != 0 ) {
+        // hand over the reads still in flight, then let the worker write
+        // everything it has been given before it exits
+        collect( true );
+        m_quit.store( true );
+        SetEvent( m_queued );
+        stopped = ( WaitForSingleObject( m_thread, THREAD_TIMEOUT ) == WAIT_OBJECT_0 );
+        if ( !stopped )
+            Log::print( "warning: readback thread did not exit\n" );
+        CloseHandle( m_thread );
+        m_thread = 0;
+    }
+
+    if ( m_queued != 0 ) CloseHandle( m_queued );
+    m_queued = 0;
+
+    // a worker which is still writing may be reading the buffer
+    if ( stopped ) release();
+}
+
+//-----------------------------------------------------------------------------
+
+void FrameReadback::release()
+{
+    if ( m_glx == 0 ) return;
+    Extensions & glx = *m_glx;
+
+    for (unsigned i=0; i<SLOTS; ++i) {
+        Slot & slot = m_slots[i];
+        if ( slot.fence != 0 ) glx.glDeleteSync( slot.fence );
+        slot.fence = 0;
+        slot.state.store( STATE_FREE );
+    }
+
+    if ( m_buffer != 0 ) {
+        glx.glBindBuffer( GL_PIXEL_PACK_BUFFER, m_buffer );
+        if ( m_mapped != 0 ) glx.glUnmapBuffer( GL_PIXEL_PACK_BUFFER );
+        glx.glBindBuffer( GL_PIXEL_PACK_BUFFER, 0 );
+        glx.glDeleteBuffers( 1, &m_buffer );
+    }
+    m_buffer = 0;
+    m_mapped = 0;
+    m_slotSize = 0;
+    m_slot = 0;
+    m_collect = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+bool FrameReadback::allocate( size_t slotSize )
+{
+    Extensions & glx = *m_glx;
+
+    // every slot is free, so nothing is using the old buffer
+    release();
+
+    const GLsizeiptr size = static_cast<GLsizeiptr>( slotSize * SLOTS );
+    glx.glGenBuffers( 1, &m_buffer );
+    glx.glBindBuffer( GL_PIXEL_PACK_BUFFER, m_buffer );
+    glx.glBufferStorage( GL_PIXEL_PACK_BUFFER, size, 0, MAP_FLAGS );
+    m_mapped = static_cast<unsigned char*>(
+        glx.glMapBufferRange( GL_PIXEL_PACK_BUFFER, 0, size, MAP_FLAGS )
+    );
+    glx.glBindBuffer( GL_PIXEL_PACK_BUFFER, 0 );
+
+    if ( m_mapped == 0 ) {
+        Log::print( "warning: failed to map readback buffer\n" );
+        release();
+        return false;
+    }
+
+    m_slotSize = slotSize;
+    if (Log::info())
+        Log::print( "readback buffer: " ) << SLOTS << " slots of " << slotSize << " bytes\n";
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void FrameReadback::capture(
+    unsigned frameId,
+    double time,
+    const unsigned *drawBuffer,
+    unsigned eyes,
+    unsigned x,
+    unsigned y,
+    unsigned width,
+    unsigned height
+) {
+    if ( !isRunning() || (eyes == 0) || (width == 0) || (height == 0) ) return;
+    Extensions & glx = *m_glx;
+
+    // pass on the reads which have completed since the last frame
+    collect( false );
+
+    // never wait for a slot: if the GPU or the worker is behind, drop
+    Slot & slot = m_slots[m_slot];
+    if ( slot.state.load() != STATE_FREE ) {
+        ++m_dropped;
+        return;
+    }
+
+    // grow the buffer if the frame no longer fits a slot (which replaces
+    // the buffer, so must wait until no slot is in use)
+    const size_t eyeSize = static_cast<size_t>( width ) * height * 4;
+    if ( eyeSize * eyes > m_slotSize ) {
+        for (unsigned i=0; i<SLOTS; ++i) {
+            if ( m_slots[i].state.load() != STATE_FREE ) {
+                ++m_dropped;
+                return;
+            }
+        }
+        if ( !allocate( eyeSize * eyes ) ) {
+            Log::print( "error: readback stopped\n" );
+            stop();
+            return;
+        }
+    }
+
+    // start reading each eye into the slot (the reads are asynchronous,
+    // since a pack buffer is bound)
+    const size_t offset = m_slot * m_slotSize;
+    glx.glBindBuffer( GL_PIXEL_PACK_BUFFER, m_buffer );
+    for (unsigned eye=0; eye<eyes; ++eye) {
+        glReadBuffer( drawBuffer[eye] );
+        glReadPixels(
+            x, y, width, height, GL_BGRA, GL_UNSIGNED_BYTE,
+            reinterpret_cast<const void*>( offset + eye * eyeSize )
+        );
+    }
+    glx.glBindBuffer( GL_PIXEL_PACK_BUFFER, 0 );
+    glReadBuffer( GL_BACK );
+    slot.fence = glx.glFenceSync( GL_SYNC_GPU_COMMANDS_COMPLETE, 0 );
+
+    Header & header = slot.header;
+    header.magic[0] = 'Q';
+    header.magic[1] = 'R';
+    header.magic[2] = 'E';
+    header.magic[3] = 'C';
+    header.frameId = frameId;
+    header.eyes = eyes;
+    header.width = width;
+    header.height = height;
+    header.reserved = 0;
+    header.time = time;
+
+    slot.state.store( STATE_READING );
+    m_slot = (m_slot + 1) % SLOTS;
+}
+
+//-----------------------------------------------------------------------------
+
+void FrameReadback::collect( bool wait )
+{
+    if ( m_glx == 0 ) return;
+    Extensions & glx = *m_glx;
+
+    for (;;) {
+        Slot & slot = m_slots[m_collect];
+        if ( slot.state.load() != STATE_READING ) break;
+
+        // the swap flushes the fence, so there is no need to here, unless
+        // we are about to wait for it
+        const GLenum status = wait ?
+            glx.glClientWaitSync( slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, READ_TIMEOUT ) :
+            glx.glClientWaitSync( slot.fence, 0, 0 );
+        if ( !wait && (status == GL_TIMEOUT_EXPIRED) ) break;
+
+        glx.glDeleteSync( slot.fence );
+        slot.fence = 0;
+
+        // the buffer is coherent, so the worker sees the pixels as soon as
+        // the fence has signalled
+        slot.state.store( STATE_QUEUED );
+        SetEvent( m_queued );
+        m_collect = (m_collect + 1) % SLOTS;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+unsigned __stdcall FrameReadback::threadFunc( void *context )
+{
+    FrameReadback *self = reinterpret_cast<FrameReadback*>( context );
+    if ( self != 0 ) self->run();
+
+    _endthreadex( 0 );
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+
+void FrameReadback::run()
+{
+    // slots are handed over in ring order, so we take them in the same order
+    unsigned next = 0;
+    for (;;) {
+        Slot & slot = m_slots[next];
+        if ( slot.state.load() == STATE_QUEUED ) {
+            // after a failure, frames are only freed
+            if ( !m_failed.load() ) {
+                if ( write( slot.header, m_mapped + next * m_slotSize ) )
+                    m_written.fetch_add( 1 );
+                else
+                    m_failed.store( true );
+            }
+            slot.state.store( STATE_FREE );
+            next = (next + 1) % SLOTS;
+            continue;
+        }
+
+        // exit only once everything handed over has been written
+        if ( m_quit.load() ) break;
+        WaitForSingleObject( m_queued, INFINITE );
+    }
+
+    finish();
+}
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,175 @@
+#ifndef hive_FrameReadback_h
+#define hive_FrameReadback_h
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+#include <windows.h>
+#include <GL/gl.h>
+#include <GL/glext.h>
+#include <array>
+#include <atomic>
+#include "Extensions.h"
+
+//-----------------------------------------------------------------------------
+
+/**
+ * Reads the painted eyes of each frame back into system memory without
+ * stalling the GL thread, and passes them to a worker thread. Each capture
+ * reads a rectangle of the back buffers into a slot of a persistently
+ * mapped pixel pack buffer, and fences the reads; once a later paint finds
+ * the fence signalled, the slot is handed to the worker, which writes it
+ * out (to a file, or a socket) and then frees it. A frame which finds its
+ * slot still busy (the GPU or the worker is behind) is dropped rather than
+ * waited for.
+ *
+ * Every frame is written as a Header followed by its eyes, as 32-bit BGRA
+ * pixels with the bottom row first. Requires ARB_buffer_storage and
+ * ARB_sync.
+ */
+class FrameReadback {
+public:
+    /// Number of slots in the ring (two frames being read, two being written)
+    static const unsigned SLOTS = 4;
+
+    /// Header written before each frame
+    struct Header {
+        char     magic[4];      ///< "QREC"
+        unsigned frameId;       ///< frame identifier
+        unsigned eyes;          ///< number of eyes which follow
+        unsigned width;         ///< width of each eye in pixels
+        unsigned height;        ///< height of each eye in pixels
+        unsigned reserved;      ///< zero
+        double   time;          ///< time the frame was painted (seconds)
+    };
+
+    /// Constructor
+    FrameReadback();
+
+    /// Destructor
+    virtual ~FrameReadback();
+
+    /// Returns true if the worker is running
+    bool isRunning() const { return m_thread != 0; }
+
+    /// Returns true if the worker has failed to write a frame (it discards
+    /// the rest until it is stopped)
+    bool isFailed() const { return m_failed.load(); }
+
+    /// Start reading a rectangle of each eye of a frame from the draw
+    /// buffers of the default framebuffer, and hand over any earlier reads
+    /// which are done
+    void capture(
+        unsigned frameId,
+        double time,
+        const unsigned *drawBuffer,
+        unsigned eyes,
+        unsigned x,
+        unsigned y,
+        unsigned width,
+        unsigned height
+    );
+
+    /// Returns the number of frames written
+    unsigned writtenFrames() const { return m_written.load(); }
+
+    /// Returns the number of frames dropped because no slot was free
+    unsigned droppedFrames() const { return m_dropped; }
+
+protected:
+    /// Start the worker (a GL context must be current): returns false if
+    /// readback is not possible
+    bool start( Extensions & glx );
+
+    /// Stop the worker, after writing the frames already handed over, and
+    /// free the buffer (a GL context must be current)
+    void stop();
+
+    /// Write one frame (worker thread): returns false if the frame could
+    /// not be written, and nothing more should be
+    virtual bool write( const Header & header, const unsigned char *pixels ) = 0;
+
+    /// Called on the worker thread just before it exits
+    virtual void finish() {}
+
+private:
+    /// Copy construction is not supported
+    FrameReadback( const FrameReadback & );
+
+    /// Assignment is not supported
+    FrameReadback & operator = ( const FrameReadback & );
+
+    /// Slot states (a slot only changes hands through its state)
+    enum State {
+        STATE_FREE,             ///< owned by the GL thread, unused
+        STATE_READING,          ///< owned by the GL thread, read in progress
+        STATE_QUEUED            ///< owned by the worker, to be written
+    };
+
+    /// One frame in the ring
+    struct Slot {
+        std::atomic<unsigned> state;  ///< State of the slot
+        GLsync   fence;         ///< set when the reads are done (GL thread)
+        Header   header;        ///< header of the frame being read
+    };
+
+    /// (Re)allocate the buffer, for slots of at least the given size (all
+    /// slots must be free)
+    bool allocate( size_t slotSize );
+
+    /// Release the buffer
+    void release();
+
+    /// Hand the slots whose reads are done over to the worker, in order
+    /// (GL thread); returns when it reaches one which is not, unless wait
+    /// is true, in which case it waits for each read to finish
+    void collect( bool wait );
+
+    /// Worker thread function
+    static unsigned __stdcall threadFunc( void *context );
+
+    /// Body of the worker thread
+    void run();
+
+    Extensions    *m_glx;       ///< OpenGL extension functions
+    GLuint         m_buffer;    ///< the pixel pack buffer
+    unsigned char *m_mapped;    ///< persistent mapping of the buffer
+    size_t         m_slotSize;  ///< size of each slot in bytes
+    unsigned       m_slot;      ///< next slot to read into (GL thread)
+    unsigned       m_collect;   ///< next slot to hand over (GL thread)
+    std::array<Slot,SLOTS> m_slots; ///< the ring of frames
+    unsigned       m_dropped;   ///< frames dropped (GL thread)
+
+    HANDLE         m_thread;    ///< worker thread handle
+    HANDLE         m_queued;    ///< auto-reset event: a slot was handed over
+    std::atomic<bool> m_quit;   ///< tells the worker to exit when idle
+    std::atomic<bool> m_failed; ///< set by the worker when a write fails
+    std::atomic<unsigned> m_written; ///< frames written (worker)
+};
+
+//-----------------------------------------------------------------------------
+
+#endif//hive_FrameReadback_h
@@ -0,0 +1,165 @@
+#include "FrameRecorder.h"
+#include <iomanip>
+#include <sstream>
+#include "Log.h"
+
+using namespace hive;
+using namespace std;
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+namespace {
+
+/// Returns the directory to record into (creating it), or ""
+std::string recordDirectory()
+{
+    char folder[MAX_PATH] = {};
+    DWORD length = GetEnvironmentVariableA( "LOCALAPPDATA", folder, MAX_PATH );
+    if ( (length == 0) || (length >= MAX_PATH) ) return "";
+
+    std::string path( folder );
+    path += "\\Quadifier";
+    CreateDirectoryA( path.c_str(), 0 );
+    path += "\\record";
+    CreateDirectoryA( path.c_str(), 0 );
+    return path;
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+
+FrameRecorder::FrameRecorder() :
+    m_chunkFrames( 0 ),
+    m_chunk( 0 ),
+    m_fileFrames( 0 ),
+    m_file( INVALID_HANDLE_VALUE )
+{
+}
+
+//-----------------------------------------------------------------------------
+
+FrameRecorder::~FrameRecorder()
+{
+}
+
+//-----------------------------------------------------------------------------
+
+bool FrameRecorder::create( Extensions & glx, unsigned chunkFrames )
+{
+    const std::string directory = recordDirectory();
+    if ( directory.empty() ) {
+        Log::print( "warning: no directory to record into, recording disabled\n" );
+        return false;
+    }
+
+    // the chunk files of this session are named after the time it started
+    SYSTEMTIME now = {};
+    GetLocalTime( &now );
+    std::ostringstream session;
+    session << directory << "\\" << std::setfill('0')
+        << std::setw(4) << now.wYear << std::setw(2) << now.wMonth
+        << std::setw(2) << now.wDay << '-' << std::setw(2) << now.wHour
+        << std::setw(2) << now.wMinute << std::setw(2) << now.wSecond;
+    m_session = session.str();
+    m_chunkFrames = chunkFrames;
+    m_chunk = 0;
+    m_fileFrames = 0;
+
+    if ( !start( glx ) ) {
+        Log::print( "warning: recording disabled\n" );
+        return false;
+    }
+
+    if (Log::info())
+        Log::print( "recording to " ) << m_session << "-*.raw\n";
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void FrameRecorder::destroy()
+{
+    if ( !isRecording() ) return;
+    stop();
+
+    if (Log::info()) {
+        Log::print( "recorder: " ) << writtenFrames() << " frames written, "
+            << droppedFrames() << " dropped\n";
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+bool FrameRecorder::write( const Header & header, const unsigned char *pixels )
+{
+    // start a new chunk file when the current one is full
+    if ( (m_file != INVALID_HANDLE_VALUE) && (m_fileFrames >= m_chunkFrames) ) {
+        CloseHandle( m_file );
+        m_file = INVALID_HANDLE_VALUE;
+    }
+    if ( m_file == INVALID_HANDLE_VALUE ) {
+        std::ostringstream name;
+        name << m_session << '-' << std::setfill('0') << std::setw(4) << m_chunk << ".raw";
+        ++m_chunk;
+        m_fileFrames = 0;
+
+        m_file = CreateFileA(
+            name.str().c_str(), GENERIC_WRITE, 0, 0, CREATE_ALWAYS,
+            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, 0
+        );
+        if ( m_file == INVALID_HANDLE_VALUE ) {
+            Log::print( "warning: failed to create record file " ) << name.str()
+                << ", recording stopped\n";
+            return false;
+        }
+    }
+
+    const DWORD size = header.eyes * header.width * header.height * 4;
+    DWORD written = 0;
+    const bool success =
+        WriteFile( m_file, &header, sizeof(header), &written, 0 ) &&
+        WriteFile( m_file, pixels, size, &written, 0 ) && ( written == size );
+    if ( !success ) {
+        Log::print( "warning: failed to write frame " ) << header.frameId
+            << ", recording stopped\n";
+        return false;
+    }
+
+    ++m_fileFrames;
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void FrameRecorder::finish()
+{
+    if ( m_file != INVALID_HANDLE_VALUE ) CloseHandle( m_file );
+    m_file = INVALID_HANDLE_VALUE;
+}
+
+//-----------------------------------------------------------------------------
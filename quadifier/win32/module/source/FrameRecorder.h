@@ -0,0 +1,79 @@
+#ifndef hive_FrameRecorder_h
+#define hive_FrameRecorder_h
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+#include <windows.h>
+#include <string>
+#include "FrameReadback.h"
+
+//-----------------------------------------------------------------------------
+
+/**
+ * Records the painted eyes of each frame to disk, through a FrameReadback
+ * so that the GL thread never waits for the GPU or the disk.
+ *
+ * The files are raw chunks in the session's directory, each holding up to
+ * a given number of frames, one after another as FrameReadback writes them.
+ */
+class FrameRecorder : public FrameReadback {
+public:
+    /// Constructor
+    FrameRecorder();
+
+    /// Destructor
+    virtual ~FrameRecorder();
+
+    /// Start recording a new session into %LOCALAPPDATA%\Quadifier\record
+    /// (a GL context must be current): returns false if not possible
+    bool create( Extensions & glx, unsigned chunkFrames );
+
+    /// Stop recording, after writing the frames already handed over, and
+    /// free the buffer (a GL context must be current)
+    void destroy();
+
+    /// Returns true if recording
+    bool isRecording() const { return isRunning(); }
+
+protected:
+    /// Write one frame, starting a new chunk file when needed (worker)
+    virtual bool write( const Header & header, const unsigned char *pixels );
+
+    /// Close the current chunk file (worker)
+    virtual void finish();
+
+private:
+    std::string    m_session;   ///< path and name prefix of the chunk files
+    unsigned       m_chunkFrames; ///< frames per chunk file
+    unsigned       m_chunk;     ///< number of the current chunk (worker)
+    unsigned       m_fileFrames;///< frames in the current chunk (worker)
+    HANDLE         m_file;      ///< the current chunk file (worker)
+};
+
+//-----------------------------------------------------------------------------
+
+#endif//hive_FrameRecorder_h
@@ -0,0 +1,94 @@
+#include "FrameRing.h"
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+FrameRing::FrameRing() :
+    m_head( 0 ),
+    m_tail( 0 )
+{
+}
+
+//-----------------------------------------------------------------------------
+
+bool FrameRing::push( const FrameDescriptor & frame )
+{
+    // only the producer writes the head, so a relaxed load is sufficient
+    const unsigned head = m_head.load( std::memory_order_relaxed );
+
+    // is the ring full?
+    if ( head - m_tail.load( std::memory_order_acquire ) >= CAPACITY )
+        return false;
+
+    // store the frame, then release it to the consumer
+    m_frames[head & (CAPACITY-1)] = frame;
+    m_head.store( head + 1, std::memory_order_release );
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+bool FrameRing::peek( FrameDescriptor & frame ) const
+{
+    // only the consumer writes the tail, so a relaxed load is sufficient
+    const unsigned tail = m_tail.load( std::memory_order_relaxed );
+
+    // is the ring empty?
+    if ( m_head.load( std::memory_order_acquire ) == tail )
+        return false;
+
+    frame = m_frames[tail & (CAPACITY-1)];
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void FrameRing::pop()
+{
+    const unsigned tail = m_tail.load( std::memory_order_relaxed );
+
+    // release the slot back to the producer
+    if ( m_head.load( std::memory_order_acquire ) != tail )
+        m_tail.store( tail + 1, std::memory_order_release );
+}
+
+//-----------------------------------------------------------------------------
+
+bool FrameRing::empty() const
+{
+    return size() == 0;
+}
+
+//-----------------------------------------------------------------------------
+
+unsigned FrameRing::size() const
+{
+    // the counters are free-running, so unsigned subtraction handles wrap
+    return m_head.load( std::memory_order_acquire ) -
+           m_tail.load( std::memory_order_acquire );
+}
+
+//-----------------------------------------------------------------------------
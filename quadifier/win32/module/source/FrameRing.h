@@ -0,0 +1,113 @@
+#ifndef hive_FrameRing_h
+#define hive_FrameRing_h
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+#include <array>
+#include <atomic>
+
+//-----------------------------------------------------------------------------
+
+/// Describes a captured frame (2D, stereo pair, or several views) handed
+/// from the Direct3D thread to the OpenGL thread
+struct FrameDescriptor {
+    /// Most views captured in one frame
+    static const unsigned MAX_VIEWS = 16;
+
+    unsigned frameId;       ///< Direct3D frame sequence number
+    unsigned eyes;          ///< number of captured views (0 to MAX_VIEWS)
+    unsigned target[MAX_VIEWS];     ///< index of the render target for each view
+    unsigned drawBuffer[MAX_VIEWS]; ///< OpenGL draw buffer (GL_NONE: output windows only)
+    double   captureTime;   ///< time-stamp when capture of the frame began
+    double   presentTime;   ///< time-stamp when the frame was presented
+    bool     posed;         ///< is the tracker rotation valid?
+    float    rotation[4];   ///< tracker rotation when capture began (x,y,z,w)
+    bool     shared;        ///< do both views share one (double-wide) target?
+    float    scale;         ///< fraction of each view's width and height rendered
+
+    /// Default constructor (an empty frame)
+    FrameDescriptor() :
+        frameId(0),
+        eyes(0),
+        captureTime(0.0),
+        presentTime(0.0),
+        posed(false),
+        shared(false),
+        scale(1.f)
+    {
+        for (unsigned i=0; i<MAX_VIEWS; ++i) {
+            target[i] = 0;
+            drawBuffer[i] = 0;
+        }
+        rotation[0] = rotation[1] = rotation[2] = 0.f;
+        rotation[3] = 1.f;
+    }
+};
+
+//-----------------------------------------------------------------------------
+
+/**
+ * A lock-free single-producer/single-consumer ring of frame descriptors.
+ *
+ * The Direct3D thread is the only producer (push) and the OpenGL thread is
+ * the only consumer (peek/pop). The consumer peeks at the oldest frame, and
+ * only pops it once it has finished reading the frame's render targets, so
+ * the producer can tell how many frames are still in use.
+ */
+class FrameRing {
+public:
+    /// Maximum number of queued frames (must be a power of two)
+    static const unsigned CAPACITY = 16;
+
+    /// Constructor
+    FrameRing();
+
+    /// Add a frame to the ring (producer), returns false if the ring is full
+    bool push( const FrameDescriptor & frame );
+
+    /// Copy the oldest frame (consumer), returns false if the ring is empty
+    bool peek( FrameDescriptor & frame ) const;
+
+    /// Remove the oldest frame (consumer)
+    void pop();
+
+    /// Returns true if there are no queued frames
+    bool empty() const;
+
+    /// Returns the number of queued frames
+    unsigned size() const;
+
+private:
+    std::array<FrameDescriptor,CAPACITY> m_frames;  ///< storage for frames
+
+    std::atomic<unsigned> m_head;   ///< count of frames pushed
+    std::atomic<unsigned> m_tail;   ///< count of frames popped
+};
+
+//-----------------------------------------------------------------------------
+
+#endif//hive_FrameRing_h
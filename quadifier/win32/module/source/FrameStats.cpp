@@ -0,0 +1,116 @@
+#include "FrameStats.h"
+#include "Log.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+using namespace hive;
+using namespace std;
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+FrameStats::FrameStats(
+    const std::string & name,
+    const std::string & unit,
+    unsigned precision
+) :
+    m_name( name ),
+    m_unit( unit ),
+    m_precision( precision )
+{
+}
+
+//-----------------------------------------------------------------------------
+
+unsigned FrameStats::addChannel( const std::string & name )
+{
+    m_channels.push_back( Channel( name ) );
+    m_channels.back().samples.reserve( HISTORY );
+    return static_cast<unsigned>( m_channels.size() - 1 );
+}
+
+//-----------------------------------------------------------------------------
+
+void FrameStats::record( unsigned channel, double sample )
+{
+    if ( channel >= m_channels.size() ) return;
+
+    Channel & c = m_channels[channel];
+
+    // fill the ring, then overwrite the oldest sample
+    if ( c.samples.size() < HISTORY )
+        c.samples.push_back( sample );
+    else
+        c.samples[c.count % HISTORY] = sample;
+
+    ++c.count;
+}
+
+//-----------------------------------------------------------------------------
+
+unsigned FrameStats::count( unsigned channel ) const
+{
+    return ( channel < m_channels.size() ) ? m_channels[channel].count : 0;
+}
+
+//-----------------------------------------------------------------------------
+
+void FrameStats::report() const
+{
+    // format the whole report first, so that it appears as one log entry
+    stringstream text;
+    text << m_name << " (" << m_unit << ", last " << HISTORY << " frames):\n";
+
+    for (unsigned i = 0; i < m_channels.size(); ++i) {
+        const Channel & c = m_channels[i];
+        if ( c.samples.empty() ) continue;
+
+        // sort a copy of the samples to find the percentiles
+        vector<double> sorted( c.samples );
+        sort( sorted.begin(), sorted.end() );
+
+        struct {
+            // return the sample at the specified percentile
+            double at( const vector<double> & v, unsigned percent ) {
+                size_t index = ( (v.size() - 1) * percent + 50 ) / 100;
+                return v[index];
+            }
+        } local;
+
+        text << "  " << left << setw(10) << c.name << right
+             << fixed << setprecision( static_cast<int>( m_precision ) )
+             << " p50=" << setw(8) << local.at( sorted, 50 )
+             << " p90=" << setw(8) << local.at( sorted, 90 )
+             << " p99=" << setw(8) << local.at( sorted, 99 )
+             << " max=" << setw(8) << sorted.back()
+             << " n=" << c.count << '\n';
+    }
+
+    Log::print( text.str() );
+}
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,90 @@
+#ifndef hive_FrameStats_h
+#define hive_FrameStats_h
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+#include <string>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+
+/**
+ * Collects per-frame samples (timings in milliseconds, unless another unit
+ * is given) for a number of named channels, keeping the most recent samples
+ * of each channel in a ring, and reports them to the log as percentiles.
+ *
+ * FrameStats is not thread safe: each thread should use its own instance.
+ */
+class FrameStats {
+public:
+    /// Number of samples kept for each channel
+    static const unsigned HISTORY = 512;
+
+    /// Constructor: the name heads the report, followed by the unit of the
+    /// samples, which are reported with the given number of decimals
+    explicit FrameStats(
+        const std::string & name,
+        const std::string & unit = "ms",
+        unsigned precision = 3
+    );
+
+    /// Add a named channel, returns the channel index
+    unsigned addChannel( const std::string & name );
+
+    /// Record a sample for the specified channel
+    void record( unsigned channel, double sample );
+
+    /// Returns the total number of samples recorded for a channel
+    unsigned count( unsigned channel ) const;
+
+    /// Write the percentiles of all channels to the log
+    void report() const;
+
+private:
+    /// Stores the samples for one channel
+    struct Channel {
+        std::string         name;       ///< name displayed in the log
+        std::vector<double> samples;    ///< ring of recent samples
+        unsigned            count;      ///< total samples recorded
+
+        /// Constructor
+        explicit Channel( const std::string & name ) :
+            name( name ),
+            count( 0 )
+        {
+        }
+    };
+
+    std::string m_name;                 ///< name displayed in the log
+    std::string m_unit;                 ///< unit of the samples
+    unsigned    m_precision;            ///< decimals of the reported samples
+    std::vector<Channel> m_channels;    ///< all the channels
+};
+
+//-----------------------------------------------------------------------------
+
+#endif//hive_FrameStats_h
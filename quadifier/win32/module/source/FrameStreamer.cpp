@@ -0,0 +1,306 @@
+#include <winsock2.h>
+#include "FrameStreamer.h"
+#include <ws2tcpip.h>
+#include <algorithm>
+#include <cstring>
+#include "FrameReadback.h"
+#include "Log.h"
+
+using namespace hive;
+using namespace std;
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+namespace {
+
+/// Socket send buffer for each node (about one 1080p eye, so that the
+/// worker is rarely waiting on the network)
+const int SEND_BUFFER = 8 * 1024 * 1024;
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+
+/// A connected node: sends each frame read back for it down its socket
+struct FrameStreamer::Node : public FrameReadback {
+    SOCKET socket;              ///< connection to the node
+    float  viewport[4];         ///< part of each eye which the node shows
+
+    Node( SOCKET s, const float *part ) : socket( s ) {
+        for (unsigned i=0; i<4; ++i) viewport[i] = part[i];
+    }
+
+    virtual ~Node() {}
+
+    /// Start the readback (a GL context must be current)
+    bool create( Extensions & glx ) { return start( glx ); }
+
+    /// Stop sending, and close the connection (a GL context must be current)
+    void destroy() {
+        // a node which has stopped reading would hold up the worker in
+        // send, so fail any send still in progress instead
+        shutdown( socket, SD_BOTH );
+        stop();
+        closesocket( socket );
+        socket = INVALID_SOCKET;
+    }
+
+    /// Send all of the data, returns false if the connection has failed
+    bool send( const void *data, size_t size ) {
+        const char *bytes = static_cast<const char*>( data );
+        while ( size > 0 ) {
+            const int chunk = static_cast<int>( std::min<size_t>( size, 1 << 30 ) );
+            const int sent = ::send( socket, bytes, chunk, 0 );
+            if ( sent <= 0 ) return false;
+            bytes += sent;
+            size -= sent;
+        }
+        return true;
+    }
+
+protected:
+    virtual bool write( const Header & header, const unsigned char *pixels ) {
+        const size_t size =
+            static_cast<size_t>( header.eyes ) * header.width * header.height * 4;
+        return send( &header, sizeof(header) ) && send( pixels, size );
+    }
+};
+
+//-----------------------------------------------------------------------------
+
+FrameStreamer::FrameStreamer() :
+    m_glx( 0 ),
+    m_winsock( false ),
+    m_listener( INVALID_LISTENER )
+{
+}
+
+//-----------------------------------------------------------------------------
+
+FrameStreamer::~FrameStreamer()
+{
+    // note: destroy() must be called while the GL context is still current
+}
+
+//-----------------------------------------------------------------------------
+
+bool FrameStreamer::create( Extensions & glx, unsigned port )
+{
+    m_glx = &glx;
+
+    WSADATA data = {};
+    if ( WSAStartup( MAKEWORD(2,2), &data ) != 0 ) {
+        Log::print( "error: failed to start winsock, streaming disabled\n" );
+        return false;
+    }
+    m_winsock = true;
+
+    SOCKET listener = socket( AF_INET, SOCK_STREAM, IPPROTO_TCP );
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl( INADDR_ANY );
+    address.sin_port = htons( static_cast<u_short>( port ) );
+
+    // never block the GL thread in accept (nodes inherit this, until their
+    // request has arrived)
+    u_long nonBlocking = 1;
+    if ( (listener == INVALID_SOCKET) ||
+         (bind( listener, reinterpret_cast<sockaddr*>(&address), sizeof(address) ) != 0) ||
+         (listen( listener, SOMAXCONN ) != 0) ||
+         (ioctlsocket( listener, FIONBIO, &nonBlocking ) != 0)
+    ) {
+        Log::print( "error: failed to listen on port " ) << port
+            << ", streaming disabled\n";
+        if ( listener != INVALID_SOCKET ) closesocket( listener );
+        destroy();
+        return false;
+    }
+    m_listener = listener;
+
+    if (Log::info())
+        Log::print( "streaming to display nodes on port " ) << port << endl;
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void FrameStreamer::destroy()
+{
+    for (unsigned i=0; i<m_nodes.size(); ++i) {
+        m_nodes[i]->destroy();
+        if (Log::info()) {
+            Log::print( "display node: " ) << m_nodes[i]->writtenFrames()
+                << " frames sent, " << m_nodes[i]->droppedFrames() << " dropped\n";
+        }
+        delete m_nodes[i];
+    }
+    m_nodes.clear();
+
+    for (unsigned i=0; i<m_pending.size(); ++i)
+        closesocket( m_pending[i].socket );
+    m_pending.clear();
+
+    if ( m_listener != INVALID_LISTENER ) closesocket( m_listener );
+    m_listener = INVALID_LISTENER;
+
+    if ( m_winsock ) WSACleanup();
+    m_winsock = false;
+}
+
+//-----------------------------------------------------------------------------
+
+void FrameStreamer::accept()
+{
+    // new connections
+    for (;;) {
+        SOCKET socket = ::accept( m_listener, 0, 0 );
+        if ( socket == INVALID_SOCKET ) break;
+
+        if ( m_nodes.size() + m_pending.size() >= MAX_NODES ) {
+            Log::print( "warning: too many display nodes, connection refused\n" );
+            closesocket( socket );
+            continue;
+        }
+
+        Pending pending = {};
+        pending.socket = socket;
+        m_pending.push_back( pending );
+    }
+
+    // their requests
+    for (unsigned i=0; i<m_pending.size(); ) {
+        Pending & pending = m_pending[i];
+        char *request = reinterpret_cast<char*>( &pending.request );
+        const int received = recv(
+            pending.socket, request + pending.received,
+            static_cast<int>( sizeof(Request) - pending.received ), 0
+        );
+
+        bool done = false;
+        if ( received > 0 ) {
+            pending.received += received;
+            if ( pending.received == sizeof(Request) ) {
+                connect( pending );
+                done = true;
+            }
+        } else if ( (received == 0) || (WSAGetLastError() != WSAEWOULDBLOCK) ) {
+            // closed before sending its request
+            closesocket( pending.socket );
+            done = true;
+        }
+
+        if ( done )
+            m_pending.erase( m_pending.begin() + i );
+        else
+            ++i;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void FrameStreamer::connect( const Pending & pending )
+{
+    const Request & request = pending.request;
+    SOCKET socket = pending.socket;
+
+    const float *viewport = request.viewport;
+    if ( (memcmp( request.magic, "QREQ", 4 ) != 0) ||
+         !(viewport[0] >= 0.f) || !(viewport[1] >= 0.f) ||
+         !(viewport[2] > 0.f) || !(viewport[3] > 0.f) ||
+         (viewport[0] + viewport[2] > 1.f) || (viewport[1] + viewport[3] > 1.f)
+    ) {
+        Log::print( "warning: invalid request from display node, connection closed\n" );
+        closesocket( socket );
+        return;
+    }
+
+    // the worker sends with blocking calls, as soon as each frame is read
+    u_long nonBlocking = 0;
+    BOOL noDelay = TRUE;
+    ioctlsocket( socket, FIONBIO, &nonBlocking );
+    setsockopt( socket, IPPROTO_TCP, TCP_NODELAY,
+        reinterpret_cast<const char*>(&noDelay), sizeof(noDelay) );
+    setsockopt( socket, SOL_SOCKET, SO_SNDBUF,
+        reinterpret_cast<const char*>(&SEND_BUFFER), sizeof(SEND_BUFFER) );
+
+    Node *node = new Node( socket, viewport );
+    if ( !node->create( *m_glx ) ) {
+        Log::print( "error: failed to start streaming to display node\n" );
+        closesocket( socket );
+        delete node;
+        return;
+    }
+    m_nodes.push_back( node );
+
+    if (Log::info()) {
+        Log::print( "display node connected, showing " )
+            << viewport[0] << ',' << viewport[1] << ' '
+            << viewport[2] << 'x' << viewport[3] << endl;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void FrameStreamer::capture(
+    unsigned frameId,
+    double time,
+    const unsigned *drawBuffer,
+    unsigned eyes,
+    unsigned width,
+    unsigned height
+) {
+    if ( !isStreaming() ) return;
+    accept();
+
+    for (unsigned i=0; i<m_nodes.size(); ) {
+        Node *node = m_nodes[i];
+
+        // drop nodes which have disconnected
+        if ( node->isFailed() ) {
+            if (Log::info()) {
+                Log::print( "display node disconnected: " ) << node->writtenFrames()
+                    << " frames sent, " << node->droppedFrames() << " dropped\n";
+            }
+            node->destroy();
+            delete node;
+            m_nodes.erase( m_nodes.begin() + i );
+            continue;
+        }
+
+        // the node's part of each eye, in whole pixels
+        const unsigned x = static_cast<unsigned>( node->viewport[0] * width + 0.5f );
+        const unsigned y = static_cast<unsigned>( node->viewport[1] * height + 0.5f );
+        const unsigned w = std::min( width - x,
+            static_cast<unsigned>( node->viewport[2] * width + 0.5f ) );
+        const unsigned h = std::min( height - y,
+            static_cast<unsigned>( node->viewport[3] * height + 0.5f ) );
+        node->capture( frameId, time, drawBuffer, eyes, x, y, w, h );
+        ++i;
+    }
+}
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,119 @@
+#ifndef hive_FrameStreamer_h
+#define hive_FrameStreamer_h
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+#include <windows.h>
+#include <vector>
+#include "Extensions.h"
+
+//-----------------------------------------------------------------------------
+
+/**
+ * Streams the painted eyes of each frame over TCP to display nodes running
+ * the receiver, so that one render host can drive several walls.
+ *
+ * A node connects and sends a Request giving the part of each eye it
+ * shows; from then on, every painted frame is read back (through a
+ * FrameReadback of the node's own, so a slow node only drops its own
+ * frames) and sent to it as a FrameReadback::Header followed by the pixels
+ * of that part of each eye. Sockets are held as UINT_PTR, so that this
+ * header need not include winsock2.h (which must precede windows.h).
+ */
+class FrameStreamer {
+public:
+    /// The request a node sends when it connects
+    struct Request {
+        char  magic[4];         ///< "QREQ"
+        float viewport[4];      ///< part of each eye (x,y,w,h from bottom left, 0..1)
+    };
+
+    /// Largest number of nodes connected at once
+    static const unsigned MAX_NODES = 8;
+
+    /// Constructor
+    FrameStreamer();
+
+    /// Destructor
+    virtual ~FrameStreamer();
+
+    /// Start listening for nodes on the port (a GL context must be current)
+    bool create( Extensions & glx, unsigned port );
+
+    /// Disconnect the nodes and stop listening (a GL context must be current)
+    void destroy();
+
+    /// Returns true if listening for nodes
+    bool isStreaming() const { return m_listener != INVALID_LISTENER; }
+
+    /// Accept new nodes, and start reading back their part of each eye of
+    /// the frame (which is sent once the reads are done)
+    void capture(
+        unsigned frameId,
+        double time,
+        const unsigned *drawBuffer,
+        unsigned eyes,
+        unsigned width,
+        unsigned height
+    );
+
+private:
+    /// Copy construction is not supported
+    FrameStreamer( const FrameStreamer & );
+
+    /// Assignment is not supported
+    FrameStreamer & operator = ( const FrameStreamer & );
+
+    /// A connected node, and the readback which sends it frames
+    struct Node;
+
+    /// A connection whose request has not yet arrived in full
+    struct Pending {
+        UINT_PTR socket;        ///< the connection
+        Request  request;       ///< the request, as received so far
+        unsigned received;      ///< bytes of the request received
+    };
+
+    /// Value of m_listener when not listening (INVALID_SOCKET)
+    static const UINT_PTR INVALID_LISTENER = ~static_cast<UINT_PTR>(0);
+
+    /// Accept new connections and read their requests, without blocking
+    void accept();
+
+    /// Start streaming to a node which has sent its request
+    void connect( const Pending & pending );
+
+    Extensions           *m_glx;        ///< OpenGL extension functions
+    bool                  m_winsock;    ///< has winsock been started?
+    UINT_PTR              m_listener;   ///< the listening socket
+    std::vector<Pending>  m_pending;    ///< connections awaiting a request
+    std::vector<Node*>    m_nodes;      ///< nodes being streamed to
+};
+
+//-----------------------------------------------------------------------------
+
+#endif//hive_FrameStreamer_h
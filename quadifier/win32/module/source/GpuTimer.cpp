@@ -0,0 +1,239 @@
+#include "GpuTimer.h"
+#include "Log.h"
+#include <GL/glext.h>
+
+using namespace hive;
+using namespace std;
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+GpuTimerGL::GpuTimerGL() :
+    m_glx( 0 ),
+    m_frame( 0 ),
+    m_points( 0 )
+{
+    for (unsigned f = 0; f < FRAMES; ++f) {
+        m_queries[f].fill( 0 );
+        m_marked[f] = 0;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+bool GpuTimerGL::create( Extensions & glx )
+{
+    if ( !glx.loadTimerQueries() ) {
+        Log::print( "warning: GL timer queries are not supported\n" );
+        return false;
+    }
+
+    m_glx = &glx;
+
+    for (unsigned f = 0; f < FRAMES; ++f)
+        glx.glGenQueries( POINTS, &m_queries[f][0] );
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void GpuTimerGL::destroy()
+{
+    if ( m_glx == 0 ) return;
+
+    for (unsigned f = 0; f < FRAMES; ++f) {
+        m_glx->glDeleteQueries( POINTS, &m_queries[f][0] );
+        m_queries[f].fill( 0 );
+    }
+
+    m_glx = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+void GpuTimerGL::mark( unsigned point )
+{
+    if ( (m_glx == 0) || (point >= POINTS) ) return;
+
+    const unsigned f = m_frame % FRAMES;
+    m_glx->glQueryCounter( m_queries[f][point], GL_TIMESTAMP );
+
+    if ( point + 1 > m_points ) m_points = point + 1;
+}
+
+//-----------------------------------------------------------------------------
+
+bool GpuTimerGL::endFrame( double *elapsed )
+{
+    if ( m_glx == 0 ) return false;
+
+    // record how many points this frame used, and move on to the next frame
+    m_marked[m_frame % FRAMES] = m_points;
+    m_points = 0;
+    ++m_frame;
+
+    // the oldest frame in flight is the one we are about to overwrite
+    if ( m_frame < FRAMES ) return false;
+    const unsigned f = m_frame % FRAMES;
+    const unsigned points = m_marked[f];
+    if ( points == 0 ) return false;
+
+    // is the last time-stamp available? (if not, skip this frame's results
+    // rather than stalling the pipeline)
+    GLint available = 0;
+    m_glx->glGetQueryObjectiv(
+        m_queries[f][points-1], GL_QUERY_RESULT_AVAILABLE, &available
+    );
+    if ( available == 0 ) return false;
+
+    GLuint64 start = 0;
+    m_glx->glGetQueryObjectui64v( m_queries[f][0], GL_QUERY_RESULT, &start );
+
+    for (unsigned p = 0; p < POINTS; ++p) {
+        GLuint64 stamp = start;
+        if ( p < points )
+            m_glx->glGetQueryObjectui64v( m_queries[f][p], GL_QUERY_RESULT, &stamp );
+
+        // time-stamps are in nanoseconds
+        elapsed[p] = static_cast<double>( stamp - start ) * 1.0e-6;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+GpuTimerDX::GpuTimerDX() :
+    m_frame( 0 ),
+    m_begun( false )
+{
+    for (unsigned f = 0; f < FRAMES; ++f) {
+        Queries & q = m_queries[f];
+        q.disjoint = q.frequency = q.begin = q.end = 0;
+        q.issued = false;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+GpuTimerDX::~GpuTimerDX()
+{
+    destroy();
+}
+
+//-----------------------------------------------------------------------------
+
+bool GpuTimerDX::create( IDirect3DDevice9 *device )
+{
+    if ( device == 0 ) return false;
+
+    bool success = true;
+
+    for (unsigned f = 0; success && (f < FRAMES); ++f) {
+        Queries & q = m_queries[f];
+        success =
+            ( device->CreateQuery( D3DQUERYTYPE_TIMESTAMPDISJOINT, &q.disjoint ) == D3D_OK ) &&
+            ( device->CreateQuery( D3DQUERYTYPE_TIMESTAMPFREQ, &q.frequency ) == D3D_OK ) &&
+            ( device->CreateQuery( D3DQUERYTYPE_TIMESTAMP, &q.begin ) == D3D_OK ) &&
+            ( device->CreateQuery( D3DQUERYTYPE_TIMESTAMP, &q.end ) == D3D_OK );
+    }
+
+    if ( !success ) {
+        Log::print( "warning: DX time-stamp queries are not supported\n" );
+        destroy();
+    }
+
+    return success;
+}
+
+//-----------------------------------------------------------------------------
+
+void GpuTimerDX::destroy()
+{
+    for (unsigned f = 0; f < FRAMES; ++f) {
+        Queries & q = m_queries[f];
+        IDirect3DQuery9 **queries[] = { &q.disjoint, &q.frequency, &q.begin, &q.end };
+        for (unsigned i = 0; i < 4; ++i) {
+            if ( *queries[i] != 0 ) {
+                (*queries[i])->Release();
+                *queries[i] = 0;
+            }
+        }
+        q.issued = false;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void GpuTimerDX::begin()
+{
+    Queries & q = m_queries[m_frame % FRAMES];
+    if ( m_begun || (q.begin == 0) ) return;
+
+    q.disjoint->Issue( D3DISSUE_BEGIN );
+    q.begin->Issue( D3DISSUE_END );
+    m_begun = true;
+}
+
+//-----------------------------------------------------------------------------
+
+bool GpuTimerDX::end( double & elapsed )
+{
+    if ( !m_begun ) return false;
+    m_begun = false;
+
+    Queries & q = m_queries[m_frame % FRAMES];
+    q.end->Issue( D3DISSUE_END );
+    q.frequency->Issue( D3DISSUE_END );
+    q.disjoint->Issue( D3DISSUE_END );
+    q.issued = true;
+
+    // move on to the next frame, which is also the oldest frame in flight
+    ++m_frame;
+    Queries & oldest = m_queries[m_frame % FRAMES];
+    if ( !oldest.issued ) return false;
+
+    // poll the results without flushing (S_FALSE means not ready yet)
+    BOOL disjoint = TRUE;
+    UINT64 frequency = 0, begin = 0, end = 0;
+    if ( (oldest.disjoint->GetData( &disjoint, sizeof(disjoint), 0 ) != S_OK) ||
+         (oldest.frequency->GetData( &frequency, sizeof(frequency), 0 ) != S_OK) ||
+         (oldest.begin->GetData( &begin, sizeof(begin), 0 ) != S_OK) ||
+         (oldest.end->GetData( &end, sizeof(end), 0 ) != S_OK) )
+        return false;
+
+    oldest.issued = false;
+
+    // discard results if the time-stamp counter was unreliable
+    if ( disjoint || (frequency == 0) || (end < begin) ) return false;
+
+    elapsed = 1000.0 * static_cast<double>( end - begin ) /
+                       static_cast<double>( frequency );
+    return true;
+}
+
+//-----------------------------------------------------------------------------
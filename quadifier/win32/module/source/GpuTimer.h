@@ -0,0 +1,129 @@
+#ifndef hive_GpuTimer_h
+#define hive_GpuTimer_h
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+#include <windows.h>
+#include <d3d9.h>
+#include <GL/gl.h>
+#include <array>
+#include "Extensions.h"
+
+//-----------------------------------------------------------------------------
+
+/**
+ * Measures GPU time between a number of points in an OpenGL frame, using
+ * GL_TIMESTAMP queries. Queries are kept for several frames, and results are
+ * only read once they are available, so the CPU never waits for the GPU.
+ */
+class GpuTimerGL {
+public:
+    /// Number of frames of queries in flight
+    static const unsigned FRAMES = 4;
+
+    /// Maximum number of time-stamp points in each frame
+    static const unsigned POINTS = 8;
+
+    /// Constructor
+    GpuTimerGL();
+
+    /// Create the queries (a GL context must be current)
+    bool create( Extensions & glx );
+
+    /// Free the queries (a GL context must be current)
+    void destroy();
+
+    /// Record a time-stamp for the specified point in the current frame
+    void mark( unsigned point );
+
+    /// Finish the current frame. If the oldest frame's results are ready,
+    /// the elapsed milliseconds from point 0 to each point are returned in
+    /// elapsed (which must hold POINTS values) and the function returns true
+    bool endFrame( double *elapsed );
+
+private:
+    Extensions *m_glx;      ///< OpenGL extension functions
+    unsigned m_frame;       ///< current frame count
+    unsigned m_points;      ///< number of points marked in the current frame
+
+    /// The queries for each frame, and the number of points marked
+    std::array< std::array<GLuint,POINTS>, FRAMES > m_queries;
+    std::array< unsigned, FRAMES > m_marked;
+};
+
+//-----------------------------------------------------------------------------
+
+/**
+ * Measures the GPU time taken by a Direct3D9 frame, using the time-stamp
+ * queries. As for GpuTimerGL, results are read without waiting for the GPU.
+ */
+class GpuTimerDX {
+public:
+    /// Number of frames of queries in flight
+    static const unsigned FRAMES = 4;
+
+    /// Constructor
+    GpuTimerDX();
+
+    /// Destructor
+    virtual ~GpuTimerDX();
+
+    /// Create the queries, returns false if time-stamps are unsupported
+    bool create( IDirect3DDevice9 *device );
+
+    /// Release the queries
+    void destroy();
+
+    /// Returns true if the queries were created
+    bool isValid() const { return m_queries[0].begin != 0; }
+
+    /// Mark the start of the frame
+    void begin();
+
+    /// Mark the end of the frame. If the oldest frame's result is ready, the
+    /// elapsed milliseconds are returned in elapsed and the function returns
+    /// true
+    bool end( double & elapsed );
+
+private:
+    /// The queries for one frame
+    struct Queries {
+        IDirect3DQuery9 *disjoint;      ///< detects frequency changes
+        IDirect3DQuery9 *frequency;     ///< time-stamp frequency
+        IDirect3DQuery9 *begin;         ///< time-stamp at start of frame
+        IDirect3DQuery9 *end;           ///< time-stamp at end of frame
+        bool             issued;        ///< have the queries been issued?
+    };
+
+    unsigned m_frame;                   ///< current frame count
+    bool m_begun;                       ///< has the current frame begun?
+    std::array< Queries, FRAMES > m_queries;
+};
+
+//-----------------------------------------------------------------------------
+
+#endif//hive_GpuTimer_h
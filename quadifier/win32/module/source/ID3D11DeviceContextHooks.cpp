@@ -0,0 +1,340 @@
+#if defined(SUPPORT_D3D11)
+
+#include "ID3D11DeviceContextHooks.h"
+#include <mhook-lib/mhook.h>
+#include <atomic>
+#include <mutex>
+#include "Quadifier.h"
+#include "Log.h"
+
+using namespace hive;
+using namespace std;
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+namespace {
+
+/// vtable slots of the ID3D11DeviceContext methods which are hooked
+enum Slot {
+    SLOT_Release                                    = 2,
+    SLOT_OMSetRenderTargets                         = 33,
+    SLOT_OMSetRenderTargetsAndUnorderedAccessViews  = 34,
+    SLOT_RSSetViewports                             = 44,
+    SLOT_ClearRenderTargetView                      = 50
+};
+
+typedef ULONG (STDMETHODCALLTYPE *PFNRelease)( ID3D11DeviceContext* );
+typedef void (STDMETHODCALLTYPE *PFNOMSetRenderTargets)(
+    ID3D11DeviceContext*, UINT, ID3D11RenderTargetView *const*,
+    ID3D11DepthStencilView* );
+typedef void (STDMETHODCALLTYPE *PFNOMSetRenderTargetsAndUnorderedAccessViews)(
+    ID3D11DeviceContext*, UINT, ID3D11RenderTargetView *const*,
+    ID3D11DepthStencilView*, UINT, UINT, ID3D11UnorderedAccessView *const*,
+    const UINT* );
+typedef void (STDMETHODCALLTYPE *PFNRSSetViewports)(
+    ID3D11DeviceContext*, UINT, const D3D11_VIEWPORT* );
+typedef void (STDMETHODCALLTYPE *PFNClearRenderTargetView)(
+    ID3D11DeviceContext*, ID3D11RenderTargetView*, const FLOAT[4] );
+
+const unsigned IMPLEMENTATIONS = ID3D11DeviceContextHooks::IMPLEMENTATIONS;
+
+/// the real functions (trampolines once hooked), per implementation
+PFNRelease                                  real_Release[IMPLEMENTATIONS];
+PFNOMSetRenderTargets                       real_OMSetRenderTargets[IMPLEMENTATIONS];
+PFNOMSetRenderTargetsAndUnorderedAccessViews real_OMSetRenderTargetsAndUnorderedAccessViews[IMPLEMENTATIONS];
+PFNRSSetViewports                           real_RSSetViewports[IMPLEMENTATIONS];
+PFNClearRenderTargetView                    real_ClearRenderTargetView[IMPLEMENTATIONS];
+
+/// the vtables which have been hooked (0 = unused)
+void **g_vtables[IMPLEMENTATIONS];
+
+/// guards attaching, detaching and unhooking
+std::mutex g_mutex;
+
+/// an attached context, and its renderer
+struct Attached {
+    std::atomic<ID3D11DeviceContext*> context;  ///< the real context (or 0)
+    Quadifier *quad;                            ///< the DX/OpenGL renderer
+};
+
+/// the attached contexts (written under g_mutex, read without it)
+Attached g_attached[ID3D11DeviceContextHooks::CAPACITY];
+
+/// nesting of hooked calls on this thread: calls made by Quadifier itself
+/// go straight to the context
+__declspec(thread) int t_depth = 0;
+
+/// RAII helper for t_depth
+struct Nested {
+    Nested()  { ++t_depth; }
+    ~Nested() { --t_depth; }
+};
+
+/// Returns the renderer of the context, or 0 if it is not attached (or is
+/// being called from inside another hook)
+Quadifier * find( ID3D11DeviceContext *context )
+{
+    if ( t_depth > 0 ) return 0;
+    for (unsigned i=0; i<ID3D11DeviceContextHooks::CAPACITY; ++i) {
+        if ( g_attached[i].context.load( std::memory_order_acquire ) == context )
+            return g_attached[i].quad;
+    }
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+
+template <unsigned I>
+ULONG STDMETHODCALLTYPE hook_Release( ID3D11DeviceContext *self )
+{
+    ULONG count = real_Release[I]( self );
+
+    // detach a context once it has been destroyed (its address may be used
+    // again by a context that has not been attached)
+    if ( count == 0 ) {
+        std::lock_guard<std::mutex> lock( g_mutex );
+        for (unsigned i=0; i<ID3D11DeviceContextHooks::CAPACITY; ++i) {
+            if ( g_attached[i].context.load() == self ) {
+                g_attached[i].context.store( 0 );
+                g_attached[i].quad = 0;
+            }
+        }
+    }
+
+    return count;
+}
+
+//-----------------------------------------------------------------------------
+
+template <unsigned I>
+void STDMETHODCALLTYPE hook_OMSetRenderTargets(
+    ID3D11DeviceContext *self,
+    UINT NumViews,
+    ID3D11RenderTargetView *const *ppRenderTargetViews,
+    ID3D11DepthStencilView *pDepthStencilView
+) {
+    // redirect rendering of the back buffer into the capture target
+    Quadifier *quad = find( self );
+    if ( quad != 0 ) {
+        Nested nested;
+        ppRenderTargetViews = quad->onPreSetRenderTargetsDX( NumViews, ppRenderTargetViews );
+    }
+
+    real_OMSetRenderTargets[I]( self, NumViews, ppRenderTargetViews, pDepthStencilView );
+}
+
+//-----------------------------------------------------------------------------
+
+template <unsigned I>
+void STDMETHODCALLTYPE hook_OMSetRenderTargetsAndUnorderedAccessViews(
+    ID3D11DeviceContext *self,
+    UINT NumRTVs,
+    ID3D11RenderTargetView *const *ppRenderTargetViews,
+    ID3D11DepthStencilView *pDepthStencilView,
+    UINT UAVStartSlot,
+    UINT NumUAVs,
+    ID3D11UnorderedAccessView *const *ppUnorderedAccessViews,
+    const UINT *pUAVInitialCounts
+) {
+    // redirect rendering of the back buffer into the capture target
+    // (NumRTVs may be D3D11_KEEP_RENDER_TARGETS_AND_DEPTH_STENCIL)
+    Quadifier *quad = find( self );
+    if ( (quad != 0) && (NumRTVs <= D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT) ) {
+        Nested nested;
+        ppRenderTargetViews = quad->onPreSetRenderTargetsDX( NumRTVs, ppRenderTargetViews );
+    }
+
+    real_OMSetRenderTargetsAndUnorderedAccessViews[I](
+        self, NumRTVs, ppRenderTargetViews, pDepthStencilView,
+        UAVStartSlot, NumUAVs, ppUnorderedAccessViews, pUAVInitialCounts
+    );
+}
+
+//-----------------------------------------------------------------------------
+
+template <unsigned I>
+void STDMETHODCALLTYPE hook_RSSetViewports(
+    ID3D11DeviceContext *self,
+    UINT NumViewports,
+    const D3D11_VIEWPORT *pViewports
+) {
+    // check for the stereo signal from the Quadifier script
+    Quadifier *quad = find( self );
+    if ( quad != 0 ) {
+        Nested nested;
+        if ( !quad->onPreSetViewportsDX( NumViewports, pViewports ) ) return;
+    }
+
+    real_RSSetViewports[I]( self, NumViewports, pViewports );
+}
+
+//-----------------------------------------------------------------------------
+
+template <unsigned I>
+void STDMETHODCALLTYPE hook_ClearRenderTargetView(
+    ID3D11DeviceContext *self,
+    ID3D11RenderTargetView *pRenderTargetView,
+    const FLOAT ColorRGBA[4]
+) {
+    // clear the capture target instead of the back buffer
+    Quadifier *quad = find( self );
+    if ( quad != 0 ) {
+        Nested nested;
+        pRenderTargetView = quad->onPreClearRenderTargetViewDX( pRenderTargetView );
+    }
+
+    real_ClearRenderTargetView[I]( self, pRenderTargetView, ColorRGBA );
+}
+
+//-----------------------------------------------------------------------------
+
+/// one hooked slot: where the real function pointer lives, and the hook
+struct Hook {
+    unsigned slot;
+    PVOID   *real;
+    PVOID    hook;
+};
+
+#define HOOK(name,I) { SLOT_##name, reinterpret_cast<PVOID*>(&real_##name[I]), \
+    reinterpret_cast<PVOID>(hook_##name<I>) }
+#define HOOKS(I) { \
+    HOOK(Release,I), \
+    HOOK(OMSetRenderTargets,I), \
+    HOOK(OMSetRenderTargetsAndUnorderedAccessViews,I), \
+    HOOK(RSSetViewports,I), \
+    HOOK(ClearRenderTargetView,I) \
+}
+
+const unsigned HOOK_COUNT = 5;
+
+/// the hooks of each implementation
+const Hook g_hooks[IMPLEMENTATIONS][HOOK_COUNT] = { HOOKS(0), HOOKS(1) };
+
+#undef HOOKS
+#undef HOOK
+
+/// hook the functions of a vtable as the given implementation (call with
+/// g_mutex held)
+bool install( unsigned implementation, void **vtable )
+{
+    const Hook *hooks = g_hooks[implementation];
+
+    // the deferred context may share its functions with the immediate context
+    // through a different vtable: those functions are already hooked
+    for (unsigned i=0; i<IMPLEMENTATIONS; ++i) {
+        if ( (g_vtables[i] != 0) &&
+             (g_vtables[i][SLOT_OMSetRenderTargets] == vtable[SLOT_OMSetRenderTargets])
+        ) {
+            g_vtables[implementation] = vtable;
+            return true;
+        }
+    }
+
+    for (unsigned i=0; i<HOOK_COUNT; ++i) {
+        *hooks[i].real = vtable[hooks[i].slot];
+        if ( !Mhook_SetHook( hooks[i].real, hooks[i].hook ) ) {
+            Log::print( "error: failed to hook ID3D11DeviceContext vtable slot " )
+                << hooks[i].slot << endl;
+
+            // undo the hooks made so far
+            while ( i-- > 0 ) Mhook_Unhook( hooks[i].real );
+            return false;
+        }
+    }
+
+    g_vtables[implementation] = vtable;
+    return true;
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+
+bool ID3D11DeviceContextHooks::attach(
+    ID3D11DeviceContext *context,
+    Quadifier *quad
+) {
+    if ( (context == 0) || (quad == 0) ) return false;
+    std::lock_guard<std::mutex> lock( g_mutex );
+
+    // the context's implementation must be hooked (or hookable)
+    void **vtable = *reinterpret_cast<void***>( context );
+    unsigned implementation = 0;
+    while ( (implementation < IMPLEMENTATIONS) &&
+            (g_vtables[implementation] != 0) &&
+            (g_vtables[implementation] != vtable) )
+        ++implementation;
+
+    if ( implementation == IMPLEMENTATIONS ) {
+        Log::print( "warning: too many ID3D11DeviceContext implementations, "
+                    "cannot hook context\n" );
+        return false;
+    }
+    if ( (g_vtables[implementation] == 0) && !install( implementation, vtable ) )
+        return false;
+
+    // find a free entry
+    unsigned index = 0;
+    while ( (index < CAPACITY) && (g_attached[index].context.load() != 0) ) ++index;
+    if ( index == CAPACITY ) {
+        Log::print( "warning: too many ID3D11DeviceContext hooked\n" );
+        return false;
+    }
+
+    // publish the context last, so that hooks only see the entry complete
+    g_attached[index].quad = quad;
+    g_attached[index].context.store( context, std::memory_order_release );
+
+    if (Log::info())
+        Log::print() << "ID3D11DeviceContextHooks::attach(" << context << ','
+            << quad << ")\n";
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void ID3D11DeviceContextHooks::unhook()
+{
+    std::lock_guard<std::mutex> lock( g_mutex );
+
+    for (unsigned implementation=0; implementation<IMPLEMENTATIONS; ++implementation) {
+        if ( g_vtables[implementation] == 0 ) continue;
+
+        // only the implementations which installed hooks have trampolines
+        const Hook *hooks = g_hooks[implementation];
+        if ( *hooks[0].real != 0 ) {
+            for (unsigned i=0; i<HOOK_COUNT; ++i)
+                Mhook_Unhook( hooks[i].real );
+        }
+        g_vtables[implementation] = 0;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+#endif//SUPPORT_D3D11
@@ -0,0 +1,70 @@
+#if !defined(hive_ID3D11DeviceContextHooks_h) && (defined(SUPPORT_D3D11))
+#define hive_ID3D11DeviceContextHooks_h
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+#include <d3d11.h>
+
+class Quadifier;
+
+//-----------------------------------------------------------------------------
+
+/**
+ * Alternative to ID3D11DeviceContextProxy which hooks only the context
+ * methods that Quadifier acts on (OMSetRenderTargets,
+ * OMSetRenderTargetsAndUnorderedAccessViews, RSSetViewports and
+ * ClearRenderTargetView), so that draws, Map/Unmap and the other state
+ * calls go straight to the runtime.
+ *
+ * The functions found in the context's vtable slots are patched with mhook,
+ * so the hooks apply to every context with the same implementation, and
+ * look up the renderer of the calling context (contexts which have not been
+ * attached pass straight through). Up to IMPLEMENTATIONS different vtables
+ * can be hooked, as the deferred contexts may not share the immediate
+ * context's. Release is hooked too, so that a context is detached when it
+ * is destroyed.
+ */
+class ID3D11DeviceContextHooks {
+public:
+    /// Maximum number of attached contexts
+    static const unsigned CAPACITY = 16;
+
+    /// Maximum number of different context implementations
+    static const unsigned IMPLEMENTATIONS = 2;
+
+    /// Hook the context (immediate or deferred) for the renderer, installing
+    /// the hooks for its implementation if needed. Returns false if the
+    /// context cannot be hooked.
+    static bool attach( ID3D11DeviceContext *context, Quadifier *quad );
+
+    /// Remove all the hooks
+    static void unhook();
+};
+
+//-----------------------------------------------------------------------------
+
+#endif//hive_ID3D11DeviceContextHooks_h
@@ -0,0 +1,547 @@
+#include "OutputWindow.h"
+#include <process.h>
+#include <GL/glext.h>
+#include <GL/wglext.h>
+#include "Log.h"
+
+using namespace hive;
+using namespace std;
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+namespace {
+
+/// Time to wait for the output thread to start or stop (milliseconds)
+const DWORD THREAD_TIMEOUT = 5000;
+
+/// Longest time the main thread waits for a copy between GPUs (nanoseconds)
+const GLuint64 COPY_TIMEOUT = 100000000;
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+
+OutputWindow::OutputWindow() :
+    m_glx( 0 ),
+    m_mainContext( 0 ),
+    m_affinityDC( 0 ),
+    m_stereo( false ),
+    m_copyImage( false ),
+    m_running( false ),
+    m_thread( 0 ),
+    m_writeSlot( 0 ),
+    m_readSlot( 0 ),
+    m_textureWidth( 0 ),
+    m_textureHeight( 0 )
+{
+    m_output = Settings::Output();
+    m_quit.store( false );
+    m_writeSlot = m_mailbox.writeSlot();
+    m_readSlot = m_mailbox.readSlot();
+    m_texture[0] = m_texture[1] = 0;
+
+    for (unsigned i=0; i<m_slot.size(); ++i) {
+        Slot & slot = m_slot[i];
+        slot.texture[0] = slot.texture[1] = 0;
+        slot.frameBuffer[0] = slot.frameBuffer[1] = 0;
+        slot.drawBuffer[0] = GL_BACK_LEFT;
+        slot.drawBuffer[1] = GL_BACK_RIGHT;
+        slot.written = 0;
+        slot.read = 0;
+        slot.eyes = 0;
+        slot.width = 0;
+        slot.height = 0;
+    }
+
+    // auto-reset event used to wake the output thread
+    m_frameReady = CreateEvent( NULL, FALSE, FALSE, NULL );
+}
+
+//-----------------------------------------------------------------------------
+
+OutputWindow::~OutputWindow()
+{
+    // note: destroy() must be called on the main GL thread before this
+    if ( m_frameReady != 0 ) CloseHandle( m_frameReady );
+}
+
+//-----------------------------------------------------------------------------
+
+bool OutputWindow::create(
+    Extensions & glx,
+    const Settings::Output & output,
+    bool stereo,
+    const GLWindow::Attributes & context
+) {
+    destroy();
+
+    m_glx = &glx;
+    m_output = output;
+    m_stereo = stereo;
+    m_context = context;
+    m_mainContext = wglGetCurrentContext();
+
+    // fences are needed in either mode, copies between GPUs in copy mode
+    if ( !glx.loadSync() ) {
+        Log::print( "warning: GL sync objects are not supported, output windows disabled\n" );
+        return false;
+    }
+    const bool multiGpu = glx.loadMultiGpu();
+    if ( (output.gpu > 0) && !multiGpu ) {
+        Log::print( "warning: WGL_NV_gpu_affinity/WGL_NV_copy_image are not supported, output on GPU " )
+            << (output.gpu - 1) << " disabled\n";
+        return false;
+    }
+    m_copyImage = ( output.gpu > 0 );
+
+    // start the output thread, and wait for it to create its context
+    m_quit.store( false );
+    m_thread = reinterpret_cast<HANDLE>( _beginthreadex(
+        0, 0, threadFunc, this, 0, 0
+    ) );
+    if ( m_thread == 0 ) {
+        Log::print( "error: failed to start output thread\n" );
+        return false;
+    }
+
+    bool success = m_created.wait( THREAD_TIMEOUT ) && ( m_window.getHGLRC() != 0 );
+
+    // on the same GPU the output context shares our objects (neither
+    // context may be current while the lists are shared)
+    if ( success && !m_copyImage ) {
+        HDC dc = wglGetCurrentDC();
+        wglMakeCurrent( 0, 0 );
+        const bool shared = ( wglShareLists( m_mainContext, m_window.getHGLRC() ) == TRUE );
+        wglMakeCurrent( dc, m_mainContext );
+
+        if ( !shared ) {
+            // copy between the contexts instead, if we can
+            Log::print( "warning: unable to share GL objects with output window\n" );
+            m_copyImage = multiGpu;
+            success = multiGpu;
+        }
+    }
+
+    // let the output thread carry on (or exit, on failure)
+    if ( !success ) m_quit.store( true );
+    m_shared.signal();
+
+    if ( !success ) {
+        Log::print( "error: failed to create output window\n" );
+        destroy();
+        return false;
+    }
+
+    m_running = true;
+    if (Log::info()) {
+        Log::print( "output window at " )
+            << output.rect[0] << ',' << output.rect[1] << ' '
+            << output.rect[2] << 'x' << output.rect[3]
+            << ( m_copyImage ? " (copied" : " (shared" )
+            << ", GPU " << output.gpu << ")\n";
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void OutputWindow::destroy()
+{
+    // stop the output thread (which destroys its window)
+    if ( m_thread != 0 ) {
+        m_quit.store( true );
+        SetEvent( m_frameReady );
+        if ( WaitForSingleObject( m_thread, THREAD_TIMEOUT ) != WAIT_OBJECT_0 )
+            Log::print( "warning: output thread did not exit\n" );
+        CloseHandle( m_thread );
+        m_thread = 0;
+    }
+
+    destroyStaging();
+    m_running = false;
+}
+
+//-----------------------------------------------------------------------------
+
+void OutputWindow::copy(
+    const GLuint *frameBuffer,
+    const GLuint *drawBuffer,
+    const unsigned *originX,
+    unsigned eyes,
+    unsigned width,
+    unsigned height
+) {
+    if ( !m_running || (eyes == 0) ) return;
+    if ( eyes > 2 ) eyes = 2;
+
+    Extensions & glx = *m_glx;
+
+    // the output's part of each eye: the viewport is measured from the
+    // bottom left, and the image is stored top row first
+    const float *viewport = m_output.viewport;
+    int x = static_cast<int>( viewport[0] * width + 0.5f );
+    int y = static_cast<int>( (1.f - viewport[1] - viewport[3]) * height + 0.5f );
+    int w = static_cast<int>( viewport[2] * width + 0.5f );
+    int h = static_cast<int>( viewport[3] * height + 0.5f );
+    if ( x < 0 ) x = 0;
+    if ( y < 0 ) y = 0;
+    if ( x + w > static_cast<int>(width) ) w = static_cast<int>(width) - x;
+    if ( y + h > static_cast<int>(height) ) h = static_cast<int>(height) - y;
+    if ( (w <= 0) || (h <= 0) ) return;
+
+    Slot & slot = m_slot[m_writeSlot];
+
+    // wait (on the GPU) for the output to finish drawing from this slot,
+    // and drop the fence of a copy the output never picked up
+    if ( slot.read != 0 ) {
+        glx.glWaitSync( slot.read, 0, GL_TIMEOUT_IGNORED );
+        glx.glDeleteSync( slot.read );
+        slot.read = 0;
+    }
+    if ( slot.written != 0 ) {
+        glx.glDeleteSync( slot.written );
+        slot.written = 0;
+    }
+
+    // the staging textures follow the size of the region
+    if ( (slot.width != static_cast<unsigned>(w)) || (slot.height != static_cast<unsigned>(h)) ) {
+        if ( !createStaging( m_writeSlot, w, h ) ) return;
+    }
+
+    // copy (and resolve) each eye's region into the staging textures
+    for (unsigned eye=0; eye<eyes; ++eye) {
+        glx.glBindFramebuffer( GL_READ_FRAMEBUFFER, frameBuffer[eye] );
+        glx.glBindFramebuffer( GL_DRAW_FRAMEBUFFER, slot.frameBuffer[eye] );
+        const int origin = static_cast<int>( originX[eye] );
+        glx.glBlitFramebuffer(
+            origin + x, y, origin + x + w, y + h,
+            0, 0, w, h,
+            GL_COLOR_BUFFER_BIT,
+            GL_NEAREST
+        );
+        slot.drawBuffer[eye] = drawBuffer[eye];
+    }
+    slot.eyes = eyes;
+    glx.glBindFramebuffer( GL_READ_FRAMEBUFFER, 0 );
+    glx.glBindFramebuffer( GL_DRAW_FRAMEBUFFER, 0 );
+
+    if ( m_copyImage ) {
+        // another context copies the staging textures out, so they must be
+        // complete before the slot is published
+        GLsync fence = glx.glFenceSync( GL_SYNC_GPU_COMMANDS_COMPLETE, 0 );
+        glx.glClientWaitSync( fence, GL_SYNC_FLUSH_COMMANDS_BIT, COPY_TIMEOUT );
+        glx.glDeleteSync( fence );
+    } else {
+        // the output waits for this on the GPU (the flush makes the fence
+        // visible to the other context)
+        slot.written = glx.glFenceSync( GL_SYNC_GPU_COMMANDS_COMPLETE, 0 );
+        glFlush();
+    }
+
+    // pass the slot to the output thread
+    m_writeSlot = m_mailbox.publish( m_writeSlot );
+    SetEvent( m_frameReady );
+}
+
+//-----------------------------------------------------------------------------
+
+bool OutputWindow::createStaging( unsigned index, unsigned width, unsigned height )
+{
+    Extensions & glx = *m_glx;
+    Slot & slot = m_slot[index];
+
+    for (unsigned eye=0; eye<2; ++eye) {
+        if ( slot.frameBuffer[eye] != 0 ) glx.glDeleteFramebuffers( 1, &slot.frameBuffer[eye] );
+        if ( slot.texture[eye] != 0 ) glDeleteTextures( 1, &slot.texture[eye] );
+        slot.frameBuffer[eye] = 0;
+        slot.texture[eye] = 0;
+    }
+    slot.width = 0;
+    slot.height = 0;
+
+    bool success = true;
+    for (unsigned eye=0; success && (eye<2); ++eye) {
+        glGenTextures( 1, &slot.texture[eye] );
+        glBindTexture( GL_TEXTURE_2D, slot.texture[eye] );
+        glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR );
+        glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR );
+        glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE );
+        glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE );
+        glTexImage2D(
+            GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0,
+            GL_RGBA, GL_UNSIGNED_BYTE, 0
+        );
+
+        glx.glGenFramebuffers( 1, &slot.frameBuffer[eye] );
+        glx.glBindFramebuffer( GL_FRAMEBUFFER, slot.frameBuffer[eye] );
+        glx.glFramebufferTexture2D(
+            GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, slot.texture[eye], 0
+        );
+        success = ( glx.glCheckFramebufferStatus( GL_FRAMEBUFFER ) == GL_FRAMEBUFFER_COMPLETE );
+    }
+    glBindTexture( GL_TEXTURE_2D, 0 );
+    glx.glBindFramebuffer( GL_FRAMEBUFFER, 0 );
+
+    if ( !success ) {
+        Log::print( "error: failed to create output staging textures\n" );
+        return false;
+    }
+
+    slot.width = width;
+    slot.height = height;
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void OutputWindow::destroyStaging()
+{
+    if ( m_glx == 0 ) return;
+    Extensions & glx = *m_glx;
+
+    for (unsigned i=0; i<m_slot.size(); ++i) {
+        Slot & slot = m_slot[i];
+        for (unsigned eye=0; eye<2; ++eye) {
+            if ( slot.frameBuffer[eye] != 0 ) glx.glDeleteFramebuffers( 1, &slot.frameBuffer[eye] );
+            if ( slot.texture[eye] != 0 ) glDeleteTextures( 1, &slot.texture[eye] );
+            slot.frameBuffer[eye] = 0;
+            slot.texture[eye] = 0;
+        }
+        if ( slot.written != 0 ) glx.glDeleteSync( slot.written );
+        if ( slot.read != 0 ) glx.glDeleteSync( slot.read );
+        slot.written = 0;
+        slot.read = 0;
+        slot.eyes = 0;
+        slot.width = 0;
+        slot.height = 0;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+unsigned __stdcall OutputWindow::threadFunc( void *context )
+{
+    OutputWindow *self = reinterpret_cast<OutputWindow*>( context );
+    if ( self != 0 ) self->run();
+
+    _endthreadex( 0 );
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+
+void OutputWindow::run()
+{
+    // window creation attributes
+    GLWindow::Attributes attributes;
+    if ( m_stereo ) attributes[WGL_STEREO_ARB] = GL_TRUE;
+    attributes[WGL_DEPTH_BITS_ARB] = 0;
+    attributes[WGL_STENCIL_BITS_ARB] = 0;
+
+    // a borderless window on top of the desktop; note that the window class
+    // is shared with the main GL window, so messages go to its window proc,
+    // which passes them to DefWindowProc as no Quadifier is attached
+    bool success = m_window.create(
+        WS_EX_TOOLWINDOW | WS_EX_NOACTIVATE,
+        L"Quadifier output",
+        WS_POPUP | WS_CLIPCHILDREN | WS_CLIPSIBLINGS,
+        m_output.rect[0], m_output.rect[1],
+        m_output.rect[2], m_output.rect[3],
+        0,
+        0,
+        DefWindowProc,
+        0,
+        attributes,
+        m_context
+    );
+
+    // on another GPU, replace the context with one tied to that GPU
+    if ( success && (m_output.gpu > 0) ) {
+        HGPUNV gpu = 0;
+        success = m_glxOutput.loadMultiGpu() &&
+            m_glxOutput.wglEnumGpusNV( m_output.gpu - 1, &gpu );
+        if ( success ) {
+            HGPUNV gpus[2] = { gpu, 0 };
+            m_affinityDC = m_glxOutput.wglCreateAffinityDCNV( gpus );
+            success = ( m_affinityDC != 0 ) && m_window.useContextOf( m_affinityDC );
+        }
+        if ( !success )
+            Log::print( "error: unable to create GL context on GPU " ) << (m_output.gpu - 1) << endl;
+    }
+    if ( !success ) m_window.destroy();
+
+    // the main thread sets up sharing while neither context is current
+    wglMakeCurrent( 0, 0 );
+    m_created.signal();
+    m_shared.wait();
+
+    if ( success && !m_quit.load() ) {
+        wglMakeCurrent( m_window.getHDC(), m_window.getHGLRC() );
+        m_glxOutput.loadSync();
+        if ( m_copyImage ) m_glxOutput.loadMultiGpu();
+
+        // only draw to the right buffer if we got a stereo format
+        GLboolean stereo = GL_FALSE;
+        glGetBooleanv( GL_STEREO, &stereo );
+        m_stereo = ( stereo == GL_TRUE );
+
+        glDisable( GL_DEPTH_TEST );
+        glDisable( GL_LIGHTING );
+        glClearColor( 0.f, 0.f, 0.f, 1.f );
+        glViewport( 0, 0, m_output.rect[2], m_output.rect[3] );
+
+        // projector warp and edge blend (the staging textures are single
+        // sample, and the output's part of each eye fills them)
+        if ( !m_output.warp.empty() || !m_output.blend.empty() ) {
+            const bool calibrated =
+                m_present.create( m_glxOutput, GL_TEXTURE_2D, 1 ) &&
+                m_present.loadCalibration(
+                    m_output.warp, m_output.blend, Settings::get().blendGamma
+                );
+            if ( !calibrated ) {
+                Log::print( "warning: output window at " )
+                    << m_output.rect[0] << ',' << m_output.rect[1]
+                    << " drawing uncalibrated\n";
+                m_present.destroy();
+            }
+        }
+
+        m_window.show( SW_SHOWNA );
+
+        while ( !m_quit.load() ) {
+            // the window still needs its messages handled
+            MSG message;
+            while ( PeekMessage( &message, NULL, 0, 0, PM_REMOVE ) ) {
+                TranslateMessage( &message );
+                DispatchMessage( &message );
+            }
+
+            // paint the latest frame, or sleep until there is one
+            if ( m_mailbox.acquire( m_readSlot ) )
+                paint();
+            else
+                MsgWaitForMultipleObjects( 1, &m_frameReady, FALSE, 100, QS_ALLINPUT );
+        }
+
+        m_present.destroy();
+
+        // our own textures (copy mode)
+        for (unsigned eye=0; eye<2; ++eye) {
+            if ( m_texture[eye] != 0 ) glDeleteTextures( 1, &m_texture[eye] );
+            m_texture[eye] = 0;
+        }
+    }
+
+    m_window.destroy();
+    if ( m_affinityDC != 0 ) {
+        m_glxOutput.wglDeleteDCNV( m_affinityDC );
+        m_affinityDC = 0;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void OutputWindow::paint()
+{
+    Slot & slot = m_slot[m_readSlot];
+    if ( slot.eyes == 0 ) return;
+
+    Extensions & glx = m_glxOutput;
+    GLuint texture[2] = { slot.texture[0], slot.texture[1] };
+
+    if ( m_copyImage ) {
+        // copy the staging textures into our own (on our GPU)
+        if ( (m_textureWidth != slot.width) || (m_textureHeight != slot.height) ) {
+            for (unsigned eye=0; eye<2; ++eye) {
+                if ( m_texture[eye] == 0 ) glGenTextures( 1, &m_texture[eye] );
+                glBindTexture( GL_TEXTURE_2D, m_texture[eye] );
+                glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR );
+                glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR );
+                glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE );
+                glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE );
+                glTexImage2D(
+                    GL_TEXTURE_2D, 0, GL_RGBA8, slot.width, slot.height, 0,
+                    GL_RGBA, GL_UNSIGNED_BYTE, 0
+                );
+            }
+            m_textureWidth = slot.width;
+            m_textureHeight = slot.height;
+        }
+        for (unsigned eye=0; eye<slot.eyes; ++eye) {
+            glx.wglCopyImageSubDataNV(
+                m_mainContext, slot.texture[eye], GL_TEXTURE_2D, 0, 0, 0, 0,
+                m_window.getHGLRC(), m_texture[eye], GL_TEXTURE_2D, 0, 0, 0, 0,
+                slot.width, slot.height, 1
+            );
+            texture[eye] = m_texture[eye];
+        }
+
+        // finish the copies before handing the slot back to the main thread
+        glFinish();
+    } else if ( slot.written != 0 ) {
+        // wait (on the GPU) for the main thread's copy into the slot
+        glx.glWaitSync( slot.written, 0, GL_TIMEOUT_IGNORED );
+        glx.glDeleteSync( slot.written );
+        slot.written = 0;
+    }
+
+    // draw each eye over the whole window (flipping the image vertically,
+    // since it is stored top row first)
+    const unsigned eyes = m_stereo ? slot.eyes : 1;
+    if ( m_present.isValid() ) {
+        // through the calibration (the pipeline flips the image itself)
+        m_present.begin();
+        for (unsigned eye=0; eye<eyes; ++eye) {
+            glDrawBuffer( m_stereo ? slot.drawBuffer[eye] : GL_BACK );
+            m_present.draw( texture[eye] );
+        }
+        m_present.end();
+    } else {
+        glEnable( GL_TEXTURE_2D );
+        glColor4f( 1.f, 1.f, 1.f, 1.f );
+        for (unsigned eye=0; eye<eyes; ++eye) {
+            glDrawBuffer( m_stereo ? slot.drawBuffer[eye] : GL_BACK );
+            glBindTexture( GL_TEXTURE_2D, texture[eye] );
+            glBegin( GL_QUADS );
+                glTexCoord2f( 0.f, 1.f ); glVertex2f( -1.f, -1.f );
+                glTexCoord2f( 1.f, 1.f ); glVertex2f(  1.f, -1.f );
+                glTexCoord2f( 1.f, 0.f ); glVertex2f(  1.f,  1.f );
+                glTexCoord2f( 0.f, 0.f ); glVertex2f( -1.f,  1.f );
+            glEnd();
+        }
+        glBindTexture( GL_TEXTURE_2D, 0 );
+        glDisable( GL_TEXTURE_2D );
+    }
+
+    // the main thread waits for this before copying into the slot again
+    if ( !m_copyImage )
+        slot.read = glx.glFenceSync( GL_SYNC_GPU_COMMANDS_COMPLETE, 0 );
+
+    m_window.swapBuffers();
+}
+
+//-----------------------------------------------------------------------------
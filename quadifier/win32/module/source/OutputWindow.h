@@ -0,0 +1,166 @@
+#ifndef hive_OutputWindow_h
+#define hive_OutputWindow_h
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+#include <windows.h>
+#include <GL/gl.h>
+#include <array>
+#include <atomic>
+#include "Event.h"
+#include "Extensions.h"
+#include "FrameMailbox.h"
+#include "GLWindow.h"
+#include "PresentPipeline.h"
+#include "Settings.h"
+
+//-----------------------------------------------------------------------------
+
+/**
+ * An extra top-level GL window which shows one part of each captured eye,
+ * e.g. one wall of a CAVE rendered by Unity into a single wide surface.
+ * Each output has its own thread and GL context, and paints and swaps
+ * independently of the main GL window.
+ *
+ * The main GL thread copies the output's part of each eye into a slot of
+ * staging textures, and passes the slot to the output thread through a
+ * FrameMailbox. When the output is on the same GPU, its context shares the
+ * staging textures with the main context (synchronised with fences in both
+ * directions). When it is on another GPU (through NV_gpu_affinity), the
+ * output thread copies the staging textures into its own with
+ * WGL_NV_copy_image.
+ *
+ * An output with a projector warp or edge blend draws its eyes through a
+ * PresentPipeline of its own, which applies them in the same draw.
+ */
+class OutputWindow {
+public:
+    /// Constructor
+    OutputWindow();
+
+    /// Destructor
+    virtual ~OutputWindow();
+
+    /// Create the window and start its thread. Called on the main GL
+    /// thread, with the main context current; the output context is created
+    /// with the main context's attributes (so that they can share)
+    bool create(
+        Extensions & glx,
+        const hive::Settings::Output & output,
+        bool stereo,
+        const GLWindow::Attributes & context
+    );
+
+    /// Stop the thread and destroy the window (main GL thread)
+    void destroy();
+
+    /// Returns the captured view shown as the left (0) or right (1) eye
+    unsigned view( unsigned eye ) const { return m_output.view[eye]; }
+
+    /**
+     * Copy this output's part of each eye into the next slot, and pass it
+     * to the output thread. Called on the main GL thread while the eye
+     * targets are locked: frameBuffer and drawBuffer give the framebuffer
+     * of each eye's target, and the buffer it is drawn to; originX gives
+     * where each eye starts in its framebuffer (the eyes of a double-wide
+     * target are side by side), and width and height the size of an eye.
+     */
+    void copy(
+        const GLuint *frameBuffer,
+        const GLuint *drawBuffer,
+        const unsigned *originX,
+        unsigned eyes,
+        unsigned width,
+        unsigned height
+    );
+
+private:
+    /// Copy construction is not supported
+    OutputWindow( const OutputWindow & );
+
+    /// Assignment is not supported
+    OutputWindow & operator = ( const OutputWindow & );
+
+    /// Output thread function
+    static unsigned __stdcall threadFunc( void *context );
+
+    /// Body of the output thread
+    void run();
+
+    /// Paint the frame in the reader's slot (output thread)
+    void paint();
+
+    /// (Re)create the staging textures of a slot (main GL thread)
+    bool createStaging( unsigned slot, unsigned width, unsigned height );
+
+    /// Free the staging textures of all slots (main GL thread)
+    void destroyStaging();
+
+    /// Textures and synchronisation of one mailbox slot
+    struct Slot {
+        GLuint   texture[2];    ///< staging texture for each eye
+        GLuint   frameBuffer[2];///< framebuffer of each staging texture
+        GLuint   drawBuffer[2]; ///< GL draw buffer of each eye
+        GLsync   written;       ///< set when the copy into the slot is done
+        GLsync   read;          ///< set when the output has drawn the slot
+        unsigned eyes;          ///< number of eyes in the slot
+        unsigned width;         ///< size of the staging textures
+        unsigned height;
+    };
+
+    Extensions *m_glx;              ///< main context functions
+    Extensions  m_glxOutput;        ///< output context functions
+    HGLRC       m_mainContext;      ///< main GL context
+    GLWindow    m_window;           ///< the output window
+    PresentPipeline m_present;      ///< warps and blends the eyes (optional)
+    HDC         m_affinityDC;       ///< NV_gpu_affinity device context (or 0)
+    hive::Settings::Output m_output; ///< output settings
+    bool        m_stereo;           ///< request a stereo pixel format?
+    GLWindow::Attributes m_context; ///< context creation attributes
+    bool        m_copyImage;        ///< copy between contexts (not shared)?
+    bool        m_running;          ///< did the window and thread start?
+
+    HANDLE      m_thread;           ///< output thread handle
+    Event       m_created;          ///< output context has been created
+    Event       m_shared;           ///< main thread has set up sharing
+    HANDLE      m_frameReady;       ///< auto-reset event: a slot was published
+    std::atomic<bool> m_quit;       ///< tells the output thread to exit
+
+    FrameMailbox m_mailbox;         ///< passes slots to the output thread
+    unsigned    m_writeSlot;        ///< slot owned by the main GL thread
+    unsigned    m_readSlot;         ///< slot owned by the output thread
+    std::array<Slot,FrameMailbox::SLOTS> m_slot;
+
+    /// Output's own copy of each eye (copy mode only)
+    GLuint      m_texture[2];
+    unsigned    m_textureWidth;
+    unsigned    m_textureHeight;
+};
+
+//-----------------------------------------------------------------------------
+
+#endif//hive_OutputWindow_h
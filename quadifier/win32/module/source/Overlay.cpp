@@ -0,0 +1,408 @@
+#include "Overlay.h"
+#include "Defines.h"
+#include "Log.h"
+#include <GL/glext.h>
+#include <cctype>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace hive;
+using namespace std;
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+namespace {
+
+/// Vertex attribute locations
+const GLuint POSITION = 0;
+const GLuint COORD = 1;
+
+/// Glyph size in atlas texels, and the scale at which glyphs are drawn
+const unsigned GLYPH_WIDTH = 3;
+const unsigned GLYPH_HEIGHT = 5;
+const unsigned GLYPH_SCALE = 3;
+
+/// HUD layout in pixels
+const unsigned MARGIN = 8;
+const unsigned ADVANCE = ( GLYPH_WIDTH + 1 ) * GLYPH_SCALE;
+const unsigned LINE_HEIGHT = ( GLYPH_HEIGHT + 2 ) * GLYPH_SCALE;
+
+/// Kinds of quad, passed to the shaders with each vertex
+const float KIND_INDICATOR = 0.f;
+const float KIND_BACKING = 1.f;
+const float KIND_GLYPH = 2.f;
+
+/// Characters in the atlas (anything else is drawn as a space)
+const char GLYPHS[] = " 0123456789.:/-ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+/// Glyph bitmaps, one octal digit per row (top row first, high bit left)
+const unsigned short FONT[] = {
+    000000, 075557, 026227, 071747, 071717, 055711, 074717, 074757,
+    071111, 075757, 075717, 000002, 002020, 011244, 000700, 025755,
+    065656, 034443, 065556, 074647, 074644, 034553, 055755, 072227,
+    011152, 055655, 044447, 057755, 065555, 025552, 065644, 025563,
+    065655, 034216, 072222, 055557, 055552, 055775, 055255, 055222,
+    071247
+};
+
+const unsigned GLYPH_COUNT = sizeof(FONT) / sizeof(FONT[0]);
+
+/// A vertex: position in pixels (text is positioned down from the top of
+/// the window, indicator from the bottom), atlas coordinates, and kind
+struct Vertex {
+    GLfloat x, y;
+    GLfloat u, v, kind;
+};
+
+/// Append a quad (two triangles) to the vertices
+void addQuad(
+    vector<Vertex> & vertices,
+    float x0, float y0, float x1, float y1,
+    float u0, float v0, float u1, float v1,
+    float kind
+) {
+    const Vertex quad[6] = {
+        { x0, y0, u0, v1, kind }, { x1, y0, u1, v1, kind }, { x0, y1, u0, v0, kind },
+        { x0, y1, u0, v0, kind }, { x1, y0, u1, v1, kind }, { x1, y1, u1, v0, kind }
+    };
+    vertices.insert( vertices.end(), quad, quad + 6 );
+}
+
+/// Vertex shader: converts pixels to clip space, moving text to the top
+const char *vertexShader =
+    "#version 150\n"
+    "uniform vec2 viewport;\n"
+    "in vec2 position;\n"
+    "in vec3 coord;\n"
+    "out vec3 atlas;\n"
+    "void main() {\n"
+    "    vec2 pixel = position;\n"
+    "    if ( coord.z > 0.5 ) pixel.y += viewport.y;\n"
+    "    atlas = coord;\n"
+    "    gl_Position = vec4( 2.0 * pixel / viewport - 1.0, 0.0, 1.0 );\n"
+    "}\n";
+
+/// Fragment shader: the indicator is drawn in the colour of the eye, the
+/// text in white on black (pixels outside each glyph are discarded)
+const char *fragmentShader =
+    "#version 150\n"
+    "uniform sampler2D glyphs;\n"
+    "uniform vec3 indicator;\n"
+    "in vec3 atlas;\n"
+    "out vec4 colour;\n"
+    "void main() {\n"
+    "    if ( atlas.z < 0.5 ) {\n"
+    "        colour = vec4( indicator, 1.0 );\n"
+    "    } else if ( atlas.z < 1.5 ) {\n"
+    "        colour = vec4( 0.0, 0.0, 0.0, 1.0 );\n"
+    "    } else {\n"
+    "        if ( texture( glyphs, atlas.xy ).r < 0.5 ) discard;\n"
+    "        colour = vec4( 1.0 );\n"
+    "    }\n"
+    "}\n";
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+
+Overlay::Overlay() :
+    m_glx( 0 ),
+    m_program( 0 ),
+    m_vertexArray( 0 ),
+    m_vertexBuffer( 0 ),
+    m_atlas( 0 ),
+    m_viewport( -1 ),
+    m_indicator( -1 ),
+    m_vertexCount( 0 ),
+    m_indicatorSize( 0 )
+{
+}
+
+//-----------------------------------------------------------------------------
+
+Overlay::~Overlay()
+{
+    // note: GL resources must be freed by calling destroy() while the
+    // context is still current
+}
+
+//-----------------------------------------------------------------------------
+
+bool Overlay::create( Extensions & glx )
+{
+    m_glx = &glx;
+
+    if ( !glx.loadShaders() ) {
+        Log::print( "error: failed to load GL shader extensions\n" );
+        return false;
+    }
+
+    GLuint vertex = compile( GL_VERTEX_SHADER, vertexShader );
+    GLuint fragment = compile( GL_FRAGMENT_SHADER, fragmentShader );
+
+    do {
+        if ( (vertex == 0) || (fragment == 0) ) break;
+
+        // link the program
+        m_program = glx.glCreateProgram();
+        glx.glAttachShader( m_program, vertex );
+        glx.glAttachShader( m_program, fragment );
+        glx.glBindAttribLocation( m_program, POSITION, "position" );
+        glx.glBindAttribLocation( m_program, COORD, "coord" );
+        glx.glLinkProgram( m_program );
+
+        GLint linked = GL_FALSE;
+        glx.glGetProgramiv( m_program, GL_LINK_STATUS, &linked );
+        if ( linked != GL_TRUE ) {
+            GLint length = 0;
+            glx.glGetProgramiv( m_program, GL_INFO_LOG_LENGTH, &length );
+            vector<char> text( length + 1, 0 );
+            glx.glGetProgramInfoLog( m_program, length, 0, &text[0] );
+            Log::print( "error: failed to link overlay shader:\n" ) << &text[0] << endl;
+
+            glx.glDeleteProgram( m_program );
+            m_program = 0;
+            break;
+        }
+
+        glx.glUseProgram( m_program );
+        glx.glUniform1i( glx.glGetUniformLocation( m_program, "glyphs" ), 0 );
+        m_viewport = glx.glGetUniformLocation( m_program, "viewport" );
+        m_indicator = glx.glGetUniformLocation( m_program, "indicator" );
+        glx.glUseProgram( 0 );
+
+        // the glyph atlas: a single row of glyphs, one byte per texel
+        const unsigned width = GLYPH_COUNT * GLYPH_WIDTH;
+        vector<GLubyte> texels( width * GLYPH_HEIGHT, 0 );
+        for (unsigned glyph=0; glyph<GLYPH_COUNT; ++glyph) {
+            for (unsigned row=0; row<GLYPH_HEIGHT; ++row) {
+                const unsigned bits = FONT[glyph] >> ( 3 * (GLYPH_HEIGHT - 1 - row) );
+                for (unsigned column=0; column<GLYPH_WIDTH; ++column) {
+                    if ( bits & ( 4 >> column ) )
+                        texels[row * width + glyph * GLYPH_WIDTH + column] = 255;
+                }
+            }
+        }
+
+        glGenTextures( 1, &m_atlas );
+        glBindTexture( GL_TEXTURE_2D, m_atlas );
+        glPixelStorei( GL_UNPACK_ALIGNMENT, 1 );
+        glTexImage2D( GL_TEXTURE_2D, 0, GL_R8, width, GLYPH_HEIGHT, 0,
+            GL_RED, GL_UNSIGNED_BYTE, &texels[0] );
+        glPixelStorei( GL_UNPACK_ALIGNMENT, 4 );
+        glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST );
+        glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST );
+        glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE );
+        glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE );
+        glBindTexture( GL_TEXTURE_2D, 0 );
+
+        // the vertex buffer is filled by update()
+        glx.glGenVertexArrays( 1, &m_vertexArray );
+        glx.glBindVertexArray( m_vertexArray );
+
+        glx.glGenBuffers( 1, &m_vertexBuffer );
+        glx.glBindBuffer( GL_ARRAY_BUFFER, m_vertexBuffer );
+
+        glx.glVertexAttribPointer( POSITION, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+            reinterpret_cast<const GLvoid*>( offsetof( Vertex, x ) ) );
+        glx.glVertexAttribPointer( COORD, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex),
+            reinterpret_cast<const GLvoid*>( offsetof( Vertex, u ) ) );
+        glx.glEnableVertexAttribArray( POSITION );
+        glx.glEnableVertexAttribArray( COORD );
+
+        glx.glBindVertexArray( 0 );
+        glx.glBindBuffer( GL_ARRAY_BUFFER, 0 );
+    } while (false_value);
+
+    // the shaders are no longer needed once linked
+    if ( vertex != 0 ) glx.glDeleteShader( vertex );
+    if ( fragment != 0 ) glx.glDeleteShader( fragment );
+
+    if (Log::info() && isValid())
+        Log::print( "created GL overlay\n" );
+
+    return isValid();
+}
+
+//-----------------------------------------------------------------------------
+
+void Overlay::destroy()
+{
+    if ( m_glx == 0 ) return;
+
+    if ( m_vertexArray != 0 ) {
+        m_glx->glDeleteVertexArrays( 1, &m_vertexArray );
+        m_vertexArray = 0;
+    }
+
+    if ( m_vertexBuffer != 0 ) {
+        m_glx->glDeleteBuffers( 1, &m_vertexBuffer );
+        m_vertexBuffer = 0;
+    }
+
+    if ( m_atlas != 0 ) {
+        glDeleteTextures( 1, &m_atlas );
+        m_atlas = 0;
+    }
+
+    if ( m_program != 0 ) {
+        m_glx->glDeleteProgram( m_program );
+        m_program = 0;
+    }
+
+    m_vertexCount = 0;
+    m_indicatorSize = 0;
+    m_text.clear();
+}
+
+//-----------------------------------------------------------------------------
+
+void Overlay::update( unsigned indicatorSize, const std::string & text )
+{
+    if ( !isValid() ) return;
+    if ( (indicatorSize == m_indicatorSize) && (text == m_text) ) return;
+    m_indicatorSize = indicatorSize;
+    m_text = text;
+
+    vector<Vertex> vertices;
+
+    // the indicator, in the bottom left corner
+    if ( indicatorSize > 0 ) {
+        const float size = static_cast<float>( indicatorSize );
+        addQuad( vertices, 0.f, 0.f, size, size, 0.f, 0.f, 0.f, 0.f, KIND_INDICATOR );
+    }
+
+    // measure the text
+    unsigned lines = 0, longest = 0, length = 0;
+    for (size_t i=0; i<=text.size(); ++i) {
+        if ( (i == text.size()) || (text[i] == '\n') ) {
+            if ( length > longest ) longest = length;
+            if ( (length > 0) || (i < text.size()) ) ++lines;
+            length = 0;
+        } else
+            ++length;
+    }
+
+    // the text, on a black backing, in the top left corner (y is measured
+    // from the top of the window)
+    if ( longest > 0 ) {
+        const float right = static_cast<float>( 2 * MARGIN + longest * ADVANCE );
+        const float bottom = -static_cast<float>( 2 * MARGIN + lines * LINE_HEIGHT );
+        addQuad( vertices, 0.f, bottom, right, 0.f, 0.f, 0.f, 0.f, 0.f, KIND_BACKING );
+
+        unsigned line = 0, column = 0;
+        for (size_t i=0; i<text.size(); ++i) {
+            if ( text[i] == '\n' ) {
+                ++line;
+                column = 0;
+                continue;
+            }
+
+            const char *found = strchr( GLYPHS,
+                toupper( static_cast<unsigned char>( text[i] ) ) );
+            const unsigned glyph = ( found != 0 ) ?
+                static_cast<unsigned>( found - GLYPHS ) : 0;
+            if ( glyph != 0 ) {
+                const float x = static_cast<float>( MARGIN + column * ADVANCE );
+                const float y = -static_cast<float>( MARGIN + (line + 1) * LINE_HEIGHT );
+                addQuad( vertices,
+                    x, y,
+                    x + GLYPH_WIDTH * GLYPH_SCALE, y + GLYPH_HEIGHT * GLYPH_SCALE,
+                    static_cast<float>( glyph ) / GLYPH_COUNT, 0.f,
+                    static_cast<float>( glyph + 1 ) / GLYPH_COUNT, 1.f,
+                    KIND_GLYPH
+                );
+            }
+            ++column;
+        }
+    }
+
+    // replace the buffer contents (the driver can orphan the old storage,
+    // so this does not wait for earlier draws)
+    m_vertexCount = static_cast<GLsizei>( vertices.size() );
+    m_glx->glBindBuffer( GL_ARRAY_BUFFER, m_vertexBuffer );
+    m_glx->glBufferData( GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex),
+        vertices.empty() ? 0 : &vertices[0], GL_DYNAMIC_DRAW );
+    m_glx->glBindBuffer( GL_ARRAY_BUFFER, 0 );
+}
+
+//-----------------------------------------------------------------------------
+
+void Overlay::draw( unsigned width, unsigned height )
+{
+    if ( !isValid() || (m_vertexCount == 0) ) return;
+    if ( (width == 0) || (height == 0) ) return;
+
+    m_glx->glUseProgram( m_program );
+    m_glx->glBindVertexArray( m_vertexArray );
+    m_glx->glActiveTexture( GL_TEXTURE0 );
+    glBindTexture( GL_TEXTURE_2D, m_atlas );
+    m_glx->glUniform2f( m_viewport,
+        static_cast<GLfloat>( width ), static_cast<GLfloat>( height ) );
+
+    glDrawBuffer( GL_BACK_LEFT );
+    m_glx->glUniform3f( m_indicator, 0.f, 0.f, 1.f );
+    glDrawArrays( GL_TRIANGLES, 0, m_vertexCount );
+
+    glDrawBuffer( GL_BACK_RIGHT );
+    m_glx->glUniform3f( m_indicator, 1.f, 0.f, 0.f );
+    glDrawArrays( GL_TRIANGLES, 0, m_vertexCount );
+
+    glBindTexture( GL_TEXTURE_2D, 0 );
+    m_glx->glBindVertexArray( 0 );
+    m_glx->glUseProgram( 0 );
+}
+
+//-----------------------------------------------------------------------------
+
+GLuint Overlay::compile( GLenum type, const char *source )
+{
+    GLuint shader = m_glx->glCreateShader( type );
+    if ( shader == 0 ) return 0;
+
+    m_glx->glShaderSource( shader, 1, &source, 0 );
+    m_glx->glCompileShader( shader );
+
+    GLint compiled = GL_FALSE;
+    m_glx->glGetShaderiv( shader, GL_COMPILE_STATUS, &compiled );
+    if ( compiled != GL_TRUE ) {
+        GLint length = 0;
+        m_glx->glGetShaderiv( shader, GL_INFO_LOG_LENGTH, &length );
+        vector<char> text( length + 1, 0 );
+        m_glx->glGetShaderInfoLog( shader, length, 0, &text[0] );
+        Log::print( "error: failed to compile overlay shader:\n" ) << &text[0] << endl;
+
+        m_glx->glDeleteShader( shader );
+        return 0;
+    }
+
+    return shader;
+}
+
+//-----------------------------------------------------------------------------
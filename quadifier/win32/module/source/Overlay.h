@@ -0,0 +1,90 @@
+#ifndef hive_Overlay_h
+#define hive_Overlay_h
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+#include <windows.h>
+#include <GL/gl.h>
+#include <string>
+#include "Extensions.h"
+
+//-----------------------------------------------------------------------------
+
+/**
+ * The overlay draws the stereo indicator (a small square in the bottom left
+ * corner, blue in the left eye and red in the right) and an optional text
+ * HUD (in the top left corner) over the presented image. The geometry lives
+ * in a vertex buffer which is only rewritten when the contents change, and
+ * the text is drawn from a small glyph atlas, so each eye costs one draw.
+ */
+class Overlay {
+public:
+    /// Constructor
+    Overlay();
+
+    /// Destructor
+    virtual ~Overlay();
+
+    /// Create the GL resources (a GL context must be current)
+    bool create( Extensions & glx );
+
+    /// Free the GL resources (a GL context must be current)
+    void destroy();
+
+    /// Returns true if the overlay was created successfully
+    bool isValid() const { return m_program != 0; }
+
+    /// Set the contents: the size of the stereo indicator in pixels (0 for
+    /// none) and the HUD text (lines separated by newlines, may be empty);
+    /// the vertex buffer is only rewritten if the contents have changed
+    void update( unsigned indicatorSize, const std::string & text );
+
+    /// Draw into the back left and back right buffers of a window of the
+    /// given size (a single draw call each)
+    void draw( unsigned width, unsigned height );
+
+private:
+    /// Compile a shader of the specified type, returns 0 on failure
+    GLuint compile( GLenum type, const char *source );
+
+    Extensions *m_glx;          ///< OpenGL extension functions
+
+    GLuint m_program;           ///< shader program
+    GLuint m_vertexArray;       ///< vertex array object
+    GLuint m_vertexBuffer;      ///< vertex buffer holding the quads
+    GLuint m_atlas;             ///< glyph atlas texture
+    GLint  m_viewport;          ///< location of the viewport size uniform
+    GLint  m_indicator;         ///< location of the indicator colour uniform
+    GLsizei m_vertexCount;      ///< number of vertices in the buffer
+
+    unsigned m_indicatorSize;   ///< indicator size in the buffer
+    std::string m_text;         ///< HUD text in the buffer
+};
+
+//-----------------------------------------------------------------------------
+
+#endif//hive_Overlay_h
@@ -0,0 +1,264 @@
+#include "PathProbe.h"
+#include <vector>
+#include "Clock.h"
+#include "DebugUtil.h"
+#include "Extensions.h"
+#include "GLWindow.h"
+#include "Log.h"
+#include "PresentPipeline.h"
+
+using namespace hive;
+using namespace std;
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+namespace {
+
+/// frames timed for each candidate (after one more to warm up)
+const unsigned FRAMES = 8;
+
+/// Returns the name of a path, for the log
+const char *pathName( PathProbe::Path path )
+{
+    switch ( path ) {
+        case PathProbe::PATH_RENDERBUFFER_BLIT: return "renderbuffer blit";
+        case PathProbe::PATH_TEXTURE_BLIT:      return "texture blit";
+        case PathProbe::PATH_TEXTURE_QUAD:      return "texture quad";
+        default:                                return "none";
+    }
+}
+
+/// Returns the mean time (milliseconds) to lock a shared surface, copy it
+/// into the destination framebuffer along a path, and unlock it; or a
+/// negative time if the path does not work
+double timePath(
+    Extensions & glx,
+    HANDLE interop,
+    IDirect3DDevice9 *device,
+    IDirect3DSurface9 *surface,
+    HANDLE shareHandle,
+    PathProbe::Path path,
+    GLuint destination,
+    PresentPipeline & present,
+    unsigned width,
+    unsigned height
+) {
+    const bool texture = ( path != PathProbe::PATH_RENDERBUFFER_BLIT );
+    GLuint name = 0, source = 0;
+    if ( texture )
+        glGenTextures( 1, &name );
+    else
+        glx.glGenRenderbuffers( 1, &name );
+
+    // share the surface as the real targets are (see registerTarget)
+    if ( glx.wglDXSetResourceShareHandleNV != 0 )
+        glx.wglDXSetResourceShareHandleNV( surface, shareHandle );
+    HANDLE object = glx.wglDXRegisterObjectNV(
+        interop, surface, name,
+        texture ? GL_TEXTURE_2D : GL_RENDERBUFFER,
+        WGL_ACCESS_READ_ONLY_NV
+    );
+    bool success = ( name != 0 ) && ( object != 0 );
+
+    // blits read from a framebuffer, attached while the object is locked
+    if ( success && (path != PathProbe::PATH_TEXTURE_QUAD) ) {
+        glx.glGenFramebuffers( 1, &source );
+        glx.glBindFramebuffer( GL_FRAMEBUFFER, source );
+        success = ( glx.wglDXLockObjectsNV( interop, 1, &object ) == GL_TRUE );
+        if ( success ) {
+            if ( texture )
+                glx.glFramebufferTexture2D(
+                    GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, name, 0 );
+            else
+                glx.glFramebufferRenderbuffer(
+                    GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, name );
+            success = ( glx.glCheckFramebufferStatus( GL_FRAMEBUFFER ) ==
+                GL_FRAMEBUFFER_COMPLETE );
+            glx.wglDXUnlockObjectsNV( interop, 1, &object );
+        }
+        glx.glBindFramebuffer( GL_FRAMEBUFFER, 0 );
+    }
+
+    // each frame is filled by DX (in a different colour, so that nothing
+    // can be skipped), then locked, copied and unlocked by GL, and finished
+    double total = 0;
+    for (unsigned i=0; success && (i <= FRAMES); ++i) {
+        device->ColorFill( surface, 0, D3DCOLOR_XRGB( 28 * i, 255 - 28 * i, 128 ) );
+
+        const double start = Clock::milliseconds();
+        if ( glx.wglDXLockObjectsNV( interop, 1, &object ) != GL_TRUE ) {
+            success = false;
+            break;
+        }
+        if ( path == PathProbe::PATH_TEXTURE_QUAD ) {
+            glx.glBindFramebuffer( GL_FRAMEBUFFER, destination );
+            present.begin();
+            present.draw( name );
+            present.end();
+        } else {
+            glx.glBindFramebuffer( GL_READ_FRAMEBUFFER, source );
+            glx.glBindFramebuffer( GL_DRAW_FRAMEBUFFER, destination );
+            glx.glBlitFramebuffer(
+                0, 0, width, height, 0, 0, width, height,
+                GL_COLOR_BUFFER_BIT, GL_NEAREST
+            );
+        }
+        glx.wglDXUnlockObjectsNV( interop, 1, &object );
+        glFinish();
+
+        if ( i > 0 ) total += Clock::milliseconds() - start;
+    }
+    glx.glBindFramebuffer( GL_FRAMEBUFFER, 0 );
+
+    if ( object != 0 ) glx.wglDXUnregisterObjectNV( interop, object );
+    if ( source != 0 ) glx.glDeleteFramebuffers( 1, &source );
+    if ( name != 0 ) {
+        if ( texture )
+            glDeleteTextures( 1, &name );
+        else
+            glx.glDeleteRenderbuffers( 1, &name );
+    }
+
+    return success ? ( total / FRAMES ) : -1.0;
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+
+void PathProbe::run(
+    IDirect3DDevice9 *device,
+    unsigned width,
+    unsigned height,
+    D3DFORMAT displayFormat,
+    bool quadOnly,
+    ProbeCache::Result & result
+) {
+    result.format = 0;
+    result.path   = PATH_NONE;
+    if ( (device == 0) || (width == 0) || (height == 0) ) return;
+
+    // the candidate formats: the display format (which the targets use
+    // otherwise), and both 32-bit RGB formats
+    vector<D3DFORMAT> formats( 1, displayFormat );
+    if ( displayFormat != D3DFMT_X8R8G8B8 ) formats.push_back( D3DFMT_X8R8G8B8 );
+    if ( displayFormat != D3DFMT_A8R8G8B8 ) formats.push_back( D3DFMT_A8R8G8B8 );
+
+    vector<Path> paths;
+    if ( !quadOnly ) {
+        paths.push_back( PATH_RENDERBUFFER_BLIT );
+        paths.push_back( PATH_TEXTURE_BLIT );
+    }
+    paths.push_back( PATH_TEXTURE_QUAD );
+
+    // the temporary window's context is current once it is created
+    GLWindow window;
+    if ( !window.create( 0, L"", 0, 0, 0, 8, 8, 0, 0, DefWindowProc, 0 ) ) {
+        Log::print( "warning: failed to create GL window for the path probe\n" );
+        return;
+    }
+
+    Extensions glx;
+    HANDLE interop = 0;
+    if ( !glx.load() )
+        Log::print( "warning: failed to load GL extensions for the path probe\n" );
+    else if ( (interop = glx.wglDXOpenDeviceNV( device )) == 0 )
+        Log::print( "warning: failed to open GL/DX interop for the path probe\n" );
+    else {
+        // the destination is a framebuffer the size of a frame
+        GLuint colour = 0, destination = 0;
+        glGenTextures( 1, &colour );
+        glBindTexture( GL_TEXTURE_2D, colour );
+        glTexImage2D(
+            GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0,
+            GL_RGBA, GL_UNSIGNED_BYTE, 0
+        );
+        glBindTexture( GL_TEXTURE_2D, 0 );
+        glx.glGenFramebuffers( 1, &destination );
+        glx.glBindFramebuffer( GL_FRAMEBUFFER, destination );
+        glx.glFramebufferTexture2D(
+            GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, colour, 0 );
+        glx.glBindFramebuffer( GL_FRAMEBUFFER, 0 );
+        glViewport( 0, 0, width, height );
+
+        PresentPipeline present;
+        present.create( glx, GL_TEXTURE_2D, 0 );
+
+        double fastest = 0;
+        for (unsigned f=0; f<formats.size(); ++f) {
+            IDirect3DSurface9 *surface = 0;
+            HANDLE shareHandle = NULL;
+            if ( device->CreateRenderTarget(
+                width, height, formats[f], D3DMULTISAMPLE_NONE, 0, FALSE,
+                &surface, &shareHandle
+            ) != D3D_OK ) {
+                if (Log::info())
+                    Log::print( "path probe: cannot create " )
+                        << D3DFORMATtoString( formats[f] ) << " target\n";
+                continue;
+            }
+
+            for (unsigned p=0; p<paths.size(); ++p) {
+                if ( (paths[p] == PATH_TEXTURE_QUAD) && !present.isValid() ) continue;
+
+                const double time = timePath(
+                    glx, interop, device, surface, shareHandle, paths[p],
+                    destination, present, width, height
+                );
+                if ( (time < 0) && Log::info() )
+                    Log::print( "path probe: " ) << D3DFORMATtoString( formats[f] )
+                        << ' ' << pathName( paths[p] ) << " failed\n";
+                else if (Log::info())
+                    Log::print( "path probe: " ) << D3DFORMATtoString( formats[f] )
+                        << ' ' << pathName( paths[p] ) << " = " << time << " ms\n";
+
+                if ( (time >= 0) && ((result.path == PATH_NONE) || (time < fastest)) ) {
+                    fastest = time;
+                    result.format = formats[f];
+                    result.path   = paths[p];
+                }
+            }
+            surface->Release();
+        }
+
+        present.destroy();
+        glx.glDeleteFramebuffers( 1, &destination );
+        glDeleteTextures( 1, &colour );
+        glx.wglDXCloseDeviceNV( interop );
+    }
+
+    window.destroy();
+
+    if ( result.path != PATH_NONE )
+        Log::print( "path probe chose " ) << D3DFORMATtoString(
+            static_cast<D3DFORMAT>( result.format ) ) << ' '
+            << pathName( static_cast<Path>( result.path ) ) << endl;
+    else
+        Log::print( "warning: path probe found no working path\n" );
+}
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,73 @@
+#ifndef hive_PathProbe_h
+#define hive_PathProbe_h
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+#include <d3d9.h>
+#include "ProbeCache.h"
+
+//-----------------------------------------------------------------------------
+
+/**
+ * Times the ways a captured frame can get from a DX target into a GL
+ * framebuffer, to find the fastest on this adapter and driver: each
+ * candidate target format, shared as a GL texture or a renderbuffer, and
+ * copied by framebuffer blit or drawn by the present pipeline. Some
+ * combinations make the driver convert the image on every lock, which only
+ * shows in the time they take.
+ *
+ * The probe runs on the DX thread before the GL window exists, with a
+ * temporary GL context of its own, and takes a few frames per candidate;
+ * its result is kept in the probe cache with the rest of the GL probe.
+ */
+class PathProbe {
+public:
+    /// The ways of presenting a target (as stored in the probe cache)
+    enum Path {
+        PATH_NONE,              ///< not probed
+        PATH_RENDERBUFFER_BLIT, ///< shared as a renderbuffer, blitted
+        PATH_TEXTURE_BLIT,      ///< shared as a texture, blitted
+        PATH_TEXTURE_QUAD       ///< shared as a texture, drawn by the present pipeline
+    };
+
+    /// Time the candidates for single-sample targets of the given size, and
+    /// set the format and path of result to the fastest (0 and PATH_NONE if
+    /// none of them worked); quadOnly limits the candidates to the present
+    /// pipeline, when its reprojection or packing is needed
+    static void run(
+        IDirect3DDevice9 *device,
+        unsigned width,
+        unsigned height,
+        D3DFORMAT displayFormat,
+        bool quadOnly,
+        ProbeCache::Result & result
+    );
+};
+
+//-----------------------------------------------------------------------------
+
+#endif//hive_PathProbe_h
@@ -0,0 +1,567 @@
+#include "PresentPipeline.h"
+#include "Defines.h"
+#include "Log.h"
+#include <GL/glext.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace hive;
+using namespace std;
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+namespace {
+
+/// Vertex attribute location of the quad position
+const GLuint POSITION = 0;
+
+/// Texture units of the warp and blend grids (the images use units 0 and 1)
+const GLint WARP_UNIT = 2;
+const GLint BLEND_UNIT = 3;
+
+/// Largest calibration grid (points along each side)
+const unsigned MAX_GRID = 4096;
+
+/**
+ * Read a calibration grid from a text file: a "columns rows" line, then one
+ * line per point of channels values (a line with a single value fills every
+ * channel). Returns false, logging why, if the file is missing or short.
+ */
+bool readGrid(
+    const std::string & fileName,
+    unsigned channels,
+    unsigned & columns,
+    unsigned & rows,
+    std::vector<GLfloat> & values
+) {
+    std::ifstream input( fileName.c_str() );
+    if ( !input ) {
+        Log::print( "error: unable to open calibration file [" ) << fileName << "]\n";
+        return false;
+    }
+
+    std::string line;
+    columns = rows = 0;
+    if ( std::getline( input, line ) ) {
+        std::istringstream header( line );
+        header >> columns >> rows;
+    }
+    if ( (columns < 2) || (rows < 2) || (columns > MAX_GRID) || (rows > MAX_GRID) ) {
+        Log::print( "error: invalid calibration grid size in [" ) << fileName << "]\n";
+        return false;
+    }
+
+    const unsigned points = columns * rows;
+    values.assign( points * channels, 0.f );
+    unsigned point = 0;
+    while ( (point < points) && std::getline( input, line ) ) {
+        std::istringstream fields( line );
+        GLfloat value[4] = { 0.f, 0.f, 0.f, 0.f };
+        unsigned count = 0;
+        while ( (count < channels) && (fields >> value[count]) ) ++count;
+        if ( count == 0 ) continue;
+        for (unsigned c=0; c<channels; ++c)
+            values[point * channels + c] = value[ (count == 1) ? 0 : c ];
+        ++point;
+    }
+    if ( point < points ) {
+        Log::print( "error: calibration file [" ) << fileName << "] has "
+            << point << " of " << points << " points\n";
+        return false;
+    }
+    return true;
+}
+
+/// Create a (linearly filtered) float texture holding a calibration grid
+GLuint createGrid(
+    GLint internalFormat,
+    GLenum format,
+    unsigned columns,
+    unsigned rows,
+    const std::vector<GLfloat> & values
+) {
+    GLuint texture = 0;
+    glGenTextures( 1, &texture );
+    glBindTexture( GL_TEXTURE_2D, texture );
+    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR );
+    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR );
+    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE );
+    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE );
+    glPixelStorei( GL_UNPACK_ALIGNMENT, 4 );
+    glTexImage2D(
+        GL_TEXTURE_2D, 0, internalFormat, columns, rows, 0,
+        format, GL_FLOAT, &values[0]
+    );
+    glBindTexture( GL_TEXTURE_2D, 0 );
+    return texture;
+}
+
+/// Vertex shader: passes the position through for the fragment shader
+const char *vertexShader =
+    "in vec2 position;\n"
+    "out vec2 screen;\n"
+    "void main() {\n"
+    "    screen = position;\n"
+    "    gl_Position = vec4( position, 0.0, 1.0 );\n"
+    "}\n";
+
+/// Fragment shader: reprojects the screen position, flipping the image
+/// vertically (the Direct3D image is stored top row first), then samples the
+/// image (resolving multisampled images by averaging the samples of each
+/// texel); areas with no image data are drawn black. When packing, each
+/// fragment picks its eye (the right eye's image is on unit 1) and where
+/// it falls in that eye: side by side puts the left eye on the left, top
+/// and bottom puts it on top, and rows puts it on every other row starting
+/// from the top. Each image may be only part of its texture, as given by its
+/// region (offset and scale); when an image is scaled up, it can be
+/// sharpened with an unsharp mask over its four neighbouring texels (single
+/// sample images only). A projector warp first moves each fragment to the
+/// window position whose image it shows (before it picks its eye), and the
+/// edge blend then scales its colour; both are grids sampled between their
+/// points, whose first and last points lie on the edges of the window
+const char *fragmentShader =
+    "#if MULTISAMPLE\n"
+    "#define SAMPLER sampler2DMS\n"
+    "uniform int samples;\n"
+    "#else\n"
+    "#define SAMPLER sampler2D\n"
+    "#endif\n"
+    "uniform SAMPLER image;\n"
+    "uniform SAMPLER imageRight;\n"
+    "uniform mat3 reprojection;\n"
+    "uniform vec2 tanHalfFov;\n"
+    "uniform int rows;\n"
+    "uniform vec4 region[2];\n"
+    "uniform float sharpen;\n"
+    "uniform sampler2D warp;\n"
+    "uniform sampler2D blend;\n"
+    "uniform int warped;\n"
+    "uniform int blended;\n"
+    "uniform float blendGamma;\n"
+    "in vec2 screen;\n"
+    "out vec4 colour;\n"
+    "vec2 grid( sampler2D points ) {\n"
+    "    vec2 size = vec2( textureSize( points, 0 ) );\n"
+    "    return ( ( screen * 0.5 + 0.5 ) * ( size - 1.0 ) + 0.5 ) / size;\n"
+    "}\n"
+    "vec4 present( SAMPLER eye, vec2 position, vec4 part ) {\n"
+    // rotate the view ray and project it back onto the image plane
+    "    vec3 ray = reprojection * vec3( position * tanHalfFov, -1.0 );\n"
+    "    vec2 point = ( ray.xy / -ray.z ) / tanHalfFov;\n"
+    "    vec2 texCoord = vec2( point.x * 0.5 + 0.5, 0.5 - point.y * 0.5 );\n"
+    "    if ( (ray.z >= 0.0) || any( lessThan( texCoord, vec2( 0.0 ) ) ) ||\n"
+    "         any( greaterThan( texCoord, vec2( 1.0 ) ) ) )\n"
+    "        return vec4( 0.0, 0.0, 0.0, 1.0 );\n"
+    "    texCoord = part.xy + texCoord * part.zw;\n"
+    "#if MULTISAMPLE\n"
+    "    ivec2 size = textureSize( eye );\n"
+    "    ivec2 texel = min( ivec2( texCoord * vec2( size ) ), size - 1 );\n"
+    "    vec4 sum = vec4( 0.0 );\n"
+    "    for (int i = 0; i < samples; ++i)\n"
+    "        sum += texelFetch( eye, texel, i );\n"
+    "    return sum / float( samples );\n"
+    "#else\n"
+    "    vec4 centre = texture( eye, texCoord );\n"
+    "    if ( sharpen <= 0.0 ) return centre;\n"
+    "    vec2 texel = 1.0 / vec2( textureSize( eye, 0 ) );\n"
+    "    vec4 around = texture( eye, texCoord + vec2( texel.x, 0.0 ) ) +\n"
+    "                  texture( eye, texCoord - vec2( texel.x, 0.0 ) ) +\n"
+    "                  texture( eye, texCoord + vec2( 0.0, texel.y ) ) +\n"
+    "                  texture( eye, texCoord - vec2( 0.0, texel.y ) );\n"
+    "    return clamp( centre + sharpen * ( centre - 0.25 * around ), 0.0, 1.0 );\n"
+    "#endif\n"
+    "}\n"
+    "void main() {\n"
+    "    vec2 at = screen;\n"
+    "    if ( warped != 0 ) at = texture( warp, grid( warp ) ).xy * 2.0 - 1.0;\n"
+    "#if PACKING == 1\n"
+    "    if ( at.x < 0.0 )\n"
+    "        colour = present( image, vec2( at.x * 2.0 + 1.0, at.y ), region[0] );\n"
+    "    else\n"
+    "        colour = present( imageRight, vec2( at.x * 2.0 - 1.0, at.y ), region[1] );\n"
+    "#elif PACKING == 2\n"
+    "    if ( at.y >= 0.0 )\n"
+    "        colour = present( image, vec2( at.x, at.y * 2.0 - 1.0 ), region[0] );\n"
+    "    else\n"
+    "        colour = present( imageRight, vec2( at.x, at.y * 2.0 + 1.0 ), region[1] );\n"
+    "#elif PACKING == 3\n"
+    "    if ( (rows - 1 - int( gl_FragCoord.y )) % 2 == 0 )\n"
+    "        colour = present( image, at, region[0] );\n"
+    "    else\n"
+    "        colour = present( imageRight, at, region[1] );\n"
+    "#else\n"
+    "    colour = present( image, at, region[0] );\n"
+    "#endif\n"
+    "    if ( blended != 0 )\n"
+    "        colour.rgb *= pow( texture( blend, grid( blend ) ).rgb, vec3( 1.0 / blendGamma ) );\n"
+    "}\n";
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+
+PresentPipeline::PresentPipeline() :
+    m_glx( 0 ),
+    m_textureTarget( GL_TEXTURE_2D ),
+    m_program( 0 ),
+    m_vertexArray( 0 ),
+    m_vertexBuffer( 0 ),
+    m_reprojection( -1 ),
+    m_tanHalfFov( -1 ),
+    m_rows( -1 ),
+    m_region( -1 ),
+    m_sharpen( -1 ),
+    m_warp( 0 ),
+    m_blend( 0 )
+{
+}
+
+//-----------------------------------------------------------------------------
+
+PresentPipeline::~PresentPipeline()
+{
+    // note: GL resources must be freed by calling destroy() while the
+    // context is still current
+}
+
+//-----------------------------------------------------------------------------
+
+bool PresentPipeline::create(
+    Extensions & glx,
+    GLenum textureTarget,
+    unsigned samples,
+    Settings::Packing packing
+) {
+    m_glx = &glx;
+    m_textureTarget = textureTarget;
+
+    if ( !glx.loadShaders() ) {
+        Log::print( "error: failed to load GL shader extensions\n" );
+        return false;
+    }
+
+    const bool multisample = ( textureTarget == GL_TEXTURE_2D_MULTISAMPLE );
+
+    // the multisample and packing preprocessor switches are prepended to the
+    // fragment shader
+    ostringstream fragmentSource;
+    fragmentSource << "#version 150\n#define MULTISAMPLE " << ( multisample ? 1 : 0 )
+        << "\n#define PACKING " << static_cast<int>( packing ) << "\n"
+        << fragmentShader;
+
+    string vertexSource( "#version 150\n" );
+    vertexSource += vertexShader;
+
+    GLuint vertex = compile( GL_VERTEX_SHADER, vertexSource.c_str() );
+    GLuint fragment = compile( GL_FRAGMENT_SHADER, fragmentSource.str().c_str() );
+
+    do {
+        if ( (vertex == 0) || (fragment == 0) ) break;
+
+        // link the program
+        m_program = glx.glCreateProgram();
+        glx.glAttachShader( m_program, vertex );
+        glx.glAttachShader( m_program, fragment );
+        glx.glBindAttribLocation( m_program, POSITION, "position" );
+        glx.glLinkProgram( m_program );
+
+        GLint linked = GL_FALSE;
+        glx.glGetProgramiv( m_program, GL_LINK_STATUS, &linked );
+        if ( linked != GL_TRUE ) {
+            GLint length = 0;
+            glx.glGetProgramiv( m_program, GL_INFO_LOG_LENGTH, &length );
+            vector<char> text( length + 1, 0 );
+            glx.glGetProgramInfoLog( m_program, length, 0, &text[0] );
+            Log::print( "error: failed to link present shader:\n" ) << &text[0] << endl;
+
+            glx.glDeleteProgram( m_program );
+            m_program = 0;
+            break;
+        }
+
+        // set the uniforms, which never change
+        glx.glUseProgram( m_program );
+        glx.glUniform1i( glx.glGetUniformLocation( m_program, "image" ), 0 );
+        glx.glUniform1i( glx.glGetUniformLocation( m_program, "imageRight" ), 1 );
+        glx.glUniform1i( glx.glGetUniformLocation( m_program, "warp" ), WARP_UNIT );
+        glx.glUniform1i( glx.glGetUniformLocation( m_program, "blend" ), BLEND_UNIT );
+        m_rows = glx.glGetUniformLocation( m_program, "rows" );
+
+        // each image fills its texture until its region is set (the array
+        // elements have consecutive locations), and is not sharpened
+        m_region = glx.glGetUniformLocation( m_program, "region" );
+        if ( m_region >= 0 ) {
+            glx.glUniform4f( m_region, 0.f, 0.f, 1.f, 1.f );
+            glx.glUniform4f( m_region + 1, 0.f, 0.f, 1.f, 1.f );
+        }
+        m_sharpen = glx.glGetUniformLocation( m_program, "sharpen" );
+        glx.glUniform1f( m_sharpen, 0.f );
+        if ( multisample ) {
+            glx.glUniform1i(
+                glx.glGetUniformLocation( m_program, "samples" ),
+                static_cast<GLint>( samples > 0 ? samples : 1 )
+            );
+        }
+
+        // no reprojection until it is set
+        static const GLfloat identity[9] = { 1.f,0.f,0.f, 0.f,1.f,0.f, 0.f,0.f,1.f };
+        m_reprojection = glx.glGetUniformLocation( m_program, "reprojection" );
+        m_tanHalfFov = glx.glGetUniformLocation( m_program, "tanHalfFov" );
+        glx.glUniformMatrix3fv( m_reprojection, 1, GL_FALSE, identity );
+        glx.glUniform2f( m_tanHalfFov, 1.f, 1.f );
+        glx.glUseProgram( 0 );
+
+        // full screen quad, drawn as a triangle strip
+        static const GLfloat quad[] = {
+            -1.0f, -1.0f,
+            +1.0f, -1.0f,
+            -1.0f, +1.0f,
+            +1.0f, +1.0f
+        };
+
+        glx.glGenVertexArrays( 1, &m_vertexArray );
+        glx.glBindVertexArray( m_vertexArray );
+
+        glx.glGenBuffers( 1, &m_vertexBuffer );
+        glx.glBindBuffer( GL_ARRAY_BUFFER, m_vertexBuffer );
+        glx.glBufferData( GL_ARRAY_BUFFER, sizeof(quad), quad, GL_STATIC_DRAW );
+
+        glx.glVertexAttribPointer( POSITION, 2, GL_FLOAT, GL_FALSE, 0, 0 );
+        glx.glEnableVertexAttribArray( POSITION );
+
+        glx.glBindVertexArray( 0 );
+        glx.glBindBuffer( GL_ARRAY_BUFFER, 0 );
+    } while (false_value);
+
+    // the shaders are no longer needed once linked
+    if ( vertex != 0 ) glx.glDeleteShader( vertex );
+    if ( fragment != 0 ) glx.glDeleteShader( fragment );
+
+    if (Log::info() && isValid())
+        Log::print( "created GL present pipeline\n" );
+
+    return isValid();
+}
+
+//-----------------------------------------------------------------------------
+
+bool PresentPipeline::loadCalibration(
+    const std::string & warpFile,
+    const std::string & blendFile,
+    float gamma
+) {
+    if ( !isValid() ) return false;
+    if ( warpFile.empty() && blendFile.empty() ) return true;
+
+    // read both files before touching the GL state, so that a bad file
+    // leaves the image uncalibrated rather than half calibrated
+    unsigned warpColumns = 0, warpRows = 0;
+    unsigned blendColumns = 0, blendRows = 0;
+    vector<GLfloat> warpPoints, blendPoints;
+    if ( !warpFile.empty() &&
+         !readGrid( warpFile, 2, warpColumns, warpRows, warpPoints ) ) return false;
+    if ( !blendFile.empty() &&
+         !readGrid( blendFile, 3, blendColumns, blendRows, blendPoints ) ) return false;
+
+    Extensions & glx = *m_glx;
+    if ( !warpPoints.empty() )
+        m_warp = createGrid( GL_RG32F, GL_RG, warpColumns, warpRows, warpPoints );
+    if ( !blendPoints.empty() )
+        m_blend = createGrid( GL_RGB32F, GL_RGB, blendColumns, blendRows, blendPoints );
+
+    glx.glUseProgram( m_program );
+    glx.glUniform1i( glx.glGetUniformLocation( m_program, "warped" ), (m_warp != 0) ? 1 : 0 );
+    glx.glUniform1i( glx.glGetUniformLocation( m_program, "blended" ), (m_blend != 0) ? 1 : 0 );
+    glx.glUniform1f(
+        glx.glGetUniformLocation( m_program, "blendGamma" ),
+        (gamma > 0.f) ? gamma : 1.f
+    );
+    glx.glUseProgram( 0 );
+
+    if (Log::info()) {
+        Log::print( "loaded projector calibration: warp " )
+            << warpColumns << 'x' << warpRows << ", blend "
+            << blendColumns << 'x' << blendRows << endl;
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void PresentPipeline::destroy()
+{
+    if ( m_glx == 0 ) return;
+
+    if ( m_warp != 0 ) {
+        glDeleteTextures( 1, &m_warp );
+        m_warp = 0;
+    }
+
+    if ( m_blend != 0 ) {
+        glDeleteTextures( 1, &m_blend );
+        m_blend = 0;
+    }
+
+    if ( m_vertexArray != 0 ) {
+        m_glx->glDeleteVertexArrays( 1, &m_vertexArray );
+        m_vertexArray = 0;
+    }
+
+    if ( m_vertexBuffer != 0 ) {
+        m_glx->glDeleteBuffers( 1, &m_vertexBuffer );
+        m_vertexBuffer = 0;
+    }
+
+    if ( m_program != 0 ) {
+        m_glx->glDeleteProgram( m_program );
+        m_program = 0;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void PresentPipeline::begin()
+{
+    m_glx->glUseProgram( m_program );
+    m_glx->glBindVertexArray( m_vertexArray );
+
+    // the calibration stays bound on its own units for every draw
+    if ( m_warp != 0 ) {
+        m_glx->glActiveTexture( GL_TEXTURE0 + WARP_UNIT );
+        glBindTexture( GL_TEXTURE_2D, m_warp );
+    }
+    if ( m_blend != 0 ) {
+        m_glx->glActiveTexture( GL_TEXTURE0 + BLEND_UNIT );
+        glBindTexture( GL_TEXTURE_2D, m_blend );
+    }
+    m_glx->glActiveTexture( GL_TEXTURE0 );
+}
+
+//-----------------------------------------------------------------------------
+
+void PresentPipeline::draw( GLuint texture )
+{
+    glBindTexture( m_textureTarget, texture );
+    glDrawArrays( GL_TRIANGLE_STRIP, 0, 4 );
+}
+
+//-----------------------------------------------------------------------------
+
+void PresentPipeline::drawPacked( GLuint left, GLuint right, unsigned height )
+{
+    m_glx->glUniform1i( m_rows, static_cast<GLint>( height ) );
+
+    m_glx->glActiveTexture( GL_TEXTURE1 );
+    glBindTexture( m_textureTarget, right );
+    m_glx->glActiveTexture( GL_TEXTURE0 );
+    glBindTexture( m_textureTarget, left );
+    glDrawArrays( GL_TRIANGLE_STRIP, 0, 4 );
+
+    m_glx->glActiveTexture( GL_TEXTURE1 );
+    glBindTexture( m_textureTarget, 0 );
+    m_glx->glActiveTexture( GL_TEXTURE0 );
+}
+
+//-----------------------------------------------------------------------------
+
+void PresentPipeline::setReprojection(
+    const GLfloat rotation[9],
+    float tanX,
+    float tanY
+) {
+    m_glx->glUniformMatrix3fv( m_reprojection, 1, GL_FALSE, rotation );
+    m_glx->glUniform2f( m_tanHalfFov, tanX, tanY );
+}
+
+//-----------------------------------------------------------------------------
+
+void PresentPipeline::setRegion(
+    unsigned image,
+    float x,
+    float y,
+    float width,
+    float height
+) {
+    if ( (image > 1) || (m_region < 0) ) return;
+    m_glx->glUniform4f( m_region + static_cast<GLint>( image ), x, y, width, height );
+}
+
+//-----------------------------------------------------------------------------
+
+void PresentPipeline::setSharpen( float amount )
+{
+    m_glx->glUniform1f( m_sharpen, amount );
+}
+
+//-----------------------------------------------------------------------------
+
+void PresentPipeline::end()
+{
+    if ( m_warp != 0 ) {
+        m_glx->glActiveTexture( GL_TEXTURE0 + WARP_UNIT );
+        glBindTexture( GL_TEXTURE_2D, 0 );
+    }
+    if ( m_blend != 0 ) {
+        m_glx->glActiveTexture( GL_TEXTURE0 + BLEND_UNIT );
+        glBindTexture( GL_TEXTURE_2D, 0 );
+    }
+    m_glx->glActiveTexture( GL_TEXTURE0 );
+
+    glBindTexture( m_textureTarget, 0 );
+    m_glx->glBindVertexArray( 0 );
+    m_glx->glUseProgram( 0 );
+}
+
+//-----------------------------------------------------------------------------
+
+GLuint PresentPipeline::compile( GLenum type, const char *source )
+{
+    GLuint shader = m_glx->glCreateShader( type );
+    if ( shader == 0 ) return 0;
+
+    m_glx->glShaderSource( shader, 1, &source, 0 );
+    m_glx->glCompileShader( shader );
+
+    GLint compiled = GL_FALSE;
+    m_glx->glGetShaderiv( shader, GL_COMPILE_STATUS, &compiled );
+    if ( compiled != GL_TRUE ) {
+        GLint length = 0;
+        m_glx->glGetShaderiv( shader, GL_INFO_LOG_LENGTH, &length );
+        vector<char> text( length + 1, 0 );
+        m_glx->glGetShaderInfoLog( shader, length, 0, &text[0] );
+        Log::print( "error: failed to compile present shader:\n" ) << &text[0] << endl;
+
+        m_glx->glDeleteShader( shader );
+        return 0;
+    }
+
+    return shader;
+}
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,147 @@
+#ifndef hive_PresentPipeline_h
+#define hive_PresentPipeline_h
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+#include <windows.h>
+#include <GL/gl.h>
+#include <string>
+#include "Extensions.h"
+#include "Settings.h"
+
+//-----------------------------------------------------------------------------
+
+/**
+ * The presentation pipeline draws a captured Direct3D image into the current
+ * OpenGL draw buffer: a static vertex buffer/array holding a full screen quad,
+ * and a small shader which flips the image vertically and samples it (from a
+ * multisampled texture if required). All state is created once, so each
+ * frame only needs to bind the program and draw.
+ *
+ * With a passive stereo packing, the shader instead combines both eyes into
+ * the one draw buffer in a single pass (drawPacked), for displays which take
+ * both eyes in an ordinary frame.
+ *
+ * For projectors, a warp (the image position shown at each point of a grid
+ * over the window) and an edge blend (the light each point should carry)
+ * can be loaded once at startup; they stay on the GPU, and are applied in
+ * the same draw which samples the image.
+ */
+class PresentPipeline {
+public:
+    /// Constructor
+    PresentPipeline();
+
+    /// Destructor
+    virtual ~PresentPipeline();
+
+    /// Create the GL resources (a GL context must be current), where
+    /// textureTarget is GL_TEXTURE_2D or GL_TEXTURE_2D_MULTISAMPLE
+    bool create(
+        Extensions & glx,
+        GLenum textureTarget,
+        unsigned samples,
+        Settings::Packing packing = Settings::PACKING_NONE
+    );
+
+    /**
+     * Load the projector calibration from text files, either of which may
+     * be empty (a GL context must be current, after create). Each file is
+     * a grid of points evenly spaced over the window, listed row by row
+     * from the bottom left after a "columns rows" line: the warp gives the
+     * image position (x y, 0..1 from the bottom left) shown at each point,
+     * and the blend its intensity (one value, or r g b, in linear light),
+     * which is converted to the display's gamma. Returns false (leaving
+     * the image uncalibrated) if a file cannot be loaded.
+     */
+    bool loadCalibration(
+        const std::string & warpFile,
+        const std::string & blendFile,
+        float gamma
+    );
+
+    /// Free the GL resources (a GL context must be current)
+    void destroy();
+
+    /// Returns true if the pipeline was created successfully
+    bool isValid() const { return m_program != 0; }
+
+    /// Bind the pipeline state, ready to draw one or more images
+    void begin();
+
+    /// Draw the texture over the whole viewport
+    void draw( GLuint texture );
+
+    /// Draw both eyes packed into the viewport, whose height is given (the
+    /// pipeline must have been created with a packing)
+    void drawPacked( GLuint left, GLuint right, unsigned height );
+
+    /**
+     * Set the reprojection applied by subsequent draws (between begin and
+     * end): the rotation (a column-major 3x3 matrix) takes view directions
+     * at present time to those at render time, for an eye with the given
+     * tangents of its half field of view. The identity draws the image as
+     * it is.
+     */
+    void setReprojection( const GLfloat rotation[9], float tanX, float tanY );
+
+    /// Set the part of its texture (in texture coordinates, from the top
+    /// left of the image) which holds the image drawn by subsequent draws:
+    /// image 0 is the left (or only) image, and image 1 the right image of
+    /// a packed draw
+    void setRegion( unsigned image, float x, float y, float width, float height );
+
+    /// Set how strongly subsequent draws sharpen the image (0 = not at all,
+    /// for images drawn at their own size); multisampled images are never
+    /// sharpened
+    void setSharpen( float amount );
+
+    /// Unbind the pipeline state
+    void end();
+
+private:
+    /// Compile a shader of the specified type, returns 0 on failure
+    GLuint compile( GLenum type, const char *source );
+
+    Extensions *m_glx;          ///< OpenGL extension functions
+
+    GLenum m_textureTarget;     ///< texture target of the images
+    GLuint m_program;           ///< shader program
+    GLuint m_vertexArray;       ///< vertex array object
+    GLuint m_vertexBuffer;      ///< vertex buffer holding the quad
+    GLint  m_reprojection;      ///< location of the reprojection uniform
+    GLint  m_tanHalfFov;        ///< location of the field of view uniform
+    GLint  m_rows;              ///< location of the viewport height uniform
+    GLint  m_region;            ///< location of the image region uniforms
+    GLint  m_sharpen;           ///< location of the sharpening uniform
+    GLuint m_warp;              ///< warp texture (or 0)
+    GLuint m_blend;             ///< blend texture (or 0)
+};
+
+//-----------------------------------------------------------------------------
+
+#endif//hive_PresentPipeline_h
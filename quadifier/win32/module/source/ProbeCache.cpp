@@ -0,0 +1,130 @@
+#include "ProbeCache.h"
+#include <windows.h>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include "Log.h"
+#include "Settings.h"
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+using namespace hive;
+
+//-----------------------------------------------------------------------------
+
+namespace {
+
+/// cached results, by adapter
+typedef std::map<std::string, ProbeCache::Result> Results;
+
+/// guards the cache (devices may be created on more than one thread)
+std::mutex    g_mutex;
+Results       g_results;    ///< results in memory
+bool          g_loaded = false; ///< has the cache file been read?
+
+/// Returns the path of the cache file (creating its directory), or ""
+std::string cachePath()
+{
+    char folder[MAX_PATH] = {};
+    DWORD length = GetEnvironmentVariableA( "LOCALAPPDATA", folder, MAX_PATH );
+    if ( (length == 0) || (length >= MAX_PATH) ) return "";
+
+    std::string path( folder );
+    path += "\\Quadifier";
+    CreateDirectoryA( path.c_str(), 0 );
+    return path + "\\probe.txt";
+}
+
+/// Read the cache file into g_results (call with g_mutex held)
+void load()
+{
+    if ( g_loaded ) return;
+    g_loaded = true;
+
+    if ( !Settings::get().probeCache ) return;
+    std::ifstream input( cachePath().c_str() );
+
+    // each line is "<adapter> <forced samples> <interop>", followed by
+    // "<format> <path>" once the present paths have been probed
+    std::string line;
+    while ( std::getline( input, line ) ) {
+        std::istringstream fields( line );
+        std::string adapter;
+        ProbeCache::Result result = {};
+        int interop = 0;
+        if ( fields >> adapter >> result.forcedSamples >> interop ) {
+            result.interop = ( interop != 0 );
+            if ( !(fields >> result.format >> result.path) ) {
+                result.format = 0;
+                result.path   = 0;
+            }
+            g_results[adapter] = result;
+        }
+    }
+}
+
+/// Write g_results to the cache file (call with g_mutex held)
+void save()
+{
+    if ( !Settings::get().probeCache ) return;
+    std::ofstream output( cachePath().c_str() );
+
+    for (Results::const_iterator i=g_results.begin(); i!=g_results.end(); ++i)
+        output << i->first << ' ' << i->second.forcedSamples << ' '
+               << ( i->second.interop ? 1 : 0 ) << ' '
+               << i->second.format << ' ' << i->second.path << '\n';
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+
+bool ProbeCache::find( const std::string & adapter, Result & result )
+{
+    std::lock_guard<std::mutex> lock( g_mutex );
+    load();
+
+    Results::const_iterator i = g_results.find( adapter );
+    if ( i == g_results.end() ) return false;
+
+    result = i->second;
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void ProbeCache::store( const std::string & adapter, const Result & result )
+{
+    std::lock_guard<std::mutex> lock( g_mutex );
+    load();
+
+    g_results[adapter] = result;
+    save();
+}
+
+//-----------------------------------------------------------------------------
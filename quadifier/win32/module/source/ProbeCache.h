@@ -0,0 +1,62 @@
+#ifndef hive_ProbeCache_h
+#define hive_ProbeCache_h
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+#include <string>
+
+//-----------------------------------------------------------------------------
+
+/**
+ * Caches the result of probing the OpenGL driver, which otherwise needs a
+ * throwaway GL window (pixel format and context) every time a device is
+ * created.
+ *
+ * Results are keyed by adapter and driver version, and are kept in memory
+ * for the life of the process and (unless the probeCache setting is off)
+ * in %LOCALAPPDATA%\Quadifier\probe.txt, one line per adapter.
+ */
+class ProbeCache {
+public:
+    /// The result of probing the GL driver
+    struct Result {
+        unsigned forcedSamples; ///< multisamples forced by the driver (or 0)
+        bool     interop;       ///< is WGL_NV_DX_interop available?
+        unsigned format;        ///< fastest target format (a D3DFORMAT, 0 = not probed)
+        unsigned path;          ///< fastest present path (a PathProbe::Path)
+    };
+
+    /// Look up the result for an adapter, returning false if not cached
+    static bool find( const std::string & adapter, Result & result );
+
+    /// Store the result for an adapter (in memory, and on disk if enabled)
+    static void store( const std::string & adapter, const Result & result );
+};
+
+//-----------------------------------------------------------------------------
+
+#endif//hive_ProbeCache_h
@@ -1,1232 +1,3407 @@
-#include <process.h>
-#include <time.h>
-#include <iomanip>
-#include <sstream>
-#include "Defines.h"
-#include "Quadifier.h"
-#include "Log.h"
-#include "Settings.h"
-#include "StereoUtil.h"
-#include "DebugUtil.h"
-#include "IDirect3DDevice9Proxy.h"
-#include <GL/glext.h>
-#include "WinMessage.h"
-
-using namespace hive;
-using namespace std;
-
-//-----------------------------------------------------------------------------
-//
-// Copyright (C) 2012-14 James Ward, University of Hull
-//
-// This software is provided 'as-is', without any express or implied
-// warranty. In no event will the authors be held liable for any damages
-// arising from the use of this software.
-//
-// Permission is granted to anyone to use this software for any purpose,
-// including commercial applications, and to alter it and redistribute it
-// freely, subject to the following restrictions:
-//
-//    1. The origin of this software must not be misrepresented; you must not
-//    claim that you wrote the original software.
-//
-//    2. If you use this software in a product, an acknowledgment in the
-//    product documentation is required.
-//
-//    3. Altered source versions must be plainly marked as such, and must not
-//    be misrepresented as being the original software.
-//
-//    4. This notice may not be removed or altered from any source
-//    distribution.
-//
-//-----------------------------------------------------------------------------
-
-/// user defined message indicating a new DX frame is available
-static const UINT WM_USER_NEWFRAME = (WM_USER + 1);
-
-//-----------------------------------------------------------------------------
-
-Quadifier::Quadifier(
-    IDirect3DDevice9 *device,
-    IDirect3D9 *direct3D
-) :
-    m_device( device ),
-    m_direct3D( direct3D )
-{
-    m_framesGL = 0;
-    m_framesDX = 0;
-
-    m_samplesDX = 0;
-    m_samplesGL = 0;
-
-    m_backBuffer = 0;
-    m_drawBuffer = 0;
-    m_readBuffer = 0;
-    // m_target implicit
-    m_stereoMode = false;
-    m_firstFrameTimeGL = 0.0;
-    m_lastFrameTimeGL = 0.0;
-    m_quadListGL = 0;
-    m_thread = 0;
-    m_sourceWindow = 0;
-    m_interopGLDX = 0;
-    // m_newFrame implict
-    // m_swapLock implict
-    m_width  = 0;
-    m_height = 0;
-    m_initialised = false;
-
-    // have we got stereo support?
-    m_stereoAvailable = isOpenGLStereoAvailable();
-
-    // set logging level
-    // note: a few log messages will already have been output at this point
-    Log::get().setLevel( Settings::get().logLevel );
-}
-
-//-----------------------------------------------------------------------------
-
-Quadifier::~Quadifier()
-{
-    if (Log::info())
-        Log::print( "~Quadifier\n" );
-
-    // clear all the render targets
-    for (unsigned i = 0; i < m_target.size(); ++i)
-        m_target[i].clear();
-
-    // release the backbuffer
-    if ( m_backBuffer != 0 ) {
-        m_backBuffer->Release();
-        m_backBuffer = 0;
-    }
-}
-
-//-----------------------------------------------------------------------------
-
-void Quadifier::onCreateDX()
-{
-}//onCreateDX
-
-//-----------------------------------------------------------------------------
-
-void Quadifier::onPreClearDX(
-    DWORD /*Count*/,
-    CONST D3DRECT* /*pRects*/,
-    DWORD /*Flags*/,
-    D3DCOLOR /*Color*/,
-    float /*Z*/,
-    DWORD /*Stencil*/
-) {
-    if (Log::verbose()) Log::print( "onPreClearDX\n" );
-
-    // is this the main display render target?
-    if ( !isPresentedRenderTarget() ) return;
-
-    if ( !m_initialised ) {
-        // the first time we are called, we will create the resources
-        // (render targets) - i.e. after the  parent window has been
-        // created at the correct size
-        createResources();
-    }
-
-    // start capturing DX drawing
-    beginCapture();
-}
-
-//-----------------------------------------------------------------------------
-
-void Quadifier::onPostClearDX()
-{
-}
-
-//-----------------------------------------------------------------------------
-
-void Quadifier::onPrePresentDX(
-    CONST RECT * /*pSourceRect*/,
-    CONST RECT * /*pDestRect*/,
-    HWND /*hDestWindowOverride*/,
-    CONST RGNDATA * /*pDirtyRegion*/
-) {
-    if (Log::verbose()) Log::print( "onPrePresentDX\n" );
-
-    // get the current render target
-    IDirect3DSurface9 *renderTarget = 0;
-    if ( m_device->GetRenderTarget( 0, &renderTarget ) == S_OK ) {
-        // release the render target (we are only storing its pointer as
-        // a hash for comparison purposes)
-        renderTarget->Release();
-
-        // insert the render target in the set of presented targets
-        // if not already present
-        m_presentedTargets.insert(
-            reinterpret_cast<unsigned>(renderTarget)
-        );
-
-        // verbose logging
-        if (Log::verbose())
-            Log::print() << "Presenting Render Target: " << renderTarget << endl;
-    }
-
-    // send frame to GL display thread
-    // if we are in stereo mode, this will be the right eye
-    // channel of a stereo pair, otherwise we are rendering 2D
-    endCapture( m_stereoMode ? GL_BACK_RIGHT : GL_BACK );
-
-    // signal that a new frame has been rendered
-    if (Log::verbose()) Log::print( "sending new frame notification\n" );
-    SendNotifyMessage( m_window.getHWND(), WM_USER_NEWFRAME, 0, 0 );
-}//onPrePresentDX
-
-//-----------------------------------------------------------------------------
-
-void Quadifier::onPostPresentDX()
-{
-    if (Log::verbose()) Log::print( "onPostPresentDX\n" );
-
-    // wait until the frame has been rendered out, to keep the OpenGL and
-    // Direct3D threads synchronised (after a timeout we return anyway)
-    m_frameDone.wait( 1000 );
-}//onPostPresentDX
-
-//-----------------------------------------------------------------------------
-
-bool Quadifier::onPreSetViewportDX( CONST D3DVIEWPORT9 *pViewport )
-{
-    if (pViewport == nullptr) return true;
-
-    // when we see SetViewport with a rectangle of (1,*,2,3) this is our
-    // signal from the Quadifier script that right eye rendering has started
-    if ( (pViewport->X      == 1) &&
-         (pViewport->Width  == 2) &&
-         (pViewport->Height == 3)
-    ) {
-        // call the handler to switch the stereo capture buffer
-        onStereoSignal();
-    }
-
-    // return true to pass on the SetViewport call to Direct3D
-    return true;
-}//onPreSetViewportDX
-
-//-----------------------------------------------------------------------------
-
-bool Quadifier::onCreate()
-{
-    if (Log::info()) {
-        // log some general information about the OpenGL renderer
-        Log::print( "GL Version : " ) << glGetString( GL_VERSION ) << endl;
-        Log::print( "GL Vendor  : " ) << glGetString( GL_VENDOR ) << endl;
-        Log::print( "GL Renderer: " ) << glGetString( GL_RENDERER ) << endl;
-    }
-
-    // query number of antialiasing samples
-    m_samplesGL = m_window.getSamples();
-    if (Log::info())
-        Log::print( "GL Samples : " ) << m_samplesGL << endl;
-
-    // output pixel format index
-    if (Log::info())
-        Log::print() << "OpenGL pixel format = " << m_window.getPixelFormat() << endl;
-
-    // query OpenGL texture size
-    {
-        GLint textureSize = 0;
-        glGetIntegerv( GL_MAX_TEXTURE_SIZE, &textureSize );
-        if (Log::info())
-            Log::print() << "OpenGL maximum texture size = " << textureSize << endl;
-    }
-
-    bool success = false;
-
-    // use textures or renderbuffers?
-    bool useTexture = Settings::get().useTexture;
-
-    if (!glx.load())
-        Log::print( "error: failed to load GL extensions\n" );
-    else do {
-        if (Log::info()) Log::print( "loaded GL extensions\n" );
-
-        if (Log::info()) Log::print( "creating GL/DX interop\n" );
-        m_interopGLDX = glx.wglDXOpenDeviceNV( m_device );
-
-        if ( m_interopGLDX == 0 ) {
-            Log::print( "error: failed to create GL/DX interop\n" );
-            break;
-        }
-
-        // select standard or multisampled GL texture mode
-        GLenum textureMode = ( m_samplesGL > 1 ) ?
-                GL_TEXTURE_2D_MULTISAMPLE : GL_TEXTURE_2D;
-
-        if (Log::info()) Log::print( "generating render buffers\n" );
-        unsigned i=0;
-        for (i=0; i<m_target.size(); ++i) {
-            // are we using textures or renderbuffers?
-            if ( useTexture ) {
-                // using GL_TEXTURE_2D
-                glGenTextures( 1, &m_target[i].texture );
-
-                if ( m_target[i].texture == 0 ) {
-                    Log::print( "error: failed to generate texture ID\n" );
-                    break;
-                }
-            } else {
-                // using GL_RENDERBUFFER
-                glx.glGenRenderbuffers( 1, &m_target[i].renderBuffer );
-
-                if ( m_target[i].renderBuffer == 0 ) {
-                    Log::print( "error: failed to generate render buffer ID\n" );
-                    break;
-                }
-            }
-
-            // JDW - register ShareHandle for ATI/AMD interoperability
-            if (Log::info())
-                Log::print("Setting SharedHandle ") << m_target[i].shareHandle << endl;;
-            if (glx.wglDXSetResourceShareHandleNV != 0) {
-                glx.wglDXSetResourceShareHandleNV(m_target[i].surface, m_target[i].shareHandle);
-            }
-            else {
-                Log::print("Failed to set SharedHandle: ") << m_target[i].shareHandle << endl;
-                break;
-            }
-
-            if (Log::info())
-                Log::print( "registering DX object " ) << i << endl;
-            m_target[i].object = glx.wglDXRegisterObjectNV(
-                m_interopGLDX,
-                m_target[i].surface,
-                useTexture ? m_target[i].texture : m_target[i].renderBuffer,
-                useTexture ? textureMode : GL_RENDERBUFFER,
-                WGL_ACCESS_READ_ONLY_NV
-            );
-
-            if ( m_target[i].object == 0 ) {
-                DWORD error = GetLastError();
-                Log::print( "error: wglDXRegisterObjectNV failed for render target: " )
-                    << formatErrorMessage(error);
-                break;
-            }
-
-            glx.glGenFramebuffers( 1, &m_target[i].frameBuffer );
-
-            if ( m_target[i].frameBuffer == 0 ) {
-                Log::print( "error: glGenFramebuffers failed\n" );
-                break;
-            }
-
-            glx.glBindFramebuffer( GL_FRAMEBUFFER, m_target[i].frameBuffer );
-            if (Log::info())
-                Log::print() << "glBindFramebuffer = " << getGLErrorString() << endl;
-
-            if ( useTexture ) {
-                // using GL_TEXTURE_2D
-
-                // important to lock before using glFramebufferTexture2D
-                if ( glx.wglDXLockObjectsNV(m_interopGLDX, 1, &m_target[i].object) == GL_TRUE ) {
-
-                    // attach colour buffer texture
-                    glx.glFramebufferTexture2D(
-                        GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
-                        textureMode, m_target[i].texture, 0
-                    );
-
-                    // unlock
-                    if (glx.wglDXUnlockObjectsNV(m_interopGLDX, 1, &m_target[i].object) != GL_TRUE ) {
-                        Log::print() << "Error: UnLockObjectsNV for texture " << i << " failed " << endl;
-                    }
-                } else {
-                    Log::print() << "Error: LockObjectsNV for texture " << i << " failed " << endl;
-                }
-            } else {
-                // using GL_RENDERBUFFER
-
-                // important to lock before using glFramebufferRenderbuffer
-                if ( glx.wglDXLockObjectsNV(m_interopGLDX, 1, &m_target[i].object) == GL_TRUE ) {
-                    // attach colour renderbuffer
-                    glx.glFramebufferRenderbuffer(
-                        GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
-                        GL_RENDERBUFFER, m_target[i].renderBuffer
-                    );
-
-                    // unlock
-                    if (glx.wglDXUnlockObjectsNV(m_interopGLDX, 1, &m_target[i].object) != GL_TRUE ) {
-                        Log::print() << "Error: UnLockObjectsNV for renderBuffer " << i << " failed " << endl;
-                    }
-                } else {
-                    Log::print() << "Error: LockObjectsNV for renderBuffer " << i << " failed " << endl;
-                }
-
-                glx.glBindRenderbuffer( GL_RENDERBUFFER, m_target[i].renderBuffer );
-
-                // if we are logging informational messages
-                if (Log::info()) {
-                    // this table defines the renderbuffer parameters to be listed
-                    struct {
-                        GLenum name;
-                        const char *text;
-                    } table[] = {
-                        { GL_RENDERBUFFER_WIDTH, "width" },
-                        { GL_RENDERBUFFER_HEIGHT, "height" },
-                        { GL_RENDERBUFFER_INTERNAL_FORMAT, "format" },
-                        { GL_RENDERBUFFER_RED_SIZE, "red" },
-                        { GL_RENDERBUFFER_GREEN_SIZE, "green" },
-                        { GL_RENDERBUFFER_BLUE_SIZE, "blue" },
-                        { GL_RENDERBUFFER_ALPHA_SIZE, "alpha" },
-                        { GL_RENDERBUFFER_DEPTH_SIZE, "depth" },
-                        { GL_RENDERBUFFER_STENCIL_SIZE, "stencil" },
-                        { 0, 0 }
-                    };
-
-                    // query and log all the renderbuffer parameters
-                    for (int p = 0; table[p].name != 0; ++p) {
-                        GLint value = 0;
-                        glx.glGetRenderbufferParameteriv( GL_RENDERBUFFER, table[p].name, &value );
-                        Log::print( "renderBuffer." ) << table[p].text << " = " << value << endl;
-                    }
-                }
-
-                glx.glBindRenderbuffer( GL_RENDERBUFFER, 0 );
-
-            }
-
-            // log the framebuffer status (should be GL_FRAMEBUFFER_COMPLETE)
-            GLenum status = glx.glCheckFramebufferStatus(GL_FRAMEBUFFER);
-            if ((status != GL_FRAMEBUFFER_COMPLETE) || Log::info()) {
-                Log::print() << "glCheckFramebufferStatus = " << GLFRAMEBUFFERSTATUStoString( status ) << endl;
-                if (status == GL_FRAMEBUFFER_INCOMPLETE_MISSING_ATTACHMENT) {
-                    // JDW added for clarification:
-                    Log::print() << "For ATI cards this may show GL_FRAMEBUFFER_INCOMPLETE_MISSING_ATTACHMENT but gets corrected later.\n";
-                }
-            }
-        }
-
-        // successful only if all render buffers were created and initialised
-        success = ( i == m_target.size() );
-    } while (false_value);
-
-    // default OpenGL settings
-    glEnable( GL_COLOR_MATERIAL );
-    glDisable( GL_LIGHTING );
-    glDisable( GL_DEPTH_TEST );
-
-    // default viewing system
-    glMatrixMode( GL_MODELVIEW );
-    glLoadIdentity();
-    glMatrixMode( GL_PROJECTION );
-    glLoadIdentity();
-
-    return success;
-}//onCreate
-
-//-----------------------------------------------------------------------------
-
-void Quadifier::onDestroy()
-{
-    // free OpenGL display list
-    if ( m_quadListGL != 0 ) {
-        glDeleteLists( m_quadListGL, 1 );
-        m_quadListGL = 0;
-    }
-
-    if (Log::info()) {
-        Log::print( "onDestroy\n" );
-
-        Log::print( "DX presented targets = " ) << m_presentedTargets.size() << endl;
-
-        Log::print( "GL frames = " ) << m_framesGL << endl;
-        Log::print( "DX frames = " ) << m_framesDX << endl;
-
-        // display a metric which indicates the ratio of DX to GL frames
-        // (in stereo mode this should tend towards 200)
-        if ( m_framesGL > 0 )
-            Log::print("DX/GL metric = ")
-                << 100 * m_framesDX / m_framesGL
-                << endl;
-
-        // display the final frame rate (number of GL frames per second)
-        double elapsed = m_lastFrameTimeGL - m_firstFrameTimeGL;
-        if ( elapsed > 0.01 )
-            Log::print("Frame rate = ")
-                << setprecision(2) << fixed
-                << static_cast<double>(m_framesGL-1) / elapsed << " fps"
-                << endl;
-    }
-}//onDestroy
-
-//-----------------------------------------------------------------------------
-
-void Quadifier::onPaint()
-{
-    // draw to default framebuffer
-    glx.glBindFramebuffer( GL_DRAW_FRAMEBUFFER, 0 );
-
-    // are we using textures?
-    const bool useTexture = Settings::get().useTexture;
-
-    // are we forced to use blit?
-    const bool mustUseBlit = !Settings::get().matchOriginalMSAA;
-
-    // save OpenGL state
-    glPushAttrib( GL_ENABLE_BIT | GL_CURRENT_BIT );
-
-    // enable texturing if required
-    if ( useTexture ) {
-        glEnable( GL_TEXTURE_2D );
-        glColor3f( 1, 1, 1 );
-    }
-
-    // for each eye
-    if (Log::verbose()) Log::print( "GL: rendering stereo frame\n" );
-    for (int eye=0; eye<2; ++eye) {
-        // get the GL draw buffer identifier for the last rendered frame
-        // (i.e. the DX surface we are reading from)
-        GLuint drawBuffer = m_target[m_readBuffer].drawBuffer;
-
-        // select the GL draw buffer (GL_BACK or GL_BACK_LEFT or GL_BACK_RIGHT)
-        if (Log::verbose()) {
-            stringstream text;
-            text << "GL: render " << m_readBuffer << " to "
-                 << GLDRAWBUFFERtoString(drawBuffer) << endl;
-            Log::print( text.str() );
-        }
-        glDrawBuffer( drawBuffer );
-
-        // lock the shared DX/GL render target
-        if ( (m_target[m_readBuffer].object != 0) && glx.wglDXLockObjectsNV(
-            m_interopGLDX, 1,
-            &m_target[m_readBuffer].object
-        ) == GL_TRUE) {
-
-            // are we rendering using textures or framebuffer blitting?
-            if ( !useTexture || mustUseBlit ) {
-                //-- render using framebuffer blitting        
-                glx.glBindFramebuffer( GL_READ_FRAMEBUFFER, m_target[m_readBuffer].frameBuffer );
-        
-                // blit from the read framebuffer to the display framebuffer
-                glx.glBlitFramebuffer(
-                    0, 0, m_width, m_height,        // source rectangle
-                    0, m_height, m_width, 0,        // destination: flip the image vertically
-                    GL_COLOR_BUFFER_BIT,
-                    GL_LINEAR
-                );
-
-            } else {
-                //-- render using texture
-
-                // bind the texture
-                glBindTexture( GL_TEXTURE_2D, m_target[m_readBuffer].texture );
-
-                // build our display list if it doesn't exist already
-                if ( m_quadListGL == 0 ) {
-                    // generate display list
-                    m_quadListGL = glGenLists( 1 );
-
-                    // draw a quad into the display list
-                    glNewList( m_quadListGL, GL_COMPILE );
-                        glBegin( GL_QUADS );
-                            glTexCoord2i( 0, 0 );
-                            glVertex3f( -1.0f, +1.0f, 0.0f );
-
-                            glTexCoord2i( 1, 0 );
-                            glVertex3f( +1.0f, +1.0f, 0.0f );
-
-                            glTexCoord2i( 1, 1 );
-                            glVertex3f( +1.0f, -1.0f, 0.0f );
-
-                            glTexCoord2i( 0, 1 );
-                            glVertex3f( -1.0f, -1.0f, 0.0f );
-                        glEnd();
-                    glEndList();
-                }
-
-                // draw a large textured quad
-                if ( m_quadListGL != 0 )
-                    glCallList( m_quadListGL );
-            }
-
-            // unlock the shared DX/GL target
-            glx.wglDXUnlockObjectsNV(
-                m_interopGLDX, 1,
-                &m_target[m_readBuffer].object
-            );
-        } else
-            Log::print( "unable to lock DX target on paint\n" );
-
-        // pick next read buffer
-        m_readBuffer = (m_readBuffer + 1) % m_target.size();
-
-        // we are only rendering stereo if we have just rendered the left eye,
-        // otherwise this must be a 2D frame and we can just exit the loop
-        if ( drawBuffer != GL_BACK_LEFT ) break;
-    }
-
-    // restore OpenGL state
-    glPopAttrib();
-
-    // draw the left/right stereo channel indicator
-    if ( Settings::get().stereoIndicator )
-        drawStereoIndicator();
-
-    // swap the buffers
-    m_window.swapBuffers();
-
-    // signal that we've processed one complete frame
-    m_frameDone.signal();
-
-    // in verbose mode, log the point at which GL swap occurs
-    if (Log::verbose()) Log::print( "GLSWAP\n" );
-
-    // performance statistics are collected in stereo mode
-    if ( m_stereoMode ) {
-        // record time-stamp of first/last frame
-        if ( m_framesGL == 0 )
-            m_firstFrameTimeGL = getTime();
-        else
-            m_lastFrameTimeGL = getTime();
-
-        // count GL frames
-        ++m_framesGL;
-    }
-}//onPaint
-
-//-----------------------------------------------------------------------------
-
-void Quadifier::onResize( UINT /*type*/, int w, int h )
-{
-    glViewport( 0, 0, w, h );
-    m_width  = w;
-    m_height = h;
-    redraw();
-}
-
-//-----------------------------------------------------------------------------
-
-void Quadifier::onStereoSignal()
-{
-    if (Log::verbose()) Log::print( "stereo signal\n" );
-
-    // enable stereo mode and print a message to the log
-    if ( !m_stereoMode ) {
-        m_stereoMode = true;
-        if ( Log::info() )
-            Log::print( "Stereo enabled" ) << endl;
-    }
-
-    // end capturing and send the left stereo frame
-    endCapture( GL_BACK_LEFT );
-
-    // begin capturing the right stereo frame
-    beginCapture();
-}
-
-void Quadifier::onIdle()
-{
-}
-
-//-----------------------------------------------------------------------------
-
-void Quadifier::redraw()
-{
-    // force an immediate paint
-    m_window.invalidate();
-    m_window.update();
-}
-
-//-----------------------------------------------------------------------------
-
-void Quadifier::drawStereoIndicator()
-{
-    const int size = 32;
-
-    GLint viewport[4] = {};
-    glGetIntegerv( GL_VIEWPORT, viewport );
-
-    // save OpenGL state
-    glPushAttrib( GL_ENABLE_BIT | GL_CURRENT_BIT | GL_TRANSFORM_BIT );
-
-        glMatrixMode( GL_PROJECTION );
-        glPushMatrix();
-        glLoadIdentity();
-        glOrtho(
-            0.0, static_cast<double>(viewport[2]),
-            0.0, static_cast<double>(viewport[3]),
-            -1.0, 1.0
-        );
-
-        glMatrixMode( GL_MODELVIEW );
-        glPushMatrix();
-        glLoadIdentity();
-
-        glEnable( GL_COLOR_MATERIAL );
-
-        glDrawBuffer( GL_BACK_LEFT );
-        glColor3f( 0.f, 0.f, 1.f );
-        glRecti( 0, 0, size, size );
-
-        glDrawBuffer( GL_BACK_RIGHT );
-        glColor3f( 1.f, 0.f, 0.f );
-        glRecti( 0, 0, size, size );
-
-        // restore modelview matrix
-        glPopMatrix();
-
-        // restore projection matrix
-        glMatrixMode( GL_PROJECTION );
-        glPopMatrix();
-
-    // restore OpenGL state
-    glPopAttrib();
-}//drawStereoIndicator
-
-//-----------------------------------------------------------------------------
-
-LRESULT CALLBACK Quadifier::windowProc(
-    HWND hWnd,      // handle to window
-    UINT uMsg,      // message identifier
-    WPARAM wParam,  // first message parameter
-    LPARAM lParam   // second message parameter
-) {
-    switch (uMsg) {
-    case WM_DESTROY:
-        onDestroy();
-        return 0L;
-
-    case WM_USER_NEWFRAME:
-        redraw();
-        return 0L;
-
-    case WM_PAINT:
-        {
-            PAINTSTRUCT paintStruct = {};
-            (void)BeginPaint( hWnd, &paintStruct );
-            onPaint();
-            EndPaint( hWnd, &paintStruct );
-        }
-        return 0L;
-
-    case WM_SIZE:
-        onResize( static_cast<UINT>(wParam), LOWORD(lParam), HIWORD(lParam) );
-        return 0L;
-
-    // forward all these messages to the source window
-    case WM_CLOSE:
-    case WM_CHAR:
-    case WM_KEYDOWN:
-    case WM_KEYUP:
-    case WM_MOUSEMOVE:
-    case WM_MOUSEWHEEL:
-    case WM_LBUTTONDOWN:
-    case WM_LBUTTONUP:
-    case WM_LBUTTONDBLCLK:
-    case WM_RBUTTONDOWN:
-    case WM_RBUTTONUP:
-    case WM_RBUTTONDBLCLK:
-    case WM_MBUTTONDOWN:
-    case WM_MBUTTONUP:
-    case WM_MBUTTONDBLCLK:
-        PostMessage( m_sourceWindow, uMsg, wParam, lParam );
-        return 0L;
-    }
-
-    return DefWindowProc( hWnd, uMsg, wParam, lParam );
-}//windowProc
-
-//-----------------------------------------------------------------------------
-
-LRESULT CALLBACK WindowProc(
-    HWND hWnd,      // handle to window
-    UINT uMsg,      // message identifier
-    WPARAM wParam,  // first message parameter
-    LPARAM lParam   // second message parameter
-) {
-    if (uMsg == WM_NCCREATE) {
-        // the WM_NCREATE is one of the first messages sent, and includes a
-        // pointer to the LPCREATESTRUCT. in this structure, we put our window
-        // class pointer at creation time. therefore we can retrieve it now,
-        // and store in GWL_USERDATA so that we can retrieve it later.
-
-        Quadifier *self = reinterpret_cast<Quadifier*>(
-            reinterpret_cast<LPCREATESTRUCT>(lParam)->lpCreateParams
-        );
-        if ( self != 0 ) {
-            SetWindowLongPtr(
-                hWnd,
-                GWLP_USERDATA,
-                reinterpret_cast<LONG_PTR>(self)
-            );
-        }
-    }
-
-    // attempt to get window pointer from GWL_USERDATA
-    Quadifier *self = reinterpret_cast<Quadifier*>(
-        GetWindowLongPtr( hWnd, GWLP_USERDATA )
-    );
-    
-    // pass message onto the window, or fall-back to default
-    if ( self != 0 )
-        return self->windowProc( hWnd, uMsg, wParam, lParam );
-    else
-        return DefWindowProc( hWnd, uMsg, wParam, lParam );
-}//WindowProc
-
-//-----------------------------------------------------------------------------
-
-LRESULT CALLBACK WindowProcSource(
-    HWND hWnd,      // handle to window
-    UINT uMsg,      // message identifier
-    WPARAM wParam,  // first message parameter
-    LPARAM lParam   // second message parameter
-) {
-    // get the old window proc pointer
-    WNDPROC oldWindowProc = reinterpret_cast<WNDPROC>(
-        GetWindowLongPtr( hWnd, GWLP_USERDATA )
-    );
-
-    //// log windows messages
-    //Log::print()
-    //    << "SRC " << windowsMessageToString( uMsg )
-    //    << ',' << hex << wParam << ',' << lParam << dec << endl;
-
-    switch (uMsg) {
-    case WM_ERASEBKGND:
-        // Ignore the WM_ERASEBKGND message
-        return TRUE;
-    }
-
-    // call the original window proc
-    return CallWindowProc( oldWindowProc, hWnd, uMsg, wParam, lParam );
-}//WindowProcSource
-
-//-----------------------------------------------------------------------------
-
-unsigned __stdcall Quadifier::threadFunc( void *context )
-{
-    if (Log::info()) Log::print( "GL rendering thread started\n" );
-
-    Quadifier *self = reinterpret_cast<Quadifier*>( context );
-
-    if ( self == 0 ) {
-        _endthreadex( 0 );
-        return 0;
-    }
-
-    // Get the old window proc of the source window
-    LONG_PTR oldWindowProc = GetWindowLongPtr( self->m_sourceWindow, GWLP_WNDPROC );
-
-    // Store the oldWindowProc pointer in user data on the source window
-    // (this pointer is later used to call the original window proc)
-    SetWindowLongPtr( self->m_sourceWindow, GWLP_USERDATA, oldWindowProc );
-
-    // Change the source window proc to point to our own WindowProcSource
-    // function. This allows us to subclass the window in the source
-    // application and intercept its messages.
-    SetWindowLongPtr(
-        self->m_sourceWindow, GWLP_WNDPROC,
-        reinterpret_cast<LONG_PTR>(WindowProcSource)
-    );
-
-    // output GL window style
-    DWORD dwStyle = WS_CLIPCHILDREN | WS_CLIPSIBLINGS | WS_CHILD;
-
-    // output GL window extended style
-    DWORD dwExStyle = 0;
-
-    // copy window rect from source window, so that the new window is
-    // positioned directly on top of the original window
-    RECT rect = {};
-    GetClientRect( self->m_sourceWindow, &rect );
-
-    // window creation attributes
-    GLWindow::Attributes attributes;
-
-    // if stereo is supported
-    if ( self->m_stereoAvailable ) {
-        // enable stereo
-        attributes[WGL_STEREO_ARB] = GL_TRUE;
-    }
-
-    // set depth and stencil attributes
-    attributes[WGL_DEPTH_BITS_ARB] = 0;
-    attributes[WGL_STENCIL_BITS_ARB] = 0;
-
-    // number of desired anti-alias samples to match DirectX
-    unsigned desiredSamples = self->m_samplesDX;
-
-    // do we want to match original number of multisamples used in DirectX?
-    // if not, set it to zero
-    if ( Settings::get().matchOriginalMSAA ) {
-        if (Log::info())
-            Log::print()
-                << "matchOriginalMSAA is ENABLED\n"
-                << "GL will attempt to use the same multisample format as DX\n";
-    } else {
-        if (Log::info())
-            Log::print()
-                << "matchOriginalMSAA is DISABLED\n"
-                << "GL is not forced to use the sample multisample format as DX\n";
-
-        desiredSamples = 0;
-    }
-
-    // optional: request the same number of multisamples as DirectX
-    if ( desiredSamples > 0 ) {
-        attributes[WGL_SAMPLE_BUFFERS_ARB] = GL_TRUE;
-        attributes[WGL_SAMPLES_ARB] = desiredSamples;
-    }
-
-    // create our OpenGL window
-    if ( !self->m_window.create(
-        dwExStyle,
-        L"Quadifier",
-        dwStyle,
-        0, 0,
-        rect.right - rect.left,
-        rect.bottom - rect.top,
-        self->m_sourceWindow,
-        0,
-        WindowProc,
-        self,
-        attributes
-    ) ) {
-        Log::print( "error: failed to create OpenGL window\n" );
-        _endthreadex( 0 );
-        return 0;
-    }
-
-    // did we get the requested number of anti-alias samples?
-    if ( self->m_window.getSamples() != desiredSamples ) {
-        // warn the user in this case: this can result in failure when
-        // the anti-aliasing in DirectX is higher than the GL context
-        Log::print( "warning: unable to create OpenGL window with " )
-            << desiredSamples << "x anti-alias samples\n"
-            << "This may cause wglDXRegisterObjectNV to fail.\n"
-            << "Please check if anti-aliasing is forced off in the driver settings.\n";
-    }
-
-    // call onCreate to carry out OpenGL setup
-    if ( self->onCreate() ) {
-        // show window without activating it
-        self->m_window.show( SW_SHOWNA );
-
-        MSG message;
-
-        do {
-            if ( PeekMessage( &message, NULL, 0, 0, PM_REMOVE ) ) {
-                TranslateMessage( &message );
-                DispatchMessage( &message );
-            } else {
-                // no message waiting: idle
-                self->onIdle();
-            }
-        } while ( message.message != WM_QUIT );
-
-        if (Log::info()) Log::print( "WM_QUIT\n" );
-    } else {
-        Log::print( "Failed when initialising OpenGL resources: exiting\n" );
-        PostMessage( self->m_sourceWindow, WM_QUIT, 0, 0 );
-    }
-
-    _endthreadex( 0 );
-
-    return 0;
-}//ThreadFunc
-
-//-----------------------------------------------------------------------------
-
-double Quadifier::getTime() const {
-    return static_cast<double>( clock() ) / static_cast<double>( CLOCKS_PER_SEC );
-}
-
-//-----------------------------------------------------------------------------
-
-void Quadifier::beginCapture() {
-    if (Log::verbose()) Log::print( "beginCapture\n" );
-
-    // save the current viewport
-    D3DVIEWPORT9 viewport = {};
-    bool savedViewport = (m_device->GetViewport( &viewport ) == D3D_OK);
-
-    // display render target parameters
-    if (Log::verbose()) {
-        stringstream text;
-        text << "SetRenderTarget("
-            << 0 << ','
-            << m_target[m_drawBuffer].surface << ") "
-            << "(drawBuffer==" << m_drawBuffer << ")\n";
-        Log::print( text.str() );
-    }
-
-    // set the render target to the surface
-    // any subsequent drawing (by the Direct3D application) will be rendered
-    // into this surface
-    // note: setting a new render target causes the viewport to be set to the
-    // full size of the new render target
-    if (m_device->SetRenderTarget( 0, m_target[m_drawBuffer].surface ) != D3D_OK) {
-        Log::print( "Error Setting Render Target\n " );
-        exit( 1 );
-    }
-
-    // restore the viewport
-    if (savedViewport)
-        m_device->SetViewport( &viewport );
-}//beginCapture
-
-//-----------------------------------------------------------------------------
-
-void Quadifier::endCapture( GLuint drawBuffer ) {
-    if (Log::verbose()) {
-        std::stringstream text;
-        text << "endCapture " << m_drawBuffer << " to " << GLDRAWBUFFERtoString( drawBuffer ) << endl;
-        Log::print( text.str() );
-    }
-
-    // set the OpenGL draw buffer destination
-    // the application has already rendered into this buffer, and here we are
-    // just labelling the buffer with left/right/back as appropriate
-    m_target[m_drawBuffer].drawBuffer = drawBuffer;
-
-    // select next draw buffer
-    m_drawBuffer = (m_drawBuffer + 1) % m_target.size();
-
-    // count DX frames
-    if ( m_stereoMode ) ++m_framesDX;
-}//endCapture
-
-//-----------------------------------------------------------------------------
-
-bool Quadifier::isPresentedRenderTarget() const
-{
-    // ensure that we have a device
-    if ( m_device == 0 ) return false;
-
-    // receives a pointer to the render target (surface)
-    IDirect3DSurface9 *renderTarget = 0;
-
-    // receives hash generated from render target pointer
-    unsigned hash = 0;
-
-    // get the current render target
-    if ( m_device->GetRenderTarget( 0, &renderTarget ) == S_OK ) {
-        // if verbose logging is enabled
-        if ( Log::verbose() ) {
-            // render target description
-            D3DSURFACE_DESC desc = {};
-
-            // get the render target description
-            if ( renderTarget->GetDesc( &desc ) == S_OK ) {
-                // display render target details
-                Log::print() << "Render target: " <<
-                    renderTarget << ',' <<
-                    D3DFORMATtoString( desc.Format ) << ',' <<
-                    desc.Width << 'x' << desc.Height << endl;
-            }
-        }
-
-        // use the renderTarget pointer as a simple hash
-        hash = reinterpret_cast<unsigned>( renderTarget );
-
-        // release render target
-        renderTarget->Release();
-    }
-
-    // has this render target been presented?
-    return ( m_presentedTargets.find(hash) != m_presentedTargets.end() );
-}//isPresentedRenderTarget
-
-//-----------------------------------------------------------------------------
-
-void Quadifier::createResources()
-{
-    // in case the graphics driver settings are forcing multisampling (e.g. the
-    // NVIDIA drivers are set to "override any application setting"), this
-    // code attempts to query how many multisamples are in use
-    int forcedSamples = 0;
-    {
-        // create a temporary OpenGL window with default pixel format
-        GLWindow window;
-        if ( window.create( 0, L"", 0, 0, 0, 8, 8, 0, 0, WindowProc, 0 ) ) {
-            // query the number of samples from OpenGL
-            forcedSamples = window.getSamples();
-            window.destroy();
-        }
-        if (Log::info())
-            Log::print( "OpenGL forced AA samples = " ) << forcedSamples << endl;
-    }
-
-    // convert number of samples to the Direct3D multisample type
-    D3DMULTISAMPLE_TYPE forcedSamplesDX = D3DMULTISAMPLE_NONE;
-    if ( forcedSamples > 1 ) {
-        if ( forcedSamples > 16 ) forcedSamples = 16;
-        forcedSamplesDX = static_cast<D3DMULTISAMPLE_TYPE>( forcedSamples );
-    }
-
-    if (Log::info())
-        Log::print( "Create DX render targets\n" );
-
-    if ( m_target[0].surface != 0 ) return;
-
-    // store the window handle of the original source window (the window
-    // in the parent Direct3D application)
-    D3DDEVICE_CREATION_PARAMETERS parameters = {};
-    m_device->GetCreationParameters( &parameters );
-    m_sourceWindow = parameters.hFocusWindow;
-    
-    // get the adapter display mode
-    D3DDISPLAYMODE displayMode = {};
-    if ( m_direct3D->GetAdapterDisplayMode( D3DADAPTER_DEFAULT, &displayMode ) != S_OK ) {
-        Log::print( "error: failed to get adapter display mode (using default)\n" );
-        // fallback code
-        displayMode.Format = D3DFMT_X8R8G8B8;
-    }
-
-    // assume no multisampling initially
-    D3DSURFACE_DESC desc = {};
-    desc.MultiSampleType = D3DMULTISAMPLE_NONE;
-
-    // attempt to retrieve the multisample type from the render target
-    IDirect3DSurface9 *renderTarget = 0;
-    if ( m_device->GetRenderTarget( 0, &renderTarget ) == S_OK ) {
-        // get the render target description
-        if ( renderTarget->GetDesc( &desc ) == S_OK ) {
-            // store viewport width and height
-            m_width  = desc.Width;
-            m_height = desc.Height;
-
-            Log::print( "DX render target surface format: " ) <<
-                D3DFORMATtoString( desc.Format ) << endl;
-        } else {
-            // failure: ensure the sample type is initialised to none
-            desc.MultiSampleType = D3DMULTISAMPLE_NONE;
-            Log::print( "error: failed to get render target description\n" );
-
-            // fall back to GetViewport to get viewport dimensions
-            D3DVIEWPORT9 viewport = {};
-            m_device->GetViewport( &viewport );
-
-            // store viewport width and height
-            m_width  = viewport.Width;
-            m_height = viewport.Height;
-        }
-
-        // release render target
-        renderTarget->Release();
-    } else {
-        Log::print( "error: failed to get render target\n" );
-    }
-
-    if (Log::info()) {
-        Log::print() << "DX viewport = "
-            << m_width << 'x' << m_height << endl;
-    }
-
-    // multisampling level to use
-    D3DMULTISAMPLE_TYPE multisampleType = desc.MultiSampleType;
-
-    if (Log::info()) {
-        // this is the original number of Direct3D samples used by the source
-        Log::print( "DX multisample type = " ) << D3DMULTISAMPLE_TYPEtoString(
-            multisampleType
-            ) << endl;
-    }
-
-    // if the target has forced multisamples that are greater than the
-    // Direct3D source, we force the source to use the same number to
-    // ensure they have a compatible pixel format (otherwise the interop
-    // seems to fail)
-    if ( multisampleType < forcedSamplesDX ) {
-        multisampleType = forcedSamplesDX;
-        Log::print( "Forcing DX multisample type to: " ) <<
-            D3DMULTISAMPLE_TYPEtoString( multisampleType ) << endl;
-    }
-
-    // convert multisampling level to an unsigned integer and store it
-    // for later use when creating the target OpenGL window
-    if ( 
-        ( multisampleType >= D3DMULTISAMPLE_2_SAMPLES  ) &&
-        ( multisampleType <= D3DMULTISAMPLE_16_SAMPLES )
-    ) {
-        m_samplesDX = static_cast<unsigned>( multisampleType );
-    } else
-        m_samplesDX = 0;
-
-    LPDIRECT3DSURFACE9 depthStencilSurface = 0;
-    D3DSURFACE_DESC depthStencilDesc = {};
-    depthStencilDesc.Format = D3DFMT_D24S8;
-
-    // display some information about the depth/stencil format
-    // (purely informational, not required currently)
-    if ( m_device->GetDepthStencilSurface( &depthStencilSurface ) == S_OK ) {
-        // get the surface description
-        if ( depthStencilSurface->GetDesc( &depthStencilDesc ) == S_OK ) {
-            if (Log::info())
-                Log::print( "DX depth/stencil surface format: " ) <<
-                    D3DFORMATtoString( depthStencilDesc.Format ) << endl;
-        } else {
-            Log::print( "error: failed to get depth surface description\n" );
-        }
-
-        // release depth stencil surface
-        depthStencilSurface->Release();
-    } else
-        Log::print( "error: failed to get depth stencil surface\n" );
-
-    // create render target(s)
-    for (unsigned i=0; i < m_target.size(); ++i) {
-        // initialise share handle to NULL
-        // JDW added for ATI compatibility
-        m_target[i].shareHandle = NULL;
-
-        // create render target
-        if (m_device->CreateRenderTarget(
-            m_width,
-            m_height,
-            displayMode.Format,
-            multisampleType,
-            0,
-            FALSE,
-            &m_target[i].surface,
-            &m_target[i].shareHandle
-        ) != S_OK) {
-            Log::print("error: failed to create DX render target\n");
-            break;
-        }
-    }
-
-    // get the current render target and save for later use
-    m_device->GetRenderTarget( 0, &m_backBuffer );
-
-    // create window
-    startRenderThread();
-
-    // we have completed initialisation
-    m_initialised = true;
-}
-
-//-----------------------------------------------------------------------------
-
-void Quadifier::startRenderThread()
-{
-    if (Log::info())
-        Log::print( "starting GL rendering thread\n" );
-
-    if ( m_thread != 0 ) return;
-
-    // create thread
-    unsigned threadId = 0;
-
-    m_thread = _beginthreadex(
-        NULL,       // no security attributes (child cannot inherit handle)
-        1024*1024,  // 1MB stack size
-        threadFunc, // code to run on new thread
-        this,       // pointer to host application class
-        0,          // run immediately (could create suspended)
-        &threadId   // OUT: returns thread ID
-    );
-
-    if (Log::info())
-        Log::print() << "thread = " << hex << (unsigned)m_thread << dec << endl;
-}
-
-//-----------------------------------------------------------------------------
+#include <process.h>
+#include <iomanip>
+#include <cmath>
+#include <sstream>
+#include "Clock.h"
+#include "Defines.h"
+#include "Quadifier.h"
+#include "Log.h"
+#include "Settings.h"
+#include "StereoUtil.h"
+#include "DebugUtil.h"
+#include "IDirect3DDevice9Proxy.h"
+#include "PathProbe.h"
+#include "ResourceTracker.h"
+#include "Trace.h"
+#include <GL/glext.h>
+#include "WinMessage.h"
+
+using namespace hive;
+using namespace std;
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+namespace {
+
+/// GPU time-stamp points in the GL frame
+enum PointGL {
+    POINT_START,        ///< start of paint
+    POINT_LOCKED,       ///< interop targets locked
+    POINT_PRESENTED,    ///< targets presented and unlocked
+    POINT_SWAPPED       ///< buffers swapped
+};
+
+/// GL timing statistics channels
+enum StatGL {
+    STAT_LOCK,          ///< time to lock the interop targets
+    STAT_PRESENT,       ///< time to present the targets
+    STAT_SWAP,          ///< time to swap buffers
+    STAT_PAINT,         ///< total paint time
+    STAT_LATENCY,       ///< CPU time from DX present to GL swap
+    STAT_BARRIER,       ///< CPU time blocked in SwapBuffers (swap group)
+    STAT_WAKE,          ///< CPU time from a new frame to the GL thread waking
+    STAT_TIMER          ///< CPU time the pacer's timer woke the GL thread late
+};
+
+/// DX timing statistics channels
+enum StatDX {
+    STAT_CAPTURE,       ///< GPU time between beginCapture and endCapture
+    STAT_FRAME,         ///< CPU time between beginCapture and endCapture
+    STAT_INTERVAL       ///< CPU time between successive DX presents
+};
+
+/// Window property of the source window which holds the GL window handle
+const wchar_t *PROP_WINDOW = L"QuadifierWindow";
+
+/// Time to wait for the GL thread to replace the targets (milliseconds)
+const unsigned REPLACE_TIMEOUT = 1000;
+
+#if !defined(WGL_CONTEXT_OPENGL_NO_ERROR_ARB)
+#define WGL_CONTEXT_OPENGL_NO_ERROR_ARB 0x31B3
+#endif
+
+#if !defined(NDEBUG)
+/// Log the messages of a KHR_debug context (debug builds only)
+void APIENTRY debugMessage(
+    GLenum /*source*/, GLenum /*type*/, GLuint id, GLenum severity,
+    GLsizei /*length*/, const GLchar *message, const void * /*userParam*/
+) {
+    const char *level =
+        ( severity == GL_DEBUG_SEVERITY_HIGH   ) ? "error" :
+        ( severity == GL_DEBUG_SEVERITY_MEDIUM ) ? "warning" : "info";
+    Log::print( "GL debug " ) << level << " " << id << ": " << message << endl;
+}
+#endif
+
+/// Convert a unit quaternion (x,y,z,w) to a column-major 3x3 rotation matrix
+void quaternionToMatrix( const float q[4], float m[9] )
+{
+    const float x = q[0], y = q[1], z = q[2], w = q[3];
+    m[0] = 1.f - 2.f*(y*y + z*z); m[3] = 2.f*(x*y - z*w);       m[6] = 2.f*(x*z + y*w);
+    m[1] = 2.f*(x*y + z*w);       m[4] = 1.f - 2.f*(x*x + z*z); m[7] = 2.f*(y*z - x*w);
+    m[2] = 2.f*(x*z - y*w);       m[5] = 2.f*(y*z + x*w);       m[8] = 1.f - 2.f*(x*x + y*y);
+}
+
+/// Rotation taking view directions at present time to those at render time
+/// (the inverse of the render rotation, times the current rotation)
+void reprojectionMatrix( const float render[4], const float now[4], float m[9] )
+{
+    float a[9], b[9];
+    quaternionToMatrix( render, a );
+    quaternionToMatrix( now, b );
+    for (unsigned col=0; col<3; ++col) {
+        for (unsigned row=0; row<3; ++row) {
+            // element (row,col) of transpose(a) * b
+            m[3*col + row] = a[3*row + 0] * b[3*col + 0] +
+                             a[3*row + 1] * b[3*col + 1] +
+                             a[3*row + 2] * b[3*col + 2];
+        }
+    }
+}
+
+/// Are two viewports the same?
+bool sameViewport( const D3DVIEWPORT9 & a, const D3DVIEWPORT9 & b )
+{
+    return ( a.X == b.X ) && ( a.Y == b.Y ) &&
+        ( a.Width == b.Width ) && ( a.Height == b.Height ) &&
+        ( a.MinZ == b.MinZ ) && ( a.MaxZ == b.MaxZ );
+}
+
+/// Scale a viewport size, keeping at least one pixel
+unsigned scaleSize( unsigned size, float scale )
+{
+    const unsigned scaled = static_cast<unsigned>( size * scale + 0.5f );
+    return ( scaled > 0 ) ? scaled : 1;
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+
+std::atomic<Quadifier*> Quadifier::s_current( nullptr );
+
+//-----------------------------------------------------------------------------
+
+Quadifier::Quadifier(
+    IDirect3DDevice9 *device,
+    IDirect3D9 *direct3D
+) :
+    m_device( device ),
+    m_direct3D( direct3D ),
+    m_deviceEx( false ),
+    m_statsGL( "GL timing" ),
+    m_statsDX( "DX timing" ),
+    m_statsCalls( "DX calls per view", "count", 0 )
+{
+    // an IDirect3DDevice9Ex keeps its resources across Reset, which lets us
+    // create the new targets before the old ones are released
+    IDirect3DDevice9Ex *deviceEx = 0;
+    if ( (m_device != 0) && (m_device->QueryInterface(
+            __uuidof(IDirect3DDevice9Ex), reinterpret_cast<void**>(&deviceEx)
+        ) == S_OK)
+    ) {
+        m_deviceEx = true;
+        deviceEx->Release();
+    }
+
+#if defined(SUPPORT_D3D11)
+    m_device11 = 0;
+    m_context11 = 0;
+    m_chain11 = 0;
+    m_backBuffer11 = 0;
+#endif
+
+    construct();
+}
+
+//-----------------------------------------------------------------------------
+
+#if defined(SUPPORT_D3D11)
+Quadifier::Quadifier( ID3D11Device *device ) :
+    m_device( 0 ),
+    m_direct3D( 0 ),
+    m_deviceEx( false ),
+    m_statsGL( "GL timing" ),
+    m_statsDX( "DX timing" ),
+    m_statsCalls( "DX calls per view", "count", 0 )
+{
+    m_device11 = device;
+    m_context11 = 0;
+    m_chain11 = 0;
+    m_backBuffer11 = 0;
+
+    // the immediate context is used to redirect rendering into our targets
+    if ( m_device11 != 0 )
+        m_device11->GetImmediateContext( &m_context11 );
+
+    construct();
+}
+#endif
+
+//-----------------------------------------------------------------------------
+
+void Quadifier::construct()
+{
+    m_framesGL = 0;
+    m_framesDX = 0;
+
+    m_samplesDX = 0;
+    m_samplesGL = 0;
+    m_forcedSamples = 0;
+    m_probe.forcedSamples = 0;
+    m_probe.interop = false;
+    m_probe.format = 0;
+    m_probe.path = PathProbe::PATH_NONE;
+    m_probePaths = false;
+
+    m_backBuffer = 0;
+    m_drawBuffer = 0;
+    // m_target implicit
+    m_stereoMode = false;
+    m_pluginSignal = false;
+    m_firstFrameTimeGL = 0.0;
+    m_lastFrameTimeGL = 0.0;
+    m_lastPresentTime = 0.0;
+    m_useBlit = true;
+    m_useTexture = true;
+    m_packing = Settings::PACKING_NONE;
+    m_hudTime = 0.0;
+    m_hudPaints = 0;
+    m_hudFrameId = 0;
+    m_hudLockTime = 0.0;
+    m_hudLocks = 0;
+    for (unsigned eye=0; eye<2; ++eye) {
+        m_hudDraws[eye].store( 0 );
+        m_hudStates[eye].store( 0 );
+    }
+    m_calls = Calls();
+    m_countCalls = Settings::get().countCalls;
+    m_presentScheduled = false;
+    m_readyTime.store( 0.0 );
+    for (unsigned i=0; i<MAX_TARGETS; ++i)
+        m_targetTag[i].store( TAG_NONE );
+    m_painted = false;
+    m_paintedFrameId = 0;
+    m_droppedEyes = 0;
+    m_repeatedEyes = 0;
+    m_mismatchedEyes = 0;
+    m_thread = 0;
+    m_sourceWindow = 0;
+    m_interopGLDX = 0;
+    // m_newFrame implict
+    // m_swapLock implict
+    m_width  = 0;
+    m_height = 0;
+    m_initialised = false;
+    m_replaceState.store( REPLACE_IDLE );
+    m_swapGroup = 0;
+    m_swapBarrier = 0;
+    m_frameCount = 0;
+    m_idleVBlanks = 0;
+    m_extrapolate = false;
+    m_refreshPeriod = 16;
+
+    // in asynchronous mode, the DX thread publishes each completed frame
+    // into the mailbox and carries on, rather than waiting for GL to swap;
+    // each of the mailbox slots then owns a pair of targets (left and right)
+    m_asyncPresent = Settings::get().asyncPresent;
+
+    // the presenter process opens our targets through their share handles,
+    // which needs a Direct3D9Ex device; without it we present as before
+    m_presenter = false;
+    if ( Settings::get().presenter && !Settings::get().passThrough ) {
+        if ( !m_deviceEx )
+            Log::print( "warning: presenter requires a Direct3D9Ex device, presenting in process\n" );
+        else
+            m_presenter = m_publisher.create( m_device );
+    }
+    if ( m_presenter ) m_asyncPresent = true;
+
+    if ( Settings::get().lowLatency && !m_asyncPresent && ( m_device != 0 ) &&
+         !Settings::get().passThrough
+    )
+        Log::print( "warning: lowLatency still waits for each GL swap without asyncPresent\n" );
+
+    // views per stereo frame: beyond the left and right eyes, each one is
+    // captured into a target of its own, and is shown by the output windows
+    m_views = Settings::get().views;
+
+    // zero-copy mode relies on the DX thread waiting for each frame to be
+    // painted (since there is a single back buffer), and is Direct3D 9 only
+    // (with only a left eye before the back buffer)
+    m_zeroCopy = Settings::get().zeroCopy && !m_asyncPresent && ( m_device != 0 ) &&
+        ( m_views == 2 );
+    m_captureBack = false;
+    m_readback = false;
+    if ( Settings::get().zeroCopy && !m_zeroCopy )
+        Log::print( "warning: zeroCopy is not supported in this mode\n" );
+
+    // double-wide capture is Direct3D 9 only, and cannot be combined with
+    // zero-copy (where the right eye is rendered into the back buffer), or
+    // with more than the two eyes
+    m_doubleWide = Settings::get().doubleWide && !m_zeroCopy && ( m_device != 0 ) &&
+        ( m_views == 2 );
+    m_eyeOffset = 0;
+    m_appViewport = D3DVIEWPORT9();
+    m_setViewport = D3DVIEWPORT9();
+    if ( Settings::get().doubleWide && !m_doubleWide )
+        Log::print( "warning: doubleWide is not supported in this mode\n" );
+
+    if ( m_presenter ) {
+        // each frame is copied out as it completes, so the next one can
+        // be rendered into the same targets straight away
+        m_target.resize( m_views );
+    } else if ( m_asyncPresent ) {
+        // the mailbox always needs one target per view for each slot
+        m_target.resize( m_views * FrameMailbox::SLOTS );
+    } else if ( m_zeroCopy ) {
+        // a left eye target, and the back buffer (GL always paints a frame
+        // before the next one is started, so one left eye target is enough)
+        m_target.resize( 2 );
+    } else {
+        // size of the target pool (a stereo pair uses two targets, so any
+        // extra targets allow DX to run ahead when a GL frame is late; each
+        // view beyond the pair needs one more)
+        m_target.resize( Settings::get().targetCount + m_views - 2 );
+    }
+    if (Log::info())
+        Log::print( "DX/GL target pool size = " ) << m_target.size() << endl;
+    m_writeSlot = m_mailbox.writeSlot();
+    m_readSlot = m_mailbox.readSlot();
+    if ( m_asyncPresent ) m_drawBuffer = m_views * m_writeSlot;
+
+    // timing statistics channels (in the order of the enumerations above)
+    m_statsGL.addChannel( "lock" );
+    m_statsGL.addChannel( "present" );
+    m_statsGL.addChannel( "swap" );
+    m_statsGL.addChannel( "paint" );
+    m_statsGL.addChannel( "latency" );
+    m_statsGL.addChannel( "barrier" );
+    m_statsGL.addChannel( "wake" );
+    m_statsGL.addChannel( "timer late" );
+    m_statsDX.addChannel( "capture" );
+    m_statsDX.addChannel( "frame" );
+    m_statsDX.addChannel( "interval" );
+    for (unsigned view=0; m_countCalls && (view<m_views); ++view) {
+        // four channels per view, in the order of Calls
+        std::ostringstream name;
+        name << 'v' << view << ' ';
+        m_statsCalls.addChannel( name.str() + "draws" );
+        m_statsCalls.addChannel( name.str() + "prims" );
+        m_statsCalls.addChannel( name.str() + "states" );
+        m_statsCalls.addChannel( name.str() + "targets" );
+    }
+
+    // auto-reset event used to wake the GL thread when a frame is queued
+    // (in either mode)
+    m_frameReady = CreateEvent( NULL, FALSE, FALSE, NULL );
+
+    // have we got stereo support? (a passive stereo packing draws both eyes
+    // into an ordinary back buffer, so never asks for a stereo format)
+    m_packing = Settings::get().stereoPacking;
+    m_stereoAvailable = ( m_packing == Settings::PACKING_NONE ) &&
+        isOpenGLStereoAvailable();
+
+    // shared tracker poses, for reprojecting each frame at present time
+    if ( Settings::get().reproject && !m_pose.open() )
+        Log::print( "warning: unable to open shared tracker poses\n" );
+
+    // set logging level
+    // note: a few log messages will already have been output at this point
+    Log::get().setLevel( Settings::get().logLevel );
+
+    // the plugin signal goes to the device created last
+    s_current.store( this );
+}//construct
+
+//-----------------------------------------------------------------------------
+
+Quadifier::~Quadifier()
+{
+    if (Log::info()) {
+        Log::print( "~Quadifier\n" );
+        m_statsDX.report();
+        if ( m_countCalls ) m_statsCalls.report();
+        ResourceTracker::report();
+    }
+
+    // stop taking the plugin signal (unless a newer device has it)
+    Quadifier *self = this;
+    s_current.compare_exchange_strong( self, nullptr );
+
+    // release the time-stamp queries
+    m_gpuTimerDX.destroy();
+
+    // release the presenter's targets (it keeps showing the last frame)
+    m_publisher.destroy();
+
+    // clear all the render targets
+    for (unsigned i = 0; i < m_target.size(); ++i)
+        m_target[i].clear();
+
+    // release the backbuffer
+    if ( m_backBuffer != 0 ) {
+        m_backBuffer->Release();
+        m_backBuffer = 0;
+    }
+
+#if defined(SUPPORT_D3D11)
+    // release the immediate context
+    if ( m_context11 != 0 ) {
+        m_context11->Release();
+        m_context11 = 0;
+    }
+#endif
+
+    // close the frame ready event
+    if ( m_frameReady != 0 ) {
+        CloseHandle( m_frameReady );
+        m_frameReady = 0;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void Quadifier::onCreateDX()
+{
+}//onCreateDX
+
+//-----------------------------------------------------------------------------
+
+void Quadifier::onPreClearDX(
+    DWORD /*Count*/,
+    CONST D3DRECT* /*pRects*/,
+    DWORD /*Flags*/,
+    D3DCOLOR /*Color*/,
+    float /*Z*/,
+    DWORD /*Stencil*/
+) {
+    if (Log::verbose()) Log::print( "onPreClearDX\n" );
+
+    // is this the main display render target?
+    if ( !isPresentedRenderTarget() ) return;
+
+    if ( !m_initialised ) {
+        // the first time we are called, we will create the resources
+        // (render targets) - i.e. after the  parent window has been
+        // created at the correct size
+        createResources();
+    }
+
+    // there is nothing to capture into if the targets have been released
+    // (e.g. after a failed Reset)
+    if ( m_target[m_drawBuffer].surface == 0 ) return;
+
+    // start capturing DX drawing
+    beginCapture();
+}
+
+//-----------------------------------------------------------------------------
+
+void Quadifier::onPostClearDX()
+{
+}
+
+//-----------------------------------------------------------------------------
+
+void Quadifier::onPrePresentDX(
+    CONST RECT * /*pSourceRect*/,
+    CONST RECT * /*pDestRect*/,
+    HWND /*hDestWindowOverride*/,
+    CONST RGNDATA * /*pDirtyRegion*/
+) {
+    if (Log::verbose()) Log::print( "onPrePresentDX\n" );
+
+    // get the current render target
+    IDirect3DSurface9 *renderTarget = 0;
+    if ( m_device->GetRenderTarget( 0, &renderTarget ) == S_OK ) {
+        // release the render target (we are only storing its pointer as
+        // a hash for comparison purposes)
+        renderTarget->Release();
+
+        // insert the render target in the set of presented targets
+        // if not already present
+        m_presentedTargets.insert(
+            reinterpret_cast<uintptr_t>(renderTarget)
+        );
+
+        // verbose logging
+        if (Log::verbose())
+            Log::print() << "Presenting Render Target: " << renderTarget << endl;
+    }
+
+    // send frame to GL display thread
+    // if we are in stereo mode, this will be the right eye
+    // channel of a stereo pair (or the last view), otherwise we are
+    // rendering 2D (this completes the frame and wakes the GL thread)
+    endCapture( viewDrawBuffer( m_capture.eyes, true ), true );
+}//onPrePresentDX
+
+//-----------------------------------------------------------------------------
+
+void Quadifier::onPostPresentDX()
+{
+    if (Log::verbose()) Log::print( "onPostPresentDX\n" );
+
+    // in asynchronous mode we never wait for the GL thread: it will pick up
+    // the latest published frame on its own vsync cadence
+    if ( m_asyncPresent ) return;
+
+    // the next frame needs one target per view (or one for both eyes, in
+    // double-wide mode), starting at m_drawBuffer; the frames still queued
+    // for GL occupy the targets just before it
+    const size_t eyes = ( m_stereoMode && !m_doubleWide ) ? m_views : 1;
+
+    // wait until the GL thread has rendered out enough frames that the next
+    // frame will not overwrite a queued one, to keep the OpenGL and Direct3D
+    // threads synchronised (after a timeout we return anyway); in zero-copy
+    // mode the application renders into the back buffer again next, so GL
+    // must have painted every queued frame
+    while ( m_zeroCopy ?
+        !m_ring.empty() : ( (m_ring.size() + 1) * eyes > m_target.size() )
+    ) {
+        if ( !m_frameDone.wait( 1000 ) ) break;
+    }
+}//onPostPresentDX
+
+//-----------------------------------------------------------------------------
+
+bool Quadifier::onPreSetViewportDX( CONST D3DVIEWPORT9 *pViewport )
+{
+    if (pViewport == nullptr) return true;
+
+    // when we see SetViewport with a rectangle of (1,*,2,3) this is our
+    // signal from the Quadifier script that right eye rendering has started
+    // (unless the script signals through the native plugin instead)
+    if ( !m_pluginSignal &&
+         (pViewport->X      == 1) &&
+         (pViewport->Width  == 2) &&
+         (pViewport->Height == 3)
+    ) {
+        // call the handler to switch the stereo capture buffer (to the next
+        // view)
+        onStereoSignal( m_capture.eyes + 1 );
+    }
+
+    // while capturing at a reduced resolution, or into the right half of a
+    // double-wide target, the viewport is adjusted (apart from the one we
+    // last set in its place, which the application may be restoring after
+    // reading it back with GetViewport)
+    if ( ((m_capture.scale < 1.f) || (m_eyeOffset != 0)) &&
+         !sameViewport( *pViewport, m_setViewport ) && isCaptureTargetBound()
+    ) {
+        m_appViewport = *pViewport;
+        m_setViewport = captureViewport( *pViewport );
+        m_device->SetViewport( &m_setViewport );
+        return false;
+    }
+
+    // return true to pass on the SetViewport call to Direct3D
+    return true;
+}//onPreSetViewportDX
+
+//-----------------------------------------------------------------------------
+
+void Quadifier::onPreResetDX()
+{
+    if (Log::info()) Log::print( "onPreResetDX\n" );
+
+    if ( !m_initialised ) return;
+
+    // the back buffer is replaced by Reset
+    if ( m_backBuffer != 0 ) {
+        m_backBuffer->Release();
+        m_backBuffer = 0;
+    }
+
+    // an IDirect3DDevice9 (but not an IDirect3DDevice9Ex) fails to Reset
+    // while any D3DPOOL_DEFAULT resources exist, so our render targets and
+    // queries have to go first: they are re-created after the Reset (this
+    // is also the case for any device if we are sharing its back buffer)
+    if ( !m_deviceEx || m_zeroCopy ) {
+        m_gpuTimerDX.destroy();
+
+        // our double-wide depth/stencil buffer may still be bound (Reset
+        // binds the automatic one again)
+        if ( m_doubleWide ) m_device->SetDepthStencilSurface( 0 );
+
+        std::vector<Target> targets( m_target.size() );
+        replaceTargets( targets, true );
+    }
+}//onPreResetDX
+
+//-----------------------------------------------------------------------------
+
+void Quadifier::onPostResetDX( HRESULT result )
+{
+    if (Log::info()) Log::print( "onPostResetDX: " ) << result << endl;
+
+    if ( !m_initialised ) return;
+
+    if ( result != D3D_OK ) {
+        // the application will try again (until then we capture nothing)
+        Log::print( "warning: Reset failed, DX render targets not re-created\n" );
+        return;
+    }
+
+    // create new targets to match the new back buffer, then swap them in
+    // (the old ones, if any, are released only after they are replaced)
+    std::vector<Target> targets( m_target.size() );
+    createTargets( targets );
+    replaceTargets( targets, false );
+
+    // the render target pointers we have seen presented are now stale:
+    // start again with the new back buffer
+    m_presentedTargets.clear();
+    if ( m_device->GetRenderTarget( 0, &m_backBuffer ) == S_OK )
+        m_presentedTargets.insert( reinterpret_cast<uintptr_t>(m_backBuffer) );
+
+    if ( !m_deviceEx || m_zeroCopy )
+        m_gpuTimerDX.create( m_device );
+}//onPostResetDX
+
+//-----------------------------------------------------------------------------
+
+#if defined(SUPPORT_D3D11)
+void Quadifier::onCreateSwapChainDX( IDXGISwapChain *chain )
+{
+    if (Log::info()) Log::print() << "onCreateSwapChainDX(" << chain << ")\n";
+
+    // we support a single swap chain (the one the application presents)
+    if ( m_chain11 != 0 ) return;
+    m_chain11 = chain;
+
+    // identify the back buffer, so that we can recognise its views
+    ID3D11Resource *backBuffer = 0;
+    if ( m_chain11->GetBuffer(
+            0, __uuidof(ID3D11Resource), reinterpret_cast<void**>(&backBuffer)
+        ) == S_OK
+    ) {
+        m_backBuffer11 = backBuffer;
+        backBuffer->Release();
+    } else
+        Log::print( "error: failed to get swap chain back buffer\n" );
+}//onCreateSwapChainDX
+#endif
+
+//-----------------------------------------------------------------------------
+
+#if defined(SUPPORT_D3D11)
+void Quadifier::onPrePresentDX( UINT /*syncInterval*/, UINT /*flags*/ )
+{
+    if (Log::verbose()) Log::print( "onPrePresentDX\n" );
+
+    // nothing has been captured until the back buffer has been bound
+    if ( !m_initialised ) return;
+
+    // send frame to GL display thread (this will be the right eye of a
+    // stereo pair, the last view, or a 2D frame)
+    endCapture( viewDrawBuffer( m_capture.eyes, true ), true );
+}//onPrePresentDX
+#endif
+
+//-----------------------------------------------------------------------------
+
+#if defined(SUPPORT_D3D11)
+ID3D11RenderTargetView * const * Quadifier::onPreSetRenderTargetsDX(
+    UINT numViews,
+    ID3D11RenderTargetView * const *views
+) {
+    // we only redirect the back buffer, which must be the first view
+    if ( (numViews == 0) || (views == 0) || (views[0] == 0) ) return views;
+    if ( !isBackBufferView( views[0] ) ) return views;
+
+    if ( !captureBackBufferDX11() ) return views;
+
+    // substitute the current target for the back buffer
+    for (UINT i=0; (i < numViews) && (i < D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT); ++i)
+        m_views11[i] = views[i];
+    m_views11[0] = m_target[m_drawBuffer].view11;
+
+    if (Log::verbose())
+        Log::print() << "OMSetRenderTargets: " << views[0] << " -> "
+            << m_views11[0] << " (drawBuffer==" << m_drawBuffer << ")\n";
+
+    return m_views11;
+}//onPreSetRenderTargetsDX
+#endif
+
+//-----------------------------------------------------------------------------
+
+#if defined(SUPPORT_D3D11)
+ID3D11RenderTargetView * Quadifier::onPreClearRenderTargetViewDX(
+    ID3D11RenderTargetView *view
+) {
+    if ( (view == 0) || !isBackBufferView( view ) ) return view;
+    if ( !captureBackBufferDX11() ) return view;
+
+    // clear the current target instead of the back buffer
+    return m_target[m_drawBuffer].view11;
+}//onPreClearRenderTargetViewDX
+#endif
+
+//-----------------------------------------------------------------------------
+
+#if defined(SUPPORT_D3D11)
+bool Quadifier::onPreSetViewportsDX(
+    UINT count,
+    const D3D11_VIEWPORT *viewports
+) {
+    if ( (count == 0) || (viewports == 0) ) return true;
+
+    // the same signal from the Quadifier script as for Direct3D 9: a
+    // viewport of (1,*,2,3) tells us that right eye rendering has started
+    if ( !m_pluginSignal &&
+         (viewports[0].TopLeftX == 1.f) &&
+         (viewports[0].Width    == 2.f) &&
+         (viewports[0].Height   == 3.f)
+    ) {
+        onStereoSignal( m_capture.eyes + 1 );
+    }
+
+    // while capturing into one of our targets at a reduced resolution, the
+    // viewports are scaled down (D3D11 targets are never double-wide)
+    const float scale = m_capture.scale;
+    if ( scale < 1.f ) {
+        ID3D11RenderTargetView *view = 0;
+        m_context11->OMGetRenderTargets( 1, &view, 0 );
+        const bool capturing = isTargetView( view );
+        if ( view != 0 ) view->Release();
+
+        if ( capturing ) {
+            D3D11_VIEWPORT scaled[D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE];
+            if ( count > D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE )
+                count = D3D11_VIEWPORT_AND_SCISSORRECT_OBJECT_COUNT_PER_PIPELINE;
+            for (UINT i=0; i<count; ++i) {
+                scaled[i] = viewports[i];
+                scaled[i].TopLeftX = viewports[i].TopLeftX * scale;
+                scaled[i].TopLeftY = viewports[i].TopLeftY * scale;
+                scaled[i].Width = static_cast<float>(
+                    scaleSize( static_cast<unsigned>( viewports[i].Width + 0.5f ), scale )
+                );
+                scaled[i].Height = static_cast<float>(
+                    scaleSize( static_cast<unsigned>( viewports[i].Height + 0.5f ), scale )
+                );
+            }
+            m_context11->RSSetViewports( count, scaled );
+            return false;
+        }
+    }
+
+    // return true to pass on the RSSetViewports call to Direct3D
+    return true;
+}//onPreSetViewportsDX
+#endif
+
+//-----------------------------------------------------------------------------
+
+#if defined(SUPPORT_D3D11)
+void Quadifier::onPostResizeBuffersDX( HRESULT result )
+{
+    if (Log::info()) Log::print( "onPostResizeBuffersDX: " ) << result << endl;
+
+    if ( (result != S_OK) || (m_chain11 == 0) ) return;
+
+    // identify the new back buffer
+    ID3D11Resource *backBuffer = 0;
+    if ( m_chain11->GetBuffer(
+            0, __uuidof(ID3D11Resource), reinterpret_cast<void**>(&backBuffer)
+        ) == S_OK
+    ) {
+        m_backBuffer11 = backBuffer;
+        backBuffer->Release();
+    }
+
+    // until initialised, the targets will be created at the new size anyway
+    if ( !m_initialised ) return;
+
+    // create new targets at the new size, then swap them in
+    std::vector<Target> targets( m_target.size() );
+    createTargetsDX11( targets );
+    replaceTargets( targets, false );
+}//onPostResizeBuffersDX
+#endif
+
+//-----------------------------------------------------------------------------
+
+bool Quadifier::onCreate()
+{
+    if (Log::info()) {
+        // log some general information about the OpenGL renderer
+        Log::print( "GL Version : " ) << glGetString( GL_VERSION ) << endl;
+        Log::print( "GL Vendor  : " ) << glGetString( GL_VENDOR ) << endl;
+        Log::print( "GL Renderer: " ) << glGetString( GL_RENDERER ) << endl;
+    }
+
+    // query number of antialiasing samples
+    m_samplesGL = m_window.getSamples();
+    if (Log::info())
+        Log::print( "GL Samples : " ) << m_samplesGL << endl;
+
+    // output pixel format index
+    if (Log::info())
+        Log::print() << "OpenGL pixel format = " << m_window.getPixelFormat() << endl;
+
+    // which context the driver accepted
+    if (Log::info()) {
+        if ( m_window.getContextAttributes().empty() )
+            Log::print( "GL context : legacy (fully validated)\n" );
+        else if ( m_window.getContextAttributes().count( WGL_CONTEXT_OPENGL_NO_ERROR_ARB ) )
+            Log::print( "GL context : no-error\n" );
+        else
+            Log::print( "GL context : debug\n" );
+    }
+
+#if !defined(NDEBUG)
+    // report the debug context's messages (synchronously, so that a
+    // breakpoint in debugMessage stops at the call which caused it)
+    if ( m_window.getContextAttributes().count( WGL_CONTEXT_FLAGS_ARB ) && glx.loadDebug() ) {
+        glEnable( GL_DEBUG_OUTPUT_SYNCHRONOUS );
+        glx.glDebugMessageControl( GL_DONT_CARE, GL_DONT_CARE,
+            GL_DEBUG_SEVERITY_NOTIFICATION, 0, 0, GL_FALSE );
+        glx.glDebugMessageCallback( debugMessage, 0 );
+    }
+#endif
+
+    // query OpenGL texture size
+    {
+        GLint textureSize = 0;
+        glGetIntegerv( GL_MAX_TEXTURE_SIZE, &textureSize );
+        if (Log::info())
+            Log::print() << "OpenGL maximum texture size = " << textureSize << endl;
+    }
+
+    bool success = false;
+
+    // use textures or renderbuffers? (the probed path, if there is one,
+    // overrides the setting)
+    m_useTexture = Settings::get().useTexture;
+    if ( m_probePaths && (m_probe.path != PathProbe::PATH_NONE) )
+        m_useTexture = ( m_probe.path != PathProbe::PATH_RENDERBUFFER_BLIT );
+
+    // in readback mode we only need the framebuffer functions
+    const bool loaded = glx.load() || ( m_readback && glx.hasFramebuffers() );
+
+    if (!loaded)
+        Log::print( "error: failed to load GL extensions\n" );
+    else do {
+        if (Log::info()) Log::print( "loaded GL extensions\n" );
+
+        if ( m_readback ) {
+            // frames are uploaded from system memory instead
+            m_readbackRing.create( glx );
+        } else {
+            if (Log::info()) Log::print( "creating GL/DX interop\n" );
+#if defined(SUPPORT_D3D11)
+            if ( m_device11 != 0 )
+                m_interopGLDX = glx.wglDXOpenDeviceNV( m_device11 );
+            else
+#endif
+            m_interopGLDX = glx.wglDXOpenDeviceNV( m_device );
+
+            if ( m_interopGLDX == 0 ) {
+                Log::print( "error: failed to create GL/DX interop\n" );
+                break;
+            }
+        }
+
+        // select standard or multisampled GL texture mode
+        GLenum textureMode = ( m_samplesGL > 1 ) ?
+                GL_TEXTURE_2D_MULTISAMPLE : GL_TEXTURE_2D;
+
+        if (Log::info()) Log::print( "generating render buffers\n" );
+        unsigned i=0;
+        for (i=0; i<m_target.size(); ++i) {
+            if ( !registerTarget( m_target[i], i ) ) break;
+        }
+
+        // successful only if all render buffers were created and initialised
+        success = ( i == m_target.size() );
+
+        // we present using textures only if requested, and only when GL and
+        // DX have matching multisample formats (otherwise we must blit)
+        m_useBlit = !m_useTexture || ( m_samplesGL != m_samplesDX ) ||
+            ( m_probePaths && (m_probe.path == PathProbe::PATH_TEXTURE_BLIT) );
+
+        // create the pipeline for presenting textures
+        if ( !m_useBlit && !m_present.create( glx, textureMode, m_samplesGL, m_packing ) ) {
+            Log::print( "warning: failed to create present pipeline, using framebuffer blit\n" );
+            m_useBlit = true;
+        }
+        if ( m_useBlit && (m_packing == Settings::PACKING_ROWS) )
+            Log::print( "warning: row packing requires useTexture, packing side by side\n" );
+        if ( m_useBlit && m_pose.isOpen() )
+            Log::print( "warning: reprojection requires useTexture (and matching MSAA)\n" );
+
+        // projector warp and edge blend, applied as the image is drawn
+        const Settings & startup = Settings::get();
+        if ( !startup.warp.empty() || !startup.blend.empty() ) {
+            if ( m_useBlit )
+                Log::print( "warning: warp and blend require useTexture (and matching MSAA)\n" );
+            else if ( !m_present.loadCalibration( startup.warp, startup.blend, startup.blendGamma ) )
+                Log::print( "warning: failed to load projector calibration, drawing uncalibrated\n" );
+        }
+
+        // create the GPU time-stamp queries (optional)
+        m_gpuTimerGL.create( glx );
+
+        // frame lock with the other nodes of a cluster (optional)
+        joinSwapGroup();
+
+        // extra output windows, each with its own thread and context
+        const vector<Settings::Output> & outputs = Settings::get().outputs;
+        for (unsigned i=0; i<outputs.size(); ++i) {
+            OutputWindow *output = new OutputWindow;
+            if ( output->create( glx, outputs[i], m_stereoAvailable, m_window.getContextAttributes() ) )
+                m_outputs.push_back( output );
+            else
+                delete output;
+        }
+
+        // schedule paints against the vblank (optional)
+        if ( Settings::get().framePacing )
+            m_pacer.create( 1.0e-6 * Settings::get().paceHeadroom );
+
+        // repaint late frames through the reprojection (optional): without
+        // the pacer, the display's refresh period sets the pace
+        m_extrapolate = Settings::get().extrapolate &&
+            !m_useBlit && m_pose.isOpen() && !m_zeroCopy;
+        if ( Settings::get().extrapolate && !m_extrapolate )
+            Log::print( "warning: extrapolate requires reproject and useTexture (and not zeroCopy)\n" );
+        DEVMODE mode = {};
+        mode.dmSize = sizeof(mode);
+        if ( EnumDisplaySettings( 0, ENUM_CURRENT_SETTINGS, &mode ) &&
+             (mode.dmDisplayFrequency > 1)
+        )
+            m_refreshPeriod = 1000 / mode.dmDisplayFrequency;
+
+        // the stereo indicator and HUD (falls back to immediate mode)
+        if ( !m_overlay.create( glx ) )
+            Log::print( "warning: failed to create overlay, HUD not available\n" );
+
+        // record the painted frames to disk (optional)
+        if ( Settings::get().record )
+            m_recorder.create( glx, Settings::get().recordChunk );
+
+        // stream the painted frames to display nodes (optional)
+        if ( Settings::get().streamPort != 0 )
+            m_streamer.create( glx, Settings::get().streamPort );
+    } while (false_value);
+
+    // default OpenGL settings
+    glEnable( GL_COLOR_MATERIAL );
+    glDisable( GL_LIGHTING );
+    glDisable( GL_DEPTH_TEST );
+
+    // default viewing system
+    glMatrixMode( GL_MODELVIEW );
+    glLoadIdentity();
+    glMatrixMode( GL_PROJECTION );
+    glLoadIdentity();
+
+    return success;
+}//onCreate
+
+//-----------------------------------------------------------------------------
+
+void Quadifier::onDestroy()
+{
+    // the source window no longer has a GL window to resize
+    RemoveProp( m_sourceWindow, PROP_WINDOW );
+
+    // free the present pipeline and time-stamp queries
+    m_present.destroy();
+    m_overlay.destroy();
+    m_recorder.destroy();
+    m_streamer.destroy();
+    m_readbackRing.destroy();
+    m_gpuTimerGL.destroy();
+    m_pacer.destroy();
+    leaveSwapGroup();
+
+    // stop the output windows
+    for (unsigned i=0; i<m_outputs.size(); ++i) {
+        m_outputs[i]->destroy();
+        delete m_outputs[i];
+    }
+    m_outputs.clear();
+
+    if (Log::info()) {
+        Log::print( "onDestroy\n" );
+
+        m_statsGL.report();
+
+        Log::print( "DX presented targets = " ) << m_presentedTargets.size() << endl;
+
+        Log::print( "GL frames = " ) << m_framesGL << endl;
+        Log::print( "DX frames = " ) << m_framesDX << endl;
+        Log::print( "GL eyes dropped = " ) << m_droppedEyes
+            << ", repeated = " << m_repeatedEyes
+            << ", mismatched = " << m_mismatchedEyes << endl;
+
+        // display a metric which indicates the ratio of DX to GL frames
+        // (in stereo mode this should tend towards 200)
+        if ( m_framesGL > 0 )
+            Log::print("DX/GL metric = ")
+                << 100 * m_framesDX / m_framesGL
+                << endl;
+
+        // display the final frame rate (number of GL frames per second)
+        double elapsed = m_lastFrameTimeGL - m_firstFrameTimeGL;
+        if ( elapsed > 0.01 )
+            Log::print("Frame rate = ")
+                << setprecision(2) << fixed
+                << static_cast<double>(m_framesGL-1) / elapsed << " fps"
+                << endl;
+    }
+}//onDestroy
+
+//-----------------------------------------------------------------------------
+
+void Quadifier::unregisterTarget( Target & target )
+{
+    if ( target.object != 0 ) {
+        glx.wglDXUnregisterObjectNV( m_interopGLDX, target.object );
+        target.object = 0;
+    }
+    if ( target.frameBuffer != 0 ) {
+        glx.glDeleteFramebuffers( 1, &target.frameBuffer );
+        target.frameBuffer = 0;
+    }
+    if ( target.texture != 0 ) {
+        glDeleteTextures( 1, &target.texture );
+        target.texture = 0;
+    }
+    if ( target.renderBuffer != 0 ) {
+        glx.glDeleteRenderbuffers( 1, &target.renderBuffer );
+        target.renderBuffer = 0;
+    }
+}//unregisterTarget
+
+//-----------------------------------------------------------------------------
+
+bool Quadifier::registerTarget( Target & target, unsigned index )
+{
+    // there is nothing to register for a target without a DX resource
+    if ( target.resource() == 0 ) return true;
+
+    // in readback mode the target is a texture of our own, which is
+    // uploaded from the DX system memory copy
+    if ( m_readback ) {
+        glGenTextures( 1, &target.texture );
+        glBindTexture( GL_TEXTURE_2D, target.texture );
+        glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR );
+        glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR );
+        glTexImage2D(
+            GL_TEXTURE_2D, 0, GL_RGBA8, target.width, target.height, 0,
+            GL_BGRA, GL_UNSIGNED_BYTE, 0
+        );
+        glBindTexture( GL_TEXTURE_2D, 0 );
+
+        glx.glGenFramebuffers( 1, &target.frameBuffer );
+        glx.glBindFramebuffer( GL_FRAMEBUFFER, target.frameBuffer );
+        glx.glFramebufferTexture2D(
+            GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, target.texture, 0
+        );
+        GLenum status = glx.glCheckFramebufferStatus( GL_FRAMEBUFFER );
+        glx.glBindFramebuffer( GL_FRAMEBUFFER, 0 );
+
+        if ( status != GL_FRAMEBUFFER_COMPLETE ) {
+            Log::print() << "glCheckFramebufferStatus = " << GLFRAMEBUFFERSTATUStoString( status ) << endl;
+            return false;
+        }
+        if (Log::info())
+            Log::print( "created readback texture " ) << index << endl;
+        return true;
+    }
+
+    // use textures or renderbuffers? (decided by onCreate)
+    const bool useTexture = m_useTexture;
+
+    // select standard or multisampled GL texture mode
+    GLenum textureMode = ( m_samplesGL > 1 ) ?
+            GL_TEXTURE_2D_MULTISAMPLE : GL_TEXTURE_2D;
+
+    // are we using textures or renderbuffers?
+    if ( useTexture ) {
+        // using GL_TEXTURE_2D
+        glGenTextures( 1, &target.texture );
+
+        if ( target.texture == 0 ) {
+            Log::print( "error: failed to generate texture ID\n" );
+            return false;
+        }
+    } else {
+        // using GL_RENDERBUFFER
+        glx.glGenRenderbuffers( 1, &target.renderBuffer );
+
+        if ( target.renderBuffer == 0 ) {
+            Log::print( "error: failed to generate render buffer ID\n" );
+            return false;
+        }
+    }
+
+    // JDW - register ShareHandle for ATI/AMD interoperability
+    // (this only applies to Direct3D 9 surfaces)
+    if ( target.surface != 0 ) {
+        if (Log::info())
+            Log::print("Setting SharedHandle ") << target.shareHandle << endl;;
+        if (glx.wglDXSetResourceShareHandleNV != 0) {
+            glx.wglDXSetResourceShareHandleNV(target.resource(), target.shareHandle);
+        }
+        else {
+            Log::print("Failed to set SharedHandle: ") << target.shareHandle << endl;
+            return false;
+        }
+    }
+
+    if (Log::info())
+        Log::print( "registering DX object " ) << index << endl;
+    target.object = glx.wglDXRegisterObjectNV(
+        m_interopGLDX,
+        target.resource(),
+        useTexture ? target.texture : target.renderBuffer,
+        useTexture ? textureMode : GL_RENDERBUFFER,
+        WGL_ACCESS_READ_ONLY_NV
+    );
+
+    if ( target.object == 0 ) {
+        DWORD error = GetLastError();
+        Log::print( "error: wglDXRegisterObjectNV failed for render target: " )
+            << formatErrorMessage(error);
+        return false;
+    }
+
+    glx.glGenFramebuffers( 1, &target.frameBuffer );
+
+    if ( target.frameBuffer == 0 ) {
+        Log::print( "error: glGenFramebuffers failed\n" );
+        return false;
+    }
+
+    glx.glBindFramebuffer( GL_FRAMEBUFFER, target.frameBuffer );
+    if (Log::info())
+        Log::print() << "glBindFramebuffer = " << getGLErrorString() << endl;
+
+    if ( useTexture ) {
+        // using GL_TEXTURE_2D
+
+        // important to lock before using glFramebufferTexture2D
+        if ( glx.wglDXLockObjectsNV(m_interopGLDX, 1, &target.object) == GL_TRUE ) {
+
+            // attach colour buffer texture
+            glx.glFramebufferTexture2D(
+                GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                textureMode, target.texture, 0
+            );
+
+            // no mipmaps: the present pipeline samples level 0
+            if ( textureMode == GL_TEXTURE_2D ) {
+                glBindTexture( GL_TEXTURE_2D, target.texture );
+                glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR );
+                glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR );
+                glBindTexture( GL_TEXTURE_2D, 0 );
+            }
+
+            // unlock
+            if (glx.wglDXUnlockObjectsNV(m_interopGLDX, 1, &target.object) != GL_TRUE ) {
+                Log::print() << "Error: UnLockObjectsNV for texture " << index << " failed " << endl;
+            }
+        } else {
+            Log::print() << "Error: LockObjectsNV for texture " << index << " failed " << endl;
+        }
+    } else {
+        // using GL_RENDERBUFFER
+
+        // important to lock before using glFramebufferRenderbuffer
+        if ( glx.wglDXLockObjectsNV(m_interopGLDX, 1, &target.object) == GL_TRUE ) {
+            // attach colour renderbuffer
+            glx.glFramebufferRenderbuffer(
+                GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                GL_RENDERBUFFER, target.renderBuffer
+            );
+
+            // unlock
+            if (glx.wglDXUnlockObjectsNV(m_interopGLDX, 1, &target.object) != GL_TRUE ) {
+                Log::print() << "Error: UnLockObjectsNV for renderBuffer " << index << " failed " << endl;
+            }
+        } else {
+            Log::print() << "Error: LockObjectsNV for renderBuffer " << index << " failed " << endl;
+        }
+
+        glx.glBindRenderbuffer( GL_RENDERBUFFER, target.renderBuffer );
+
+        // if we are logging informational messages
+        if (Log::info()) {
+            // this table defines the renderbuffer parameters to be listed
+            struct {
+                GLenum name;
+                const char *text;
+            } table[] = {
+                { GL_RENDERBUFFER_WIDTH, "width" },
+                { GL_RENDERBUFFER_HEIGHT, "height" },
+                { GL_RENDERBUFFER_INTERNAL_FORMAT, "format" },
+                { GL_RENDERBUFFER_RED_SIZE, "red" },
+                { GL_RENDERBUFFER_GREEN_SIZE, "green" },
+                { GL_RENDERBUFFER_BLUE_SIZE, "blue" },
+                { GL_RENDERBUFFER_ALPHA_SIZE, "alpha" },
+                { GL_RENDERBUFFER_DEPTH_SIZE, "depth" },
+                { GL_RENDERBUFFER_STENCIL_SIZE, "stencil" },
+                { 0, 0 }
+            };
+
+            // query and log all the renderbuffer parameters
+            for (int p = 0; table[p].name != 0; ++p) {
+                GLint value = 0;
+                glx.glGetRenderbufferParameteriv( GL_RENDERBUFFER, table[p].name, &value );
+                Log::print( "renderBuffer." ) << table[p].text << " = " << value << endl;
+            }
+        }
+
+        glx.glBindRenderbuffer( GL_RENDERBUFFER, 0 );
+
+    }
+
+    // log the framebuffer status (should be GL_FRAMEBUFFER_COMPLETE)
+    GLenum status = glx.glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    if ((status != GL_FRAMEBUFFER_COMPLETE) || Log::info()) {
+        Log::print() << "glCheckFramebufferStatus = " << GLFRAMEBUFFERSTATUStoString( status ) << endl;
+        if (status == GL_FRAMEBUFFER_INCOMPLETE_MISSING_ATTACHMENT) {
+            // JDW added for clarification:
+            Log::print() << "For ATI cards this may show GL_FRAMEBUFFER_INCOMPLETE_MISSING_ATTACHMENT but gets corrected later.\n";
+        }
+    }
+
+    return true;
+}//registerTarget
+
+//-----------------------------------------------------------------------------
+
+void Quadifier::updateTargets()
+{
+    // is there a replacement waiting? (if so, the DX thread is waiting too)
+    unsigned state = REPLACE_REQUESTED;
+    if ( !m_replaceState.compare_exchange_strong( state, REPLACE_BUSY ) )
+        return;
+
+    if (Log::info()) Log::print( "replacing GL/DX targets\n" );
+
+    // register the new targets before releasing the old ones
+    for (unsigned i=0; i<m_pendingTarget.size(); ++i) {
+        if ( !registerTarget( m_pendingTarget[i], i ) )
+            Log::print( "error: failed to register replacement target " ) << i << endl;
+    }
+    for (unsigned i=0; i<m_target.size(); ++i)
+        unregisterTarget( m_target[i] );
+    glx.glBindFramebuffer( GL_FRAMEBUFFER, 0 );
+
+    // the old targets are handed back to the DX thread for release
+    m_target.swap( m_pendingTarget );
+
+    // the new targets hold no frame yet: a tag left from the old ones could
+    // match a stale descriptor, and paint the wrong target
+    for (unsigned i=0; i<MAX_TARGETS; ++i)
+        m_targetTag[i].store( TAG_NONE );
+
+    // any queued frames were captured into the old targets: drop them (the
+    // DX thread is waiting for us, so nothing is published meanwhile)
+    if ( m_asyncPresent ) {
+        if ( m_mailbox.acquire( m_readSlot ) ) m_slotFrame[m_readSlot].eyes = 0;
+    } else {
+        FrameDescriptor frame;
+        while ( m_ring.peek( frame ) ) {
+            m_ring.pop();
+            m_frameDone.signal();
+        }
+    }
+    m_lastFrame.eyes = 0;
+
+    m_replaceState.store( REPLACE_IDLE );
+    m_targetsReplaced.signal();
+}//updateTargets
+
+//-----------------------------------------------------------------------------
+
+void Quadifier::joinSwapGroup()
+{
+    const unsigned group = Settings::get().swapGroup;
+    const unsigned barrier = Settings::get().swapBarrier;
+    if ( group == 0 ) return;
+
+    do {
+        if ( !glx.hasSwapGroup() ) {
+            Log::print( "warning: WGL_NV_swap_group is not supported, frames will not be locked\n" );
+            break;
+        }
+
+        HDC hdc = m_window.getHDC();
+
+        GLuint maxGroups = 0, maxBarriers = 0;
+        if ( !glx.wglQueryMaxSwapGroupsNV( hdc, &maxGroups, &maxBarriers ) ||
+             (group > maxGroups) || (barrier > maxBarriers)
+        ) {
+            Log::print( "warning: swap group " ) << group << " or barrier "
+                << barrier << " is not available (groups " << maxGroups
+                << ", barriers " << maxBarriers << ")\n";
+            break;
+        }
+
+        if ( !glx.wglJoinSwapGroupNV( hdc, group ) ) {
+            Log::print( "warning: failed to join swap group " ) << group << endl;
+            break;
+        }
+        m_swapGroup = group;
+
+        // the barrier synchronises the groups of all the nodes
+        if ( barrier != 0 ) {
+            if ( glx.wglBindSwapBarrierNV( group, barrier ) )
+                m_swapBarrier = barrier;
+            else
+                Log::print( "warning: failed to bind swap barrier " ) << barrier << endl;
+        }
+
+        if (Log::info()) {
+            Log::print( "joined swap group " ) << m_swapGroup
+                << ", barrier " << m_swapBarrier << endl;
+        }
+    } while (false_value);
+}
+
+//-----------------------------------------------------------------------------
+
+void Quadifier::leaveSwapGroup()
+{
+    if ( m_swapGroup == 0 ) return;
+
+    if ( m_swapBarrier != 0 )
+        glx.wglBindSwapBarrierNV( m_swapGroup, 0 );
+    glx.wglJoinSwapGroupNV( m_window.getHDC(), 0 );
+
+    // final frame lock status
+    if (Log::info()) {
+        Log::print( "left swap group " ) << m_swapGroup
+            << ", vblanks without a swap " << m_idleVBlanks << endl;
+    }
+
+    m_swapGroup = 0;
+    m_swapBarrier = 0;
+    m_frameCount = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+void Quadifier::onPaint()
+{
+    // read the settings once for the whole frame (they may be reloaded)
+    const Settings & settings = Settings::get();
+
+    // swap in any replacement targets before painting
+    updateTargets();
+
+    // pick the frame to paint: in asynchronous mode this is the latest frame
+    // in the mailbox, otherwise the oldest frame in the ring; if there is no
+    // new frame we simply repaint the last one
+    bool newFrame = false;
+    if ( m_asyncPresent ) {
+        if ( m_mailbox.acquire( m_readSlot ) ) {
+            m_lastFrame = m_slotFrame[m_readSlot];
+            newFrame = true;
+        }
+    } else
+        newFrame = m_ring.peek( m_lastFrame );
+
+    // in zero-copy mode we cannot repaint an old frame, since the back
+    // buffer may already hold part of the next one (leave the front buffer
+    // as it is instead)
+    if ( m_zeroCopy && !newFrame ) return;
+
+    // every eye's target must still hold this frame: DX only overwrites a
+    // queued target if it gave up waiting for us, and may reuse the targets
+    // of a frame once we have released it, so a late frame or a repaint can
+    // find a target from another frame (or one which is half rendered);
+    // a shared target is tagged with its last eye
+    unsigned mismatched = 0;
+    for (unsigned eye=0; eye<m_lastFrame.eyes; ++eye) {
+        const unsigned tagEye = m_lastFrame.shared ? m_lastFrame.eyes - 1 : eye;
+        if ( m_targetTag[m_lastFrame.target[eye]].load() !=
+             targetTag( m_lastFrame.frameId, tagEye )
+        )
+            ++mismatched;
+    }
+
+    if ( newFrame ) {
+        // frames which we never saw (dropped by a full ring, or replaced in
+        // the mailbox by a newer frame)
+        if ( m_painted && (m_lastFrame.frameId - m_paintedFrameId > 1) ) {
+            const unsigned frames = m_lastFrame.frameId - m_paintedFrameId - 1;
+            m_droppedEyes += frames * m_lastFrame.eyes;
+            if (Log::verbose())
+                Log::print() << "GL: " << frames << " frame(s) dropped before frame "
+                    << m_lastFrame.frameId << endl;
+        }
+        m_painted = true;
+        m_paintedFrameId = m_lastFrame.frameId;
+
+        if ( mismatched > 0 ) {
+            m_mismatchedEyes += mismatched;
+            Log::print( "warning: frame " ) << m_lastFrame.frameId
+                << " was overwritten before it was painted, skipping it\n";
+        }
+    }
+
+    if ( mismatched > 0 ) {
+        // leave the front buffer as it is, but release the frame
+        if ( newFrame && !m_asyncPresent ) {
+            m_ring.pop();
+            m_frameDone.signal();
+        }
+        m_lastFrame.eyes = 0;
+        return;
+    }
+
+    if ( !newFrame && m_painted ) m_repeatedEyes += m_lastFrame.eyes;
+
+    // GPU time-stamp at the start of the frame
+    m_gpuTimerGL.mark( POINT_START );
+
+    // draw to default framebuffer
+    glx.glBindFramebuffer( GL_DRAW_FRAMEBUFFER, 0 );
+
+    const FrameDescriptor & frame = m_lastFrame;
+
+    // gather the interop objects for all eyes, so that they can be locked
+    // (and later unlocked) in a single call: each lock/unlock synchronises
+    // the DX and GL drivers, so doing this once per frame halves the cost
+    // (both eyes of a double-wide frame are in the one target)
+    const unsigned views = frame.shared ? 1 : frame.eyes;
+    HANDLE objects[FrameDescriptor::MAX_VIEWS] = {};
+    GLint objectCount = 0;
+    for (unsigned eye=0; eye<views; ++eye) {
+        HANDLE object = m_target[frame.target[eye]].object;
+        if ( object == 0 ) break;
+        objects[objectCount++] = object;
+    }
+
+    // lock the shared DX/GL render targets
+    bool locked = false;
+    if ( m_readback ) {
+        // no interop: upload each new frame from the DX system memory copies
+        locked = ( frame.eyes > 0 );
+        for (unsigned eye=0; newFrame && (eye<views); ++eye) {
+            const Target & target = m_target[frame.target[eye]];
+            m_readbackRing.upload(
+                target.texture, target.width, target.height, target.pixels, target.pitch
+            );
+        }
+    } else if ( objectCount > 0 ) {
+        const double lockStart = getTime();
+        {
+            Trace::Scope trace( Trace::LOCK, frame.frameId, 0 );
+            locked = ( objectCount == static_cast<GLint>(views) ) &&
+                ( glx.wglDXLockObjectsNV( m_interopGLDX, objectCount, objects ) == GL_TRUE );
+        }
+        m_hudLockTime += 1000.0 * (getTime() - lockStart);
+        ++m_hudLocks;
+
+        if ( !locked )
+            Log::print( "unable to lock DX target on paint\n" );
+    }
+    m_gpuTimerGL.mark( POINT_LOCKED );
+
+    // bind the present pipeline state once for all eyes
+    if ( locked && !m_useBlit ) {
+        m_present.begin();
+
+        // a frame captured at a reduced resolution is sharpened as it is
+        // scaled back up
+        m_present.setSharpen( (frame.scale < 1.f) ? settings.sharpen / 100.f : 0.f );
+
+        // late-latch: rotate the image by however far the tracked head has
+        // turned since the frame was rendered (or not at all, if either
+        // pose is unknown)
+        if ( m_pose.isOpen() ) {
+            float rotation[9] = { 1.f,0.f,0.f, 0.f,1.f,0.f, 0.f,0.f,1.f };
+            SharedPose::Pose pose;
+            if ( frame.posed && m_pose.read( settings.reprojectSensor, pose ) )
+                reprojectionMatrix( frame.rotation, pose.rotation, rotation );
+
+            const float tanX = std::tan(
+                0.5f * settings.reprojectFov * 3.14159265f / 180.f
+            );
+            const float tanY = ( m_width > 0 ) ?
+                tanX * static_cast<float>(m_height) / m_width : tanX;
+            m_present.setReprojection( rotation, tanX, tanY );
+        }
+    }
+
+    // passive stereo: both eyes go into the one back buffer, in one pass
+    const bool packed = locked && (m_packing != Settings::PACKING_NONE) &&
+        (frame.eyes >= 2);
+    if ( packed ) {
+        if (Log::verbose()) Log::print( "GL: rendering packed stereo frame\n" );
+        glDrawBuffer( GL_BACK );
+        presentPacked( frame );
+    }
+
+    // for each eye
+    if ( !packed && Log::verbose() ) Log::print( "GL: rendering stereo frame\n" );
+    for (unsigned eye=0; locked && !packed && (eye<frame.eyes); ++eye) {
+        // get the GL draw buffer identifier for this eye (views beyond the
+        // two eyes are only for the output windows)
+        GLuint drawBuffer = frame.drawBuffer[eye];
+        if ( drawBuffer == GL_NONE ) continue;
+
+        // select the GL draw buffer (GL_BACK or GL_BACK_LEFT or GL_BACK_RIGHT)
+        if (Log::verbose()) {
+            Log::print() << "GL: render " << frame.target[eye] << " to "
+                 << GLDRAWBUFFERtoString(drawBuffer) << endl;
+        }
+        glDrawBuffer( drawBuffer );
+
+        // draw the DX surface we are reading from
+        present( frame, eye );
+    }
+
+    if ( locked && !m_useBlit ) m_present.end();
+
+    // pass each new frame on to the output windows (while still locked),
+    // each showing its own pair of views as its left and right eyes
+    if ( locked && newFrame && !m_outputs.empty() ) {
+        for (unsigned i=0; i<m_outputs.size(); ++i) {
+            GLuint frameBuffer[2] = {};
+            GLuint drawBuffer[2] = {};
+            unsigned originX[2] = {};
+            unsigned width = 0;
+            unsigned height = 0;
+            unsigned eyes = 0;
+            for (; eyes<2; ++eyes) {
+                const unsigned view = m_outputs[i]->view( eyes );
+                if ( view >= frame.eyes ) break;
+                frameBuffer[eyes] = m_target[frame.target[view]].frameBuffer;
+                drawBuffer[eyes] = ( frame.eyes == 1 ) ? frame.drawBuffer[0] :
+                    ( eyes == 0 ) ? GL_BACK_LEFT : GL_BACK_RIGHT;
+                eyeRegion( frame, view, originX[eyes], width, height );
+            }
+            m_outputs[i]->copy(
+                frameBuffer, drawBuffer, originX, eyes, width, height
+            );
+        }
+    }
+
+    // unlock the shared DX/GL targets together
+    if ( locked && (objectCount > 0) ) {
+        Trace::Scope trace( Trace::UNLOCK, frame.frameId, 0 );
+        glx.wglDXUnlockObjectsNV( m_interopGLDX, objectCount, objects );
+    }
+    m_gpuTimerGL.mark( POINT_PRESENTED );
+
+    // start reading back each new frame for the recording and the display
+    // nodes (before the overlay is drawn over it): this never waits for
+    // the GPU
+    // (a packed frame is a single image, holding both eyes)
+    if ( locked && newFrame ) {
+        const double paintTime = getTime();
+        const unsigned packedBuffer[1] = { GL_BACK };
+        const unsigned *drawBuffers = packed ? packedBuffer : frame.drawBuffer;
+        const unsigned eyes = packed ? 1 : ( frame.eyes < 2 ? frame.eyes : 2 );
+        m_recorder.capture(
+            frame.frameId, paintTime, drawBuffers, eyes, 0, 0, m_width, m_height
+        );
+        m_streamer.capture(
+            frame.frameId, paintTime, drawBuffers, eyes, m_width, m_height
+        );
+    }
+
+    // draw the left/right stereo channel indicator and the HUD
+    ++m_hudPaints;
+    if ( settings.stereoIndicator || settings.hud )
+        drawOverlay( settings.stereoIndicator, settings.hud );
+
+    // swap the buffers (in a swap group, this is where we wait for the
+    // other nodes, so the CPU time spent here is the barrier wait)
+    const double swapStart = getTime();
+    {
+        Trace::Scope trace( Trace::SWAP, frame.frameId, 0 );
+        m_window.swapBuffers();
+    }
+    m_gpuTimerGL.mark( POINT_SWAPPED );
+    if ( m_swapGroup != 0 ) {
+        m_statsGL.record( STAT_BARRIER, 1000.0 * (getTime() - swapStart) );
+
+        // count the frame-locked vblanks which went by without a swap of
+        // ours (this node, or another node, was late)
+        GLuint frameCount = 0;
+        if ( glx.wglQueryFrameCountNV( m_window.getHDC(), &frameCount ) ) {
+            if ( (m_frameCount != 0) && (frameCount > m_frameCount + 1) )
+                m_idleVBlanks += frameCount - m_frameCount - 1;
+            m_frameCount = frameCount;
+        }
+    }
+
+    // collect the GPU timing results of an earlier frame, if available
+    double elapsed[GpuTimerGL::POINTS] = {};
+    if ( m_gpuTimerGL.endFrame( elapsed ) ) {
+        m_statsGL.record( STAT_LOCK, elapsed[POINT_LOCKED] );
+        m_statsGL.record( STAT_PRESENT, elapsed[POINT_PRESENTED] - elapsed[POINT_LOCKED] );
+        m_statsGL.record( STAT_SWAP, elapsed[POINT_SWAPPED] - elapsed[POINT_PRESENTED] );
+        m_statsGL.record( STAT_PAINT, elapsed[POINT_SWAPPED] );
+    }
+
+    if ( newFrame ) {
+        // latency from the DX present to the completion of the GL swap
+        const double latency = 1000.0 * (getTime() - frame.presentTime);
+        m_statsGL.record( STAT_LATENCY, latency );
+
+        // periodic report
+        const unsigned interval = settings.statsInterval;
+        if ( (interval > 0) && (m_statsGL.count( STAT_LATENCY ) % interval == 0) ) {
+            m_statsGL.report();
+            Log::print( "GL eyes: dropped " ) << m_droppedEyes
+                << ", repeated " << m_repeatedEyes
+                << ", mismatched " << m_mismatchedEyes << endl;
+            if ( m_swapGroup != 0 ) {
+                Log::print( "GL frame lock: swap group " ) << m_swapGroup
+                    << ", barrier " << m_swapBarrier
+                    << ", frame count " << m_frameCount
+                    << ", vblanks without a swap " << m_idleVBlanks << endl;
+            }
+        }
+    }
+
+    // in synchronous mode, release the frame from the ring (its targets can
+    // now be reused) and signal that we've processed one complete frame
+    if ( newFrame && !m_asyncPresent ) {
+        m_ring.pop();
+        m_frameDone.signal();
+    }
+
+
+    // in verbose mode, log the point at which GL swap occurs
+    if (Log::verbose()) Log::print( "GLSWAP\n" );
+
+    // performance statistics are collected in stereo mode
+    if ( m_stereoMode ) {
+        // record time-stamp of first/last frame
+        if ( m_framesGL == 0 )
+            m_firstFrameTimeGL = getTime();
+        else
+            m_lastFrameTimeGL = getTime();
+
+        // count GL frames
+        ++m_framesGL;
+    }
+}//onPaint
+
+//-----------------------------------------------------------------------------
+
+void Quadifier::onResize( UINT /*type*/, int w, int h )
+{
+    glViewport( 0, 0, w, h );
+    m_width  = w;
+    m_height = h;
+    redraw();
+}
+
+//-----------------------------------------------------------------------------
+
+void Quadifier::onStereoSignal( unsigned view )
+{
+    if (Log::verbose()) Log::print( "stereo signal " ) << view << endl;
+    Trace::Scope trace( Trace::STEREO_SIGNAL, m_capture.frameId, view );
+
+    // each view follows the one captured before it (view 0 is started by
+    // the frame itself), and there are only so many targets for them
+    if ( (view != m_capture.eyes + 1) || (view >= m_views) ) {
+        if (Log::verbose())
+            Log::print( "ignoring the signal for view " ) << view
+                << " (capturing view " << m_capture.eyes << ")\n";
+        return;
+    }
+
+    // enable stereo mode and print a message to the log
+    if ( !m_stereoMode ) {
+        m_stereoMode = true;
+        if ( Log::info() )
+            Log::print( "Stereo enabled" ) << endl;
+    }
+
+    // end capturing and send the left stereo frame (or the view before)
+    endCapture( viewDrawBuffer( view - 1, false ), false );
+
+    // begin capturing the right stereo frame, or the next view (in double-
+    // wide mode it goes into the same target, which is already bound)
+    if ( !m_doubleWide ) beginCapture();
+}
+
+//-----------------------------------------------------------------------------
+
+void Quadifier::onPluginSignal( unsigned view )
+{
+    // the plugin event is issued on the render thread (our DX thread), in
+    // order with the D3D calls, so it is handled just like the viewport
+    Quadifier *quad = s_current.load();
+    if ( (quad == 0) || Settings::get().passThrough ) return;
+
+    if ( !quad->m_pluginSignal ) {
+        quad->m_pluginSignal = true;
+        if ( Log::info() )
+            Log::print( "Stereo signal from the native plugin" ) << endl;
+    }
+
+    quad->onStereoSignal( view );
+}//onPluginSignal
+
+//-----------------------------------------------------------------------------
+
+void Quadifier::onIdle()
+{
+    // the DX thread may be waiting for the targets to be replaced
+    updateTargets();
+
+    // is there a new frame waiting?
+    bool pending = m_asyncPresent ? m_mailbox.isFresh() : !m_ring.empty();
+
+    if ( pending ) {
+        // a new frame has been queued: when pacing, hold it until shortly
+        // before the next vblank (if woken early by a message or another
+        // frame, we come back here once that has been dealt with)
+        if ( m_pacer.isEnabled() ) {
+            if ( !m_pacer.wait( m_frameReady ) ) return;
+            if ( m_pacer.lastLate() >= 0.0 )
+                m_statsGL.record( STAT_TIMER, 1000.0 * m_pacer.lastLate() );
+        }
+
+        // paint it
+        redraw();
+    } else if ( m_extrapolate && m_painted && (m_lastFrame.eyes > 0) ) {
+        // no new frame: paint the last one again on the display's clock,
+        // reprojected to the newest pose (a frame which arrives meanwhile
+        // is painted as it would have been; a frame which was overwritten
+        // is not painted again)
+        if ( m_pacer.isEnabled() ) {
+            if ( !m_pacer.wait( m_frameReady ) ) return;
+        } else if ( MsgWaitForMultipleObjects(
+                1, &m_frameReady, FALSE, m_refreshPeriod, QS_ALLINPUT
+            ) != WAIT_TIMEOUT )
+            return;
+        redraw();
+    } else {
+        // sleep until the DX thread queues a frame, or a window message
+        // arrives (the timeout is only a safety net); the time it takes us
+        // to wake for a frame queued while we slept is the scheduling delay
+        // the GL thread sees
+        const double sleepTime = getTime();
+        if ( MsgWaitForMultipleObjects(
+                1, &m_frameReady, FALSE, 100, QS_ALLINPUT
+            ) == WAIT_OBJECT_0 ) {
+            const double readyTime = m_readyTime.load();
+            if ( readyTime >= sleepTime )
+                m_statsGL.record( STAT_WAKE, 1000.0 * (getTime() - readyTime) );
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void Quadifier::redraw()
+{
+    // force an immediate paint
+    m_window.invalidate();
+    m_window.update();
+}
+
+//-----------------------------------------------------------------------------
+
+void Quadifier::drawStereoIndicator()
+{
+    const int size = 32;
+
+    GLint viewport[4] = {};
+    glGetIntegerv( GL_VIEWPORT, viewport );
+
+    // save OpenGL state
+    glPushAttrib( GL_ENABLE_BIT | GL_CURRENT_BIT | GL_TRANSFORM_BIT );
+
+        glMatrixMode( GL_PROJECTION );
+        glPushMatrix();
+        glLoadIdentity();
+        glOrtho(
+            0.0, static_cast<double>(viewport[2]),
+            0.0, static_cast<double>(viewport[3]),
+            -1.0, 1.0
+        );
+
+        glMatrixMode( GL_MODELVIEW );
+        glPushMatrix();
+        glLoadIdentity();
+
+        glEnable( GL_COLOR_MATERIAL );
+
+        glDrawBuffer( GL_BACK_LEFT );
+        glColor3f( 0.f, 0.f, 1.f );
+        glRecti( 0, 0, size, size );
+
+        glDrawBuffer( GL_BACK_RIGHT );
+        glColor3f( 1.f, 0.f, 0.f );
+        glRecti( 0, 0, size, size );
+
+        // restore modelview matrix
+        glPopMatrix();
+
+        // restore projection matrix
+        glMatrixMode( GL_PROJECTION );
+        glPopMatrix();
+
+    // restore OpenGL state
+    glPopAttrib();
+}//drawStereoIndicator
+
+//-----------------------------------------------------------------------------
+
+void Quadifier::drawOverlay( bool indicator, bool hud )
+{
+    if ( !m_overlay.isValid() ) {
+        if ( indicator ) drawStereoIndicator();
+        return;
+    }
+
+    // refresh the HUD text a couple of times a second (the overlay only
+    // rewrites its vertices when the text actually changes)
+    const double HUD_INTERVAL = 0.5;
+    const double now = getTime();
+    const double elapsed = now - m_hudTime;
+    if ( elapsed >= HUD_INTERVAL ) {
+        // frame ids count completed DX frames, so their rate is the DX rate
+        const unsigned frameId = m_lastFrame.frameId;
+        std::ostringstream text;
+        text << fixed << setprecision(1)
+             << "GL " << m_hudPaints / elapsed << " FPS\n"
+             << "DX " << (frameId - m_hudFrameId) / elapsed << " FPS\n"
+             << setprecision(2)
+             << "LOCK " << ( m_hudLocks > 0 ? m_hudLockTime / m_hudLocks : 0.0 ) << " MS\n"
+             << "EYES DROPPED " << m_droppedEyes << '\n'
+             << "EYES REPEATED " << m_repeatedEyes << '\n'
+             << "EYES MISMATCHED " << m_mismatchedEyes;
+        if ( m_countCalls ) {
+            text << "\nDRAWS " << m_hudDraws[0].load( std::memory_order_relaxed )
+                 << " / " << m_hudDraws[1].load( std::memory_order_relaxed )
+                 << "\nSTATES " << m_hudStates[0].load( std::memory_order_relaxed )
+                 << " / " << m_hudStates[1].load( std::memory_order_relaxed );
+        }
+        m_hudText = text.str();
+
+        m_hudTime = now;
+        m_hudPaints = 0;
+        m_hudFrameId = frameId;
+        m_hudLockTime = 0.0;
+        m_hudLocks = 0;
+    }
+
+    m_overlay.update( indicator ? 32 : 0, hud ? m_hudText : std::string() );
+    m_overlay.draw( m_width, m_height );
+}
+
+//-----------------------------------------------------------------------------
+
+void Quadifier::present( const FrameDescriptor & frame, unsigned eye )
+{
+    const Target & target = m_target[frame.target[eye]];
+    if ( target.width == 0 ) return;
+    Trace::Scope trace( Trace::BLIT, frame.frameId, eye );
+
+    // the part of the target holding this eye (the image is stored top
+    // row first, so this is also the bottom of the GL framebuffer)
+    unsigned x = 0;
+    unsigned width = 0;
+    unsigned height = 0;
+    eyeRegion( frame, eye, x, width, height );
+
+    if ( m_useBlit ) {
+        //-- render using framebuffer blitting
+        glx.glBindFramebuffer( GL_READ_FRAMEBUFFER, target.frameBuffer );
+
+        // blit from the read framebuffer to the display framebuffer
+        glx.glBlitFramebuffer(
+            x, 0, x + width, height,        // source rectangle
+            0, m_height, m_width, 0,        // destination: flip the image vertically
+            GL_COLOR_BUFFER_BIT,
+            GL_LINEAR
+        );
+    } else {
+        //-- render using texture (the shader flips the image vertically)
+        m_present.setRegion(
+            0,
+            static_cast<float>(x) / target.width,
+            0.f,
+            static_cast<float>(width) / target.width,
+            static_cast<float>(height) / target.height
+        );
+        m_present.draw( target.texture );
+    }
+}//present
+
+//-----------------------------------------------------------------------------
+
+void Quadifier::eyeRegion(
+    const FrameDescriptor & frame,
+    unsigned eye,
+    unsigned & x,
+    unsigned & width,
+    unsigned & height
+) const {
+    const Target & target = m_target[frame.target[eye]];
+    const unsigned eyeWidth = m_doubleWide ? target.width / 2 : target.width;
+    x = ( frame.shared && (eye == 1) ) ? eyeWidth : 0;
+    width = eyeWidth;
+    height = target.height;
+
+    // the application's viewports were scaled by the same rule
+    if ( frame.scale < 1.f ) {
+        width = scaleSize( width, frame.scale );
+        height = scaleSize( height, frame.scale );
+    }
+}//eyeRegion
+
+//-----------------------------------------------------------------------------
+
+void Quadifier::presentPacked( const FrameDescriptor & frame )
+{
+    const Target & left = m_target[frame.target[0]];
+    const Target & right = m_target[frame.target[1]];
+    if ( (left.width == 0) || (right.width == 0) ) return;
+    Trace::Scope trace( Trace::BLIT, frame.frameId, 0 );
+
+    // the part of the target(s) holding each eye
+    unsigned originX[2] = {};
+    unsigned eyeWidth[2] = {};
+    unsigned eyeHeight[2] = {};
+    eyeRegion( frame, 0, originX[0], eyeWidth[0], eyeHeight[0] );
+    eyeRegion( frame, 1, originX[1], eyeWidth[1], eyeHeight[1] );
+
+    if ( m_useBlit ) {
+        //-- blit each eye into its half of the frame (rows cannot be blitted)
+        const bool topBottom = ( m_packing == Settings::PACKING_TOP_BOTTOM );
+        const GLint width = static_cast<GLint>( m_width );
+        const GLint height = static_cast<GLint>( m_height );
+        const Target *eyes[2] = { &left, &right };
+        for (unsigned eye=0; eye<2; ++eye) {
+            const Target & target = *eyes[eye];
+            GLint x0 = 0, y0 = 0, x1 = width, y1 = height;
+            if ( topBottom ) {
+                // the left eye goes in the top half
+                y0 = ( eye == 0 ) ? height / 2 : 0;
+                y1 = ( eye == 0 ) ? height : height / 2;
+            } else {
+                x0 = ( eye == 0 ) ? 0 : width / 2;
+                x1 = ( eye == 0 ) ? width / 2 : width;
+            }
+
+            glx.glBindFramebuffer( GL_READ_FRAMEBUFFER, target.frameBuffer );
+            glx.glBlitFramebuffer(
+                originX[eye], 0, originX[eye] + eyeWidth[eye], eyeHeight[eye],
+                x0, y1, x1, y0,                 // destination: flip the image vertically
+                GL_COLOR_BUFFER_BIT,
+                GL_LINEAR
+            );
+        }
+    } else {
+        //-- render using textures (the shader picks the eye for each pixel)
+        m_present.setRegion(
+            0,
+            static_cast<float>(originX[0]) / left.width,
+            0.f,
+            static_cast<float>(eyeWidth[0]) / left.width,
+            static_cast<float>(eyeHeight[0]) / left.height
+        );
+        m_present.setRegion(
+            1,
+            static_cast<float>(originX[1]) / right.width,
+            0.f,
+            static_cast<float>(eyeWidth[1]) / right.width,
+            static_cast<float>(eyeHeight[1]) / right.height
+        );
+        m_present.drawPacked( left.texture, right.texture, m_height );
+    }
+}//presentPacked
+
+//-----------------------------------------------------------------------------
+
+LRESULT CALLBACK Quadifier::windowProc(
+    HWND hWnd,      // handle to window
+    UINT uMsg,      // message identifier
+    WPARAM wParam,  // first message parameter
+    LPARAM lParam   // second message parameter
+) {
+    switch (uMsg) {
+    case WM_DESTROY:
+        onDestroy();
+        return 0L;
+
+    case WM_PAINT:
+        {
+            PAINTSTRUCT paintStruct = {};
+            (void)BeginPaint( hWnd, &paintStruct );
+            onPaint();
+            EndPaint( hWnd, &paintStruct );
+        }
+        return 0L;
+
+    case WM_SIZE:
+        onResize( static_cast<UINT>(wParam), LOWORD(lParam), HIWORD(lParam) );
+        return 0L;
+
+    // forward all these messages to the source window
+    case WM_CLOSE:
+    case WM_CHAR:
+    case WM_KEYDOWN:
+    case WM_KEYUP:
+    case WM_MOUSEMOVE:
+    case WM_MOUSEWHEEL:
+    case WM_LBUTTONDOWN:
+    case WM_LBUTTONUP:
+    case WM_LBUTTONDBLCLK:
+    case WM_RBUTTONDOWN:
+    case WM_RBUTTONUP:
+    case WM_RBUTTONDBLCLK:
+    case WM_MBUTTONDOWN:
+    case WM_MBUTTONUP:
+    case WM_MBUTTONDBLCLK:
+        PostMessage( m_sourceWindow, uMsg, wParam, lParam );
+        return 0L;
+    }
+
+    return DefWindowProc( hWnd, uMsg, wParam, lParam );
+}//windowProc
+
+//-----------------------------------------------------------------------------
+
+LRESULT CALLBACK WindowProc(
+    HWND hWnd,      // handle to window
+    UINT uMsg,      // message identifier
+    WPARAM wParam,  // first message parameter
+    LPARAM lParam   // second message parameter
+) {
+    if (uMsg == WM_NCCREATE) {
+        // the WM_NCREATE is one of the first messages sent, and includes a
+        // pointer to the LPCREATESTRUCT. in this structure, we put our window
+        // class pointer at creation time. therefore we can retrieve it now,
+        // and store in GWL_USERDATA so that we can retrieve it later.
+
+        Quadifier *self = reinterpret_cast<Quadifier*>(
+            reinterpret_cast<LPCREATESTRUCT>(lParam)->lpCreateParams
+        );
+        if ( self != 0 ) {
+            SetWindowLongPtr(
+                hWnd,
+                GWLP_USERDATA,
+                reinterpret_cast<LONG_PTR>(self)
+            );
+        }
+    }
+
+    // attempt to get window pointer from GWL_USERDATA
+    Quadifier *self = reinterpret_cast<Quadifier*>(
+        GetWindowLongPtr( hWnd, GWLP_USERDATA )
+    );
+    
+    // pass message onto the window, or fall-back to default
+    if ( self != 0 )
+        return self->windowProc( hWnd, uMsg, wParam, lParam );
+    else
+        return DefWindowProc( hWnd, uMsg, wParam, lParam );
+}//WindowProc
+
+//-----------------------------------------------------------------------------
+
+LRESULT CALLBACK WindowProcSource(
+    HWND hWnd,      // handle to window
+    UINT uMsg,      // message identifier
+    WPARAM wParam,  // first message parameter
+    LPARAM lParam   // second message parameter
+) {
+    // get the old window proc pointer
+    WNDPROC oldWindowProc = reinterpret_cast<WNDPROC>(
+        GetWindowLongPtr( hWnd, GWLP_USERDATA )
+    );
+
+    //// log windows messages
+    //Log::print()
+    //    << "SRC " << windowsMessageToString( uMsg )
+    //    << ',' << hex << wParam << ',' << lParam << dec << endl;
+
+    switch (uMsg) {
+    case WM_ERASEBKGND:
+        // Ignore the WM_ERASEBKGND message
+        return TRUE;
+
+    case WM_SIZE:
+        {
+            // keep the GL window covering the client area (asynchronously,
+            // since the GL window belongs to the rendering thread)
+            HWND window = reinterpret_cast<HWND>( GetProp( hWnd, PROP_WINDOW ) );
+            if ( window != 0 ) {
+                SetWindowPos(
+                    window, 0, 0, 0, LOWORD(lParam), HIWORD(lParam),
+                    SWP_NOZORDER | SWP_NOACTIVATE | SWP_ASYNCWINDOWPOS
+                );
+            }
+        }
+        break;
+    }
+
+    // call the original window proc
+    return CallWindowProc( oldWindowProc, hWnd, uMsg, wParam, lParam );
+}//WindowProcSource
+
+//-----------------------------------------------------------------------------
+
+unsigned __stdcall Quadifier::threadFunc( void *context )
+{
+    if (Log::info()) Log::print( "GL rendering thread started\n" );
+
+    Quadifier *self = reinterpret_cast<Quadifier*>( context );
+
+    if ( self == 0 ) {
+        _endthreadex( 0 );
+        return 0;
+    }
+
+    // Get the old window proc of the source window
+    LONG_PTR oldWindowProc = GetWindowLongPtr( self->m_sourceWindow, GWLP_WNDPROC );
+
+    // Store the oldWindowProc pointer in user data on the source window
+    // (this pointer is later used to call the original window proc)
+    SetWindowLongPtr( self->m_sourceWindow, GWLP_USERDATA, oldWindowProc );
+
+    // Change the source window proc to point to our own WindowProcSource
+    // function. This allows us to subclass the window in the source
+    // application and intercept its messages.
+    SetWindowLongPtr(
+        self->m_sourceWindow, GWLP_WNDPROC,
+        reinterpret_cast<LONG_PTR>(WindowProcSource)
+    );
+
+    // output GL window style
+    DWORD dwStyle = WS_CLIPCHILDREN | WS_CLIPSIBLINGS | WS_CHILD;
+
+    // output GL window extended style
+    DWORD dwExStyle = 0;
+
+    // copy window rect from source window, so that the new window is
+    // positioned directly on top of the original window
+    RECT rect = {};
+    GetClientRect( self->m_sourceWindow, &rect );
+
+    // window creation attributes
+    GLWindow::Attributes attributes;
+
+    // if stereo is supported
+    if ( self->m_stereoAvailable ) {
+        // enable stereo
+        attributes[WGL_STEREO_ARB] = GL_TRUE;
+    }
+
+    // set depth and stencil attributes
+    attributes[WGL_DEPTH_BITS_ARB] = 0;
+    attributes[WGL_STENCIL_BITS_ARB] = 0;
+
+    // number of desired anti-alias samples to match DirectX
+    unsigned desiredSamples = self->m_samplesDX;
+
+    // do we want to match original number of multisamples used in DirectX?
+    // if not, set it to zero
+    if ( Settings::get().matchOriginalMSAA ) {
+        if (Log::info())
+            Log::print()
+                << "matchOriginalMSAA is ENABLED\n"
+                << "GL will attempt to use the same multisample format as DX\n";
+    } else {
+        if (Log::info())
+            Log::print()
+                << "matchOriginalMSAA is DISABLED\n"
+                << "GL is not forced to use the sample multisample format as DX\n";
+
+        desiredSamples = 0;
+    }
+
+    // optional: request the same number of multisamples as DirectX
+    if ( desiredSamples > 0 ) {
+        attributes[WGL_SAMPLE_BUFFERS_ARB] = GL_TRUE;
+        attributes[WGL_SAMPLES_ARB] = desiredSamples;
+    }
+
+    // a no-error context in release builds, so that the driver skips
+    // validating each call, and a debug context (KHR_debug) in debug builds;
+    // both keep the compatibility profile, as the blit, HUD and stereo
+    // indicator use fixed function GL (the driver may refuse either, and
+    // then a legacy context is used)
+    GLWindow::Attributes context;
+#if defined(NDEBUG)
+    context[WGL_CONTEXT_OPENGL_NO_ERROR_ARB] = GL_TRUE;
+#else
+    context[WGL_CONTEXT_FLAGS_ARB] = WGL_CONTEXT_DEBUG_BIT_ARB;
+#endif
+
+    // create our OpenGL window
+    if ( !self->m_window.create(
+        dwExStyle,
+        L"Quadifier",
+        dwStyle,
+        0, 0,
+        rect.right - rect.left,
+        rect.bottom - rect.top,
+        self->m_sourceWindow,
+        0,
+        WindowProc,
+        self,
+        attributes,
+        context
+    ) ) {
+        Log::print( "error: failed to create OpenGL window\n" );
+        _endthreadex( 0 );
+        return 0;
+    }
+
+    // let the source window find the GL window, to resize it with its own
+    SetProp( self->m_sourceWindow, PROP_WINDOW, self->m_window.getHWND() );
+
+    // did we get the requested number of anti-alias samples?
+    if ( self->m_window.getSamples() != desiredSamples ) {
+        // warn the user in this case: this can result in failure when
+        // the anti-aliasing in DirectX is higher than the GL context
+        Log::print( "warning: unable to create OpenGL window with " )
+            << desiredSamples << "x anti-alias samples\n"
+            << "This may cause wglDXRegisterObjectNV to fail.\n"
+            << "Please check if anti-aliasing is forced off in the driver settings.\n";
+    }
+
+    // check the cached probe against the real window: more samples than
+    // requested means the driver is forcing them; a wrong entry is fixed
+    // for the next device (these targets have already been created)
+    {
+        ProbeCache::Result actual = self->m_probe;
+        unsigned samples = self->m_window.getSamples();
+        if ( samples > desiredSamples )
+            actual.forcedSamples = ( samples > 16 ) ? 16 : samples;
+        actual.interop = ( wglGetProcAddress( "wglDXOpenDeviceNV" ) != 0 );
+        if ( (actual.forcedSamples != self->m_probe.forcedSamples) ||
+             (actual.interop != self->m_probe.interop)
+        ) {
+            Log::print( "warning: GL probe cache was out of date, updated\n" );
+            ProbeCache::store( self->m_adapter, actual );
+        }
+    }
+
+    // real-time scheduling of the GL thread (optional)
+    {
+        const Settings & settings = Settings::get();
+        if ( !settings.renderTask.empty() || (settings.renderCore > 0) ||
+             settings.renderPriority || (settings.timerPeriod > 0) )
+            self->m_renderScheduling.enter(
+                settings.renderTask,
+                static_cast<int>( settings.renderCore ) - 1,
+                settings.renderPriority,
+                settings.timerPeriod
+            );
+    }
+
+    // call onCreate to carry out OpenGL setup
+    if ( self->onCreate() ) {
+        // show window without activating it
+        self->m_window.show( SW_SHOWNA );
+
+        MSG message;
+
+        do {
+            if ( PeekMessage( &message, NULL, 0, 0, PM_REMOVE ) ) {
+                TranslateMessage( &message );
+                DispatchMessage( &message );
+            } else {
+                // no message waiting: idle
+                self->onIdle();
+            }
+        } while ( message.message != WM_QUIT );
+
+        if (Log::info()) Log::print( "WM_QUIT\n" );
+    } else {
+        Log::print( "Failed when initialising OpenGL resources: exiting\n" );
+        PostMessage( self->m_sourceWindow, WM_QUIT, 0, 0 );
+    }
+
+    self->m_renderScheduling.leave();
+
+    _endthreadex( 0 );
+
+    return 0;
+}//ThreadFunc
+
+//-----------------------------------------------------------------------------
+
+double Quadifier::getTime() const {
+    return Clock::seconds();
+}
+
+//-----------------------------------------------------------------------------
+
+void Quadifier::markCaptureStart() {
+    // record the time at which capture of the frame started
+    if ( (m_capture.eyes == 0) && (m_capture.captureTime == 0.0) )
+        m_capture.captureTime = getTime();
+
+    // record the tracker rotation the frame is (about to be) rendered with
+    SharedPose::Pose pose;
+    if ( !m_capture.posed && m_pose.isOpen() &&
+         m_pose.read( Settings::get().reprojectSensor, pose )
+    ) {
+        for (unsigned i=0; i<4; ++i)
+            m_capture.rotation[i] = pose.rotation[i];
+        m_capture.posed = true;
+    }
+
+    // GPU time-stamp at the start of the frame (ignored if already begun)
+    m_gpuTimerDX.begin();
+}
+
+//-----------------------------------------------------------------------------
+
+void Quadifier::beginCapture() {
+    if (Log::verbose()) Log::print( "beginCapture\n" );
+    Trace::Scope trace( Trace::BEGIN_CAPTURE, m_capture.frameId, m_capture.eyes );
+
+    markCaptureStart();
+
+    // the presenter gets the frame before as soon as its copy is done
+    if ( m_presenter ) m_publisher.poll();
+
+#if defined(SUPPORT_D3D11)
+    if ( m_device11 != 0 ) {
+        // if the application is rendering to the back buffer (or to one of
+        // our targets, e.g. when switching eyes) then rebind the current
+        // target in its place, keeping the depth/stencil view
+        // the target no longer holds the frame it was tagged with
+        m_targetTag[m_drawBuffer].store( TAG_NONE );
+
+        ID3D11RenderTargetView *view = 0;
+        ID3D11DepthStencilView *depthStencil = 0;
+        m_context11->OMGetRenderTargets( 1, &view, &depthStencil );
+
+        if ( (view != 0) && (isBackBufferView( view ) || isTargetView( view )) ) {
+            if (Log::verbose())
+                Log::print() << "OMSetRenderTargets("
+                    << m_target[m_drawBuffer].view11 << ") "
+                    << "(drawBuffer==" << m_drawBuffer << ")\n";
+            m_context11->OMSetRenderTargets(
+                1, &m_target[m_drawBuffer].view11, depthStencil
+            );
+        }
+
+        if ( view != 0 ) view->Release();
+        if ( depthStencil != 0 ) depthStencil->Release();
+        return;
+    }
+#endif
+
+    // in zero-copy mode the final eye (the right eye, or a 2D frame) is
+    // rendered into the back buffer, which may already be bound
+    if ( m_zeroCopy ) {
+        m_captureBack = ( m_capture.eyes > 0 ) || !m_stereoMode;
+        m_targetTag[currentTarget()].store( TAG_NONE );
+
+        IDirect3DSurface9 *renderTarget = 0;
+        if ( m_device->GetRenderTarget( 0, &renderTarget ) == S_OK ) {
+            renderTarget->Release();
+            if ( renderTarget == m_target[currentTarget()].surface ) return;
+        }
+    }
+
+    // the target no longer holds the frame it was tagged with
+    m_targetTag[currentTarget()].store( TAG_NONE );
+
+    // the surface to render into
+    IDirect3DSurface9 *surface = m_target[currentTarget()].surface;
+
+    // save the current viewport
+    D3DVIEWPORT9 viewport = {};
+    bool savedViewport = (m_device->GetViewport( &viewport ) == D3D_OK);
+
+    // display render target parameters
+    if (Log::verbose()) {
+        Log::print() << "SetRenderTarget("
+            << 0 << ','
+            << surface << ") "
+            << "(drawBuffer==" << currentTarget() << ")\n";
+    }
+
+    // set the render target to the surface
+    // any subsequent drawing (by the Direct3D application) will be rendered
+    // into this surface
+    // note: setting a new render target causes the viewport to be set to the
+    // full size of the new render target
+    if (m_device->SetRenderTarget( 0, surface ) != D3D_OK) {
+        Log::print( "Error Setting Render Target\n " );
+        exit( 1 );
+    }
+
+    // a double-wide target needs a depth/stencil buffer as wide as itself
+    if ( m_doubleWide && (m_target[0].depth != 0) )
+        m_device->SetDepthStencilSurface( m_target[0].depth );
+
+    // restore the viewport (adjusted for this frame and eye: if we set
+    // the saved one, start again from the application's)
+    if (savedViewport) {
+        if ( (m_capture.scale < 1.f) || m_doubleWide ) {
+            if ( sameViewport( viewport, m_setViewport ) ) viewport = m_appViewport;
+            m_appViewport = viewport;
+            m_setViewport = captureViewport( viewport );
+            viewport = m_setViewport;
+        }
+        m_device->SetViewport( &viewport );
+    }
+}//beginCapture
+
+//-----------------------------------------------------------------------------
+
+void Quadifier::endCapture( GLuint drawBuffer, bool complete ) {
+    Trace::Scope trace( Trace::END_CAPTURE, m_capture.frameId, m_capture.eyes );
+    if (Log::verbose()) {
+        Log::print() << "endCapture " << currentTarget() << " to "
+            << GLDRAWBUFFERtoString( drawBuffer ) << endl;
+    }
+
+    // set the OpenGL draw buffer destination
+    // the application has already rendered into this buffer, and here we are
+    // just labelling the buffer with left/right/back as appropriate
+    // (in double-wide mode the target holds the frame only once the right
+    // eye is done, so the left eye leaves it untagged)
+    // the calls made for this view (counted from the end of the view
+    // before), then start counting the next one
+    if ( m_countCalls && (m_capture.eyes < m_views) ) {
+        const unsigned channel = 4 * m_capture.eyes;
+        m_statsCalls.record( channel + 0, m_calls.draws );
+        m_statsCalls.record( channel + 1, m_calls.primitives );
+        m_statsCalls.record( channel + 2, m_calls.states );
+        m_statsCalls.record( channel + 3, m_calls.targets );
+        if ( m_capture.eyes < 2 ) {
+            m_hudDraws[m_capture.eyes].store( m_calls.draws, std::memory_order_relaxed );
+            m_hudStates[m_capture.eyes].store( m_calls.states, std::memory_order_relaxed );
+        }
+    }
+    m_calls = Calls();
+
+    if ( m_capture.eyes < m_views ) {
+        if ( !m_doubleWide || complete ) {
+            m_targetTag[currentTarget()].store(
+                targetTag( m_capture.frameId, m_capture.eyes )
+            );
+        }
+        m_capture.target[m_capture.eyes] = currentTarget();
+        m_capture.drawBuffer[m_capture.eyes] = drawBuffer;
+        ++m_capture.eyes;
+    }
+
+    if ( complete ) {
+        // the frame is complete (right eye, last view or 2D)
+        completeFrame();
+    } else if ( m_doubleWide ) {
+        // the right eye goes in the right half of the same target
+        m_capture.shared = true;
+        m_eyeOffset = m_target[currentTarget()].width / 2;
+    } else if ( m_asyncPresent ) {
+        // the next view goes in the next target owned by this slot
+        m_drawBuffer = m_views * m_writeSlot + m_capture.eyes;
+    } else {
+        // select next draw buffer
+        m_drawBuffer = (m_drawBuffer + 1) % poolSize();
+    }
+
+    // count DX frames
+    if ( m_stereoMode ) ++m_framesDX;
+}//endCapture
+
+//-----------------------------------------------------------------------------
+
+GLuint Quadifier::viewDrawBuffer( unsigned view, bool last ) const {
+    if ( !m_stereoMode ) return GL_BACK;
+    if ( view >= 2 ) return GL_NONE;
+    return ( (view == 0) && !last ) ? GL_BACK_LEFT : GL_BACK_RIGHT;
+}//viewDrawBuffer
+
+//-----------------------------------------------------------------------------
+
+void Quadifier::completeFrame() {
+    // register the present thread with the GL thread's MMCSS task (once:
+    // the thread is the application's, so its priority is left alone)
+    if ( !m_presentScheduled ) {
+        m_presentScheduled = true;
+        const Settings & settings = Settings::get();
+        if ( settings.presentTask && !settings.renderTask.empty() )
+            m_presentScheduling.enter( settings.renderTask, -1, false, 0 );
+    }
+
+    // resolve the frame for GL (this is part of the capture time)
+    resolveFrame();
+    if ( m_readback ) readbackFrame();
+
+    m_capture.presentTime = getTime();
+
+    // GPU time-stamp at the end of the frame, and collect the GPU timing
+    // result of an earlier frame (if available)
+    double elapsed = 0.0;
+    const bool timed = m_gpuTimerDX.end( elapsed );
+    if ( timed )
+        m_statsDX.record( STAT_CAPTURE, elapsed );
+
+    // time since the last frame
+    if ( m_lastPresentTime > 0.0 )
+        m_statsDX.record( STAT_INTERVAL, 1000.0 * (m_capture.presentTime - m_lastPresentTime) );
+    m_lastPresentTime = m_capture.presentTime;
+
+    // CPU time spent capturing this frame
+    if ( m_capture.captureTime > 0.0 ) {
+        m_statsDX.record( STAT_FRAME, 1000.0 * (m_capture.presentTime - m_capture.captureTime) );
+
+        // periodic report
+        const unsigned interval = Settings::get().statsInterval;
+        if ( (interval > 0) && (m_statsDX.count( STAT_FRAME ) % interval == 0) ) {
+            m_statsDX.report();
+            if ( m_countCalls ) m_statsCalls.report();
+            ResourceTracker::report();
+        }
+    }
+
+    if ( m_presenter ) {
+        // copy the eyes into the presenter's targets (it shows only the
+        // first two views), and carry on in the same targets
+        IDirect3DSurface9 *surface[SharedFrames::EYES] = {};
+        RECT region[SharedFrames::EYES] = {};
+        unsigned eyes = m_capture.eyes;
+        if ( eyes > SharedFrames::EYES ) eyes = SharedFrames::EYES;
+        for (unsigned eye=0; eye<eyes; ++eye) {
+            unsigned x = 0, width = 0, height = 0;
+            eyeRegion( m_capture, eye, x, width, height );
+            surface[eye] = static_cast<IDirect3DSurface9*>(
+                m_target[m_capture.target[eye]].resource()
+            );
+            SetRect( &region[eye], x, 0, x + width, height );
+        }
+        const Target & first = m_target[m_capture.target[0]];
+        m_publisher.publish(
+            surface, region, eyes,
+            m_doubleWide ? first.width / 2 : first.width, first.height,
+            m_capture.frameId
+        );
+        m_drawBuffer = 0;
+    } else if ( m_asyncPresent ) {
+        // publish the frame to the GL thread and continue with whichever
+        // slot comes back from the mailbox
+        m_slotFrame[m_writeSlot] = m_capture;
+        m_writeSlot = m_mailbox.publish( m_writeSlot );
+        m_drawBuffer = m_views * m_writeSlot;
+    } else {
+        // queue the frame for the GL thread
+        if ( !m_ring.push( m_capture ) ) {
+            Log::print( "warning: frame ring full, dropping frame " )
+                << m_capture.frameId << endl;
+        }
+
+        // select next draw buffer (unless the frame ended in the back buffer,
+        // which is not part of the rotation)
+        if ( !m_captureBack )
+            m_drawBuffer = (m_drawBuffer + 1) % poolSize();
+        m_captureBack = false;
+    }
+
+    // wake the GL thread
+    if (Log::verbose()) Log::print( "sending new frame notification\n" );
+    m_readyTime.store( getTime() );
+    SetEvent( m_frameReady );
+
+    // pick the capture resolution of the next frame, from the GPU time of
+    // an earlier frame (or without GPU timing, the CPU time of this one)
+    const Settings & settings = Settings::get();
+    double frameTime = 0.0;
+    if ( m_gpuTimerDX.isValid() ) {
+        if ( timed ) frameTime = elapsed;
+    } else if ( m_capture.captureTime > 0.0 )
+        frameTime = 1000.0 * (m_capture.presentTime - m_capture.captureTime);
+    const float scale = m_resolution.update(
+        frameTime, settings.resolutionBudget / 1000.0, settings.minResolution / 100.f
+    );
+
+    // start the next frame
+    ++m_capture.frameId;
+    m_capture.eyes = 0;
+    m_capture.captureTime = 0.0;
+    m_capture.posed = false;
+    m_capture.shared = false;
+    m_capture.scale = scale;
+    m_eyeOffset = 0;
+}//completeFrame
+
+//-----------------------------------------------------------------------------
+
+unsigned Quadifier::currentTarget() const {
+    return m_captureBack ? poolSize() : m_drawBuffer;
+}
+
+//-----------------------------------------------------------------------------
+
+unsigned Quadifier::poolSize() const {
+    return static_cast<unsigned>( m_target.size() ) - ( m_zeroCopy ? 1 : 0 );
+}
+
+//-----------------------------------------------------------------------------
+
+void Quadifier::resolveFrame() {
+    // this is done once the frame is complete (rather than per eye, which
+    // may be in the middle of a scene), once for a shared target
+    const unsigned views = m_capture.shared ? 1 : m_capture.eyes;
+    for (unsigned eye=0; eye<views; ++eye) {
+        const Target & target = m_target[m_capture.target[eye]];
+
+#if defined(SUPPORT_D3D11)
+        if ( (target.resolve11 != 0) && (target.texture11 != 0) ) {
+            D3D11_TEXTURE2D_DESC desc = {};
+            target.texture11->GetDesc( &desc );
+            m_context11->ResolveSubresource(
+                target.resolve11, 0, target.texture11, 0, desc.Format
+            );
+            continue;
+        }
+#endif
+
+        if ( (target.resolve != 0) && (target.surface != 0) ) {
+            if ( m_device->StretchRect(
+                    target.surface, NULL, target.resolve, NULL, D3DTEXF_NONE
+                ) != D3D_OK )
+                Log::print( "error: failed to resolve DX render target\n" );
+        }
+    }
+}//resolveFrame
+
+//-----------------------------------------------------------------------------
+
+void Quadifier::readbackFrame() {
+    const unsigned views = m_capture.shared ? 1 : m_capture.eyes;
+    for (unsigned eye=0; eye<views; ++eye) {
+        Target & target = m_target[m_capture.target[eye]];
+        if ( target.system == 0 ) continue;
+
+        // the GL thread has finished with the previous copy, since the
+        // target is being reused
+        if ( target.pixels != 0 ) {
+            target.system->UnlockRect();
+            target.pixels = 0;
+        }
+
+        // note: this waits for the GPU to finish drawing the target
+        IDirect3DSurface9 *source = static_cast<IDirect3DSurface9*>( target.resource() );
+        if ( m_device->GetRenderTargetData( source, target.system ) != D3D_OK ) {
+            Log::print( "error: failed to read back DX render target\n" );
+            continue;
+        }
+
+        // the GL thread reads the pixels while the surface stays locked
+        D3DLOCKED_RECT locked = {};
+        if ( target.system->LockRect( &locked, NULL, D3DLOCK_READONLY ) == D3D_OK ) {
+            target.pixels = locked.pBits;
+            target.pitch = static_cast<unsigned>( locked.Pitch );
+        } else
+            Log::print( "error: failed to lock DX system memory surface\n" );
+    }
+}//readbackFrame
+
+//-----------------------------------------------------------------------------
+
+bool Quadifier::isPresentedRenderTarget() const
+{
+    // ensure that we have a device
+    if ( m_device == 0 ) return false;
+
+    // receives a pointer to the render target (surface)
+    IDirect3DSurface9 *renderTarget = 0;
+
+    // receives hash generated from render target pointer
+    uintptr_t hash = 0;
+
+    // get the current render target
+    if ( m_device->GetRenderTarget( 0, &renderTarget ) == S_OK ) {
+        // if verbose logging is enabled
+        if ( Log::verbose() ) {
+            // render target description
+            D3DSURFACE_DESC desc = {};
+
+            // get the render target description
+            if ( renderTarget->GetDesc( &desc ) == S_OK ) {
+                // display render target details
+                Log::print() << "Render target: " <<
+                    renderTarget << ',' <<
+                    D3DFORMATtoString( desc.Format ) << ',' <<
+                    desc.Width << 'x' << desc.Height << endl;
+            }
+        }
+
+        // use the renderTarget pointer as a simple hash
+        hash = reinterpret_cast<uintptr_t>( renderTarget );
+
+        // release render target
+        renderTarget->Release();
+    }
+
+    // has this render target been presented?
+    return m_presentedTargets.contains( hash );
+}//isPresentedRenderTarget
+
+//-----------------------------------------------------------------------------
+
+bool Quadifier::isCaptureTargetBound() const
+{
+    if ( m_device == 0 ) return false;
+
+    IDirect3DSurface9 *renderTarget = 0;
+    if ( m_device->GetRenderTarget( 0, &renderTarget ) != S_OK ) return false;
+
+    // (we only compare the pointer)
+    renderTarget->Release();
+    return ( renderTarget != 0 ) && ( renderTarget == m_target[currentTarget()].surface );
+}//isCaptureTargetBound
+
+//-----------------------------------------------------------------------------
+
+D3DVIEWPORT9 Quadifier::captureViewport( const D3DVIEWPORT9 & viewport ) const
+{
+    D3DVIEWPORT9 adjusted = viewport;
+    const float scale = m_capture.scale;
+    if ( scale < 1.f ) {
+        adjusted.X = static_cast<DWORD>( viewport.X * scale );
+        adjusted.Y = static_cast<DWORD>( viewport.Y * scale );
+        adjusted.Width = scaleSize( viewport.Width, scale );
+        adjusted.Height = scaleSize( viewport.Height, scale );
+    }
+    adjusted.X += m_eyeOffset;
+    return adjusted;
+}//captureViewport
+
+//-----------------------------------------------------------------------------
+
+#if defined(SUPPORT_D3D11)
+bool Quadifier::isBackBufferView( ID3D11RenderTargetView *view ) const
+{
+    if ( (view == 0) || (m_backBuffer11 == 0) ) return false;
+
+    // compare the resource of the view with the back buffer
+    ID3D11Resource *resource = 0;
+    view->GetResource( &resource );
+    if ( resource == 0 ) return false;
+    resource->Release();
+
+    return ( resource == m_backBuffer11 );
+}//isBackBufferView
+#endif
+
+//-----------------------------------------------------------------------------
+
+#if defined(SUPPORT_D3D11)
+bool Quadifier::isTargetView( ID3D11RenderTargetView *view ) const
+{
+    for (unsigned i=0; i < m_target.size(); ++i)
+        if ( (view != 0) && (m_target[i].view11 == view) ) return true;
+    return false;
+}//isTargetView
+#endif
+
+//-----------------------------------------------------------------------------
+
+#if defined(SUPPORT_D3D11)
+bool Quadifier::captureBackBufferDX11()
+{
+    if ( !m_initialised ) {
+        // the first time the back buffer is used, create the resources
+        // (by which time the swap chain has been created at the right size)
+        if ( m_chain11 == 0 ) return false;
+        createResources();
+        if ( !m_initialised ) return false;
+    }
+
+    // start capturing DX drawing: as in beginCapture, the target no longer
+    // holds the frame it was tagged with (the caller rebinds it, from inside
+    // the application's own call, so beginCapture itself is not used)
+    markCaptureStart();
+    m_targetTag[m_drawBuffer].store( TAG_NONE );
+
+    return ( m_target[m_drawBuffer].view11 != 0 );
+}//captureBackBufferDX11
+#endif
+
+//-----------------------------------------------------------------------------
+
+std::string Quadifier::adapterKey() const
+{
+    // vendor, device and driver version, as hex
+    unsigned vendor = 0, device = 0;
+    long long version = 0;
+
+    if ( m_device != 0 ) {
+        IDirect3D9 *direct3D = 0;
+        D3DDEVICE_CREATION_PARAMETERS parameters = {};
+        D3DADAPTER_IDENTIFIER9 identifier = {};
+        if ( SUCCEEDED( m_device->GetDirect3D( &direct3D ) ) ) {
+            if ( SUCCEEDED( m_device->GetCreationParameters( &parameters ) ) &&
+                 SUCCEEDED( direct3D->GetAdapterIdentifier(
+                    parameters.AdapterOrdinal, 0, &identifier ) )
+            ) {
+                vendor  = identifier.VendorId;
+                device  = identifier.DeviceId;
+                version = identifier.DriverVersion.QuadPart;
+            }
+            direct3D->Release();
+        }
+    }
+#if defined(SUPPORT_D3D11)
+    else if ( m_device11 != 0 ) {
+        IDXGIDevice *dxgiDevice = 0;
+        IDXGIAdapter *adapter = 0;
+        if ( SUCCEEDED( m_device11->QueryInterface(
+                __uuidof(IDXGIDevice), reinterpret_cast<void**>(&dxgiDevice) ) )
+        ) {
+            if ( SUCCEEDED( dxgiDevice->GetAdapter( &adapter ) ) ) {
+                DXGI_ADAPTER_DESC desc = {};
+                LARGE_INTEGER umdVersion = {};
+                if ( SUCCEEDED( adapter->GetDesc( &desc ) ) ) {
+                    vendor = desc.VendorId;
+                    device = desc.DeviceId;
+                }
+                if ( SUCCEEDED( adapter->CheckInterfaceSupport(
+                        __uuidof(IDXGIDevice), &umdVersion ) ) )
+                    version = umdVersion.QuadPart;
+                adapter->Release();
+            }
+            dxgiDevice->Release();
+        }
+    }
+#endif
+
+    std::ostringstream key;
+    key << hex << setfill('0')
+        << setw(4) << vendor << ':' << setw(4) << device << ':'
+        << setw(16) << version;
+    return key.str();
+}
+
+//-----------------------------------------------------------------------------
+
+ProbeCache::Result Quadifier::probeGL()
+{
+    ProbeCache::Result result = {};
+
+    // in case the graphics driver settings are forcing multisampling (e.g. the
+    // NVIDIA drivers are set to "override any application setting"), this
+    // code attempts to query how many multisamples are in use
+    GLWindow window;
+    if ( window.create( 0, L"", 0, 0, 0, 8, 8, 0, 0, WindowProc, 0 ) ) {
+        // query the number of samples from OpenGL
+        unsigned samples = window.getSamples();
+        if ( samples > 16 ) samples = 16;
+        result.forcedSamples = ( samples > 1 ) ? samples : 0;
+
+        // is the DX interop available?
+        result.interop = ( wglGetProcAddress( "wglDXOpenDeviceNV" ) != 0 );
+
+        window.destroy();
+    }
+
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+
+void Quadifier::createResources()
+{
+    // the forced multisampling and interop support must be known before the
+    // targets are created, which is before the GL thread exists: they are
+    // probed with a temporary GL window only once per adapter and driver
+    // version, and cached (the GL thread corrects the cache if it finds
+    // the driver has changed its mind)
+    m_adapter = adapterKey();
+    if ( !ProbeCache::find( m_adapter, m_probe ) ) {
+        m_probe = probeGL();
+        ProbeCache::store( m_adapter, m_probe );
+    } else if (Log::info())
+        Log::print( "GL probe cached for adapter " ) << m_adapter << endl;
+
+    // without the DX interop, frames go through system memory
+    // (this must be decided before the targets are created)
+    m_readback = ( m_device != 0 ) && !m_presenter &&
+        ( Settings::get().readback || !m_probe.interop );
+
+    if (Log::info())
+        Log::print( "OpenGL forced AA samples = " ) << m_probe.forcedSamples << endl;
+    if ( m_readback && Log::info() )
+        Log::print( "GL/DX interop not used: frames will be read back through system memory\n" );
+
+    // store the number of samples (which also applies to any targets that
+    // are re-created later)
+    m_forcedSamples = m_probe.forcedSamples;
+
+    // the fastest target format and present path are probed through the
+    // interop (Direct3D 9 only), once the target size is known
+    m_probePaths = Settings::get().probePaths && ( m_device != 0 ) && !m_readback &&
+        !m_presenter;
+
+#if defined(SUPPORT_D3D11)
+    // Direct3D 11 has its own render targets
+    if ( m_device11 != 0 ) {
+        createResourcesDX11();
+        return;
+    }
+#endif
+
+    if ( m_target[0].surface != 0 ) return;
+
+    // store the window handle of the original source window (the window
+    // in the parent Direct3D application)
+    D3DDEVICE_CREATION_PARAMETERS parameters = {};
+    m_device->GetCreationParameters( &parameters );
+    m_sourceWindow = parameters.hFocusWindow;
+
+    // create render target(s)
+    createTargets( m_target );
+
+    // get the current render target and save for later use
+    m_device->GetRenderTarget( 0, &m_backBuffer );
+
+    // create the GPU time-stamp queries (optional)
+    m_gpuTimerDX.create( m_device );
+
+    // create window (unless the presenter process shows the frames)
+    if ( m_presenter )
+        m_publisher.setWindow( m_sourceWindow );
+    else
+        startRenderThread();
+
+    // we have completed initialisation
+    m_initialised = true;
+}
+
+//-----------------------------------------------------------------------------
+
+void Quadifier::createTargets( std::vector<Target> & targets )
+{
+    if (Log::info())
+        Log::print( "Create DX render targets\n" );
+
+    // convert number of forced samples to the Direct3D multisample type
+    D3DMULTISAMPLE_TYPE forcedSamplesDX = D3DMULTISAMPLE_NONE;
+    if ( m_forcedSamples > 1 )
+        forcedSamplesDX = static_cast<D3DMULTISAMPLE_TYPE>( m_forcedSamples );
+
+    // get the adapter display mode
+    D3DDISPLAYMODE displayMode = {};
+    if ( m_direct3D->GetAdapterDisplayMode( D3DADAPTER_DEFAULT, &displayMode ) != S_OK ) {
+        Log::print( "error: failed to get adapter display mode (using default)\n" );
+        // fallback code
+        displayMode.Format = D3DFMT_X8R8G8B8;
+    }
+
+    // viewport width and height
+    unsigned width  = 0;
+    unsigned height = 0;
+
+    // assume no multisampling initially
+    D3DSURFACE_DESC desc = {};
+    desc.MultiSampleType = D3DMULTISAMPLE_NONE;
+
+    // attempt to retrieve the multisample type from the render target
+    IDirect3DSurface9 *renderTarget = 0;
+    if ( m_device->GetRenderTarget( 0, &renderTarget ) == S_OK ) {
+        // get the render target description
+        if ( renderTarget->GetDesc( &desc ) == S_OK ) {
+            // store viewport width and height
+            width  = desc.Width;
+            height = desc.Height;
+
+            Log::print( "DX render target surface format: " ) <<
+                D3DFORMATtoString( desc.Format ) << endl;
+        } else {
+            // failure: ensure the sample type is initialised to none
+            desc.MultiSampleType = D3DMULTISAMPLE_NONE;
+            Log::print( "error: failed to get render target description\n" );
+
+            // fall back to GetViewport to get viewport dimensions
+            D3DVIEWPORT9 viewport = {};
+            m_device->GetViewport( &viewport );
+
+            // store viewport width and height
+            width  = viewport.Width;
+            height = viewport.Height;
+        }
+
+        // release render target
+        renderTarget->Release();
+    } else {
+        Log::print( "error: failed to get render target\n" );
+    }
+
+    if (Log::info()) {
+        Log::print() << "DX viewport = "
+            << width << 'x' << height << endl;
+    }
+
+    // multisampling level to use
+    D3DMULTISAMPLE_TYPE multisampleType = desc.MultiSampleType;
+
+    if (Log::info()) {
+        // this is the original number of Direct3D samples used by the source
+        Log::print( "DX multisample type = " ) << D3DMULTISAMPLE_TYPEtoString(
+            multisampleType
+            ) << endl;
+    }
+
+    // if the target has forced multisamples that are greater than the
+    // Direct3D source, we force the source to use the same number to
+    // ensure they have a compatible pixel format (otherwise the interop
+    // seems to fail)
+    if ( multisampleType < forcedSamplesDX ) {
+        multisampleType = forcedSamplesDX;
+        Log::print( "Forcing DX multisample type to: " ) <<
+            D3DMULTISAMPLE_TYPEtoString( multisampleType ) << endl;
+    }
+
+    // with a resolve stage, the application renders into a private
+    // multisampled target which is resolved into a single-sample copy for
+    // GL, so the GL window need not be multisampled (but if the driver is
+    // forcing GL multisampling, we have to match it instead)
+    // (system memory copies can only be taken of single-sample surfaces, so
+    // in readback mode we always resolve)
+    const bool resolve = ( multisampleType != D3DMULTISAMPLE_NONE ) &&
+        ( m_readback || (Settings::get().resolveMSAA && ( m_forcedSamples == 0 )) );
+
+    if ( resolve && Log::info() )
+        Log::print( "DX multisampling will be resolved before sharing with GL\n" );
+
+    // convert multisampling level to an unsigned integer and store it
+    // for later use when creating the target OpenGL window
+    if ( 
+        !resolve &&
+        ( multisampleType >= D3DMULTISAMPLE_2_SAMPLES  ) &&
+        ( multisampleType <= D3DMULTISAMPLE_16_SAMPLES )
+    ) {
+        m_samplesDX = static_cast<unsigned>( multisampleType );
+    } else
+        m_samplesDX = 0;
+
+    LPDIRECT3DSURFACE9 depthStencilSurface = 0;
+    D3DSURFACE_DESC depthStencilDesc = {};
+    depthStencilDesc.Format = D3DFMT_D24S8;
+
+    // display some information about the depth/stencil format
+    // (purely informational, not required currently)
+    if ( m_device->GetDepthStencilSurface( &depthStencilSurface ) == S_OK ) {
+        // get the surface description
+        if ( depthStencilSurface->GetDesc( &depthStencilDesc ) == S_OK ) {
+            if (Log::info())
+                Log::print( "DX depth/stencil surface format: " ) <<
+                    D3DFORMATtoString( depthStencilDesc.Format ) << endl;
+        } else {
+            Log::print( "error: failed to get depth surface description\n" );
+        }
+
+        // release depth stencil surface
+        depthStencilSurface->Release();
+    } else
+        Log::print( "error: failed to get depth stencil surface\n" );
+
+    // time the ways of sharing a target with GL, once per adapter and
+    // driver version (cached with the GL probe); the fastest format is
+    // then used for the targets, and onCreate follows the fastest path
+    // (reprojection and row packing need the present pipeline)
+    if ( m_probePaths && (m_probe.path == PathProbe::PATH_NONE) ) {
+        PathProbe::run(
+            m_device, width, height, displayMode.Format,
+            m_pose.isOpen() || ( m_packing == Settings::PACKING_ROWS ),
+            m_probe
+        );
+        if ( m_probe.path != PathProbe::PATH_NONE )
+            ProbeCache::store( m_adapter, m_probe );
+    }
+    const D3DFORMAT format = ( m_probePaths && (m_probe.format != 0) ) ?
+        static_cast<D3DFORMAT>( m_probe.format ) : displayMode.Format;
+
+    // in double-wide mode, each target holds both eyes side by side
+    const unsigned targetWidth = m_doubleWide ? 2 * width : width;
+
+    // create render target(s)
+    for (unsigned i=0; i < targets.size(); ++i) {
+        // initialise share handle to NULL
+        // JDW added for ATI compatibility
+        targets[i].shareHandle = NULL;
+        targets[i].width  = targetWidth;
+        targets[i].height = height;
+
+        // in zero-copy mode the last target is the back buffer itself, as
+        // long as it can be shared as it is (i.e. it is not multisampled);
+        // otherwise we fall back to a target of our own
+        if ( m_zeroCopy && (i + 1 == targets.size()) ) {
+            if ( multisampleType != D3DMULTISAMPLE_NONE )
+                Log::print( "warning: zeroCopy requires a single-sample back buffer\n" );
+            else if ( m_device->GetBackBuffer(
+                    0, 0, D3DBACKBUFFER_TYPE_MONO, &targets[i].surface
+                ) == D3D_OK ) {
+                if (Log::info())
+                    Log::print( "sharing DX back buffer " ) << targets[i].surface << endl;
+                continue;
+            } else
+                Log::print( "error: failed to get DX back buffer\n" );
+        }
+
+        // create render target (shared with GL, unless it is resolved)
+        if (m_device->CreateRenderTarget(
+            targetWidth,
+            height,
+            format,
+            multisampleType,
+            0,
+            FALSE,
+            &targets[i].surface,
+            ( resolve || m_readback ) ? NULL : &targets[i].shareHandle
+        ) != S_OK) {
+            Log::print("error: failed to create DX render target\n");
+            break;
+        }
+
+        // create the single-sample copy which is shared with GL
+        if (resolve && (m_device->CreateRenderTarget(
+            targetWidth,
+            height,
+            format,
+            D3DMULTISAMPLE_NONE,
+            0,
+            FALSE,
+            &targets[i].resolve,
+            m_readback ? NULL : &targets[i].shareHandle
+        ) != S_OK)) {
+            Log::print("error: failed to create DX resolve target\n");
+            break;
+        }
+    }
+
+    // the application's depth/stencil buffer is only as wide as one eye, so
+    // double-wide targets have one of their own (shared by all of them,
+    // since DX renders one frame at a time)
+    if ( m_doubleWide && !targets.empty() && (targets[0].surface != 0) &&
+         (m_device->CreateDepthStencilSurface(
+            targetWidth,
+            height,
+            depthStencilDesc.Format,
+            multisampleType,
+            0,
+            FALSE,
+            &targets[0].depth,
+            NULL
+         ) != D3D_OK)
+    )
+        Log::print( "error: failed to create DX double-wide depth/stencil surface\n" );
+
+    // in readback mode, each target has a copy in system memory
+    for (unsigned i=0; m_readback && (i < targets.size()); ++i) {
+        IDirect3DSurface9 *source = static_cast<IDirect3DSurface9*>( targets[i].resource() );
+        D3DSURFACE_DESC sourceDesc = {};
+        if ( (source == 0) || (source->GetDesc( &sourceDesc ) != D3D_OK) ) continue;
+
+        if ( m_device->CreateOffscreenPlainSurface(
+            sourceDesc.Width,
+            sourceDesc.Height,
+            sourceDesc.Format,
+            D3DPOOL_SYSTEMMEM,
+            &targets[i].system,
+            NULL
+        ) != D3D_OK ) {
+            Log::print( "error: failed to create DX system memory surface\n" );
+            break;
+        }
+    }
+
+    // the targets' own memory is accounted apart from the application's
+    // (the shared back buffer of zero-copy mode is the application's)
+    for (unsigned i=0; i < targets.size(); ++i) {
+        if ( !(m_zeroCopy && (i + 1 == targets.size())) )
+            ResourceTracker::track( targets[i].surface, "quadifier" );
+        ResourceTracker::track( targets[i].resolve, "quadifier" );
+        ResourceTracker::track( targets[i].depth, "quadifier" );
+        ResourceTracker::track( targets[i].system, "quadifier" );
+    }
+}//createTargets
+
+//-----------------------------------------------------------------------------
+
+void Quadifier::replaceTargets( std::vector<Target> & targets, bool release )
+{
+    if ( m_thread == 0 ) {
+        // nothing is registered with GL yet: just swap them
+        m_target.swap( targets );
+    } else {
+        // hand the new targets to the GL thread, and wake it up
+        m_pendingTarget.swap( targets );
+        m_replaceState.store( REPLACE_REQUESTED );
+        SetEvent( m_frameReady );
+
+        // wait until the GL thread has swapped the targets over
+        while ( m_replaceState.load() != REPLACE_IDLE ) {
+            if ( m_targetsReplaced.wait( REPLACE_TIMEOUT ) ) continue;
+
+            // if the old targets must go, keep waiting while the GL thread
+            // is still there to paint from them
+            const bool running = WaitForSingleObject(
+                reinterpret_cast<HANDLE>( m_thread ), 0 ) == WAIT_TIMEOUT;
+            if ( release && running ) {
+                Log::print( "error: timed out releasing DX render targets, still waiting for GL\n" );
+                continue;
+            }
+
+            // otherwise we withdraw the request (unless the GL thread has
+            // already started on it) and carry on with the old targets, or
+            // (if they must go) release them here, GL no longer using them
+            unsigned state = REPLACE_REQUESTED;
+            if ( m_replaceState.compare_exchange_strong( state, REPLACE_IDLE ) ) {
+                if ( release ) {
+                    Log::print( "error: GL thread has exited, releasing DX render targets\n" );
+                    m_target.swap( m_pendingTarget );
+                } else
+                    Log::print( "error: timed out replacing DX render targets, keeping the old ones\n" );
+                break;
+            }
+        }
+
+        // this is now either the old targets, or the withdrawn new ones
+        targets.swap( m_pendingTarget );
+    }
+
+    // release the targets we no longer use
+    for (unsigned i=0; i < targets.size(); ++i)
+        targets[i].clear();
+
+    // start capturing the next frame from scratch
+    m_capture.eyes = 0;
+    m_capture.captureTime = 0.0;
+    m_capture.posed = false;
+    m_capture.shared = false;
+    m_captureBack = false;
+    m_eyeOffset = 0;
+}//replaceTargets
+
+//-----------------------------------------------------------------------------
+
+#if defined(SUPPORT_D3D11)
+void Quadifier::createResourcesDX11()
+{
+    if ( (m_chain11 == 0) || (m_target[0].texture11 != 0) ) return;
+
+    // the swap chain describes the window
+    DXGI_SWAP_CHAIN_DESC chainDesc = {};
+    if ( m_chain11->GetDesc( &chainDesc ) != S_OK ) {
+        Log::print( "error: failed to get swap chain description\n" );
+        return;
+    }
+
+    // store the window handle of the original source window
+    m_sourceWindow = chainDesc.OutputWindow;
+
+    // create render target(s)
+    createTargetsDX11( m_target );
+
+    // create window
+    startRenderThread();
+
+    // we have completed initialisation
+    m_initialised = true;
+}//createResourcesDX11
+#endif
+
+//-----------------------------------------------------------------------------
+
+#if defined(SUPPORT_D3D11)
+void Quadifier::createTargetsDX11( std::vector<Target> & targets )
+{
+    if (Log::info())
+        Log::print( "Create DX render targets\n" );
+
+    // the swap chain describes the back buffer format
+    DXGI_SWAP_CHAIN_DESC chainDesc = {};
+    if ( m_chain11->GetDesc( &chainDesc ) != S_OK ) {
+        Log::print( "error: failed to get swap chain description\n" );
+        return;
+    }
+
+    // viewport width and height
+    const unsigned width  = chainDesc.BufferDesc.Width;
+    const unsigned height = chainDesc.BufferDesc.Height;
+
+    // refresh the back buffer (in case the buffers have been resized)
+    ID3D11Resource *backBuffer = 0;
+    if ( m_chain11->GetBuffer(
+            0, __uuidof(ID3D11Resource), reinterpret_cast<void**>(&backBuffer)
+        ) == S_OK
+    ) {
+        m_backBuffer11 = backBuffer;
+        backBuffer->Release();
+    }
+
+    // multisampling level to use: as for Direct3D 9, we use the forced GL
+    // number of samples if that is greater than the application's
+    UINT samples = chainDesc.SampleDesc.Count;
+    if ( samples < m_forcedSamples ) {
+        samples = m_forcedSamples;
+        Log::print( "Forcing DX multisample count to: " ) << samples << endl;
+    }
+
+    // resolve multisampling before sharing with GL, as for Direct3D 9
+    const bool resolve = Settings::get().resolveMSAA &&
+        ( m_forcedSamples == 0 ) && ( samples > 1 );
+    m_samplesDX = ( !resolve && (samples > 1) ) ? samples : 0;
+
+    if (Log::info()) {
+        if ( resolve )
+            Log::print( "DX multisampling will be resolved before sharing with GL\n" );
+        Log::print() << "DX viewport = " << width << 'x' << height << endl;
+        Log::print() << "DX swap chain format = " << chainDesc.BufferDesc.Format
+            << ", samples = " << chainDesc.SampleDesc.Count << endl;
+    }
+
+    // the capture targets match the back buffer
+    D3D11_TEXTURE2D_DESC desc = {};
+    desc.Width = width;
+    desc.Height = height;
+    desc.MipLevels = 1;
+    desc.ArraySize = 1;
+    desc.Format = chainDesc.BufferDesc.Format;
+    desc.SampleDesc.Count = ( samples > 1 ) ? samples : 1;
+    desc.SampleDesc.Quality = 0;
+    desc.Usage = D3D11_USAGE_DEFAULT;
+    desc.BindFlags = D3D11_BIND_RENDER_TARGET | D3D11_BIND_SHADER_RESOURCE;
+
+    // create render target(s)
+    for (unsigned i=0; i < targets.size(); ++i) {
+        targets[i].shareHandle = NULL;
+        targets[i].width  = width;
+        targets[i].height = height;
+
+        if ( m_device11->CreateTexture2D( &desc, 0, &targets[i].texture11 ) != S_OK ) {
+            Log::print( "error: failed to create DX11 render target\n" );
+            break;
+        }
+
+        if ( m_device11->CreateRenderTargetView(
+                targets[i].texture11, 0, &targets[i].view11 ) != S_OK ) {
+            Log::print( "error: failed to create DX11 render target view\n" );
+            break;
+        }
+
+        // create the single-sample copy which is shared with GL
+        if ( resolve ) {
+            D3D11_TEXTURE2D_DESC resolveDesc = desc;
+            resolveDesc.SampleDesc.Count = 1;
+            if ( m_device11->CreateTexture2D( &resolveDesc, 0, &targets[i].resolve11 ) != S_OK ) {
+                Log::print( "error: failed to create DX11 resolve target\n" );
+                break;
+            }
+        }
+    }
+
+    // the targets' own memory is accounted apart from the application's
+    for (unsigned i=0; i < targets.size(); ++i) {
+        ResourceTracker::track( targets[i].texture11, "quadifier" );
+        ResourceTracker::track( targets[i].resolve11, "quadifier" );
+    }
+}//createTargetsDX11
+#endif
+
+//-----------------------------------------------------------------------------
+
+void Quadifier::startRenderThread()
+{
+    if (Log::info())
+        Log::print( "starting GL rendering thread\n" );
+
+    if ( m_thread != 0 ) return;
+
+    // create thread
+    unsigned threadId = 0;
+
+    m_thread = _beginthreadex(
+        NULL,       // no security attributes (child cannot inherit handle)
+        1024*1024,  // 1MB stack size
+        threadFunc, // code to run on new thread
+        this,       // pointer to host application class
+        0,          // run immediately (could create suspended)
+        &threadId   // OUT: returns thread ID
+    );
+
+    if (Log::info())
+        Log::print() << "thread = " << hex << (unsigned)m_thread << dec << endl;
+}
+
+//-----------------------------------------------------------------------------
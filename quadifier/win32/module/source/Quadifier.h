@@ -1,225 +1,656 @@
-#ifndef hive_Quadifier_h
-#define hive_Quadifier_h
-
-//-----------------------------------------------------------------------------
-//
-// Copyright (C) 2012-14 James Ward, University of Hull
-//
-// This software is provided 'as-is', without any express or implied
-// warranty. In no event will the authors be held liable for any damages
-// arising from the use of this software.
-//
-// Permission is granted to anyone to use this software for any purpose,
-// including commercial applications, and to alter it and redistribute it
-// freely, subject to the following restrictions:
-//
-//    1. The origin of this software must not be misrepresented; you must not
-//    claim that you wrote the original software.
-//
-//    2. If you use this software in a product, an acknowledgment in the
-//    product documentation is required.
-//
-//    3. Altered source versions must be plainly marked as such, and must not
-//    be misrepresented as being the original software.
-//
-//    4. This notice may not be removed or altered from any source
-//    distribution.
-//
-//-----------------------------------------------------------------------------
-
-#include <d3d9.h>
-#include <GL/gl.h>
-#include <GL/glext.h>
-#include <GL/wglext.h>
-#include <array>
-#include <set>
-#include "Event.h"
-#include "Extensions.h"
-#include "GLWindow.h"
-
-//-----------------------------------------------------------------------------
-
-/// Quadifier is the main implementation of the Direct3D to OpenGL renderer
-class Quadifier {
-public:
-    /// Constructor
-    Quadifier(
-        IDirect3DDevice9 *device,
-        IDirect3D9 *direct3D
-    );
-
-    /// Destructor
-    virtual ~Quadifier();
-
-    /// Called when D3D device is created
-    void onCreateDX();
-
-    /// Called immediately before D3D Clear
-    void onPreClearDX(
-        DWORD Count,
-        CONST D3DRECT *pRects,
-        DWORD Flags,
-        D3DCOLOR Color,
-        float Z,
-        DWORD Stencil
-    );
-
-    /// Called immediately after D3D Clear
-    void onPostClearDX();
-
-    /// Called immediately before D3D Present
-    void onPrePresentDX(
-        CONST RECT *pSourceRect,
-        CONST RECT *pDestRect,
-        HWND hDestWindowOverride,
-        CONST RGNDATA *pDirtyRegion
-    );
-
-    /// Called immediately after D3D Present
-    void onPostPresentDX();
-
-    /// Called immediately before D3D SetViewport
-    bool onPreSetViewportDX( CONST D3DVIEWPORT9 *pViewport );
-
-private:
-    /// Create D3D resources (render targets)
-    void createResources();
-
-    /// Start OpenGL rendering thread
-    void startRenderThread();
-
-    /// Called when OpenGL window is created
-    bool onCreate();
-
-    /// Called when OpenGL window is destroyed
-    void onDestroy();
-
-    /// Called when OpenGL window is painted
-    void onPaint();
-    
-    /// Called when OpenGL window is resized
-    void onResize( UINT type, int w, int h );
-
-    /// Called when stereo signal is received from Unity script, which tells
-    /// us that the right eye rendering pass has started
-    void onStereoSignal();
-
-    /// Called to perform idle processing
-    void onIdle();
-
-    /// Request a redraw
-    void redraw();
-
-    /// Draw a small indicator to show left/right stereo channels
-    void drawStereoIndicator();
-
-public:
-    /// The WIN32 WindowProc for the OpenGL window
-    LRESULT CALLBACK windowProc(
-        HWND hWnd,      // handle to window
-        UINT uMsg,      // message identifier
-        WPARAM wParam,  // first message parameter
-        LPARAM lParam   // second message parameter
-    );
-
-    /// OpenGL rendering thread function
-    static unsigned __stdcall threadFunc( void *context );
-
-private:
-
-    /// Return the wall clock time in seconds
-    double getTime() const;
-
-    /// Begin capturing a DirectX frame
-    void beginCapture();
-
-    /// Finish capturing a DirectX frame, request rendering to the
-    /// specified OpenGL draw buffer, and swap the render targets
-    /// ready for the next frame
-    void endCapture( GLuint drawBuffer );
-
-    /**
-     * Returns true if the current render target has ever been presented
-     * (which we use to detect render targets that are actually displayed,
-     * rather than the various off screen render targets).
-     */
-    bool isPresentedRenderTarget() const;
-
-private:
-    IDirect3DDevice9    *m_device;      ///< The Direct3D device
-    IDirect3D9          *m_direct3D;    ///< The Direct3D interface
-    LPDIRECT3DSURFACE9   m_backBuffer;  ///< The back buffer for rendering
-
-    unsigned m_framesGL;    ///< OpenGL frame count
-    unsigned m_framesDX;    ///< Direct3D frame count
-
-    unsigned m_samplesDX;   ///< Direct3D multisamples (or 0)
-    unsigned m_samplesGL;   ///< OpenGL multisamples (or 0)
-
-    unsigned m_drawBuffer;  ///< buffer to draw to
-    unsigned m_readBuffer;  ///< buffer to read from
-
-    unsigned m_width;       ///< display width in pixels
-    unsigned m_height;      ///< display height in pixels
-
-    bool m_initialised;     ///< has initialisation completed?
-
-    /// Set of all render targets that have been presented
-    std::set< unsigned > m_presentedTargets;
-
-    /// Stores all the details of an individual render target
-    struct Target {
-        LPDIRECT3DSURFACE9  surface;        ///< Direct3D surface
-        HANDLE              object;         ///< Handle of interop object
-        GLuint              texture;        ///< OpenGL texture
-        GLuint              renderBuffer;   ///< OpenGL renderbuffer
-        GLuint              frameBuffer;    ///< OpenGL framebuffer
-        GLuint              drawBuffer;     ///< OpenGL draw buffer identifier
-        HANDLE              shareHandle;    ///< Share handle required for AMD
-
-        /// Default constructor
-        Target() :
-            surface(0),
-            object(0),
-            texture(0),
-            renderBuffer(0),
-            frameBuffer(0),
-            drawBuffer(GL_BACK)
-        {
-        }
-
-        /// Clear the contents (free stored data)
-        void clear() {
-            if ( surface != 0 ) {
-                surface->Release();
-                surface = 0;
-            }
-        }
-    };
-
-    std::array<Target,3> m_target; ///< DX/GL targets for rendering
-
-    bool     m_stereoMode;          ///< Stereo mode enable/disable
-    bool     m_stereoAvailable;     ///< Is quad-buffer stereo available?
-
-    double   m_firstFrameTimeGL;    ///< time-stamp of first GL frame
-    double   m_lastFrameTimeGL;     ///< time-stamp of last GL frame
-
-    GLuint   m_quadListGL;          ///< GL display list for textured quad
-
-    uintptr_t m_thread;             ///< Handle of the rendering thread
-
-    HWND m_sourceWindow;            ///< Window handle of source (Direct3D)
-
-    HANDLE m_interopGLDX;           ///< Handle for the OpenGL/DX interop
-
-    Event m_frameDone;              ///< Signals when frame is rendered out
-
-    Extensions glx;                 ///< Stores the OpenGL extension functions
-
-    GLWindow m_window;              ///< The OpenGL output window
-};
-
-//-----------------------------------------------------------------------------
-
-#endif//hive_Quadifier_h
+#ifndef hive_Quadifier_h
+#define hive_Quadifier_h
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+#include <d3d9.h>
+#if defined(SUPPORT_D3D11)
+#include <d3d11.h>
+#endif
+#include <GL/gl.h>
+#include <GL/glext.h>
+#include <GL/wglext.h>
+#include <array>
+#include <atomic>
+#include <vector>
+#include "Event.h"
+#include "Extensions.h"
+#include "FrameMailbox.h"
+#include "FramePublisher.h"
+#include "FrameRecorder.h"
+#include "FrameStreamer.h"
+#include "FrameRing.h"
+#include "ResolutionController.h"
+#include "FramePacer.h"
+#include "FrameStats.h"
+#include "GLWindow.h"
+#include "GpuTimer.h"
+#include "OutputWindow.h"
+#include "Overlay.h"
+#include "ReadbackRing.h"
+#include "PresentPipeline.h"
+#include "ProbeCache.h"
+#include "SharedPose.h"
+#include "SurfaceTable.h"
+#include "ThreadScheduling.h"
+
+//-----------------------------------------------------------------------------
+
+/// Quadifier is the main implementation of the Direct3D to OpenGL renderer
+class Quadifier {
+public:
+    /// Constructor
+    Quadifier(
+        IDirect3DDevice9 *device,
+        IDirect3D9 *direct3D
+    );
+
+#if defined(SUPPORT_D3D11)
+    /// Constructor (Direct3D 11)
+    Quadifier( ID3D11Device *device );
+#endif
+
+    /// Destructor
+    virtual ~Quadifier();
+
+    /// Called when D3D device is created
+    void onCreateDX();
+
+    /// Called immediately before D3D Clear
+    void onPreClearDX(
+        DWORD Count,
+        CONST D3DRECT *pRects,
+        DWORD Flags,
+        D3DCOLOR Color,
+        float Z,
+        DWORD Stencil
+    );
+
+    /// Called immediately after D3D Clear
+    void onPostClearDX();
+
+    /// Called immediately before D3D Present
+    void onPrePresentDX(
+        CONST RECT *pSourceRect,
+        CONST RECT *pDestRect,
+        HWND hDestWindowOverride,
+        CONST RGNDATA *pDirtyRegion
+    );
+
+    /// Called immediately after D3D Present
+    void onPostPresentDX();
+
+    /// Called immediately before D3D SetViewport
+    bool onPreSetViewportDX( CONST D3DVIEWPORT9 *pViewport );
+
+    /// Called immediately before D3D Reset
+    void onPreResetDX();
+
+    /// Count a D3D draw call of the given number of primitives, for the view
+    /// being captured (DX thread)
+    void countDraw( unsigned primitives ) {
+        ++m_calls.draws;
+        m_calls.primitives += primitives;
+    }
+
+    /// Count a D3D state change (render, sampler or texture stage state, a
+    /// texture, shader, stream or vertex format) for the view being captured
+    void countState() { ++m_calls.states; }
+
+    /// Count a D3D render target switch for the view being captured
+    void countTarget() { ++m_calls.targets; }
+
+    /// Called immediately after D3D Reset, with its result
+    void onPostResetDX( HRESULT result );
+
+#if defined(SUPPORT_D3D11)
+    /// Called when a DXGI swap chain is created for the D3D11 device
+    void onCreateSwapChainDX( IDXGISwapChain *chain );
+
+    /// Called immediately before DXGI Present
+    void onPrePresentDX( UINT syncInterval, UINT flags );
+
+    /// Called immediately before D3D11 OMSetRenderTargets: returns the
+    /// views to bind, with the swap chain back buffer replaced by the
+    /// current capture target
+    ID3D11RenderTargetView * const * onPreSetRenderTargetsDX(
+        UINT numViews,
+        ID3D11RenderTargetView * const *views
+    );
+
+    /// Called immediately before D3D11 ClearRenderTargetView: returns the
+    /// view to clear (the capture target instead of the back buffer)
+    ID3D11RenderTargetView * onPreClearRenderTargetViewDX(
+        ID3D11RenderTargetView *view
+    );
+
+    /// Called immediately before D3D11 RSSetViewports
+    bool onPreSetViewportsDX( UINT count, const D3D11_VIEWPORT *viewports );
+
+    /// Called immediately after DXGI ResizeBuffers, with its result
+    void onPostResizeBuffersDX( HRESULT result );
+#endif
+
+    /// Called by the native Unity plugin (through the module's
+    /// QuadifierSignalView export) on the DX thread, when rendering of a
+    /// view starts (1 = the right eye): signals the most recently created
+    /// Quadifier, which from then on ignores the (1,*,2,3) viewport signal
+    static void onPluginSignal( unsigned view );
+
+private:
+    /// Stores all the details of an individual render target
+    struct Target;
+
+    /// Initialisation shared by the constructors
+    void construct();
+
+    /// Create D3D resources (render targets)
+    void createResources();
+
+    /// Returns a key identifying the D3D adapter and its driver version
+    std::string adapterKey() const;
+
+    /// Probe the GL driver with a temporary window (forced multisampling,
+    /// and whether the DX interop is available)
+    static ProbeCache::Result probeGL();
+
+    /// Create a D3D render target for each of the targets, matching the
+    /// current back buffer
+    void createTargets( std::vector<Target> & targets );
+
+    /**
+     * Replace the current targets with the new ones, which must be the same
+     * in number. If the GL thread is running, their interop registrations
+     * are swapped over on the GL thread while the DX thread waits. On return
+     * the vector holds the old targets, which have been released.
+     *
+     * If the GL thread does not respond in time the request is withdrawn and
+     * the old targets are kept, unless release is true (the old targets must
+     * be gone, e.g. before an IDirect3DDevice9 is Reset): then the DX thread
+     * waits for as long as the GL thread is running.
+     */
+    void replaceTargets( std::vector<Target> & targets, bool release );
+
+#if defined(SUPPORT_D3D11)
+    /// Create D3D11 resources (render targets)
+    void createResourcesDX11();
+
+    /// Create a D3D11 render target for each of the targets, matching the
+    /// current swap chain back buffer
+    void createTargetsDX11( std::vector<Target> & targets );
+
+    /// Returns true if the view is of the swap chain back buffer
+    bool isBackBufferView( ID3D11RenderTargetView *view ) const;
+
+    /// Returns true if the view is of one of our capture targets
+    bool isTargetView( ID3D11RenderTargetView *view ) const;
+
+    /// Start capturing into the D3D11 back buffer: the first time this
+    /// creates the resources; returns false if capture is not possible
+    bool captureBackBufferDX11();
+#endif
+
+    /// Start OpenGL rendering thread
+    void startRenderThread();
+
+    /// Called when OpenGL window is created
+    bool onCreate();
+
+    /// Called when OpenGL window is destroyed
+    void onDestroy();
+
+    /// Register a DX target with the GL/DX interop (index is for logging)
+    bool registerTarget( Target & target, unsigned index );
+
+    /// Unregister a DX target from the GL/DX interop, and free its GL objects
+    void unregisterTarget( Target & target );
+
+    /// Carry out a pending replacement of the targets (GL thread)
+    void updateTargets();
+
+    /// Join the swap group and barrier given in the settings, if any, so
+    /// that all nodes of a cluster swap on the same vblank (GL thread)
+    void joinSwapGroup();
+
+    /// Leave the swap group and barrier (GL thread)
+    void leaveSwapGroup();
+
+    /// Called when OpenGL window is painted
+    void onPaint();
+    
+    /// Called when OpenGL window is resized
+    void onResize( UINT type, int w, int h );
+
+    /// Called when stereo signal is received from Unity script, which tells
+    /// us that the rendering pass of a view has started (1 = the right eye;
+    /// views beyond the configured number, or out of order, are ignored)
+    void onStereoSignal( unsigned view );
+
+    /// Called to perform idle processing
+    void onIdle();
+
+    /// Request a redraw
+    void redraw();
+
+    /// Draw a small indicator to show left/right stereo channels
+    /// (immediate mode, used if the overlay could not be created)
+    void drawStereoIndicator();
+
+    /// Draw the stereo indicator and/or the HUD through the overlay,
+    /// refreshing the HUD text periodically
+    void drawOverlay( bool indicator, bool hud );
+
+    /// Present one eye of a frame into the current draw buffer (by
+    /// framebuffer blit, or by drawing it as a texture through the present
+    /// pipeline)
+    void present( const FrameDescriptor & frame, unsigned eye );
+
+    /// Render both eyes packed into the current draw buffer (passive stereo)
+    void presentPacked( const FrameDescriptor & frame );
+
+    /// The part of its target which holds an eye of a frame, from the top
+    /// left: in double-wide mode each eye is half of the target (a 2D frame
+    /// uses the left half), otherwise the whole target, and either is
+    /// reduced by the frame's scale
+    void eyeRegion(
+        const FrameDescriptor & frame,
+        unsigned eye,
+        unsigned & x,
+        unsigned & width,
+        unsigned & height
+    ) const;
+
+public:
+    /// The WIN32 WindowProc for the OpenGL window
+    LRESULT CALLBACK windowProc(
+        HWND hWnd,      // handle to window
+        UINT uMsg,      // message identifier
+        WPARAM wParam,  // first message parameter
+        LPARAM lParam   // second message parameter
+    );
+
+    /// OpenGL rendering thread function
+    static unsigned __stdcall threadFunc( void *context );
+
+private:
+
+    /// Return the wall clock time in seconds
+    double getTime() const;
+
+    /// Begin capturing a DirectX frame (and redirect rendering into the
+    /// current target)
+    void beginCapture();
+
+    /// Record the CPU and GPU time-stamps for the start of capture (which
+    /// are ignored if capture of the frame has already started)
+    void markCaptureStart();
+
+    /// Finish capturing a view of a DirectX frame, request rendering to the
+    /// specified OpenGL draw buffer, and swap the render targets ready for
+    /// the next view (or, if complete, the next frame)
+    void endCapture( GLuint drawBuffer, bool complete );
+
+    /// Returns the main window's draw buffer for a captured view: views 0
+    /// and 1 are the left and right eyes, further views go only to the
+    /// output windows (GL_NONE); the last view of a stereo frame is never
+    /// the left eye
+    GLuint viewDrawBuffer( unsigned view, bool last ) const;
+
+    /// Hand the captured frame over to the OpenGL thread, and start
+    /// capturing the next frame
+    void completeFrame();
+
+    /// Returns the index of the target for the eye being captured
+    unsigned currentTarget() const;
+
+    /// Returns the number of targets used in rotation (synchronous mode)
+    unsigned poolSize() const;
+
+    /// Resolve the multisampled targets of the captured frame into their
+    /// single-sample copies (if the targets have them)
+    void resolveFrame();
+
+    /// Copy the targets of the captured frame into their system memory
+    /// surfaces, and leave those locked for the GL thread (readback mode)
+    void readbackFrame();
+
+    /**
+     * Returns true if the current render target has ever been presented
+     * (which we use to detect render targets that are actually displayed,
+     * rather than the various off screen render targets).
+     */
+    bool isPresentedRenderTarget() const;
+
+    /// Returns true if the current render target is the target (or back
+    /// buffer) being captured into
+    bool isCaptureTargetBound() const;
+
+    /// Returns a viewport the application sets while capturing, adjusted:
+    /// scaled to the capture resolution, and moved into the eye's half of a
+    /// double-wide target
+    D3DVIEWPORT9 captureViewport( const D3DVIEWPORT9 & viewport ) const;
+
+private:
+    IDirect3DDevice9    *m_device;      ///< The Direct3D device
+    IDirect3D9          *m_direct3D;    ///< The Direct3D interface
+    LPDIRECT3DSURFACE9   m_backBuffer;  ///< The back buffer for rendering
+    bool                 m_deviceEx;    ///< Is the device IDirect3DDevice9Ex?
+
+#if defined(SUPPORT_D3D11)
+    ID3D11Device        *m_device11;    ///< The Direct3D 11 device (or 0)
+    ID3D11DeviceContext *m_context11;   ///< The D3D11 immediate context
+    IDXGISwapChain      *m_chain11;     ///< The DXGI swap chain (or 0)
+
+    /// The swap chain back buffer: this is only used for comparison, so
+    /// we don't hold a reference (which would prevent ResizeBuffers)
+    ID3D11Resource      *m_backBuffer11;
+
+    /// Views passed to OMSetRenderTargets, after substitution
+    ID3D11RenderTargetView *m_views11[D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT];
+#endif
+
+    unsigned m_framesGL;    ///< OpenGL frame count
+    unsigned m_framesDX;    ///< Direct3D frame count
+
+    unsigned m_samplesDX;   ///< Direct3D multisamples shared with GL (or 0)
+    unsigned m_samplesGL;   ///< OpenGL multisamples (or 0)
+    unsigned m_forcedSamples; ///< multisamples forced by GL driver (or 0)
+    std::string m_adapter;  ///< adapter key of the probe cache
+    ProbeCache::Result m_probe; ///< GL probe result used for the targets
+    bool m_probePaths;      ///< use the probed target format and present path?
+
+    unsigned m_drawBuffer;  ///< buffer to draw to
+
+    unsigned m_width;       ///< GL window width in pixels
+    unsigned m_height;      ///< GL window height in pixels
+
+    bool m_initialised;     ///< has initialisation completed?
+
+    /// Set of all render targets that have been presented
+    SurfaceTable m_presentedTargets;
+
+    /// Stores all the details of an individual render target
+    struct Target {
+        LPDIRECT3DSURFACE9  surface;        ///< Direct3D surface
+        LPDIRECT3DSURFACE9  resolve;        ///< single-sample copy (or 0)
+        LPDIRECT3DSURFACE9  system;         ///< system memory copy (or 0)
+        LPDIRECT3DSURFACE9  depth;          ///< double-wide depth/stencil (or 0)
+        const void         *pixels;         ///< locked system memory copy
+        unsigned            pitch;          ///< bytes between its rows
+        HANDLE              object;         ///< Handle of interop object
+        GLuint              texture;        ///< OpenGL texture
+        GLuint              renderBuffer;   ///< OpenGL renderbuffer
+        GLuint              frameBuffer;    ///< OpenGL framebuffer
+        HANDLE              shareHandle;    ///< Share handle required for AMD
+        unsigned            width;          ///< width in pixels
+        unsigned            height;         ///< height in pixels
+#if defined(SUPPORT_D3D11)
+        ID3D11Texture2D        *texture11;  ///< Direct3D 11 texture
+        ID3D11RenderTargetView *view11;     ///< Direct3D 11 render target view
+        ID3D11Texture2D        *resolve11;  ///< single-sample copy (or 0)
+#endif
+
+        /// Default constructor
+        Target() :
+            surface(0),
+            resolve(0),
+            system(0),
+            depth(0),
+            pixels(0),
+            pitch(0),
+            object(0),
+            texture(0),
+            renderBuffer(0),
+            frameBuffer(0),
+            shareHandle(0),
+            width(0),
+            height(0)
+#if defined(SUPPORT_D3D11)
+            , texture11(0)
+            , view11(0)
+            , resolve11(0)
+#endif
+        {
+        }
+
+        /// Returns the DX resource which is shared with GL: if the target is
+        /// multisampled and resolved by DX, this is the single-sample copy
+        void * resource() const {
+#if defined(SUPPORT_D3D11)
+            if ( resolve11 != 0 ) return resolve11;
+            if ( texture11 != 0 ) return texture11;
+#endif
+            if ( resolve != 0 ) return resolve;
+            return surface;
+        }
+
+        /// Clear the contents (free stored data)
+        void clear() {
+            if ( surface != 0 ) {
+                surface->Release();
+                surface = 0;
+            }
+            if ( resolve != 0 ) {
+                resolve->Release();
+                resolve = 0;
+            }
+            if ( depth != 0 ) {
+                depth->Release();
+                depth = 0;
+            }
+            if ( system != 0 ) {
+                if ( pixels != 0 ) system->UnlockRect();
+                system->Release();
+                system = 0;
+            }
+            pixels = 0;
+            pitch = 0;
+#if defined(SUPPORT_D3D11)
+            if ( resolve11 != 0 ) {
+                resolve11->Release();
+                resolve11 = 0;
+            }
+            if ( view11 != 0 ) {
+                view11->Release();
+                view11 = 0;
+            }
+            if ( texture11 != 0 ) {
+                texture11->Release();
+                texture11 = 0;
+            }
+#endif
+        }
+    };
+
+    /// DX/GL targets for rendering: in synchronous mode these are used in
+    /// rotation; in asynchronous mode each mailbox slot owns a pair
+    std::vector<Target> m_target;
+
+    /// States of a target replacement (see replaceTargets)
+    enum ReplaceState {
+        REPLACE_IDLE,       ///< no replacement pending
+        REPLACE_REQUESTED,  ///< new targets are waiting for the GL thread
+        REPLACE_BUSY        ///< GL thread is swapping the targets over
+    };
+
+    std::vector<Target> m_pendingTarget;    ///< targets waiting to replace
+    std::atomic<unsigned> m_replaceState;   ///< a ReplaceState
+    Event m_targetsReplaced;                ///< Signals when replaced
+
+    bool     m_asyncPresent;        ///< Present without waiting for GL?
+
+    /// With the presenter (Direct3D9Ex only) there is no GL thread: each
+    /// completed frame is copied into the targets shared with the presenter
+    /// process, and the application never waits for it (as asyncPresent)
+    bool     m_presenter;
+    FramePublisher m_publisher;     ///< Hands frames to the presenter (DX thread)
+
+    /// In zero-copy mode the last target is the DX back buffer itself: the
+    /// final eye of each frame is rendered there without redirection, and
+    /// only the left eye of a stereo pair uses the rest of the pool
+    bool     m_zeroCopy;
+
+    /// In readback mode (when there is no GL/DX interop, or if requested)
+    /// DX copies each eye into system memory, and GL uploads it into a
+    /// texture of its own; this is Direct3D 9 only
+    bool     m_readback;
+    ReadbackRing m_readbackRing;    ///< uploads frames (GL thread only)
+    bool     m_captureBack;         ///< capturing into the back buffer?
+
+    /// In double-wide mode (Direct3D 9, not zero-copy) each target is twice
+    /// the width of the back buffer, and holds both eyes side by side: the
+    /// stereo signal only moves the viewports of the right eye across by
+    /// m_eyeOffset, rather than switching the render target mid-frame
+    bool     m_doubleWide;
+    unsigned m_eyeOffset;           ///< x offset of the eye being captured
+    unsigned m_views;               ///< views per stereo frame (fixed at startup)
+
+    /// While capturing at a reduced resolution (or into the right half of a
+    /// double-wide target), the application's viewports are adjusted
+    /// before they are set: these are the last one it set, and ours
+    D3DVIEWPORT9 m_appViewport;
+    D3DVIEWPORT9 m_setViewport;
+    ResolutionController m_resolution; ///< picks the capture scale (DX thread)
+
+    FrameMailbox m_mailbox;         ///< Passes frames to GL (async mode)
+    unsigned m_writeSlot;           ///< mailbox slot owned by DX thread
+    unsigned m_readSlot;            ///< mailbox slot owned by GL thread
+
+    /// Frame descriptors for each mailbox slot (async mode)
+    std::array<FrameDescriptor,FrameMailbox::SLOTS> m_slotFrame;
+
+    FrameRing m_ring;               ///< Passes frames to GL (sync mode)
+
+    FrameDescriptor m_capture;      ///< frame being captured by DX thread
+    FrameDescriptor m_lastFrame;    ///< frame last painted by GL thread
+
+    /// Largest target pool (targetCount plus the extra views, or one
+    /// target per view for each mailbox slot)
+    static const unsigned MAX_TARGETS = FrameDescriptor::MAX_VIEWS * FrameMailbox::SLOTS;
+
+    /// Tag of a target which is being rendered into
+    static const unsigned TAG_NONE = ~0u;
+
+    /// Tag of the frame and eye captured into a target
+    static unsigned targetTag( unsigned frameId, unsigned eye ) {
+        return frameId * FrameDescriptor::MAX_VIEWS + eye % FrameDescriptor::MAX_VIEWS;
+    }
+
+    /// The frame and eye each target holds (written by the DX thread as it
+    /// captures, checked by the GL thread before it paints, so that a late
+    /// GL thread never pairs eyes of different frames or paints a target
+    /// which DX has started to overwrite)
+    std::atomic<unsigned> m_targetTag[MAX_TARGETS];
+
+    bool     m_painted;             ///< has a new frame been painted?
+    unsigned m_paintedFrameId;      ///< id of the last new frame painted
+    unsigned m_droppedEyes;         ///< eyes captured but never painted
+    unsigned m_repeatedEyes;        ///< eyes painted again (no new frame)
+    unsigned m_mismatchedEyes;      ///< eyes overwritten before painting
+
+    /// Tracker poses written by the VRPN bridge (open only when reprojecting)
+    SharedPose m_pose;
+
+    FramePacer m_pacer;             ///< schedules GL paints (GL thread only)
+    ThreadScheduling m_renderScheduling;  ///< real-time scheduling of the GL thread
+    ThreadScheduling m_presentScheduling; ///< MMCSS task of the DX present thread
+    bool     m_presentScheduled;    ///< has the present thread been scheduled?
+    std::atomic<double> m_readyTime; ///< when the DX thread last woke the GL thread
+
+    /// When the DX frame is late, the last frame is painted again at the
+    /// display rate (by the pacer, or every refresh period), reprojected to
+    /// the newest tracker pose
+    bool     m_extrapolate;
+    DWORD    m_refreshPeriod;       ///< display refresh period (milliseconds)
+
+    /// Extra output windows, each showing part of the captured eyes
+    std::vector<OutputWindow*> m_outputs;
+
+    unsigned m_swapGroup;           ///< swap group joined (0 = none)
+    unsigned m_swapBarrier;         ///< swap barrier bound (0 = none)
+    GLuint   m_frameCount;          ///< frame counter at the last swap
+    unsigned m_idleVBlanks;         ///< frame-locked vblanks with no swap of ours
+    GpuTimerGL m_gpuTimerGL;        ///< GPU timing of GL paint
+    GpuTimerDX m_gpuTimerDX;        ///< GPU timing of DX capture
+    FrameStats m_statsGL;           ///< timing statistics (GL thread only)
+    FrameStats m_statsDX;           ///< timing statistics (DX thread only)
+    FrameStats m_statsCalls;        ///< D3D calls of each view (DX thread only)
+
+    /// The D3D calls made while one view is captured
+    struct Calls {
+        unsigned draws;             ///< draw calls
+        unsigned primitives;        ///< primitives drawn
+        unsigned states;            ///< state changes
+        unsigned targets;           ///< render target switches
+    };
+    Calls    m_calls;               ///< calls made for the current view
+    bool     m_countCalls;          ///< record m_calls (fixed at startup)?
+
+    bool     m_stereoMode;          ///< Stereo mode enable/disable
+    bool     m_pluginSignal;        ///< has the plugin signalled the right eye?
+    bool     m_stereoAvailable;     ///< Is quad-buffer stereo available?
+    Settings::Packing m_packing;    ///< passive stereo packing (fixed at startup)
+
+    double   m_firstFrameTimeGL;    ///< time-stamp of first GL frame
+    double   m_lastFrameTimeGL;     ///< time-stamp of last GL frame
+    double   m_lastPresentTime;     ///< time-stamp of last DX present
+
+    PresentPipeline m_present;      ///< GL pipeline for textured quad
+    Overlay  m_overlay;             ///< GL stereo indicator and HUD
+    FrameRecorder m_recorder;       ///< records the painted frames (optional)
+    FrameStreamer m_streamer;       ///< streams them to display nodes (optional)
+    std::string m_hudText;          ///< current HUD text
+    double   m_hudTime;             ///< time-stamp of the last HUD refresh
+    unsigned m_hudPaints;           ///< GL paints since the last refresh
+    unsigned m_hudFrameId;          ///< DX frame painted at the last refresh
+    double   m_hudLockTime;         ///< interop lock time since the refresh (ms)
+    unsigned m_hudLocks;            ///< interop locks since the last refresh
+    std::atomic<unsigned> m_hudDraws[2];  ///< draw calls of each eye's last capture
+    std::atomic<unsigned> m_hudStates[2]; ///< state changes of each eye's last capture
+    bool     m_useBlit;             ///< present using framebuffer blit?
+    bool     m_useTexture;          ///< share targets as textures (or renderbuffers)?
+
+    uintptr_t m_thread;             ///< Handle of the rendering thread
+
+    HWND m_sourceWindow;            ///< Window handle of source (Direct3D)
+
+    HANDLE m_interopGLDX;           ///< Handle for the OpenGL/DX interop
+
+    Event m_frameDone;              ///< Signals when frame is rendered out
+
+    HANDLE m_frameReady;            ///< Wakes GL thread for a new frame
+
+    Extensions glx;                 ///< Stores the OpenGL extension functions
+
+    GLWindow m_window;              ///< The OpenGL output window
+
+    static std::atomic<Quadifier*> s_current; ///< last created (plugin signal)
+};
+
+//-----------------------------------------------------------------------------
+
+#endif//hive_Quadifier_h
@@ -0,0 +1,196 @@
+#include "ReadbackRing.h"
+#include <cstring>
+#include "Log.h"
+
+using namespace hive;
+using namespace std;
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+namespace {
+
+/// Flags used both for the buffer storage and for its mapping
+const GLbitfield MAP_FLAGS =
+    GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+/// Longest time to wait for a slot to be free (nanoseconds)
+const GLuint64 SLOT_TIMEOUT = 100000000;
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+
+ReadbackRing::ReadbackRing() :
+    m_glx( 0 ),
+    m_persistent( false ),
+    m_buffer( 0 ),
+    m_mapped( 0 ),
+    m_slotSize( 0 ),
+    m_slot( 0 )
+{
+    m_fence.fill( 0 );
+}
+
+//-----------------------------------------------------------------------------
+
+ReadbackRing::~ReadbackRing()
+{
+    // note: GL resources must be freed by calling destroy() while the
+    // context is still current
+}
+
+//-----------------------------------------------------------------------------
+
+bool ReadbackRing::create( Extensions & glx )
+{
+    m_glx = &glx;
+
+    // the buffer is allocated by the first upload, when the size is known
+    m_persistent = glx.loadShaders() && glx.loadSync() && glx.loadBufferStorage();
+    if ( !m_persistent )
+        Log::print( "warning: persistent buffers are not supported, uploading directly\n" );
+
+    return m_persistent;
+}
+
+//-----------------------------------------------------------------------------
+
+void ReadbackRing::destroy()
+{
+    release();
+    m_persistent = false;
+}
+
+//-----------------------------------------------------------------------------
+
+void ReadbackRing::release()
+{
+    if ( m_glx == 0 ) return;
+    Extensions & glx = *m_glx;
+
+    for (unsigned i=0; i<SLOTS; ++i) {
+        if ( m_fence[i] != 0 ) glx.glDeleteSync( m_fence[i] );
+        m_fence[i] = 0;
+    }
+
+    if ( m_buffer != 0 ) {
+        glx.glBindBuffer( GL_PIXEL_UNPACK_BUFFER, m_buffer );
+        if ( m_mapped != 0 ) glx.glUnmapBuffer( GL_PIXEL_UNPACK_BUFFER );
+        glx.glBindBuffer( GL_PIXEL_UNPACK_BUFFER, 0 );
+        glx.glDeleteBuffers( 1, &m_buffer );
+    }
+    m_buffer = 0;
+    m_mapped = 0;
+    m_slotSize = 0;
+    m_slot = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+bool ReadbackRing::allocate( size_t slotSize )
+{
+    Extensions & glx = *m_glx;
+
+    // no transfer may be using the old buffer
+    glFinish();
+    release();
+
+    const GLsizeiptr size = static_cast<GLsizeiptr>( slotSize * SLOTS );
+    glx.glGenBuffers( 1, &m_buffer );
+    glx.glBindBuffer( GL_PIXEL_UNPACK_BUFFER, m_buffer );
+    glx.glBufferStorage( GL_PIXEL_UNPACK_BUFFER, size, 0, MAP_FLAGS );
+    m_mapped = static_cast<unsigned char*>(
+        glx.glMapBufferRange( GL_PIXEL_UNPACK_BUFFER, 0, size, MAP_FLAGS )
+    );
+    glx.glBindBuffer( GL_PIXEL_UNPACK_BUFFER, 0 );
+
+    if ( m_mapped == 0 ) {
+        Log::print( "warning: failed to map upload buffer, uploading directly\n" );
+        release();
+        m_persistent = false;
+        return false;
+    }
+
+    m_slotSize = slotSize;
+    if (Log::info())
+        Log::print( "upload buffer: " ) << SLOTS << " slots of " << slotSize << " bytes\n";
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void ReadbackRing::upload(
+    GLuint texture,
+    unsigned width,
+    unsigned height,
+    const void *pixels,
+    unsigned pitch
+) {
+    if ( (m_glx == 0) || (pixels == 0) ) return;
+    Extensions & glx = *m_glx;
+
+    const size_t size = static_cast<size_t>( pitch ) * height;
+
+    // grow the buffer if the image no longer fits a slot
+    if ( m_persistent && (size > m_slotSize) ) allocate( size );
+
+    // rows may be padded (the pitch is always a whole number of pixels)
+    glPixelStorei( GL_UNPACK_ROW_LENGTH, pitch / 4 );
+    glBindTexture( GL_TEXTURE_2D, texture );
+
+    if ( m_persistent ) {
+        // wait until the slot's previous transfer has completed
+        GLsync & fence = m_fence[m_slot];
+        if ( fence != 0 ) {
+            glx.glClientWaitSync( fence, GL_SYNC_FLUSH_COMMANDS_BIT, SLOT_TIMEOUT );
+            glx.glDeleteSync( fence );
+            fence = 0;
+        }
+
+        // copy into the slot, and transfer from it to the texture
+        const size_t offset = m_slot * m_slotSize;
+        memcpy( m_mapped + offset, pixels, size );
+        glx.glBindBuffer( GL_PIXEL_UNPACK_BUFFER, m_buffer );
+        glTexSubImage2D(
+            GL_TEXTURE_2D, 0, 0, 0, width, height, GL_BGRA, GL_UNSIGNED_BYTE,
+            reinterpret_cast<const void*>( offset )
+        );
+        glx.glBindBuffer( GL_PIXEL_UNPACK_BUFFER, 0 );
+        fence = glx.glFenceSync( GL_SYNC_GPU_COMMANDS_COMPLETE, 0 );
+
+        m_slot = (m_slot + 1) % SLOTS;
+    } else {
+        glTexSubImage2D(
+            GL_TEXTURE_2D, 0, 0, 0, width, height, GL_BGRA, GL_UNSIGNED_BYTE, pixels
+        );
+    }
+
+    glBindTexture( GL_TEXTURE_2D, 0 );
+    glPixelStorei( GL_UNPACK_ROW_LENGTH, 0 );
+}
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,100 @@
+#ifndef hive_ReadbackRing_h
+#define hive_ReadbackRing_h
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+#include <windows.h>
+#include <GL/gl.h>
+#include <GL/glext.h>
+#include <array>
+#include "Extensions.h"
+
+//-----------------------------------------------------------------------------
+
+/**
+ * Uploads images from system memory into GL textures through a ring of
+ * slots in one persistently mapped pixel buffer object. Each upload copies
+ * the image into the next slot and starts an asynchronous transfer from it,
+ * so the transfer overlaps the rest of the frame; a fence on each slot
+ * stops it being overwritten before its transfer has completed.
+ *
+ * This is the transport used when there is no GL/DX interop. Without
+ * ARB_buffer_storage, images are uploaded directly from system memory.
+ */
+class ReadbackRing {
+public:
+    /// Number of slots in the ring (both eyes of two frames)
+    static const unsigned SLOTS = 4;
+
+    /// Constructor
+    ReadbackRing();
+
+    /// Destructor
+    virtual ~ReadbackRing();
+
+    /// Prepare for uploads (a GL context must be current): returns true if
+    /// persistently mapped buffers are available
+    bool create( Extensions & glx );
+
+    /// Free the buffer (a GL context must be current)
+    void destroy();
+
+    /// Upload an image of 32-bit BGRA pixels, stored top row first with
+    /// rows pitch bytes apart, into level 0 of a GL_TEXTURE_2D texture
+    void upload(
+        GLuint texture,
+        unsigned width,
+        unsigned height,
+        const void *pixels,
+        unsigned pitch
+    );
+
+private:
+    /// Copy construction is not supported
+    ReadbackRing( const ReadbackRing & );
+
+    /// Assignment is not supported
+    ReadbackRing & operator = ( const ReadbackRing & );
+
+    /// (Re)allocate the buffer, for slots of at least the given size
+    bool allocate( size_t slotSize );
+
+    /// Release the buffer
+    void release();
+
+    Extensions    *m_glx;       ///< OpenGL extension functions
+    bool           m_persistent;///< are persistently mapped buffers available?
+    GLuint         m_buffer;    ///< the pixel unpack buffer
+    unsigned char *m_mapped;    ///< persistent mapping of the buffer
+    size_t         m_slotSize;  ///< size of each slot in bytes
+    unsigned       m_slot;      ///< next slot to use
+    std::array<GLsync,SLOTS> m_fence; ///< set when each slot's transfer is done
+};
+
+//-----------------------------------------------------------------------------
+
+#endif//hive_ReadbackRing_h
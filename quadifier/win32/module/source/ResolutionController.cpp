@@ -0,0 +1,106 @@
+#include "ResolutionController.h"
+#include <cmath>
+#include "Log.h"
+
+using namespace hive;
+using namespace std;
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+namespace {
+
+/// Frames to measure at a new scale before changing it again (longer than
+/// the GPU timer latency)
+const unsigned SETTLE_FRAMES = 8;
+
+/// Fraction of the budget to aim for, leaving headroom for variation
+const double HEADROOM = 0.9;
+
+/// Smallest change of scale worth making
+const float STEP = 0.05f;
+
+/// Weight of each new frame time in the smoothed average
+const double SMOOTHING = 0.25;
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+
+ResolutionController::ResolutionController() :
+    m_scale( 1.f ),
+    m_average( 0.0 ),
+    m_frames( 0 )
+{
+}
+
+//-----------------------------------------------------------------------------
+
+float ResolutionController::update( double frameTime, double budget, float minimum )
+{
+    if ( budget <= 0.0 ) {
+        reset();
+        return m_scale;
+    }
+    if ( frameTime <= 0.0 ) return m_scale;
+
+    m_average = ( m_frames == 0 ) ?
+        frameTime : m_average + SMOOTHING * ( frameTime - m_average );
+    if ( ++m_frames < SETTLE_FRAMES ) return m_scale;
+
+    // the scale which would just fit (the time follows the area)
+    float ideal = m_scale * static_cast<float>(
+        sqrt( HEADROOM * budget / m_average )
+    );
+    if ( ideal < minimum ) ideal = minimum;
+    if ( ideal > 1.f ) ideal = 1.f;
+
+    // go down as far as needed, but back up only half way
+    float next = ( ideal < m_scale ) ? ideal : m_scale + 0.5f * ( ideal - m_scale );
+    if ( (ideal == 1.f) && (1.f - next < STEP) ) next = 1.f;
+    if ( fabs( next - m_scale ) < STEP ) {
+        // keep to the allowed range, even for a small change
+        if ( (m_scale >= minimum) && (m_scale <= 1.f) ) return m_scale;
+        next = ideal;
+    }
+
+    if (Log::info()) {
+        Log::print() << "capture resolution " << static_cast<int>( 100.f * next + 0.5f )
+            << "% (frame time " << m_average << "ms)\n";
+    }
+    m_scale = next;
+    m_frames = 0;
+    return m_scale;
+}//update
+
+//-----------------------------------------------------------------------------
+
+void ResolutionController::reset()
+{
+    m_scale = 1.f;
+    m_average = 0.0;
+    m_frames = 0;
+}
@@ -0,0 +1,68 @@
+#ifndef hive_ResolutionController_h
+#define hive_ResolutionController_h
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+/**
+ * Chooses the fraction of each eye's width and height which the application
+ * renders, from the time its frames take, so that it keeps within a frame
+ * budget under load (the captured image is scaled back up to the window by
+ * GL).
+ *
+ * The frame time is taken to follow the rendered area, so each change moves
+ * the scale towards the one which would just fit the budget (less some
+ * headroom): straight down when over budget, but only part of the way back
+ * up. Each change waits for measurements of frames rendered at the new scale
+ * (GPU timings arrive a few frames late), and small changes are ignored, so
+ * the scale settles rather than changing every frame.
+ */
+class ResolutionController {
+public:
+    /// Constructor (full resolution)
+    ResolutionController();
+
+    /// Returns the current scale (0..1)
+    float scale() const { return m_scale; }
+
+    /// Update with the time of a frame rendered at the current scale
+    /// (milliseconds), the frame budget (milliseconds, or 0 for full
+    /// resolution) and the smallest scale allowed: returns the scale
+    /// for the next frame
+    float update( double frameTime, double budget, float minimum );
+
+    /// Return to full resolution, and forget the measurements
+    void reset();
+
+private:
+    float    m_scale;       ///< current scale
+    double   m_average;     ///< smoothed frame time at the current scale
+    unsigned m_frames;      ///< frames measured at the current scale
+};
+
+//-----------------------------------------------------------------------------
+
+#endif//hive_ResolutionController_h
@@ -0,0 +1,449 @@
+#include "ResourceTracker.h"
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "DebugUtil.h"
+#include "Log.h"
+#include "Settings.h"
+
+using namespace hive;
+using namespace std;
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+namespace {
+
+/// private data under which the release notifier is attached to a resource
+/// {5C2C8F1A-3E4B-4D7A-9E61-2B8F0D4C7A13}
+const GUID TRACKER_GUID =
+    { 0x5c2c8f1a, 0x3e4b, 0x4d7a, { 0x9e, 0x61, 0x2b, 0x8f, 0x0d, 0x4c, 0x7a, 0x13 } };
+
+/// number of categories listed by each report
+const unsigned REPORT_CATEGORIES = 8;
+
+/// live totals of one category
+struct Totals {
+    unsigned long long bytes;   ///< bytes held
+    unsigned count;             ///< resources held
+    bool     video;             ///< in video memory (or system memory)?
+};
+
+/// totals by category
+typedef std::map<std::string, Totals> Categories;
+
+/// guards the totals (resources are created and destroyed on any thread)
+std::mutex g_mutex;
+Categories g_categories;
+
+/// Add a resource to its category
+void add( const std::string & category, unsigned long long bytes, bool video )
+{
+    std::lock_guard<std::mutex> lock( g_mutex );
+    Totals & totals = g_categories[category];
+    totals.bytes += bytes;
+    totals.count += 1;
+    totals.video = video;
+}
+
+/// Take a resource off its category
+void remove( const std::string & category, unsigned long long bytes )
+{
+    std::lock_guard<std::mutex> lock( g_mutex );
+    Categories::iterator i = g_categories.find( category );
+    if ( i == g_categories.end() ) return;
+    i->second.bytes -= bytes;
+    if ( --i->second.count == 0 ) g_categories.erase( i );
+}
+
+/**
+ * Attached to a resource as private data: the resource holds the last
+ * reference, and releases it as the resource is destroyed, which takes the
+ * resource off its category.
+ */
+class Releaser : public IUnknown {
+public:
+    Releaser( const std::string & category, unsigned long long bytes, bool video ) :
+        m_refs( 1 ),
+        m_category( category ),
+        m_bytes( bytes )
+    {
+        add( m_category, m_bytes, video );
+    }
+
+    STDMETHOD(QueryInterface)( REFIID riid, void **ppvObj )
+    {
+        if ( riid != __uuidof(IUnknown) ) {
+            *ppvObj = 0;
+            return E_NOINTERFACE;
+        }
+        *ppvObj = this;
+        AddRef();
+        return S_OK;
+    }
+
+    STDMETHOD_(ULONG,AddRef)()
+    {
+        return InterlockedIncrement( &m_refs );
+    }
+
+    STDMETHOD_(ULONG,Release)()
+    {
+        const ULONG refs = InterlockedDecrement( &m_refs );
+        if ( refs == 0 ) {
+            remove( m_category, m_bytes );
+            delete this;
+        }
+        return refs;
+    }
+
+private:
+    LONG m_refs;                ///< reference count
+    std::string m_category;     ///< category of the resource
+    unsigned long long m_bytes; ///< size of the resource
+};
+
+/// Returns the bits per pixel of a Direct3D 9 format (of its 4x4 blocks, for
+/// DXT formats)
+unsigned formatBits( D3DFORMAT format )
+{
+    switch ( format ) {
+        case D3DFMT_DXT1:
+            return 4;
+        case D3DFMT_DXT2: case D3DFMT_DXT3: case D3DFMT_DXT4: case D3DFMT_DXT5:
+        case D3DFMT_A8: case D3DFMT_L8: case D3DFMT_P8: case D3DFMT_A4L4:
+            return 8;
+        case D3DFMT_R5G6B5: case D3DFMT_X1R5G5B5: case D3DFMT_A1R5G5B5:
+        case D3DFMT_A4R4G4B4: case D3DFMT_X4R4G4B4: case D3DFMT_A8R3G3B2:
+        case D3DFMT_A8L8: case D3DFMT_A8P8: case D3DFMT_L16: case D3DFMT_R16F:
+        case D3DFMT_V8U8: case D3DFMT_L6V5U5: case D3DFMT_D16:
+        case D3DFMT_D16_LOCKABLE: case D3DFMT_D15S1: case D3DFMT_UYVY:
+        case D3DFMT_YUY2: case D3DFMT_R8G8_B8G8: case D3DFMT_G8R8_G8B8:
+            return 16;
+        case D3DFMT_R8G8B8:
+            return 24;
+        case D3DFMT_A16B16G16R16: case D3DFMT_A16B16G16R16F:
+        case D3DFMT_G32R32F: case D3DFMT_Q16W16V16U16:
+            return 64;
+        case D3DFMT_A32B32G32R32F:
+            return 128;
+        default:
+            return 32;
+    }
+}
+
+/// Returns the bytes of one level of a Direct3D 9 resource
+unsigned long long levelBytes(
+    D3DFORMAT format,
+    unsigned width,
+    unsigned height,
+    unsigned depth
+) {
+    // DXT formats are stored in whole 4x4 blocks
+    if ( (format == D3DFMT_DXT1) || (format == D3DFMT_DXT2) ||
+         (format == D3DFMT_DXT3) || (format == D3DFMT_DXT4) ||
+         (format == D3DFMT_DXT5)
+    ) {
+        width  = ( width  + 3 ) & ~3u;
+        height = ( height + 3 ) & ~3u;
+    }
+    return ( static_cast<unsigned long long>( width ) * height * depth *
+        formatBits( format ) + 7 ) / 8;
+}
+
+#if defined(SUPPORT_D3D11)
+/// Returns the bits per pixel of a DXGI format (of its 4x4 blocks, for block
+/// compressed formats), and whether it is block compressed
+unsigned formatBits( DXGI_FORMAT format, bool & block )
+{
+    block = ( (format >= DXGI_FORMAT_BC1_TYPELESS) && (format <= DXGI_FORMAT_BC5_SNORM) ) ||
+            ( (format >= DXGI_FORMAT_BC6H_TYPELESS) && (format <= DXGI_FORMAT_BC7_UNORM_SRGB) );
+
+    if ( format == DXGI_FORMAT_UNKNOWN )                return 8;
+    if ( format <= DXGI_FORMAT_R32G32B32A32_SINT )      return 128;
+    if ( format <= DXGI_FORMAT_R32G32B32_SINT )         return 96;
+    if ( format <= DXGI_FORMAT_X32_TYPELESS_G8X24_UINT ) return 64;
+    if ( format <= DXGI_FORMAT_X24_TYPELESS_G8_UINT )   return 32;
+    if ( format <= DXGI_FORMAT_R16_SINT )               return 16;
+    if ( format <= DXGI_FORMAT_A8_UNORM )               return 8;
+    if ( format == DXGI_FORMAT_R1_UNORM )               return 1;
+    if ( format == DXGI_FORMAT_R9G9B9E5_SHAREDEXP )     return 32;
+    if ( format <= DXGI_FORMAT_G8R8_G8B8_UNORM )        return 16;
+    if ( format <= DXGI_FORMAT_BC1_UNORM_SRGB )         return 4;
+    if ( format <= DXGI_FORMAT_BC3_UNORM_SRGB )         return 8;
+    if ( format <= DXGI_FORMAT_BC4_SNORM )              return 4;
+    if ( format <= DXGI_FORMAT_BC5_SNORM )              return 8;
+    if ( format <= DXGI_FORMAT_B5G5R5A1_UNORM )         return 16;
+    if ( format <= DXGI_FORMAT_B8G8R8X8_UNORM_SRGB )    return 32;
+    if ( format <= DXGI_FORMAT_BC7_UNORM_SRGB )         return 8;
+    return 32;
+}
+
+/// Returns the bytes of one level of a Direct3D 11 resource
+unsigned long long levelBytes(
+    DXGI_FORMAT format,
+    unsigned width,
+    unsigned height,
+    unsigned depth
+) {
+    bool block = false;
+    const unsigned bits = formatBits( format, block );
+    if ( block ) {
+        width  = ( width  + 3 ) & ~3u;
+        height = ( height + 3 ) & ~3u;
+    }
+    return ( static_cast<unsigned long long>( width ) * height * depth * bits + 7 ) / 8;
+}
+
+/// Returns the size of a mip level (at least 1)
+unsigned mip( unsigned size, unsigned level )
+{
+    return ( (size >> level) > 0 ) ? ( size >> level ) : 1;
+}
+#endif
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+
+void ResourceTracker::track( IDirect3DResource9 *resource, const char *owner )
+{
+    if ( (resource == 0) || !Settings::get().trackMemory ) return;
+
+    D3DFORMAT format = D3DFMT_UNKNOWN;
+    D3DPOOL   pool   = D3DPOOL_DEFAULT;
+    DWORD     usage  = 0;
+    unsigned long long bytes = 0;
+
+    switch ( resource->GetType() ) {
+        case D3DRTYPE_SURFACE: {
+            D3DSURFACE_DESC desc = {};
+            if ( static_cast<IDirect3DSurface9*>( resource )->GetDesc( &desc ) != D3D_OK )
+                return;
+            format = desc.Format;
+            pool   = desc.Pool;
+            usage  = desc.Usage;
+            bytes  = levelBytes( format, desc.Width, desc.Height, 1 );
+            if ( desc.MultiSampleType >= D3DMULTISAMPLE_2_SAMPLES )
+                bytes *= desc.MultiSampleType;
+            break;
+        }
+        case D3DRTYPE_TEXTURE: {
+            IDirect3DTexture9 *texture = static_cast<IDirect3DTexture9*>( resource );
+            for (DWORD i=0; i<texture->GetLevelCount(); ++i) {
+                D3DSURFACE_DESC desc = {};
+                if ( texture->GetLevelDesc( i, &desc ) != D3D_OK ) return;
+                format = desc.Format;
+                pool   = desc.Pool;
+                usage  = desc.Usage;
+                bytes += levelBytes( format, desc.Width, desc.Height, 1 );
+            }
+            break;
+        }
+        case D3DRTYPE_CUBETEXTURE: {
+            IDirect3DCubeTexture9 *texture = static_cast<IDirect3DCubeTexture9*>( resource );
+            for (DWORD i=0; i<texture->GetLevelCount(); ++i) {
+                D3DSURFACE_DESC desc = {};
+                if ( texture->GetLevelDesc( i, &desc ) != D3D_OK ) return;
+                format = desc.Format;
+                pool   = desc.Pool;
+                usage  = desc.Usage;
+                bytes += 6 * levelBytes( format, desc.Width, desc.Height, 1 );
+            }
+            break;
+        }
+        case D3DRTYPE_VOLUMETEXTURE: {
+            IDirect3DVolumeTexture9 *texture = static_cast<IDirect3DVolumeTexture9*>( resource );
+            for (DWORD i=0; i<texture->GetLevelCount(); ++i) {
+                D3DVOLUME_DESC desc = {};
+                if ( texture->GetLevelDesc( i, &desc ) != D3D_OK ) return;
+                format = desc.Format;
+                pool   = desc.Pool;
+                usage  = desc.Usage;
+                bytes += levelBytes( format, desc.Width, desc.Height, desc.Depth );
+            }
+            break;
+        }
+        case D3DRTYPE_VERTEXBUFFER: {
+            D3DVERTEXBUFFER_DESC desc = {};
+            if ( static_cast<IDirect3DVertexBuffer9*>( resource )->GetDesc( &desc ) != D3D_OK )
+                return;
+            format = desc.Format;
+            pool   = desc.Pool;
+            usage  = desc.Usage;
+            bytes  = desc.Size;
+            break;
+        }
+        case D3DRTYPE_INDEXBUFFER: {
+            D3DINDEXBUFFER_DESC desc = {};
+            if ( static_cast<IDirect3DIndexBuffer9*>( resource )->GetDesc( &desc ) != D3D_OK )
+                return;
+            format = desc.Format;
+            pool   = desc.Pool;
+            usage  = desc.Usage;
+            bytes  = desc.Size;
+            break;
+        }
+        default:
+            return;
+    }
+
+    ostringstream category;
+    category << owner << ' ' << D3DFORMATtoString( format ) << ' '
+             << D3DPOOLtoString( pool ) << ' '
+             << ( (usage != 0) ? D3DUSAGEtoString( usage ) : "0" );
+
+    // managed resources live in both, but it is their video memory which
+    // is paged
+    const bool video = ( pool == D3DPOOL_DEFAULT ) || ( pool == D3DPOOL_MANAGED );
+
+    // the resource holds the only reference to the releaser from now on
+    // (attaching one replaces any earlier one, which is released)
+    Releaser *releaser = new Releaser( category.str(), bytes, video );
+    resource->SetPrivateData( TRACKER_GUID, releaser, sizeof(IUnknown*), D3DSPD_IUNKNOWN );
+    releaser->Release();
+}
+
+//-----------------------------------------------------------------------------
+
+#if defined(SUPPORT_D3D11)
+void ResourceTracker::track( ID3D11Resource *resource, const char *owner )
+{
+    if ( (resource == 0) || !Settings::get().trackMemory ) return;
+
+    DXGI_FORMAT format = DXGI_FORMAT_UNKNOWN;
+    D3D11_USAGE usage = D3D11_USAGE_DEFAULT;
+    UINT bind = 0;
+    unsigned long long bytes = 0;
+
+    D3D11_RESOURCE_DIMENSION dimension = D3D11_RESOURCE_DIMENSION_UNKNOWN;
+    resource->GetType( &dimension );
+
+    switch ( dimension ) {
+        case D3D11_RESOURCE_DIMENSION_BUFFER: {
+            D3D11_BUFFER_DESC desc = {};
+            static_cast<ID3D11Buffer*>( resource )->GetDesc( &desc );
+            usage = desc.Usage;
+            bind  = desc.BindFlags;
+            bytes = desc.ByteWidth;
+            break;
+        }
+        case D3D11_RESOURCE_DIMENSION_TEXTURE1D: {
+            D3D11_TEXTURE1D_DESC desc = {};
+            static_cast<ID3D11Texture1D*>( resource )->GetDesc( &desc );
+            format = desc.Format;
+            usage  = desc.Usage;
+            bind   = desc.BindFlags;
+            for (UINT i=0; i<desc.MipLevels; ++i)
+                bytes += levelBytes( format, mip( desc.Width, i ), 1, 1 );
+            bytes *= desc.ArraySize;
+            break;
+        }
+        case D3D11_RESOURCE_DIMENSION_TEXTURE2D: {
+            D3D11_TEXTURE2D_DESC desc = {};
+            static_cast<ID3D11Texture2D*>( resource )->GetDesc( &desc );
+            format = desc.Format;
+            usage  = desc.Usage;
+            bind   = desc.BindFlags;
+            for (UINT i=0; i<desc.MipLevels; ++i)
+                bytes += levelBytes(
+                    format, mip( desc.Width, i ), mip( desc.Height, i ), 1 );
+            bytes *= desc.ArraySize * desc.SampleDesc.Count;
+            break;
+        }
+        case D3D11_RESOURCE_DIMENSION_TEXTURE3D: {
+            D3D11_TEXTURE3D_DESC desc = {};
+            static_cast<ID3D11Texture3D*>( resource )->GetDesc( &desc );
+            format = desc.Format;
+            usage  = desc.Usage;
+            bind   = desc.BindFlags;
+            for (UINT i=0; i<desc.MipLevels; ++i)
+                bytes += levelBytes( format,
+                    mip( desc.Width, i ), mip( desc.Height, i ), mip( desc.Depth, i ) );
+            break;
+        }
+        default:
+            return;
+    }
+
+    static const char *usageNames[] = { "DEFAULT", "IMMUTABLE", "DYNAMIC", "STAGING" };
+    ostringstream category;
+    category << owner << " DXGI_FORMAT " << format << " D3D11_USAGE_"
+             << ( (usage <= D3D11_USAGE_STAGING) ? usageNames[usage] : "?" )
+             << " bind 0x" << hex << bind;
+
+    // staging resources are the ones the CPU reads and writes
+    Releaser *releaser = new Releaser( category.str(), bytes, usage != D3D11_USAGE_STAGING );
+    resource->SetPrivateDataInterface( TRACKER_GUID, releaser );
+    releaser->Release();
+}
+#endif
+
+//-----------------------------------------------------------------------------
+
+void ResourceTracker::report()
+{
+    if ( !Settings::get().trackMemory ) return;
+
+    // copy the totals, so that the report is formatted without the lock
+    vector< pair<unsigned long long, string> > largest;
+    unsigned long long videoBytes = 0, systemBytes = 0;
+    unsigned videoCount = 0, systemCount = 0;
+    {
+        std::lock_guard<std::mutex> lock( g_mutex );
+        for (Categories::const_iterator i=g_categories.begin(); i!=g_categories.end(); ++i) {
+            ostringstream name;
+            name << setw(6) << i->second.count << " x " << i->first;
+            largest.push_back( make_pair( i->second.bytes, name.str() ) );
+            if ( i->second.video ) {
+                videoBytes += i->second.bytes;
+                videoCount += i->second.count;
+            } else {
+                systemBytes += i->second.bytes;
+                systemCount += i->second.count;
+            }
+        }
+    }
+    sort( largest.rbegin(), largest.rend() );
+
+    // format the whole report first, so that it appears as one log entry
+    const double MB = 1.0 / ( 1024.0 * 1024.0 );
+    stringstream text;
+    text << fixed << setprecision(1)
+         << "DX memory (MB): video=" << videoBytes * MB << " in " << videoCount
+         << " resources, system=" << systemBytes * MB << " in " << systemCount
+         << " resources, largest:\n";
+    for (unsigned i=0; (i < largest.size()) && (i < REPORT_CATEGORIES); ++i)
+        text << "  " << setw(8) << largest[i].first * MB << ' ' << largest[i].second << '\n';
+
+    Log::print( text.str() );
+}
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,69 @@
+#ifndef hive_ResourceTracker_h
+#define hive_ResourceTracker_h
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+#include <d3d9.h>
+#if defined(SUPPORT_D3D11)
+#include <d3d11.h>
+#endif
+
+//-----------------------------------------------------------------------------
+
+/**
+ * Accounts for the memory held by Direct3D resources, so that the log shows
+ * what an application has filled video memory with before the driver starts
+ * paging. The size of each tracked resource is worked out from its
+ * description when it is created, and added to the totals for its owner,
+ * format, pool (or usage) and usage flags; it is taken off again when the
+ * resource is destroyed, which releases a private data interface attached
+ * to it for the purpose.
+ *
+ * Sizes are of the data alone (all mip levels, faces and samples), without
+ * the driver's alignment and padding. Resources in system memory are
+ * totalled apart from those in video memory. Tracking only happens with
+ * the trackMemory setting, and is thread safe.
+ */
+class ResourceTracker {
+public:
+    /// Track a Direct3D 9 resource (texture, surface or buffer) until it is
+    /// destroyed; tracking it again moves it to the new owner
+    static void track( IDirect3DResource9 *resource, const char *owner = "app" );
+
+#if defined(SUPPORT_D3D11)
+    /// Track a Direct3D 11 resource (texture or buffer) until it is destroyed
+    static void track( ID3D11Resource *resource, const char *owner = "app" );
+#endif
+
+    /// Write the live totals to the log: video and system memory, and the
+    /// largest categories
+    static void report();
+};
+
+//-----------------------------------------------------------------------------
+
+#endif//hive_ResourceTracker_h
@@ -1,149 +1,563 @@
-#include "Settings.h"
-#include <Windows.h>
-#include <VersionHelpers.h>
-
-//-----------------------------------------------------------------------------
-//
-// Copyright (C) 2012-14 James Ward, University of Hull
-//
-// This software is provided 'as-is', without any express or implied
-// warranty. In no event will the authors be held liable for any damages
-// arising from the use of this software.
-//
-// Permission is granted to anyone to use this software for any purpose,
-// including commercial applications, and to alter it and redistribute it
-// freely, subject to the following restrictions:
-//
-//    1. The origin of this software must not be misrepresented; you must not
-//    claim that you wrote the original software.
-//
-//    2. If you use this software in a product, an acknowledgment in the
-//    product documentation is required.
-//
-//    3. Altered source versions must be plainly marked as such, and must not
-//    be misrepresented as being the original software.
-//
-//    4. This notice may not be removed or altered from any source
-//    distribution.
-//
-//-----------------------------------------------------------------------------
-
-#include <fstream>
-#include <algorithm>
-using namespace std;
-
-#include "Log.h"
-using namespace hive;
-
-//-----------------------------------------------------------------------------
-
-const Settings & Settings::get()
-{
-    static Settings settings;
-    return settings;
-}
-
-//-----------------------------------------------------------------------------
-
-bool Settings::load( const std::string & fileName )
-{
-    // open the file
-    ifstream input( fileName.c_str() );
-    if ( !input ) return false;
-
-    struct {
-        // convert string to boolean
-        bool readBool( std::string text ) {
-            // convert to lower case
-            std::transform( text.begin(), text.end(), text.begin(), ::tolower );
-
-            // accept sensible values for true (anything else is false)
-            return ( text == "yes" ) || ( text == "true" ) || ( text == "1" );
-        }
-
-        // conert string to log level
-        Log::Level readLogLevel( std::string text ) {
-            // convert to lower case
-            std::transform( text.begin(), text.end(), text.begin(), ::tolower );
-
-            // convert text to logging level (accepts "warn" or "warning")
-            if (text.find_first_of( "error" ) == 0)
-                return Log::Level::Error;
-            else if (text.find_first_of( "warn" ) == 0)
-                return Log::Level::Warning;
-            else if (text.find_first_of( "info" ) == 0)
-                return Log::Level::Info;
-            else if (text.find_first_of( "verbose" ) == 0)
-                return Log::Level::Verbose;
-            else
-                return Log::Level::Info;
-        }
-    } local;
-
-    for (;;) {
-        // read key
-        string key;
-        input >> ws >> key;
-        if ( !input ) break;
-
-        // read value
-        string value;
-        input >> ws >> value;
-        if ( !input ) {
-            // missing values return an error
-            return false;
-        }
-
-        Log::print("Settings: ") << key << " = " << value << endl;
-
-        // store key/value
-        if ( key == "passThrough" )
-            passThrough = local.readBool( value );
-        else if ( key == "useTexture" )
-            useTexture = local.readBool( value );
-        else if ( key == "preventModeChange" )
-            preventModeChange = local.readBool( value );
-        else if ( key == "matchOriginalMSAA" )
-            matchOriginalMSAA = local.readBool( value );
-        else if ( key == "stereoIndicator" )
-            stereoIndicator = local.readBool( value );
-        else if ( key == "logLevel" ) {
-            logLevel = local.readLogLevel( value );
-        } else {
-            // unrecognised keys are currently ignored
-        }
-    }
-
-    // close the file
-    input.close();
-
-    return true;
-}
-
-//-----------------------------------------------------------------------------
-
-Settings::Settings() :
-    passThrough( false ),
-    forceDirect3D9Ex( false ),
-    useTexture( false ),
-    preventModeChange( true ),
-    matchOriginalMSAA( true ),
-    stereoIndicator( false )
-{
-    // initialise OS version info structure
-    OSVERSIONINFO info = {};
-    info.dwOSVersionInfoSize = sizeof(info);
-
-    // are we on Windows Vista or higher?
-    bool vistaUp = IsWindowsVistaOrGreater();
-
-    // force use of Direct3D9Ex on Vista upwards
-    forceDirect3D9Ex = vistaUp;
-
-    // attempt to load settings from file
-    static const std::string fileName( "quadifier.ini" );
-    if ( !load( fileName ) )
-        Log::print() << "Failed to load settings from [" << fileName << "]\n";
-}
-
-//-----------------------------------------------------------------------------
+#include "Settings.h"
+#include <Windows.h>
+#include <VersionHelpers.h>
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+#include <fstream>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstdio>
+#include <cwchar>
+#include <process.h>
+using namespace std;
+
+#include "Log.h"
+using namespace hive;
+
+//-----------------------------------------------------------------------------
+
+namespace {
+    /// The settings file, relative to the working directory
+    const char * const FILE_NAME = "quadifier.ini";
+    const wchar_t * const FILE_NAME_W = L"quadifier.ini";
+
+    /// Quiet time after a change before reloading (milliseconds), since
+    /// editors often save a file in several writes
+    const DWORD SETTLE_TIME = 200;
+
+    /// The published snapshot (0 until first use)
+    std::atomic<const Settings*> g_current( 0 );
+
+    /// The watcher thread, and the event which stops it
+    HANDLE g_watchThread = 0;
+    HANDLE g_watchStop = 0;
+
+    /// Does a batch of change notifications mention the file?
+    bool mentions( const void *buffer, const wchar_t *name )
+    {
+        const size_t length = wcslen( name );
+        const BYTE *next = static_cast<const BYTE*>( buffer );
+        for (;;) {
+            const FILE_NOTIFY_INFORMATION *info =
+                reinterpret_cast<const FILE_NOTIFY_INFORMATION*>( next );
+            if ( ( info->FileNameLength == length * sizeof(wchar_t) ) &&
+                 ( _wcsnicmp( info->FileName, name, length ) == 0 )
+            )
+                return true;
+            if ( info->NextEntryOffset == 0 ) return false;
+            next += info->NextEntryOffset;
+        }
+    }
+
+    /// Watch the directory holding the settings file, until stopped
+    unsigned __stdcall watchThread( void * )
+    {
+        // split the full path of the file into its directory and name
+        wchar_t path[MAX_PATH] = {};
+        wchar_t *name = 0;
+        if ( (GetFullPathNameW( FILE_NAME_W, MAX_PATH, path, &name ) == 0) ||
+             (name == 0)
+        ) {
+            Log::print( "Settings: unable to locate the settings file\n" );
+            return 0;
+        }
+        const std::wstring fileName( name );
+        *name = 0;
+
+        HANDLE directory = CreateFileW(
+            path, FILE_LIST_DIRECTORY,
+            FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+            0, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, 0
+        );
+        if ( directory == INVALID_HANDLE_VALUE ) {
+            Log::print( "Settings: unable to watch the settings file\n" );
+            return 0;
+        }
+
+        OVERLAPPED overlapped = {};
+        overlapped.hEvent = CreateEvent( 0, TRUE, FALSE, 0 );
+
+        // notifications are DWORD aligned
+        DWORD buffer[1024];
+
+        for (;;) {
+            const DWORD filter = FILE_NOTIFY_CHANGE_LAST_WRITE |
+                FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_FILE_NAME;
+            if ( !ReadDirectoryChangesW( directory, buffer, sizeof(buffer),
+                    FALSE, filter, 0, &overlapped, 0 )
+            )
+                break;
+
+            // wait for a change, or to be stopped
+            DWORD bytes = 0;
+            HANDLE handles[2] = { g_watchStop, overlapped.hEvent };
+            if ( WaitForMultipleObjects( 2, handles, FALSE, INFINITE ) != WAIT_OBJECT_0 + 1 ) {
+                // the buffer must outlive the request
+                CancelIo( directory );
+                GetOverlappedResult( directory, &overlapped, &bytes, TRUE );
+                break;
+            }
+            if ( !GetOverlappedResult( directory, &overlapped, &bytes, FALSE ) )
+                break;
+
+            // no bytes means the notifications overflowed (so reload anyway)
+            if ( (bytes != 0) && !mentions( buffer, fileName.c_str() ) )
+                continue;
+
+            // let the writer finish, then reload
+            if ( WaitForSingleObject( g_watchStop, SETTLE_TIME ) != WAIT_TIMEOUT )
+                break;
+            Settings::reload();
+        }
+
+        CloseHandle( overlapped.hEvent );
+        CloseHandle( directory );
+        return 0;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+const Settings & Settings::get()
+{
+    const Settings *current = g_current.load( std::memory_order_acquire );
+    if ( current == 0 ) {
+        // first use: if another thread gets there first, use its snapshot
+        Settings *initial = new Settings( FILE_NAME );
+        const Settings *expected = 0;
+        if ( g_current.compare_exchange_strong( expected, initial ) )
+            current = initial;
+        else {
+            delete initial;
+            current = expected;
+        }
+    }
+    return *current;
+}
+
+//-----------------------------------------------------------------------------
+
+bool Settings::reload()
+{
+    const Settings & current = get();
+
+    // start from the defaults, so that removing a key restores its default
+    Settings *next = new Settings( "" );
+    if ( !next->load( FILE_NAME ) ) {
+        // probably caught mid-write: keep the current snapshot
+        Log::print() << "Failed to reload settings from [" << FILE_NAME << "]\n";
+        delete next;
+        return false;
+    }
+    next->keepFixed( current );
+
+    // publish; the old snapshot is deliberately leaked, since any thread may
+    // still hold a reference to it (reloads are rare, and snapshots small)
+    g_current.store( next, std::memory_order_release );
+    Log::get().setLevel( next->logLevel );
+
+    if (Log::info())
+        Log::print() << "Settings: reloaded [" << FILE_NAME << "]\n";
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void Settings::watch()
+{
+    if ( g_watchThread != 0 ) return;
+
+    g_watchStop = CreateEvent( 0, TRUE, FALSE, 0 );
+    g_watchThread = reinterpret_cast<HANDLE>(
+        _beginthreadex( 0, 0, watchThread, 0, 0, 0 )
+    );
+    if ( g_watchThread != 0 )
+        SetThreadPriority( g_watchThread, THREAD_PRIORITY_BELOW_NORMAL );
+}
+
+//-----------------------------------------------------------------------------
+
+void Settings::unwatch()
+{
+    if ( g_watchThread == 0 ) return;
+
+    // this is called with the loader lock held, so we cannot wait for the
+    // thread to finish
+    SetEvent( g_watchStop );
+    CloseHandle( g_watchThread );
+    g_watchThread = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+void Settings::keepFixed( const Settings & startup )
+{
+    // these are read once, at startup or when the devices and windows are
+    // created, and mixing old and new values would break the pipeline
+    passThrough = startup.passThrough;
+    forceDirect3D9Ex = startup.forceDirect3D9Ex;
+    useTexture = startup.useTexture;
+    matchOriginalMSAA = startup.matchOriginalMSAA;
+    resolveMSAA = startup.resolveMSAA;
+    asyncPresent = startup.asyncPresent;
+    lowLatency = startup.lowLatency;
+    presenter = startup.presenter;
+    zeroCopy = startup.zeroCopy;
+    readback = startup.readback;
+    targetCount = startup.targetCount;
+    trackMemory = startup.trackMemory;
+    countCalls = startup.countCalls;
+    reproject = startup.reproject;
+    framePacing = startup.framePacing;
+    paceHeadroom = startup.paceHeadroom;
+    renderTask = startup.renderTask;
+    renderCore = startup.renderCore;
+    renderPriority = startup.renderPriority;
+    presentTask = startup.presentTask;
+    timerPeriod = startup.timerPeriod;
+    swapGroup = startup.swapGroup;
+    swapBarrier = startup.swapBarrier;
+    probeCache = startup.probeCache;
+    probePaths = startup.probePaths;
+    hookDevice = startup.hookDevice;
+    hookContext = startup.hookContext;
+    flipModel = startup.flipModel;
+    record = startup.record;
+    recordChunk = startup.recordChunk;
+    streamPort = startup.streamPort;
+    stereoPacking = startup.stereoPacking;
+    doubleWide = startup.doubleWide;
+    views = startup.views;
+    extrapolate = startup.extrapolate;
+    warp = startup.warp;
+    blend = startup.blend;
+    blendGamma = startup.blendGamma;
+    outputs = startup.outputs;
+}
+
+//-----------------------------------------------------------------------------
+
+bool Settings::load( const std::string & fileName )
+{
+    // open the file
+    ifstream input( fileName.c_str() );
+    if ( !input ) return false;
+
+    struct {
+        // convert string to boolean
+        bool readBool( std::string text ) {
+            // convert to lower case
+            std::transform( text.begin(), text.end(), text.begin(), ::tolower );
+
+            // accept sensible values for true (anything else is false)
+            return ( text == "yes" ) || ( text == "true" ) || ( text == "1" );
+        }
+
+        // convert string to unsigned integer, clamped to a range
+        unsigned readUnsigned( const std::string & text, unsigned low, unsigned high ) {
+            unsigned long value = std::strtoul( text.c_str(), 0, 10 );
+            if ( value < low ) return low;
+            if ( value > high ) return high;
+            return static_cast<unsigned>( value );
+        }
+
+        // convert string to float, clamped to a range
+        float readFloat( const std::string & text, float low, float high ) {
+            float value = static_cast<float>( std::strtod( text.c_str(), 0 ) );
+            if ( !(value >= low) ) return low;
+            if ( value > high ) return high;
+            return value;
+        }
+
+        // file name, where "none" is no file
+        std::string readFile( const std::string & text ) {
+            return ( text == "none" ) ? std::string() : text;
+        }
+
+        // MMCSS task name, where "none" is no task (and "ProAudio" is the
+        // "Pro Audio" task, as values cannot contain spaces)
+        std::string readTask( const std::string & text ) {
+            std::string lower( text );
+            std::transform( lower.begin(), lower.end(), lower.begin(), ::tolower );
+            if ( lower == "none" ) return std::string();
+            if ( lower == "proaudio" ) return "Pro Audio";
+            return text;
+        }
+
+        // conert string to log level
+        Log::Level readLogLevel( std::string text ) {
+            // convert to lower case
+            std::transform( text.begin(), text.end(), text.begin(), ::tolower );
+
+            // convert text to logging level (accepts "warn" or "warning")
+            if (text.find_first_of( "error" ) == 0)
+                return Log::Level::Error;
+            else if (text.find_first_of( "warn" ) == 0)
+                return Log::Level::Warning;
+            else if (text.find_first_of( "info" ) == 0)
+                return Log::Level::Info;
+            else if (text.find_first_of( "verbose" ) == 0)
+                return Log::Level::Verbose;
+            else
+                return Log::Level::Info;
+        }
+
+        // convert string to stereo packing (anything unknown is none)
+        Settings::Packing readPacking( std::string text ) {
+            // convert to lower case
+            std::transform( text.begin(), text.end(), text.begin(), ::tolower );
+
+            if ( text == "sidebyside" )
+                return Settings::PACKING_SIDE_BY_SIDE;
+            else if ( text == "topbottom" )
+                return Settings::PACKING_TOP_BOTTOM;
+            else if ( text == "rows" )
+                return Settings::PACKING_ROWS;
+            else
+                return Settings::PACKING_NONE;
+        }
+
+        // convert "x,y,w,h/left,top,width,height[/gpu[/left,right]]" to an
+        // output (showing views 0 and 1 unless the views are given)
+        bool readOutput( const std::string & text, Settings::Output & output ) {
+            output.gpu = 0;
+            output.view[0] = 0;
+            output.view[1] = 1;
+            int count = sscanf( text.c_str(), "%f,%f,%f,%f/%d,%d,%d,%d/%u/%u,%u",
+                &output.viewport[0], &output.viewport[1],
+                &output.viewport[2], &output.viewport[3],
+                &output.rect[0], &output.rect[1], &output.rect[2], &output.rect[3],
+                &output.gpu, &output.view[0], &output.view[1]
+            );
+            return ( count >= 8 ) && ( count != 10 ) &&
+                ( output.rect[2] > 0 ) && ( output.rect[3] > 0 );
+        }
+    } local;
+
+    for (;;) {
+        // read key
+        string key;
+        input >> ws >> key;
+        if ( !input ) break;
+
+        // read value
+        string value;
+        input >> ws >> value;
+        if ( !input ) {
+            // missing values return an error
+            return false;
+        }
+
+        Log::print("Settings: ") << key << " = " << value << endl;
+
+        // store key/value
+        if ( key == "passThrough" )
+            passThrough = local.readBool( value );
+        else if ( key == "useTexture" )
+            useTexture = local.readBool( value );
+        else if ( key == "preventModeChange" )
+            preventModeChange = local.readBool( value );
+        else if ( key == "matchOriginalMSAA" )
+            matchOriginalMSAA = local.readBool( value );
+        else if ( key == "resolveMSAA" )
+            resolveMSAA = local.readBool( value );
+        else if ( key == "stereoIndicator" )
+            stereoIndicator = local.readBool( value );
+        else if ( key == "hud" )
+            hud = local.readBool( value );
+        else if ( key == "asyncPresent" )
+            asyncPresent = local.readBool( value );
+        else if ( key == "lowLatency" )
+            lowLatency = local.readBool( value );
+        else if ( key == "presenter" )
+            presenter = local.readBool( value );
+        else if ( key == "zeroCopy" )
+            zeroCopy = local.readBool( value );
+        else if ( key == "readback" )
+            readback = local.readBool( value );
+        else if ( key == "targetCount" )
+            targetCount = local.readUnsigned( value, 3, 8 );
+        else if ( key == "statsInterval" )
+            statsInterval = local.readUnsigned( value, 0, 1000000 );
+        else if ( key == "trackMemory" )
+            trackMemory = local.readBool( value );
+        else if ( key == "countCalls" )
+            countCalls = local.readBool( value );
+        else if ( key == "reproject" )
+            reproject = local.readBool( value );
+        else if ( key == "reprojectSensor" )
+            reprojectSensor = local.readUnsigned( value, 0, 7 );
+        else if ( key == "reprojectFov" )
+            reprojectFov = local.readUnsigned( value, 10, 170 );
+        else if ( key == "framePacing" )
+            framePacing = local.readBool( value );
+        else if ( key == "paceHeadroom" )
+            paceHeadroom = local.readUnsigned( value, 0, 20000 );
+        else if ( key == "renderTask" )
+            renderTask = local.readTask( value );
+        else if ( key == "renderCore" )
+            renderCore = local.readUnsigned( value, 0, 64 );
+        else if ( key == "renderPriority" )
+            renderPriority = local.readBool( value );
+        else if ( key == "presentTask" )
+            presentTask = local.readBool( value );
+        else if ( key == "timerPeriod" )
+            timerPeriod = local.readUnsigned( value, 0, 15 );
+        else if ( key == "swapGroup" )
+            swapGroup = local.readUnsigned( value, 0, 1024 );
+        else if ( key == "swapBarrier" )
+            swapBarrier = local.readUnsigned( value, 0, 1024 );
+        else if ( key == "probeCache" )
+            probeCache = local.readBool( value );
+        else if ( key == "probePaths" )
+            probePaths = local.readBool( value );
+        else if ( key == "hookDevice" )
+            hookDevice = local.readBool( value );
+        else if ( key == "hookContext" )
+            hookContext = local.readBool( value );
+        else if ( key == "flipModel" )
+            flipModel = local.readBool( value );
+        else if ( key == "record" )
+            record = local.readBool( value );
+        else if ( key == "recordChunk" )
+            recordChunk = local.readUnsigned( value, 1, 100000 );
+        else if ( key == "streamPort" )
+            streamPort = local.readUnsigned( value, 0, 65535 );
+        else if ( key == "stereoPacking" )
+            stereoPacking = local.readPacking( value );
+        else if ( key == "doubleWide" )
+            doubleWide = local.readBool( value );
+        else if ( key == "views" )
+            views = local.readUnsigned( value, 2, 16 );
+        else if ( key == "resolutionBudget" )
+            resolutionBudget = local.readUnsigned( value, 0, 1000000 );
+        else if ( key == "minResolution" )
+            minResolution = local.readUnsigned( value, 25, 100 );
+        else if ( key == "sharpen" )
+            sharpen = local.readUnsigned( value, 0, 100 );
+        else if ( key == "extrapolate" )
+            extrapolate = local.readBool( value );
+        else if ( key == "warp" )
+            warp = local.readFile( value );
+        else if ( key == "blend" )
+            blend = local.readFile( value );
+        else if ( key == "blendGamma" )
+            blendGamma = local.readFloat( value, 1.f, 4.f );
+        else if ( key == "output" ) {
+            Output output;
+            if ( local.readOutput( value, output ) )
+                outputs.push_back( output );
+            else
+                Log::print( "Settings: invalid output [" ) << value << "]\n";
+        } else if ( (key == "outputWarp") || (key == "outputBlend") ) {
+            // applies to the output given last
+            if ( outputs.empty() )
+                Log::print( "Settings: " ) << key << " before any output\n";
+            else if ( key == "outputWarp" )
+                outputs.back().warp = local.readFile( value );
+            else
+                outputs.back().blend = local.readFile( value );
+        } else if ( key == "logLevel" ) {
+            logLevel = local.readLogLevel( value );
+        } else {
+            // unrecognised keys are currently ignored
+        }
+    }
+
+    // close the file
+    input.close();
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+Settings::Settings( const std::string & fileName ) :
+    passThrough( false ),
+    forceDirect3D9Ex( false ),
+    useTexture( false ),
+    preventModeChange( true ),
+    matchOriginalMSAA( true ),
+    resolveMSAA( true ),
+    stereoIndicator( false ),
+    hud( false ),
+    asyncPresent( false ),
+    lowLatency( false ),
+    presenter( false ),
+    zeroCopy( false ),
+    readback( false ),
+    targetCount( 3 ),
+    statsInterval( 0 ),
+    trackMemory( false ),
+    countCalls( false ),
+    reproject( false ),
+    reprojectSensor( 0 ),
+    reprojectFov( 90 ),
+    framePacing( false ),
+    paceHeadroom( 2000 ),
+    renderCore( 0 ),
+    renderPriority( false ),
+    presentTask( false ),
+    timerPeriod( 0 ),
+    swapGroup( 0 ),
+    swapBarrier( 0 ),
+    probeCache( true ),
+    probePaths( false ),
+    hookDevice( false ),
+    hookContext( false ),
+    flipModel( false ),
+    record( false ),
+    recordChunk( 600 ),
+    streamPort( 0 ),
+    stereoPacking( PACKING_NONE ),
+    doubleWide( false ),
+    views( 2 ),
+    resolutionBudget( 0 ),
+    minResolution( 50 ),
+    sharpen( 25 ),
+    extrapolate( false ),
+    blendGamma( 2.2f ),
+    logLevel( Log::Level::Info )
+{
+    // initialise OS version info structure
+    OSVERSIONINFO info = {};
+    info.dwOSVersionInfoSize = sizeof(info);
+
+    // are we on Windows Vista or higher?
+    bool vistaUp = IsWindowsVistaOrGreater();
+
+    // force use of Direct3D9Ex on Vista upwards
+    forceDirect3D9Ex = vistaUp;
+
+    // attempt to load settings from file (if any)
+    if ( !fileName.empty() && !load( fileName ) )
+        Log::print() << "Failed to load settings from [" << fileName << "]\n";
+}
+
+//-----------------------------------------------------------------------------
@@ -1,60 +1,142 @@
-#ifndef Settings_h
-#define Settings_h
-
-//-----------------------------------------------------------------------------
-//
-// Copyright (C) 2012-14 James Ward, University of Hull
-//
-// This software is provided 'as-is', without any express or implied
-// warranty. In no event will the authors be held liable for any damages
-// arising from the use of this software.
-//
-// Permission is granted to anyone to use this software for any purpose,
-// including commercial applications, and to alter it and redistribute it
-// freely, subject to the following restrictions:
-//
-//    1. The origin of this software must not be misrepresented; you must not
-//    claim that you wrote the original software.
-//
-//    2. If you use this software in a product, an acknowledgment in the
-//    product documentation is required.
-//
-//    3. Altered source versions must be plainly marked as such, and must not
-//    be misrepresented as being the original software.
-//
-//    4. This notice may not be removed or altered from any source
-//    distribution.
-//
-//-----------------------------------------------------------------------------
-
-#include <string>
-#include "Log.h"
-
-//-----------------------------------------------------------------------------
-
-namespace hive {
-
-struct Settings {
-    bool passThrough;       ///< Enable "pass through" mode
-    bool forceDirect3D9Ex;  ///< Force Direct3D9 applications to use Direct3D9Ex
-    bool useTexture;        ///< Use textures (true) or renderbuffers (false)
-    bool preventModeChange; ///< Prevent application from changing display mode
-    bool matchOriginalMSAA; ///< Should GL use same number of samples as DX?
-    bool stereoIndicator;   ///< Display stereo indicator?
-    Log::Level logLevel;    ///< Logging level
-
-    /// Returns the current settings
-    static const Settings & get();
-
-    /// Load settings from file
-    bool load( const std::string & fileName );
-
-private:
-    Settings();
-};
-
-} // namespace hive
-
-//-----------------------------------------------------------------------------
-
-#endif//Settings_h
+#ifndef Settings_h
+#define Settings_h
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+#include <string>
+#include <vector>
+#include "Log.h"
+
+//-----------------------------------------------------------------------------
+
+namespace hive {
+
+struct Settings {
+    /// An extra output window, showing part of each captured eye
+    struct Output {
+        float viewport[4];  ///< part of each eye (x,y,w,h from bottom left, 0..1)
+        int   rect[4];      ///< window position and size on the desktop
+        unsigned gpu;       ///< 0 = main GL GPU, else NV_gpu_affinity GPU gpu-1
+        unsigned view[2];   ///< views shown as the left and right eye
+        std::string warp;   ///< projector warp file (empty = none)
+        std::string blend;  ///< projector edge blend file (empty = none)
+    };
+
+    /// How both eyes are packed into one frame for passive stereo displays
+    enum Packing {
+        PACKING_NONE,           ///< quad buffered stereo (no packing)
+        PACKING_SIDE_BY_SIDE,   ///< left eye in the left half, right eye in the right
+        PACKING_TOP_BOTTOM,     ///< left eye in the top half, right eye in the bottom
+        PACKING_ROWS            ///< eyes on alternate rows, left eye on the top row
+    };
+
+    bool passThrough;       ///< Enable "pass through" mode
+    bool forceDirect3D9Ex;  ///< Force Direct3D9 applications to use Direct3D9Ex
+    bool useTexture;        ///< Use textures (true) or renderbuffers (false)
+    bool preventModeChange; ///< Prevent application from changing display mode
+    bool matchOriginalMSAA; ///< Should GL use same number of samples as DX?
+    bool resolveMSAA;       ///< Resolve DX multisampling before sharing with GL?
+    bool stereoIndicator;   ///< Display stereo indicator?
+    bool hud;               ///< Display the performance HUD?
+    bool asyncPresent;      ///< Present without waiting for the GL swap?
+    bool lowLatency;        ///< Direct3D9Ex frame latency of one, presents without waiting?
+    bool presenter;         ///< Hand frames to the presenter process instead of a GL thread?
+    bool zeroCopy;          ///< Share the DX back buffer with GL directly?
+    bool readback;          ///< Copy frames through system memory (no interop)?
+    unsigned targetCount;   ///< Number of DX/GL targets in the pool
+    unsigned statsInterval; ///< Frames between timing reports (0 = at exit)
+    bool trackMemory;       ///< Account for DX resource memory in the timing reports?
+    bool countCalls;        ///< Count the D3D9 draw and state calls of each view?
+    bool reproject;         ///< Late-latch the tracker rotation at present?
+    unsigned reprojectSensor; ///< Tracker sensor used for reprojection
+    unsigned reprojectFov;  ///< Horizontal field of view of each eye (degrees)
+    bool framePacing;       ///< Paint each frame just before the vblank?
+    unsigned paceHeadroom;  ///< Time left before the vblank (microseconds)
+    std::string renderTask; ///< MMCSS task of the GL thread (empty = none)
+    unsigned renderCore;    ///< Logical processor reserved for the GL thread (0 = none, else renderCore-1)
+    bool renderPriority;    ///< Raise the priority of the GL thread?
+    bool presentTask;       ///< Register the DX present thread with the MMCSS task too?
+    unsigned timerPeriod;   ///< System timer period while capturing (milliseconds, 0 = default)
+    unsigned swapGroup;     ///< NV swap group to join (0 = none)
+    unsigned swapBarrier;   ///< NV swap barrier to bind the group to (0 = none)
+    bool probeCache;        ///< Keep the GL driver probe results on disk?
+    bool probePaths;        ///< Time the interop formats and paths, and use the fastest?
+    bool hookDevice;        ///< Hook D3D9 device methods instead of a proxy?
+    bool hookContext;       ///< Hook D3D11 context methods instead of a proxy?
+    bool flipModel;         ///< Create D3D11 swap chains in the flip model (waitable)?
+    bool record;            ///< Record the painted frames to disk?
+    unsigned recordChunk;   ///< Frames per recording file
+    unsigned streamPort;    ///< Port to stream frames to display nodes on (0 = none)
+    Packing stereoPacking;  ///< Pack both eyes into one frame (passive stereo)?
+    bool doubleWide;        ///< Capture both eyes side by side in one target?
+    unsigned views;         ///< Views captured per stereo frame (2 = left and right)
+    unsigned resolutionBudget; ///< DX frame time to keep within (microseconds, 0 = full resolution)
+    unsigned minResolution; ///< Smallest capture resolution (percent of each side)
+    unsigned sharpen;       ///< Sharpening of images scaled up by GL (percent)
+    bool extrapolate;       ///< Repaint the last frame, reprojected, when DX is late?
+    std::string warp;       ///< Projector warp file of the main window (empty = none)
+    std::string blend;      ///< Projector edge blend file of the main window (empty = none)
+    float blendGamma;       ///< Display gamma the edge blends are converted to
+    std::vector<Output> outputs; ///< Extra output windows (one per key)
+    Log::Level logLevel;    ///< Logging level
+
+    /// Returns the current settings snapshot
+    ///
+    /// Snapshots are immutable, and are never freed once published, so the
+    /// reference stays valid; but read it once per frame (or per call) so
+    /// that related keys all come from the same snapshot.
+    static const Settings & get();
+
+    /// Reload the settings file and publish a new snapshot
+    ///
+    /// Only the keys which are safe to change while running take effect
+    /// (preventModeChange, stereoIndicator, hud, statsInterval,
+    /// reprojectSensor, reprojectFov, resolutionBudget, minResolution,
+    /// sharpen and logLevel); the rest keep their startup values.
+    static bool reload();
+
+    /// Start watching the settings file, reloading it when it changes
+    static void watch();
+
+    /// Stop watching the settings file
+    static void unwatch();
+
+    /// Load settings from file
+    bool load( const std::string & fileName );
+
+private:
+    Settings( const std::string & fileName );
+
+    /// Copy the keys which cannot change while running
+    void keepFixed( const Settings & startup );
+};
+
+} // namespace hive
+
+//-----------------------------------------------------------------------------
+
+#endif//Settings_h
@@ -0,0 +1,95 @@
+#include "SurfaceTable.h"
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+SurfaceTable::SurfaceTable() :
+    m_size( 0 ),
+    m_next( 0 ),
+    m_lastKey( 0 ),
+    m_lastResult( false )
+{
+    m_keys.fill( 0 );
+}
+
+//-----------------------------------------------------------------------------
+
+void SurfaceTable::insert( uintptr_t key )
+{
+    if ( (key == 0) || contains( key ) ) return;
+
+    if ( m_size < CAPACITY ) {
+        // append to the table
+        m_keys[m_size++] = key;
+    } else {
+        // replace the oldest entry
+        m_keys[m_next] = key;
+        m_next = (m_next + 1) % CAPACITY;
+    }
+
+    // the cached result may no longer be valid
+    m_lastKey = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+bool SurfaceTable::contains( uintptr_t key ) const
+{
+    if ( key == 0 ) return false;
+
+    // the same render target is usually queried several times per frame
+    if ( key == m_lastKey ) return m_lastResult;
+
+    bool found = false;
+    for (unsigned i=0; i<m_size; ++i) {
+        if ( m_keys[i] == key ) {
+            found = true;
+            break;
+        }
+    }
+
+    m_lastKey = key;
+    m_lastResult = found;
+    return found;
+}
+
+//-----------------------------------------------------------------------------
+
+void SurfaceTable::clear()
+{
+    m_size = 0;
+    m_next = 0;
+    m_lastKey = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+unsigned SurfaceTable::size() const
+{
+    return m_size;
+}
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,76 @@
+#ifndef hive_SurfaceTable_h
+#define hive_SurfaceTable_h
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+#include <array>
+#include <cstdint>
+
+//-----------------------------------------------------------------------------
+
+/**
+ * A small fixed-capacity set of surface keys (surface pointers, which are
+ * only compared and never dereferenced).
+ *
+ * This is used to remember the render targets that have been presented,
+ * and is queried on every Clear, so it is a flat array which is scanned
+ * linearly, and the result of the last query is cached. When the table is
+ * full, the oldest entry is replaced.
+ */
+class SurfaceTable {
+public:
+    /// Maximum number of keys
+    static const unsigned CAPACITY = 16;
+
+    /// Constructor
+    SurfaceTable();
+
+    /// Add a key, if not already present (0 is not a valid key)
+    void insert( uintptr_t key );
+
+    /// Returns true if the key is present
+    bool contains( uintptr_t key ) const;
+
+    /// Remove all the keys
+    void clear();
+
+    /// Returns the number of keys
+    unsigned size() const;
+
+private:
+    std::array<uintptr_t,CAPACITY> m_keys;  ///< storage for keys
+
+    unsigned m_size;                ///< number of keys stored
+    unsigned m_next;                ///< next entry to replace when full
+
+    mutable uintptr_t m_lastKey;    ///< key of the last query (or 0)
+    mutable bool m_lastResult;      ///< result of the last query
+};
+
+//-----------------------------------------------------------------------------
+
+#endif//hive_SurfaceTable_h
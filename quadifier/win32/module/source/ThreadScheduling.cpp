@@ -0,0 +1,189 @@
+#include "ThreadScheduling.h"
+#include "Log.h"
+
+using namespace hive;
+using namespace std;
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+namespace {
+
+/// MMCSS thread priority above the task's default (AVRT_PRIORITY_HIGH)
+const int TASK_PRIORITY_HIGH = 1;
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+
+ThreadScheduling::ThreadScheduling() :
+    m_avrt( 0 ),
+    m_winmm( 0 ),
+    m_task( 0 ),
+    m_thread( 0 ),
+    m_affinity( 0 ),
+    m_priority( THREAD_PRIORITY_NORMAL ),
+    m_raised( false ),
+    m_timerPeriod( 0 )
+{
+}
+
+//-----------------------------------------------------------------------------
+
+ThreadScheduling::~ThreadScheduling()
+{
+    leave();
+}
+
+//-----------------------------------------------------------------------------
+
+bool ThreadScheduling::enter(
+    const std::string & task, int core, bool raise, unsigned timerPeriod
+) {
+    leave();
+
+    bool success = true;
+
+    // a real handle to the thread, rather than the GetCurrentThread()
+    // pseudo-handle, so that leave restores this thread and not its caller
+    const HANDLE process = GetCurrentProcess();
+    if ( !DuplicateHandle( process, GetCurrentThread(), process, &m_thread,
+            0, FALSE, DUPLICATE_SAME_ACCESS )
+    ) {
+        Log::print( "warning: unable to open the thread for scheduling\n" );
+        m_thread = 0;
+        return false;
+    }
+
+    // register with the MMCSS task (its scheduling is set up under
+    // HKLM\SOFTWARE\Microsoft\Windows NT\CurrentVersion\Multimedia\SystemProfile\Tasks)
+    if ( !task.empty() ) {
+        m_avrt = LoadLibraryW( L"avrt.dll" );
+        SetTaskProc setTask = ( m_avrt == 0 ) ? 0 :
+            reinterpret_cast<SetTaskProc>( GetProcAddress( m_avrt, "AvSetMmThreadCharacteristicsW" ) );
+        DWORD index = 0;
+        const wstring name( task.begin(), task.end() );
+        if ( setTask != 0 ) m_task = setTask( name.c_str(), &index );
+        if ( m_task == 0 ) {
+            Log::print( "warning: unable to register thread with MMCSS task " ) << task << endl;
+            success = false;
+        } else if ( raise ) {
+            TaskPriorityProc setPriority = reinterpret_cast<TaskPriorityProc>(
+                GetProcAddress( m_avrt, "AvSetMmThreadPriority" ) );
+            if ( setPriority != 0 ) setPriority( m_task, TASK_PRIORITY_HIGH );
+        }
+    }
+
+    // raise the priority directly if MMCSS does not do it for us
+    if ( raise && (m_task == 0) ) {
+        m_priority = GetThreadPriority( m_thread );
+        m_raised = ( SetThreadPriority( m_thread, THREAD_PRIORITY_HIGHEST ) == TRUE );
+        if ( !m_raised ) {
+            Log::print( "warning: unable to raise thread priority\n" );
+            success = false;
+        }
+    }
+
+    // pin to the reserved logical processor
+    if ( core >= 0 ) {
+        const DWORD_PTR mask = static_cast<DWORD_PTR>( 1 ) << core;
+        DWORD_PTR process = 0, system = 0;
+        GetProcessAffinityMask( GetCurrentProcess(), &process, &system );
+        if ( (core < static_cast<int>( 8 * sizeof(DWORD_PTR) )) && ((process & mask) != 0) )
+            m_affinity = SetThreadAffinityMask( m_thread, mask );
+        if ( m_affinity == 0 ) {
+            Log::print( "warning: unable to pin thread to logical processor " ) << core << endl;
+            success = false;
+        }
+    }
+
+    // a shorter timer period (process wide, while the thread runs)
+    if ( timerPeriod > 0 ) {
+        m_winmm = LoadLibraryW( L"winmm.dll" );
+        PeriodProc beginPeriod = ( m_winmm == 0 ) ? 0 :
+            reinterpret_cast<PeriodProc>( GetProcAddress( m_winmm, "timeBeginPeriod" ) );
+        if ( (beginPeriod != 0) && (beginPeriod( timerPeriod ) == 0) ) {
+            m_timerPeriod = timerPeriod;
+        } else {
+            Log::print( "warning: unable to set the timer period to " ) << timerPeriod << "ms\n";
+            success = false;
+        }
+    }
+
+    if (Log::info())
+        Log::print() << "thread " << GetCurrentThreadId() << " scheduling: task "
+            << ( (m_task != 0) ? task : "none" )
+            << ", core " << ( (m_affinity != 0) ? core : -1 )
+            << ", raised " << ( (m_raised || (raise && (m_task != 0))) ? "yes" : "no" )
+            << ", timer period " << m_timerPeriod << "ms\n";
+
+    return success;
+}
+
+//-----------------------------------------------------------------------------
+
+void ThreadScheduling::leave()
+{
+    if ( m_task != 0 ) {
+        RevertTaskProc revertTask = reinterpret_cast<RevertTaskProc>(
+            GetProcAddress( m_avrt, "AvRevertMmThreadCharacteristics" ) );
+        if ( revertTask != 0 ) revertTask( m_task );
+        m_task = 0;
+    }
+
+    if ( m_raised ) {
+        SetThreadPriority( m_thread, m_priority );
+        m_raised = false;
+    }
+
+    if ( m_affinity != 0 ) {
+        SetThreadAffinityMask( m_thread, m_affinity );
+        m_affinity = 0;
+    }
+
+    if ( m_timerPeriod > 0 ) {
+        PeriodProc endPeriod = reinterpret_cast<PeriodProc>(
+            GetProcAddress( m_winmm, "timeEndPeriod" ) );
+        if ( endPeriod != 0 ) endPeriod( m_timerPeriod );
+        m_timerPeriod = 0;
+    }
+
+    if ( m_avrt != 0 ) {
+        FreeLibrary( m_avrt );
+        m_avrt = 0;
+    }
+    if ( m_winmm != 0 ) {
+        FreeLibrary( m_winmm );
+        m_winmm = 0;
+    }
+
+    if ( m_thread != 0 ) {
+        CloseHandle( m_thread );
+        m_thread = 0;
+    }
+}
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,90 @@
+#ifndef hive_ThreadScheduling_h
+#define hive_ThreadScheduling_h
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+#include <windows.h>
+#include <string>
+
+//-----------------------------------------------------------------------------
+
+/**
+ * Real-time scheduling of a thread: registers it with an MMCSS task (e.g.
+ * "Games" or "Pro Audio"), so that the multimedia class scheduler boosts it
+ * ahead of ordinary work, optionally pins it to a reserved logical
+ * processor, raises its priority, and shortens the system timer period
+ * while it runs (so that sleeps and waits end nearer their due time).
+ *
+ * avrt.dll and winmm.dll are loaded at run time, so the module does not
+ * depend on them; anything unavailable is skipped with a warning. Call
+ * enter on the thread being scheduled; leave restores that thread, from
+ * whichever thread calls it (e.g. a destructor run by another thread).
+ */
+class ThreadScheduling {
+public:
+    /// Constructor
+    ThreadScheduling();
+
+    /// Destructor (leaves, if still entered)
+    virtual ~ThreadScheduling();
+
+    /// Schedule the calling thread: task is the MMCSS task name (empty =
+    /// none), core the logical processor to pin it to (< 0 = any), raise
+    /// raises its priority, and timerPeriod is the timer period to request
+    /// in milliseconds (0 = leave it); returns false if any part failed
+    bool enter( const std::string & task, int core, bool raise, unsigned timerPeriod );
+
+    /// Restore the thread's scheduling, and the timer period
+    void leave();
+
+private:
+    /// Copy construction is not supported
+    ThreadScheduling( const ThreadScheduling & );
+
+    /// Assignment is not supported
+    ThreadScheduling & operator = ( const ThreadScheduling & );
+
+    /// Signatures of the avrt.dll and winmm.dll functions used
+    typedef HANDLE (WINAPI *SetTaskProc)( LPCWSTR, LPDWORD );
+    typedef BOOL (WINAPI *RevertTaskProc)( HANDLE );
+    typedef BOOL (WINAPI *TaskPriorityProc)( HANDLE, int );
+    typedef UINT (WINAPI *PeriodProc)( UINT );
+
+private:
+    HMODULE  m_avrt;            ///< avrt.dll (or 0)
+    HMODULE  m_winmm;           ///< winmm.dll (or 0)
+    HANDLE   m_task;            ///< MMCSS task handle (or 0)
+    HANDLE   m_thread;          ///< real handle of the thread entered (or 0)
+    DWORD_PTR m_affinity;       ///< affinity before pinning (0 = not pinned)
+    int      m_priority;        ///< priority before raising it
+    bool     m_raised;          ///< was the priority raised?
+    unsigned m_timerPeriod;     ///< timer period requested (0 = none)
+};
+
+//-----------------------------------------------------------------------------
+
+#endif//hive_ThreadScheduling_h
@@ -0,0 +1,88 @@
+#include "Trace.h"
+
+#if defined(SUPPORT_TRACELOGGING)
+
+#include <windows.h>
+#include <TraceLoggingProvider.h>
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+// the provider id is fixed, so that trace sessions can enable it by id as
+// well as by name (xperf -on Hive.Quadifier, or wpr with a custom profile)
+TRACELOGGING_DEFINE_PROVIDER(
+    g_provider,
+    "Hive.Quadifier",
+    // {0bc65684-7eee-58d9-bb9c-b0ef38cb67fc}
+    (0x0bc65684, 0x7eee, 0x58d9, 0xbb, 0x9c, 0xb0, 0xef, 0x38, 0xcb, 0x67, 0xfc)
+);
+
+// TraceLogging takes the event name and opcode as constants, so each step
+// is written by a pair of its own calls
+#define TRACE_STEP( name ) \
+    if ( start ) \
+        TraceLoggingWrite( g_provider, name, \
+            TraceLoggingOpcode( WINEVENT_OPCODE_START ), \
+            TraceLoggingUInt32( frame, "Frame" ), \
+            TraceLoggingUInt32( eye, "Eye" ) ); \
+    else \
+        TraceLoggingWrite( g_provider, name, \
+            TraceLoggingOpcode( WINEVENT_OPCODE_STOP ), \
+            TraceLoggingUInt32( frame, "Frame" ), \
+            TraceLoggingUInt32( eye, "Eye" ) )
+
+//-----------------------------------------------------------------------------
+
+void Trace::open()
+{
+    TraceLoggingRegister( g_provider );
+}
+
+//-----------------------------------------------------------------------------
+
+void Trace::close()
+{
+    TraceLoggingUnregister( g_provider );
+}
+
+//-----------------------------------------------------------------------------
+
+void Trace::write( Point point, bool start, unsigned frame, unsigned eye )
+{
+    switch ( point ) {
+    case BEGIN_CAPTURE: TRACE_STEP( "BeginCapture" ); break;
+    case END_CAPTURE:   TRACE_STEP( "EndCapture" ); break;
+    case STEREO_SIGNAL: TRACE_STEP( "StereoSignal" ); break;
+    case LOCK:          TRACE_STEP( "Lock" ); break;
+    case UNLOCK:        TRACE_STEP( "Unlock" ); break;
+    case BLIT:          TRACE_STEP( "Blit" ); break;
+    case SWAP:          TRACE_STEP( "Swap" ); break;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+#endif//SUPPORT_TRACELOGGING
@@ -0,0 +1,104 @@
+#ifndef hive_Trace_h
+#define hive_Trace_h
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+/**
+ * An ETW provider ("Hive.Quadifier") for lining the capture and paint
+ * pipeline up against the driver queues and the DWM in GPUView or WPA:
+ * each traced step writes a TraceLogging start event when it begins and a
+ * stop event when it ends, tagged with the frame id and eye, so a trace
+ * shows where a frame stalled. Writing an event costs a test of a flag
+ * while no trace session has the provider enabled.
+ *
+ * TraceLogging needs the Windows 10 SDK, so the provider is only built in
+ * SUPPORT_TRACELOGGING builds; otherwise every call does nothing, and is
+ * compiled away.
+ */
+class Trace {
+public:
+    /// The traced steps of the pipeline (a step which covers the whole
+    /// frame is tagged as eye 0)
+    enum Point {
+        BEGIN_CAPTURE,  ///< DX: start capturing a view into a target
+        END_CAPTURE,    ///< DX: hand a captured view on to GL
+        STEREO_SIGNAL,  ///< DX: the application signalled the next view
+        LOCK,           ///< GL: lock the shared DX targets
+        UNLOCK,         ///< GL: unlock the shared DX targets
+        BLIT,           ///< GL: draw a view (or a packed frame) to the window
+        SWAP            ///< GL: swap the window's buffers
+    };
+
+    /// Writes the start event of a step when constructed, and its stop
+    /// event when destroyed
+    class Scope {
+    public:
+        Scope( Point point, unsigned frame, unsigned eye ) :
+            m_point( point ), m_frame( frame ), m_eye( eye )
+        {
+            Trace::begin( point, frame, eye );
+        }
+
+        ~Scope() { Trace::end( m_point, m_frame, m_eye ); }
+
+    private:
+        Point    m_point;
+        unsigned m_frame;
+        unsigned m_eye;
+    };
+
+#if defined(SUPPORT_TRACELOGGING)
+    /// Register the provider (when the module is loaded)
+    static void open();
+
+    /// Unregister the provider (when the module is unloaded)
+    static void close();
+
+    /// Write the start event of a step
+    static void begin( Point point, unsigned frame, unsigned eye ) {
+        write( point, true, frame, eye );
+    }
+
+    /// Write the stop event of a step
+    static void end( Point point, unsigned frame, unsigned eye ) {
+        write( point, false, frame, eye );
+    }
+
+private:
+    /// Write the start or stop event of a step
+    static void write( Point point, bool start, unsigned frame, unsigned eye );
+#else
+    static void open() {}
+    static void close() {}
+    static void begin( Point, unsigned, unsigned ) {}
+    static void end( Point, unsigned, unsigned ) {}
+#endif
+};
+
+//-----------------------------------------------------------------------------
+
+#endif//hive_Trace_h
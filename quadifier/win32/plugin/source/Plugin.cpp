@@ -0,0 +1,252 @@
+#include "Plugin.h"
+#include <windows.h>
+#include <xmmintrin.h>
+#include <cmath>
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+namespace {
+
+/// Cameras processed together, one per SSE lane
+const int LANES = 4;
+
+/// Smallest eye to screen distance (avoids an infinite frustum)
+const float MIN_DISTANCE = 1.0e-4f;
+
+/// Floats in a 4x4 matrix
+const int MATRIX_FLOATS = 16;
+
+/// Rows of the per-lane camera data
+enum {
+    RIGHT = 0,          ///< camera right vector (3 rows)
+    UP = 3,             ///< camera up vector (3 rows)
+    NORMAL = 6,         ///< unit screen normal (3 rows)
+    EYE = 9,            ///< eye position (3 rows)
+    OFFSET = 12,        ///< screen plane offset
+    WIDTH = 13,         ///< screen width
+    HEIGHT = 14,        ///< screen height
+    LANE_FLOATS = 15
+};
+
+/// The camera basis of a screen, as set by Transform.LookAt in the script
+/// (forward along the negative normal, up as near to the screen up as it
+/// can be), plus the unit normal and its offset, for the eye distance
+struct Basis {
+    float right[3];
+    float up[3];
+    float normal[3];
+    float offset;       ///< distance of the screen plane along the normal
+    float width;
+    float height;
+};
+
+/// Normalise a vector in place (leaving a zero vector alone)
+void normalise( float v[3] )
+{
+    const float length = std::sqrt( v[0]*v[0] + v[1]*v[1] + v[2]*v[2] );
+    if ( length > 0.f ) {
+        v[0] /= length;
+        v[1] /= length;
+        v[2] /= length;
+    }
+}
+
+/// c = a x b
+void cross( const float a[3], const float b[3], float c[3] )
+{
+    c[0] = a[1]*b[2] - a[2]*b[1];
+    c[1] = a[2]*b[0] - a[0]*b[2];
+    c[2] = a[0]*b[1] - a[1]*b[0];
+}
+
+/// Work out the camera basis of one screen
+void makeBasis( const float *screen, Basis & basis )
+{
+    const float *centre = screen;
+    const float *normal = screen + 3;
+    const float *up = screen + 6;
+
+    for (int i=0; i<3; ++i) basis.normal[i] = normal[i];
+    normalise( basis.normal );
+
+    // Quaternion.LookRotation: right = up x forward, up = forward x right
+    const float forward[3] = { -basis.normal[0], -basis.normal[1], -basis.normal[2] };
+    cross( up, forward, basis.right );
+    normalise( basis.right );
+    cross( forward, basis.right, basis.up );
+
+    basis.offset = basis.normal[0]*centre[0] + basis.normal[1]*centre[1] +
+        basis.normal[2]*centre[2];
+    basis.width = screen[9];
+    basis.height = screen[10];
+}
+
+/// The quadifier module's view signal (exported by module.dll)
+typedef void (*PFNQuadifierSignalView)( unsigned view );
+
+/// The module's signal function, looked up by the first event (and only
+/// called on the render thread, so needs no locking)
+PFNQuadifierSignalView signalView = 0;
+
+/// Has the module been looked for yet?
+bool moduleChecked = false;
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+
+QUADIFIER_PLUGIN_API int __stdcall QuadifierComputeProjections(
+    const float *screens,
+    int screenCount,
+    const float *eyes,
+    int eyeCount,
+    float nearPlane,
+    float farPlane,
+    float *projections
+) {
+    if ( (screens == 0) || (eyes == 0) || (projections == 0) ) return 0;
+    if ( (screenCount <= 0) || (eyeCount <= 0) || (farPlane == nearPlane) ) return 0;
+
+    // terms which are the same for every camera
+    const float c = -( farPlane + nearPlane ) / ( farPlane - nearPlane );
+    const float d = -2.f * nearPlane * farPlane / ( farPlane - nearPlane );
+
+    const __m128 two = _mm_set1_ps( 2.f );
+    const __m128 minus2 = _mm_set1_ps( -2.f );
+    const __m128 minDistance = _mm_set1_ps( MIN_DISTANCE );
+    const __m128 signMask = _mm_set1_ps( -0.f );
+
+    const int cameras = screenCount * eyeCount;
+    Basis basis = {};
+    int basisScreen = -1;
+
+    for (int first=0; first<cameras; first+=LANES) {
+        // gather the basis and eye of each camera into lanes (unused lanes
+        // repeat the last camera, and are not written out)
+        __declspec(align(16)) float lane[LANE_FLOATS][LANES];
+        for (int i=0; i<LANES; ++i) {
+            const int camera = ( first + i < cameras ) ? first + i : cameras - 1;
+            const int screen = camera / eyeCount;
+            if ( screen != basisScreen ) {
+                makeBasis( screens + screen * QUADIFIER_SCREEN_FLOATS, basis );
+                basisScreen = screen;
+            }
+            const float *eye = eyes + 3 * ( camera % eyeCount );
+
+            for (int j=0; j<3; ++j) {
+                lane[RIGHT+j][i] = basis.right[j];
+                lane[UP+j][i] = basis.up[j];
+                lane[NORMAL+j][i] = basis.normal[j];
+                lane[EYE+j][i] = eye[j];
+            }
+            lane[OFFSET][i] = basis.offset;
+            lane[WIDTH][i] = basis.width;
+            lane[HEIGHT][i] = basis.height;
+        }
+
+        const __m128 ex = _mm_load_ps( lane[EYE] );
+        const __m128 ey = _mm_load_ps( lane[EYE+1] );
+        const __m128 ez = _mm_load_ps( lane[EYE+2] );
+
+        // the eye in camera coordinates (Quaternion.Inverse( rotation ) * eye)
+        const __m128 eyeX = _mm_add_ps( _mm_add_ps(
+            _mm_mul_ps( ex, _mm_load_ps( lane[RIGHT] ) ),
+            _mm_mul_ps( ey, _mm_load_ps( lane[RIGHT+1] ) ) ),
+            _mm_mul_ps( ez, _mm_load_ps( lane[RIGHT+2] ) ) );
+        const __m128 eyeY = _mm_add_ps( _mm_add_ps(
+            _mm_mul_ps( ex, _mm_load_ps( lane[UP] ) ),
+            _mm_mul_ps( ey, _mm_load_ps( lane[UP+1] ) ) ),
+            _mm_mul_ps( ez, _mm_load_ps( lane[UP+2] ) ) );
+
+        // distance from the eye to the screen plane
+        __m128 distance = _mm_sub_ps( _mm_add_ps( _mm_add_ps(
+            _mm_mul_ps( ex, _mm_load_ps( lane[NORMAL] ) ),
+            _mm_mul_ps( ey, _mm_load_ps( lane[NORMAL+1] ) ) ),
+            _mm_mul_ps( ez, _mm_load_ps( lane[NORMAL+2] ) ) ),
+            _mm_load_ps( lane[OFFSET] ) );
+        distance = _mm_max_ps( _mm_andnot_ps( signMask, distance ), minDistance );
+
+        // the script's frustum is left/right = (-eyeX -/+ width/2) * near /
+        // distance (and likewise bottom/top), where the near plane cancels
+        // out of the scale and offset terms of the projection
+        const __m128 invWidth = _mm_div_ps( _mm_set1_ps( 1.f ), _mm_load_ps( lane[WIDTH] ) );
+        const __m128 invHeight = _mm_div_ps( _mm_set1_ps( 1.f ), _mm_load_ps( lane[HEIGHT] ) );
+
+        __declspec(align(16)) float x[LANES], y[LANES], a[LANES], b[LANES];
+        _mm_store_ps( x, _mm_mul_ps( _mm_mul_ps( two, distance ), invWidth ) );
+        _mm_store_ps( y, _mm_mul_ps( _mm_mul_ps( two, distance ), invHeight ) );
+        _mm_store_ps( a, _mm_mul_ps( _mm_mul_ps( minus2, eyeX ), invWidth ) );
+        _mm_store_ps( b, _mm_mul_ps( _mm_mul_ps( minus2, eyeY ), invHeight ) );
+
+        // scatter the matrices (column-major, as Frustum.computeFrustum)
+        for (int i=0; (i<LANES) && (first+i<cameras); ++i) {
+            float *m = projections + MATRIX_FLOATS * ( first + i );
+            for (int j=0; j<MATRIX_FLOATS; ++j) m[j] = 0.f;
+            m[0]  = x[i];
+            m[5]  = y[i];
+            m[8]  = a[i];
+            m[9]  = b[i];
+            m[10] = c;
+            m[11] = -1.f;
+            m[14] = d;
+        }
+    }
+
+    return cameras;
+}
+
+//-----------------------------------------------------------------------------
+
+QUADIFIER_PLUGIN_API int __stdcall QuadifierViewEvent( int view )
+{
+    return QUADIFIER_EVENT_VIEW + view;
+}
+
+//-----------------------------------------------------------------------------
+
+QUADIFIER_PLUGIN_API void __stdcall UnityRenderEvent( int eventID )
+{
+    if ( (eventID < QUADIFIER_EVENT_VIEW) ||
+         (eventID >= QUADIFIER_EVENT_VIEW + QUADIFIER_MAX_VIEWS) )
+        return;
+
+    // the module is injected before Unity starts, so is either loaded by
+    // the first event or not at all
+    if ( !moduleChecked ) {
+        moduleChecked = true;
+        HMODULE module = GetModuleHandleA( "module.dll" );
+        if ( module != 0 ) {
+            signalView = reinterpret_cast<PFNQuadifierSignalView>(
+                GetProcAddress( module, "QuadifierSignalView" ) );
+        }
+    }
+
+    if ( signalView != 0 )
+        signalView( static_cast<unsigned>( eventID - QUADIFIER_EVENT_VIEW ) );
+}
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,97 @@
+#ifndef hive_Plugin_h
+#define hive_Plugin_h
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+/**
+ * Native Unity plugin, so that scripts can hand per-frame work which would
+ * otherwise allocate (and be scalar) in UnityScript to C++. All arrays are
+ * allocated by the caller, and are only read or written during the call.
+ */
+
+// functions use the stdcall convention expected by DllImport, and are
+// exported without decoration by Plugin.def
+#define QUADIFIER_PLUGIN_API extern "C"
+
+/// Event ID given to GL.IssuePluginEvent to signal that rendering of view 0
+/// is starting, plus the view number for the others (Unity passes every
+/// event to every plugin, so they are unlikely to be ones that another
+/// plugin uses: "QUA" and the view)
+#define QUADIFIER_EVENT_VIEW 0x51554100
+
+/// Most views in one frame (as in the quadifier module)
+#define QUADIFIER_MAX_VIEWS 16
+
+/// Event ID signalling that right eye rendering is starting
+#define QUADIFIER_EVENT_RIGHT_EYE ( QUADIFIER_EVENT_VIEW + 1 )
+
+/// Number of floats describing each screen: centre (x,y,z), normal (x,y,z),
+/// up (x,y,z), width, height, and one unused float
+#define QUADIFIER_SCREEN_FLOATS 12
+
+/**
+ * Compute the off-axis projection matrix of every eye of every screen, as
+ * CameraRig.updateCamera does in Quadifier.js: each camera sits at the eye,
+ * facing along the negative screen normal, with an asymmetric frustum
+ * through the edges of the screen.
+ *
+ * screens holds QUADIFIER_SCREEN_FLOATS floats per screen, and eyes three
+ * floats (x,y,z) per eye, in world coordinates. projections receives one
+ * column-major 4x4 matrix (the layout of a Unity Matrix4x4) per screen per
+ * eye, screen by screen: the matrix for screen s and eye e is at index
+ * s * eyeCount + e. Returns the number of matrices written.
+ */
+QUADIFIER_PLUGIN_API int __stdcall QuadifierComputeProjections(
+    const float *screens,
+    int screenCount,
+    const float *eyes,
+    int eyeCount,
+    float nearPlane,
+    float farPlane,
+    float *projections
+);
+
+/**
+ * Returns the event ID which signals the given view (QUADIFIER_EVENT_VIEW
+ * plus the view), so that the script can check that the plugin is loaded
+ * before it relies on the events to signal the eyes.
+ */
+QUADIFIER_PLUGIN_API int __stdcall QuadifierViewEvent( int view );
+
+/**
+ * Called by Unity on its render thread for each GL.IssuePluginEvent, in
+ * order with the rendering commands. On one of the view events this tells
+ * the quadifier module (if it has been injected into the process) that
+ * rendering of that view is starting, as the script's signalling camera
+ * does for the right eye with its (1,*,2,3) viewport; other events are
+ * ignored.
+ */
+QUADIFIER_PLUGIN_API void __stdcall UnityRenderEvent( int eventID );
+
+//-----------------------------------------------------------------------------
+
+#endif//hive_Plugin_h
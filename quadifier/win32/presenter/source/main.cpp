@@ -0,0 +1,679 @@
+#include <windows.h>
+#include <d3d9.h>
+#include <GL/gl.h>
+#include <GL/glext.h>
+#include <GL/wglext.h>
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Extensions.h"
+#include "GLWindow.h"
+#include "Log.h"
+#include "SharedFrames.h"
+
+using namespace hive;
+using namespace std;
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+namespace {
+
+/// The presenter's command line options
+struct Options {
+    std::vector<DWORD> processes;   ///< application processes to present
+    std::vector<RECT> rects;        ///< fixed window of each (else it follows the application's)
+    unsigned swapGroup;     ///< NV swap group to join (0 = none)
+    unsigned swapBarrier;   ///< NV swap barrier to bind the group to (0 = none)
+    bool hold;              ///< keep showing the last frames once the applications exit?
+
+    Options() :
+        swapGroup( 0 ),
+        swapBarrier( 0 ),
+        hold( false )
+    {
+    }
+};
+
+/// Number of slots and eyes in each pool of shared targets
+const unsigned SLOTS = SharedFrames::SLOTS;
+const unsigned EYES  = SharedFrames::EYES;
+
+/// Time between attempts to open the frames of an application (milliseconds)
+const DWORD RETRY_TIME = 1000;
+
+/// Time between checks of the application window's position (milliseconds)
+const DWORD FOLLOW_TIME = 250;
+
+/// Longest wait for anything to do while no window is shown (milliseconds)
+const DWORD IDLE_TIME = 100;
+
+/// The frames of one application process, and the window showing them
+struct Channel {
+    DWORD    processId;     ///< the application process
+    HANDLE   process;       ///< its handle (signalled when it exits)
+    bool     exited;        ///< has it exited (or never existed)?
+    SharedFrames frames;    ///< its shared frames (open once it creates them)
+    DWORD    retryTime;     ///< tick count of the last attempt to open them
+
+    GLWindow window;        ///< the window showing the frames
+    bool     stereo;        ///< is the window quad buffered?
+    bool     shown;         ///< is the window shown yet?
+    RECT     rect;          ///< its position and size on the desktop
+    bool     fixed;         ///< was the position given on the command line?
+    DWORD    followTime;    ///< tick count of the last check of the application window
+    Extensions glx;         ///< OpenGL extension functions (of its context)
+    bool     sync;          ///< are fences (ARB_sync) available?
+    int      interval;      ///< swap interval of the window (-1 = not set)
+
+    IDirect3DDevice9Ex *device; ///< our own device, which opens the shared targets
+    HANDLE   interop;       ///< the GL/DX interop device
+
+    unsigned generation;    ///< generation of the open pool (0 = none)
+    SharedFrames::Surfaces surfaces;        ///< the open pool
+    IDirect3DSurface9 *surface[SLOTS][EYES]; ///< the shared targets, opened
+    HANDLE   object[SLOTS][EYES];           ///< their interop objects
+    GLuint   renderBuffer[SLOTS][EYES];     ///< their GL renderbuffers
+    GLuint   frameBuffer[SLOTS][EYES];      ///< framebuffers to blit from
+
+    unsigned slot;          ///< slot held by us
+    bool     hasFrame;      ///< does it hold a frame which can be painted?
+    SharedFrames::Frame frame; ///< the frame in it
+    GLsync   fence;         ///< set once the GPU has painted it
+    unsigned painted;       ///< refreshes painted
+    unsigned received;      ///< frames received
+    unsigned skipped;       ///< frames published but never received
+
+    Channel() :
+        processId( 0 ),
+        process( 0 ),
+        exited( false ),
+        retryTime( 0 ),
+        stereo( false ),
+        shown( false ),
+        fixed( false ),
+        followTime( 0 ),
+        sync( false ),
+        interval( -1 ),
+        device( 0 ),
+        interop( 0 ),
+        generation( 0 ),
+        slot( SharedFrames::readSlot() ),
+        hasFrame( false ),
+        fence( 0 ),
+        painted( 0 ),
+        received( 0 ),
+        skipped( 0 )
+    {
+        SetRect( &rect, 0, 0, 640, 480 );
+        surfaces = SharedFrames::Surfaces();
+        frame = SharedFrames::Frame();
+        for (unsigned i = 0; i < SLOTS; ++i) {
+            for (unsigned j = 0; j < EYES; ++j) {
+                surface[i][j] = 0;
+                object[i][j] = 0;
+                renderBuffer[i][j] = 0;
+                frameBuffer[i][j] = 0;
+            }
+        }
+    }
+
+private:
+    /// Copy construction is not supported
+    Channel( const Channel & );
+
+    /// Assignment is not supported
+    Channel & operator = ( const Channel & );
+};
+
+Options      g_options;         ///< command line options
+IDirect3D9Ex *g_direct3D = 0;   ///< creates the device of each channel
+PFNWGLSWAPINTERVALEXTPROC g_swapInterval = 0; ///< WGL_EXT_swap_control (or 0)
+
+//-----------------------------------------------------------------------------
+
+/// The window procedure of the GL windows
+LRESULT CALLBACK windowProc( HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam )
+{
+    switch (uMsg) {
+    case WM_CLOSE:
+        PostQuitMessage( 0 );
+        return 0L;
+
+    case WM_KEYDOWN:
+        if ( wParam == VK_ESCAPE ) PostQuitMessage( 0 );
+        return 0L;
+    }
+
+    return DefWindowProc( hWnd, uMsg, wParam, lParam );
+}
+
+//-----------------------------------------------------------------------------
+
+/// Make the GL context of a channel current
+void makeCurrent( Channel & channel )
+{
+    wglMakeCurrent( channel.window.getHDC(), channel.window.getHGLRC() );
+}
+
+//-----------------------------------------------------------------------------
+
+/// Create the window, context and devices of a channel (its window is shown
+/// once the first frame arrives)
+bool createChannel( Channel & channel, bool first )
+{
+    // a topmost window which is never activated, so that the application
+    // keeps the keyboard focus; quad buffered if the driver allows, else a
+    // mono one (which shows the left eye)
+    GLWindow::Attributes attributes;
+    attributes[WGL_STEREO_ARB] = GL_TRUE;
+    attributes[WGL_DEPTH_BITS_ARB] = 0;
+    attributes[WGL_STENCIL_BITS_ARB] = 0;
+    const DWORD exStyle = WS_EX_TOPMOST | WS_EX_NOACTIVATE | WS_EX_TOOLWINDOW;
+    const DWORD style = WS_POPUP | WS_CLIPCHILDREN | WS_CLIPSIBLINGS;
+    const RECT & rect = channel.rect;
+    channel.stereo = channel.window.create(
+        exStyle, L"Quadifier presenter", style,
+        rect.left, rect.top, rect.right - rect.left, rect.bottom - rect.top,
+        0, 0, windowProc, 0, attributes
+    );
+    if ( !channel.stereo ) {
+        attributes.erase( WGL_STEREO_ARB );
+        if ( !channel.window.create(
+            exStyle, L"Quadifier presenter", style,
+            rect.left, rect.top, rect.right - rect.left, rect.bottom - rect.top,
+            0, 0, windowProc, 0, attributes
+        ) ) {
+            Log::print( "error: failed to create OpenGL window\n" );
+            return false;
+        }
+        Log::print( "warning: stereo is not available, showing the left eye\n" );
+    }
+
+    // the frames arrive through the DX interop
+    Extensions & glx = channel.glx;
+    if ( !glx.load() || !glx.hasFramebuffers() ) {
+        Log::print( "error: the GL/DX interop is not available\n" );
+        return false;
+    }
+    channel.sync = glx.loadSync();
+    if ( first ) {
+        g_swapInterval = reinterpret_cast<PFNWGLSWAPINTERVALEXTPROC>(
+            wglGetProcAddress( "wglSwapIntervalEXT" )
+        );
+    }
+
+    // frame lock with other displays (optional)
+    if ( g_options.swapGroup != 0 ) {
+        if ( glx.hasSwapGroup() &&
+             glx.wglJoinSwapGroupNV( channel.window.getHDC(), g_options.swapGroup ) &&
+             ( !first || (g_options.swapBarrier == 0) ||
+               glx.wglBindSwapBarrierNV( g_options.swapGroup, g_options.swapBarrier ) )
+        )
+            Log::print( "joined swap group " ) << g_options.swapGroup << endl;
+        else
+            Log::print( "warning: failed to join swap group " ) << g_options.swapGroup << endl;
+    }
+
+    // a device of our own opens the application's shared targets (it never
+    // presents, so the window and back buffer are only nominal)
+    D3DPRESENT_PARAMETERS parameters = {};
+    parameters.Windowed = TRUE;
+    parameters.SwapEffect = D3DSWAPEFFECT_DISCARD;
+    parameters.hDeviceWindow = channel.window.getHWND();
+    parameters.BackBufferWidth = 1;
+    parameters.BackBufferHeight = 1;
+    parameters.BackBufferFormat = D3DFMT_UNKNOWN;
+    if ( g_direct3D->CreateDeviceEx(
+            D3DADAPTER_DEFAULT, D3DDEVTYPE_HAL, channel.window.getHWND(),
+            D3DCREATE_HARDWARE_VERTEXPROCESSING | D3DCREATE_FPU_PRESERVE,
+            &parameters, NULL, &channel.device
+         ) != D3D_OK
+    ) {
+        Log::print( "error: failed to create Direct3D9Ex device\n" );
+        return false;
+    }
+
+    channel.interop = glx.wglDXOpenDeviceNV( channel.device );
+    if ( channel.interop == 0 ) {
+        Log::print( "error: failed to create GL/DX interop\n" );
+        return false;
+    }
+
+    // notice the application exiting (or not being there to begin with)
+    channel.process = OpenProcess( SYNCHRONIZE, FALSE, channel.processId );
+    if ( channel.process == 0 ) {
+        Log::print( "warning: no process " ) << channel.processId << endl;
+        channel.exited = true;
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+/// Release the pool of shared targets a channel has open (its context
+/// must be current)
+void releaseSurfaces( Channel & channel )
+{
+    Extensions & glx = channel.glx;
+    if ( channel.fence != 0 ) {
+        glx.glDeleteSync( channel.fence );
+        channel.fence = 0;
+    }
+    for (unsigned slot = 0; slot < SLOTS; ++slot) {
+        for (unsigned eye = 0; eye < EYES; ++eye) {
+            if ( channel.object[slot][eye] != 0 ) {
+                glx.wglDXUnregisterObjectNV( channel.interop, channel.object[slot][eye] );
+                channel.object[slot][eye] = 0;
+            }
+            if ( channel.frameBuffer[slot][eye] != 0 ) {
+                glx.glDeleteFramebuffers( 1, &channel.frameBuffer[slot][eye] );
+                channel.frameBuffer[slot][eye] = 0;
+            }
+            if ( channel.renderBuffer[slot][eye] != 0 ) {
+                glx.glDeleteRenderbuffers( 1, &channel.renderBuffer[slot][eye] );
+                channel.renderBuffer[slot][eye] = 0;
+            }
+            if ( channel.surface[slot][eye] != 0 ) {
+                channel.surface[slot][eye]->Release();
+                channel.surface[slot][eye] = 0;
+            }
+        }
+    }
+    channel.generation = 0;
+    channel.hasFrame = false;
+    channel.slot = SharedFrames::readSlot();
+}
+
+//-----------------------------------------------------------------------------
+
+/// Open the application's current pool of shared targets (its context must
+/// be current): the frame shown before is dropped
+void openSurfaces( Channel & channel )
+{
+    SharedFrames::Surfaces surfaces = {};
+    unsigned generation = 0;
+    if ( !channel.frames.surfaces( surfaces, generation ) ) return;
+
+    releaseSurfaces( channel );
+    channel.surfaces = surfaces;
+
+    // a failed pool is not tried again until the application replaces it
+    channel.generation = generation;
+
+    Extensions & glx = channel.glx;
+    for (unsigned slot = 0; slot < SLOTS; ++slot) {
+        for (unsigned eye = 0; eye < EYES; ++eye) {
+            // a shared target is opened by creating it with its handle
+            HANDLE handle = surfaces.handle[slot][eye];
+            if ( channel.device->CreateRenderTarget(
+                    surfaces.width, surfaces.height,
+                    static_cast<D3DFORMAT>( surfaces.format ),
+                    D3DMULTISAMPLE_NONE, 0, FALSE,
+                    &channel.surface[slot][eye], &handle
+                 ) != D3D_OK
+            ) {
+                Log::print( "error: failed to open the shared targets of process " )
+                    << channel.processId << endl;
+                releaseSurfaces( channel );
+                channel.generation = generation;
+                return;
+            }
+
+            glx.wglDXSetResourceShareHandleNV( channel.surface[slot][eye], handle );
+            glx.glGenRenderbuffers( 1, &channel.renderBuffer[slot][eye] );
+            channel.object[slot][eye] = glx.wglDXRegisterObjectNV(
+                channel.interop, channel.surface[slot][eye],
+                channel.renderBuffer[slot][eye], GL_RENDERBUFFER,
+                WGL_ACCESS_READ_ONLY_NV
+            );
+            if ( channel.object[slot][eye] == 0 ) {
+                Log::print( "error: failed to register the shared targets of process " )
+                    << channel.processId << endl;
+                releaseSurfaces( channel );
+                channel.generation = generation;
+                return;
+            }
+
+            glx.glGenFramebuffers( 1, &channel.frameBuffer[slot][eye] );
+            glx.glBindFramebuffer( GL_READ_FRAMEBUFFER, channel.frameBuffer[slot][eye] );
+            glx.glFramebufferRenderbuffer(
+                GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER,
+                channel.renderBuffer[slot][eye]
+            );
+        }
+    }
+    glx.glBindFramebuffer( GL_READ_FRAMEBUFFER, 0 );
+
+    if (Log::info())
+        Log::print( "process " ) << channel.processId << ": targets "
+            << surfaces.width << 'x' << surfaces.height
+            << " generation " << generation << endl;
+}
+
+//-----------------------------------------------------------------------------
+
+/// Keep the window over the application's client area
+void follow( Channel & channel, DWORD now )
+{
+    if ( channel.fixed || (now - channel.followTime < FOLLOW_TIME) ) return;
+    channel.followTime = now;
+
+    // (neither call waits on the application's message loop)
+    RECT rect = {};
+    const HWND window = channel.surfaces.window;
+    if ( (window == 0) || !GetClientRect( window, &rect ) ) return;
+    POINT origin = { 0, 0 };
+    ClientToScreen( window, &origin );
+    OffsetRect( &rect, origin.x, origin.y );
+    if ( IsRectEmpty( &rect ) || EqualRect( &rect, &channel.rect ) ) return;
+
+    channel.rect = rect;
+    SetWindowPos(
+        channel.window.getHWND(), HWND_TOPMOST,
+        rect.left, rect.top, rect.right - rect.left, rect.bottom - rect.top,
+        SWP_NOACTIVATE
+    );
+}
+
+//-----------------------------------------------------------------------------
+
+/// Open the frames of the application, follow it, and take its latest
+/// frame (its context must be current); returns true while it is running
+bool update( Channel & channel, DWORD now )
+{
+    // the last frame stays open (and shown, with -hold) after the exit
+    if ( !channel.exited && (channel.process != 0) &&
+         (WaitForSingleObject( channel.process, 0 ) == WAIT_OBJECT_0)
+    ) {
+        Log::print( "process " ) << channel.processId << " exited\n";
+        channel.exited = true;
+        channel.frames.close();
+        if ( !g_options.hold ) channel.window.show( SW_HIDE );
+    }
+    if ( channel.exited ) return false;
+
+    // the module creates the frames with its first device
+    if ( !channel.frames.isOpen() ) {
+        if ( now - channel.retryTime < RETRY_TIME ) return true;
+        channel.retryTime = now;
+        if ( !channel.frames.open( channel.processId ) ) return true;
+        Log::print( "presenting process " ) << channel.processId << endl;
+    }
+
+    // a new pool replaces the one we have open
+    const unsigned generation = channel.frames.generation();
+    if ( (generation != 0) && (generation != channel.generation) )
+        openSurfaces( channel );
+    if ( channel.surface[0][0] == 0 ) return true;
+
+    follow( channel, now );
+
+    // our slot goes back only once the GPU has finished painting it
+    if ( channel.fence != 0 ) {
+        if ( channel.glx.glClientWaitSync( channel.fence, 0, 0 ) == GL_TIMEOUT_EXPIRED )
+            return true;
+        channel.glx.glDeleteSync( channel.fence );
+        channel.fence = 0;
+    }
+
+    SharedFrames::Frame frame;
+    if ( !channel.frames.acquire( channel.generation, channel.slot, frame ) )
+        return true;
+
+    if ( (channel.received > 0) && (frame.frameId > channel.frame.frameId + 1) )
+        channel.skipped += frame.frameId - channel.frame.frameId - 1;
+    ++channel.received;
+    channel.frame = frame;
+    channel.hasFrame = true;
+
+    if ( !channel.shown ) {
+        channel.shown = true;
+        channel.window.show( SW_SHOWNOACTIVATE );
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+/// Returns true if the channel's window is being painted
+bool isPainted( const Channel & channel )
+{
+    return channel.shown && ( !channel.exited || g_options.hold );
+}
+
+//-----------------------------------------------------------------------------
+
+/// Paint the frame the channel holds (again, if no newer one has arrived
+/// since the last refresh), and swap (its context must be current); only
+/// the pacing window waits for the vertical blank, so that several windows
+/// are not each given a refresh of their own
+void paint( Channel & channel, bool pacing )
+{
+    if ( !isPainted( channel ) ) return;
+
+    const int interval = pacing ? 1 : 0;
+    if ( (g_swapInterval != 0) && (channel.interval != interval) ) {
+        g_swapInterval( interval );
+        channel.interval = interval;
+    }
+
+    Extensions & glx = channel.glx;
+    RECT client = {};
+    GetClientRect( channel.window.getHWND(), &client );
+    const GLint width = client.right;
+    const GLint height = client.bottom;
+
+    glx.glBindFramebuffer( GL_DRAW_FRAMEBUFFER, 0 );
+    if ( channel.hasFrame ) {
+        const unsigned slot = channel.slot;
+        const unsigned eyes = std::min( std::max( channel.frame.eyes, 1u ), EYES );
+        HANDLE *objects = channel.object[slot];
+        glx.wglDXLockObjectsNV( channel.interop, eyes, objects );
+
+        // a mono frame goes to both eyes, and the rows are flipped (DX
+        // stores the top row first)
+        const SharedFrames::Surfaces & surfaces = channel.surfaces;
+        for (unsigned eye = 0; eye < (channel.stereo ? EYES : 1); ++eye) {
+            glDrawBuffer( !channel.stereo ? GL_BACK : (eye == 0) ? GL_BACK_LEFT : GL_BACK_RIGHT );
+            glx.glBindFramebuffer( GL_READ_FRAMEBUFFER, channel.frameBuffer[slot][std::min( eye, eyes - 1 )] );
+            glx.glBlitFramebuffer(
+                0, 0, surfaces.width, surfaces.height,
+                0, height, width, 0,
+                GL_COLOR_BUFFER_BIT, GL_LINEAR
+            );
+        }
+        glx.glBindFramebuffer( GL_READ_FRAMEBUFFER, 0 );
+
+        glx.wglDXUnlockObjectsNV( channel.interop, eyes, objects );
+
+        // without fences, the slot is not handed back until the GPU is done
+        if ( channel.fence != 0 ) glx.glDeleteSync( channel.fence );
+        if ( channel.sync )
+            channel.fence = glx.glFenceSync( GL_SYNC_GPU_COMMANDS_COMPLETE, 0 );
+        else
+            glFinish();
+    } else {
+        glDrawBuffer( GL_BACK );
+        glClearColor( 0.f, 0.f, 0.f, 1.f );
+        glClear( GL_COLOR_BUFFER_BIT );
+    }
+
+    channel.window.swapBuffers();
+
+    if ( (++channel.painted % 600) == 0 ) {
+        Log::print( "process " ) << channel.processId << ": frame "
+            << channel.frame.frameId << ", " << channel.painted << " painted, "
+            << channel.received << " received, " << channel.skipped << " skipped\n";
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+/// Release everything a channel holds
+void destroyChannel( Channel & channel )
+{
+    if ( channel.window.getHGLRC() != 0 ) {
+        makeCurrent( channel );
+        releaseSurfaces( channel );
+        if ( channel.interop != 0 ) channel.glx.wglDXCloseDeviceNV( channel.interop );
+        channel.interop = 0;
+    }
+    if ( channel.device != 0 ) {
+        channel.device->Release();
+        channel.device = 0;
+    }
+    channel.window.destroy();
+    channel.frames.close();
+    if ( channel.process != 0 ) {
+        CloseHandle( channel.process );
+        channel.process = 0;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+/// Parse the command line, returns false for unknown options
+bool parse( int argc, char **argv, Options & options )
+{
+    for (int i=1; i<argc; ++i) {
+        std::string arg( argv[i] );
+        bool hasValue = (i + 1 < argc);
+        bool hasRect = (i + 4 < argc);
+        if ( hasValue && (arg == "-pid") ) {
+            // one or more process IDs
+            while ( (i + 1 < argc) && (argv[i + 1][0] != '-') )
+                options.processes.push_back( strtoul( argv[++i], 0, 10 ) );
+        } else if ( hasValue && (arg == "-swapGroup") )
+            options.swapGroup = strtoul( argv[++i], 0, 10 );
+        else if ( hasValue && (arg == "-swapBarrier") )
+            options.swapBarrier = strtoul( argv[++i], 0, 10 );
+        else if ( arg == "-hold" )
+            options.hold = true;
+        else if ( hasRect && (arg == "-window") ) {
+            int rect[4] = {};
+            for (unsigned j=0; j<4; ++j)
+                rect[j] = atoi( argv[++i] );
+            RECT window = {};
+            SetRect( &window, rect[0], rect[1], rect[0] + rect[2], rect[1] + rect[3] );
+            options.rects.push_back( window );
+        } else
+            return false;
+    }
+    return !options.processes.empty();
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+
+int main( int argc, char **argv )
+{
+    if ( !parse( argc, argv, g_options ) ) {
+        cerr << "usage: presenter -pid <pid> [<pid>...] [-window x y w h]...\n"
+             << "                 [-swapGroup n] [-swapBarrier n] [-hold]\n"
+             << "(each -window is the window of the next process, in order;\n"
+             << "otherwise each window covers its application's window)\n";
+        return 1;
+    }
+    Log::open( "presenter.log" );
+
+    if ( Direct3DCreate9Ex( D3D_SDK_VERSION, &g_direct3D ) != S_OK ) {
+        cerr << "error: Direct3D9Ex is not available\n";
+        return 1;
+    }
+
+    // one window per application process
+    std::vector<Channel*> channels;
+    for (size_t i=0; i<g_options.processes.size(); ++i) {
+        Channel *channel = new Channel;
+        channel->processId = g_options.processes[i];
+        if ( i < g_options.rects.size() ) {
+            channel->rect = g_options.rects[i];
+            channel->fixed = true;
+        }
+        channels.push_back( channel );
+        if ( !createChannel( *channel, i == 0 ) ) {
+            cerr << "error: failed to create the window of process "
+                 << channel->processId << endl;
+            for (size_t j=0; j<channels.size(); ++j) {
+                destroyChannel( *channels[j] );
+                delete channels[j];
+            }
+            g_direct3D->Release();
+            return 1;
+        }
+    }
+
+    // refresh every window at the display rate, whether or not its
+    // application has a new frame (the last one is painted again)
+    MSG message = {};
+    while ( message.message != WM_QUIT ) {
+        if ( PeekMessage( &message, 0, 0, 0, PM_REMOVE ) ) {
+            TranslateMessage( &message );
+            DispatchMessage( &message );
+            continue;
+        }
+
+        const DWORD now = GetTickCount();
+        bool running = false;
+        size_t pacing = channels.size();
+        std::vector<HANDLE> ready;
+        for (size_t i=0; i<channels.size(); ++i) {
+            Channel & channel = *channels[i];
+            makeCurrent( channel );
+            if ( update( channel, now ) ) running = true;
+            if ( isPainted( channel ) && (pacing == channels.size()) ) pacing = i;
+            if ( channel.frames.isOpen() ) ready.push_back( channel.frames.readyEvent() );
+        }
+        if ( !running && !g_options.hold ) break;
+
+        // the swap of the first painted window paces the loop; until one
+        // is shown, wait for a frame (or a message) instead
+        if ( pacing == channels.size() ) {
+            MsgWaitForMultipleObjects(
+                static_cast<DWORD>( ready.size() ), ready.empty() ? 0 : &ready[0],
+                FALSE, IDLE_TIME, QS_ALLINPUT
+            );
+            continue;
+        }
+        for (size_t i=0; i<channels.size(); ++i) {
+            makeCurrent( *channels[i] );
+            paint( *channels[i], i == pacing );
+        }
+    }
+
+    for (size_t i=0; i<channels.size(); ++i) {
+        destroyChannel( *channels[i] );
+        delete channels[i];
+    }
+    g_direct3D->Release();
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,435 @@
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <windows.h>
+#include <process.h>
+#include <GL/gl.h>
+#include <GL/glext.h>
+#include <GL/wglext.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "Extensions.h"
+#include "FrameMailbox.h"
+#include "FrameReadback.h"
+#include "FrameStreamer.h"
+#include "GLWindow.h"
+#include "Log.h"
+#include "ReadbackRing.h"
+
+using namespace hive;
+using namespace std;
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+namespace {
+
+/// The display node's command line options
+struct Options {
+    std::string host;   ///< render host name or address
+    unsigned port;      ///< render host streamPort
+    float viewport[4];  ///< part of each eye shown (x,y,w,h from bottom left, 0..1)
+    int rect[4];        ///< window position and size on the desktop
+    unsigned swapGroup; ///< NV swap group to join (0 = none)
+    unsigned swapBarrier; ///< NV swap barrier to bind the group to (0 = none)
+
+    Options() :
+        host( "localhost" ),
+        port( 3020 ),
+        swapGroup( 0 ),
+        swapBarrier( 0 )
+    {
+        viewport[0] = viewport[1] = 0.f;
+        viewport[2] = viewport[3] = 1.f;
+        rect[0] = rect[1] = 0;
+        rect[2] = 1280;
+        rect[3] = 720;
+    }
+};
+
+/// A frame received from the host
+struct Frame {
+    FrameReadback::Header header;       ///< its header
+    std::vector<unsigned char> pixels;  ///< each eye, bottom row first
+};
+
+/// Time between attempts to connect to the host (milliseconds)
+const DWORD RETRY_TIME = 1000;
+
+/// Largest eye width or height accepted from the host (pixels)
+const unsigned MAX_SIZE = 8192;
+
+Options          g_options;         ///< command line options
+Frame            g_frames[FrameMailbox::SLOTS]; ///< frames passed to the GL thread
+FrameMailbox     g_mailbox;         ///< latest frame received
+HANDLE           g_frameReady = 0;  ///< auto-reset event: a frame was published
+std::atomic<bool> g_quit;           ///< tells the network thread to exit
+std::atomic<SOCKET> g_socket;       ///< the current connection (or INVALID_SOCKET)
+
+unsigned         g_width = 0;       ///< window width in pixels
+unsigned         g_height = 0;      ///< window height in pixels
+
+//-----------------------------------------------------------------------------
+
+/// Receive exactly size bytes, returns false if the connection has failed
+bool receive( SOCKET socket, void *data, size_t size )
+{
+    char *bytes = static_cast<char*>( data );
+    while ( size > 0 ) {
+        const int chunk = static_cast<int>( std::min<size_t>( size, 1 << 30 ) );
+        const int received = recv( socket, bytes, chunk, 0 );
+        if ( received <= 0 ) return false;
+        bytes += received;
+        size -= received;
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+/// Connect to the host and send our request, returns INVALID_SOCKET on failure
+SOCKET connectToHost()
+{
+    std::ostringstream port;
+    port << g_options.port;
+
+    addrinfo hints = {};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_protocol = IPPROTO_TCP;
+    addrinfo *address = 0;
+    if ( getaddrinfo( g_options.host.c_str(), port.str().c_str(), &hints, &address ) != 0 )
+        return INVALID_SOCKET;
+
+    SOCKET socket = ::socket( address->ai_family, address->ai_socktype, address->ai_protocol );
+    if ( (socket != INVALID_SOCKET) &&
+         (connect( socket, address->ai_addr, static_cast<int>(address->ai_addrlen) ) != 0)
+    ) {
+        closesocket( socket );
+        socket = INVALID_SOCKET;
+    }
+    freeaddrinfo( address );
+    if ( socket == INVALID_SOCKET ) return INVALID_SOCKET;
+
+    FrameStreamer::Request request = {};
+    memcpy( request.magic, "QREQ", 4 );
+    for (unsigned i=0; i<4; ++i) request.viewport[i] = g_options.viewport[i];
+    if ( send( socket, reinterpret_cast<const char*>(&request), sizeof(request), 0 )
+         != sizeof(request)
+    ) {
+        closesocket( socket );
+        return INVALID_SOCKET;
+    }
+    return socket;
+}
+
+//-----------------------------------------------------------------------------
+
+/// Network thread: receives frames into the mailbox, reconnecting whenever
+/// the connection to the host is lost
+unsigned __stdcall networkThread( void * )
+{
+    unsigned slot = g_mailbox.writeSlot();
+    while ( !g_quit.load() ) {
+        SOCKET socket = connectToHost();
+        if ( socket == INVALID_SOCKET ) {
+            Sleep( RETRY_TIME );
+            continue;
+        }
+        g_socket.store( socket );
+        Log::print( "connected to " ) << g_options.host << ':' << g_options.port << endl;
+
+        for (;;) {
+            Frame & frame = g_frames[slot];
+            FrameReadback::Header & header = frame.header;
+            if ( !receive( socket, &header, sizeof(header) ) ) break;
+            if ( memcmp( header.magic, "QREC", 4 ) != 0 ) {
+                Log::print( "error: invalid frame from host\n" );
+                break;
+            }
+
+            // the pixels are sized from the header: check it before trusting
+            // it with an allocation
+            if ( (header.eyes < 1) || (header.eyes > 2) ||
+                 (header.width == 0) || (header.width > MAX_SIZE) ||
+                 (header.height == 0) || (header.height > MAX_SIZE)
+            ) {
+                Log::print( "error: invalid frame size from host: " )
+                    << header.eyes << " x " << header.width << 'x'
+                    << header.height << endl;
+                break;
+            }
+
+            frame.pixels.resize(
+                static_cast<size_t>( header.eyes ) * header.width * header.height * 4
+            );
+            if ( !frame.pixels.empty() &&
+                 !receive( socket, &frame.pixels[0], frame.pixels.size() )
+            )
+                break;
+
+            // latest wins: if the GL thread is behind, it skips frames
+            slot = g_mailbox.publish( slot );
+            SetEvent( g_frameReady );
+        }
+
+        g_socket.store( INVALID_SOCKET );
+        closesocket( socket );
+        if ( !g_quit.load() ) Log::print( "connection to host lost\n" );
+    }
+
+    _endthreadex( 0 );
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+
+/// The window procedure of the GL window
+LRESULT CALLBACK windowProc( HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam )
+{
+    switch (uMsg) {
+    case WM_CLOSE:
+        PostQuitMessage( 0 );
+        return 0L;
+
+    case WM_SIZE:
+        g_width = LOWORD(lParam);
+        g_height = HIWORD(lParam);
+        return 0L;
+
+    case WM_KEYDOWN:
+        if ( wParam == VK_ESCAPE ) PostQuitMessage( 0 );
+        return 0L;
+    }
+
+    return DefWindowProc( hWnd, uMsg, wParam, lParam );
+}
+
+//-----------------------------------------------------------------------------
+
+/// Parse the command line, returns false for unknown options
+bool parse( int argc, char **argv, Options & options )
+{
+    for (int i=1; i<argc; ++i) {
+        std::string arg( argv[i] );
+        bool hasValue = (i + 1 < argc);
+        bool hasRect = (i + 4 < argc);
+        if ( hasValue && (arg == "-host") )
+            options.host = argv[++i];
+        else if ( hasValue && (arg == "-port") )
+            options.port = strtoul( argv[++i], 0, 10 );
+        else if ( hasValue && (arg == "-swapGroup") )
+            options.swapGroup = strtoul( argv[++i], 0, 10 );
+        else if ( hasValue && (arg == "-swapBarrier") )
+            options.swapBarrier = strtoul( argv[++i], 0, 10 );
+        else if ( hasRect && (arg == "-viewport") ) {
+            for (unsigned j=0; j<4; ++j)
+                options.viewport[j] = static_cast<float>( atof( argv[++i] ) );
+        } else if ( hasRect && (arg == "-window") ) {
+            for (unsigned j=0; j<4; ++j)
+                options.rect[j] = atoi( argv[++i] );
+        } else
+            return false;
+    }
+    return true;
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+
+int main( int argc, char **argv )
+{
+    if ( !parse( argc, argv, g_options ) ) {
+        cerr << "usage: receiver [-host name] [-port n] [-viewport x y w h]\n"
+             << "                [-window x y w h] [-swapGroup n] [-swapBarrier n]\n";
+        return 1;
+    }
+    Log::open( "receiver.log" );
+
+    WSADATA data = {};
+    if ( WSAStartup( MAKEWORD(2,2), &data ) != 0 ) {
+        cerr << "error: failed to start winsock\n";
+        return 1;
+    }
+
+    // a quad-buffered window if the driver allows, else a mono one (which
+    // shows the left eye)
+    GLWindow window;
+    GLWindow::Attributes attributes;
+    attributes[WGL_STEREO_ARB] = GL_TRUE;
+    attributes[WGL_DEPTH_BITS_ARB] = 0;
+    attributes[WGL_STENCIL_BITS_ARB] = 0;
+    const DWORD style = WS_POPUP | WS_CLIPCHILDREN | WS_CLIPSIBLINGS;
+    const int *rect = g_options.rect;
+    bool stereo = window.create(
+        0, L"Quadifier receiver", style, rect[0], rect[1], rect[2], rect[3],
+        0, 0, windowProc, 0, attributes
+    );
+    if ( !stereo ) {
+        attributes.erase( WGL_STEREO_ARB );
+        if ( !window.create(
+            0, L"Quadifier receiver", style, rect[0], rect[1], rect[2], rect[3],
+            0, 0, windowProc, 0, attributes
+        ) ) {
+            cerr << "error: failed to create OpenGL window\n";
+            return 1;
+        }
+        Log::print( "warning: stereo is not available, showing the left eye\n" );
+    }
+    g_width = rect[2];
+    g_height = rect[3];
+
+    // uploads go through the same ring as the readback mode of the module
+    Extensions glx;
+    if ( !glx.load() && !glx.hasFramebuffers() ) {
+        cerr << "error: failed to load GL extensions\n";
+        return 1;
+    }
+    ReadbackRing ring;
+    ring.create( glx );
+
+    // a texture and framebuffer for each eye, to blit from
+    GLuint texture[2] = {};
+    GLuint frameBuffer[2] = {};
+    unsigned textureWidth = 0;
+    unsigned textureHeight = 0;
+    glGenTextures( 2, texture );
+    glx.glGenFramebuffers( 2, frameBuffer );
+
+    // frame lock with the other nodes (optional)
+    if ( g_options.swapGroup != 0 ) {
+        if ( glx.hasSwapGroup() &&
+             glx.wglJoinSwapGroupNV( window.getHDC(), g_options.swapGroup ) &&
+             ( (g_options.swapBarrier == 0) ||
+               glx.wglBindSwapBarrierNV( g_options.swapGroup, g_options.swapBarrier ) )
+        )
+            Log::print( "joined swap group " ) << g_options.swapGroup << endl;
+        else
+            Log::print( "warning: failed to join swap group " ) << g_options.swapGroup << endl;
+    }
+
+    g_frameReady = CreateEvent( 0, FALSE, FALSE, 0 );
+    g_quit.store( false );
+    g_socket.store( INVALID_SOCKET );
+    HANDLE thread = reinterpret_cast<HANDLE>( _beginthreadex(
+        0, 0, networkThread, 0, 0, 0
+    ) );
+    window.show();
+
+    unsigned readSlot = g_mailbox.readSlot();
+    unsigned lastFrameId = 0;
+    unsigned frames = 0;
+    unsigned skipped = 0;
+    MSG message = {};
+    while ( message.message != WM_QUIT ) {
+        if ( PeekMessage( &message, 0, 0, 0, PM_REMOVE ) ) {
+            TranslateMessage( &message );
+            DispatchMessage( &message );
+            continue;
+        }
+        if ( !g_mailbox.acquire( readSlot ) ) {
+            MsgWaitForMultipleObjects( 1, &g_frameReady, FALSE, 100, QS_ALLINPUT );
+            continue;
+        }
+
+        const Frame & frame = g_frames[readSlot];
+        const FrameReadback::Header & header = frame.header;
+        const unsigned eyes = std::min( header.eyes, 2u );
+        if ( (eyes == 0) || frame.pixels.empty() ) continue;
+
+        // frames which the host sent but we never painted
+        if ( (frames > 0) && (header.frameId > lastFrameId + 1) )
+            skipped += header.frameId - lastFrameId - 1;
+        lastFrameId = header.frameId;
+
+        // (re)size the textures to the frame
+        if ( (header.width != textureWidth) || (header.height != textureHeight) ) {
+            for (unsigned eye=0; eye<2; ++eye) {
+                glBindTexture( GL_TEXTURE_2D, texture[eye] );
+                glTexImage2D(
+                    GL_TEXTURE_2D, 0, GL_RGBA8, header.width, header.height, 0,
+                    GL_BGRA, GL_UNSIGNED_BYTE, 0
+                );
+                glx.glBindFramebuffer( GL_READ_FRAMEBUFFER, frameBuffer[eye] );
+                glx.glFramebufferTexture2D(
+                    GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture[eye], 0
+                );
+            }
+            glBindTexture( GL_TEXTURE_2D, 0 );
+            textureWidth = header.width;
+            textureHeight = header.height;
+        }
+
+        // upload and present each eye: the rows are already bottom first,
+        // so unlike the module's present path there is no flip
+        const size_t eyeSize = static_cast<size_t>( header.width ) * header.height * 4;
+        glx.glBindFramebuffer( GL_DRAW_FRAMEBUFFER, 0 );
+        for (unsigned eye=0; eye<eyes; ++eye) {
+            if ( !stereo && (eye > 0) ) break;
+            ring.upload(
+                texture[eye], header.width, header.height,
+                &frame.pixels[eye * eyeSize], header.width * 4
+            );
+            glDrawBuffer( !stereo ? GL_BACK : (eye == 0) ? GL_BACK_LEFT : GL_BACK_RIGHT );
+            glx.glBindFramebuffer( GL_READ_FRAMEBUFFER, frameBuffer[eye] );
+            glx.glBlitFramebuffer(
+                0, 0, header.width, header.height,
+                0, 0, g_width, g_height,
+                GL_COLOR_BUFFER_BIT, GL_LINEAR
+            );
+        }
+        glx.glBindFramebuffer( GL_READ_FRAMEBUFFER, 0 );
+        window.swapBuffers();
+
+        if ( (++frames % 600) == 0 ) {
+            Log::print( "frame " ) << header.frameId << ": " << frames
+                << " painted, " << skipped << " skipped\n";
+        }
+    }
+
+    // stop the network thread (closing the socket ends a blocking receive)
+    g_quit.store( true );
+    SOCKET socket = g_socket.load();
+    if ( socket != INVALID_SOCKET ) shutdown( socket, SD_BOTH );
+    WaitForSingleObject( thread, RETRY_TIME * 2 );
+    CloseHandle( thread );
+    CloseHandle( g_frameReady );
+
+    ring.destroy();
+    glx.glDeleteFramebuffers( 2, frameBuffer );
+    glDeleteTextures( 2, texture );
+    window.destroy();
+    WSACleanup();
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
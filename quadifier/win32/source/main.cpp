@@ -1,89 +1,265 @@
-#include <iostream>
-#include "DLLInject.h"
-#include "GLWindow.h"
-#include <GL/gl.h>
-#include <GL/wglext.h>
-
-using namespace std;
-
-//-----------------------------------------------------------------------------
-//
-// Copyright (C) 2012-14 James Ward, University of Hull
-//
-// This software is provided 'as-is', without any express or implied
-// warranty. In no event will the authors be held liable for any damages
-// arising from the use of this software.
-//
-// Permission is granted to anyone to use this software for any purpose,
-// including commercial applications, and to alter it and redistribute it
-// freely, subject to the following restrictions:
-//
-//    1. The origin of this software must not be misrepresented; you must not
-//    claim that you wrote the original software.
-//
-//    2. If you use this software in a product, an acknowledgment in the
-//    product documentation is required.
-//
-//    3. Altered source versions must be plainly marked as such, and must not
-//    be misrepresented as being the original software.
-//
-//    4. This notice may not be removed or altered from any source
-//    distribution.
-//
-//-----------------------------------------------------------------------------
-
-// workaround for issue seen on Windows 7 with NVIDIA 
-void triggerStereo()
-{
-    // attributes for an OpenGL stereo window
-    GLWindow::Attributes attributes;
-    attributes[WGL_STEREO_ARB] = GL_TRUE;
-
-    // create and destroy a small stereo window: this is here to work around
-    // an issue with windows failing to switch to quad-buffer mode (although
-    // the window is successfully created and reports a stereo pixel format)
-    // note: the window is invisible (not shown) but typically causes the
-    // windows desktop to flash briefly (first run only) as stereo activates
-    GLWindow window;
-    window.create( 0, "", 0, 0, 0, 8, 8, 0, 0, DefWindowProc, 0, attributes );
-    window.destroy();
-}
-
-//-----------------------------------------------------------------------------
-
-int main ( int argc, char **argv )
-{
-    // trigger stereo mode in Windows by creating a temporary stereo window
-    triggerStereo();
-
-    // the name of our DLL to be injected
-    static const string moduleName( "module.dll" );
-
-    // have we got an application filename?
-    if ( argc > 1 ) {
-        // name of the application executable
-        string applicationName( argv[1] );
-
-        // build command line string
-        string commandLine;
-        for (int i=2; i<argc; ++i) {
-            if (i > 2) commandLine += " ";
-            commandLine += string(argv[i]);
-        }
-
-        // attempt to launch the application and inject the DLL
-        if ( !hive::createProcessWithDLL(
-            applicationName,    // name of executable
-            moduleName,         // name of DLL
-            commandLine         // command line options
-        ) )
-            cerr << "error: failed to start " << applicationName << endl;
-    } else {
-        // display usage instructions
-        cerr << "usage: launcher <executable> [options]\n";
-    }
-
-    return 0;
-}
-
-//-----------------------------------------------------------------------------
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+#include <sstream>
+#include <process.h>
+#include "DLLInject.h"
+#include "GLWindow.h"
+#include <GL/gl.h>
+#include <GL/wglext.h>
+
+using namespace std;
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2012-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+// workaround for issue seen on Windows 7 with NVIDIA 
+void triggerStereo()
+{
+    // attributes for an OpenGL stereo window
+    GLWindow::Attributes attributes;
+    attributes[WGL_STEREO_ARB] = GL_TRUE;
+
+    // create and destroy a small stereo window: this is here to work around
+    // an issue with windows failing to switch to quad-buffer mode (although
+    // the window is successfully created and reports a stereo pixel format)
+    // note: the window is invisible (not shown) but typically causes the
+    // windows desktop to flash briefly (first run only) as stereo activates
+    GLWindow window;
+    window.create( 0, "", 0, 0, 0, 8, 8, 0, 0, DefWindowProc, 0, attributes );
+    window.destroy();
+}
+
+//-----------------------------------------------------------------------------
+
+// runs triggerStereo on its own thread, so that it overlaps process creation
+unsigned __stdcall triggerStereoThread( void * )
+{
+    triggerStereo();
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+
+/// parse a target: a process ID (all digits), or an executable (quoted if it
+/// contains spaces) followed by its options
+hive::InjectTarget parseTarget( const string & text )
+{
+    hive::InjectTarget target;
+
+    if ( !text.empty() && ( text.find_first_not_of( "0123456789" ) == string::npos ) ) {
+        target.processId = strtoul( text.c_str(), 0, 10 );
+        return target;
+    }
+
+    size_t end = 0;
+    if ( !text.empty() && ( text[0] == '"' ) ) {
+        end = text.find( '"', 1 );
+        if ( end == string::npos ) end = text.size();
+        target.applicationName = text.substr( 1, end - 1 );
+        if ( end < text.size() ) ++end;
+    } else {
+        end = text.find_first_of( " \t" );
+        if ( end == string::npos ) end = text.size();
+        target.applicationName = text.substr( 0, end );
+    }
+
+    size_t options = text.find_first_not_of( " \t", end );
+    if ( options != string::npos ) target.commandLine = text.substr( options );
+
+    return target;
+}
+
+//-----------------------------------------------------------------------------
+
+/// inject into all the targets at once, and report the failures
+int injectBatch( vector<hive::InjectTarget> & targets, const string & moduleName,
+    DWORD timeout )
+{
+    hive::injectDLLs( targets, moduleName, timeout );
+
+    int failures = 0;
+    for (size_t i=0; i<targets.size(); ++i) {
+        if ( targets[i].result ) continue;
+        ++failures;
+        if ( targets[i].processId != 0 )
+            cerr << "error: failed to inject " << moduleName << " into process "
+                 << targets[i].processId << endl;
+        else
+            cerr << "error: failed to start " << targets[i].applicationName
+                 << " with " << moduleName << endl;
+    }
+
+    cout << ( targets.size() - failures ) << " of " << targets.size()
+         << " targets ready\n";
+    return failures;
+}
+
+//-----------------------------------------------------------------------------
+
+/// start the presenter (from the launcher's own directory) for the processes
+/// the module is ready in; it runs on after the launcher exits
+void startPresenter( const vector<DWORD> & processes )
+{
+    if ( processes.empty() ) {
+        cerr << "error: no targets to start the presenter for\n";
+        return;
+    }
+
+    char path[MAX_PATH] = {};
+    const DWORD length = GetModuleFileNameA( 0, path, MAX_PATH );
+    string pathName( path, length );
+    pathName = pathName.substr( 0, pathName.find_last_of( "\\/" ) + 1 ) + "presenter.exe";
+
+    ostringstream line;
+    line << '"' << pathName << "\" -pid";
+    for (size_t i=0; i<processes.size(); ++i)
+        line << ' ' << processes[i];
+    const string text( line.str() );
+    vector<char> commandLine( text.begin(), text.end() );
+    commandLine.push_back( 0 );
+
+    STARTUPINFOA startupInfo = { sizeof(startupInfo) };
+    PROCESS_INFORMATION processInfo = {};
+    if ( !CreateProcessA(
+        pathName.c_str(), &commandLine[0], 0, 0, FALSE, 0, 0, 0,
+        &startupInfo, &processInfo
+    ) ) {
+        cerr << "error: failed to start " << pathName << endl;
+        return;
+    }
+    CloseHandle( processInfo.hProcess );
+    CloseHandle( processInfo.hThread );
+    cout << "presenter started for " << processes.size() << " targets\n";
+}
+
+//-----------------------------------------------------------------------------
+
+int main ( int argc, char **argv )
+{
+    // trigger stereo mode in Windows by creating a temporary stereo window,
+    // in parallel with launching the application
+    HANDLE stereoThread = reinterpret_cast<HANDLE>(
+        _beginthreadex( 0, 0, triggerStereoThread, 0, 0, 0 )
+    );
+    if ( stereoThread == 0 ) triggerStereo();
+
+    // the name of our DLL to be injected
+    static const string moduleName( "module.dll" );
+
+    // per-target timeout for injection and readiness (milliseconds), and
+    // whether the frames are shown by the presenter process
+    DWORD timeout = 5000;
+    bool presenter = false;
+    int first = 1;
+    for (;;) {
+        if ( (argc > first + 1) && (string( argv[first] ) == "-timeout") ) {
+            timeout = strtoul( argv[first + 1], 0, 10 );
+            first += 2;
+        } else if ( (argc > first) && (string( argv[first] ) == "-presenter") ) {
+            presenter = true;
+            ++first;
+        } else
+            break;
+    }
+    vector<DWORD> ready;
+
+    // batch modes: several targets launched or injected concurrently
+    vector<hive::InjectTarget> targets;
+    if ( (argc > first + 1) && (string( argv[first] ) == "-list") ) {
+        // one target per line of the file
+        ifstream input( argv[first + 1] );
+        if ( !input ) cerr << "error: unable to read " << argv[first + 1] << endl;
+        string line;
+        while ( getline( input, line ) ) {
+            if ( line.find_first_not_of( " \t\r" ) == string::npos ) continue;
+            if ( !line.empty() && ( line[line.size() - 1] == '\r' ) )
+                line.erase( line.size() - 1 );
+            targets.push_back( parseTarget( line ) );
+        }
+    } else if ( (argc > first + 1) && (string( argv[first] ) == "-pid") ) {
+        // already running processes
+        for (int i=first+1; i<argc; ++i)
+            targets.push_back( parseTarget( argv[i] ) );
+    }
+
+    if ( !targets.empty() ) {
+        injectBatch( targets, moduleName, timeout );
+        for (size_t i=0; i<targets.size(); ++i) {
+            if ( !targets[i].result ) continue;
+            ready.push_back( targets[i].processId != 0 ?
+                targets[i].processId : targets[i].launchedId );
+        }
+    } else if ( argc > first ) {
+        // have we got an application filename?
+        // name of the application executable
+        string applicationName( argv[first] );
+
+        // build command line string
+        string commandLine;
+        for (int i=first+1; i<argc; ++i) {
+            if (i > first+1) commandLine += " ";
+            commandLine += string(argv[i]);
+        }
+
+        // attempt to launch the application and inject the DLL
+        DWORD processId = 0;
+        if ( !hive::createProcessWithDLL(
+            applicationName,    // name of executable
+            moduleName,         // name of DLL
+            commandLine,        // command line options
+            "",                 // current directory
+            timeout,            // injection and readiness timeout
+            &processId          // OUT: ID of the new process
+        ) )
+            cerr << "error: failed to start " << applicationName
+                 << " with " << moduleName << endl;
+        else
+            ready.push_back( processId );
+    } else {
+        // display usage instructions
+        cerr << "usage: launcher [-timeout ms] [-presenter] <executable> [options]\n"
+             << "       launcher [-timeout ms] [-presenter] -list <file>\n"
+             << "       launcher [-timeout ms] [-presenter] -pid <pid> [<pid>...]\n"
+             << "(a list file has one target per line: a process ID, or an\n"
+             << "executable and its options; -presenter starts presenter.exe\n"
+             << "for the targets, which needs \"presenter true\")\n";
+        presenter = false;
+    }
+
+    // one presenter shows the frames of all the targets
+    if ( presenter ) startPresenter( ready );
+
+    // the stereo window must have come and gone before we exit
+    if ( stereoThread != 0 ) {
+        WaitForSingleObject( stereoThread, INFINITE );
+        CloseHandle( stereoThread );
+    }
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
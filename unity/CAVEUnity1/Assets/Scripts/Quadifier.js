@@ -3,6 +3,7 @@
 import System.Xml;
 import System.Collections.Generic;
 import System.Threading;
+import System.Runtime.InteropServices;
 
 //-----------------------------------------------------------------------------
 
@@ -18,14 +19,46 @@ private var settingsFile = "settings.xml";
 // maximum number of tracked items
 private var maxTrackedItems = 8;
 
-// stores latest tracking data received
+// receives tracking data from the network thread (without locking)
+private var trackerBuffer :TrackerBuffer;
+
+// value of trackerBuffer.published when the data was last read
+private var trackerPublished = 0;
+
+// stores latest tracking data received (copied once per frame)
 private var trackerData :TrackerData[];
 
 // stores references to tracked objects in scene
 private var trackedItem :GameObject[];
 
-// lock to control access to the tracker data array
-private var trackerLock = new Object();
+//-----------------------------------------------------------------------------
+
+// computes the projection of every camera in one call (QuadifierPlugin.dll,
+// built with the quadifier module; copy it to Assets/Plugins): the arrays
+// are allocated once, so the per-frame update makes no allocations
+@DllImport("QuadifierPlugin")
+private static function QuadifierComputeProjections(
+	screens		:float[],	// 12 floats per screen (see setupNativeCameras)
+	screenCount	:int,
+	eyes		:float[],	// 3 floats per eye
+	eyeCount	:int,
+	nearPlane	:float,
+	farPlane	:float,
+	projections :Matrix4x4[]	// one per screen per eye
+) :int {}
+
+// returns the plugin event which signals a view (1 = the right eye) to the
+// Quadifier module, in place of the fake camera (see setupCameras)
+@DllImport("QuadifierPlugin")
+private static function QuadifierViewEvent( view :int ) :int {}
+
+// use the native plugin? (false if it is not available)
+private var nativeCameras = false;
+
+// arrays shared with the native plugin
+private var nativeScreens :float[];
+private var nativeEyes :float[];
+private var nativeProjections :Matrix4x4[];
 
 //-----------------------------------------------------------------------------
 
@@ -87,6 +120,17 @@ class Settings
 	// tracker network port number
 	public var networkPort :ushort;
 	
+	// tracker transport: "tcp" (connect to the bridge) or "udp" (datagrams)
+	public var networkProtocol :String;
+	
+	// multicast group to join for "udp" (empty for unicast)
+	public var multicastGroup :String;
+	
+	// render each eye of each screen as a view of its own, across the
+	// whole surface (needs QuadifierPlugin, and "views" in quadifier.ini
+	// set to twice the number of screens)
+	public var multiView :boolean;
+	
 	// tracker transformation matrix
 	public var trackerMatrix :Matrix4x4;
 	
@@ -94,6 +138,9 @@ class Settings
 	function Settings() {
 		eyeSeparation = 0.07;	// default eye separation
 		networkPort   = 3010;	// default network port
+		networkProtocol = "tcp";	// default transport
+		multicastGroup  = "";	// default: unicast
+		multiView = false;		// default: screens share the surface
 	}
 };
 
@@ -104,6 +151,7 @@ class CameraRig {
 	public var left	 :Camera;
 	public var right :Camera;
 	public var screen :ProjectionScreen;
+	public var rotation :Quaternion;
 	
 	// creates a camera rig for a particular screen
 	function CameraRig(theScreen :ProjectionScreen) {
@@ -115,6 +163,16 @@ class CameraRig {
 		
 		// create right camera
 		right = screen.createCamera("right");
+		
+		// the cameras always face the screen
+		rotation = Quaternion.LookRotation( -screen.normal, screen.up );
+	}
+	
+	// position a camera at the eye, with a projection computed elsewhere
+	function apply( camera :Camera, eye :Vector3, projection :Matrix4x4 ) {
+		camera.transform.position = eye;
+		camera.transform.rotation = rotation;
+		camera.projectionMatrix = projection;
 	}
 
 	// update an individual camera	
@@ -248,12 +306,36 @@ function createFakeCamera( label :String ) {
 
 //-----------------------------------------------------------------------------
 
+// returns true if the native plugin can signal the views (a plugin event
+// costs nothing, where the fake camera is a whole extra camera pass)
+function setupPluginSignal() {
+	try {
+		QuadifierViewEvent( 1 );
+		return true;
+	} catch ( e :System.Exception ) {
+		// DllNotFoundException or EntryPointNotFoundException
+		return false;
+	}
+}
+
+//-----------------------------------------------------------------------------
+
+// signal the start of a view from a camera, through the native plugin
+function addViewSignal( camera :Camera, view :int ) {
+	var signal = camera.gameObject.AddComponent( QuadifierEyeSignal ) as QuadifierEyeSignal;
+	signal.eventID = QuadifierViewEvent( view );
+}
+
+//-----------------------------------------------------------------------------
+
 // initialise the camera rig for each screen
 function setupCameras() {
 	// render our cameras after the main camera, and render the left channel
 	// cameras before the right channel cameras
-    // the fake camera in between is used to signal the DLL when right eye
-    // rendering has started
+    // the right eye cameras signal the DLL through the native plugin when
+    // right eye rendering has started, or failing that the fake camera in
+    // between does
+    var pluginSignal = setupPluginSignal();
     var cameraDepthLeft  = Camera.main.depth + 1;
     var cameraDepthFake  = cameraDepthLeft + 1;
 	var cameraDepthRight = cameraDepthFake + 1;
@@ -267,17 +349,43 @@ function setupCameras() {
 	Camera.main.enabled = false;
 
     // create fake camera
-	var fakeCamera = createFakeCamera("fake");
-	fakeCamera.depth = cameraDepthFake;
+    if ( !pluginSignal ) {
+        var fakeCamera = createFakeCamera("fake");
+        fakeCamera.depth = cameraDepthFake;
+    }
+	Debug.Log( pluginSignal ?
+		"Quadifier: right eye signalled by QuadifierPlugin" :
+		"Quadifier: QuadifierPlugin not found, right eye signalled by the fake camera" );
+	
+	// in multi-view mode every camera is a view of its own, in the order
+	// left then right eye of each screen, each covering the whole surface
+	// (which Quadifier captures into a target per view)
+	var multiView = pluginSignal && settings.multiView;
+	if ( settings.multiView && !multiView )
+		Debug.Log( "Quadifier: multiView needs QuadifierPlugin, screens share the surface" );
+	var view = 0;
 	
 	// for each screen, create the corresponding camera
 	for ( var screen in settings.screens ) {
 		// create camera pair
 	    var rig = new CameraRig( screen );
-		rig.left.depth  = cameraDepthLeft;
-		rig.left.clearFlags = cameraClearFlagsLeft;
-		rig.right.depth = cameraDepthRight;
-		rig.right.clearFlags = cameraClearFlagsRight;
+		if ( multiView ) {
+			rig.left.rect = Rect( 0, 0, 1, 1 );
+			rig.left.depth = cameraDepthLeft + view;
+			rig.left.clearFlags = cameraClearFlagsLeft;
+			if ( view > 0 ) addViewSignal( rig.left, view );
+			rig.right.rect = Rect( 0, 0, 1, 1 );
+			rig.right.depth = cameraDepthLeft + view + 1;
+			rig.right.clearFlags = cameraClearFlagsLeft;
+			addViewSignal( rig.right, view + 1 );
+			view += 2;
+		} else {
+			rig.left.depth  = cameraDepthLeft;
+			rig.left.clearFlags = cameraClearFlagsLeft;
+			rig.right.depth = cameraDepthRight;
+			rig.right.clearFlags = cameraClearFlagsRight;
+			if ( pluginSignal ) addViewSignal( rig.right, 1 );
+		}
 		cameras.Add( rig );
 		
 		// set up temporary initial eye positions, assuming that the X axis
@@ -292,23 +400,17 @@ function setupCameras() {
 
 //-----------------------------------------------------------------------------
 
-// this function is called when tracking data is received (from another thread)
-function trackerDataCallback( data :TrackerData ) {
-	// debugging: display data as received
-	Debug.Log(
-		  "t=" + data.timeStamp +
-		", s=" + data.sensor 	+
-		", p=" + data.position 	+
-		", r=" + data.rotation
-	);
+// copy the latest tracking data received (once per frame)
+function readTracker() {
+	// nothing to do unless the network thread has published since last time
+	var published = trackerBuffer.published;
+	if ( published == trackerPublished ) return;
+	trackerPublished = published;
 	
-	// store tracker data
-	if ( (data.sensor >= 0) && (data.sensor < trackerData.Length) ) {
-		// lock before writing to array
-		Monitor.Enter( trackerLock );
-			trackerData[data.sensor] = data;
-		Monitor.Exit( trackerLock );
-	}
+	// a sensor whose slot was overtaken while copying keeps its previous
+	// data, and is picked up again next frame
+	for (var i=0; i<trackerData.Length; i++)
+		trackerBuffer.read( i, trackerData[i] );
 }
 
 //-----------------------------------------------------------------------------
@@ -330,9 +432,15 @@ function Start () {
 	frustum = GetComponent( Frustum );
 	trackerClient = GetComponent( TrackerClient );	
 
-	// allocate tracker data and tracked item builtin arrays
+	// allocate tracker data and tracked item builtin arrays, and find the
+	// objects named "tracker0", "tracker1" etc. (once, rather than per frame)
+	trackerBuffer = new TrackerBuffer( maxTrackedItems );
 	trackerData = new TrackerData[maxTrackedItems];
 	trackedItem = new GameObject[trackerData.Length];
+	for (var i=0; i<trackerData.Length; i++) {
+		trackerData[i] = new TrackerData();
+		trackedItem[i] = GameObject.Find( "tracker" + i );
+	}
 	
 	// save settings to file (useful to create an XML file with the proper
 	// format, for later manual editing)
@@ -344,9 +452,13 @@ function Start () {
 	
 	// initialise the cameras from settings
 	setupCameras();
+	setupNativeCameras();
 	
-	// start the tracker client, and install a callback to receive data
-	trackerClient.start( trackerDataCallback, "localhost", settings.networkPort );
+	// start the tracker client, writing into the tracker buffer
+	if ( settings.networkProtocol == "udp" )
+		trackerClient.startUdp( trackerBuffer, settings.networkPort, settings.multicastGroup );
+	else
+		trackerClient.start( trackerBuffer, "localhost", settings.networkPort );
 }
 
 //-----------------------------------------------------------------------------
@@ -354,41 +466,23 @@ function Start () {
 // update position of all tracked objects
 // any objects named "tracker0", "tracker1" etc. will be repositioned
 function updateObjects () {
-	// potentially quite inefficient to lock for the entire update loop
-	Monitor.Enter( trackerLock );
-	
 	// for each object
 	for (var i=0; i<trackerData.Length; i++) {
-		// ignore invalid items
-	    if ( (trackerData[i] == null) || !trackerData[i].valid ) continue;
-	    
-		// attempt to find (and cache reference to) corresponding object
-	    if ( trackedItem[i] == null )
-	    	trackedItem[i] = GameObject.Find( "tracker" + i );
+		// ignore invalid items, and sensors with no object in the scene
+	    if ( !trackerData[i].valid || (trackedItem[i] == null) ) continue;
 	    
 	    // update object position
-	    if ( trackedItem[i] != null ) {
-	    	trackedItem[i].transform.position = trackerData[i].position;
-	    	trackedItem[i].transform.rotation = trackerData[i].rotation;
-	    }
+	    trackedItem[i].transform.position = trackerData[i].position;
+	    trackedItem[i].transform.rotation = trackerData[i].rotation;
 	}
-	
-	// unlock
-	Monitor.Exit( trackerLock );
 }
 
 //-----------------------------------------------------------------------------
 
 // update position of all cameras
 function updateCameras () {
-	// copy tracker data
-	var tracker = new TrackerData();
-	Monitor.Enter( trackerLock );
-		if ( trackerData[0] != null )
-			tracker = trackerData[0];
-		else
-			tracker.valid = false;
-	Monitor.Exit( trackerLock );
+	// head tracker data (copied by readTracker this frame)
+	var tracker = trackerData[0];
 	
 	// exit if data is invalid
 	if ( !tracker.valid ) return;
@@ -406,18 +500,85 @@ function updateCameras () {
 	var eyeRight  :Vector3 = eyeCentre + eyeOffset;
 	
 	// update the position of all camera rigs
+	if ( nativeCameras ) {
+		updateNativeCameras( eyeLeft, eyeRight );
+		return;
+	}
 	for (var rig in cameras)
 		rig.update( eyeLeft, eyeRight );
 }
 
 //-----------------------------------------------------------------------------
 
+// prepare the arrays shared with the native plugin, and check that the
+// plugin is there (otherwise the cameras are updated in script)
+function setupNativeCameras() {
+	var count = cameras.Count;
+	nativeScreens = new float[12 * count];
+	nativeEyes = new float[6];
+	nativeProjections = new Matrix4x4[2 * count];
+	
+	for (var i=0; i<count; i++) {
+		var screen = cameras[i].screen;
+		var values = [
+			screen.centre.x, screen.centre.y, screen.centre.z,
+			screen.normal.x, screen.normal.y, screen.normal.z,
+			screen.up.x, screen.up.y, screen.up.z,
+			screen.width, screen.height, 0.0f
+		];
+		for (var j=0; j<values.length; j++)
+			nativeScreens[12 * i + j] = values[j];
+	}
+	
+	if ( count == 0 ) return;
+	try {
+		var first = cameras[0].left;
+		nativeCameras = QuadifierComputeProjections(
+			nativeScreens, count, nativeEyes, 2,
+			first.nearClipPlane, first.farClipPlane, nativeProjections
+		) == 2 * count;
+	} catch ( e :System.Exception ) {
+		// DllNotFoundException or EntryPointNotFoundException
+		nativeCameras = false;
+	}
+	Debug.Log( nativeCameras ?
+		"Quadifier: camera projections computed by QuadifierPlugin" :
+		"Quadifier: QuadifierPlugin not found, camera projections computed in script" );
+}
+
+//-----------------------------------------------------------------------------
+
+// update all cameras through the native plugin
+// (all cameras share the near and far planes of the first one)
+function updateNativeCameras( eyeLeft :Vector3, eyeRight :Vector3 ) {
+	nativeEyes[0] = eyeLeft.x;  nativeEyes[1] = eyeLeft.y;  nativeEyes[2] = eyeLeft.z;
+	nativeEyes[3] = eyeRight.x; nativeEyes[4] = eyeRight.y; nativeEyes[5] = eyeRight.z;
+	
+	var count = cameras.Count;
+	var first = cameras[0].left;
+	QuadifierComputeProjections(
+		nativeScreens, count, nativeEyes, 2,
+		first.nearClipPlane, first.farClipPlane, nativeProjections
+	);
+	
+	for (var i=0; i<count; i++) {
+		var rig = cameras[i];
+		rig.apply( rig.left, eyeLeft, nativeProjections[2 * i] );
+		rig.apply( rig.right, eyeRight, nativeProjections[2 * i + 1] );
+	}
+}
+
+//-----------------------------------------------------------------------------
+
 function Update () {
 	// ensure vsync is disabled
 	// note: calling this from Start doesn't seem to work (it changes back),
 	// presumably because player quality settings are applied after start up?
 	QualitySettings.vSyncCount = 0;
 
+	// copy the latest tracking data
+	readTracker();
+
 	// update camera positions
 	updateCameras();
 	
@@ -0,0 +1,27 @@
+#pragma strict
+
+//-----------------------------------------------------------------------------
+
+// added by Quadifier.js to the cameras which start a view when
+// QuadifierPlugin.dll is available: the first of the cameras of a view to
+// render each frame issues the plugin event which tells the Quadifier
+// module that the view is starting (the right eye cameras all start view
+// 1; in multi-view mode each camera is a view of its own)
+
+// the event ID (from QuadifierViewEvent in the plugin)
+public var eventID = 0;
+
+// the frame and event last issued (shared by all the cameras)
+private static var signalledFrame = -1;
+private static var signalledEvent = 0;
+
+//-----------------------------------------------------------------------------
+
+function OnPreRender () {
+	if ( (signalledFrame == Time.frameCount) && (signalledEvent == eventID) ) return;
+	signalledFrame = Time.frameCount;
+	signalledEvent = eventID;
+	GL.IssuePluginEvent( eventID );
+}
+
+//-----------------------------------------------------------------------------
@@ -16,11 +16,25 @@ private var serverIP :IPAddress;
 // the network port to use
 private var networkPort :ushort = 3010;
 
+// multicast group to join when receiving datagrams (empty for unicast)
+private var multicastGroup :String = "";
+
 // is the client running?
 private var running = false;
 
-// callback function used to notify when data has arrived
-private var dataCallback :function(TrackerData) = null;
+// receives the data of every sensor, as it arrives
+private var buffer :TrackerBuffer = null;
+
+// size of each tracker data record, and of the frame header which
+// follows the 4 byte frame length (sequence, send time, record count)
+private var recordSize = 36;
+private var headerSize = 16;
+
+// a datagram is taken as a new stream (e.g. the bridge was restarted, and
+// counts from 0 again) after this many milliseconds without one, or if its
+// sequence number is this far behind the newest one seen
+private var resyncTime = 1000;
+private var resyncFrames = 256;
 
 //---------------------------------------------------------
 
@@ -31,6 +45,7 @@ class TrackerData {
 	var position :Vector3;		// position of the sensor
 	var rotation :Quaternion;	// orientation of the sensor
 	var valid :boolean;			// is the data valid?
+	var sequence :int;			// update sequence number (0 = none)
 	
 	function TrackerData() {
 		timeStamp = 0;
@@ -38,6 +53,17 @@ class TrackerData {
 		position = Vector3(0,0,0);
 		rotation = Quaternion.identity;
 		valid = false;
+		sequence = 0;
+	}
+	
+	// copy another sample into this one (without allocating)
+	function copy( other :TrackerData ) {
+		timeStamp = other.timeStamp;
+		sensor = other.sensor;
+		position = other.position;
+		rotation = other.rotation;
+		valid = other.valid;
+		sequence = other.sequence;
 	}
 	
 	// convert tracker data to a 4x4 matrix
@@ -52,16 +78,127 @@ class TrackerData {
 
 //---------------------------------------------------------
 
+// the latest data of each sensor, written by the network thread and read by
+// the main thread without locks: each sensor has three preallocated slots,
+// and the writer fills the slot after the one last published before making
+// it the latest, so the reader always has a complete slot to copy; each
+// slot also carries a sequence number, cleared while it is being written,
+// so that a copy which the writer overtook (by lapping all three slots) is
+// detected and discarded
+class TrackerBuffer {
+	private var slots :TrackerData[];	// three slots per sensor
+	private var latest :int[];			// latest slot of each sensor
+	private var sequence :int;			// last sequence number written
+	
+	// changes whenever a frame of updates has been published (so that the
+	// reader can tell, with one read, if there is anything new)
+	var published :int;
+	
+	function TrackerBuffer( sensors :int ) {
+		slots = new TrackerData[3 * sensors];
+		for (var i=0; i<slots.Length; i++)
+			slots[i] = new TrackerData();
+		latest = new int[sensors];
+		sequence = 0;
+		published = 0;
+	}
+	
+	// number of sensors
+	function get sensors() :int {
+		return latest.Length;
+	}
+	
+	// decode one 36 byte record into the next slot of its sensor, and make
+	// it the latest (network thread)
+	function write( data :byte[], offset :int ) {
+		var sensor = BitConverter.ToInt32( data, offset + 4 );
+		if ( (sensor < 0) || (sensor >= latest.Length) ) return;
+		
+		var next = ( latest[sensor] + 1 ) % 3;
+		var slot = slots[3 * sensor + next];
+		slot.sequence = 0;
+		Thread.MemoryBarrier();
+		
+		TrackerClient.readTrackerData( data, offset, slot );
+		
+		// sequence numbers are never 0 (the "being written" marker)
+		sequence++;
+		if ( sequence == 0 ) sequence = 1;
+		Thread.MemoryBarrier();
+		slot.sequence = sequence;
+		Thread.MemoryBarrier();
+		latest[sensor] = next;
+	}
+	
+	// signal that a frame of updates is complete (network thread)
+	function publish() {
+		Thread.MemoryBarrier();
+		published++;
+	}
+	
+	// copy the latest data of a sensor, returning false (and leaving the
+	// result as it was) if there is none yet, or if the copy was overtaken
+	// by the writer (main thread)
+	function read( sensor :int, result :TrackerData ) :boolean {
+		var slot = slots[3 * sensor + latest[sensor]];
+		Thread.MemoryBarrier();
+		var copied = slot.sequence;
+		if ( (copied == 0) || (copied == result.sequence) ) return false;
+		Thread.MemoryBarrier();
+		
+		var timeStamp = slot.timeStamp;
+		var position = slot.position;
+		var rotation = slot.rotation;
+		Thread.MemoryBarrier();
+		if ( slot.sequence != copied ) return false;
+		
+		result.timeStamp = timeStamp;
+		result.sensor = sensor;
+		result.position = position;
+		result.rotation = rotation;
+		result.valid = true;
+		result.sequence = copied;
+		return true;
+	}
+};
+
+//---------------------------------------------------------
+
+// decode the 36 byte tracker data sent by the bridge (in place)
+static function readTrackerData( data :byte[], offset :int, trackData :TrackerData ) {
+	// time in seconds
+	trackData.timeStamp = BitConverter.ToSingle( data, offset + 0 );
+	
+	// sensor identifier number
+	trackData.sensor = BitConverter.ToInt32( data, offset + 4 );
+	
+	// position vector
+	trackData.position.x = BitConverter.ToSingle( data, offset +  8 );
+	trackData.position.y = BitConverter.ToSingle( data, offset + 12 );
+	trackData.position.z = BitConverter.ToSingle( data, offset + 16 );
+	
+	// orientation quaternion
+	trackData.rotation.x = BitConverter.ToSingle( data, offset + 20 );
+	trackData.rotation.y = BitConverter.ToSingle( data, offset + 24 );
+	trackData.rotation.z = BitConverter.ToSingle( data, offset + 28 );
+	trackData.rotation.w = BitConverter.ToSingle( data, offset + 32 );
+	
+	// mark the data as valid
+	trackData.valid = true;
+}
+
+//---------------------------------------------------------
+
 // start the tracker client
 function start(
-	callback :function(TrackerData),	// callback to receive data
+	target :TrackerBuffer,				// receives the data
 	server :String,						// network server name
 	port :ushort						// network port number
 ) {
     Debug.Log( "Client: start" );
     
-    // install the user defined data callback
-    dataCallback = callback;
+    // install the buffer to receive data
+    buffer = target;
     
     // get server host address
     serverIP = Dns.GetHostAddresses(server)[0];
@@ -77,6 +214,26 @@ function start(
 
 //---------------------------------------------------------
 
+// start the tracker client, receiving UDP datagrams from the bridge
+// (started with -udp) instead of connecting to it
+function startUdp(
+	target :TrackerBuffer,				// receives the data
+	port :ushort,						// network port number
+	group :String						// multicast group, or empty
+) {
+    Debug.Log( "Client: start (udp)" );
+
+    buffer = target;
+    networkPort = port;
+    multicastGroup = (group != null) ? group : "";
+
+    // start the datagram receiving thread
+    thread = new Thread( threadUdpListener );
+    thread.Start();
+}
+
+//---------------------------------------------------------
+
 // stop the tracker client
 function stop() {
 	Debug.Log( "Client: stop" );
@@ -93,6 +250,32 @@ function stop() {
 
 //---------------------------------------------------------
 
+// decode a frame (starting after its length field) into the buffer
+private function readFrame( data :byte[], offset :int, size :int ) {
+	var count = BitConverter.ToInt32( data, offset + 12 );
+	if ( (count < 0) || (headerSize + count * recordSize > size) ) count = 0;
+	
+	for (var i=0; i<count; i++)
+		buffer.write( data, offset + headerSize + i * recordSize );
+	buffer.publish();
+}
+
+//---------------------------------------------------------
+
+// read exactly count bytes from the stream
+private function readFully( stream :NetworkStream, buffer :byte[], count :int ) {
+	var offset = 0;
+	while ( offset < count ) {
+		var read = stream.Read( buffer, offset, count - offset );
+		
+		// 10054 is the Windows Socket error code for a connection reset
+		if ( read <= 0 ) throw SocketException( 10054 );
+		offset += read;
+	}
+}
+
+//---------------------------------------------------------
+
 // the network client thread
 private function threadListener() {
 	Debug.Log( "Client: thread started" );
@@ -109,8 +292,9 @@ private function threadListener() {
 
 		Debug.Log( "Client: connected" );
 
-        // receive buffer
-        var data = new byte[36];
+        // receive buffers: the frame length, then the rest of the frame
+        var length = new byte[4];
+        var data = new byte[headerSize + 16 * recordSize];
 
         // wait for data
         var ticks = 1000;
@@ -130,32 +314,15 @@ private function threadListener() {
         
         // we have received data
         while (running) {
-            // read data
-            stream.Read( data, 0, data.Length );
+            // read the frame length, then the whole frame
+            readFully( stream, length, 4 );
+            var size = BitConverter.ToInt32( length, 0 );
+            if ( (size < headerSize) || (size > headerSize + 1024 * recordSize) )
+                throw SocketException( 10053 );
+            if ( size > data.Length ) data = new byte[size];
+            readFully( stream, data, size );
 
-			var trackData :TrackerData = new TrackerData();
-			
-			// time in seconds
-			trackData.timeStamp = BitConverter.ToSingle( data, 0 );
-			
-			// sensor identifier number
-			trackData.sensor = BitConverter.ToInt32( data, 4 );
-			
-			// position vector
-			trackData.position.x = BitConverter.ToSingle( data,  8 );
-			trackData.position.y = BitConverter.ToSingle( data, 12 );
-			trackData.position.z = BitConverter.ToSingle( data, 16 );
-			
-			// orientation quaternion
-			trackData.rotation.x = BitConverter.ToSingle( data, 20 );
-			trackData.rotation.y = BitConverter.ToSingle( data, 24 );
-			trackData.rotation.z = BitConverter.ToSingle( data, 28 );
-			trackData.rotation.w = BitConverter.ToSingle( data, 32 );
-			
-			// mark the data as valid
-			trackData.valid = true;
-		
-			dataCallback( trackData );
+			readFrame( data, 0, size );
         }
     }
     catch (InvOpEx : InvalidOperationException) {
@@ -174,3 +341,68 @@ private function threadListener() {
 }
 
 //---------------------------------------------------------
+
+// the datagram client thread: each datagram holds one frame, as sent over
+// TCP (length, sequence number, monotonic send time, count, records)
+private function threadUdpListener() {
+	Debug.Log( "Client: udp thread started" );
+	
+	var client = new UdpClient();
+	
+	try {
+		// allow other clients on this machine to share the port
+		client.Client.SetSocketOption(
+			SocketOptionLevel.Socket, SocketOptionName.ReuseAddress, true
+		);
+		client.Client.Bind( IPEndPoint( IPAddress.Any, networkPort ) );
+		if ( multicastGroup != "" )
+			client.JoinMulticastGroup( IPAddress.Parse( multicastGroup ) );
+		
+		// wake up regularly to check whether we have been stopped
+		client.Client.ReceiveTimeout = 250;
+		
+		var remote = new IPEndPoint( IPAddress.Any, 0 );
+		
+		// each socket starts a new stream
+		var lastSequence = 0;
+		var haveSequence = false;
+		var lastReceived = 0;
+		
+		running = true;
+		while (running) {
+			var packet :byte[];
+			try {
+				packet = client.Receive( remote );
+			}
+			catch (TimeoutEx : SocketException) {
+				if ( TimeoutEx.SocketErrorCode == SocketError.TimedOut ) continue;
+				throw TimeoutEx;
+			}
+			if ( packet.Length < 4 + headerSize ) continue;
+			
+			// drop frames older than the newest one seen (the difference
+			// wraps around, so it is still correct after 2^32 frames),
+			// unless the stream has started again
+			var sequence = BitConverter.ToInt32( packet, 4 );
+			var now = Environment.TickCount;
+			var behind = lastSequence - sequence;
+			var restarted = ( now - lastReceived > resyncTime ) || ( behind > resyncFrames );
+			lastReceived = now;
+			if ( haveSequence && !restarted && (behind >= 0) ) continue;
+			if ( haveSequence && restarted && (behind >= 0) )
+				Debug.Log( "Client: tracker stream restarted at frame " + sequence );
+			lastSequence = sequence;
+			haveSequence = true;
+			
+			readFrame( packet, 4, packet.Length - 4 );
+		}
+	}
+	catch (SockEx : SocketException) {
+		Debug.Log( "Socket exception: " + SockEx.Message );
+	}
+	finally {
+		client.Close();
+	}
+}
+
+//---------------------------------------------------------
@@ -1,423 +1,1508 @@
-#include <iostream>
-#include <vector>
-#include <conio.h>
-#include <winsock2.h>
-#include "vrpn_Analog.h"
-#include "vrpn_Tracker.h"
-
-using namespace std;
-
-//-----------------------------------------------------------------------------
-//
-// Copyright (C) 2013-14 James Ward, University of Hull
-//
-// This software is provided 'as-is', without any express or implied
-// warranty. In no event will the authors be held liable for any damages
-// arising from the use of this software.
-//
-// Permission is granted to anyone to use this software for any purpose,
-// including commercial applications, and to alter it and redistribute it
-// freely, subject to the following restrictions:
-//
-//    1. The origin of this software must not be misrepresented; you must not
-//    claim that you wrote the original software.
-//
-//    2. If you use this software in a product, an acknowledgment in the
-//    product documentation is required.
-//
-//    3. Altered source versions must be plainly marked as such, and must not
-//    be misrepresented as being the original software.
-//
-//    4. This notice may not be removed or altered from any source
-//    distribution.
-//
-//-----------------------------------------------------------------------------
-
-/// VRPN "bridge" which connects to a VRPN server and serves tracking data
-/// in a simple binary format so that it can easily be read by a fairly
-/// dumb Unity script. This is a proof of concept, and would benefit from
-/// a rewrite using Boost ASIO or similar instead of Winsock.
-/// Tested and working using Vicon Tracker and Razer Hydra
-/// J.Ward 12/01/13
-
-//-----------------------------------------------------------------------------
-
-#pragma pack (push, 1)
-/// defines the format of the tracker data sent to Unity
-struct TrackerData {
-    float timeStamp;    ///< time in seconds
-    int   sensor;       ///< sensor number
-    float position[3];  ///< position vector
-    float rotation[4];  ///< orientation quaternion
-
-    TrackerData() :
-        timeStamp(0.0f),
-        sensor(0)
-    {
-    }
-
-    /// fill in the structure, given VRPN tracking data
-    void set( const vrpn_TRACKERCB & tracker ) {
-        // time in seconds
-        timeStamp = (float)(tracker.msg_time.tv_sec) +
-                    static_cast<float>(tracker.msg_time.tv_usec) * 1.0e-6f;
-
-        // sensor number
-        sensor = tracker.sensor;
-
-        // position
-        position[0] = static_cast<float>( tracker.pos[0] );
-        position[1] = static_cast<float>( tracker.pos[1] );
-        position[2] = static_cast<float>( tracker.pos[2] );
-
-        // calculate scale factor to normalise the quaternion
-        double sum = 0.0;
-        for (unsigned i=0; i<4; i++)
-            sum += tracker.quat[i] * tracker.quat[i];
-        double scale = 1.0 / sqrt( sum );
-
-        // orientation quaternion (normalise before sending to Unity)
-        rotation[0] = static_cast<float>( tracker.quat[0] * scale );
-        rotation[1] = static_cast<float>( tracker.quat[1] * scale );
-        rotation[2] = static_cast<float>( tracker.quat[2] * scale );
-        rotation[3] = static_cast<float>( tracker.quat[3] * scale );
-    }
-};
-#pragma pack (pop)
-
-//-----------------------------------------------------------------------------
-
-const short SERVER_PORT = 3010;
-
-//-----------------------------------------------------------------------------
-
-class Server {
-public:
-    /// default constructor
-    Server();
-
-    /// destructor
-    virtual ~Server();
-
-    /// the server thread
-    static unsigned __stdcall serverThread( void *userData );
-
-    /// start the server
-    bool start();
-
-    /// stop the server
-    void stop();
-
-    /// returns true if the server is running
-    bool isRunning() const;
-
-    /// send tracking data to the client
-    bool send( const TrackerData & data );
-
-private:
-    /// send data
-    unsigned send( SOCKET sock, const void *data, unsigned size );
-    
-    /// open Winsock library
-    bool openWinsock();
-
-    /// close Winsock library
-    void closeWinsock();
-
-private:
-    bool    m_running;  ///< is the server running?
-    HANDLE  m_thread;   ///< server thread handle
-    SOCKET  m_socket;   ///< socket connection
-    bool    m_quit;     ///< quit flag
-};
-
-//-----------------------------------------------------------------------------
-
-Server::Server() {
-    m_running = false;
-    m_thread = 0;
-    m_socket = 0;
-    m_quit = false;
-    openWinsock();
-}
-
-//-----------------------------------------------------------------------------
-
-Server::~Server() {
-    stop();
-    closeWinsock();
-}
-
-//-----------------------------------------------------------------------------
-
-unsigned Server::serverThread( void *userData ) {
-    Server *server = reinterpret_cast<Server*>( userData );
-
-    // create socket
-    SOCKET sock = socket( PF_INET, SOCK_STREAM, 0 );
-    if ( sock == INVALID_SOCKET ) {
-        cerr << "Server: failed to create socket\n";
-        _endthreadex( 0 );
-        return 0;
-    }
-
-    // bind socket
-    struct sockaddr_in address;
-    address.sin_family = AF_INET;
-    address.sin_port = htons( SERVER_PORT );
-    address.sin_addr.s_addr = htonl( INADDR_ANY );
-    if (
-        bind( sock, (const struct sockaddr*)&address, sizeof(address) )
-        == SOCKET_ERROR
-    ) {
-        cerr << "Server: failed to bind socket\n";
-        closesocket( sock );
-        _endthreadex(0);
-        return 0;
-    }
-
-    do {
-        cout << "Server: listening\n";
-
-        // listen for connection
-        if ( listen( sock, SOMAXCONN ) == SOCKET_ERROR ) {
-            cerr << "Server: listen failed\n";
-            break;
-        }
-
-        int numRead = 0;
-        do {
-            // create an fd_set containing one socket (sock)
-            fd_set set;
-            FD_ZERO( &set );
-            FD_SET( sock, &set );
-
-            // check socket status, with 250ms timeout period
-            struct timeval timeout = { 0, 250*1000 };
-            numRead = select( 1, &set, 0, 0, &timeout );
-        } while ( (numRead == 0) && !server->m_quit );
-
-        if ( server->m_quit ) break;
-
-        // accept connection
-        struct sockaddr_in client;
-        int size = sizeof( client );
-        SOCKET link;
-        do {
-            // the use of select() above should mean that we are
-            // ready to accept() without blocking by this stage
-            link = accept(sock, (struct sockaddr*)&client, &size);
-        } while (link == INVALID_SOCKET);
-
-        // successful?
-        if ( link == INVALID_SOCKET ) {
-            cerr << "Server: accept failed\n";
-            break;
-        }
-
-        server->m_socket = link;
-
-        cout << "connection\n";
-
-        vector<char> buffer(256);
-
-        int result = 0;
-        do {
-            result = recv( link, &buffer[0], buffer.size(), 0);
-            if ( result > 0 )
-                cout << "Server: received " << result << " bytes\n";
-            else if ( result == 0 )
-                cout << "Server: closing connection\n";
-            else {
-                cerr << "Server: recv failed with error " << WSAGetLastError() << endl;
-                cerr << "Closing connection (assume client disconnected)\n";
-                break;
-            }
-        } while (result > 0);
-
-        // close the socket
-        shutdown( server->m_socket, SD_SEND );
-        closesocket( server->m_socket );
-        server->m_socket = 0;
-    } while ( !server->m_quit );
-
-    // close listen socket
-    closesocket( sock );
-    sock = 0;
-
-    // end the thread
-    _endthreadex(1);
-
-    return 1;
-}
-
-//-----------------------------------------------------------------------------
-
-bool Server::start() {
-    // is server already running?
-    if ( isRunning() ) return true;
-
-    m_quit = false;
-
-    // start server thread
-    unsigned int threadId = 0;
-    m_thread = reinterpret_cast<HANDLE>(_beginthreadex(
-        0,              // no security attributes (child can't inherit)
-        1024*1024,      // 1MB stack size
-        serverThread,   // thread function
-        this,           // pointer to parent
-        0,              // run immediately
-        &threadId       // out: returns thread ID
-    ));
-
-    // check result
-    if ( m_thread != 0 ) {
-        // check whether it started
-        if ( WaitForSingleObject( m_thread, 100L) == WAIT_OBJECT_0 ) {
-            m_running = false;
-            return false;
-        } else
-            m_running = true;
-
-        return true;
-    } else {
-        // failed to start
-        m_running = false;
-
-        return false;
-    }
-}
-
-//-----------------------------------------------------------------------------
-
-void Server::stop() {
-    // is server already stopped?
-    if ( !isRunning() ) return;
-
-    // set flag to request thread to stop
-    m_quit = true;
-
-    // wait for it to stop (give it 4 seconds)
-    if ( WaitForSingleObject(m_thread, 4000L) == WAIT_OBJECT_0 ) {
-        // thread has exited
-        CloseHandle( m_thread );
-    } else {
-        // timeout: thread still running
-    }
-
-    // clear thread handle
-    m_thread = 0;
-
-    // reset running state and stop request flag
-    m_running = false;
-    m_quit = false;
-}
-
-//-----------------------------------------------------------------------------
-
-bool Server::isRunning() const {
-    return m_running;
-}
-
-//-----------------------------------------------------------------------------
-
-bool Server::send( const TrackerData & data ) {
-    if ( m_socket != 0 )
-        return send( m_socket, &data, sizeof(data) ) == sizeof(data);
-    else
-        return false;
-}
-
-//-----------------------------------------------------------------------------
-
-unsigned Server::send( SOCKET sock, const void *data, unsigned size ) {
-    int numRemain = static_cast<int>(size);
-
-    const char *ptr = reinterpret_cast<const char *>(data);
-
-    do {
-        // send a packet
-        int numSent = ::send( sock, ptr, numRemain, 0 );
-        if ( numSent == SOCKET_ERROR ) break;
-
-        // update buffer pointer and byte count
-        ptr += numSent;
-        numRemain -= numSent;
-    } while ( numRemain > 0 );
-
-    // return number of bytes sent
-    return size - numRemain;
-}
-
-//-----------------------------------------------------------------------------
-
-bool Server::openWinsock() {
-    WORD version = MAKEWORD(2,2);
-    WSADATA wsa;
-    if ( WSAStartup( version, &wsa ) != 0 )
-        return false;
-
-    if ( wsa.wVersion == version )
-        return true;
-    else {
-        WSACleanup();
-        return false;
-    }
-}
-
-//-----------------------------------------------------------------------------
-
-void Server::closeWinsock() {
-    WSACleanup();
-}
-
-//-----------------------------------------------------------------------------
-
-unsigned frames = 0;
-
-void VRPN_CALLBACK handleTracker( void *userData, const vrpn_TRACKERCB tracker ) {
-    Server *server = reinterpret_cast<Server*>( userData );
-
-    if (tracker.sensor == 0) ++frames;
-
-    cout << "Tracker " << tracker.sensor << ": "
-         << tracker.pos[0]  << ',' <<  tracker.pos[1]  << ',' << tracker.pos[2]  << ','
-         << tracker.quat[0] << ',' <<  tracker.quat[1] << ',' << tracker.quat[2] << ','
-         << tracker.quat[3]
-         << endl;
-
-     // tracker data to send to Unity client
-     TrackerData data;
-     data.set( tracker );
-
-     // send the data
-     server->send( data );
-}
-
-int main (int , char **)
-{
-    Server server;
-    server.start();
-
-    vrpn_Tracker_Remote tracker( "Tracker0@localhost" );
-
-    tracker.register_change_handler( &server, handleTracker );
-
-    // record start time
-    float t = (float)clock()/CLOCKS_PER_SEC;
-
-    while (!kbhit())
-        tracker.mainloop();
-
-    server.stop();
-
-    tracker.unregister_change_handler( &server, handleTracker );
-
-    // calculate update rate achieved (for Razer Hydra, I get 250Hz)
-    t = (float)clock()/CLOCKS_PER_SEC - t;
-    printf("%.2f Hz\n", (float)frames / t);
-
-    return 0;
-}
-
-//-----------------------------------------------------------------------------
+#include <iostream>
+#include <vector>
+#include <conio.h>
+#include <string>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#if !defined(_WIN32_WINNT) || (_WIN32_WINNT < 0x0600)
+#undef _WIN32_WINNT
+#define _WIN32_WINNT 0x0600     // WSAPoll needs Vista upwards
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include "vrpn_Analog.h"
+#include "vrpn_Tracker.h"
+#include "../quadifier/common/Clock.h"
+#include "../quadifier/win32/common/SharedPose.h"
+
+using namespace std;
+
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2013-14 James Ward, University of Hull
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+//    1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software.
+//
+//    2. If you use this software in a product, an acknowledgment in the
+//    product documentation is required.
+//
+//    3. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+//    4. This notice may not be removed or altered from any source
+//    distribution.
+//
+//-----------------------------------------------------------------------------
+
+/// VRPN "bridge" which connects to a VRPN server and serves tracking data
+/// in a simple binary format so that it can easily be read by a fairly
+/// dumb Unity script. This is a proof of concept, and would benefit from
+/// a rewrite using Boost ASIO or similar instead of Winsock.
+/// Tested and working using Vicon Tracker and Razer Hydra
+/// J.Ward 12/01/13
+
+//-----------------------------------------------------------------------------
+
+#pragma pack (push, 1)
+/// defines the format of the tracker data sent to Unity
+struct TrackerData {
+    float timeStamp;    ///< time in seconds
+    int   sensor;       ///< sensor number
+    float position[3];  ///< position vector
+    float rotation[4];  ///< orientation quaternion
+
+    TrackerData() :
+        timeStamp(0.0f),
+        sensor(0)
+    {
+    }
+
+    /// fill in the structure, given VRPN tracking data
+    void set( const vrpn_TRACKERCB & tracker ) {
+        // time in seconds
+        timeStamp = (float)(tracker.msg_time.tv_sec) +
+                    static_cast<float>(tracker.msg_time.tv_usec) * 1.0e-6f;
+
+        // sensor number
+        sensor = tracker.sensor;
+
+        // position
+        position[0] = static_cast<float>( tracker.pos[0] );
+        position[1] = static_cast<float>( tracker.pos[1] );
+        position[2] = static_cast<float>( tracker.pos[2] );
+
+        // calculate scale factor to normalise the quaternion
+        double sum = 0.0;
+        for (unsigned i=0; i<4; i++)
+            sum += tracker.quat[i] * tracker.quat[i];
+        double scale = 1.0 / sqrt( sum );
+
+        // orientation quaternion (normalise before sending to Unity)
+        rotation[0] = static_cast<float>( tracker.quat[0] * scale );
+        rotation[1] = static_cast<float>( tracker.quat[1] * scale );
+        rotation[2] = static_cast<float>( tracker.quat[2] * scale );
+        rotation[3] = static_cast<float>( tracker.quat[3] * scale );
+    }
+};
+
+/// defines the header of each frame sent to Unity: a frame carries every
+/// sensor update from one VRPN mainloop tick, as `count` TrackerData records
+/// following the header; over UDP each datagram is one frame, and the
+/// sequence number and monotonic send time let the client drop stale or
+/// reordered frames
+struct FrameHeader {
+    unsigned    length;     ///< bytes following this field (header and records)
+    unsigned    sequence;   ///< incremented for every frame sent
+    double      sendTime;   ///< monotonic time of sending (seconds)
+    unsigned    count;      ///< number of TrackerData records
+};
+#pragma pack (pop)
+
+//-----------------------------------------------------------------------------
+
+const short SERVER_PORT = 3010;
+
+/// time-to-live of multicast datagrams (1 = local subnet only)
+const int MULTICAST_TTL = 1;
+
+/// unsent bytes allowed per client before it is disconnected
+const size_t MAX_PENDING = 64 * 1024;
+
+/// samples queued for printing (-verbose) before further samples are dropped
+const size_t MAX_PRINT_QUEUE = 4096;
+
+//-----------------------------------------------------------------------------
+
+class Server {
+public:
+    /// default constructor
+    Server();
+
+    /// destructor
+    virtual ~Server();
+
+    /// the server thread
+    static unsigned __stdcall serverThread( void *userData );
+
+    /// start the server
+    bool start();
+
+    /// stop the server
+    void stop();
+
+    /// returns true if the server is running
+    bool isRunning() const;
+
+    /// send datagrams to a unicast or multicast address (in addition to
+    /// any TCP clients)
+    bool openDatagram( const std::string & host, unsigned short port );
+
+    /// send one frame of tracking data to all the clients
+    bool send( const std::vector<TrackerData> & records );
+
+    /// returns the number of clients, and the most data queued for any one
+    /// client since the last call (bytes)
+    void status( size_t & clients, size_t & queued );
+
+private:
+    /// a connected TCP client
+    struct Client {
+        SOCKET      socket;     ///< non-blocking socket
+        std::string pending;    ///< data not yet accepted by the socket
+    };
+
+    /// the body of the server thread
+    void run();
+
+    /// accept all waiting connections (server thread)
+    void acceptClients( SOCKET listener );
+
+    /// send as much pending data as the client's socket will take, returns
+    /// false if the connection has failed (call with m_lock held)
+    bool flush( Client & client );
+
+    /// close and remove a client (call with m_lock held)
+    void removeClient( size_t index, const char *reason );
+
+    /// wake the server thread from WSAPoll
+    void wake();
+
+    /// open Winsock library
+    bool openWinsock();
+
+    /// close Winsock library
+    void closeWinsock();
+
+private:
+    bool    m_running;  ///< is the server running?
+    HANDLE  m_thread;   ///< server thread handle
+    volatile bool m_quit; ///< quit flag
+
+    CRITICAL_SECTION    m_lock;     ///< guards m_clients
+    std::vector<Client> m_clients;  ///< the connected clients
+    SOCKET      m_wakeSocket;       ///< loopback socket polled by the server
+    sockaddr_in m_wakeAddress;      ///< address of m_wakeSocket
+
+    SOCKET      m_datagram;     ///< UDP socket (INVALID_SOCKET if unused)
+    sockaddr_in m_destination;  ///< where datagrams are sent
+    unsigned    m_sequence;     ///< sequence number of the next frame
+    std::string m_frame;        ///< the frame being sent
+    size_t      m_maxPending;   ///< most data queued for a client (guarded)
+};
+
+//-----------------------------------------------------------------------------
+
+Server::Server() {
+    m_running = false;
+    m_thread = 0;
+    m_quit = false;
+    m_wakeSocket = INVALID_SOCKET;
+    m_datagram = INVALID_SOCKET;
+    m_sequence = 0;
+    m_maxPending = 0;
+    InitializeCriticalSection( &m_lock );
+    openWinsock();
+}
+
+//-----------------------------------------------------------------------------
+
+Server::~Server() {
+    stop();
+    if ( m_datagram != INVALID_SOCKET ) closesocket( m_datagram );
+    closeWinsock();
+    DeleteCriticalSection( &m_lock );
+}
+
+//-----------------------------------------------------------------------------
+
+unsigned Server::serverThread( void *userData ) {
+    Server *server = reinterpret_cast<Server*>( userData );
+    server->run();
+
+    // end the thread
+    _endthreadex(1);
+
+    return 1;
+}
+
+//-----------------------------------------------------------------------------
+
+void Server::run() {
+    // create the listening socket
+    SOCKET listener = socket( PF_INET, SOCK_STREAM, 0 );
+    if ( listener == INVALID_SOCKET ) {
+        cerr << "Server: failed to create socket\n";
+        return;
+    }
+
+    // bind socket
+    struct sockaddr_in address;
+    address.sin_family = AF_INET;
+    address.sin_port = htons( SERVER_PORT );
+    address.sin_addr.s_addr = htonl( INADDR_ANY );
+    if (
+        bind( listener, (const struct sockaddr*)&address, sizeof(address) )
+        == SOCKET_ERROR
+    ) {
+        cerr << "Server: failed to bind socket\n";
+        closesocket( listener );
+        return;
+    }
+
+    // never block in accept
+    u_long nonBlocking = 1;
+    ioctlsocket( listener, FIONBIO, &nonBlocking );
+
+    if ( listen( listener, SOMAXCONN ) == SOCKET_ERROR ) {
+        cerr << "Server: listen failed\n";
+        closesocket( listener );
+        return;
+    }
+
+    cout << "Server: listening\n";
+
+    std::vector<WSAPOLLFD> polls;
+    std::vector<char> buffer(256);
+
+    while ( !m_quit ) {
+        // poll the listener, the wake socket, and every client (for writing
+        // only while it has pending data)
+        polls.clear();
+        WSAPOLLFD poll = {};
+        poll.fd = listener;
+        poll.events = POLLRDNORM;
+        polls.push_back( poll );
+        poll.fd = m_wakeSocket;
+        polls.push_back( poll );
+
+        EnterCriticalSection( &m_lock );
+        for (size_t i=0; i<m_clients.size(); ++i) {
+            poll.fd = m_clients[i].socket;
+            poll.events = POLLRDNORM;
+            if ( !m_clients[i].pending.empty() ) poll.events |= POLLWRNORM;
+            polls.push_back( poll );
+        }
+        LeaveCriticalSection( &m_lock );
+
+        // wait for activity, waking regularly to check the quit flag
+        int ready = WSAPoll( &polls[0], static_cast<ULONG>( polls.size() ), 250 );
+        if ( ready == SOCKET_ERROR ) {
+            cerr << "Server: poll failed with error " << WSAGetLastError() << endl;
+            break;
+        }
+        if ( ready == 0 ) continue;
+
+        // new connections
+        if ( polls[0].revents & POLLRDNORM ) acceptClients( listener );
+
+        // drain the wake-up datagrams
+        if ( polls[1].revents & POLLRDNORM ) {
+            while ( recv( m_wakeSocket, &buffer[0], buffer.size(), 0 ) > 0 ) {}
+        }
+
+        // service the clients which were polled (new clients are appended,
+        // and removals are matched by socket, so indices stay valid)
+        EnterCriticalSection( &m_lock );
+        for (size_t p=2; p<polls.size(); ++p) {
+            if ( polls[p].revents == 0 ) continue;
+
+            size_t i = 0;
+            while ( (i < m_clients.size()) && (m_clients[i].socket != polls[p].fd) ) ++i;
+            if ( i == m_clients.size() ) continue;
+
+            if ( polls[p].revents & (POLLERR | POLLHUP | POLLNVAL) ) {
+                removeClient( i, "closing connection" );
+                continue;
+            }
+
+            if ( polls[p].revents & POLLRDNORM ) {
+                int result = recv( m_clients[i].socket, &buffer[0], buffer.size(), 0 );
+                if ( result > 0 ) {
+                    cout << "Server: received " << result << " bytes\n";
+                } else if ( result == 0 ) {
+                    removeClient( i, "closing connection" );
+                    continue;
+                } else if ( WSAGetLastError() != WSAEWOULDBLOCK ) {
+                    removeClient( i, "recv failed (assume client disconnected)" );
+                    continue;
+                }
+            }
+
+            if ( (polls[p].revents & POLLWRNORM) && !flush( m_clients[i] ) )
+                removeClient( i, "send failed" );
+        }
+        LeaveCriticalSection( &m_lock );
+    }
+
+    // close all connections
+    EnterCriticalSection( &m_lock );
+    while ( !m_clients.empty() ) removeClient( m_clients.size() - 1, "server stopping" );
+    LeaveCriticalSection( &m_lock );
+
+    // close listen socket
+    closesocket( listener );
+}
+
+//-----------------------------------------------------------------------------
+
+void Server::acceptClients( SOCKET listener ) {
+    for (;;) {
+        struct sockaddr_in address;
+        int size = sizeof( address );
+        SOCKET link = accept( listener, (struct sockaddr*)&address, &size );
+        if ( link == INVALID_SOCKET ) break;
+
+        // never block in send or recv
+        u_long nonBlocking = 1;
+        ioctlsocket( link, FIONBIO, &nonBlocking );
+
+        // send each packet immediately rather than coalescing (Nagle)
+        BOOL noDelay = TRUE;
+        setsockopt( link, IPPROTO_TCP, TCP_NODELAY,
+            reinterpret_cast<const char*>(&noDelay), sizeof(noDelay) );
+
+        Client client;
+        client.socket = link;
+
+        EnterCriticalSection( &m_lock );
+        m_clients.push_back( client );
+        size_t count = m_clients.size();
+        LeaveCriticalSection( &m_lock );
+
+        cout << "connection from " << inet_ntoa( address.sin_addr )
+             << " (" << count << " clients)\n";
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+bool Server::flush( Client & client ) {
+    while ( !client.pending.empty() ) {
+        int numSent = ::send( client.socket, client.pending.data(),
+            static_cast<int>( client.pending.size() ), 0 );
+        if ( numSent == SOCKET_ERROR )
+            return WSAGetLastError() == WSAEWOULDBLOCK;
+        client.pending.erase( 0, numSent );
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void Server::removeClient( size_t index, const char *reason ) {
+    shutdown( m_clients[index].socket, SD_SEND );
+    closesocket( m_clients[index].socket );
+    m_clients.erase( m_clients.begin() + index );
+    cout << "Server: " << reason << " (" << m_clients.size() << " clients)\n";
+}
+
+//-----------------------------------------------------------------------------
+
+void Server::wake() {
+    char byte = 0;
+    sendto( m_wakeSocket, &byte, 1, 0,
+        reinterpret_cast<const sockaddr*>(&m_wakeAddress), sizeof(m_wakeAddress) );
+}
+
+//-----------------------------------------------------------------------------
+
+bool Server::start() {
+    // is server already running?
+    if ( isRunning() ) return true;
+
+    m_quit = false;
+
+    // the wake-up socket: a non-blocking loopback datagram socket which the
+    // server thread polls along with the clients
+    if ( m_wakeSocket == INVALID_SOCKET ) {
+        m_wakeSocket = socket( AF_INET, SOCK_DGRAM, IPPROTO_UDP );
+        memset( &m_wakeAddress, 0, sizeof(m_wakeAddress) );
+        m_wakeAddress.sin_family = AF_INET;
+        m_wakeAddress.sin_addr.s_addr = htonl( INADDR_LOOPBACK );
+        int size = sizeof(m_wakeAddress);
+        u_long nonBlocking = 1;
+        if ( (m_wakeSocket == INVALID_SOCKET) ||
+             (bind( m_wakeSocket, (const sockaddr*)&m_wakeAddress, size ) == SOCKET_ERROR) ||
+             (getsockname( m_wakeSocket, (sockaddr*)&m_wakeAddress, &size ) == SOCKET_ERROR) ||
+             (ioctlsocket( m_wakeSocket, FIONBIO, &nonBlocking ) == SOCKET_ERROR)
+        ) {
+            cerr << "Server: failed to create wake-up socket\n";
+            if ( m_wakeSocket != INVALID_SOCKET ) closesocket( m_wakeSocket );
+            m_wakeSocket = INVALID_SOCKET;
+            return false;
+        }
+    }
+
+    // start server thread
+    unsigned int threadId = 0;
+    m_thread = reinterpret_cast<HANDLE>(_beginthreadex(
+        0,              // no security attributes (child can't inherit)
+        1024*1024,      // 1MB stack size
+        serverThread,   // thread function
+        this,           // pointer to parent
+        0,              // run immediately
+        &threadId       // out: returns thread ID
+    ));
+
+    // check result
+    if ( m_thread != 0 ) {
+        // check whether it started
+        if ( WaitForSingleObject( m_thread, 100L) == WAIT_OBJECT_0 ) {
+            m_running = false;
+            return false;
+        } else
+            m_running = true;
+
+        return true;
+    } else {
+        // failed to start
+        m_running = false;
+
+        return false;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void Server::stop() {
+    // is server already stopped?
+    if ( !isRunning() ) return;
+
+    // set flag to request thread to stop
+    m_quit = true;
+    wake();
+
+    // wait for it to stop (give it 4 seconds)
+    if ( WaitForSingleObject(m_thread, 4000L) == WAIT_OBJECT_0 ) {
+        // thread has exited
+        CloseHandle( m_thread );
+    } else {
+        // timeout: thread still running
+    }
+
+    // clear thread handle
+    m_thread = 0;
+
+    // reset running state and stop request flag
+    m_running = false;
+    m_quit = false;
+
+    closesocket( m_wakeSocket );
+    m_wakeSocket = INVALID_SOCKET;
+}
+
+//-----------------------------------------------------------------------------
+
+bool Server::isRunning() const {
+    return m_running;
+}
+
+//-----------------------------------------------------------------------------
+
+bool Server::openDatagram( const std::string & host, unsigned short port ) {
+    // resolve the address (dotted quad, or host name)
+    memset( &m_destination, 0, sizeof(m_destination) );
+    m_destination.sin_family = AF_INET;
+    m_destination.sin_port = htons( port );
+    m_destination.sin_addr.s_addr = inet_addr( host.c_str() );
+    if ( m_destination.sin_addr.s_addr == INADDR_NONE ) {
+        hostent *entry = gethostbyname( host.c_str() );
+        if ( (entry == 0) || (entry->h_addrtype != AF_INET) ) {
+            cerr << "Server: unknown host " << host << endl;
+            return false;
+        }
+        memcpy( &m_destination.sin_addr, entry->h_addr_list[0], 4 );
+    }
+
+    m_datagram = socket( AF_INET, SOCK_DGRAM, IPPROTO_UDP );
+    if ( m_datagram == INVALID_SOCKET ) {
+        cerr << "Server: failed to create datagram socket\n";
+        return false;
+    }
+
+    // multicast: keep to the local subnet, and loop back so that a client
+    // on this machine also receives the packets
+    unsigned long address = ntohl( m_destination.sin_addr.s_addr );
+    if ( (address >> 28) == 0xE ) {
+        int ttl = MULTICAST_TTL;
+        setsockopt( m_datagram, IPPROTO_IP, IP_MULTICAST_TTL,
+            reinterpret_cast<const char*>(&ttl), sizeof(ttl) );
+        DWORD loop = 1;
+        setsockopt( m_datagram, IPPROTO_IP, IP_MULTICAST_LOOP,
+            reinterpret_cast<const char*>(&loop), sizeof(loop) );
+    }
+
+    cout << "Server: sending datagrams to " << host << ":" << port << endl;
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+bool Server::send( const std::vector<TrackerData> & records ) {
+    if ( records.empty() ) return false;
+    bool sent = false;
+
+    // build the frame: header then records, in one buffer for one write
+    FrameHeader header;
+    header.length   = static_cast<unsigned>( sizeof(header) - sizeof(header.length)
+                    + records.size() * sizeof(TrackerData) );
+    header.sequence = m_sequence++;
+    header.sendTime = Clock::seconds();
+    header.count    = static_cast<unsigned>( records.size() );
+    m_frame.assign( reinterpret_cast<const char*>(&header), sizeof(header) );
+    m_frame.append( reinterpret_cast<const char*>(&records[0]),
+        records.size() * sizeof(TrackerData) );
+
+    // datagrams are never retried: a lost frame is replaced by the next one
+    if ( m_datagram != INVALID_SOCKET ) {
+        sent = sendto( m_datagram, m_frame.data(), static_cast<int>( m_frame.size() ),
+            0, reinterpret_cast<const sockaddr*>(&m_destination),
+            sizeof(m_destination) ) == static_cast<int>( m_frame.size() );
+    }
+
+    // queue the data for every client and send what each socket will take
+    // now; the server thread sends the rest as the sockets drain, and a
+    // client too slow to keep up is disconnected rather than holding up
+    // the others (or the VRPN loop)
+    bool backlog = false;
+
+    EnterCriticalSection( &m_lock );
+    for (size_t i=m_clients.size(); i-- > 0;) {
+        Client & client = m_clients[i];
+        client.pending.append( m_frame );
+        if ( !flush( client ) )
+            removeClient( i, "send failed" );
+        else if ( client.pending.size() > MAX_PENDING )
+            removeClient( i, "client too slow, disconnecting" );
+        else {
+            backlog = backlog || !client.pending.empty();
+            m_maxPending = max( m_maxPending, client.pending.size() );
+            sent = true;
+        }
+    }
+    LeaveCriticalSection( &m_lock );
+
+    // let the server thread poll for writing
+    if ( backlog ) wake();
+
+    return sent;
+}
+
+//-----------------------------------------------------------------------------
+
+void Server::status( size_t & clients, size_t & queued ) {
+    EnterCriticalSection( &m_lock );
+    clients = m_clients.size();
+    queued = m_maxPending;
+    m_maxPending = 0;
+    LeaveCriticalSection( &m_lock );
+}
+
+//-----------------------------------------------------------------------------
+
+bool Server::openWinsock() {
+    WORD version = MAKEWORD(2,2);
+    WSADATA wsa;
+    if ( WSAStartup( version, &wsa ) != 0 )
+        return false;
+
+    if ( wsa.wVersion == version )
+        return true;
+    else {
+        WSACleanup();
+        return false;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void Server::closeWinsock() {
+    WSACleanup();
+}
+
+//-----------------------------------------------------------------------------
+
+/// Collects statistics in the VRPN loop, and prints them (and optionally
+/// every sample) from a background thread, so that console output never
+/// holds up tracker.mainloop()
+class Diagnostics {
+public:
+    /// default constructor
+    Diagnostics();
+
+    /// destructor
+    virtual ~Diagnostics();
+
+    /// start the diagnostics thread, printing a stats line every interval
+    /// seconds (0 = never) and, if verbose, every sample received
+    bool start( Server *server, double interval, bool verbose );
+
+    /// stop the diagnostics thread
+    void stop();
+
+    /// record a sample received from VRPN (VRPN thread)
+    void sample( const TrackerData & data );
+
+    /// record a frame handed to the server, and the time taken (VRPN thread)
+    void sent( double duration );
+
+private:
+    /// the diagnostics thread
+    static unsigned __stdcall diagnosticsThread( void *userData );
+
+    /// the body of the diagnostics thread
+    void run();
+
+    /// print the stats line for the last elapsed seconds, and reset them
+    void report( double elapsed );
+
+private:
+    Server *m_server;       ///< the server (for its queue depth)
+    double  m_interval;     ///< seconds between stats lines (0 = never)
+    bool    m_verbose;      ///< print every sample?
+    HANDLE  m_thread;       ///< diagnostics thread handle
+    HANDLE  m_quit;         ///< signalled to stop the thread
+
+    CRITICAL_SECTION m_lock;            ///< guards the data below
+    std::vector<unsigned> m_samples;    ///< samples per sensor this interval
+    std::vector<TrackerData> m_print;   ///< samples waiting to be printed
+    unsigned m_dropped;     ///< samples not printed (queue full)
+    unsigned m_frames;      ///< frames sent this interval
+    double   m_sendTotal;   ///< total send time this interval (seconds)
+    double   m_sendMax;     ///< longest send this interval (seconds)
+};
+
+//-----------------------------------------------------------------------------
+
+Diagnostics::Diagnostics() {
+    m_server = 0;
+    m_interval = 0.0;
+    m_verbose = false;
+    m_thread = 0;
+    m_quit = CreateEvent( 0, TRUE, FALSE, 0 );
+    m_dropped = 0;
+    m_frames = 0;
+    m_sendTotal = 0.0;
+    m_sendMax = 0.0;
+    InitializeCriticalSection( &m_lock );
+}
+
+//-----------------------------------------------------------------------------
+
+Diagnostics::~Diagnostics() {
+    stop();
+    CloseHandle( m_quit );
+    DeleteCriticalSection( &m_lock );
+}
+
+//-----------------------------------------------------------------------------
+
+unsigned Diagnostics::diagnosticsThread( void *userData ) {
+    Diagnostics *diagnostics = reinterpret_cast<Diagnostics*>( userData );
+    diagnostics->run();
+
+    // end the thread
+    _endthreadex(1);
+
+    return 1;
+}
+
+//-----------------------------------------------------------------------------
+
+bool Diagnostics::start( Server *server, double interval, bool verbose ) {
+    m_server = server;
+    m_interval = interval;
+    m_verbose = verbose;
+
+    // nothing to print
+    if ( (m_interval <= 0.0) && !m_verbose ) return true;
+
+    ResetEvent( m_quit );
+    unsigned int threadId = 0;
+    m_thread = reinterpret_cast<HANDLE>(_beginthreadex(
+        0, 0, diagnosticsThread, this, 0, &threadId
+    ));
+
+    // the console is low priority: never compete with the VRPN loop
+    if ( m_thread != 0 )
+        SetThreadPriority( m_thread, THREAD_PRIORITY_BELOW_NORMAL );
+
+    return m_thread != 0;
+}
+
+//-----------------------------------------------------------------------------
+
+void Diagnostics::stop() {
+    if ( m_thread == 0 ) return;
+
+    SetEvent( m_quit );
+    WaitForSingleObject( m_thread, 4000L );
+    CloseHandle( m_thread );
+    m_thread = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+void Diagnostics::sample( const TrackerData & data ) {
+    if ( (m_thread == 0) || (data.sensor < 0) ) return;
+
+    EnterCriticalSection( &m_lock );
+    size_t sensor = static_cast<size_t>( data.sensor );
+    if ( sensor >= m_samples.size() ) m_samples.resize( sensor + 1, 0 );
+    ++m_samples[sensor];
+
+    if ( m_verbose ) {
+        if ( m_print.size() < MAX_PRINT_QUEUE )
+            m_print.push_back( data );
+        else
+            ++m_dropped;
+    }
+    LeaveCriticalSection( &m_lock );
+}
+
+//-----------------------------------------------------------------------------
+
+void Diagnostics::sent( double duration ) {
+    if ( m_thread == 0 ) return;
+
+    EnterCriticalSection( &m_lock );
+    ++m_frames;
+    m_sendTotal += duration;
+    m_sendMax = max( m_sendMax, duration );
+    LeaveCriticalSection( &m_lock );
+}
+
+//-----------------------------------------------------------------------------
+
+void Diagnostics::run() {
+    std::vector<TrackerData> print;
+    double last = Clock::seconds();
+
+    // wake often enough to keep up with the samples when verbose
+    DWORD timeout = m_verbose ? 100 :
+        static_cast<DWORD>( m_interval * 1000.0 );
+
+    while ( WaitForSingleObject( m_quit, timeout ) == WAIT_TIMEOUT ) {
+        if ( m_verbose ) {
+            // take the queued samples, and print them without the lock
+            unsigned dropped = 0;
+            EnterCriticalSection( &m_lock );
+            print.swap( m_print );
+            std::swap( dropped, m_dropped );
+            LeaveCriticalSection( &m_lock );
+
+            for (size_t i=0; i<print.size(); ++i) {
+                const TrackerData & data = print[i];
+                cout << "Tracker " << data.sensor << ": "
+                     << data.position[0] << ',' << data.position[1] << ','
+                     << data.position[2] << ','
+                     << data.rotation[0] << ',' << data.rotation[1] << ','
+                     << data.rotation[2] << ',' << data.rotation[3] << '\n';
+            }
+            if ( dropped > 0 )
+                cout << "(" << dropped << " samples not printed)\n";
+            print.clear();
+        }
+
+        double now = Clock::seconds();
+        if ( (m_interval > 0.0) && (now - last >= m_interval) ) {
+            report( now - last );
+            last = now;
+        }
+
+        cout << flush;
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void Diagnostics::report( double elapsed ) {
+    size_t clients = 0, queued = 0;
+    if ( m_server ) m_server->status( clients, queued );
+
+    EnterCriticalSection( &m_lock );
+    std::vector<unsigned> samples( m_samples.size(), 0 );
+    samples.swap( m_samples );
+    unsigned frames = m_frames;
+    double sendTotal = m_sendTotal, sendMax = m_sendMax;
+    m_frames = 0;
+    m_sendTotal = m_sendMax = 0.0;
+    LeaveCriticalSection( &m_lock );
+
+    // e.g. "Hz 0:250.0 1:250.0 | 250.0 frames/s | send 4.1/12.3 us | 2 clients, 0 bytes queued"
+    char text[64];
+    string line( "Hz" );
+    for (size_t i=0; i<samples.size(); ++i) {
+        sprintf_s( text, sizeof(text), " %u:%.1f", static_cast<unsigned>(i),
+            samples[i] / elapsed );
+        line += text;
+    }
+    sprintf_s( text, sizeof(text), " | %.1f frames/s", frames / elapsed );
+    line += text;
+    sprintf_s( text, sizeof(text), " | send %.1f/%.1f us",
+        frames ? 1.0e6 * sendTotal / frames : 0.0, 1.0e6 * sendMax );
+    line += text;
+    sprintf_s( text, sizeof(text), " | %u clients, %u bytes queued",
+        static_cast<unsigned>( clients ), static_cast<unsigned>( queued ) );
+    line += text;
+
+    cout << line << '\n';
+}
+
+//-----------------------------------------------------------------------------
+
+/// Predicts where each sensor will be when the frame rendered from its
+/// sample reaches the display: the velocity and angular velocity between
+/// successive samples (exponentially smoothed, to keep tracker noise from
+/// being amplified) are extrapolated over the sensor's lead time, and the
+/// record's time stamp becomes the predicted display time, on the bridge's
+/// monotonic clock (as the frame's send time: the tracker's own time, in
+/// seconds since 1970, is far too large for a float to resolve the lead).
+/// Sensors without a lead time are passed through unchanged.
+class Predictor {
+public:
+    /// default constructor
+    Predictor();
+
+    /// set the lead time of a sensor, or of every sensor (sensor < 0),
+    /// in seconds
+    void setLead( int sensor, double lead );
+
+    /// set the weight of each new velocity sample (1 = no smoothing)
+    void setSmoothing( double weight );
+
+    /// returns true if any sensor is predicted
+    bool isEnabled() const;
+
+    /// replace the record by its prediction (time = the sample's own time,
+    /// now = the bridge clock time it arrived, both in seconds)
+    void predict( double time, double now, TrackerData & data );
+
+private:
+    /// the motion of one sensor
+    struct Sensor {
+        bool   valid;           ///< has a sample been seen?
+        double time;            ///< time of the last sample (seconds)
+        double position[3];     ///< last position
+        double rotation[4];     ///< last orientation (x,y,z,w, normalised)
+        double velocity[3];     ///< smoothed velocity (per second)
+        double angular[3];      ///< smoothed angular velocity (radians/second)
+    };
+
+    /// returns the lead time of a sensor (seconds)
+    double lead( int sensor ) const;
+
+private:
+    double m_defaultLead;           ///< lead time of sensors not set
+    std::vector<double> m_lead;     ///< lead time of each sensor (< 0 = default)
+    double m_smoothing;             ///< weight of each new velocity sample
+    std::vector<Sensor> m_sensors;  ///< motion of each sensor
+};
+
+//-----------------------------------------------------------------------------
+
+/// longest gap between samples which is still extrapolated across (seconds)
+const double MAX_SAMPLE_GAP = 0.1;
+
+Predictor::Predictor() {
+    m_defaultLead = 0.0;
+    m_smoothing = 0.5;
+}
+
+//-----------------------------------------------------------------------------
+
+void Predictor::setLead( int sensor, double lead ) {
+    if ( sensor < 0 ) {
+        m_defaultLead = lead;
+        return;
+    }
+    size_t index = static_cast<size_t>( sensor );
+    if ( index >= m_lead.size() ) m_lead.resize( index + 1, -1.0 );
+    m_lead[index] = lead;
+}
+
+//-----------------------------------------------------------------------------
+
+void Predictor::setSmoothing( double weight ) {
+    m_smoothing = min( max( weight, 0.01 ), 1.0 );
+}
+
+//-----------------------------------------------------------------------------
+
+bool Predictor::isEnabled() const {
+    if ( m_defaultLead > 0.0 ) return true;
+    for (size_t i=0; i<m_lead.size(); ++i)
+        if ( m_lead[i] > 0.0 ) return true;
+    return false;
+}
+
+//-----------------------------------------------------------------------------
+
+double Predictor::lead( int sensor ) const {
+    size_t index = static_cast<size_t>( sensor );
+    if ( (index < m_lead.size()) && (m_lead[index] >= 0.0) ) return m_lead[index];
+    return m_defaultLead;
+}
+
+//-----------------------------------------------------------------------------
+
+void Predictor::predict( double time, double now, TrackerData & data ) {
+    if ( data.sensor < 0 ) return;
+    const double ahead = lead( data.sensor );
+    if ( ahead <= 0.0 ) return;
+
+    size_t index = static_cast<size_t>( data.sensor );
+    if ( index >= m_sensors.size() ) {
+        Sensor none = {};
+        m_sensors.resize( index + 1, none );
+    }
+    Sensor & sensor = m_sensors[index];
+
+    double rotation[4];
+    for (unsigned i=0; i<4; ++i) rotation[i] = data.rotation[i];
+
+    // the motion since the last sample (a gap, or time going backwards,
+    // starts again from rest)
+    const double dt = time - sensor.time;
+    if ( sensor.valid && (dt > 0.0) && (dt <= MAX_SAMPLE_GAP) ) {
+        for (unsigned i=0; i<3; ++i) {
+            const double velocity = ( data.position[i] - sensor.position[i] ) / dt;
+            sensor.velocity[i] += m_smoothing * ( velocity - sensor.velocity[i] );
+        }
+
+        // the rotation from the last orientation to this one, q * last^-1,
+        // as an angular velocity (taking the shorter way round)
+        const double *q = rotation;
+        const double *p = sensor.rotation;
+        double delta[4] = {
+            q[3]*-p[0] + q[0]*p[3] + q[1]*-p[2] - q[2]*-p[1],
+            q[3]*-p[1] - q[0]*-p[2] + q[1]*p[3] + q[2]*-p[0],
+            q[3]*-p[2] + q[0]*-p[1] - q[1]*-p[0] + q[2]*p[3],
+            q[3]*p[3] - q[0]*-p[0] - q[1]*-p[1] - q[2]*-p[2]
+        };
+        if ( delta[3] < 0.0 )
+            for (unsigned i=0; i<4; ++i) delta[i] = -delta[i];
+        const double sine = sqrt( delta[0]*delta[0] + delta[1]*delta[1] + delta[2]*delta[2] );
+        const double angle = 2.0 * atan2( sine, delta[3] );
+        for (unsigned i=0; i<3; ++i) {
+            const double angular = ( sine > 1.0e-9 ) ? delta[i] / sine * angle / dt : 0.0;
+            sensor.angular[i] += m_smoothing * ( angular - sensor.angular[i] );
+        }
+    } else if ( !sensor.valid || (dt != 0.0) ) {
+        for (unsigned i=0; i<3; ++i) sensor.velocity[i] = sensor.angular[i] = 0.0;
+    }
+
+    sensor.valid = true;
+    sensor.time = time;
+    for (unsigned i=0; i<3; ++i) sensor.position[i] = data.position[i];
+    for (unsigned i=0; i<4; ++i) sensor.rotation[i] = rotation[i];
+
+    // extrapolate: move on at the velocity, and turn at the angular
+    // velocity (as a rotation applied before the current orientation)
+    for (unsigned i=0; i<3; ++i)
+        data.position[i] = static_cast<float>( sensor.position[i] + sensor.velocity[i] * ahead );
+
+    const double *w = sensor.angular;
+    const double rate = sqrt( w[0]*w[0] + w[1]*w[1] + w[2]*w[2] );
+    if ( rate > 1.0e-9 ) {
+        const double half = 0.5 * rate * ahead;
+        const double s = sin( half ) / rate;
+        const double turn[4] = { w[0] * s, w[1] * s, w[2] * s, cos( half ) };
+        const double *q = rotation;
+        const double predicted[4] = {
+            turn[3]*q[0] + turn[0]*q[3] + turn[1]*q[2] - turn[2]*q[1],
+            turn[3]*q[1] - turn[0]*q[2] + turn[1]*q[3] + turn[2]*q[0],
+            turn[3]*q[2] + turn[0]*q[1] - turn[1]*q[0] + turn[2]*q[3],
+            turn[3]*q[3] - turn[0]*q[0] - turn[1]*q[1] - turn[2]*q[2]
+        };
+        for (unsigned i=0; i<4; ++i) data.rotation[i] = static_cast<float>( predicted[i] );
+    }
+
+    // the record now describes the pose at the display time (on the
+    // bridge clock, which starts with the bridge: a float resolves it to a
+    // millisecond for the first two hours, and to 8ms after a day)
+    data.timeStamp = static_cast<float>( now + ahead );
+}
+
+//-----------------------------------------------------------------------------
+
+#pragma pack (push, 1)
+/// a tracker sample as recorded (-record) and replayed (-replay)
+struct TrackRecord {
+    double      received;   ///< when it arrived (seconds since the recording started)
+    double      sampleTime; ///< the tracker's own time of the sample (seconds)
+    unsigned    tick;       ///< VRPN mainloop tick it arrived in (one frame per tick)
+    TrackerData data;       ///< the sample, as measured
+};
+
+/// the header at the start of a recording
+struct TrackHeader {
+    char        magic[4];   ///< "QTRK"
+    unsigned    version;    ///< format version (1)
+    unsigned    recordSize; ///< sizeof(TrackRecord)
+    unsigned    count;      ///< records written (updated as they are appended)
+};
+#pragma pack (pop)
+
+//-----------------------------------------------------------------------------
+
+/// An append-only recording of tracker samples, memory-mapped: the file is
+/// grown (and remapped) a chunk at a time, so appending a sample is a copy
+/// into the view, and the header's count is updated after each record so
+/// that a recording cut short is still readable. The file is trimmed to the
+/// records written when it is closed.
+class TrackFile {
+public:
+    /// default constructor
+    TrackFile();
+
+    /// destructor (closes the file)
+    virtual ~TrackFile();
+
+    /// create (or replace) a recording
+    bool create( const std::string & fileName );
+
+    /// open an existing recording to replay
+    bool open( const std::string & fileName );
+
+    /// close the file
+    void close();
+
+    /// returns true if the file is open
+    bool isOpen() const;
+
+    /// append a record (recording only)
+    bool append( const TrackRecord & record );
+
+    /// returns the number of records
+    unsigned count() const;
+
+    /// returns a record (index < count)
+    const TrackRecord & record( unsigned index ) const;
+
+private:
+    /// map the file at the given size (bytes)
+    bool map( size_t size );
+
+    /// unmap the file
+    void unmap();
+
+private:
+    HANDLE  m_file;         ///< the file
+    HANDLE  m_mapping;      ///< its file mapping
+    char   *m_view;         ///< the mapped view (or 0)
+    size_t  m_size;         ///< size of the mapping (bytes)
+    bool    m_writing;      ///< created for recording?
+};
+
+//-----------------------------------------------------------------------------
+
+/// records the file grows by each time it fills up
+const size_t TRACK_CHUNK = 65536;
+
+TrackFile::TrackFile() {
+    m_file = INVALID_HANDLE_VALUE;
+    m_mapping = 0;
+    m_view = 0;
+    m_size = 0;
+    m_writing = false;
+}
+
+//-----------------------------------------------------------------------------
+
+TrackFile::~TrackFile() {
+    close();
+}
+
+//-----------------------------------------------------------------------------
+
+bool TrackFile::create( const std::string & fileName ) {
+    close();
+
+    m_file = CreateFileA( fileName.c_str(), GENERIC_READ | GENERIC_WRITE,
+        FILE_SHARE_READ, 0, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, 0 );
+    if ( m_file == INVALID_HANDLE_VALUE ) {
+        cerr << "unable to create recording " << fileName << endl;
+        return false;
+    }
+
+    m_writing = true;
+    if ( !map( sizeof(TrackHeader) + TRACK_CHUNK * sizeof(TrackRecord) ) ) {
+        close();
+        return false;
+    }
+
+    TrackHeader *header = reinterpret_cast<TrackHeader*>( m_view );
+    memcpy( header->magic, "QTRK", 4 );
+    header->version = 1;
+    header->recordSize = sizeof(TrackRecord);
+    header->count = 0;
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+bool TrackFile::open( const std::string & fileName ) {
+    close();
+
+    m_file = CreateFileA( fileName.c_str(), GENERIC_READ,
+        FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0 );
+    LARGE_INTEGER size = {};
+    if ( (m_file == INVALID_HANDLE_VALUE) || !GetFileSizeEx( m_file, &size ) ||
+         (size.QuadPart < static_cast<LONGLONG>( sizeof(TrackHeader) )) ) {
+        cerr << "unable to open recording " << fileName << endl;
+        close();
+        return false;
+    }
+
+    m_writing = false;
+    if ( !map( static_cast<size_t>( size.QuadPart ) ) ) {
+        close();
+        return false;
+    }
+
+    // the header must match, and the records it counts must be there
+    const TrackHeader *header = reinterpret_cast<const TrackHeader*>( m_view );
+    if ( (memcmp( header->magic, "QTRK", 4 ) != 0) || (header->version != 1) ||
+         (header->recordSize != sizeof(TrackRecord)) ||
+         (sizeof(TrackHeader) + header->count * sizeof(TrackRecord) > m_size) ) {
+        cerr << fileName << " is not a tracker recording\n";
+        close();
+        return false;
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void TrackFile::close() {
+    if ( m_file == INVALID_HANDLE_VALUE ) return;
+
+    // trim a recording to the records written
+    LARGE_INTEGER used = {};
+    if ( m_writing && (m_view != 0) )
+        used.QuadPart = sizeof(TrackHeader) + count() * sizeof(TrackRecord);
+
+    unmap();
+    if ( used.QuadPart > 0 ) {
+        SetFilePointerEx( m_file, used, 0, FILE_BEGIN );
+        SetEndOfFile( m_file );
+    }
+
+    CloseHandle( m_file );
+    m_file = INVALID_HANDLE_VALUE;
+    m_writing = false;
+}
+
+//-----------------------------------------------------------------------------
+
+bool TrackFile::isOpen() const {
+    return m_view != 0;
+}
+
+//-----------------------------------------------------------------------------
+
+bool TrackFile::append( const TrackRecord & record ) {
+    if ( !m_writing || (m_view == 0) ) return false;
+
+    // grow the file when the mapping is full
+    const unsigned index = count();
+    const size_t end = sizeof(TrackHeader) + (index + 1) * sizeof(TrackRecord);
+    if ( (end > m_size) && !map( m_size + TRACK_CHUNK * sizeof(TrackRecord) ) ) return false;
+
+    memcpy( m_view + sizeof(TrackHeader) + index * sizeof(TrackRecord),
+        &record, sizeof(record) );
+    reinterpret_cast<TrackHeader*>( m_view )->count = index + 1;
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+unsigned TrackFile::count() const {
+    return ( m_view != 0 ) ? reinterpret_cast<const TrackHeader*>( m_view )->count : 0;
+}
+
+//-----------------------------------------------------------------------------
+
+const TrackRecord & TrackFile::record( unsigned index ) const {
+    return *reinterpret_cast<const TrackRecord*>(
+        m_view + sizeof(TrackHeader) + index * sizeof(TrackRecord) );
+}
+
+//-----------------------------------------------------------------------------
+
+bool TrackFile::map( size_t size ) {
+    unmap();
+
+    // mapping a file for writing extends it to the size of the mapping
+    const DWORD protect = m_writing ? PAGE_READWRITE : PAGE_READONLY;
+    const DWORD access = m_writing ? FILE_MAP_WRITE : FILE_MAP_READ;
+    const unsigned long long size64 = size;
+    m_mapping = CreateFileMapping( m_file, 0, protect,
+        static_cast<DWORD>( size64 >> 32 ), static_cast<DWORD>( size64 ), 0 );
+    if ( m_mapping != 0 )
+        m_view = reinterpret_cast<char*>( MapViewOfFile( m_mapping, access, 0, 0, size ) );
+    if ( m_view == 0 ) {
+        cerr << "unable to map recording (" << GetLastError() << ")\n";
+        unmap();
+        return false;
+    }
+
+    m_size = size;
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void TrackFile::unmap() {
+    if ( m_view != 0 ) UnmapViewOfFile( m_view );
+    if ( m_mapping != 0 ) CloseHandle( m_mapping );
+    m_view = 0;
+    m_mapping = 0;
+    m_size = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+unsigned frames = 0;
+
+/// the sensor updates received during the current VRPN mainloop tick
+vector<TrackerData> batch;
+
+/// latest poses, shared with the Quadifier module for late-latching
+hive::SharedPose pose;
+
+/// rate, latency and queue statistics (printed from a background thread)
+Diagnostics diagnostics;
+
+/// extrapolates each sensor to its display time (optional, per sensor)
+Predictor predictor;
+
+/// samples recorded with -record
+TrackFile recording;
+
+/// VRPN mainloop ticks so far (the frame each recorded sample belongs to)
+unsigned tick = 0;
+
+/// when the recording started
+double recordStart = 0.0;
+
+/// handle one sample, live or replayed (time = the sample's own time)
+void handleSample( double time, const TrackerData & data, vector<TrackerData> *records ) {
+     // count it (and queue it for printing if verbose): no console I/O here
+     diagnostics.sample( data );
+
+     // the pose handed to Unity is predicted for the time it is displayed
+     // (the shared pose stays as measured, for late-latching)
+     TrackerData predicted( data );
+     predictor.predict( time, Clock::seconds(), predicted );
+
+     // add the data to this tick's frame (a sensor reported twice in one
+     // tick keeps only its latest sample)
+     size_t i = 0;
+     while ( (i < records->size()) && ((*records)[i].sensor != data.sensor) ) ++i;
+     if ( i < records->size() )
+         (*records)[i] = predicted;
+     else
+         records->push_back( predicted );
+
+     // publish the latest pose of the sensor (read at present time)
+     if ( pose.isOpen() && (data.sensor >= 0) ) {
+         hive::SharedPose::Pose latest;
+         latest.timeStamp = data.timeStamp;
+         for (unsigned i=0; i<3; ++i) latest.position[i] = data.position[i];
+         for (unsigned i=0; i<4; ++i) latest.rotation[i] = data.rotation[i];
+         pose.write( static_cast<unsigned>(data.sensor), latest );
+     }
+}
+
+void VRPN_CALLBACK handleTracker( void *userData, const vrpn_TRACKERCB tracker ) {
+    vector<TrackerData> *records = reinterpret_cast<vector<TrackerData>*>( userData );
+
+    if (tracker.sensor == 0) ++frames;
+
+     // tracker data to send to Unity client
+     TrackerData data;
+     data.set( tracker );
+
+     // the sample's own time (the float time stamp is too coarse for this)
+     const double time = static_cast<double>( tracker.msg_time.tv_sec ) +
+                         1.0e-6 * tracker.msg_time.tv_usec;
+
+     // keep it, as measured, if recording
+     if ( recording.isOpen() ) {
+         TrackRecord record;
+         record.received = Clock::seconds() - recordStart;
+         record.sampleTime = time;
+         record.tick = tick;
+         record.data = data;
+         recording.append( record );
+     }
+
+     handleSample( time, data, records );
+}
+
+/// replay a recording through the same path as live samples, at the speed
+/// given (1 = as recorded, 0 = as fast as possible), until a key is pressed
+void replay( TrackFile & file, double speed, bool loop, Server & server ) {
+    const unsigned count = file.count();
+    if ( count == 0 ) return;
+
+    do {
+        double start = Clock::seconds();
+        unsigned i = 0;
+        while ( (i < count) && !kbhit() ) {
+            // wait until the tick is due: sleep, then spin the last
+            // millisecond or so (Sleep is much coarser than the samples)
+            const TrackRecord & first = file.record( i );
+            if ( speed > 0.0 ) {
+                const double due = start + first.received / speed;
+                double wait = due - Clock::seconds();
+                if ( wait > 0.002 ) Sleep( static_cast<DWORD>( (wait - 0.002) * 1000.0 ) );
+                while ( Clock::seconds() < due ) {}
+            }
+
+            // the samples of one recorded tick go out as one frame
+            batch.clear();
+            for (; (i < count) && (file.record( i ).tick == first.tick); ++i) {
+                const TrackRecord & record = file.record( i );
+                if ( record.data.sensor == 0 ) ++frames;
+                handleSample( record.sampleTime, record.data, &batch );
+            }
+
+            double sent = Clock::seconds();
+            server.send( batch );
+            diagnostics.sent( Clock::seconds() - sent );
+        }
+    } while ( loop && !kbhit() );
+}
+
+int main (int argc, char **argv)
+{
+    Server server;
+    server.start();
+
+    double statsInterval = 1.0;
+    bool verbose = false;
+    string recordFile;
+    string replayFile;
+    double speed = 1.0;
+    bool loop = false;
+
+    for (int i=1; i<argc; ++i) {
+        string option( argv[i] );
+        if ( (option == "-udp") && (i+1 < argc) ) {
+            // optional datagram transport: -udp <address>[:<port>]
+            string host( argv[++i] );
+            unsigned short port = SERVER_PORT;
+            size_t colon = host.find( ':' );
+            if ( colon != string::npos ) {
+                port = static_cast<unsigned short>( atoi( host.c_str() + colon + 1 ) );
+                host.erase( colon );
+            }
+            server.openDatagram( host, port );
+        } else if ( (option == "-stats") && (i+1 < argc) ) {
+            // seconds between stats lines (0 = none)
+            statsInterval = atof( argv[++i] );
+        } else if ( option == "-verbose" ) {
+            // print every sample (from the diagnostics thread)
+            verbose = true;
+        } else if ( (option == "-predict") && (i+1 < argc) ) {
+            // lead time in milliseconds: -predict [<sensor>:]<ms>
+            string value( argv[++i] );
+            int sensor = -1;
+            size_t colon = value.find( ':' );
+            if ( colon != string::npos ) {
+                sensor = atoi( value.c_str() );
+                value.erase( 0, colon + 1 );
+            }
+            predictor.setLead( sensor, max( atof( value.c_str() ), 0.0 ) / 1000.0 );
+        } else if ( (option == "-smooth") && (i+1 < argc) ) {
+            // weight of each new velocity sample in the prediction
+            predictor.setSmoothing( atof( argv[++i] ) );
+        } else if ( (option == "-record") && (i+1 < argc) ) {
+            // record every sample to a file
+            recordFile = argv[++i];
+        } else if ( (option == "-replay") && (i+1 < argc) ) {
+            // replay a recording instead of connecting to VRPN
+            replayFile = argv[++i];
+        } else if ( (option == "-speed") && (i+1 < argc) ) {
+            // replay speed (1 = as recorded, 0 = as fast as possible)
+            speed = max( atof( argv[++i] ), 0.0 );
+        } else if ( option == "-loop" ) {
+            // replay the recording over and over
+            loop = true;
+        }
+    }
+
+    if ( predictor.isEnabled() )
+        cout << "predicting tracker poses to their display time\n";
+
+    diagnostics.start( &server, statsInterval, verbose );
+
+    if ( !pose.open() )
+        cerr << "unable to open shared tracker poses\n";
+
+    // record start time
+    float t = (float)clock()/CLOCKS_PER_SEC;
+
+    if ( !replayFile.empty() ) {
+        // replay a recording instead of connecting to VRPN
+        TrackFile file;
+        if ( file.open( replayFile ) ) {
+            cout << "replaying " << file.count() << " samples from " << replayFile << endl;
+            replay( file, speed, loop, server );
+        }
+
+        diagnostics.stop();
+        server.stop();
+    } else {
+        if ( !recordFile.empty() && recording.create( recordFile ) ) {
+            cout << "recording to " << recordFile << endl;
+            recordStart = Clock::seconds();
+        }
+
+        vrpn_Tracker_Remote tracker( "Tracker0@localhost" );
+
+        tracker.register_change_handler( &batch, handleTracker );
+
+        while (!kbhit()) {
+            // collect the sensor updates of one tick, and send them as one frame
+            batch.clear();
+            tracker.mainloop();
+            ++tick;
+            if ( !batch.empty() ) {
+                double start = Clock::seconds();
+                server.send( batch );
+                diagnostics.sent( Clock::seconds() - start );
+            }
+        }
+
+        diagnostics.stop();
+        server.stop();
+
+        tracker.unregister_change_handler( &batch, handleTracker );
+        recording.close();
+    }
+
+    pose.close();
+
+    // calculate update rate achieved (for Razer Hydra, I get 250Hz)
+    t = (float)clock()/CLOCKS_PER_SEC - t;
+    printf("%.2f Hz\n", (float)frames / t);
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------